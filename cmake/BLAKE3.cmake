@@ -0,0 +1,32 @@
+# Licensed to the Apache Software Foundation (ASF) under one
+# or more contributor license agreements.  See the NOTICE file
+# distributed with this work for additional information
+# regarding copyright ownership.  The ASF licenses this file
+# to you under the Apache License, Version 2.0 (the
+# "License"); you may not use this file except in compliance
+# with the License.  You may obtain a copy of the License at
+#
+#   http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing,
+# software distributed under the License is distributed on an
+# "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+# KIND, either express or implied.  See the License for the
+# specific language governing permissions and limitations
+# under the License.
+
+include(FetchContent)
+
+FetchContent_Declare(blake3
+    GIT_REPOSITORY  https://github.com/BLAKE3-team/BLAKE3.git
+    GIT_TAG         1.5.4
+    GIT_SHALLOW     TRUE
+    SOURCE_SUBDIR   c
+    SYSTEM
+)
+
+FetchContent_MakeAvailable(blake3)
+
+if (NOT TARGET BLAKE3::blake3)
+    add_library(BLAKE3::blake3 ALIAS blake3)
+endif()
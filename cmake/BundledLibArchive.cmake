@@ -34,9 +34,13 @@ function(use_bundled_libarchive SOURCE_DIR BINARY_DIR)
             -DENABLE_MBEDTLS=OFF
             -DENABLE_NETTLE=OFF
             -DENABLE_LIBB2=OFF
-            -DENABLE_LZ4=OFF
+            -DENABLE_LZ4=ON
+            "-DLZ4_INCLUDE_DIR=${LZ4_INCLUDE_DIRS}"
+            "-DLZ4_LIBRARY=${LZ4_LIBRARIES}"
             -DENABLE_LZO=OFF
-            -DENABLE_ZSTD=OFF
+            -DENABLE_ZSTD=ON
+            "-DZSTD_INCLUDE_DIR=${ZSTD_INCLUDE_DIRS}"
+            "-DZSTD_LIBRARY=${ZSTD_LIBRARIES}"
             -DENABLE_ZLIB=ON
             -DENABLE_LIBXML2=OFF
             -DENABLE_EXPAT=OFF
@@ -80,7 +84,7 @@ function(use_bundled_libarchive SOURCE_DIR BINARY_DIR)
             TLS_VERIFY TRUE
     )
 
-    add_dependencies(libarchive-external ZLIB::ZLIB OpenSSL::Crypto)
+    add_dependencies(libarchive-external ZLIB::ZLIB OpenSSL::Crypto zstd::zstd lz4::lz4)
     if (ENABLE_LZMA)
         add_dependencies(libarchive-external LibLZMA::LibLZMA)
     endif()
@@ -96,7 +100,7 @@ function(use_bundled_libarchive SOURCE_DIR BINARY_DIR)
     add_library(LibArchive::LibArchive STATIC IMPORTED)
     set_target_properties(LibArchive::LibArchive PROPERTIES IMPORTED_LOCATION "${LIBARCHIVE_LIBRARY}")
     add_dependencies(LibArchive::LibArchive libarchive-external)
-    target_link_libraries(LibArchive::LibArchive INTERFACE ZLIB::ZLIB OpenSSL::Crypto)
+    target_link_libraries(LibArchive::LibArchive INTERFACE ZLIB::ZLIB OpenSSL::Crypto zstd::zstd lz4::lz4)
     if (ENABLE_LZMA)
         target_link_libraries(LibArchive::LibArchive INTERFACE LibLZMA::LibLZMA)
     endif()
@@ -0,0 +1,34 @@
+# Licensed to the Apache Software Foundation (ASF) under one
+# or more contributor license agreements.  See the NOTICE file
+# distributed with this work for additional information
+# regarding copyright ownership.  The ASF licenses this file
+# to you under the Apache License, Version 2.0 (the
+# "License"); you may not use this file except in compliance
+# with the License.  You may obtain a copy of the License at
+#
+#   http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing,
+# software distributed under the License is distributed on an
+# "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+# KIND, either express or implied.  See the License for the
+# specific language governing permissions and limitations
+# under the License.
+
+include(FetchContent)
+
+# only the header is used, with XXH_INLINE_ALL defined, so that the hash functions are inlined into their callers
+FetchContent_Declare(xxhash
+    GIT_REPOSITORY  https://github.com/Cyan4973/xxHash.git
+    GIT_TAG         v0.8.3
+    GIT_SHALLOW     TRUE
+    SYSTEM
+)
+
+FetchContent_MakeAvailable(xxhash)
+
+if (NOT TARGET xxhash::xxhash)
+    add_library(xxhash INTERFACE)
+    target_include_directories(xxhash SYSTEM INTERFACE "${xxhash_SOURCE_DIR}")
+    add_library(xxhash::xxhash ALIAS xxhash)
+endif()
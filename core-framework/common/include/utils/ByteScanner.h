@@ -0,0 +1,85 @@
+/**
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The ASF licenses this file to You under the Apache License, Version 2.0
+ * (the "License"); you may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace org::apache::nifi::minifi::utils {
+
+enum class VectorInstructionSet {
+  Scalar,
+  SSE2,
+  AVX2,
+  NEON
+};
+
+// the instruction sets usable on the running CPU in increasing order of preference, Scalar is always the first one
+const std::vector<VectorInstructionSet>& getSupportedVectorInstructionSets();
+
+// the preferred one of the supported instruction sets, AVX2 is detected at runtime, so the binaries built for x86-64 use it only where it is available
+VectorInstructionSet getVectorInstructionSet();
+
+/**
+ * Finds the first occurrence of any byte of a small set, e.g. the separator, the quote and the newline characters of CSV content.
+ * Blocks of 16 (SSE2, NEON) or 32 (AVX2) bytes are compared with all bytes of the set at once; a single byte is searched with memchr.
+ */
+class ByteSetScanner {
+ public:
+  static constexpr size_t MAX_BYTES = 8;
+
+  // bytes may contain at most MAX_BYTES characters, the instruction set must be one of the supported ones
+  explicit ByteSetScanner(std::string_view bytes, VectorInstructionSet instruction_set = getVectorInstructionSet());
+
+  // returns the position of the first byte of the set at or after pos, or std::string_view::npos if there is none
+  [[nodiscard]] size_t find(std::string_view data, size_t pos = 0) const;
+
+  [[nodiscard]] bool contains(char c) const { return table_[static_cast<unsigned char>(c)]; }
+
+ private:
+  std::array<char, MAX_BYTES> bytes_{};
+  size_t byte_count_ = 0;
+  std::array<bool, 256> table_{};
+  VectorInstructionSet instruction_set_;
+};
+
+/**
+ * Finds the first occurrence of a delimiter, e.g. the line endings or the byte sequence separating the parts of the content.
+ * Single byte delimiters are searched with memchr. For longer delimiters the first and the last bytes of the delimiter
+ * are compared with whole blocks, and only the positions where both of them match are compared with the complete delimiter.
+ */
+class DelimiterScanner {
+ public:
+  // the delimiter must not be empty, the instruction set must be one of the supported ones
+  explicit DelimiterScanner(std::string delimiter, VectorInstructionSet instruction_set = getVectorInstructionSet());
+
+  // returns the position of the first occurrence of the delimiter starting at or after pos, or std::string_view::npos if there is none
+  [[nodiscard]] size_t find(std::string_view data, size_t pos = 0) const;
+
+  [[nodiscard]] const std::string& delimiter() const { return delimiter_; }
+  [[nodiscard]] size_t size() const { return delimiter_.size(); }
+
+ private:
+  std::string delimiter_;
+  VectorInstructionSet instruction_set_;
+};
+
+}  // namespace org::apache::nifi::minifi::utils
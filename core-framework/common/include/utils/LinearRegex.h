@@ -0,0 +1,169 @@
+/**
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The ASF licenses this file to You under the Apache License, Version 2.0
+ * (the "License"); you may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <bitset>
+#include <cstdint>
+#include <limits>
+#include <memory>
+#include <optional>
+#include <span>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace org::apache::nifi::minifi::utils {
+
+/**
+ * Regular expression engine with a running time linear in the length of the subject.
+ *
+ * The pattern is compiled to an NFA, which is simulated with all of its threads in lockstep (Pike VM), so patterns like (a*)*b
+ * cannot cause catastrophic backtracking. Thread priorities follow the backtracking order, so the matches and the submatches
+ * are the same as those of the ECMAScript grammar of std::regex, except that a group repeated by a loop keeps the capture of its
+ * last non-empty iteration.
+ * The extent of a match can also differ when the body of a loop can match the empty string.
+ * Backreferences, lookarounds and POSIX character classes cannot be simulated this way, compile() returns std::nullopt for them.
+ *
+ * When only the fact of the match is needed, the NFA is converted to a DFA on first use, which costs a table lookup per character.
+ * Patterns whose DFA would exceed MAX_AUTOMATON_STATES keep using the NFA simulation.
+ */
+class LinearRegex {
+ public:
+  static constexpr size_t NPOS = std::numeric_limits<size_t>::max();
+  static constexpr size_t MAX_PROGRAM_SIZE = 65536;
+  static constexpr size_t MAX_AUTOMATON_STATES = 4096;
+
+  static std::optional<LinearRegex> compile(std::string_view pattern, bool case_insensitive = false);
+
+  /**
+   * @param captures if not null and the whole subject matches, it is set to the positions of the match and of the groups like by search()
+   */
+  bool fullMatch(std::string_view subject, std::vector<size_t>* captures = nullptr) const;
+
+  /**
+   * Finds the leftmost match in subject, starting at position start.
+   * @param captures if not null, it is set to the begin and end positions of the match followed by those of the groups,
+   * NPOS for the groups which did not participate in the match
+   */
+  bool search(std::string_view subject, size_t start = 0, std::vector<size_t>* captures = nullptr) const;
+
+  /**
+   * Replaces the first or all matches, the replacement can refer to the match with $&, $`, $' and $n like in std::regex_replace
+   */
+  [[nodiscard]] std::string replace(std::string_view subject, std::string_view replacement, bool first_only) const;
+
+  /// Like replace(), but appends the result to result
+  void replace(std::string_view subject, std::string_view replacement, bool first_only, std::string& result) const;
+
+  /**
+   * Appends the replacement of a match found by search() to result, $` refers to the part of the subject from prefix_begin to the match
+   * @param captures the positions set by search()
+   */
+  void appendReplacement(std::string& result, std::string_view subject, std::span<const size_t> captures, std::string_view replacement, size_t prefix_begin) const;
+
+  [[nodiscard]] size_t getGroupCount() const {
+    return group_count_;
+  }
+
+  [[nodiscard]] size_t getProgramSize() const {
+    return program_.size();
+  }
+
+ private:
+  friend class PatternCompiler;
+  friend class PikeVM;
+  friend class AutomatonBuilder;
+  friend class LinearRegexSet;
+
+  enum class OpCode : uint8_t {
+    Char,  // consume the character c
+    Any,  // consume any character except line terminators
+    Class,  // consume a character of classes[x]
+    Split,  // continue at both x and y, x has the higher priority
+    Jump,  // continue at x
+    Save,  // save the current position to capture slot x
+    AssertBegin,
+    AssertEnd,
+    AssertWordBoundary,
+    AssertNotWordBoundary,
+    Match  // the pattern of index x matched, there is only one pattern unless the program belongs to a LinearRegexSet
+  };
+
+  struct Instruction {
+    OpCode op_code;
+    char c = 0;
+    uint32_t x = 0;
+    uint32_t y = 0;
+  };
+
+  // an entry point of the program, with the characters a match starting there can begin with
+  struct Start {
+    uint32_t pc = 0;
+    std::bitset<256> first_characters{};
+    bool matches_anywhere = false;  // it can match the empty string or its first character is not known
+  };
+
+  struct Automata;
+
+  LinearRegex();
+
+  void addStart(uint32_t pc);
+  [[nodiscard]] bool consumes(const Instruction& instruction, char c) const;
+  bool run(std::string_view subject, size_t start, bool full_match, std::vector<size_t>* captures) const;
+  // sets the matching patterns in matched, returns false if the DFA is not available
+  bool runAutomaton(std::string_view subject, bool full_match, std::vector<bool>& matched) const;
+
+  std::vector<Instruction> program_;
+  std::vector<std::bitset<256>> classes_;
+  std::vector<Start> starts_;  // in the order of their priorities
+  std::bitset<256> first_characters_;  // of all starts, no match can begin at other characters unless a start matches anywhere
+  bool matches_anywhere_ = false;
+  size_t group_count_ = 0;
+  std::shared_ptr<Automata> automata_;  // built on first use and shared by the copies
+};
+
+/**
+ * Several patterns compiled into a single program, so that one pass over the subject tells which of them match it.
+ * Routing a line by dozens of patterns costs about as much as matching it with the slowest of them, instead of their sum.
+ * The patterns are the ones supported by LinearRegex, their groups are not captured.
+ */
+class LinearRegexSet {
+ public:
+  static std::optional<LinearRegexSet> compile(std::span<const std::string> patterns, bool case_insensitive = false);
+
+  /// @return for each pattern whether it matches a part of subject
+  [[nodiscard]] std::vector<bool> search(std::string_view subject) const;
+
+  /// @return for each pattern whether it matches the whole subject
+  [[nodiscard]] std::vector<bool> fullMatch(std::string_view subject) const;
+
+  [[nodiscard]] size_t size() const {
+    return pattern_count_;
+  }
+
+ private:
+  LinearRegexSet() = default;
+
+  [[nodiscard]] std::vector<bool> run(std::string_view subject, bool full_match) const;
+
+  LinearRegex regex_;
+  std::vector<uint32_t> pattern_of_instruction_;
+  size_t pattern_count_ = 0;
+};
+
+}  // namespace org::apache::nifi::minifi::utils
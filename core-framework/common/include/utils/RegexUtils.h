@@ -18,6 +18,7 @@
 
 #pragma once
 
+#include <memory>
 #include <string>
 #include <string_view>
 #include <vector>
@@ -36,6 +37,13 @@
 namespace org::apache::nifi::minifi::utils {
 
 class Regex;
+class LinearRegex;
+
+/// Selects how the processors evaluate the regular expressions of their users
+enum class RegexEngine {
+  Standard,  // regex.h with libstdc++, std::regex otherwise
+  Linear  // LinearRegex for the patterns it supports, the standard engine for the rest
+};
 
 #ifdef NO_MORE_REGFREEE
 using SMatch = std::smatch;
@@ -89,6 +97,7 @@ class SMatch {
   };
 
   void reset(std::string str);
+  void assignCaptures(const std::vector<size_t>& captures);
 
   bool ready_{false};
   std::vector<Regmatch> matches_;
@@ -105,7 +114,10 @@ class SMatch {
 
 class Regex {
  public:
-  enum class Mode { ICASE };
+  enum class Mode {
+    ICASE,
+    LINEAR  // evaluate the pattern as ECMAScript with LinearRegex if it supports the pattern, matching takes linear time then
+  };
 
   Regex();
   explicit Regex(std::string value);
@@ -121,6 +133,7 @@ class Regex {
  private:
   std::string regex_str_;
   bool valid_;
+  std::shared_ptr<const LinearRegex> linear_regex_;
 
 #ifdef NO_MORE_REGFREEE
   std::regex compiled_regex_;
@@ -133,6 +146,13 @@ class Regex {
   int regex_mode_;
 #endif
 
+  friend bool regexMatch(const char* str, const Regex& regex);
+  friend bool regexSearch(const char* str, const Regex& regex);
+  friend bool regexMatch(const std::string_view& str, const Regex& regex);
+  friend bool regexSearch(const std::string_view& str, const Regex& regex);
+  friend bool regexMatch(const std::string& str, const Regex& regex);
+  friend bool regexSearch(const std::string& str, const Regex& regex);
+
   friend bool regexMatch(const char* str, CMatch& match, const Regex& regex);
   friend bool regexSearch(const char* str, CMatch& match, const Regex& regex);
 
@@ -0,0 +1,411 @@
+/**
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The ASF licenses this file to You under the Apache License, Version 2.0
+ * (the "License"); you may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "utils/ByteScanner.h"
+
+#include <algorithm>
+#include <bit>
+#include <cstdint>
+#include <utility>
+
+#include "minifi-cpp/utils/gsl.h"
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define MINIFI_BYTE_SCANNER_SSE2
+#include <emmintrin.h>
+#if defined(__x86_64__) || defined(_M_X64)
+// AVX2 is not part of the x86-64 baseline, its functions are compiled for it using the target attribute, and they are only called after runtime detection
+#define MINIFI_BYTE_SCANNER_AVX2
+#include <immintrin.h>
+#ifdef _MSC_VER
+#include <intrin.h>
+#define MINIFI_TARGET_AVX2
+#else
+#define MINIFI_TARGET_AVX2 __attribute__((target("avx2")))
+#endif
+#endif
+#elif defined(__ARM_NEON) || defined(_M_ARM64)
+#define MINIFI_BYTE_SCANNER_NEON
+#include <arm_neon.h>
+#endif
+
+namespace org::apache::nifi::minifi::utils {
+
+namespace {
+
+// The vectorized functions below search the full blocks starting at pos. They return the position of the first match,
+// or npos after advancing pos to the first byte not covered by a full block, where the caller continues with the scalar search.
+
+#ifdef MINIFI_BYTE_SCANNER_SSE2
+// The blocks are compared in strides of 64 bytes, and only one test is done for the whole stride, the positions of the matches are only computed
+// for the strides containing a match. The positions in a stride fit in a 64 bit mask.
+constexpr size_t STRIDE_SIZE = 64;
+constexpr size_t SSE2_BLOCK_SIZE = 16;
+
+// the set bits of the mask are the positions relative to pos where the first and the last bytes of the delimiter match
+size_t findDelimiterCandidate(std::string_view delimiter, std::string_view data, size_t pos, uint64_t mask) {
+  for (; mask != 0; mask &= mask - 1) {
+    const size_t candidate = pos + std::countr_zero(mask);
+    if (data.substr(candidate, delimiter.size()) == delimiter) {
+      return candidate;
+    }
+  }
+  return std::string_view::npos;
+}
+
+__m128i loadSse2(const char* block_start) {
+  return _mm_loadu_si128(reinterpret_cast<const __m128i*>(block_start));
+}
+
+__m128i matchAnyByteSse2(const __m128i* needles, size_t byte_count, const char* block_start) {
+  const __m128i block = loadSse2(block_start);
+  __m128i matches = _mm_cmpeq_epi8(block, needles[0]);
+  for (size_t i = 1; i < byte_count; ++i) {
+    matches = _mm_or_si128(matches, _mm_cmpeq_epi8(block, needles[i]));
+  }
+  return matches;
+}
+
+__m128i matchDelimiterEndsSse2(__m128i first_needle, __m128i last_needle, size_t last_offset, const char* block_start) {
+  return _mm_and_si128(_mm_cmpeq_epi8(loadSse2(block_start), first_needle), _mm_cmpeq_epi8(loadSse2(block_start + last_offset), last_needle));
+}
+
+uint64_t maskSse2(__m128i matches) {
+  return static_cast<uint16_t>(_mm_movemask_epi8(matches));
+}
+
+uint64_t strideMaskSse2(__m128i matches0, __m128i matches1, __m128i matches2, __m128i matches3) {
+  return maskSse2(matches0) | maskSse2(matches1) << 16U | maskSse2(matches2) << 32U | maskSse2(matches3) << 48U;
+}
+
+bool anyMatchSse2(__m128i matches0, __m128i matches1, __m128i matches2, __m128i matches3) {
+  return _mm_movemask_epi8(_mm_or_si128(_mm_or_si128(matches0, matches1), _mm_or_si128(matches2, matches3))) != 0;
+}
+
+size_t findAnyByteSse2(const std::array<char, ByteSetScanner::MAX_BYTES>& bytes, size_t byte_count, std::string_view data, size_t& pos) {
+  __m128i needles[ByteSetScanner::MAX_BYTES];  // NOLINT(cppcoreguidelines-avoid-c-arrays), std::array would drop the alignment attributes
+  for (size_t i = 0; i < byte_count; ++i) {
+    needles[i] = _mm_set1_epi8(bytes[i]);
+  }
+  for (; pos + STRIDE_SIZE <= data.size(); pos += STRIDE_SIZE) {
+    const char* const stride_start = data.data() + pos;
+    const __m128i matches0 = matchAnyByteSse2(needles, byte_count, stride_start);
+    const __m128i matches1 = matchAnyByteSse2(needles, byte_count, stride_start + SSE2_BLOCK_SIZE);
+    const __m128i matches2 = matchAnyByteSse2(needles, byte_count, stride_start + 2 * SSE2_BLOCK_SIZE);
+    const __m128i matches3 = matchAnyByteSse2(needles, byte_count, stride_start + 3 * SSE2_BLOCK_SIZE);
+    if (anyMatchSse2(matches0, matches1, matches2, matches3)) {
+      return pos + std::countr_zero(strideMaskSse2(matches0, matches1, matches2, matches3));
+    }
+  }
+  for (; pos + SSE2_BLOCK_SIZE <= data.size(); pos += SSE2_BLOCK_SIZE) {
+    if (const uint64_t mask = maskSse2(matchAnyByteSse2(needles, byte_count, data.data() + pos)); mask != 0) {
+      return pos + std::countr_zero(mask);
+    }
+  }
+  return std::string_view::npos;
+}
+
+size_t findDelimiterSse2(std::string_view delimiter, std::string_view data, size_t& pos) {
+  const size_t last_offset = delimiter.size() - 1;
+  const __m128i first_needle = _mm_set1_epi8(delimiter.front());
+  const __m128i last_needle = _mm_set1_epi8(delimiter.back());
+  for (; pos + last_offset + STRIDE_SIZE <= data.size(); pos += STRIDE_SIZE) {
+    const char* const stride_start = data.data() + pos;
+    const __m128i matches0 = matchDelimiterEndsSse2(first_needle, last_needle, last_offset, stride_start);
+    const __m128i matches1 = matchDelimiterEndsSse2(first_needle, last_needle, last_offset, stride_start + SSE2_BLOCK_SIZE);
+    const __m128i matches2 = matchDelimiterEndsSse2(first_needle, last_needle, last_offset, stride_start + 2 * SSE2_BLOCK_SIZE);
+    const __m128i matches3 = matchDelimiterEndsSse2(first_needle, last_needle, last_offset, stride_start + 3 * SSE2_BLOCK_SIZE);
+    if (anyMatchSse2(matches0, matches1, matches2, matches3)) {
+      if (const auto position = findDelimiterCandidate(delimiter, data, pos, strideMaskSse2(matches0, matches1, matches2, matches3)); position != std::string_view::npos) {
+        return position;
+      }
+    }
+  }
+  for (; pos + last_offset + SSE2_BLOCK_SIZE <= data.size(); pos += SSE2_BLOCK_SIZE) {
+    if (const auto position = findDelimiterCandidate(delimiter, data, pos, maskSse2(matchDelimiterEndsSse2(first_needle, last_needle, last_offset, data.data() + pos)));
+        position != std::string_view::npos) {
+      return position;
+    }
+  }
+  return std::string_view::npos;
+}
+#endif
+
+#ifdef MINIFI_BYTE_SCANNER_AVX2
+constexpr size_t AVX2_BLOCK_SIZE = 32;
+
+// lambdas would not inherit the target attribute, so the helpers of the AVX2 functions are separate functions as well
+MINIFI_TARGET_AVX2 __m256i loadAvx2(const char* block_start) {
+  return _mm256_loadu_si256(reinterpret_cast<const __m256i*>(block_start));
+}
+
+MINIFI_TARGET_AVX2 __m256i matchAnyByteAvx2(const __m256i* needles, size_t byte_count, const char* block_start) {
+  const __m256i block = loadAvx2(block_start);
+  __m256i matches = _mm256_cmpeq_epi8(block, needles[0]);
+  for (size_t i = 1; i < byte_count; ++i) {
+    matches = _mm256_or_si256(matches, _mm256_cmpeq_epi8(block, needles[i]));
+  }
+  return matches;
+}
+
+MINIFI_TARGET_AVX2 __m256i matchDelimiterEndsAvx2(__m256i first_needle, __m256i last_needle, size_t last_offset, const char* block_start) {
+  return _mm256_and_si256(_mm256_cmpeq_epi8(loadAvx2(block_start), first_needle), _mm256_cmpeq_epi8(loadAvx2(block_start + last_offset), last_needle));
+}
+
+MINIFI_TARGET_AVX2 uint64_t maskAvx2(__m256i matches) {
+  return static_cast<uint32_t>(_mm256_movemask_epi8(matches));
+}
+
+MINIFI_TARGET_AVX2 bool anyMatchAvx2(__m256i matches0, __m256i matches1) {
+  const __m256i matches = _mm256_or_si256(matches0, matches1);
+  return _mm256_testz_si256(matches, matches) == 0;
+}
+
+MINIFI_TARGET_AVX2 size_t findAnyByteAvx2(const std::array<char, ByteSetScanner::MAX_BYTES>& bytes, size_t byte_count, std::string_view data, size_t& pos) {
+  __m256i needles[ByteSetScanner::MAX_BYTES];  // NOLINT(cppcoreguidelines-avoid-c-arrays), std::array would drop the alignment attributes
+  for (size_t i = 0; i < byte_count; ++i) {
+    needles[i] = _mm256_set1_epi8(bytes[i]);
+  }
+  for (; pos + STRIDE_SIZE <= data.size(); pos += STRIDE_SIZE) {
+    const char* const stride_start = data.data() + pos;
+    const __m256i matches0 = matchAnyByteAvx2(needles, byte_count, stride_start);
+    const __m256i matches1 = matchAnyByteAvx2(needles, byte_count, stride_start + AVX2_BLOCK_SIZE);
+    if (anyMatchAvx2(matches0, matches1)) {
+      return pos + std::countr_zero(maskAvx2(matches0) | maskAvx2(matches1) << 32U);
+    }
+  }
+  for (; pos + AVX2_BLOCK_SIZE <= data.size(); pos += AVX2_BLOCK_SIZE) {
+    if (const uint64_t mask = maskAvx2(matchAnyByteAvx2(needles, byte_count, data.data() + pos)); mask != 0) {
+      return pos + std::countr_zero(mask);
+    }
+  }
+  return std::string_view::npos;
+}
+
+MINIFI_TARGET_AVX2 size_t findDelimiterAvx2(std::string_view delimiter, std::string_view data, size_t& pos) {
+  const size_t last_offset = delimiter.size() - 1;
+  const __m256i first_needle = _mm256_set1_epi8(delimiter.front());
+  const __m256i last_needle = _mm256_set1_epi8(delimiter.back());
+  for (; pos + last_offset + STRIDE_SIZE <= data.size(); pos += STRIDE_SIZE) {
+    const char* const stride_start = data.data() + pos;
+    const __m256i matches0 = matchDelimiterEndsAvx2(first_needle, last_needle, last_offset, stride_start);
+    const __m256i matches1 = matchDelimiterEndsAvx2(first_needle, last_needle, last_offset, stride_start + AVX2_BLOCK_SIZE);
+    if (anyMatchAvx2(matches0, matches1)) {
+      if (const auto position = findDelimiterCandidate(delimiter, data, pos, maskAvx2(matches0) | maskAvx2(matches1) << 32U); position != std::string_view::npos) {
+        return position;
+      }
+    }
+  }
+  for (; pos + last_offset + AVX2_BLOCK_SIZE <= data.size(); pos += AVX2_BLOCK_SIZE) {
+    if (const auto position = findDelimiterCandidate(delimiter, data, pos, maskAvx2(matchDelimiterEndsAvx2(first_needle, last_needle, last_offset, data.data() + pos)));
+        position != std::string_view::npos) {
+      return position;
+    }
+  }
+  return std::string_view::npos;
+}
+
+bool isAvx2Supported() {
+#ifdef _MSC_VER
+  std::array<int, 4> registers{};
+  __cpuid(registers.data(), 0);
+  if (registers[0] < 7) {
+    return false;
+  }
+  __cpuid(registers.data(), 1);
+  const bool os_saves_ymm_registers = (registers[2] & (1 << 27)) != 0 && (_xgetbv(0) & 0x6) == 0x6;
+  __cpuidex(registers.data(), 7, 0);
+  return os_saves_ymm_registers && (registers[1] & (1 << 5)) != 0;
+#else
+  return __builtin_cpu_supports("avx2");
+#endif
+}
+#endif
+
+#ifdef MINIFI_BYTE_SCANNER_NEON
+constexpr size_t NEON_BLOCK_SIZE = 16;
+
+// NEON has no movemask, narrowing the 16 byte wide comparison result to 16 nibbles gives a 64 bit mask with 4 bits per byte
+uint64_t neonMask(uint8x16_t matches) {
+  return vget_lane_u64(vreinterpret_u64_u8(vshrn_n_u16(vreinterpretq_u16_u8(matches), 4)), 0);
+}
+
+size_t findAnyByteNeon(const std::array<char, ByteSetScanner::MAX_BYTES>& bytes, size_t byte_count, std::string_view data, size_t& pos) {
+  uint8x16_t needles[ByteSetScanner::MAX_BYTES];  // NOLINT(cppcoreguidelines-avoid-c-arrays)
+  for (size_t i = 0; i < byte_count; ++i) {
+    needles[i] = vdupq_n_u8(static_cast<uint8_t>(bytes[i]));
+  }
+  for (; pos + NEON_BLOCK_SIZE <= data.size(); pos += NEON_BLOCK_SIZE) {
+    const uint8x16_t block = vld1q_u8(reinterpret_cast<const uint8_t*>(data.data() + pos));
+    uint8x16_t matches = vceqq_u8(block, needles[0]);
+    for (size_t i = 1; i < byte_count; ++i) {
+      matches = vorrq_u8(matches, vceqq_u8(block, needles[i]));
+    }
+    if (const uint64_t mask = neonMask(matches); mask != 0) {
+      return pos + std::countr_zero(mask) / 4;
+    }
+  }
+  return std::string_view::npos;
+}
+
+size_t findDelimiterNeon(std::string_view delimiter, std::string_view data, size_t& pos) {
+  const size_t last_offset = delimiter.size() - 1;
+  const uint8x16_t first_needle = vdupq_n_u8(static_cast<uint8_t>(delimiter.front()));
+  const uint8x16_t last_needle = vdupq_n_u8(static_cast<uint8_t>(delimiter.back()));
+  for (; pos + last_offset + NEON_BLOCK_SIZE <= data.size(); pos += NEON_BLOCK_SIZE) {
+    const auto* const block_start = reinterpret_cast<const uint8_t*>(data.data() + pos);
+    const uint8x16_t matches = vandq_u8(vceqq_u8(vld1q_u8(block_start), first_needle), vceqq_u8(vld1q_u8(block_start + last_offset), last_needle));
+    // keeping a single bit of each nibble, so every set bit is a candidate position
+    for (uint64_t mask = neonMask(matches) & 0x8888888888888888; mask != 0; mask &= mask - 1) {
+      const size_t candidate = pos + std::countr_zero(mask) / 4;
+      if (data.substr(candidate, delimiter.size()) == delimiter) {
+        return candidate;
+      }
+    }
+  }
+  return std::string_view::npos;
+}
+#endif
+
+std::vector<VectorInstructionSet> detectVectorInstructionSets() {
+  std::vector<VectorInstructionSet> instruction_sets{VectorInstructionSet::Scalar};
+#ifdef MINIFI_BYTE_SCANNER_SSE2
+  instruction_sets.push_back(VectorInstructionSet::SSE2);
+#endif
+#ifdef MINIFI_BYTE_SCANNER_AVX2
+  if (isAvx2Supported()) {
+    instruction_sets.push_back(VectorInstructionSet::AVX2);
+  }
+#endif
+#ifdef MINIFI_BYTE_SCANNER_NEON
+  instruction_sets.push_back(VectorInstructionSet::NEON);
+#endif
+  return instruction_sets;
+}
+
+bool isSupported(VectorInstructionSet instruction_set) {
+  return std::ranges::find(getSupportedVectorInstructionSets(), instruction_set) != getSupportedVectorInstructionSets().end();
+}
+
+}  // namespace
+
+const std::vector<VectorInstructionSet>& getSupportedVectorInstructionSets() {
+  static const std::vector<VectorInstructionSet> instruction_sets = detectVectorInstructionSets();
+  return instruction_sets;
+}
+
+VectorInstructionSet getVectorInstructionSet() {
+  static const VectorInstructionSet instruction_set = getSupportedVectorInstructionSets().back();
+  return instruction_set;
+}
+
+ByteSetScanner::ByteSetScanner(std::string_view bytes, VectorInstructionSet instruction_set)
+    : instruction_set_(instruction_set) {
+  gsl_Expects(bytes.size() <= MAX_BYTES && isSupported(instruction_set));
+  for (const char c : bytes) {
+    if (!contains(c)) {
+      table_[static_cast<unsigned char>(c)] = true;
+      bytes_[byte_count_++] = c;
+    }
+  }
+}
+
+size_t ByteSetScanner::find(std::string_view data, size_t pos) const {
+  if (byte_count_ == 0) {
+    return std::string_view::npos;
+  }
+  if (byte_count_ == 1) {
+    // memchr is vectorized by the C library already, and does not need the fallback loop for the tail of the data
+    return data.find(bytes_[0], pos);
+  }
+
+  size_t result = std::string_view::npos;
+  switch (instruction_set_) {
+#ifdef MINIFI_BYTE_SCANNER_SSE2
+    case VectorInstructionSet::SSE2:
+      result = findAnyByteSse2(bytes_, byte_count_, data, pos);
+      break;
+#endif
+#ifdef MINIFI_BYTE_SCANNER_AVX2
+    case VectorInstructionSet::AVX2:
+      result = findAnyByteAvx2(bytes_, byte_count_, data, pos);
+      break;
+#endif
+#ifdef MINIFI_BYTE_SCANNER_NEON
+    case VectorInstructionSet::NEON:
+      result = findAnyByteNeon(bytes_, byte_count_, data, pos);
+      break;
+#endif
+    default:
+      break;
+  }
+  if (result != std::string_view::npos) {
+    return result;
+  }
+
+  for (; pos < data.size(); ++pos) {
+    if (contains(data[pos])) {
+      return pos;
+    }
+  }
+  return std::string_view::npos;
+}
+
+DelimiterScanner::DelimiterScanner(std::string delimiter, VectorInstructionSet instruction_set)
+    : delimiter_(std::move(delimiter)),
+      instruction_set_(instruction_set) {
+  gsl_Expects(!delimiter_.empty() && isSupported(instruction_set));
+}
+
+size_t DelimiterScanner::find(std::string_view data, size_t pos) const {
+  if (delimiter_.size() == 1) {
+    return data.find(delimiter_[0], pos);
+  }
+  if (instruction_set_ == VectorInstructionSet::Scalar) {
+    return data.find(delimiter_, pos);
+  }
+  if (pos > data.size()) {
+    return std::string_view::npos;
+  }
+
+  size_t result = std::string_view::npos;
+  switch (instruction_set_) {
+#ifdef MINIFI_BYTE_SCANNER_SSE2
+    case VectorInstructionSet::SSE2:
+      result = findDelimiterSse2(delimiter_, data, pos);
+      break;
+#endif
+#ifdef MINIFI_BYTE_SCANNER_AVX2
+    case VectorInstructionSet::AVX2:
+      result = findDelimiterAvx2(delimiter_, data, pos);
+      break;
+#endif
+#ifdef MINIFI_BYTE_SCANNER_NEON
+    case VectorInstructionSet::NEON:
+      result = findDelimiterNeon(delimiter_, data, pos);
+      break;
+#endif
+    default:
+      break;
+  }
+  if (result != std::string_view::npos) {
+    return result;
+  }
+  return data.find(delimiter_, pos);
+}
+
+}  // namespace org::apache::nifi::minifi::utils
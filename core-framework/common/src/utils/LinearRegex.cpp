@@ -0,0 +1,1190 @@
+/**
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The ASF licenses this file to You under the Apache License, Version 2.0
+ * (the "License"); you may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "utils/LinearRegex.h"
+
+#include <algorithm>
+#include <array>
+#include <cctype>
+#include <map>
+#include <mutex>
+#include <span>
+#include <utility>
+
+#include "minifi-cpp/utils/gsl.h"
+
+namespace org::apache::nifi::minifi::utils {
+
+namespace {
+constexpr size_t UNBOUNDED = std::numeric_limits<size_t>::max();
+constexpr size_t MAX_REPETITION_BOUND = 1000;
+
+bool isWordCharacter(char c) {
+  return std::isalnum(static_cast<unsigned char>(c)) || c == '_';
+}
+
+std::optional<uint8_t> hexValue(char c) {
+  if (c >= '0' && c <= '9') { return gsl::narrow<uint8_t>(c - '0'); }
+  if (c >= 'a' && c <= 'f') { return gsl::narrow<uint8_t>(c - 'a' + 10); }
+  if (c >= 'A' && c <= 'F') { return gsl::narrow<uint8_t>(c - 'A' + 10); }
+  return std::nullopt;
+}
+
+std::bitset<256> characterClassOf(char escape) {
+  std::bitset<256> set;
+  for (int c = 0; c < 256; ++c) {
+    const auto ch = static_cast<char>(c);
+    switch (std::tolower(static_cast<unsigned char>(escape))) {
+      case 'd': set[c] = ch >= '0' && ch <= '9'; break;
+      case 'w': set[c] = isWordCharacter(ch); break;
+      case 's': set[c] = ch == ' ' || ch == '\t' || ch == '\n' || ch == '\r' || ch == '\f' || ch == '\v'; break;
+      default: break;
+    }
+  }
+  return std::isupper(static_cast<unsigned char>(escape)) ? ~set : set;
+}
+
+void addOtherCases(std::bitset<256>& set) {
+  for (int c = 'a'; c <= 'z'; ++c) {
+    const int upper = c - 'a' + 'A';
+    if (set[c] || set[upper]) {
+      set.set(c);
+      set.set(upper);
+    }
+  }
+}
+}  // namespace
+
+/// Parses the supported subset of the ECMAScript grammar and lowers it to a Pike VM program
+class PatternCompiler {
+ public:
+  PatternCompiler(bool case_insensitive, LinearRegex& regex) : case_insensitive_(case_insensitive), regex_(regex) {}
+
+  bool compile(std::string_view pattern) {
+    auto root = parse(pattern);
+    if (!root) {
+      return false;
+    }
+    regex_.group_count_ = group_count_;
+    emit({.op_code = LinearRegex::OpCode::Save, .x = 0});
+    if (!lower(*root)) {
+      return false;
+    }
+    emit({.op_code = LinearRegex::OpCode::Save, .x = 1});
+    emit({.op_code = LinearRegex::OpCode::Match});
+    if (regex_.program_.size() > LinearRegex::MAX_PROGRAM_SIZE) {
+      return false;
+    }
+    regex_.addStart(0);
+    return true;
+  }
+
+  // the patterns are lowered one after the other, each of them is a start of the program and ends in a Match of its own index
+  bool compileSet(std::span<const std::string> patterns, std::vector<uint32_t>& pattern_of_instruction) {
+    std::vector<uint32_t> entries;
+    for (size_t i = 0; i < patterns.size(); ++i) {
+      auto root = parse(patterns[i]);
+      if (!root) {
+        return false;
+      }
+      entries.push_back(next());
+      if (!lower(*root)) {
+        return false;
+      }
+      emit({.op_code = LinearRegex::OpCode::Match, .x = gsl::narrow<uint32_t>(i)});
+      pattern_of_instruction.resize(regex_.program_.size(), gsl::narrow<uint32_t>(i));
+    }
+    if (regex_.program_.size() > LinearRegex::MAX_PROGRAM_SIZE) {
+      return false;
+    }
+    for (const auto entry : entries) {
+      regex_.addStart(entry);
+    }
+    return true;
+  }
+
+ private:
+  struct Node {
+    enum class Type { Char, Any, Class, Assert, Group, Concat, Alternate, Repeat };
+
+    Type type;
+    char c = 0;  // Char
+    std::bitset<256> set{};  // Class
+    LinearRegex::OpCode assertion = LinearRegex::OpCode::AssertBegin;  // Assert
+    uint32_t group = 0;  // Group
+    size_t min = 0;  // Repeat
+    size_t max = 0;  // Repeat
+    bool greedy = true;  // Repeat
+    std::vector<Node> children{};  // Group, Concat, Alternate, Repeat
+  };
+
+  std::optional<Node> parse(std::string_view pattern) {
+    pattern_ = pattern;
+    pos_ = 0;
+    group_count_ = 0;
+    auto root = parseAlternation();
+    if (!root || pos_ != pattern_.size()) {
+      return std::nullopt;
+    }
+    return root;
+  }
+
+  [[nodiscard]] bool atEnd() const { return pos_ >= pattern_.size(); }
+  [[nodiscard]] char peek() const { return pattern_[pos_]; }
+
+  bool consume(char c) {
+    if (!atEnd() && peek() == c) {
+      ++pos_;
+      return true;
+    }
+    return false;
+  }
+
+  std::optional<Node> parseAlternation() {
+    auto first = parseConcatenation();
+    if (!first || !consume('|')) {
+      return first;
+    }
+    Node alternation{.type = Node::Type::Alternate};
+    alternation.children.push_back(std::move(*first));
+    do {
+      auto next = parseConcatenation();
+      if (!next) {
+        return std::nullopt;
+      }
+      alternation.children.push_back(std::move(*next));
+    } while (consume('|'));
+    return alternation;
+  }
+
+  std::optional<Node> parseConcatenation() {
+    Node concatenation{.type = Node::Type::Concat};
+    while (!atEnd() && peek() != '|' && peek() != ')') {
+      auto repetition = parseRepetition();
+      if (!repetition) {
+        return std::nullopt;
+      }
+      concatenation.children.push_back(std::move(*repetition));
+    }
+    return concatenation;
+  }
+
+  std::optional<Node> parseRepetition() {
+    auto atom = parseAtom();
+    if (!atom || atEnd()) {
+      return atom;
+    }
+
+    size_t min = 0;
+    size_t max = UNBOUNDED;
+    switch (peek()) {
+      case '*': ++pos_; break;
+      case '+': ++pos_; min = 1; break;
+      case '?': ++pos_; max = 1; break;
+      case '{':
+        ++pos_;
+        if (!parseBounds(min, max)) {
+          return std::nullopt;
+        }
+        break;
+      default:
+        return atom;
+    }
+    if (atom->type == Node::Type::Assert) {
+      return std::nullopt;
+    }
+    const bool greedy = !consume('?');
+    if (!atEnd() && (peek() == '*' || peek() == '+' || peek() == '?' || peek() == '{')) {
+      return std::nullopt;
+    }
+
+    Node repetition{.type = Node::Type::Repeat, .min = min, .max = max, .greedy = greedy};
+    repetition.children.push_back(std::move(*atom));
+    return repetition;
+  }
+
+  std::optional<size_t> parseNumber() {
+    const auto begin = pos_;
+    size_t number = 0;
+    while (!atEnd() && std::isdigit(static_cast<unsigned char>(peek()))) {
+      number = number * 10 + gsl::narrow<size_t>(peek() - '0');
+      if (number > MAX_REPETITION_BOUND) {
+        return std::nullopt;
+      }
+      ++pos_;
+    }
+    return pos_ == begin ? std::nullopt : std::optional<size_t>(number);
+  }
+
+  bool parseBounds(size_t& min, size_t& max) {
+    const auto lower_bound = parseNumber();
+    if (!lower_bound) {
+      return false;
+    }
+    min = *lower_bound;
+    max = min;
+    if (consume(',')) {
+      max = UNBOUNDED;
+      if (!atEnd() && peek() != '}') {
+        const auto upper_bound = parseNumber();
+        if (!upper_bound || *upper_bound < min) {
+          return false;
+        }
+        max = *upper_bound;
+      }
+    }
+    return consume('}');
+  }
+
+  std::optional<Node> parseAtom() {
+    const char c = pattern_[pos_++];
+    switch (c) {
+      case '.': return Node{.type = Node::Type::Any};
+      case '^': return Node{.type = Node::Type::Assert, .assertion = LinearRegex::OpCode::AssertBegin};
+      case '$': return Node{.type = Node::Type::Assert, .assertion = LinearRegex::OpCode::AssertEnd};
+      case '(': return parseGroup();
+      case '[': return parseClass();
+      case '\\': return parseEscape();
+      case ')': case '*': case '+': case '?': case '{': case '}': case ']':
+        return std::nullopt;
+      default:
+        return literal(c);
+    }
+  }
+
+  std::optional<Node> parseGroup() {
+    std::optional<uint32_t> group;
+    if (consume('?')) {
+      if (!consume(':')) {  // lookarounds
+        return std::nullopt;
+      }
+    } else {
+      group = ++group_count_;
+    }
+    auto inner = parseAlternation();
+    if (!inner || !consume(')')) {
+      return std::nullopt;
+    }
+    if (!group) {
+      return inner;
+    }
+    Node capture{.type = Node::Type::Group, .group = *group};
+    capture.children.push_back(std::move(*inner));
+    return capture;
+  }
+
+  std::optional<Node> parseEscape() {
+    if (atEnd()) {
+      return std::nullopt;
+    }
+    const char c = pattern_[pos_++];
+    switch (c) {
+      case 'b': return Node{.type = Node::Type::Assert, .assertion = LinearRegex::OpCode::AssertWordBoundary};
+      case 'B': return Node{.type = Node::Type::Assert, .assertion = LinearRegex::OpCode::AssertNotWordBoundary};
+      case 'd': case 'D': case 'w': case 'W': case 's': case 'S': return classNode(characterClassOf(c));
+      default: {
+        const auto character = parseCharacterEscape(c);
+        if (!character) {
+          return std::nullopt;
+        }
+        return literal(*character);
+      }
+    }
+  }
+
+  std::optional<char> parseCharacterEscape(char c) {
+    switch (c) {
+      case 't': return '\t';
+      case 'n': return '\n';
+      case 'r': return '\r';
+      case 'f': return '\f';
+      case 'v': return '\v';
+      case '0':
+        if (!atEnd() && std::isdigit(static_cast<unsigned char>(peek()))) {
+          return std::nullopt;
+        }
+        return '\0';
+      case 'x': {
+        if (pos_ + 2 > pattern_.size()) {
+          return std::nullopt;
+        }
+        const auto high = hexValue(pattern_[pos_]);
+        const auto low = hexValue(pattern_[pos_ + 1]);
+        if (!high || !low) {
+          return std::nullopt;
+        }
+        pos_ += 2;
+        return static_cast<char>(*high * 16 + *low);
+      }
+      default:
+        // backreferences, control and unicode escapes are not supported
+        if (std::isalnum(static_cast<unsigned char>(c))) {
+          return std::nullopt;
+        }
+        return c;
+    }
+  }
+
+  // a class atom is either a single character, which can start a range, or a class escape like \d
+  bool parseClassAtom(std::optional<char>& character, std::bitset<256>& set) {
+    if (atEnd()) {
+      return false;
+    }
+    const char c = pattern_[pos_++];
+    if (c == '[' && !atEnd() && (peek() == ':' || peek() == '.' || peek() == '=')) {
+      return false;
+    }
+    if (c != '\\') {
+      character = c;
+      return true;
+    }
+    if (atEnd()) {
+      return false;
+    }
+    const char escape = pattern_[pos_++];
+    switch (escape) {
+      case 'd': case 'D': case 'w': case 'W': case 's': case 'S':
+        set = characterClassOf(escape);
+        return true;
+      case 'b':
+        character = '\b';
+        return true;
+      default:
+        character = parseCharacterEscape(escape);
+        return character.has_value();
+    }
+  }
+
+  std::optional<Node> parseClass() {
+    const bool negated = consume('^');
+    if (consume(']')) {
+      return std::nullopt;
+    }
+    std::bitset<256> set;
+    while (!consume(']')) {
+      std::optional<char> low;
+      std::bitset<256> escape_set;
+      if (!parseClassAtom(low, escape_set)) {
+        return std::nullopt;
+      }
+      if (!low) {
+        set |= escape_set;
+        continue;
+      }
+      if (pos_ + 1 < pattern_.size() && peek() == '-' && pattern_[pos_ + 1] != ']') {
+        ++pos_;
+        std::optional<char> high;
+        if (!parseClassAtom(high, escape_set) || !high || static_cast<unsigned char>(*high) < static_cast<unsigned char>(*low)) {
+          return std::nullopt;
+        }
+        for (int c = static_cast<unsigned char>(*low); c <= static_cast<unsigned char>(*high); ++c) {
+          set.set(c);
+        }
+      } else {
+        set.set(static_cast<unsigned char>(*low));
+      }
+    }
+    if (case_insensitive_) {
+      addOtherCases(set);
+    }
+    return classNode(negated ? ~set : set);
+  }
+
+  static Node classNode(const std::bitset<256>& set) {
+    return Node{.type = Node::Type::Class, .set = set};
+  }
+
+  Node literal(char c) const {
+    if (case_insensitive_ && std::isalpha(static_cast<unsigned char>(c))) {
+      std::bitset<256> set;
+      set.set(static_cast<unsigned char>(c));
+      addOtherCases(set);
+      return classNode(set);
+    }
+    return Node{.type = Node::Type::Char, .c = c};
+  }
+
+  size_t emit(LinearRegex::Instruction instruction) {
+    regex_.program_.push_back(instruction);
+    return regex_.program_.size() - 1;
+  }
+
+  [[nodiscard]] uint32_t next() const {
+    return gsl::narrow<uint32_t>(regex_.program_.size());
+  }
+
+  bool lower(const Node& node) {
+    if (regex_.program_.size() > LinearRegex::MAX_PROGRAM_SIZE) {
+      return false;
+    }
+    auto& program = regex_.program_;
+    switch (node.type) {
+      case Node::Type::Char:
+        emit({.op_code = LinearRegex::OpCode::Char, .c = node.c});
+        return true;
+      case Node::Type::Any:
+        emit({.op_code = LinearRegex::OpCode::Any});
+        return true;
+      case Node::Type::Class:
+        regex_.classes_.push_back(node.set);
+        emit({.op_code = LinearRegex::OpCode::Class, .x = gsl::narrow<uint32_t>(regex_.classes_.size() - 1)});
+        return true;
+      case Node::Type::Assert:
+        emit({.op_code = node.assertion});
+        return true;
+      case Node::Type::Group:
+        emit({.op_code = LinearRegex::OpCode::Save, .x = 2 * node.group});
+        if (!lower(node.children[0])) {
+          return false;
+        }
+        emit({.op_code = LinearRegex::OpCode::Save, .x = 2 * node.group + 1});
+        return true;
+      case Node::Type::Concat:
+        return std::all_of(node.children.begin(), node.children.end(), [this](const Node& child) { return lower(child); });
+      case Node::Type::Alternate: {
+        std::vector<size_t> jumps_to_end;
+        for (size_t i = 0; i < node.children.size(); ++i) {
+          const bool last = i + 1 == node.children.size();
+          const auto split = last ? 0 : emit({.op_code = LinearRegex::OpCode::Split});
+          if (!last) {
+            program[split].x = next();
+          }
+          if (!lower(node.children[i])) {
+            return false;
+          }
+          if (!last) {
+            jumps_to_end.push_back(emit({.op_code = LinearRegex::OpCode::Jump}));
+            program[split].y = next();
+          }
+        }
+        for (const auto jump : jumps_to_end) {
+          program[jump].x = next();
+        }
+        return true;
+      }
+      case Node::Type::Repeat:
+        return lowerRepetition(node);
+    }
+    return false;
+  }
+
+  // x{2,4} is lowered to xx(x(x)?)?, x{2,} to xxx*
+  bool lowerRepetition(const Node& node) {
+    auto& program = regex_.program_;
+    const auto& body = node.children[0];
+    for (size_t i = 0; i < node.min; ++i) {
+      if (!lower(body)) {
+        return false;
+      }
+    }
+
+    const auto set_branches = [&](size_t split, uint32_t body_start, uint32_t skip) {
+      program[split].x = node.greedy ? body_start : skip;
+      program[split].y = node.greedy ? skip : body_start;
+    };
+
+    if (node.max == UNBOUNDED) {
+      const auto split = emit({.op_code = LinearRegex::OpCode::Split});
+      if (!lower(body)) {
+        return false;
+      }
+      emit({.op_code = LinearRegex::OpCode::Jump, .x = gsl::narrow<uint32_t>(split)});
+      set_branches(split, gsl::narrow<uint32_t>(split + 1), next());
+      return true;
+    }
+
+    std::vector<size_t> splits;
+    for (size_t i = node.min; i < node.max; ++i) {
+      splits.push_back(emit({.op_code = LinearRegex::OpCode::Split}));
+      if (!lower(body)) {
+        return false;
+      }
+    }
+    for (const auto split : splits) {
+      set_branches(split, gsl::narrow<uint32_t>(split + 1), next());
+    }
+    return true;
+  }
+
+  bool case_insensitive_;
+  LinearRegex& regex_;
+  std::string_view pattern_;
+  size_t pos_ = 0;
+  uint32_t group_count_ = 0;
+};
+
+/// Simulates the program with one thread per instruction, in the order of their priorities
+class PikeVM {
+ public:
+  PikeVM(const LinearRegex& regex, std::string_view subject, size_t slot_count)
+      : regex_(regex),
+        subject_(subject),
+        slot_count_(slot_count),
+        current_(regex.program_.size(), slot_count),
+        next_(regex.program_.size(), slot_count),
+        scratch_(slot_count, LinearRegex::NPOS) {}
+
+  bool run(size_t start, bool full_match, std::vector<size_t>* captures) {
+    bool matched = false;
+    for (size_t pos = start;; ++pos) {
+      if (!matched && (!full_match || pos == start)) {
+        if (!full_match && current_.empty()) {
+          current_.clear();
+          pos = skipToCandidate(pos);
+        }
+        addStartThreads(pos);
+      }
+      if (current_.empty() && (matched || full_match || pos >= subject_.size())) {
+        break;
+      }
+
+      for (const auto pc : current_.threads()) {
+        const auto& instruction = regex_.program_[pc];
+        if (instruction.op_code == LinearRegex::OpCode::Match) {
+          if (full_match && pos != subject_.size()) {
+            continue;
+          }
+          if (!captures) {
+            return true;
+          }
+          matched = true;
+          const auto thread_captures = current_.captures(pc);
+          captures->assign(thread_captures.begin(), thread_captures.end());
+          break;  // the threads with lower priorities are cut
+        }
+        if (pos < subject_.size() && regex_.consumes(instruction, subject_[pos])) {
+          const auto thread_captures = current_.captures(pc);
+          std::copy(thread_captures.begin(), thread_captures.end(), scratch_.begin());
+          addThread(next_, pc + 1, pos + 1);
+        }
+      }
+
+      if (pos >= subject_.size()) {
+        break;
+      }
+      std::swap(current_, next_);
+      next_.clear();
+    }
+    return matched;
+  }
+
+  // unlike run(), a Match does not cut the threads with lower priorities, as they may belong to other patterns
+  void runSet(bool full_match, std::span<const uint32_t> pattern_of_instruction, std::vector<bool>& matched) {
+    auto remaining = matched.size();
+    for (size_t pos = 0;; ++pos) {
+      if (!full_match || pos == 0) {
+        if (!full_match && current_.empty()) {
+          current_.clear();
+          pos = skipToCandidate(pos);
+        }
+        addStartThreads(pos);
+      }
+      if (current_.empty() && (full_match || pos >= subject_.size())) {
+        break;
+      }
+
+      for (const auto pc : current_.threads()) {
+        const auto pattern = pattern_of_instruction[pc];
+        if (matched[pattern]) {
+          continue;
+        }
+        const auto& instruction = regex_.program_[pc];
+        if (instruction.op_code == LinearRegex::OpCode::Match) {
+          if (full_match && pos != subject_.size()) {
+            continue;
+          }
+          matched[pattern] = true;
+          if (--remaining == 0) {
+            return;
+          }
+          continue;
+        }
+        if (pos < subject_.size() && regex_.consumes(instruction, subject_[pos])) {
+          addThread(next_, pc + 1, pos + 1);
+        }
+      }
+
+      if (pos >= subject_.size()) {
+        break;
+      }
+      std::swap(current_, next_);
+      next_.clear();
+    }
+  }
+
+ private:
+  // no match can begin at a position where none of the starts can, so the scan jumps over them while no thread is alive
+  [[nodiscard]] size_t skipToCandidate(size_t pos) const {
+    if (pos == 0 || regex_.matches_anywhere_) {
+      return pos;
+    }
+    while (pos < subject_.size() && !regex_.first_characters_.test(static_cast<unsigned char>(subject_[pos]))) {
+      ++pos;
+    }
+    return pos;
+  }
+
+  // a start whose first characters do not contain the current one would die in this step, unless it is at the beginning of the subject
+  void addStartThreads(size_t pos) {
+    for (const auto& start : regex_.starts_) {
+      if (pos == 0 || start.matches_anywhere || (pos < subject_.size() && start.first_characters.test(static_cast<unsigned char>(subject_[pos])))) {
+        std::fill(scratch_.begin(), scratch_.end(), LinearRegex::NPOS);
+        addThread(current_, start.pc, pos);
+      }
+    }
+  }
+
+  class ThreadList {
+   public:
+    ThreadList(size_t program_size, size_t slot_count)
+        : sparse_(program_size), captures_(program_size * slot_count), slot_count_(slot_count) {
+      dense_.reserve(program_size);
+    }
+
+    [[nodiscard]] bool contains(uint32_t pc) const {
+      const auto index = sparse_[pc];
+      return index < dense_.size() && dense_[index] == pc;
+    }
+
+    void insert(uint32_t pc) {
+      sparse_[pc] = gsl::narrow<uint32_t>(dense_.size());
+      dense_.push_back(pc);
+    }
+
+    // the threads which wait for the next character or match, the rest of the visited instructions only prevent visiting them again
+    void addRunnable(uint32_t pc) {
+      runnable_.push_back(pc);
+    }
+
+    std::span<size_t> captures(uint32_t pc) {
+      return {captures_.data() + pc * slot_count_, slot_count_};
+    }
+
+    [[nodiscard]] const std::vector<uint32_t>& threads() const { return runnable_; }
+    [[nodiscard]] bool empty() const { return runnable_.empty(); }
+    void clear() {
+      dense_.clear();
+      runnable_.clear();
+    }
+
+   private:
+    std::vector<uint32_t> sparse_;
+    std::vector<uint32_t> dense_;
+    std::vector<uint32_t> runnable_;
+    std::vector<size_t> captures_;
+    size_t slot_count_;
+  };
+
+  struct Frame {
+    bool restore;  // restore captures[slot] to value, otherwise explore pc
+    uint32_t pc_or_slot;
+    size_t value = 0;
+  };
+
+  [[nodiscard]] bool isWordBoundary(size_t pos) const {
+    const bool word_before = pos > 0 && isWordCharacter(subject_[pos - 1]);
+    const bool word_after = pos < subject_.size() && isWordCharacter(subject_[pos]);
+    return word_before != word_after;
+  }
+
+  // follows the epsilon transitions from pc in priority order, scratch_ holds the captures of the thread
+  void addThread(ThreadList& list, uint32_t start_pc, size_t pos) {
+    stack_.push_back({.restore = false, .pc_or_slot = start_pc});
+    while (!stack_.empty()) {
+      const auto frame = stack_.back();
+      stack_.pop_back();
+      if (frame.restore) {
+        scratch_[frame.pc_or_slot] = frame.value;
+        continue;
+      }
+
+      auto pc = frame.pc_or_slot;
+      bool alive = true;
+      while (alive && !list.contains(pc)) {
+        list.insert(pc);
+        const auto& instruction = regex_.program_[pc];
+        switch (instruction.op_code) {
+          case LinearRegex::OpCode::Jump:
+            pc = instruction.x;
+            break;
+          case LinearRegex::OpCode::Split:
+            stack_.push_back({.restore = false, .pc_or_slot = instruction.y});
+            pc = instruction.x;
+            break;
+          case LinearRegex::OpCode::Save:
+            if (instruction.x < slot_count_) {
+              stack_.push_back({.restore = true, .pc_or_slot = instruction.x, .value = scratch_[instruction.x]});
+              scratch_[instruction.x] = pos;
+            }
+            ++pc;
+            break;
+          case LinearRegex::OpCode::AssertBegin:
+            alive = pos == 0;
+            ++pc;
+            break;
+          case LinearRegex::OpCode::AssertEnd:
+            alive = pos == subject_.size();
+            ++pc;
+            break;
+          case LinearRegex::OpCode::AssertWordBoundary:
+            alive = isWordBoundary(pos);
+            ++pc;
+            break;
+          case LinearRegex::OpCode::AssertNotWordBoundary:
+            alive = !isWordBoundary(pos);
+            ++pc;
+            break;
+          default:  // consuming instructions and Match wait for the next step
+            std::copy(scratch_.begin(), scratch_.end(), list.captures(pc).begin());
+            list.addRunnable(pc);
+            alive = false;
+            break;
+        }
+      }
+    }
+  }
+
+  const LinearRegex& regex_;
+  std::string_view subject_;
+  size_t slot_count_;
+  ThreadList current_;
+  ThreadList next_;
+  std::vector<size_t> scratch_;
+  std::vector<Frame> stack_;
+};
+
+namespace {
+struct Automaton {
+  std::array<uint16_t, 256> byte_classes{};
+  size_t class_count = 0;
+  std::vector<uint32_t> transitions;  // the next state, indexed by state * class_count + byte class
+  std::vector<uint32_t> transition_matches;  // the patterns matching before the character, indexed like transitions
+  std::vector<uint32_t> end_matches;  // the patterns matching at the end of the subject, indexed by state
+  std::vector<std::vector<uint32_t>> match_lists{{}};  // the lists of patterns referred to by the above, the first one is empty
+};
+}  // namespace
+
+struct LinearRegex::Automata {
+  std::once_flag search_flag;
+  std::optional<Automaton> search;
+  std::once_flag full_match_flag;
+  std::optional<Automaton> full_match;
+};
+
+/**
+ * Converts the program to a DFA by the subset construction, ignoring the captures.
+ * A state is the set of instructions to continue at, before following their epsilon transitions, as the assertions among those depend
+ * on the next character. A search adds the starts of the program at every position, a full match only at the beginning.
+ */
+class AutomatonBuilder {
+ public:
+  AutomatonBuilder(const LinearRegex& regex, bool full_match) : regex_(regex), full_match_(full_match), visited_(regex.program_.size(), 0) {
+    has_word_boundaries_ = std::any_of(regex.program_.begin(), regex.program_.end(), [](const auto& instruction) {
+      return instruction.op_code == LinearRegex::OpCode::AssertWordBoundary || instruction.op_code == LinearRegex::OpCode::AssertNotWordBoundary;
+    });
+  }
+
+  std::optional<Automaton> build() {
+    computeByteClasses();
+    intern(State{.pcs = {}, .at_begin = true});
+    for (size_t state_index = 0; state_index < states_.size(); ++state_index) {
+      const auto state = states_[state_index];
+      for (size_t byte_class = 0; byte_class < automaton_.class_count; ++byte_class) {
+        const char c = representatives_[byte_class];
+        std::vector<uint32_t> next_pcs;
+        std::vector<uint32_t> matches;
+        follow(state, c, next_pcs, matches);
+        std::sort(next_pcs.begin(), next_pcs.end());
+        next_pcs.erase(std::unique(next_pcs.begin(), next_pcs.end()), next_pcs.end());
+        const auto next = intern(State{.pcs = std::move(next_pcs), .at_begin = false, .after_word = has_word_boundaries_ && isWordCharacter(c)});
+        if (!next) {
+          return std::nullopt;
+        }
+        automaton_.transitions.push_back(*next);
+        automaton_.transition_matches.push_back(full_match_ ? 0 : internMatches(std::move(matches)));
+      }
+      std::vector<uint32_t> next_pcs;
+      std::vector<uint32_t> matches;
+      follow(state, std::nullopt, next_pcs, matches);
+      automaton_.end_matches.push_back(internMatches(std::move(matches)));
+    }
+    return std::move(automaton_);
+  }
+
+ private:
+  struct State {
+    std::vector<uint32_t> pcs;
+    bool at_begin = false;
+    bool after_word = false;
+
+    auto operator<=>(const State&) const = default;
+  };
+
+  // bytes are in the same class if no instruction and no assertion can tell them apart
+  void computeByteClasses() {
+    std::vector<std::bitset<256>> sets;
+    for (const auto& instruction : regex_.program_) {
+      if (instruction.op_code == LinearRegex::OpCode::Char) {
+        sets.emplace_back().set(static_cast<unsigned char>(instruction.c));
+      }
+    }
+    sets.emplace_back().set('\n').set('\r');
+    sets.insert(sets.end(), regex_.classes_.begin(), regex_.classes_.end());
+    if (has_word_boundaries_) {
+      auto& word_characters = sets.emplace_back();
+      for (int c = 0; c < 256; ++c) {
+        word_characters[c] = isWordCharacter(static_cast<char>(c));
+      }
+    }
+
+    std::array<uint32_t, 256> classes{};
+    uint32_t class_count = 1;
+    for (const auto& set : sets) {
+      std::map<std::pair<uint32_t, bool>, uint32_t> refined;
+      for (int c = 0; c < 256; ++c) {
+        classes[c] = refined.emplace(std::make_pair(classes[c], set.test(c)), gsl::narrow<uint32_t>(refined.size())).first->second;
+      }
+      class_count = gsl::narrow<uint32_t>(refined.size());
+    }
+    representatives_.assign(class_count, 0);
+    std::vector<bool> seen(class_count, false);
+    for (int c = 0; c < 256; ++c) {
+      automaton_.byte_classes[c] = gsl::narrow<uint16_t>(classes[c]);
+      if (!seen[classes[c]]) {
+        seen[classes[c]] = true;
+        representatives_[classes[c]] = static_cast<char>(c);
+      }
+    }
+    automaton_.class_count = class_count;
+  }
+
+  std::optional<uint32_t> intern(State state) {
+    if (const auto it = state_ids_.find(state); it != state_ids_.end()) {
+      return it->second;
+    }
+    if (states_.size() >= LinearRegex::MAX_AUTOMATON_STATES) {
+      return std::nullopt;
+    }
+    const auto id = gsl::narrow<uint32_t>(states_.size());
+    state_ids_.emplace(state, id);
+    states_.push_back(std::move(state));
+    return id;
+  }
+
+  uint32_t internMatches(std::vector<uint32_t> matches) {
+    if (matches.empty()) {
+      return 0;
+    }
+    std::sort(matches.begin(), matches.end());
+    matches.erase(std::unique(matches.begin(), matches.end()), matches.end());
+    const auto [it, inserted] = match_list_ids_.emplace(matches, gsl::narrow<uint32_t>(automaton_.match_lists.size()));
+    if (inserted) {
+      automaton_.match_lists.push_back(std::move(matches));
+    }
+    return it->second;
+  }
+
+  // follows the epsilon transitions of the state before consuming next, or at the end of the subject if next is std::nullopt
+  void follow(const State& state, std::optional<char> next, std::vector<uint32_t>& next_pcs, std::vector<uint32_t>& matches) {
+    ++generation_;
+    std::vector<uint32_t> stack(state.pcs.rbegin(), state.pcs.rend());
+    if (!full_match_ || state.at_begin) {
+      for (auto start = regex_.starts_.rbegin(); start != regex_.starts_.rend(); ++start) {
+        stack.push_back(start->pc);
+      }
+    }
+    const bool before_word = next && isWordCharacter(*next);
+    while (!stack.empty()) {
+      const auto pc = stack.back();
+      stack.pop_back();
+      if (visited_[pc] == generation_) {
+        continue;
+      }
+      visited_[pc] = generation_;
+      const auto& instruction = regex_.program_[pc];
+      switch (instruction.op_code) {
+        case LinearRegex::OpCode::Char:
+        case LinearRegex::OpCode::Any:
+        case LinearRegex::OpCode::Class:
+          if (next && regex_.consumes(instruction, *next)) {
+            next_pcs.push_back(pc + 1);
+          }
+          break;
+        case LinearRegex::OpCode::Split:
+          stack.push_back(instruction.y);
+          stack.push_back(instruction.x);
+          break;
+        case LinearRegex::OpCode::Jump:
+          stack.push_back(instruction.x);
+          break;
+        case LinearRegex::OpCode::Save:
+          stack.push_back(pc + 1);
+          break;
+        case LinearRegex::OpCode::AssertBegin:
+          if (state.at_begin) {
+            stack.push_back(pc + 1);
+          }
+          break;
+        case LinearRegex::OpCode::AssertEnd:
+          if (!next) {
+            stack.push_back(pc + 1);
+          }
+          break;
+        case LinearRegex::OpCode::AssertWordBoundary:
+          if (state.after_word != before_word) {
+            stack.push_back(pc + 1);
+          }
+          break;
+        case LinearRegex::OpCode::AssertNotWordBoundary:
+          if (state.after_word == before_word) {
+            stack.push_back(pc + 1);
+          }
+          break;
+        case LinearRegex::OpCode::Match:
+          matches.push_back(instruction.x);
+          break;
+      }
+    }
+  }
+
+  const LinearRegex& regex_;
+  bool full_match_;
+  bool has_word_boundaries_ = false;
+  Automaton automaton_;
+  std::vector<char> representatives_;
+  std::vector<State> states_;
+  std::map<State, uint32_t> state_ids_;
+  std::map<std::vector<uint32_t>, uint32_t> match_list_ids_;
+  std::vector<uint32_t> visited_;
+  uint32_t generation_ = 0;
+};
+
+LinearRegex::LinearRegex() : automata_(std::make_shared<Automata>()) {}
+
+bool LinearRegex::consumes(const Instruction& instruction, char c) const {
+  switch (instruction.op_code) {
+    case OpCode::Char: return c == instruction.c;
+    case OpCode::Any: return c != '\n' && c != '\r';
+    case OpCode::Class: return classes_[instruction.x].test(static_cast<unsigned char>(c));
+    default: return false;
+  }
+}
+
+bool LinearRegex::runAutomaton(std::string_view subject, bool full_match, std::vector<bool>& matched) const {
+  auto& flag = full_match ? automata_->full_match_flag : automata_->search_flag;
+  auto& automaton = full_match ? automata_->full_match : automata_->search;
+  std::call_once(flag, [&] { automaton = AutomatonBuilder(*this, full_match).build(); });
+  if (!automaton) {
+    return false;
+  }
+
+  auto remaining = gsl::narrow<size_t>(std::count(matched.begin(), matched.end(), false));
+  const auto record = [&](uint32_t match_list) {
+    for (const auto pattern : automaton->match_lists[match_list]) {
+      if (!matched[pattern]) {
+        matched[pattern] = true;
+        --remaining;
+      }
+    }
+    return remaining == 0;
+  };
+
+  uint32_t state = 0;
+  for (const char c : subject) {
+    const auto index = state * automaton->class_count + automaton->byte_classes[static_cast<unsigned char>(c)];
+    if (automaton->transition_matches[index] != 0 && record(automaton->transition_matches[index])) {
+      return true;
+    }
+    state = automaton->transitions[index];
+  }
+  record(automaton->end_matches[state]);
+  return true;
+}
+
+std::optional<LinearRegex> LinearRegex::compile(std::string_view pattern, bool case_insensitive) {
+  LinearRegex regex;
+  if (!PatternCompiler(case_insensitive, regex).compile(pattern)) {
+    return std::nullopt;
+  }
+  return regex;
+}
+
+void LinearRegex::addStart(uint32_t pc) {
+  Start start{.pc = pc};
+  std::vector<bool> visited(program_.size(), false);
+  std::vector<uint32_t> stack{pc};
+  while (!stack.empty()) {
+    const auto current = stack.back();
+    stack.pop_back();
+    if (visited[current]) {
+      continue;
+    }
+    visited[current] = true;
+    const auto& instruction = program_[current];
+    switch (instruction.op_code) {
+      case OpCode::Char:
+        start.first_characters.set(static_cast<unsigned char>(instruction.c));
+        break;
+      case OpCode::Any:
+        start.first_characters.set();
+        start.first_characters.reset('\n');
+        start.first_characters.reset('\r');
+        break;
+      case OpCode::Class:
+        start.first_characters |= classes_[instruction.x];
+        break;
+      case OpCode::Split:
+        stack.push_back(instruction.y);
+        stack.push_back(instruction.x);
+        break;
+      case OpCode::Jump:
+        stack.push_back(instruction.x);
+        break;
+      case OpCode::Save:
+      case OpCode::AssertEnd:
+      case OpCode::AssertWordBoundary:
+      case OpCode::AssertNotWordBoundary:
+        stack.push_back(current + 1);
+        break;
+      case OpCode::AssertBegin:  // only matches at position 0, where every start is tried
+        break;
+      case OpCode::Match:
+        start.matches_anywhere = true;
+        break;
+    }
+  }
+  first_characters_ |= start.first_characters;
+  matches_anywhere_ = matches_anywhere_ || start.matches_anywhere;
+  starts_.push_back(start);
+}
+
+bool LinearRegex::fullMatch(std::string_view subject, std::vector<size_t>* captures) const {
+  if (std::vector<bool> matched(1, false); !captures && runAutomaton(subject, true, matched)) {
+    return matched[0];
+  }
+  return run(subject, 0, true, captures);
+}
+
+bool LinearRegex::search(std::string_view subject, size_t start, std::vector<size_t>* captures) const {
+  if (std::vector<bool> matched(1, false); !captures && start == 0 && runAutomaton(subject, false, matched)) {
+    return matched[0];
+  }
+  return run(subject, start, false, captures);
+}
+
+bool LinearRegex::run(std::string_view subject, size_t start, bool full_match, std::vector<size_t>* captures) const {
+  PikeVM vm(*this, subject, captures ? 2 * (group_count_ + 1) : 0);
+  return vm.run(start, full_match, captures);
+}
+
+std::string LinearRegex::replace(std::string_view subject, std::string_view replacement, bool first_only) const {
+  std::string result;
+  replace(subject, replacement, first_only, result);
+  return result;
+}
+
+void LinearRegex::replace(std::string_view subject, std::string_view replacement, bool first_only, std::string& result) const {
+  std::vector<size_t> captures;
+  size_t copied_until = 0;
+  size_t search_start = 0;
+
+  while (search_start <= subject.size() && search(subject, search_start, &captures)) {
+    const auto match_begin = captures[0];
+    const auto match_end = captures[1];
+    result.append(subject.substr(copied_until, match_begin - copied_until));
+    appendReplacement(result, subject, captures, replacement, copied_until);
+
+    copied_until = match_end;
+    if (first_only) {
+      break;
+    }
+    // an empty match would be found again at the same position
+    search_start = match_end == match_begin ? match_end + 1 : match_end;
+  }
+
+  result.append(subject.substr(copied_until));
+}
+
+void LinearRegex::appendReplacement(std::string& result, std::string_view subject, std::span<const size_t> captures, std::string_view replacement, size_t prefix_begin) const {
+  const auto match_begin = captures[0];
+  const auto match_end = captures[1];
+
+  const auto append_group = [&](size_t group) {
+    if (group <= group_count_ && captures[2 * group] != NPOS) {
+      result.append(subject.substr(captures[2 * group], captures[2 * group + 1] - captures[2 * group]));
+    }
+  };
+
+  for (size_t i = 0; i < replacement.size(); ++i) {
+    if (replacement[i] != '$' || i + 1 == replacement.size()) {
+      result.push_back(replacement[i]);
+      continue;
+    }
+    const char format = replacement[i + 1];
+    if (format == '$') {
+      result.push_back('$');
+      ++i;
+    } else if (format == '&') {
+      append_group(0);
+      ++i;
+    } else if (format == '`') {
+      result.append(subject.substr(prefix_begin, match_begin - prefix_begin));
+      ++i;
+    } else if (format == '\'') {
+      result.append(subject.substr(match_end));
+      ++i;
+    } else if (std::isdigit(static_cast<unsigned char>(format))) {
+      size_t group = gsl::narrow<size_t>(format - '0');
+      ++i;
+      if (i + 1 < replacement.size() && std::isdigit(static_cast<unsigned char>(replacement[i + 1]))) {
+        group = group * 10 + gsl::narrow<size_t>(replacement[i + 1] - '0');
+        ++i;
+      }
+      append_group(group);
+    } else {
+      result.push_back('$');
+    }
+  }
+}
+
+std::optional<LinearRegexSet> LinearRegexSet::compile(std::span<const std::string> patterns, bool case_insensitive) {
+  LinearRegexSet regex_set;
+  if (!PatternCompiler(case_insensitive, regex_set.regex_).compileSet(patterns, regex_set.pattern_of_instruction_)) {
+    return std::nullopt;
+  }
+  regex_set.pattern_count_ = patterns.size();
+  return regex_set;
+}
+
+std::vector<bool> LinearRegexSet::search(std::string_view subject) const {
+  return run(subject, false);
+}
+
+std::vector<bool> LinearRegexSet::fullMatch(std::string_view subject) const {
+  return run(subject, true);
+}
+
+std::vector<bool> LinearRegexSet::run(std::string_view subject, bool full_match) const {
+  std::vector<bool> matched(pattern_count_, false);
+  if (pattern_count_ > 0 && !regex_.runAutomaton(subject, full_match, matched)) {
+    PikeVM vm(regex_, subject, 0);
+    vm.runSet(full_match, pattern_of_instruction_, matched);
+  }
+  return matched;
+}
+
+}  // namespace org::apache::nifi::minifi::utils
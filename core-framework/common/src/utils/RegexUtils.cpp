@@ -22,6 +22,7 @@
 #include <vector>
 
 #include "minifi-cpp/Exception.h"
+#include "utils/LinearRegex.h"
 
 namespace org::apache::nifi::minifi::utils {
 
@@ -102,6 +103,18 @@ void SMatch::reset(std::string str) {
   suffix_ = unmatched_;
   ready_ = false;
 }
+
+// captures are the positions of the match and of its groups, as set by LinearRegex
+void SMatch::assignCaptures(const std::vector<size_t>& captures) {
+  suffix_ = Regmatch{true, string_.begin() + gsl::narrow<std::ptrdiff_t>(captures[1]), string_.end()};
+  for (size_t i = 0; i + 1 < captures.size(); i += 2) {
+    if (captures[i] == LinearRegex::NPOS) {
+      matches_.emplace_back(false, string_.end(), string_.end());
+    } else {
+      matches_.emplace_back(true, string_.begin() + gsl::narrow<std::ptrdiff_t>(captures[i]), string_.begin() + gsl::narrow<std::ptrdiff_t>(captures[i + 1]));
+    }
+  }
+}
 #endif
 
 Regex::Regex() : Regex::Regex("") {}
@@ -116,6 +129,8 @@ Regex::Regex(std::string value, const std::vector<Regex::Mode> &mode)
 #else
     regex_mode_(REG_EXTENDED) {
 #endif
+  bool case_insensitive = false;
+  bool linear = false;
   for (const auto m : mode) {
     switch (m) {
       case Mode::ICASE:
@@ -124,10 +139,20 @@ Regex::Regex(std::string value, const std::vector<Regex::Mode> &mode)
 #else
         regex_mode_ |= REG_ICASE;
 #endif
+        case_insensitive = true;
+        break;
+      case Mode::LINEAR:
+        linear = true;
         break;
     }
   }
+  if (linear) {
+    if (auto linear_regex = LinearRegex::compile(regex_str_, case_insensitive)) {
+      linear_regex_ = std::make_shared<const LinearRegex>(std::move(*linear_regex));
+    }
+  }
 #ifdef NO_MORE_REGFREEE
+  // the match results are std::match_results, which only std::regex can fill
   try {
     compiled_regex_ = std::regex(regex_str_, regex_mode_);
     valid_ = true;
@@ -135,8 +160,10 @@ Regex::Regex(std::string value, const std::vector<Regex::Mode> &mode)
     throw Exception(REGEX_EXCEPTION, e.what());
   }
 #else
-  compileRegex(compiled_regex_, regex_str_);
-  compileRegex(compiled_full_input_regex_, '^' + regex_str_ + '$');
+  if (!linear_regex_) {
+    compileRegex(compiled_regex_, regex_str_);
+    compileRegex(compiled_full_input_regex_, '^' + regex_str_ + '$');
+  }
   valid_ = true;
 #endif
 }
@@ -157,17 +184,22 @@ Regex& Regex::operator=(const Regex& other) {
     return *this;
   }
 
+#ifndef NO_MORE_REGFREEE
+  if (valid_ && !linear_regex_) {
+    regfree(&compiled_regex_);
+    regfree(&compiled_full_input_regex_);
+  }
+#endif
   regex_str_ = other.regex_str_;
   regex_mode_ = other.regex_mode_;
+  linear_regex_ = other.linear_regex_;
 #ifdef NO_MORE_REGFREEE
   compiled_regex_ = other.compiled_regex_;
 #else
-  if (valid_) {
-    regfree(&compiled_regex_);
-    regfree(&compiled_full_input_regex_);
+  if (!linear_regex_) {
+    compileRegex(compiled_regex_, regex_str_);
+    compileRegex(compiled_full_input_regex_, '^' + regex_str_ + '$');
   }
-  compileRegex(compiled_regex_, regex_str_);
-  compileRegex(compiled_full_input_regex_, '^' + regex_str_ + '$');
 #endif
   valid_ = other.valid_;
   return *this;
@@ -189,15 +221,18 @@ Regex& Regex::operator=(Regex&& other) noexcept {
     return *this;
   }
 
+#ifndef NO_MORE_REGFREEE
+  if (valid_ && !linear_regex_) {
+    regfree(&compiled_regex_);
+    regfree(&compiled_full_input_regex_);
+  }
+#endif
   regex_str_ = std::move(other.regex_str_);
   regex_mode_ = other.regex_mode_;
+  linear_regex_ = std::move(other.linear_regex_);
 #ifdef NO_MORE_REGFREEE
   compiled_regex_ = std::move(other.compiled_regex_);
 #else
-  if (valid_) {
-    regfree(&compiled_regex_);
-    regfree(&compiled_full_input_regex_);
-  }
   compiled_regex_ = other.compiled_regex_;
   compiled_full_input_regex_ = other.compiled_full_input_regex_;
 #endif
@@ -208,7 +243,7 @@ Regex& Regex::operator=(Regex&& other) noexcept {
 
 #ifndef NO_MORE_REGFREEE
 Regex::~Regex() {
-  if (valid_) {
+  if (valid_ && !linear_regex_) {
     regfree(&compiled_regex_);
     regfree(&compiled_full_input_regex_);
   }
@@ -228,16 +263,25 @@ void Regex::compileRegex(regex_t& regex, const std::string& regex_string) const
 #endif
 
 bool regexMatch(const char* str, const Regex& regex) {
+  if (regex.valid_ && regex.linear_regex_) {
+    return regex.linear_regex_->fullMatch(str);
+  }
   CMatch match;
   return regexMatch(str, match, regex);
 }
 
 bool regexMatch(const std::string_view& str, const Regex& regex) {
+  if (regex.valid_ && regex.linear_regex_) {
+    return regex.linear_regex_->fullMatch(str);
+  }
   SVMatch match;
   return regexMatch(str, match, regex);
 }
 
 bool regexMatch(const std::string& str, const Regex& regex) {
+  if (regex.valid_ && regex.linear_regex_) {
+    return regex.linear_regex_->fullMatch(str);
+  }
   SMatch match;
   return regexMatch(str, match, regex);
 }
@@ -273,6 +317,14 @@ bool regexMatch(const std::string& str, SMatch& match, const Regex& regex) {
 #else
   match.reset(str);
   match.ready_ = true;
+  if (regex.linear_regex_) {
+    std::vector<size_t> captures;
+    const bool result = regex.linear_regex_->fullMatch(str, &captures);
+    if (result) {
+      match.assignCaptures(captures);
+    }
+    return result;
+  }
   std::vector<regmatch_t> regmatches(regex.compiled_full_input_regex_.re_nsub + 1);
   bool result = regexec(&regex.compiled_full_input_regex_, str.c_str(), regmatches.size(), regmatches.data(), 0) == 0;
   if (result) {
@@ -293,16 +345,25 @@ bool regexMatch(const std::string& str, SMatch& match, const Regex& regex) {
 }
 
 bool regexSearch(const char* str, const Regex& regex) {
+  if (regex.valid_ && regex.linear_regex_) {
+    return regex.linear_regex_->search(str);
+  }
   CMatch match;
   return regexSearch(str, match, regex);
 }
 
 bool regexSearch(const std::string_view& str, const Regex& regex) {
+  if (regex.valid_ && regex.linear_regex_) {
+    return regex.linear_regex_->search(str);
+  }
   SVMatch match;
   return regexSearch(str, match, regex);
 }
 
 bool regexSearch(const std::string& str, const Regex& regex) {
+  if (regex.valid_ && regex.linear_regex_) {
+    return regex.linear_regex_->search(str);
+  }
   SMatch match;
   return regexSearch(str, match, regex);
 }
@@ -338,6 +399,14 @@ bool regexSearch(const std::string& str, SMatch& match, const Regex& regex) {
 #else
   match.reset(str);
   match.ready_ = true;
+  if (regex.linear_regex_) {
+    std::vector<size_t> captures;
+    const bool result = regex.linear_regex_->search(str, 0, &captures);
+    if (result) {
+      match.assignCaptures(captures);
+    }
+    return result;
+  }
   std::vector<regmatch_t> regmatches(regex.compiled_regex_.re_nsub + 1);
   bool result = regexec(&regex.compiled_regex_, str.c_str(), regmatches.size(), regmatches.data(), 0) == 0;
   if (result) {
@@ -33,6 +33,10 @@ namespace org::apache::nifi::minifi::http {
 enum class HttpRequestMethod {
   Get, Post, Put, Patch, Delete, Connect, Head, Options, Trace
 };
+
+enum class HttpVersion {
+  Http1_1, Http2
+};
 }  // namespace org::apache::nifi::minifi::http
 
 namespace magic_enum::customize {
@@ -52,6 +56,16 @@ constexpr customize_t enum_name<HttpRequestMethod>(HttpRequestMethod type) noexc
   }
   return invalid_tag;
 }
+
+using HttpVersion = org::apache::nifi::minifi::http::HttpVersion;
+template<>
+constexpr customize_t enum_name<HttpVersion>(HttpVersion version) noexcept {
+  switch (version) {
+    case HttpVersion::Http1_1: return "HTTP/1.1";
+    case HttpVersion::Http2: return "HTTP/2";
+  }
+  return invalid_tag;
+}
 }  // namespace magic_enum::customize
 
 namespace org::apache::nifi::minifi::http {
@@ -49,9 +49,14 @@ namespace org::apache::nifi::minifi::http {
  *    by the current buffer
  *  - because of this, all functions that request data at a specific offset are implicit seeks and potentially modify
  *    the current buffer
+ *  - small chunks are coalesced into one buffer to keep the number of chunks handed to curl low, and the producer
+ *    is blocked while MAX_QUEUED_BYTES are waiting to be sent, so the data is streamed rather than buffered in memory
  */
 class HttpStreamingCallback final : public HTTPUploadByteArrayInputCallback {
  public:
+  static constexpr size_t COALESCE_CHUNK_SIZE = 64 * 1024;
+  static constexpr size_t MAX_QUEUED_BYTES = 4 * 1024 * 1024;
+
   void close() override {
     logger_->log_trace("close() called");
     std::unique_lock<std::mutex> lock(mutex_);
@@ -137,6 +142,8 @@ class HttpStreamingCallback final : public HTTPUploadByteArrayInputCallback {
     } else {
       current_vec_ = std::move(byte_arrays_.front());
       byte_arrays_.pop_front();
+      queued_bytes_ -= current_vec_.size();
+      cv.notify_all();
 
       ptr_ = current_vec_.data();
       current_buffer_start_ = total_bytes_loaded_;
@@ -154,7 +161,7 @@ class HttpStreamingCallback final : public HTTPUploadByteArrayInputCallback {
   /**
    * Common implementation for placing a buffer into the queue
    * @param vec the buffer to be inserted
-   * @return the number of bytes processed (the size of vec)
+   * @return the number of bytes processed (the size of vec), or an error if the stream is already closed, as nobody would read the data
    */
   io::IoResult processInner(std::vector<std::byte>&& vec) {
     size_t size = vec.size();
@@ -166,7 +173,19 @@ class HttpStreamingCallback final : public HTTPUploadByteArrayInputCallback {
     }
 
     std::unique_lock<std::mutex> lock(mutex_);
-    byte_arrays_.emplace_back(std::move(vec));
+    cv.wait(lock, [&] {
+      return queued_bytes_ < MAX_QUEUED_BYTES || !is_alive_;
+    });
+    if (!is_alive_) {
+      logger_->log_error("Tried to write {} bytes after the stream was closed", size);
+      return io::IoResult::error();
+    }
+    if (!byte_arrays_.empty() && byte_arrays_.back().size() + size <= COALESCE_CHUNK_SIZE) {
+      byte_arrays_.back().insert(byte_arrays_.back().end(), vec.begin(), vec.end());
+    } else {
+      byte_arrays_.emplace_back(std::move(vec));
+    }
+    queued_bytes_ += size;
     cv.notify_all();
 
     return io::IoResult::from(size);
@@ -201,6 +220,7 @@ class HttpStreamingCallback final : public HTTPUploadByteArrayInputCallback {
   size_t total_bytes_loaded_{0U};
   size_t current_buffer_start_{0U};
   size_t current_pos_{0U};
+  size_t queued_bytes_{0U};
 
   std::deque<std::vector<std::byte>> byte_arrays_;
 
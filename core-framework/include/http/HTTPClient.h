@@ -50,6 +50,8 @@
 
 namespace org::apache::nifi::minifi::http {
 
+class HTTPConnectionShare;
+
 struct KeepAliveProbeData {
   std::chrono::seconds keep_alive_delay;
   std::chrono::seconds keep_alive_interval;
@@ -121,6 +123,23 @@ class HTTPClient : public BaseHTTPClient, public core::ConnectableImpl {
 
   bool submit() override;
 
+  /**
+   * submit() split into steps, so that the transfer can be driven by a curl multi handle (see MultiHTTPClient).
+   * prepareSubmit() configures the easy handle for the request, finishSubmit() collects the response once the transfer is done.
+   */
+  bool prepareSubmit();
+  bool finishSubmit(CURLcode result);
+
+  CURL* getHandle() const {
+    return http_session_.get();
+  }
+
+  // DNS cache, TLS sessions and connections are shared with every other client using the same share
+  void setConnectionShare(std::shared_ptr<HTTPConnectionShare> connection_share);
+
+  // HTTP/2 is negotiated with ALPN on TLS connections, plain HTTP and servers without HTTP/2 support use HTTP/1.1
+  bool setHttpVersion(HttpVersion version);
+
   int64_t getResponseCode() const override;
 
   const char *getContentType() override;
@@ -249,9 +268,13 @@ class HTTPClient : public BaseHTTPClient, public core::ConnectableImpl {
 
   struct CurlEasyCleanup { void operator()(CURL* curl) const; };
   struct CurlMimeFree { void operator()(curl_mime* curl_mime) const; };
+  struct CurlSlistFreeAll { void operator()(curl_slist* slist) const; };
 
+  // declared before the easy handle, so that the handle is cleaned up before the share is released
+  std::shared_ptr<HTTPConnectionShare> connection_share_;
   std::unique_ptr<CURL, CurlEasyCleanup> http_session_;
   std::unique_ptr<curl_mime, CurlMimeFree> form_;
+  std::unique_ptr<curl_slist, CurlSlistFreeAll> request_header_list_;
   std::unique_ptr<HTTPReadCallback> read_callback_;
   std::unique_ptr<HTTPUploadCallback> write_callback_;
   std::unique_ptr<HTTPUploadCallback> form_callback_;
@@ -90,6 +90,9 @@ class HttpStream : public io::BaseStreamImpl {
     if (client == nullptr)
       return false;
     bool submit_status = client->submit();
+    // the request will not consume more data, unblock a writer waiting for the upload to make progress
+    if (auto upload_callback = client->getUploadCallback())
+      upload_callback->close();
     return submit_status;
   }
 
@@ -0,0 +1,100 @@
+/**
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The ASF licenses this file to You under the Apache License, Version 2.0
+ * (the "License"); you may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#pragma once
+
+#include <array>
+#include <chrono>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+
+#include "http/HTTPClient.h"
+#include "core/logging/LoggerFactory.h"
+
+namespace org::apache::nifi::minifi::http {
+
+/**
+ * Thread safe wrapper of a curl share handle. Clients using the same share reuse each other's
+ * DNS cache entries and TLS sessions, but not their connections. Clients keep the share alive while they use it.
+ */
+class HTTPConnectionShare {
+ public:
+  HTTPConnectionShare();
+
+  HTTPConnectionShare(const HTTPConnectionShare&) = delete;
+  HTTPConnectionShare& operator=(const HTTPConnectionShare&) = delete;
+  HTTPConnectionShare(HTTPConnectionShare&&) = delete;
+  HTTPConnectionShare& operator=(HTTPConnectionShare&&) = delete;
+  ~HTTPConnectionShare() = default;
+
+  [[nodiscard]] CURLSH* get() const {
+    return share_handle_.get();
+  }
+
+ private:
+  static void lock(CURL* handle, curl_lock_data data, curl_lock_access access, void* user_data);
+  static void unlock(CURL* handle, curl_lock_data data, void* user_data);
+
+  struct CurlShareCleanup { void operator()(CURLSH* share_handle) const; };
+
+  std::array<std::mutex, CURL_LOCK_DATA_LAST> mutexes_;
+  std::unique_ptr<CURLSH, CurlShareCleanup> share_handle_;
+};
+
+/**
+ * Performs the requests of multiple HTTPClients concurrently from the calling thread, using a curl multi handle.
+ * When multiplexing is enabled, requests to the same HTTP/2 server are sent as parallel streams over a single connection.
+ * Not thread safe, the clients must not be used by anyone else until their requests are completed.
+ */
+class MultiHTTPClient {
+ public:
+  explicit MultiHTTPClient(bool multiplex = true);
+
+  MultiHTTPClient(const MultiHTTPClient&) = delete;
+  MultiHTTPClient& operator=(const MultiHTTPClient&) = delete;
+  MultiHTTPClient(MultiHTTPClient&&) = delete;
+  MultiHTTPClient& operator=(MultiHTTPClient&&) = delete;
+  ~MultiHTTPClient();
+
+  bool addRequest(HTTPClient& client);
+
+  [[nodiscard]] size_t size() const {
+    return clients_.size();
+  }
+
+  /**
+   * Runs the added requests until all of them are completed. on_complete is called with the client
+   * and the result of its request in the order of completion, from the calling thread.
+   */
+  void performAll(const std::function<void(HTTPClient&, bool)>& on_complete);
+
+ private:
+  void processCompletedTransfers(const std::function<void(HTTPClient&, bool)>& on_complete);
+  void removeAll();
+
+  static constexpr std::chrono::milliseconds POLL_TIMEOUT{1000};
+
+  struct CurlMultiCleanup { void operator()(CURLM* multi_handle) const; };
+
+  bool multiplex_;
+  std::unique_ptr<CURLM, CurlMultiCleanup> multi_handle_;
+  std::unordered_map<CURL*, HTTPClient*> clients_;
+  std::shared_ptr<core::logging::Logger> logger_{core::logging::LoggerFactory<MultiHTTPClient>::getLogger()};
+};
+
+}  // namespace org::apache::nifi::minifi::http
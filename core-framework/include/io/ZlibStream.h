@@ -101,6 +101,7 @@ class ZlibDecompressStream : public ZlibBaseStream {
   size_t write(const uint8_t *value, size_t size) override;
 
  private:
+  ZlibCompressionFormat format_;
   std::shared_ptr<core::logging::Logger> logger_;
 };
 
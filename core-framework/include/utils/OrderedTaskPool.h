@@ -0,0 +1,139 @@
+/**
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The ASF licenses this file to You under the Apache License, Version 2.0
+ * (the "License"); you may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <mutex>
+#include <optional>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include "minifi-cpp/utils/gsl.h"
+
+namespace org::apache::nifi::minifi::utils {
+
+/**
+ * Runs the added tasks on a fixed set of worker threads, and hands out their results in the order the tasks were added.
+ * An exception thrown by a task is caught on the worker thread, and rethrown by the takeNext call which would have returned its result.
+ * The tasks which are not started yet when the pool is destroyed are dropped, the running ones are waited for.
+ */
+template<typename Result>
+class OrderedTaskPool {
+ public:
+  explicit OrderedTaskPool(size_t thread_count) {
+    workers_.reserve(thread_count);
+    for (size_t i = 0; i < thread_count; ++i) {
+      workers_.emplace_back([this] { work(); });
+    }
+  }
+
+  OrderedTaskPool(const OrderedTaskPool&) = delete;
+  OrderedTaskPool(OrderedTaskPool&&) = delete;
+  OrderedTaskPool& operator=(const OrderedTaskPool&) = delete;
+  OrderedTaskPool& operator=(OrderedTaskPool&&) = delete;
+
+  ~OrderedTaskPool() {
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      stopping_ = true;
+    }
+    task_added_.notify_all();
+    for (auto& worker : workers_) {
+      worker.join();
+    }
+  }
+
+  void add(std::function<Result()> task) {
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      tasks_.push_back(Task{.function = std::move(task)});
+    }
+    task_added_.notify_one();
+  }
+
+  // the number of tasks whose results are not taken yet
+  [[nodiscard]] size_t size() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return tasks_.size();
+  }
+
+  // waits for the result of the oldest task whose result is not taken yet, or rethrows the exception thrown by that task
+  Result takeNext() {
+    std::unique_lock<std::mutex> lock(mutex_);
+    gsl_Expects(!tasks_.empty());
+    task_done_.wait(lock, [this] { return tasks_.front().isDone(); });
+    auto task = std::move(tasks_.front());
+    tasks_.pop_front();
+    --next_task_;
+    lock.unlock();
+    if (task.exception) {
+      std::rethrow_exception(task.exception);
+    }
+    return std::move(*task.result);
+  }
+
+ private:
+  struct Task {
+    [[nodiscard]] bool isDone() const { return result.has_value() || exception != nullptr; }
+
+    std::function<Result()> function;
+    std::optional<Result> result;
+    std::exception_ptr exception;
+  };
+
+  void work() {
+    std::unique_lock<std::mutex> lock(mutex_);
+    while (true) {
+      task_added_.wait(lock, [this] { return stopping_ || next_task_ < tasks_.size(); });
+      if (stopping_) {
+        return;
+      }
+      // the task is only removed after its result is set, and adding tasks to the deque does not move the others
+      auto& task = tasks_[next_task_++];
+      const auto function = std::move(task.function);
+      lock.unlock();
+      std::optional<Result> result;
+      std::exception_ptr exception;
+      try {
+        result.emplace(function());
+      } catch (...) {
+        exception = std::current_exception();
+      }
+      lock.lock();
+      task.result = std::move(result);
+      task.exception = std::move(exception);
+      task_done_.notify_one();
+    }
+  }
+
+  mutable std::mutex mutex_;
+  std::condition_variable task_added_;
+  std::condition_variable task_done_;
+  std::deque<Task> tasks_;
+  size_t next_task_ = 0;  // the index of the first task which is not started yet
+  bool stopping_ = false;
+  std::vector<std::thread> workers_;
+};
+
+}  // namespace org::apache::nifi::minifi::utils
@@ -20,6 +20,7 @@
 #include <filesystem>
 #include <fstream>
 #include <memory>
+#include <optional>
 #include <sstream>
 #include <tuple>
 #include <utility>
@@ -144,6 +145,27 @@ inline uint64_t file_size(const std::filesystem::path& path) {
   return file_size;
 }
 
+struct FileIdentity {
+  uint64_t device = 0;
+  uint64_t inode = 0;
+
+  bool operator==(const FileIdentity&) const = default;
+};
+
+// the identity stays the same when the file is renamed within the file system; it is not available on Windows
+inline std::optional<FileIdentity> get_file_identity(const std::filesystem::path& path) {
+#ifdef WIN32
+  (void)path;
+  return std::nullopt;
+#else
+  struct stat result = {};
+  if (stat(path.c_str(), &result) != 0) {
+    return std::nullopt;
+  }
+  return FileIdentity{.device = gsl::narrow<uint64_t>(result.st_dev), .inode = gsl::narrow<uint64_t>(result.st_ino)};
+#endif
+}
+
 inline bool get_permissions(const std::filesystem::path& path, uint32_t& permissions) {
   std::error_code ec;
   permissions = static_cast<uint32_t>(std::filesystem::status(path, ec).permissions());
@@ -45,7 +45,16 @@ std::shared_ptr<io::BaseStream> BufferedContentSession::append(
     const std::shared_ptr<ResourceClaim>& resource_id, size_t offset,
     const std::function<void(const std::shared_ptr<ResourceClaim>&)>& on_copy) {
   if (auto it = managed_resources_.find(resource_id); it != managed_resources_.end()) {
-    return it->second;
+    if (it->second->size() == offset) {
+      return it->second;
+    }
+    // the flow file is a view that ends before the end of the resource (e.g. a clone of a part of it),
+    // appending in place would overwrite the content of the other flow files sharing the resource
+    const auto new_claim = create();
+    auto output = write(new_claim);
+    output->write(it->second->getBuffer().subspan(0, offset));
+    on_copy(new_claim);
+    return output;
   }
   return ContentSessionImpl::append(resource_id, offset, on_copy);
 }
@@ -15,6 +15,7 @@
  * limitations under the License.
  */
 #include "http/HTTPClient.h"
+#include "http/MultiHTTPClient.h"
 
 #include <openssl/err.h>
 #include <openssl/ssl.h>
@@ -323,6 +324,13 @@ std::unique_ptr<struct curl_slist, CurlSlistDeleter> toCurlSlist(const std::unor
 
 
 bool HTTPClient::submit() {
+  if (!prepareSubmit()) {
+    return false;
+  }
+  return finishSubmit(curl_easy_perform(http_session_.get()));
+}
+
+bool HTTPClient::prepareSubmit() {
   if (url_.empty()) {
     logger_->log_error("Tried to submit to an empty url");
     return false;
@@ -350,11 +358,12 @@ bool HTTPClient::submit() {
     curl_easy_setopt(http_session_.get(), CURLOPT_NOPROGRESS, 1);
   }
 
-  const auto headers = toCurlSlist(request_headers_);
-  if (headers) {
-    curl_slist_append(headers.get(), "Expect:");
-    curl_easy_setopt(http_session_.get(), CURLOPT_HTTPHEADER, headers.get());
+  // the header list has to outlive the transfer, which may be performed outside of this function
+  request_header_list_.reset(toCurlSlist(request_headers_).release());
+  if (request_header_list_) {
+    curl_slist_append(request_header_list_.get(), "Expect:");
   }
+  curl_easy_setopt(http_session_.get(), CURLOPT_HTTPHEADER, request_header_list_.get());
 
   curl_easy_setopt(http_session_.get(), CURLOPT_URL, url_.c_str());
   logger_->log_debug("Submitting to {} {}", method_ ? magic_enum::enum_name(*method_) : "NONE", url_);
@@ -369,7 +378,11 @@ bool HTTPClient::submit() {
   if (form_ != nullptr) {
     curl_easy_setopt(http_session_.get(), CURLOPT_MIMEPOST, form_.get());
   }
-  res_ = curl_easy_perform(http_session_.get());
+  return true;
+}
+
+bool HTTPClient::finishSubmit(CURLcode result) {
+  res_ = result;
   if (read_callback_ == nullptr) {
     content_.close();
   }
@@ -378,7 +391,7 @@ bool HTTPClient::submit() {
   response_data_.response_code = http_code;
   curl_easy_getinfo(http_session_.get(), CURLINFO_CONTENT_TYPE, &response_data_.response_content_type);
   if (res_ == CURLE_OPERATION_TIMEDOUT) {
-    logger_->log_error("HTTP operation timed out, with absolute timeout {}\n", absolute_timeout);
+    logger_->log_error("HTTP operation timed out, with absolute timeout {}\n", absolute_timeout_.value_or(3 * read_timeout_));
   }
   if (res_ != CURLE_OK) {
     logger_->log_error("curl_easy_perform() failed {} on {}, error code {}\n", curl_easy_strerror(res_), url_, magic_enum::enum_underlying(res_));
@@ -389,6 +402,26 @@ bool HTTPClient::submit() {
   return true;
 }
 
+void HTTPClient::setConnectionShare(std::shared_ptr<HTTPConnectionShare> connection_share) {
+  connection_share_ = std::move(connection_share);
+  curl_easy_setopt(http_session_.get(), CURLOPT_SHARE, connection_share_ ? connection_share_->get() : nullptr);
+}
+
+bool HTTPClient::setHttpVersion(HttpVersion version) {
+  switch (version) {
+    case HttpVersion::Http1_1:
+      return CURLE_OK == curl_easy_setopt(http_session_.get(), CURLOPT_HTTP_VERSION, CURL_HTTP_VERSION_1_1);
+    case HttpVersion::Http2: {
+      if ((curl_version_info(CURLVERSION_NOW)->features & CURL_VERSION_HTTP2) == 0) {
+        logger_->log_warn("libcurl was built without HTTP/2 support, using HTTP/1.1 for {}", url_);
+        return false;
+      }
+      return CURLE_OK == curl_easy_setopt(http_session_.get(), CURLOPT_HTTP_VERSION, CURL_HTTP_VERSION_2TLS);
+    }
+  }
+  return false;
+}
+
 int64_t HTTPClient::getResponseCode() const {
   return response_data_.response_code;
 }
@@ -537,4 +570,8 @@ void HTTPClient::CurlMimeFree::operator()(curl_mime* curl_mime) const {
   curl_mime_free(curl_mime);
 }
 
+void HTTPClient::CurlSlistFreeAll::operator()(curl_slist* slist) const {
+  curl_slist_free_all(slist);
+}
+
 }  // namespace org::apache::nifi::minifi::http
@@ -63,10 +63,13 @@ size_t HttpStream::write(const uint8_t* value, size_t size) {
     http_client_write_future_ = std::async(std::launch::async, submit_client, http_client_);
     write_started_ = true;
   }
-  if (auto http_callback = dynamic_cast<HttpStreamingCallback*>(http_client_->getUploadCallback()))
-    http_callback->process(value, size);
-  else
+  if (auto http_callback = dynamic_cast<HttpStreamingCallback*>(http_client_->getUploadCallback())) {
+    if (!http_callback->process(value, size)) {
+      return io::STREAM_ERROR;
+    }
+  } else {
     throw std::runtime_error("Invalid http streaming callback");
+  }
   return size;
 }
 
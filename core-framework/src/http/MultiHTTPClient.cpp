@@ -0,0 +1,136 @@
+/**
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The ASF licenses this file to You under the Apache License, Version 2.0
+ * (the "License"); you may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "http/MultiHTTPClient.h"
+
+#include <stdexcept>
+#include <utility>
+
+#include "magic_enum/magic_enum.hpp"
+#include "minifi-cpp/utils/gsl.h"
+
+namespace org::apache::nifi::minifi::http {
+
+HTTPConnectionShare::HTTPConnectionShare()
+    : share_handle_(curl_share_init()) {
+  if (!share_handle_) {
+    throw std::runtime_error{"curl_share_init failed"};
+  }
+  curl_share_setopt(share_handle_.get(), CURLSHOPT_LOCKFUNC, &HTTPConnectionShare::lock);
+  curl_share_setopt(share_handle_.get(), CURLSHOPT_UNLOCKFUNC, &HTTPConnectionShare::unlock);
+  curl_share_setopt(share_handle_.get(), CURLSHOPT_USERDATA, static_cast<void*>(this));
+  curl_share_setopt(share_handle_.get(), CURLSHOPT_SHARE, CURL_LOCK_DATA_DNS);
+  curl_share_setopt(share_handle_.get(), CURLSHOPT_SHARE, CURL_LOCK_DATA_SSL_SESSION);
+  // the connection cache is not shared, libcurl does not support sharing it between handles used concurrently by multiple threads
+}
+
+void HTTPConnectionShare::lock(CURL* /*handle*/, curl_lock_data data, curl_lock_access /*access*/, void* user_data) {
+  gsl_Expects(user_data && data < CURL_LOCK_DATA_LAST);
+  static_cast<HTTPConnectionShare*>(user_data)->mutexes_[data].lock();
+}
+
+void HTTPConnectionShare::unlock(CURL* /*handle*/, curl_lock_data data, void* user_data) {
+  gsl_Expects(user_data && data < CURL_LOCK_DATA_LAST);
+  static_cast<HTTPConnectionShare*>(user_data)->mutexes_[data].unlock();
+}
+
+void HTTPConnectionShare::CurlShareCleanup::operator()(CURLSH* share_handle) const {
+  curl_share_cleanup(share_handle);
+}
+
+MultiHTTPClient::MultiHTTPClient(bool multiplex)
+    : multiplex_(multiplex),
+      multi_handle_(curl_multi_init()) {
+  if (!multi_handle_) {
+    throw std::runtime_error{"curl_multi_init failed"};
+  }
+  curl_multi_setopt(multi_handle_.get(), CURLMOPT_PIPELINING, multiplex_ ? CURLPIPE_MULTIPLEX : CURLPIPE_NOTHING);
+}
+
+MultiHTTPClient::~MultiHTTPClient() {
+  removeAll();
+}
+
+bool MultiHTTPClient::addRequest(HTTPClient& client) {
+  if (!client.prepareSubmit()) {
+    return false;
+  }
+  // wait for an HTTP/2 connection being set up to the same host instead of opening a new one
+  curl_easy_setopt(client.getHandle(), CURLOPT_PIPEWAIT, multiplex_ ? 1L : 0L);
+  if (const auto result = curl_multi_add_handle(multi_handle_.get(), client.getHandle()); result != CURLM_OK) {
+    logger_->log_error("curl_multi_add_handle() failed {} on {}, error code {}", curl_multi_strerror(result), client.getURL(), magic_enum::enum_underlying(result));
+    return false;
+  }
+  clients_.emplace(client.getHandle(), &client);
+  return true;
+}
+
+void MultiHTTPClient::performAll(const std::function<void(HTTPClient&, bool)>& on_complete) {
+  int still_running = 0;
+  do {
+    if (const auto result = curl_multi_perform(multi_handle_.get(), &still_running); result != CURLM_OK) {
+      logger_->log_error("curl_multi_perform() failed {}, error code {}", curl_multi_strerror(result), magic_enum::enum_underlying(result));
+      break;
+    }
+    processCompletedTransfers(on_complete);
+    if (still_running > 0) {
+      if (const auto result = curl_multi_poll(multi_handle_.get(), nullptr, 0, gsl::narrow<int>(POLL_TIMEOUT.count()), nullptr); result != CURLM_OK) {
+        logger_->log_error("curl_multi_poll() failed {}, error code {}", curl_multi_strerror(result), magic_enum::enum_underlying(result));
+        break;
+      }
+    }
+  } while (still_running > 0);
+  processCompletedTransfers(on_complete);
+
+  // only left over if the multi handle failed, these requests could not be completed
+  for (const auto& [handle, client] : std::exchange(clients_, {})) {
+    curl_multi_remove_handle(multi_handle_.get(), handle);
+    on_complete(*client, client->finishSubmit(CURLE_ABORTED_BY_CALLBACK));
+  }
+}
+
+void MultiHTTPClient::processCompletedTransfers(const std::function<void(HTTPClient&, bool)>& on_complete) {
+  int messages_left = 0;
+  while (CURLMsg* message = curl_multi_info_read(multi_handle_.get(), &messages_left)) {
+    if (message->msg != CURLMSG_DONE) {
+      continue;
+    }
+    CURL* handle = message->easy_handle;
+    const CURLcode result = message->data.result;
+    curl_multi_remove_handle(multi_handle_.get(), handle);
+    const auto it = clients_.find(handle);
+    if (it == clients_.end()) {
+      logger_->log_error("Completed transfer does not belong to any of the clients");
+      continue;
+    }
+    HTTPClient& client = *it->second;
+    clients_.erase(it);
+    on_complete(client, client.finishSubmit(result));
+  }
+}
+
+void MultiHTTPClient::removeAll() {
+  for (const auto& [handle, client] : clients_) {
+    curl_multi_remove_handle(multi_handle_.get(), handle);
+  }
+  clients_.clear();
+}
+
+void MultiHTTPClient::CurlMultiCleanup::operator()(CURLM* multi_handle) const {
+  curl_multi_cleanup(multi_handle);
+}
+
+}  // namespace org::apache::nifi::minifi::http
@@ -129,6 +129,7 @@ void ZlibCompressStream::close() {
 
 ZlibDecompressStream::ZlibDecompressStream(gsl::not_null<OutputStream*> output, ZlibCompressionFormat format)
     : ZlibBaseStream(std::move(output)),
+      format_(format),
       logger_{core::logging::LoggerFactory<ZlibDecompressStream>::getLogger()} {
   int ret = inflateInit2(&strm_, 15 + (format == ZlibCompressionFormat::GZIP ? 16 : 0) /* windowBits */);
   if (ret != Z_OK) {
@@ -151,6 +152,12 @@ ZlibDecompressStream::~ZlibDecompressStream() {
 }
 
 size_t ZlibDecompressStream::write(const uint8_t* value, size_t size) {
+  if (state_ == ZlibStreamState::FINISHED && format_ == ZlibCompressionFormat::GZIP && size > 0) {
+    // a gzip file can consist of multiple members, e.g. the independently compressed blocks of a parallel compression
+    logger_->log_trace("Starting the decompression of the next gzip member");
+    inflateReset(&strm_);
+    state_ = ZlibStreamState::INITIALIZED;
+  }
   if (state_ != ZlibStreamState::INITIALIZED) {
     logger_->log_error("writeData called in invalid ZlibDecompressStream state, state is {}", magic_enum::enum_name(state_));
     return STREAM_ERROR;
@@ -164,14 +171,13 @@ size_t ZlibDecompressStream::write(const uint8_t* value, size_t size) {
    * but in this case we do not have to close the stream, because it will detect the end of the compressed format
    * and signal that it is ended by returning Z_STREAM_END and not accepting any more input data.
    */
-  int ret = 0;
-  do {
+  while (true) {
     logger_->log_trace("writeData has {} B of input data left", strm_.avail_in);
 
     strm_.next_out = reinterpret_cast<Bytef*>(outputBuffer_.data());
     strm_.avail_out = gsl::narrow<uInt>(outputBuffer_.size());
 
-    ret = inflate(&strm_, Z_NO_FLUSH);
+    const int ret = inflate(&strm_, Z_NO_FLUSH);
     if (ret == Z_STREAM_ERROR ||
         ret == Z_NEED_DICT ||
         ret == Z_DATA_ERROR ||
@@ -187,10 +193,17 @@ size_t ZlibDecompressStream::write(const uint8_t* value, size_t size) {
       state_ = ZlibStreamState::ERRORED;
       return STREAM_ERROR;
     }
-  } while (strm_.avail_out == 0);
 
-  if (ret == Z_STREAM_END) {
-    state_ = ZlibStreamState::FINISHED;
+    if (ret == Z_STREAM_END) {
+      if (format_ != ZlibCompressionFormat::GZIP || strm_.avail_in == 0) {
+        state_ = ZlibStreamState::FINISHED;
+        break;
+      }
+      logger_->log_trace("Starting the decompression of the next gzip member");
+      inflateReset(&strm_);
+    } else if (strm_.avail_out != 0) {
+      break;
+    }
   }
 
   return size;
@@ -16,6 +16,9 @@
  */
 #pragma once
 
+#include <memory>
+#include <utility>
+
 #include "minifi-cpp/controllers/RecordSetReader.h"
 #include "core/controller/ControllerServiceBase.h"
 
@@ -27,6 +30,21 @@ class RecordSetReaderImpl : public controller::ControllerServiceBase, public Rec
   using ControllerServiceBase::ControllerServiceBase;
 
   [[nodiscard]] ControllerServiceHandle* getControllerServiceHandle() override {return this;}
+
+  std::expected<RecordSet, std::error_code> read(io::InputStream& input_stream) override {
+    const auto record_reader = createRecordReader(input_stream);
+    RecordSet record_set;
+    while (true) {
+      auto record = record_reader->next();
+      if (!record) {
+        return std::unexpected{record.error()};
+      }
+      if (!*record) {
+        return record_set;
+      }
+      record_set.push_back(std::move(**record));
+    }
+  }
 };
 
 }  // namespace org::apache::nifi::minifi::core
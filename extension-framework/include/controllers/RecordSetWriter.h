@@ -16,6 +16,8 @@
  */
 #pragma once
 
+#include <memory>
+
 #include "minifi-cpp/controllers/RecordSetWriter.h"
 #include "core/controller/ControllerServiceBase.h"
 
@@ -26,6 +28,21 @@ class RecordSetWriterImpl : public controller::ControllerServiceBase, public Rec
   using ControllerServiceBase::ControllerServiceBase;
 
   [[nodiscard]] ControllerServiceHandle* getControllerServiceHandle() override {return this;}
+
+  void write(const RecordSet& record_set, const std::shared_ptr<FlowFile>& flow_file, ProcessSession& session) override {
+    session.write(flow_file, [this, &record_set](const std::shared_ptr<io::OutputStream>& stream) -> io::IoResult {
+      const auto record_writer = createRecordWriter(*stream);
+      for (const auto& record : record_set) {
+        if (!record_writer->write(record)) {
+          return io::IoResult::error();
+        }
+      }
+      if (!record_writer->finish()) {
+        return io::IoResult::error();
+      }
+      return io::IoResult::zero();
+    });
+  }
 };
 
 }  // namespace org::apache::nifi::minifi::core
@@ -18,6 +18,7 @@
 #pragma once
 
 #include <memory>
+#include <optional>
 #include <string>
 #include <unordered_map>
 
@@ -29,7 +30,7 @@ namespace org::apache::nifi::minifi::controllers {
 
 class KeyValueStateStorage;
 
-class KeyValueStateManager final : public core::StateManagerImpl {
+class KeyValueStateManager : public core::StateManagerImpl {
  public:
   KeyValueStateManager(const utils::Identifier& id, gsl::not_null<KeyValueStateStorage*> storage);
 
@@ -44,6 +45,13 @@ class KeyValueStateManager final : public core::StateManagerImpl {
   bool commit() override;
   bool rollback() override;
 
+ protected:
+  // by default the state is serialized into a single record keyed by the component id, storages can override how it is read and written
+  virtual std::optional<core::StateManager::State> readState();
+  // previous_state is the last committed state, so that only the differences need to be written
+  virtual bool writeState(const std::optional<core::StateManager::State>& previous_state, const core::StateManager::State& state);
+  virtual bool removeState();
+
  private:
   enum class ChangeType {
     NONE,
@@ -51,7 +59,11 @@ class KeyValueStateManager final : public core::StateManagerImpl {
     CLEAR
   };
 
+  // the state is read from the storage on first use
+  const std::optional<core::StateManager::State>& loadedState();
+
   gsl::not_null<KeyValueStateStorage*> storage_;
+  bool state_loaded_ = false;
   std::optional<core::StateManager::State> state_;
   bool transaction_in_progress_;
   ChangeType change_type_;
@@ -0,0 +1,57 @@
+/**
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The ASF licenses this file to You under the Apache License, Version 2.0
+ * (the "License"); you may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+#include <filesystem>
+#include <functional>
+#include <memory>
+#include <optional>
+#include <vector>
+
+#include "minifi-cpp/core/logging/Logger.h"
+
+namespace org::apache::nifi::minifi::utils::file {
+
+struct DirectoryEntry {
+  std::filesystem::path directory;
+  std::filesystem::path filename;
+  std::chrono::system_clock::time_point last_modified;
+  uint64_t size = 0;
+
+  [[nodiscard]] std::filesystem::path fullPath() const { return directory / filename; }
+};
+
+/**
+ * Lists the files in a directory tree together with their modification time and size, which are read with the same stat call
+ * which tells the files and the directories apart.
+ * The subdirectories are listed in parallel on up to thread_count threads, so the order of the returned entries is unspecified.
+ * @param dir_callback Called for every child directory, its return value decides if that directory is listed.
+ * It is called from the listing threads, but never concurrently.
+ */
+std::vector<DirectoryEntry> list_dir_entries(const std::filesystem::path& dir,
+    const std::function<bool(const std::filesystem::path&)>& dir_callback,
+    size_t thread_count,
+    const std::shared_ptr<core::logging::Logger>& logger);
+
+/**
+ * Returns the modification time and size of a single file, or std::nullopt if it is a directory or it cannot be accessed.
+ */
+std::optional<DirectoryEntry> get_directory_entry(const std::filesystem::path& file_path);
+
+}  // namespace org::apache::nifi::minifi::utils::file
@@ -22,6 +22,7 @@
 #include <string>
 
 #include "../ListingStateManager.h"
+#include "utils/file/DirectoryLister.h"
 #include "utils/file/FileUtils.h"
 
 namespace org::apache::nifi::minifi::utils {
@@ -44,6 +45,10 @@ class ListedFile : public utils::ListedObject {
     }
   }
 
+  explicit ListedFile(const utils::file::DirectoryEntry& entry, std::filesystem::path input_directory)
+    : last_modified_time_(entry.last_modified), size_(entry.size), full_file_path_(entry.fullPath()), input_directory_(std::move(input_directory)) {
+  }
+
   [[nodiscard]] std::chrono::system_clock::time_point getLastModified() const override {
     return std::chrono::time_point_cast<std::chrono::milliseconds>(last_modified_time_);
   }
@@ -60,6 +65,10 @@ class ListedFile : public utils::ListedObject {
     return input_directory_;
   }
 
+  [[nodiscard]] uint64_t getSize() const { return size_ ? *size_ : utils::file::file_size(full_file_path_); }
+
+  [[nodiscard]] std::chrono::system_clock::duration getAge() const { return std::chrono::system_clock::now() - last_modified_time_; }
+
   [[nodiscard]] bool matches(const FileFilter& file_filter) {
     if (file_filter.ignore_hidden_files && utils::file::FileUtils::is_hidden(full_file_path_))
       return false;
@@ -95,9 +104,8 @@ class ListedFile : public utils::ListedObject {
     return true;
   }
 
-  [[nodiscard]] std::chrono::system_clock::duration getAge() const { return std::chrono::system_clock::now() - last_modified_time_;}
-  [[nodiscard]] size_t getSize() const { return utils::file::file_size(full_file_path_); }
   std::chrono::system_clock::time_point last_modified_time_;
+  std::optional<uint64_t> size_;
   std::filesystem::path full_file_path_;
   std::filesystem::path input_directory_;
 };
@@ -16,6 +16,9 @@
  */
 
 #include <memory>
+#include <optional>
+#include <string>
+#include <utility>
 
 #include "controllers/keyvalue/KeyValueStateManager.h"
 #include "controllers/keyvalue/KeyValueStateStorage.h"
@@ -29,10 +32,30 @@ KeyValueStateManager::KeyValueStateManager(
       storage_(storage),
       transaction_in_progress_(false),
       change_type_(ChangeType::NONE) {
+}
+
+std::optional<core::StateManager::State> KeyValueStateManager::readState() {
   std::string serialized;
-  if (storage_->get(id_.to_string(), serialized)) {
-    state_ = KeyValueStateStorage::deserialize(serialized);
+  if (!storage_->get(id_.to_string(), serialized)) {
+    return std::nullopt;
+  }
+  return KeyValueStateStorage::deserialize(serialized);
+}
+
+bool KeyValueStateManager::writeState(const std::optional<core::StateManager::State>& /*previous_state*/, const core::StateManager::State& state) {
+  return storage_->set(id_.to_string(), KeyValueStateStorage::serialize(state));
+}
+
+bool KeyValueStateManager::removeState() {
+  return storage_->remove(id_.to_string());
+}
+
+const std::optional<core::StateManager::State>& KeyValueStateManager::loadedState() {
+  if (!state_loaded_) {
+    state_ = readState();
+    state_loaded_ = true;
   }
+  return state_;
 }
 
 bool KeyValueStateManager::set(const core::StateManager::State& kvs) {
@@ -52,7 +75,7 @@ bool KeyValueStateManager::set(const core::StateManager::State& kvs) {
 }
 
 bool KeyValueStateManager::get(core::StateManager::State& kvs) {
-  if (!state_) {
+  if (!loadedState()) {
     return false;
   }
   // not allowed, if there were modifications (dirty read)
@@ -64,7 +87,7 @@ bool KeyValueStateManager::get(core::StateManager::State& kvs) {
 }
 
 bool KeyValueStateManager::clear() {
-  if (!state_) {
+  if (!loadedState()) {
     return false;
   }
 
@@ -108,13 +131,13 @@ bool KeyValueStateManager::commit() {
 
   // actually make the pending changes
   if (change_type_ == ChangeType::SET) {
-    if (storage_->set(id_.to_string(), KeyValueStateStorage::serialize(state_to_set_))) {
-      state_ = state_to_set_;
+    if (writeState(loadedState(), state_to_set_)) {
+      state_ = std::move(state_to_set_);
     } else {
       success = false;
     }
   } else if (change_type_ == ChangeType::CLEAR) {
-    if (state_ && storage_->remove(id_.to_string())) {
+    if (loadedState() && removeState()) {
       state_.reset();
     } else {
       success = false;
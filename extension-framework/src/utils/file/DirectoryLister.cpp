@@ -0,0 +1,217 @@
+/**
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The ASF licenses this file to You under the Apache License, Version 2.0
+ * (the "License"); you may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "utils/file/DirectoryLister.h"
+
+#include <algorithm>
+#include <condition_variable>
+#include <deque>
+#include <iterator>
+#include <mutex>
+#include <thread>
+#include <utility>
+
+#ifndef WIN32
+#include <dirent.h>
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <cerrno>
+#include <cstring>
+#endif
+
+#include "minifi-cpp/utils/gsl.h"
+#include "utils/file/FileUtils.h"
+
+namespace org::apache::nifi::minifi::utils::file {
+
+namespace {
+
+#ifndef WIN32
+DirectoryEntry toDirectoryEntry(std::filesystem::path directory, std::filesystem::path filename, const struct stat& file_status) {
+#ifdef __APPLE__
+  const auto& modification_time = file_status.st_mtimespec;
+#else
+  const auto& modification_time = file_status.st_mtim;
+#endif
+  const auto since_epoch = std::chrono::seconds{modification_time.tv_sec} + std::chrono::nanoseconds{modification_time.tv_nsec};
+  return DirectoryEntry{
+    .directory = std::move(directory),
+    .filename = std::move(filename),
+    .last_modified = std::chrono::system_clock::time_point{std::chrono::duration_cast<std::chrono::system_clock::duration>(since_epoch)},
+    .size = gsl::narrow<uint64_t>(file_status.st_size)};
+}
+#endif
+
+struct DirectoryContents {
+  std::vector<DirectoryEntry> files;
+  std::vector<std::filesystem::path> subdirectories;
+};
+
+DirectoryContents readDirectory(const std::filesystem::path& dir, core::logging::Logger& logger) {
+  DirectoryContents contents;
+#ifndef WIN32
+  // the entries are stat'ed relative to the directory descriptor, so their paths do not have to be resolved again
+  const int dir_fd = open(dir.c_str(), O_RDONLY | O_DIRECTORY | O_CLOEXEC);
+  if (dir_fd < 0) {
+    logger.log_warn("Failed to open directory {}: {}", dir, std::strerror(errno));
+    return contents;
+  }
+  DIR* dir_stream = fdopendir(dir_fd);
+  if (dir_stream == nullptr) {
+    logger.log_warn("Failed to open directory {}: {}", dir, std::strerror(errno));
+    close(dir_fd);
+    return contents;
+  }
+  while (const dirent* entry = readdir(dir_stream)) {
+    const std::string_view name = entry->d_name;
+    if (name == "." || name == "..") {
+      continue;
+    }
+    if (entry->d_type == DT_DIR) {
+      contents.subdirectories.push_back(dir / name);
+      continue;
+    }
+    // symbolic links are followed, like by the std::filesystem based listing
+    struct stat file_status{};
+    if (fstatat(dir_fd, entry->d_name, &file_status, 0) != 0) {
+      logger.log_debug("Failed to get the status of {}: {}", dir / name, std::strerror(errno));
+      continue;
+    }
+    if (S_ISDIR(file_status.st_mode)) {
+      contents.subdirectories.push_back(dir / name);
+    } else {
+      contents.files.push_back(toDirectoryEntry(dir, name, file_status));
+    }
+  }
+  closedir(dir_stream);
+#else
+  std::error_code error;
+  for (const auto& entry : std::filesystem::directory_iterator(dir, std::filesystem::directory_options::skip_permission_denied, error)) {
+    if (entry.is_directory(error)) {
+      contents.subdirectories.push_back(entry.path());
+    } else if (auto directory_entry = get_directory_entry(entry.path())) {
+      contents.files.push_back(std::move(*directory_entry));
+    }
+  }
+  if (error) {
+    logger.log_warn("Failed to list directory {}: {}", dir, error.message());
+  }
+#endif
+  return contents;
+}
+
+class DirectoryListing {
+ public:
+  DirectoryListing(const std::function<bool(const std::filesystem::path&)>& dir_callback, std::shared_ptr<core::logging::Logger> logger)
+    : dir_callback_(dir_callback),
+      logger_(std::move(logger)) {
+  }
+
+  std::vector<DirectoryEntry> run(const std::filesystem::path& dir, size_t thread_count) {
+    pending_directories_.push_back(dir);
+    std::vector<std::thread> threads;
+    for (size_t i = 1; i < thread_count; ++i) {
+      threads.emplace_back([this] { listDirectories(); });
+    }
+    listDirectories();
+    for (auto& thread : threads) {
+      thread.join();
+    }
+    return std::move(files_);
+  }
+
+ private:
+  void listDirectories() {
+    std::unique_lock lock(mutex_);
+    while (true) {
+      directories_changed_.wait(lock, [this] { return !pending_directories_.empty() || busy_threads_ == 0; });
+      if (pending_directories_.empty()) {
+        return;
+      }
+      auto dir = std::move(pending_directories_.front());
+      pending_directories_.pop_front();
+      ++busy_threads_;
+      lock.unlock();
+
+      auto contents = readDirectory(dir, *logger_);
+
+      lock.lock();
+      --busy_threads_;
+      std::move(contents.files.begin(), contents.files.end(), std::back_inserter(files_));
+      for (auto& subdirectory : contents.subdirectories) {
+        if (dir_callback_(subdirectory)) {
+          pending_directories_.push_back(std::move(subdirectory));
+        }
+      }
+      directories_changed_.notify_all();
+    }
+  }
+
+  const std::function<bool(const std::filesystem::path&)>& dir_callback_;
+  std::shared_ptr<core::logging::Logger> logger_;
+  std::mutex mutex_;
+  std::condition_variable directories_changed_;
+  std::deque<std::filesystem::path> pending_directories_;
+  size_t busy_threads_ = 0;
+  std::vector<DirectoryEntry> files_;
+};
+
+}  // namespace
+
+std::vector<DirectoryEntry> list_dir_entries(const std::filesystem::path& dir,
+    const std::function<bool(const std::filesystem::path&)>& dir_callback,
+    size_t thread_count,
+    const std::shared_ptr<core::logging::Logger>& logger) {
+  logger->log_debug("Performing file listing against {} on {} threads", dir, thread_count);
+  if (!utils::file::exists(dir)) {
+    logger->log_warn("Failed to open directory: {}", dir);
+    return {};
+  }
+  return DirectoryListing{dir_callback, logger}.run(dir, std::max(thread_count, size_t{1}));
+}
+
+std::optional<DirectoryEntry> get_directory_entry(const std::filesystem::path& file_path) {
+#ifndef WIN32
+  struct stat file_status{};
+  if (stat(file_path.c_str(), &file_status) != 0 || S_ISDIR(file_status.st_mode)) {
+    return std::nullopt;
+  }
+  return toDirectoryEntry(file_path.parent_path(), file_path.filename(), file_status);
+#else
+  std::error_code error;
+  const auto status = std::filesystem::status(file_path, error);
+  if (error || std::filesystem::is_directory(status)) {
+    return std::nullopt;
+  }
+  const auto last_write_time = std::filesystem::last_write_time(file_path, error);
+  if (error) {
+    return std::nullopt;
+  }
+  const auto size = std::filesystem::is_regular_file(status) ? std::filesystem::file_size(file_path, error) : 0;
+  if (error) {
+    return std::nullopt;
+  }
+  return DirectoryEntry{
+    .directory = file_path.parent_path(),
+    .filename = file_path.filename(),
+    .last_modified = to_sys(last_write_time),
+    .size = size};
+#endif
+}
+
+}  // namespace org::apache::nifi::minifi::utils::file
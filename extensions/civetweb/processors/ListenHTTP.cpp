@@ -20,6 +20,7 @@
  */
 #include "ListenHTTP.h"
 
+#include <future>
 #include <memory>
 #include <set>
 #include <string>
@@ -30,6 +31,7 @@
 #include "minifi-cpp/utils/gsl.h"
 #include "utils/ProcessorConfigUtils.h"
 #include "io/StreamPipe.h"
+#include "io/StreamSlice.h"
 
 namespace org::apache::nifi::minifi::processors {
 
@@ -113,9 +115,13 @@ void ListenHTTP::onSchedule(core::ProcessContext& context, core::ProcessSessionF
     flow_id = flow_version->getFlowId();
   }
 
+  ingestion_mode_ = utils::parseEnumProperty<listen_http::IngestionMode>(context, IngestionMode);
+  logger_->log_debug("ListenHTTP using {}: {}", IngestionMode.name, magic_enum::enum_name(ingestion_mode_));
+
   const auto buffer_size = utils::parseU64Property(context, BufferSize);
   handler_ = std::make_unique<Handler>(base_path, flow_id, buffer_size, std::move(authDNPattern),
-    headersAsAttributesPattern.empty() ? std::nullopt : std::make_optional<utils::Regex>(headersAsAttributesPattern));
+    headersAsAttributesPattern.empty() ? std::nullopt : std::make_optional<utils::Regex>(headersAsAttributesPattern),
+    ingestion_mode_ == listen_http::IngestionMode::Streaming ? context.getContentRepository() : nullptr);
   server_->addHandler(base_path, handler_.get());
 
   if (randomPort) {
@@ -145,7 +151,7 @@ void ListenHTTP::onTrigger(core::ProcessContext& context, core::ProcessSession&
     }
   }
   const bool incoming_processed = processIncomingFlowFile(session);
-  const bool request_processed = processRequestBuffer(session);
+  const bool request_processed = ingestion_mode_ == listen_http::IngestionMode::Streaming ? processCompletedRequests(session) : processRequestBuffer(session);
   if (!restored_processed && !incoming_processed && !request_processed) {
     context.yield();
   }
@@ -210,6 +216,49 @@ bool ListenHTTP::processRequestBuffer(core::ProcessSession& session) {
   return flow_file_count > 0;
 }
 
+/// @return Whether there was a request processed
+bool ListenHTTP::processCompletedRequests(core::ProcessSession& session) {
+  gsl_Expects(handler_);
+  // the requests are answered only after the session is committed, so an acknowledged request cannot be lost by a rollback or a shutdown
+  std::vector<std::promise<bool>> pending_responses;
+  try {
+    while (batch_size_ == 0 || batch_size_ > pending_responses.size()) {
+      Handler::CompletedRequest req;
+      if (!handler_->dequeueCompletedRequest(req)) {
+        break;
+      }
+      pending_responses.push_back(std::move(req.committed));
+
+      auto flow_file = session.create();
+      for (const auto& [key, value] : req.attributes) {
+        flow_file->setAttribute(key, value);
+      }
+      if (req.claim) {
+        // the content was already written to the content repository by the handler, the claim only needs to be attached
+        flow_file->setResourceClaim(req.claim);
+        flow_file->setSize(req.size);
+        flow_file->setOffset(0);
+      }
+      session.transfer(flow_file, Success);
+    }
+
+    if (!pending_responses.empty()) {
+      logger_->log_debug("ListenHTTP committing {} flow files of completed HTTP requests", pending_responses.size());
+      session.commit();
+    }
+  } catch (...) {
+    for (auto& response : pending_responses) {
+      response.set_value(false);
+    }
+    throw;
+  }
+
+  for (auto& response : pending_responses) {
+    response.set_value(true);
+  }
+  return !pending_responses.empty();
+}
+
 namespace {
 
 class MgConnectionInputStream : public io::InputStreamImpl {
@@ -251,12 +300,14 @@ class MgConnectionOutputStream : public io::StreamImpl, public virtual io::Outpu
 
 }  // namespace
 
-ListenHTTP::Handler::Handler(std::string base_uri, std::optional<std::string> flow_id, uint64_t buffer_size, std::string &&auth_dn_regex, std::optional<utils::Regex> &&headers_as_attrs_regex)
+ListenHTTP::Handler::Handler(std::string base_uri, std::optional<std::string> flow_id, uint64_t buffer_size, std::string &&auth_dn_regex, std::optional<utils::Regex> &&headers_as_attrs_regex,
+    std::shared_ptr<core::ContentRepository> content_repo)
     : base_uri_(std::move(base_uri)),
       flow_id_(std::move(flow_id)),
       auth_dn_regex_(std::move(auth_dn_regex)),
       headers_as_attrs_regex_(std::move(headers_as_attrs_regex)),
-      buffer_size_(buffer_size) {
+      buffer_size_(buffer_size),
+      content_repo_(std::move(content_repo)) {
   logger_->log_debug("ListenHTTP using {}: {}", BufferSize.name, buffer_size_);
 }
 
@@ -272,21 +323,103 @@ void ListenHTTP::Handler::sendHttp503(mg_connection* const conn) {
                   "Content-Length: 0\r\n\r\n");
 }
 
-void ListenHTTP::Handler::setHeaderAttributes(const mg_request_info *req_info, core::FlowFile& flow_file) const {
+std::map<std::string, std::string> ListenHTTP::Handler::getHeaderAttributes(const mg_request_info *req_info) const {
+  std::map<std::string, std::string> attributes;
   // Add filename from "filename" header value (and pattern headers)
   for (int i = 0; i < req_info->num_headers; i++) {
     auto header = &req_info->http_headers[i];
 
     if (strcmp("filename", header->name) == 0) {
-      flow_file.setAttribute("filename", header->value);
+      attributes["filename"] = header->value;
     } else if (headers_as_attrs_regex_ && utils::regexMatch(header->name, *headers_as_attrs_regex_)) {
-      flow_file.setAttribute(header->name, header->value);
+      attributes[header->name] = header->value;
     }
   }
 
   if (req_info->query_string) {
-    flow_file.addAttribute("http.query", req_info->query_string);
+    attributes.emplace("http.query", req_info->query_string);
+  }
+  return attributes;
+}
+
+void ListenHTTP::Handler::handleRequest(mg_connection *conn, const mg_request_info *req_info, bool write_body) {
+  if (content_repo_) {
+    streamRequest(conn, req_info, write_body);
+  } else {
+    enqueueRequest(conn, req_info, write_body);
+  }
+}
+
+void ListenHTTP::Handler::streamRequest(mg_connection *conn, const mg_request_info *req_info, bool write_body) {
+  // the place in the buffer is reserved before the body is received, so concurrent requests cannot exceed the buffer size
+  if (++streamed_request_count_ > buffer_size_ && buffer_size_ != 0) {
+    --streamed_request_count_;
+    logger_->log_warn("ListenHTTP buffer is full, '{}' request for '{}' uri was dropped", req_info->request_method, req_info->request_uri);
+    sendHttp503(conn);
+    return;
+  }
+  bool enqueued = false;
+  const auto release_reservation = gsl::finally([this, &enqueued] {
+    if (!enqueued) {
+      --streamed_request_count_;
+    }
+  });
+
+  {
+    std::lock_guard lock(request_mtx_);
+    if (!running_) {
+      sendHttp503(conn);
+      return;
+    }
+  }
+
+  CompletedRequest req;
+  if (flow_id_) {
+    req.attributes[std::string{core::SpecialFlowAttribute::FLOW_ID}] = flow_id_.value();
   }
+  req.attributes.merge(getHeaderAttributes(req_info));
+
+  if (write_body) {
+    // if the request fails, dropping the claim removes the partially written content
+    req.claim = ResourceClaim::create(content_repo_);
+    const auto content_stream = content_repo_->write(*req.claim);
+    if (!content_stream) {
+      logger_->log_error("ListenHTTP failed to open content for writing, '{}' request for '{}' uri was dropped", req_info->request_method, req_info->request_uri);
+      sendHttp500(conn);
+      return;
+    }
+    std::optional<size_t> request_size = std::nullopt;
+    if (req_info->content_length > 0) { request_size = gsl::narrow<size_t>(req_info->content_length); }
+    MgConnectionInputStream mg_body{conn, request_size};
+    if (!minifi::internal::pipe(mg_body, *content_stream)) {
+      logger_->log_error("ListenHTTP failed to write request body, '{}' request for '{}' uri was dropped", req_info->request_method, req_info->request_uri);
+      content_stream->close();
+      sendHttp500(conn);
+      return;
+    }
+    req.size = content_stream->size();
+    content_stream->close();
+  }
+
+  auto committed = req.committed.get_future();
+  {
+    // checked again under the lock, so a request cannot be enqueued after stop() drained the queue
+    std::lock_guard lock(request_mtx_);
+    if (!running_) {
+      sendHttp503(conn);
+      return;
+    }
+    completed_requests_.enqueue(std::move(req));
+    enqueued = true;
+  }
+
+  if (!committed.get()) {
+    logger_->log_warn("ListenHTTP could not commit the flow file of '{}' request for '{}' uri", req_info->request_method, req_info->request_uri);
+    sendHttp503(conn);
+    return;
+  }
+  mg_printf(conn, "HTTP/1.1 200 OK\r\n");
+  writeBody(nullptr, conn, req_info);
 }
 
 void ListenHTTP::Handler::enqueueRequest(mg_connection *conn, const mg_request_info *req_info, bool write_body) {
@@ -334,7 +467,9 @@ void ListenHTTP::Handler::enqueueRequest(mg_connection *conn, const mg_request_i
     });
   }
 
-  setHeaderAttributes(req_info, *flow_file);
+  for (const auto& [key, value] : getHeaderAttributes(req_info)) {
+    flow_file->setAttribute(key, value);
+  }
   mg_printf(conn, "HTTP/1.1 200 OK\r\n");
   writeBody(&session.get(), conn, req_info);
 
@@ -358,7 +493,7 @@ bool ListenHTTP::Handler::handlePost(CivetServer* /*server*/, struct mg_connecti
   // Always send 100 Continue, as allowed per standard to minimize client delay (https://www.w3.org/Protocols/rfc2616/rfc2616-sec8.html)
   mg_printf(conn, "HTTP/1.1 100 Continue\r\n\r\n");
 
-  enqueueRequest(conn, req_info, true);
+  handleRequest(conn, req_info, true);
   return true;
 }
 
@@ -389,7 +524,7 @@ bool ListenHTTP::Handler::handleGet(CivetServer* /*server*/, struct mg_connectio
     return true;
   }
 
-  enqueueRequest(conn, req_info, false);
+  handleRequest(conn, req_info, false);
   return true;
 }
 
@@ -406,7 +541,7 @@ bool ListenHTTP::Handler::handleHead(CivetServer* /*server*/, struct mg_connecti
   }
 
   mg_printf(conn, "HTTP/1.1 200 OK\r\n");
-  writeBody(nullptr, conn, req_info);
+  writeBody(nullptr, conn, req_info, false);
 
   return true;
 }
@@ -446,7 +581,39 @@ bool ListenHTTP::Handler::dequeueRequest(Request& req) {
   return request_buffer_.tryDequeue(req);
 }
 
-void ListenHTTP::Handler::writeBody(core::ProcessSession* payload_reader, mg_connection *conn, const mg_request_info *req_info) {
+bool ListenHTTP::Handler::dequeueCompletedRequest(CompletedRequest& req) {
+  if (!completed_requests_.tryDequeue(req)) {
+    return false;
+  }
+  --streamed_request_count_;
+  return true;
+}
+
+void ListenHTTP::Handler::writeResponsePayload(core::ProcessSession* payload_reader, mg_connection *conn, const std::shared_ptr<core::FlowFile>& flow_file) const {
+  if (payload_reader) {
+    payload_reader->read(flow_file, [&] (auto& content) {
+      MgConnectionOutputStream out{conn};
+      return minifi::internal::pipe(*content, out);
+    });
+    return;
+  }
+
+  // in streaming mode there is no session on the server thread, the response body is read from the content repository directly
+  const auto claim = flow_file->getResourceClaim();
+  if (!content_repo_ || !claim) {
+    return;
+  }
+  const auto content_stream = content_repo_->read(*claim);
+  if (!content_stream) {
+    logger_->log_error("ListenHTTP failed to read response body content {}", claim->getContentFullPath());
+    return;
+  }
+  io::StreamSlice content{content_stream, gsl::narrow<size_t>(flow_file->getOffset()), gsl::narrow<size_t>(flow_file->getSize())};
+  MgConnectionOutputStream out{conn};
+  minifi::internal::pipe(content, out);
+}
+
+void ListenHTTP::Handler::writeBody(core::ProcessSession* payload_reader, mg_connection *conn, const mg_request_info *req_info, bool include_payload) {
   const auto &request_uri_str = std::string(req_info->request_uri);
 
   if (request_uri_str.size() > base_uri_.size() + 1) {
@@ -469,11 +636,8 @@ void ListenHTTP::Handler::writeBody(core::ProcessSession* payload_reader, mg_con
       mg_printf(conn, "Content-length: ");
       mg_printf(conn, "%s", std::to_string(response.flow_file->getSize()).c_str());
       mg_printf(conn, "\r\n\r\n");
-      if (payload_reader) {
-        payload_reader->read(response.flow_file, [&] (auto& content) {
-          MgConnectionOutputStream out{conn};
-          return minifi::internal::pipe(*content, out);
-        });
+      if (include_payload) {
+        writeResponsePayload(payload_reader, conn, response.flow_file);
       }
     } else {
       logger_->log_debug("No response body available for URI: {}", req_info->request_uri);
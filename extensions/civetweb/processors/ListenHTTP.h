@@ -19,6 +19,7 @@
  */
 #pragma once
 
+#include <atomic>
 #include <map>
 #include <memory>
 #include <string>
@@ -28,6 +29,8 @@
 #include <CivetServer.h>
 
 #include "minifi-cpp/FlowFileRecord.h"
+#include "minifi-cpp/ResourceClaim.h"
+#include "minifi-cpp/core/ContentRepository.h"
 #include "core/ProcessSession.h"
 #include "minifi-cpp/core/PropertyDefinition.h"
 #include "core/PropertyDefinitionBuilder.h"
@@ -36,6 +39,7 @@
 #include "core/Core.h"
 #include "core/logging/LoggerFactory.h"
 #include "utils/MinifiConcurrentQueue.h"
+#include "utils/Enum.h"
 #include "minifi-cpp/utils/gsl.h"
 #include "minifi-cpp/utils/Export.h"
 #include "utils/RegexUtils.h"
@@ -46,6 +50,13 @@ namespace org::apache::nifi::minifi::test {
 struct ListenHTTPTestAccessor;
 }  // namespace org::apache::nifi::minifi::test
 
+namespace org::apache::nifi::minifi::processors::listen_http {
+enum class IngestionMode {
+  Synchronous,
+  Streaming
+};
+}  // namespace org::apache::nifi::minifi::processors::listen_http
+
 namespace org::apache::nifi::minifi::processors {
 
 class ListenHTTP : public core::ProcessorImpl {
@@ -120,6 +131,14 @@ class ListenHTTP : public core::ProcessorImpl {
         .withValidator(core::StandardPropertyValidators::UNSIGNED_INTEGER_VALIDATOR)
         .withDefaultValue(ListenHTTP::DEFAULT_BUFFER_SIZE_STR)
         .build();
+  EXTENSIONAPI static constexpr auto IngestionMode = core::PropertyDefinitionBuilder<magic_enum::enum_count<listen_http::IngestionMode>()>::createProperty("Ingestion Mode")
+        .withDescription("In Synchronous mode each request waits until the processor is triggered, and is answered after its flow file is created in the processor's session. "
+            "In Streaming mode the request body is written to the content repository on the HTTP server thread, the flow files of the received requests are committed "
+            "in batches when the processor is triggered, and each request is answered after its flow file is committed. In Streaming mode Buffer Size limits the number "
+            "of received but not yet committed requests, and these requests are answered with 503 if the processor stops before committing them.")
+        .withAllowedValues(magic_enum::enum_names<listen_http::IngestionMode>())
+        .withDefaultValue(magic_enum::enum_name(listen_http::IngestionMode::Synchronous))
+        .build();
   EXTENSIONAPI static constexpr auto Properties = std::to_array<core::PropertyReference>({
       BasePath,
       Port,
@@ -130,7 +149,8 @@ class ListenHTTP : public core::ProcessorImpl {
       SSLMinimumVersion,
       HeadersAsAttributesRegex,
       BatchSize,
-      BufferSize
+      BufferSize,
+      IngestionMode
   });
 
 
@@ -177,11 +197,25 @@ class ListenHTTP : public core::ProcessorImpl {
     };
     using Request = std::promise<std::expected<RequestValue, FailureValue>>;
 
+    // a request received in streaming mode, waiting for its flow file to be committed before it is answered
+    struct CompletedRequest {
+      std::map<std::string, std::string> attributes;
+      std::shared_ptr<ResourceClaim> claim;
+      uint64_t size{0};
+      // set to whether the session owning the flow file of the request was committed
+      std::promise<bool> committed;
+    };
+
+    /**
+     * @param content_repo if set, requests are streamed into the content repository on the server thread, and completed requests
+     * are collected by the processor with dequeueCompletedRequest, otherwise every request waits for a session through dequeueRequest
+     */
     Handler(std::string base_uri,
             std::optional<std::string> flow_id,
             uint64_t buffer_size,
             std::string &&auth_dn_regex,
-            std::optional<utils::Regex> &&headers_as_attrs_regex);
+            std::optional<utils::Regex> &&headers_as_attrs_regex,
+            std::shared_ptr<core::ContentRepository> content_repo = nullptr);
     bool handlePost(CivetServer *server, struct mg_connection *conn) override;
     bool handleGet(CivetServer *server, struct mg_connection *conn) override;
     bool handleHead(CivetServer *server, struct mg_connection *conn) override;
@@ -195,13 +229,14 @@ class ListenHTTP : public core::ProcessorImpl {
     bool setResponseBody(const ResponseBody& response);
 
     bool dequeueRequest(Request& req);
+    bool dequeueCompletedRequest(CompletedRequest& req);
 
     size_t requestCount() const {
-      return request_buffer_.size();
+      return request_buffer_.size() + completed_requests_.size();
     }
 
     bool empty() const {
-      return request_buffer_.empty();
+      return request_buffer_.empty() && completed_requests_.empty();
     }
 
     void stop() {
@@ -214,15 +249,22 @@ class ListenHTTP : public core::ProcessorImpl {
         req.set_value(std::unexpected{FailureValue{Handler::FailureReason::PROCESSOR_SHUTDOWN, std::move(req_done_promise)}});
         req_done.wait();
       }
+      CompletedRequest completed_req;
+      while (dequeueCompletedRequest(completed_req)) {
+        completed_req.committed.set_value(false);
+      }
     }
 
    private:
     static void sendHttp500(struct mg_connection *conn);
     static void sendHttp503(struct mg_connection *conn);
     bool authRequest(mg_connection *conn, const mg_request_info *req_info) const;
-    void setHeaderAttributes(const mg_request_info *req_info, core::FlowFile& flow_file) const;
-    void writeBody(core::ProcessSession* payload_reader, mg_connection *conn, const mg_request_info *req_info);
+    std::map<std::string, std::string> getHeaderAttributes(const mg_request_info *req_info) const;
+    void writeBody(core::ProcessSession* payload_reader, mg_connection *conn, const mg_request_info *req_info, bool include_payload = true);
+    void writeResponsePayload(core::ProcessSession* payload_reader, mg_connection *conn, const std::shared_ptr<core::FlowFile>& flow_file) const;
+    void handleRequest(mg_connection *conn, const mg_request_info *req_info, bool write_body);
     void enqueueRequest(mg_connection *conn, const mg_request_info *req_info, bool write_body);
+    void streamRequest(mg_connection *conn, const mg_request_info *req_info, bool write_body);
 
     std::string base_uri_;
     std::optional<std::string> flow_id_;
@@ -235,6 +277,10 @@ class ListenHTTP : public core::ProcessorImpl {
     std::mutex request_mtx_;
     bool running_{true};
     utils::ConcurrentQueue<Request> request_buffer_;
+    std::shared_ptr<core::ContentRepository> content_repo_;
+    utils::ConcurrentQueue<CompletedRequest> completed_requests_;
+    // the requests in completed_requests_ and the ones being received in streaming mode
+    std::atomic<uint64_t> streamed_request_count_{0};
   };
 
   static int logMessage(const struct mg_connection *conn, const char *message) {
@@ -280,6 +326,7 @@ class ListenHTTP : public core::ProcessorImpl {
   bool processIncomingFlowFile(core::ProcessSession &session);
   bool processFlowFile(const std::shared_ptr<core::FlowFile>& flow_file);
   bool processRequestBuffer(core::ProcessSession &session);
+  bool processCompletedRequests(core::ProcessSession &session);
   size_t pendingRequestCount() {
     return handler_ ? handler_->requestCount() : 0;
   }
@@ -289,6 +336,7 @@ class ListenHTTP : public core::ProcessorImpl {
   std::unique_ptr<Handler> handler_;
   std::string listeningPort;
   uint64_t batch_size_{0};
+  listen_http::IngestionMode ingestion_mode_{listen_http::IngestionMode::Synchronous};
   core::FlowFileStore file_store_;
 };
 
@@ -16,11 +16,14 @@
  * limitations under the License.
  */
 
+#include <atomic>
 #include <fstream>
 #include <map>
 #include <memory>
 #include <set>
 #include <iostream>
+#include <thread>
+#include <vector>
 
 #include "unit/TestBase.h"
 #include "unit/Catch.h"
@@ -141,6 +144,7 @@ class ListenHTTPTestsFixture {
   void run_server() {
     plan->setProperty(listen_http, minifi::processors::ListenHTTP::BatchSize, std::to_string(batch_size_));
     plan->setProperty(listen_http, minifi::processors::ListenHTTP::BufferSize, std::to_string(buffer_size_));
+    plan->setProperty(listen_http, minifi::processors::ListenHTTP::IngestionMode, ingestion_mode_);
 
     plan->runNextProcessor();  // GetFile
     plan->runNextProcessor();  // UpdateAttribute
@@ -265,6 +269,7 @@ class ListenHTTPTestsFixture {
   std::string url;
   std::size_t batch_size_ = 0;
   std::size_t buffer_size_ = 0;
+  std::string ingestion_mode_ = "Synchronous";
 };
 
 TEST_CASE("ListenHTTP creation", "[basic]") {
@@ -452,6 +457,144 @@ TEST_CASE_METHOD(ListenHTTPTestsFixture, "HTTP Batch tests", "[batch]") {
   test_connect(requests, expected_processed_request_count);
 }
 
+TEST_CASE_METHOD(ListenHTTPTestsFixture, "HTTP requests in streaming mode", "[streaming]") {
+  ingestion_mode_ = "Streaming";
+
+  SECTION("GET") {
+    method = HttpRequestMethod::Get;
+  }
+  SECTION("POST") {
+    method = HttpRequestMethod::Post;
+    payload = "Test payload";
+  }
+
+  run_server();
+  test_connect();
+}
+
+TEST_CASE_METHOD(ListenHTTPTestsFixture, "HTTP POST in streaming mode is answered after its flow file is committed", "[streaming]") {
+  ingestion_mode_ = "Streaming";
+  run_server();
+
+  method = HttpRequestMethod::Post;
+  payload = "Test payload";
+  std::atomic<size_t> answered_count{0};
+  std::vector<std::thread> client_threads;
+  for (size_t i = 0; i < 3; ++i) {
+    client_threads.emplace_back([this, &answered_count] {
+      auto client = initialize_client();
+      check_response(client->submit(), HttpResponseExpectations{}, *client);
+      ++answered_count;
+    });
+  }
+  REQUIRE(minifi::test::utils::verifyEventHappenedInPollTime(10s, [&] { return ListenHTTPTestAccessor::call_pendingRequestCount(listen_http.get()) == 3; }));
+  CHECK(answered_count == 0);
+
+  plan->runCurrentProcessor();  // ListenHTTP
+  for (auto& thread : client_threads) {
+    thread.join();
+  }
+  CHECK(answered_count == 3);
+  plan->runNextProcessor();  // LogAttribute
+  CHECK(ListenHTTPTestAccessor::call_pendingRequestCount(listen_http.get()) == 0);
+  CHECK(LogTestController::getInstance().contains("Size:" + std::to_string(payload.size()) + " Offset:0"));
+  CHECK(LogTestController::getInstance().contains("Logged 3 flow files"));
+}
+
+TEST_CASE_METHOD(ListenHTTPTestsFixture, "HTTP requests in streaming mode are refused if the buffer is full", "[streaming]") {
+  ingestion_mode_ = "Streaming";
+  buffer_size_ = 1;
+  run_server();
+
+  method = HttpRequestMethod::Post;
+  payload = "Test payload";
+  std::thread first_client_thread([this] {
+    auto first_client = initialize_client();
+    check_response(first_client->submit(), HttpResponseExpectations{}, *first_client);
+  });
+  REQUIRE(minifi::test::utils::verifyEventHappenedInPollTime(10s, [&] { return ListenHTTPTestAccessor::call_pendingRequestCount(listen_http.get()) == 1; }));
+  auto second_client = initialize_client();
+  check_response(second_client->submit(), HttpResponseExpectations{true, 503}, *second_client);
+
+  plan->runCurrentProcessor();  // ListenHTTP
+  first_client_thread.join();
+  plan->runNextProcessor();  // LogAttribute
+  CHECK(LogTestController::getInstance().contains("Logged 1 flow files"));
+}
+
+TEST_CASE_METHOD(ListenHTTPTestsFixture, "Concurrent HTTP requests in streaming mode do not exceed the buffer size", "[streaming]") {
+  ingestion_mode_ = "Streaming";
+  buffer_size_ = 3;
+  run_server();
+
+  method = HttpRequestMethod::Post;
+  payload = "Test payload";
+  std::vector<std::unique_ptr<minifi::http::HTTPClient>> clients;
+  for (size_t i = 0; i < 10; ++i) {
+    clients.push_back(initialize_client());
+  }
+  std::atomic<size_t> accepted_count{0};
+  std::atomic<size_t> refused_count{0};
+  std::vector<std::thread> client_threads;
+  for (auto& client : clients) {
+    client_threads.emplace_back([&client, &accepted_count, &refused_count] {
+      if (client->submit() && client->getResponseCode() == 200) {
+        ++accepted_count;
+      } else {
+        ++refused_count;
+      }
+    });
+  }
+  // the accepted requests are only answered after the processor commits them
+  REQUIRE(minifi::test::utils::verifyEventHappenedInPollTime(10s, [&] { return refused_count == clients.size() - buffer_size_; }));
+  CHECK(ListenHTTPTestAccessor::call_pendingRequestCount(listen_http.get()) == buffer_size_);
+
+  plan->runCurrentProcessor();  // ListenHTTP
+  for (auto& thread : client_threads) {
+    thread.join();
+  }
+  CHECK(accepted_count == buffer_size_);
+  plan->runNextProcessor();  // LogAttribute
+  CHECK(LogTestController::getInstance().contains("Logged 3 flow files"));
+}
+
+TEST_CASE_METHOD(ListenHTTPTestsFixture, "HTTP requests in streaming mode are only acknowledged if they are committed before the processor stops", "[streaming]") {
+  ingestion_mode_ = "Streaming";
+  batch_size_ = 2;
+  run_server();
+
+  method = HttpRequestMethod::Post;
+  payload = "Test payload";
+  std::atomic<size_t> accepted_count{0};
+  std::atomic<size_t> refused_count{0};
+  std::vector<std::thread> client_threads;
+  for (size_t i = 0; i < 3; ++i) {
+    client_threads.emplace_back([this, &accepted_count, &refused_count] {
+      auto client = initialize_client();
+      const bool success = client->submit();
+      if (success && client->getResponseCode() == 200) {
+        ++accepted_count;
+      } else if (success && client->getResponseCode() == 503) {
+        ++refused_count;
+      }
+    });
+  }
+  REQUIRE(minifi::test::utils::verifyEventHappenedInPollTime(10s, [&] { return ListenHTTPTestAccessor::call_pendingRequestCount(listen_http.get()) == 3; }));
+
+  plan->runCurrentProcessor();  // ListenHTTP commits a batch of 2 requests, the third one is still pending
+  plan->runNextProcessor();  // LogAttribute
+  REQUIRE(minifi::test::utils::verifyEventHappenedInPollTime(10s, [&] { return accepted_count == 2; }));
+
+  // stopping the processor answers the pending request without committing it, so the client can retry it
+  plan.reset();
+  for (auto& thread : client_threads) {
+    thread.join();
+  }
+  CHECK(accepted_count == 2);
+  CHECK(refused_count == 1);
+  CHECK(LogTestController::getInstance().contains("Logged 2 flow files"));
+}
+
 TEST_CASE_METHOD(ListenHTTPTestsFixture, "HTTPS without CA", "[basic][https]") {
   plan->setProperty(listen_http, minifi::processors::ListenHTTP::SSLCertificate, (minifi::utils::file::FileUtils::get_executable_dir() / "resources" / "server.pem").string());
 
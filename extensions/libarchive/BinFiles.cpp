@@ -16,6 +16,7 @@
  */
 #include "BinFiles.h"
 
+#include <algorithm>
 #include <cstdio>
 #include <deque>
 #include <map>
@@ -50,7 +51,7 @@ void BinFiles::initialize() {
   setSupportedRelationships(Relationships);
 }
 
-void BinFiles::onSchedule(core::ProcessContext& context, core::ProcessSessionFactory&) {
+void BinFiles::onSchedule(core::ProcessContext& context, core::ProcessSessionFactory& session_factory) {
   if (const auto val64 = utils::parseOptionalU64Property(context, MinSize)) {
     this->binManager_.setMinSize(*val64);
     logger_->log_debug("BinFiles: MinSize [{}]", val64);
@@ -78,6 +79,16 @@ void BinFiles::onSchedule(core::ProcessContext& context, core::ProcessSessionFac
   }
   batchSize_ = gsl::narrow<uint32_t>(utils::parseU64Property(context, BatchSize));
   logger_->log_debug("BinFiles: BatchSize [{}]", batchSize_);
+
+  persistence_ = utils::parseEnumProperty<bin_files::BinnedFlowFilePersistence>(context, FlowFilePersistence);
+  logger_->log_debug("BinFiles: Binned FlowFile Persistence [{}]", magic_enum::enum_name(persistence_));
+  std::lock_guard<std::mutex> lock(held_session_mutex_);
+  if (held_session_) {
+    // the flow files held by the previous session are returned to the incoming connections, and removed from their bins
+    std::deque<std::unique_ptr<Bin>> no_ready_bins;
+    rollbackHeldSession(no_ready_bins);
+  }
+  held_session_ = persistence_ == bin_files::BinnedFlowFilePersistence::OnMerge ? session_factory.createSession() : nullptr;
 }
 
 void BinFiles::preprocessFlowFile(const std::shared_ptr<core::FlowFile>& flow) {
@@ -94,57 +105,87 @@ void BinFiles::preprocessFlowFile(const std::shared_ptr<core::FlowFile>& flow) {
   }
 }
 
+BinManager::Shard& BinManager::getShard(const std::string& group) {
+  return shards_[std::hash<std::string>{}(group) % shards_.size()];
+}
+
+std::unique_ptr<Bin> BinManager::takeFirstBin(Shard& shard, std::deque<std::unique_ptr<Bin>>& queue) {
+  auto bin = std::move(queue.front());
+  queue.pop_front();
+  shard.binsByCreationDate.erase({bin->getCreationDate(), bin.get()});
+  binCount_--;
+  return bin;
+}
+
 void BinManager::gatherReadyBins() {
-  std::lock_guard < std::mutex > lock(mutex_);
-  std::vector< std::string > emptyQueue;
-  for (auto& [group_id, queue] : groupBinMap_) {
-    while (!queue->empty()) {
-      std::unique_ptr<Bin> &bin = queue->front();
-      if (bin->isReadyForMerge() || (binAge_ != std::chrono::milliseconds::max() && bin->isOlderThan(binAge_))) {
-        readyBin_.push_back(std::move(bin));
-        queue->pop_front();
-        binCount_--;
-        logger_->log_debug("BinManager move bin {} to ready bins for group {}", readyBin_.back()->getUUIDStr(), readyBin_.back()->getGroupId());
-      } else {
-        break;
+  const bool has_max_age = binAge_ != std::chrono::milliseconds::max();
+  const auto now = std::chrono::system_clock::now();
+  std::vector<std::unique_ptr<Bin>> ready_bins;
+  for (auto& shard : shards_) {
+    std::lock_guard<std::mutex> lock(shard.mutex);
+    if (has_max_age) {
+      for (auto it = shard.binsByCreationDate.begin(); it != shard.binsByCreationDate.end() && now > it->first + binAge_; ++it) {
+        shard.groupsWithReadyBins.insert(it->second->getGroupId());
       }
     }
-    if (queue->empty()) {
-      emptyQueue.push_back(group_id);
+    for (const auto& group : shard.groupsWithReadyBins) {
+      auto search = shard.groupBinMap.find(group);
+      if (search == shard.groupBinMap.end()) {
+        continue;
+      }
+      auto& queue = search->second;
+      while (!queue.empty() && (queue.front()->isReadyForMerge() || (has_max_age && queue.front()->isOlderThan(binAge_)))) {
+        ready_bins.push_back(takeFirstBin(shard, queue));
+      }
+      if (queue.empty()) {
+        // erase from the map if the queue is empty for the group
+        shard.groupBinMap.erase(search);
+      }
     }
+    shard.groupsWithReadyBins.clear();
   }
-  for (const auto& group : emptyQueue) {
-    // erase from the map if the queue is empty for the group
-    groupBinMap_.erase(group);
+
+  // the bins of the different shards are merged in the order they were created in
+  std::stable_sort(ready_bins.begin(), ready_bins.end(), [](const auto& lhs, const auto& rhs) { return lhs->getCreationDate() < rhs->getCreationDate(); });
+  std::lock_guard<std::mutex> lock(mutex_);
+  for (auto& bin : ready_bins) {
+    logger_->log_debug("BinManager move bin {} to ready bins for group {}", bin->getUUIDStr(), bin->getGroupId());
+    readyBin_.push_back(std::move(bin));
   }
-  logger_->log_debug("BinManager groupBinMap size {}", groupBinMap_.size());
+  logger_->log_debug("BinManager bin count {}", binCount_.load());
 }
 
 void BinManager::removeOldestBin() {
-  std::lock_guard < std::mutex > lock(mutex_);
+  Shard* oldest_shard = nullptr;
   std::chrono::system_clock::time_point olddate = std::chrono::system_clock::time_point::max();
-  std::unique_ptr < std::deque<std::unique_ptr<Bin>>>* oldqueue = nullptr;
-  for (auto& [_, queue] : groupBinMap_) {
-    if (!queue->empty()) {
-      std::unique_ptr<Bin> &bin = queue->front();
-      if (bin->getCreationDate() < olddate) {
-        olddate = bin->getCreationDate();
-        oldqueue = &queue;
-      }
+  for (auto& shard : shards_) {
+    std::lock_guard<std::mutex> lock(shard.mutex);
+    if (!shard.binsByCreationDate.empty() && shard.binsByCreationDate.begin()->first < olddate) {
+      olddate = shard.binsByCreationDate.begin()->first;
+      oldest_shard = &shard;
     }
   }
-  if (olddate != std::chrono::system_clock::time_point::max()) {
-    std::unique_ptr<Bin> &remove = (*oldqueue)->front();
-    std::string group = remove->getGroupId();
-    readyBin_.push_back(std::move(remove));
-    (*oldqueue)->pop_front();
-    binCount_--;
-    logger_->log_debug("BinManager move bin {} to ready bins for group {}", readyBin_.back()->getUUIDStr(), readyBin_.back()->getGroupId());
-    if ((*oldqueue)->empty()) {
-      groupBinMap_.erase(group);
+  if (oldest_shard == nullptr) {
+    return;
+  }
+
+  std::unique_ptr<Bin> bin;
+  {
+    std::lock_guard<std::mutex> lock(oldest_shard->mutex);
+    // the bin may have been gathered since, then the current oldest one of the shard is removed
+    if (oldest_shard->binsByCreationDate.empty()) {
+      return;
+    }
+    // the bins of a group are created in order, so the oldest bin is the first one of its group
+    auto search = oldest_shard->groupBinMap.find(oldest_shard->binsByCreationDate.begin()->second->getGroupId());
+    bin = takeFirstBin(*oldest_shard, search->second);
+    if (search->second.empty()) {
+      oldest_shard->groupBinMap.erase(search);
     }
   }
-  logger_->log_debug("BinManager groupBinMap size {}", groupBinMap_.size());
+  logger_->log_debug("BinManager move bin {} to ready bins for group {}", bin->getUUIDStr(), bin->getGroupId());
+  addReadyBin(std::move(bin));
+  logger_->log_debug("BinManager bin count {}", binCount_.load());
 }
 
 void BinManager::getReadyBin(std::deque<std::unique_ptr<Bin>> &retBins) {
@@ -161,50 +202,68 @@ void BinManager::addReadyBin(std::unique_ptr<Bin> ready_bin) {
   readyBin_.push_back(std::move(ready_bin));
 }
 
+void BinManager::removeFlowFiles(const std::function<bool(const core::FlowFile&)>& predicate) {
+  for (auto& shard : shards_) {
+    std::lock_guard<std::mutex> lock(shard.mutex);
+    for (auto group = shard.groupBinMap.begin(); group != shard.groupBinMap.end();) {
+      auto& queue = group->second;
+      for (auto bin = queue.begin(); bin != queue.end();) {
+        (*bin)->removeFlowFiles(predicate);
+        if ((*bin)->getSize() > 0) {
+          ++bin;
+          continue;
+        }
+        shard.binsByCreationDate.erase({(*bin)->getCreationDate(), bin->get()});
+        bin = queue.erase(bin);
+        binCount_--;
+      }
+      if (queue.empty()) {
+        shard.groupsWithReadyBins.erase(group->first);
+        group = shard.groupBinMap.erase(group);
+      } else {
+        ++group;
+      }
+    }
+  }
+  std::lock_guard<std::mutex> lock(mutex_);
+  for (auto& bin : readyBin_) {
+    bin->removeFlowFiles(predicate);
+  }
+  std::erase_if(readyBin_, [](const std::unique_ptr<Bin>& bin) { return bin->getSize() == 0; });
+}
+
 bool BinManager::offer(const std::string &group, const std::shared_ptr<core::FlowFile>& flow) {
-  std::lock_guard < std::mutex > lock(mutex_);
   if (flow->getSize() > maxSize_) {
     // could not be added to a bin -- too large by itself, so create a separate bin for just this guy.
     auto bin = std::make_unique<Bin>(0, ULLONG_MAX, 1, INT_MAX, "", group);
     if (!bin->offer(flow))
       return false;
-    readyBin_.push_back(std::move(bin));
-    logger_->log_debug("BinManager move bin {} to ready bins for group {}", readyBin_.back()->getUUIDStr(), group);
+    logger_->log_debug("BinManager move bin {} to ready bins for group {}", bin->getUUIDStr(), group);
+    addReadyBin(std::move(bin));
     return true;
   }
-  auto search = groupBinMap_.find(group);
-  if (search != groupBinMap_.end()) {
-    std::unique_ptr < std::deque<std::unique_ptr<Bin>>>&queue = search->second;
-    if (!queue->empty()) {
-      std::unique_ptr<Bin> &tail = queue->back();
-      if (!tail->offer(flow)) {
-        // last bin can not offer the flow
-        auto bin = std::make_unique<Bin>(minSize_, maxSize_, minEntries_, maxEntries_, fileCount_, group);
-        if (!bin->offer(flow))
-          return false;
-        queue->push_back(std::move(bin));
-        logger_->log_debug("BinManager add bin {} to group {}", queue->back()->getUUIDStr(), group);
-        binCount_++;
-      }
-    } else {
-      auto bin = std::make_unique<Bin>(minSize_, maxSize_, minEntries_, maxEntries_, fileCount_, group);
-      if (!bin->offer(flow))
-        return false;
-      queue->push_back(std::move(bin));
-      binCount_++;
-      logger_->log_debug("BinManager add bin {} to group {}", queue->back()->getUUIDStr(), group);
-    }
-  } else {
-    auto queue = std::make_unique<std::deque<std::unique_ptr<Bin>>>();
+
+  auto& shard = getShard(group);
+  std::lock_guard<std::mutex> lock(shard.mutex);
+  auto& queue = shard.groupBinMap[group];
+  // the last bin is closed if it can not offer the flow
+  if (queue.empty() || !queue.back()->offer(flow)) {
     auto bin = std::make_unique<Bin>(minSize_, maxSize_, minEntries_, maxEntries_, fileCount_, group);
-    if (!bin->offer(flow))
+    if (!bin->offer(flow)) {
+      if (queue.empty()) {
+        shard.groupBinMap.erase(group);
+      }
       return false;
-    queue->push_back(std::move(bin));
-    logger_->log_debug("BinManager add bin {} to group {}", queue->back()->getUUIDStr(), group);
-    groupBinMap_.insert(std::make_pair(group, std::move(queue)));
+    }
+    shard.binsByCreationDate.emplace(bin->getCreationDate(), bin.get());
+    queue.push_back(std::move(bin));
     binCount_++;
+    logger_->log_debug("BinManager add bin {} to group {}", queue.back()->getUUIDStr(), group);
+  }
+  // only the last bin of a group can be open, the others are ready for merge
+  if (queue.size() > 1 || queue.front()->isReadyForMerge()) {
+    shard.groupsWithReadyBins.insert(group);
   }
-
   return true;
 }
 
@@ -224,6 +283,14 @@ bool BinFiles::resurrectFlowFiles(core::ProcessSession &session) {
 }
 
 bool BinFiles::assumeOwnershipOfNextBatch(core::ProcessSession &session) {
+  if (!binNextBatch(session, [&session](const std::shared_ptr<core::FlowFile>& flow) { session.transfer(flow, Self); })) {
+    return false;
+  }
+  session.commit();
+  return true;
+}
+
+bool BinFiles::binNextBatch(core::ProcessSession &session, const std::function<void(const std::shared_ptr<core::FlowFile>&)>& on_binned) {
   for (size_t i = 0; i < batchSize_; ++i) {
     auto flow = session.get();
 
@@ -242,9 +309,8 @@ bool BinFiles::assumeOwnershipOfNextBatch(core::ProcessSession &session) {
       session.transfer(flow, Failure);
       continue;
     }
-    session.transfer(flow, Self);
+    on_binned(flow);
   }
-  session.commit();
   return true;
 }
 
@@ -267,6 +333,51 @@ void BinFiles::processReadyBins(std::deque<std::unique_ptr<Bin>> ready_bins, cor
   }
 }
 
+void BinFiles::processReadyBinsInHeldSession(std::deque<std::unique_ptr<Bin>> ready_bins) {
+  try {
+    std::unordered_set<utils::Identifier> merged_flow_files;
+    for (auto& bin : ready_bins) {
+      for (const auto& flow : bin->getFlowFile()) {
+        if (!held_flow_files_.contains(flow->getUUID())) {
+          held_session_->add(flow);
+        }
+        merged_flow_files.insert(flow->getUUID());
+      }
+      logger_->log_debug("BinFiles start to process bin {} for group {}", bin->getUUIDStr(), bin->getGroupId());
+      if (!processBin(*held_session_, bin))
+        transferFlowsToFail(*held_session_, bin);
+    }
+    // the session can only be committed if every flow file taken by it is transferred
+    for (const auto& [uuid, flow] : held_flow_files_) {
+      if (!merged_flow_files.contains(uuid)) {
+        held_session_->transfer(flow, Self);
+      }
+    }
+    held_session_->commit();
+    // the session lives on, so its committed provenance events must not be persisted again by its next commit
+    held_session_->getProvenanceReporter()->clear();
+    held_flow_files_.clear();
+  } catch(const std::exception& ex) {
+    logger_->log_error("Caught Exception type: '{}' while merging ready bins: '{}'", typeid(ex).name(), ex.what());
+    rollbackHeldSession(ready_bins);
+  }
+}
+
+void BinFiles::rollbackHeldSession(std::deque<std::unique_ptr<Bin>>& ready_bins) {
+  // the rollback returns the held flow files to their incoming connections, so they are removed from the bins
+  held_session_->rollback();
+  held_session_->getProvenanceReporter()->clear();
+  const auto is_held = [this](const core::FlowFile& flow) { return held_flow_files_.contains(flow.getUUID()); };
+  binManager_.removeFlowFiles(is_held);
+  for (auto& bin : ready_bins) {
+    bin->removeFlowFiles(is_held);
+    if (bin->getSize() > 0) {
+      binManager_.addReadyBin(std::move(bin));
+    }
+  }
+  held_flow_files_.clear();
+}
+
 std::deque<std::unique_ptr<Bin>> BinFiles::gatherReadyBins(core::ProcessContext &context) {
   binManager_.gatherReadyBins();
   if (gsl::narrow<uint32_t>(binManager_.getBinCount()) > maxBinCount_) {
@@ -287,6 +398,19 @@ void BinFiles::onTrigger(core::ProcessContext& context, core::ProcessSession& se
     return;
   }
 
+  if (persistence_ == bin_files::BinnedFlowFilePersistence::OnMerge) {
+    std::lock_guard<std::mutex> lock(held_session_mutex_);
+    const bool valid_batch = binNextBatch(*held_session_, [this](const std::shared_ptr<core::FlowFile>& flow) { held_flow_files_.emplace(flow->getUUID(), flow); });
+    auto ready_bins = gatherReadyBins(context);
+    if (ready_bins.empty() && !valid_batch) {
+      context.yield();
+    }
+    if (!ready_bins.empty() || held_session_->existsFlowFileInRelationship(Failure)) {
+      processReadyBinsInHeldSession(std::move(ready_bins));
+    }
+    return;
+  }
+
   const bool valid_batch = assumeOwnershipOfNextBatch(session);
   if (auto ready_bins = gatherReadyBins(context); ready_bins.empty()) {
     if (!valid_batch) {
@@ -16,10 +16,15 @@
  */
 #pragma once
 
+#include <array>
+#include <atomic>
 #include <cinttypes>
 #include <limits>
 #include <deque>
+#include <functional>
 #include <memory>
+#include <mutex>
+#include <unordered_map>
 #include <unordered_set>
 #include <string>
 #include <set>
@@ -37,6 +42,29 @@
 #include "utils/Id.h"
 #include "minifi-cpp/utils/Export.h"
 #include "core/FlowFileStore.h"
+#include "utils/Enum.h"
+
+namespace org::apache::nifi::minifi::processors::bin_files {
+enum class BinnedFlowFilePersistence {
+  OnBinning,
+  OnMerge
+};
+}  // namespace org::apache::nifi::minifi::processors::bin_files
+
+namespace magic_enum::customize {
+using BinnedFlowFilePersistence = org::apache::nifi::minifi::processors::bin_files::BinnedFlowFilePersistence;
+
+template <>
+constexpr customize_t enum_name<BinnedFlowFilePersistence>(BinnedFlowFilePersistence value) noexcept {
+  switch (value) {
+    case BinnedFlowFilePersistence::OnBinning:
+      return "On Binning";
+    case BinnedFlowFilePersistence::OnMerge:
+      return "On Merge";
+  }
+  return invalid_tag;
+}
+}  // namespace magic_enum::customize
 
 namespace org::apache::nifi::minifi::processors {
 
@@ -107,6 +135,15 @@ class Bin {
   [[nodiscard]] std::string getGroupId() const {
     return groupId_;
   }
+  void removeFlowFiles(const std::function<bool(const core::FlowFile&)>& predicate) {
+    std::erase_if(queue_, [&](const std::shared_ptr<core::FlowFile>& flow) {
+      if (!predicate(*flow)) {
+        return false;
+      }
+      queued_data_size_ -= flow->getSize();
+      return true;
+    });
+  }
 
  private:
   uint64_t minSize_;
@@ -150,8 +187,12 @@ class BinManager {
     fileCount_ = value;
   }
   void purge() {
-    std::lock_guard<std::mutex> lock(mutex_);
-    groupBinMap_.clear();
+    for (auto& shard : shards_) {
+      std::lock_guard<std::mutex> lock(shard.mutex);
+      shard.groupBinMap.clear();
+      shard.groupsWithReadyBins.clear();
+      shard.binsByCreationDate.clear();
+    }
     binCount_ = 0;
   }
   // Adds the given flowFile to the first available bin in which it fits for the given group or creates a new bin in the specified group if necessary.
@@ -162,8 +203,24 @@ class BinManager {
   void removeOldestBin();
   void getReadyBin(std::deque<std::unique_ptr<Bin>> &retBins);
   void addReadyBin(std::unique_ptr<Bin> ready_bin);
+  // removes the matching flow files from every bin, and drops the bins which become empty
+  void removeFlowFiles(const std::function<bool(const core::FlowFile&)>& predicate);
 
  private:
+  // The groups are partitioned among the shards by their hash, so offers to different groups rarely wait for each other,
+  // and gathering the ready bins only visits the groups which may have some, instead of every group.
+  struct Shard {
+    std::mutex mutex;
+    std::unordered_map<std::string, std::deque<std::unique_ptr<Bin>>> groupBinMap;
+    std::unordered_set<std::string> groupsWithReadyBins;
+    // every bin has the same max age, so this is also the order in which they expire
+    std::set<std::pair<std::chrono::system_clock::time_point, Bin*>> binsByCreationDate;
+  };
+  static constexpr size_t SHARD_COUNT = 16;
+
+  Shard& getShard(const std::string& group);
+  std::unique_ptr<Bin> takeFirstBin(Shard& shard, std::deque<std::unique_ptr<Bin>>& queue);
+
   std::mutex mutex_;
   uint64_t minSize_{0};
   uint64_t maxSize_{std::numeric_limits<decltype(maxSize_)>::max()};
@@ -171,9 +228,9 @@ class BinManager {
   uint32_t minEntries_{1};
   std::string fileCount_;
   std::chrono::milliseconds binAge_{std::chrono::milliseconds::max()};
-  std::map<std::string, std::unique_ptr<std::deque<std::unique_ptr<Bin>>> >groupBinMap_;
+  std::array<Shard, SHARD_COUNT> shards_;
   std::deque<std::unique_ptr<Bin>> readyBin_;
-  int binCount_{0};
+  std::atomic<int> binCount_{0};
   std::shared_ptr<core::logging::Logger> logger_{core::logging::LoggerFactory<BinManager>::getLogger()};
 };
 
@@ -219,6 +276,17 @@ class BinFiles : public core::ProcessorImpl {
       .withValidator(core::StandardPropertyValidators::UNSIGNED_INTEGER_VALIDATOR)
       .withDefaultValue("1")
       .build();
+  EXTENSIONAPI static constexpr auto FlowFilePersistence =
+      core::PropertyDefinitionBuilder<magic_enum::enum_count<bin_files::BinnedFlowFilePersistence>()>::createProperty("Binned FlowFile Persistence")
+      .withDescription("Specifies when the FlowFiles taken from the incoming connections are persisted to the FlowFile Repository.\n"
+          "On Binning: Every FlowFile is persisted as owned by this processor when it is added to a bin, and once more when its bin is merged.\n"
+          "On Merge: The FlowFiles are held in an uncommitted session, so a FlowFile is only persisted once, when its bin is merged. "
+          "The FlowFiles which are still in open bins when other bins are merged are persisted as owned by this processor, like with On Binning. "
+          "After a restart the FlowFiles which were not persisted as owned by this processor are taken from their incoming connection again.")
+      .isRequired(true)
+      .withDefaultValue(magic_enum::enum_name(bin_files::BinnedFlowFilePersistence::OnBinning))
+      .withAllowedValues(magic_enum::enum_names<bin_files::BinnedFlowFilePersistence>())
+      .build();
   EXTENSIONAPI static constexpr auto Properties = std::to_array<core::PropertyReference>({
       MinSize,
       MaxSize,
@@ -226,7 +294,8 @@ class BinFiles : public core::ProcessorImpl {
       MaxEntries,
       MaxBinCount,
       MaxBinAge,
-      BatchSize
+      BatchSize,
+      FlowFilePersistence
   });
 
 
@@ -278,8 +347,13 @@ class BinFiles : public core::ProcessorImpl {
   // Sort flow files retrieved from the flow file repository after restart to their respective bins
   bool resurrectFlowFiles(core::ProcessSession &session);
   bool assumeOwnershipOfNextBatch(core::ProcessSession &session);
+  // Offers the next batch of flow files to the bins and passes the successfully binned ones to on_binned, the others are transferred to Failure
+  bool binNextBatch(core::ProcessSession &session, const std::function<void(const std::shared_ptr<core::FlowFile>&)>& on_binned);
   std::deque<std::unique_ptr<Bin>> gatherReadyBins(core::ProcessContext &context);
   void processReadyBins(std::deque<std::unique_ptr<Bin>> ready_bins, core::ProcessSession &session);
+  // Merges the ready bins in the held session, and commits it together with the flow files which are still binned
+  void processReadyBinsInHeldSession(std::deque<std::unique_ptr<Bin>> ready_bins);
+  void rollbackHeldSession(std::deque<std::unique_ptr<Bin>>& ready_bins);
 
   BinManager binManager_;
 
@@ -287,6 +361,14 @@ class BinFiles : public core::ProcessorImpl {
   uint32_t batchSize_{1};
   uint32_t maxBinCount_{100};
   core::FlowFileStore file_store_;
+  bin_files::BinnedFlowFilePersistence persistence_{bin_files::BinnedFlowFilePersistence::OnBinning};
+  // With On Merge persistence the flow files are taken from the incoming connections by this long-lived session,
+  // which is only committed when some bins are merged, so they are not persisted as owned by this processor in the meantime.
+  // The concurrent triggers share the held session, so they run one at a time with this persistence.
+  std::mutex held_session_mutex_;
+  std::shared_ptr<core::ProcessSession> held_session_;
+  // the binned flow files which were taken by the held session since its last commit
+  std::unordered_map<utils::Identifier, std::shared_ptr<core::FlowFile>> held_flow_files_;
 };
 
 }  // namespace org::apache::nifi::minifi::processors
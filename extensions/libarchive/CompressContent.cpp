@@ -38,14 +38,18 @@ const std::map<std::string, io::CompressionFormat> CompressContent::compressionF
   {"application/bzip2", io::CompressionFormat::BZIP2},
   {"application/x-bzip2", io::CompressionFormat::BZIP2},
   {"application/x-lzma", io::CompressionFormat::LZMA},
-  {"application/x-xz", io::CompressionFormat::XZ_LZMA2}
+  {"application/x-xz", io::CompressionFormat::XZ_LZMA2},
+  {"application/zstd", io::CompressionFormat::ZSTD},
+  {"application/x-lz4", io::CompressionFormat::LZ4}
 };
 
 const std::map<io::CompressionFormat, std::string> CompressContent::fileExtension_{
   {io::CompressionFormat::GZIP, ".gz"},
   {io::CompressionFormat::LZMA, ".lzma"},
   {io::CompressionFormat::BZIP2, ".bz2"},
-  {io::CompressionFormat::XZ_LZMA2, ".xz"}
+  {io::CompressionFormat::XZ_LZMA2, ".xz"},
+  {io::CompressionFormat::ZSTD, ".zst"},
+  {io::CompressionFormat::LZ4, ".lz4"}
 };
 
 void CompressContent::initialize() {
@@ -60,9 +64,12 @@ void CompressContent::onSchedule(core::ProcessContext& context, core::ProcessSes
   updateFileName_ = utils::parseBoolProperty(context, UpdateFileName);
   encapsulateInTar_ = utils::parseBoolProperty(context, EncapsulateInTar);
   batchSize_ = utils::parseU64Property(context, BatchSize);
+  compressionThreadCount_ = utils::parseU64Property(context, CompressionThreadCount);
+  compressionBlockSize_ = utils::parseDataSizeProperty(context, CompressionBlockSize);
 
-  logger_->log_info("Compress Content: Mode [{}] Format [{}] Level [{}] UpdateFileName [{}] EncapsulateInTar [{}]",
-      magic_enum::enum_name(compressMode_), magic_enum::enum_name(compressFormat_), compressLevel_, updateFileName_, encapsulateInTar_);
+  logger_->log_info("Compress Content: Mode [{}] Format [{}] Level [{}] UpdateFileName [{}] EncapsulateInTar [{}] ThreadCount [{}] BlockSize [{}]",
+      magic_enum::enum_name(compressMode_), magic_enum::enum_name(compressFormat_), compressLevel_, updateFileName_, encapsulateInTar_,
+      compressionThreadCount_, compressionBlockSize_);
 }
 
 void CompressContent::onTrigger(core::ProcessContext& context, core::ProcessSession& session) {
@@ -107,8 +114,8 @@ void CompressContent::processFlowFile(const std::shared_ptr<core::FlowFile>& flo
   std::string mimeType = toMimeType(compressFormat);
 
   // Validate
-  if (!encapsulateInTar_ && compressFormat != io::CompressionFormat::GZIP) {
-    logger_->log_error("non-TAR encapsulated format only supports GZIP compression");
+  if (!encapsulateInTar_ && compressFormat != io::CompressionFormat::GZIP && compressFormat != io::CompressionFormat::ZSTD && compressFormat != io::CompressionFormat::LZ4) {
+    logger_->log_error("non-TAR encapsulated format only supports gzip, zstd and lz4 compression");
     session.transfer(flowFile, Failure);
     return;
   }
@@ -122,6 +129,16 @@ void CompressContent::processFlowFile(const std::shared_ptr<core::FlowFile>& flo
     session.transfer(flowFile, Failure);
     return;
   }
+  if (encapsulateInTar_ && compressFormat == io::CompressionFormat::ZSTD && archive_zstd_version() == nullptr) {
+    logger_->log_error("{} compression format is requested, but the agent was compiled without TAR encapsulated zstd support", magic_enum::enum_name(compressFormat));
+    session.transfer(flowFile, Failure);
+    return;
+  }
+  if (encapsulateInTar_ && compressFormat == io::CompressionFormat::LZ4 && archive_liblz4_version() == nullptr) {
+    logger_->log_error("{} compression format is requested, but the agent was compiled without TAR encapsulated lz4 support", magic_enum::enum_name(compressFormat));
+    session.transfer(flowFile, Failure);
+    return;
+  }
 
   std::string fileExtension;
   auto search = fileExtension_.find(compressFormat);
@@ -163,10 +180,24 @@ void CompressContent::processFlowFile(const std::shared_ptr<core::FlowFile>& flo
         return transformer(in, out);
       }));
     });
-  } else {
+  } else if (compressFormat == io::CompressionFormat::GZIP && (compressMode_ == compress_content::CompressionMode::decompress || compressionThreadCount_ <= 1)) {
     CompressContent::GzipWriteCallback callback(compressMode_, compressLevel_, flowFile, session);
     session.write(result, std::ref(callback));
     success = callback.success_;
+  } else {
+    // zstd and lz4, and gzip compressed by more than one thread, are compressed in independent blocks, which are concatenated members or frames
+    session.write(result, [&] (const auto& out) {
+      return io::IoResult::from(session.read(flowFile, [&] (const auto& in) -> io::IoResult {
+        auto ret = compressMode_ == compress_content::CompressionMode::compress
+            ? io::compressInBlocks(*in, *out, compressFormat, compressLevel_, compressionBlockSize_, compressionThreadCount_)
+            : io::decompressFrames(*in, *out, compressFormat);
+        if (!ret) {
+          success = false;
+          return io::IoResult::zero();  // prevents a session rollback
+        }
+        return ret;
+      }));
+    });
   }
 
   if (!success) {
@@ -208,6 +239,8 @@ std::string CompressContent::toMimeType(io::CompressionFormat format) {
     case io::CompressionFormat::BZIP2: return "application/bzip2";
     case io::CompressionFormat::LZMA: return "application/x-lzma";
     case io::CompressionFormat::XZ_LZMA2: return "application/x-xz";
+    case io::CompressionFormat::ZSTD: return "application/zstd";
+    case io::CompressionFormat::LZ4: return "application/x-lz4";
   }
   throw Exception(GENERAL_EXCEPTION, "Invalid compression format");
 }
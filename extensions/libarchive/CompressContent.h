@@ -43,6 +43,7 @@
 #include "minifi-cpp/utils/Export.h"
 #include "WriteArchiveStream.h"
 #include "ReadArchiveStream.h"
+#include "ContentCompression.h"
 
 namespace org::apache::nifi::minifi::processors::compress_content {
 enum class CompressionMode {
@@ -55,6 +56,8 @@ enum class ExtendedCompressionFormat {
   LZMA,
   XZ_LZMA2,
   BZIP2,
+  ZSTD,
+  LZ4,
   USE_MIME_TYPE
 };
 
@@ -74,6 +77,10 @@ constexpr customize_t enum_name<ExtendedCompressionFormat>(ExtendedCompressionFo
       return "xz-lzma2";
     case ExtendedCompressionFormat::BZIP2:
       return "bzip2";
+    case ExtendedCompressionFormat::ZSTD:
+      return "zstd";
+    case ExtendedCompressionFormat::LZ4:
+      return "lz4";
     case ExtendedCompressionFormat::USE_MIME_TYPE:
       return "use mime.type attribute";
   }
@@ -98,7 +105,8 @@ class CompressContent : public core::ProcessorImpl {
       .withAllowedValues(magic_enum::enum_names<compress_content::CompressionMode>())
       .build();
   EXTENSIONAPI static constexpr auto CompressLevel = core::PropertyDefinitionBuilder<>::createProperty("Compression Level")
-      .withDescription("The compression level to use; this is valid only when using GZIP compression.")
+      .withDescription("The compression level to use; this is valid only when using gzip (0-9), zstd (1-22) or lz4 (1-12) compression. "
+          "When Encapsulate in TAR is true, the lz4 levels above 9 are reduced to 9.")
       .isRequired(true)
       .withValidator(core::StandardPropertyValidators::INTEGER_VALIDATOR)
       .withDefaultValue("1")
@@ -129,13 +137,31 @@ class CompressContent : public core::ProcessorImpl {
       .withValidator(core::StandardPropertyValidators::UNSIGNED_INTEGER_VALIDATOR)
       .withDefaultValue("1")
       .build();
+  EXTENSIONAPI static constexpr auto CompressionThreadCount = core::PropertyDefinitionBuilder<>::createProperty("Compression Thread Count")
+      .withDescription("The number of threads compressing the content of a FlowFile. If more than 1, the content is split into blocks of Compression Block Size, "
+          "which are compressed independently and in parallel, and written as a multi-member gzip or a multi-frame zstd or lz4 stream, "
+          "which can be decompressed by any decompressor of the format. Used only on compression when Encapsulate in TAR is false.")
+      .isRequired(true)
+      .withValidator(core::StandardPropertyValidators::UNSIGNED_INTEGER_VALIDATOR)
+      .withDefaultValue("1")
+      .build();
+  EXTENSIONAPI static constexpr auto CompressionBlockSize = core::PropertyDefinitionBuilder<>::createProperty("Compression Block Size")
+      .withDescription("The size of the blocks the content is split into when it is compressed by more than one thread. "
+          "zstd and lz4 content is always compressed in blocks of this size, when Encapsulate in TAR is false. "
+          "Larger blocks compress better, and each thread holds up to two blocks in memory.")
+      .isRequired(true)
+      .withValidator(core::StandardPropertyValidators::DATA_SIZE_VALIDATOR)
+      .withDefaultValue("1 MB")
+      .build();
   EXTENSIONAPI static constexpr auto Properties = std::to_array<core::PropertyReference>({
       CompressMode,
       CompressLevel,
       CompressFormat,
       UpdateFileName,
       EncapsulateInTar,
-      BatchSize
+      BatchSize,
+      CompressionThreadCount,
+      CompressionBlockSize
   });
 
 
@@ -218,6 +244,8 @@ class CompressContent : public core::ProcessorImpl {
   bool updateFileName_ = false;
   bool encapsulateInTar_ = false;
   uint64_t batchSize_{1};
+  uint64_t compressionThreadCount_{1};
+  uint64_t compressionBlockSize_{};
   static const std::map<std::string, io::CompressionFormat> compressionFormatMimeTypeMap_;
   static const std::map<io::CompressionFormat, std::string> fileExtension_;
 };
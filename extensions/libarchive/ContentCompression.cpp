@@ -0,0 +1,261 @@
+/**
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The ASF licenses this file to You under the Apache License, Version 2.0
+ * (the "License"); you may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "ContentCompression.h"
+
+#include <zlib.h>
+#include <zstd.h>
+#include <lz4frame.h>
+
+#include <algorithm>
+#include <memory>
+#include <optional>
+#include <utility>
+#include <vector>
+
+#include "minifi-cpp/utils/gsl.h"
+#include "utils/OrderedTaskPool.h"
+
+namespace org::apache::nifi::minifi::io {
+
+namespace {
+
+constexpr size_t DECOMPRESSION_BUFFER_SIZE = 64 * 1024;
+
+std::optional<std::vector<std::byte>> compressGzipMember(int compression_level, std::span<const std::byte> block) {
+  z_stream strm{};
+  // window bits 15 + 16 writes a gzip header and trailer around the deflate stream
+  if (deflateInit2(&strm, compression_level, Z_DEFLATED, 15 + 16, 8, Z_DEFAULT_STRATEGY) != Z_OK) {
+    return std::nullopt;
+  }
+  const auto deflate_end = gsl::finally([&strm] { deflateEnd(&strm); });
+  std::vector<std::byte> compressed(deflateBound(&strm, gsl::narrow<uLong>(block.size())));
+  strm.next_in = reinterpret_cast<Bytef*>(const_cast<std::byte*>(block.data()));
+  strm.avail_in = gsl::narrow<uInt>(block.size());
+  strm.next_out = reinterpret_cast<Bytef*>(compressed.data());
+  strm.avail_out = gsl::narrow<uInt>(compressed.size());
+  if (deflate(&strm, Z_FINISH) != Z_STREAM_END) {
+    return std::nullopt;
+  }
+  compressed.resize(strm.total_out);
+  return compressed;
+}
+
+std::optional<std::vector<std::byte>> compressZstdFrame(int compression_level, std::span<const std::byte> block) {
+  std::vector<std::byte> compressed(ZSTD_compressBound(block.size()));
+  const size_t compressed_size = ZSTD_compress(compressed.data(), compressed.size(), block.data(), block.size(), compression_level);
+  if (ZSTD_isError(compressed_size)) {
+    return std::nullopt;
+  }
+  compressed.resize(compressed_size);
+  return compressed;
+}
+
+std::optional<std::vector<std::byte>> compressLz4Frame(int compression_level, std::span<const std::byte> block) {
+  LZ4F_preferences_t preferences{};
+  preferences.compressionLevel = compression_level;
+  preferences.frameInfo.contentSize = block.size();
+  std::vector<std::byte> compressed(LZ4F_compressFrameBound(block.size(), &preferences));
+  const size_t compressed_size = LZ4F_compressFrame(compressed.data(), compressed.size(), block.data(), block.size(), &preferences);
+  if (LZ4F_isError(compressed_size)) {
+    return std::nullopt;
+  }
+  compressed.resize(compressed_size);
+  return compressed;
+}
+
+// reads until the block is full or the input ends, returns the number of bytes read
+std::optional<size_t> readBlock(InputStream& input, std::span<std::byte> block) {
+  size_t block_size = 0;
+  while (block_size < block.size()) {
+    const auto ret = input.read(block.subspan(block_size));
+    if (isError(ret)) {
+      return std::nullopt;
+    }
+    if (ret == 0) {
+      break;
+    }
+    block_size += ret;
+  }
+  return block_size;
+}
+
+bool writeAll(OutputStream& output, std::span<const std::byte> data) {
+  const auto ret = output.write(data);
+  return !isError(ret) && ret == data.size();
+}
+
+IoResult decompressZstdFrames(InputStream& input, OutputStream& output) {
+  const std::unique_ptr<ZSTD_DCtx, decltype(&ZSTD_freeDCtx)> context{ZSTD_createDCtx(), &ZSTD_freeDCtx};
+  if (!context) {
+    return IoResult::error();
+  }
+  std::vector<std::byte> input_buffer(ZSTD_DStreamInSize());
+  std::vector<std::byte> output_buffer(ZSTD_DStreamOutSize());
+  uint64_t total_read = 0;
+  bool frame_finished = false;
+  while (true) {
+    const auto read_size = input.read(input_buffer);
+    if (isError(read_size)) {
+      return IoResult::error();
+    }
+    if (read_size == 0) {
+      break;
+    }
+    total_read += read_size;
+    ZSTD_inBuffer in{input_buffer.data(), read_size, 0};
+    bool output_full = false;
+    while (in.pos < in.size || output_full) {
+      ZSTD_outBuffer out{output_buffer.data(), output_buffer.size(), 0};
+      const size_t ret = ZSTD_decompressStream(context.get(), &out, &in);
+      if (ZSTD_isError(ret) || !writeAll(output, std::span(output_buffer).subspan(0, out.pos))) {
+        return IoResult::error();
+      }
+      // 0 is returned when a frame is completely decoded and flushed, the next input byte starts a new frame
+      frame_finished = ret == 0;
+      output_full = !frame_finished && out.pos == out.size;
+    }
+  }
+  if (!frame_finished) {
+    return IoResult::error();
+  }
+  return IoResult::from(total_read);
+}
+
+IoResult decompressLz4Frames(InputStream& input, OutputStream& output) {
+  LZ4F_dctx* raw_context = nullptr;
+  if (LZ4F_isError(LZ4F_createDecompressionContext(&raw_context, LZ4F_VERSION))) {
+    return IoResult::error();
+  }
+  const std::unique_ptr<LZ4F_dctx, decltype(&LZ4F_freeDecompressionContext)> context{raw_context, &LZ4F_freeDecompressionContext};
+  std::vector<std::byte> input_buffer(DECOMPRESSION_BUFFER_SIZE);
+  std::vector<std::byte> output_buffer(DECOMPRESSION_BUFFER_SIZE);
+  uint64_t total_read = 0;
+  bool frame_finished = false;
+  while (true) {
+    const auto read_size = input.read(input_buffer);
+    if (isError(read_size)) {
+      return IoResult::error();
+    }
+    if (read_size == 0) {
+      break;
+    }
+    total_read += read_size;
+    size_t input_offset = 0;
+    bool output_full = false;
+    while (input_offset < read_size || output_full) {
+      size_t consumed_size = read_size - input_offset;
+      size_t decompressed_size = output_buffer.size();
+      const size_t ret = LZ4F_decompress(context.get(), output_buffer.data(), &decompressed_size, input_buffer.data() + input_offset, &consumed_size, nullptr);
+      if (LZ4F_isError(ret) || !writeAll(output, std::span(output_buffer).subspan(0, decompressed_size))) {
+        return IoResult::error();
+      }
+      input_offset += consumed_size;
+      // 0 is returned when a frame is completely decoded, after which the context starts decoding a new frame
+      frame_finished = ret == 0;
+      output_full = !frame_finished && decompressed_size == output_buffer.size();
+    }
+  }
+  if (!frame_finished) {
+    return IoResult::error();
+  }
+  return IoResult::from(total_read);
+}
+
+}  // namespace
+
+std::optional<std::vector<std::byte>> compressBlock(CompressionFormat format, int compression_level, std::span<const std::byte> block) {
+  switch (format) {
+    case CompressionFormat::GZIP: return compressGzipMember(compression_level, block);
+    case CompressionFormat::ZSTD: return compressZstdFrame(compression_level, block);
+    case CompressionFormat::LZ4: return compressLz4Frame(compression_level, block);
+    case CompressionFormat::LZMA:
+    case CompressionFormat::XZ_LZMA2:
+    case CompressionFormat::BZIP2:
+      break;
+  }
+  return std::nullopt;
+}
+
+IoResult compressInBlocks(InputStream& input, OutputStream& output, CompressionFormat format, int compression_level, size_t block_size, size_t thread_count) {
+  block_size = std::max<size_t>(block_size, 1);
+  thread_count = std::max<size_t>(thread_count, 1);
+  std::optional<utils::OrderedTaskPool<std::optional<std::vector<std::byte>>>> compressor_pool;
+  if (thread_count > 1) {
+    compressor_pool.emplace(thread_count);
+  }
+  const auto write_next_block = [&] {
+    const auto compressed = compressor_pool->takeNext();
+    return compressed && writeAll(output, *compressed);
+  };
+
+  uint64_t total_read = 0;
+  while (true) {
+    std::vector<std::byte> block(block_size);
+    const auto read_size = readBlock(input, block);
+    if (!read_size) {
+      return IoResult::error();
+    }
+    // an empty input is compressed to a single empty member or frame, so that it can be decompressed
+    if (*read_size == 0 && total_read > 0) {
+      break;
+    }
+    total_read += *read_size;
+    block.resize(*read_size);
+    const bool last_block = *read_size < block_size;
+
+    if (!compressor_pool) {
+      const auto compressed = compressBlock(format, compression_level, block);
+      if (!compressed || !writeAll(output, *compressed)) {
+        return IoResult::error();
+      }
+    } else {
+      // at most thread_count blocks are compressed or waiting to be written, which bounds the memory used
+      if (compressor_pool->size() == thread_count && !write_next_block()) {
+        return IoResult::error();
+      }
+      compressor_pool->add([format, compression_level, block = std::move(block)] {
+        return compressBlock(format, compression_level, block);
+      });
+    }
+    if (last_block) {
+      break;
+    }
+  }
+  while (compressor_pool && compressor_pool->size() > 0) {
+    if (!write_next_block()) {
+      return IoResult::error();
+    }
+  }
+  return IoResult::from(total_read);
+}
+
+IoResult decompressFrames(InputStream& input, OutputStream& output, CompressionFormat format) {
+  switch (format) {
+    case CompressionFormat::ZSTD: return decompressZstdFrames(input, output);
+    case CompressionFormat::LZ4: return decompressLz4Frames(input, output);
+    case CompressionFormat::GZIP:
+    case CompressionFormat::LZMA:
+    case CompressionFormat::XZ_LZMA2:
+    case CompressionFormat::BZIP2:
+      break;
+  }
+  return IoResult::error();
+}
+
+}  // namespace org::apache::nifi::minifi::io
@@ -0,0 +1,54 @@
+/**
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The ASF licenses this file to You under the Apache License, Version 2.0
+ * (the "License"); you may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <optional>
+#include <span>
+#include <vector>
+
+#include "minifi-cpp/io/InputStream.h"
+#include "minifi-cpp/io/OutputStream.h"
+#include "minifi-cpp/io/StreamCallback.h"
+#include "WriteArchiveStream.h"
+
+namespace org::apache::nifi::minifi::io {
+
+/**
+ * Compresses a block into a self-contained gzip member, zstd frame or lz4 frame.
+ * These formats allow concatenating members or frames, so the compressed blocks written one after the other are a valid compressed stream.
+ * Returns std::nullopt for the formats not supporting this, and on compression errors.
+ */
+std::optional<std::vector<std::byte>> compressBlock(CompressionFormat format, int compression_level, std::span<const std::byte> block);
+
+/**
+ * Splits the input into blocks of block_size bytes, compresses them independently on up to thread_count threads, and writes the
+ * compressed blocks to the output in the order of the input.
+ * At most thread_count blocks are compressed or waiting to be written at any time, which bounds the memory used.
+ * Returns the number of bytes read from the input.
+ */
+IoResult compressInBlocks(InputStream& input, OutputStream& output, CompressionFormat format, int compression_level, size_t block_size, size_t thread_count);
+
+/**
+ * Decompresses a zstd or lz4 stream consisting of one or more frames.
+ * Returns an error if the input is not in the format, or it ends in the middle of a frame.
+ */
+IoResult decompressFrames(InputStream& input, OutputStream& output, CompressionFormat format);
+
+}  // namespace org::apache::nifi::minifi::io
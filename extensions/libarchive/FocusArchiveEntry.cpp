@@ -25,9 +25,10 @@
 #include <cstring>
 
 #include <array>
-#include <string>
-
 #include <memory>
+#include <span>
+#include <string>
+#include <utility>
 
 #include "minifi-cpp/core/ProcessContext.h"
 #include "core/ProcessSession.h"
@@ -45,6 +46,105 @@ namespace org::apache::nifi::minifi::processors {
 
 std::shared_ptr<utils::IdGenerator> FocusArchiveEntry::id_generator_ = utils::IdGenerator::getIdGenerator();
 
+struct FocusArchiveEntryReadData {
+  std::shared_ptr<io::InputStream> stream;
+  core::ProcessContext* context = nullptr;
+  std::array<std::byte, BUFFER_SIZE> buf{};
+};
+
+namespace {
+
+ArchiveEntryMetadata readEntryMetadata(struct archive_entry* entry) {
+  ArchiveEntryMetadata metadata;
+  metadata.entryName = archive_entry_pathname(entry);
+  metadata.entryType = archive_entry_filetype(entry);
+  metadata.entryPerm = archive_entry_perm(entry);
+  metadata.entrySize = archive_entry_size(entry);
+  metadata.entryUID = archive_entry_uid(entry);
+  metadata.entryGID = archive_entry_gid(entry);
+  metadata.entryMTime = archive_entry_mtime(entry);
+  metadata.entryMTimeNsec = archive_entry_mtime_nsec(entry);
+  return metadata;
+}
+
+io::IoResult writeEntryData(struct archive* input_archive, io::OutputStream& output) {
+  std::array<std::byte, BUFFER_SIZE> buffer{};
+  size_t total_written = 0;
+  while (true) {
+    const la_ssize_t read_size = archive_read_data(input_archive, buffer.data(), buffer.size());
+    if (read_size < 0) {
+      return io::IoResult::error();
+    }
+    if (read_size == 0) {
+      break;
+    }
+    const auto data = std::span(buffer).subspan(0, gsl::narrow<size_t>(read_size));
+    const auto write_ret = output.write(data);
+    if (io::isError(write_ret) || write_ret != data.size()) {
+      return io::IoResult::error();
+    }
+    total_written += write_ret;
+  }
+  return io::IoResult::from(total_written);
+}
+
+}  // namespace
+
+std::string FocusArchiveEntry::extractEntries(core::ProcessContext& context, core::ProcessSession& session, const std::shared_ptr<core::FlowFile>& flow_file,
+    ArchiveMetadata& archive_metadata) {
+  // the archive is read from its claim while the extracted entries replace the content of the flow file, so the claim is kept until the end
+  const auto archive_claim = flow_file->getResourceClaim();
+  FocusArchiveEntryReadData data;
+  data.stream = session.getFlowFileContentStream(*flow_file);
+  data.context = &context;
+  if (!data.stream) {
+    logger_->log_error("FocusArchiveEntry can't open archive, the flow file has no content");
+    return {};
+  }
+
+  auto input_archive = processors::archive_read_unique_ptr{archive_read_new()};
+  archive_read_support_format_all(input_archive.get());
+  archive_read_support_filter_all(input_archive.get());
+  if (archive_read_open(input_archive.get(), &data, ok_cb, read_cb, ok_cb)) {
+    logger_->log_error("FocusArchiveEntry can't open due to archive error: {}", archive_error_string(input_archive.get()));
+    return {};
+  }
+
+  std::string target_entry_stash_key;
+  struct archive_entry* entry = nullptr;
+  while (context.isRunning()) {
+    const auto res = archive_read_next_header(input_archive.get(), &entry);
+    if (res == ARCHIVE_EOF) {
+      break;
+    }
+    if (res < ARCHIVE_OK) {  // TODO(MINIFICPP-2761)
+      logger_->log_error("FocusArchiveEntry can't read header due to archive error: {}", archive_error_string(input_archive.get()));
+      break;
+    }
+
+    archive_metadata.archiveFormatName.assign(archive_format_name(input_archive.get()));
+    archive_metadata.archiveFormat = archive_format(input_archive.get());
+    auto metadata = readEntryMetadata(entry);
+    logger_->log_info("FocusArchiveEntry entry type of {} is: {}", metadata.entryName, metadata.entryType);
+    logger_->log_info("FocusArchiveEntry entry perm of {} is: {}", metadata.entryName, metadata.entryPerm);
+
+    if (metadata.entryType == AE_IFREG) {
+      logger_->log_info("FocusArchiveEntry extracting {}", metadata.entryName);
+      session.write(flow_file, [&input_archive](const std::shared_ptr<io::OutputStream>& output) {
+        return writeEntryData(input_archive.get(), *output);
+      });
+      metadata.stashKey = id_generator_->generate().to_string();
+      logger_->log_debug("FocusArchiveEntry generated stash key {} for entry {}", metadata.stashKey, metadata.entryName);
+      if (metadata.entryName == archive_metadata.focusedEntry) {
+        target_entry_stash_key = metadata.stashKey;
+      }
+      session.stash(metadata.stashKey, flow_file);
+    }
+    archive_metadata.entryMetadata.push_back(std::move(metadata));
+  }
+  return target_entry_stash_key;
+}
+
 void FocusArchiveEntry::initialize() {
   setSupportedProperties(Properties);
   setSupportedRelationships(Relationships);
@@ -57,34 +157,12 @@ void FocusArchiveEntry::onTrigger(core::ProcessContext& context, core::ProcessSe
     return;
   }
 
-  utils::file::FileManager file_man;
-
   // Extract archive contents
   ArchiveMetadata archiveMetadata;
   archiveMetadata.focusedEntry = context.getProperty(Path).value_or("");
   flowFile->getAttribute("filename", archiveMetadata.archiveName);
 
-  session.read(flowFile, ReadCallback{&context, &file_man, &archiveMetadata});
-
-  // For each extracted entry, import & stash to key
-  std::string targetEntryStashKey;
-
-  for (auto &entryMetadata : archiveMetadata.entryMetadata) {
-    if (entryMetadata.entryType == AE_IFREG) {
-      logger_->log_info("FocusArchiveEntry importing {} from {}", entryMetadata.entryName, entryMetadata.tmpFileName);
-      session.import(entryMetadata.tmpFileName.string(), flowFile, false, 0);
-      utils::Identifier stashKeyUuid = id_generator_->generate();
-      logger_->log_debug("FocusArchiveEntry generated stash key {} for entry {}", stashKeyUuid.to_string(), entryMetadata.entryName);
-      entryMetadata.stashKey = stashKeyUuid.to_string();
-
-      if (entryMetadata.entryName == archiveMetadata.focusedEntry) {
-        targetEntryStashKey = entryMetadata.stashKey;
-      }
-
-      // Stash the content
-      session.stash(entryMetadata.stashKey, flowFile);
-    }
-  }
+  const std::string targetEntryStashKey = extractEntries(context, session, flowFile, archiveMetadata);
 
   // Restore target archive entry
   if (!targetEntryStashKey.empty()) {
@@ -128,14 +206,8 @@ void FocusArchiveEntry::onTrigger(core::ProcessContext& context, core::ProcessSe
   session.transfer(flowFile, Success);
 }
 
-struct FocusArchiveEntryReadData {
-  std::shared_ptr<io::InputStream> stream;
-  core::ProcessContext* context = nullptr;
-  std::array<std::byte, BUFFER_SIZE> buf{};
-};
-
 // Read callback which reads from the flowfile stream
-la_ssize_t FocusArchiveEntry::ReadCallback::read_cb(struct archive * a, void *d, const void **buf) {
+la_ssize_t FocusArchiveEntry::read_cb(struct archive * a, void *d, const void **buf) {
   auto data = static_cast<FocusArchiveEntryReadData *>(d);
   *buf = data->buf.data();
   size_t read = 0;
@@ -73,11 +73,15 @@ class FocusArchiveEntry : public core::ProcessorImpl {
     core::ProcessContext* const context_;
     std::shared_ptr<core::logging::Logger> logger_ = core::logging::LoggerFactory<FocusArchiveEntry>::getLogger();
     ArchiveMetadata *_archiveMetadata;
-    static int ok_cb(struct archive *, void* /*d*/) { return ARCHIVE_OK; }
-    static la_ssize_t read_cb(struct archive * a, void *d, const void **buf);
   };
 
  private:
+  // extracts each regular file entry into a new content claim of the flow file and stashes it, returns the stash key of the focused entry
+  std::string extractEntries(core::ProcessContext& context, core::ProcessSession& session, const std::shared_ptr<core::FlowFile>& flow_file, ArchiveMetadata& archive_metadata);
+
+  static int ok_cb(struct archive *, void* /*d*/) { return ARCHIVE_OK; }
+  static la_ssize_t read_cb(struct archive * a, void *d, const void **buf);
+
   static std::shared_ptr<utils::IdGenerator> id_generator_;
 };
 
@@ -16,7 +16,10 @@
  */
 #include "MergeContent.h"
 
+#include <zlib.h>
+
 #include <algorithm>
+#include <chrono>
 #include <cstdio>
 #include <deque>
 #include <map>
@@ -28,6 +31,8 @@
 #include "minifi-cpp/core/ProcessContext.h"
 #include "core/ProcessSession.h"
 #include "core/Resource.h"
+#include "io/BufferStream.h"
+#include "ParallelZipWriter.h"
 #include "serialization/FlowFileV3Serializer.h"
 #include "serialization/PayloadSerializer.h"
 #include "utils/ProcessorConfigUtils.h"
@@ -64,6 +69,7 @@ void MergeContent::onSchedule(core::ProcessContext& context, core::ProcessSessio
   demarcator_ = context.getProperty(Demarcator).value_or("");
   keepPath_ = utils::parseBoolProperty(context, KeepPath);
   attributeStrategy_ = context.getProperty(AttributeStrategy).value_or("");
+  compressionThreadCount_ = utils::parseU64Property(context, CompressionThreadCount);
 
   validatePropertyOptions();
 
@@ -250,7 +256,7 @@ bool MergeContent::processBin(core::ProcessSession &session, std::unique_ptr<Bin
     mergeBin = std::make_unique<TarMerge>();
     mimeType = "application/tar";
   } else if (mergeFormat_ == merge_content_options::MERGE_FORMAT_ZIP_VALUE) {
-    mergeBin = std::make_unique<ZipMerge>();
+    mergeBin = std::make_unique<ZipMerge>(gsl::narrow<size_t>(compressionThreadCount_));
     mimeType = "application/zip";
   } else {
     logger_->log_error("Merge format not supported {}", mergeFormat_);
@@ -316,7 +322,11 @@ void TarMerge::merge(core::ProcessSession &session,
 
 void ZipMerge::merge(core::ProcessSession &session,
     std::deque<std::shared_ptr<core::FlowFile>> &flows, FlowFileSerializer& serializer, const std::shared_ptr<core::FlowFile>& merge_flow) {
-  session.write(merge_flow, ArchiveMerge::WriteCallback{merge_content_options::MERGE_FORMAT_ZIP_VALUE, flows, serializer});
+  if (thread_count_ > 1) {
+    session.write(merge_flow, ParallelZipWriteCallback{flows, serializer, thread_count_});
+  } else {
+    session.write(merge_flow, ArchiveMerge::WriteCallback{merge_content_options::MERGE_FORMAT_ZIP_VALUE, flows, serializer});
+  }
   std::string fileName;
   merge_flow->getAttribute(core::SpecialFlowAttribute::FILENAME, fileName);
   if (flows.size() == 1) {
@@ -330,6 +340,33 @@ void ZipMerge::merge(core::ProcessSession &session,
   }
 }
 
+io::IoResult ParallelZipWriteCallback::operator()(const std::shared_ptr<io::OutputStream>& stream) const {
+  io::ParallelZipWriter zip_writer(*stream, Z_DEFAULT_COMPRESSION, thread_count_);
+  const auto modification_time = std::chrono::system_clock::now();
+  for (const auto& flow : flows_) {
+    std::string file_name;
+    flow->getAttribute(core::SpecialFlowAttribute::FILENAME, file_name);
+    if (flow->getSize() > io::ParallelZipWriter::MAX_BUFFERED_ENTRY_SIZE) {
+      // large FlowFiles are not read into memory, but deflated into the archive on the processor's thread
+      const auto write_content = [this, &flow](const std::shared_ptr<io::OutputStream>& entry_stream) { return serializer_.serialize(flow, entry_stream); };
+      if (!zip_writer.addStreamedEntry(std::move(file_name), S_IFREG | 0755, modification_time, write_content)) {
+        return io::IoResult::error();
+      }
+      continue;
+    }
+    // the content is read on the processor's thread, as the session is not thread safe, and only compressed on the worker threads
+    const auto content = std::make_shared<io::BufferStream>();
+    const auto ret = serializer_.serialize(flow, content);
+    if (!ret) {
+      return ret;
+    }
+    if (!zip_writer.addEntry(std::move(file_name), content->moveBuffer(), S_IFREG | 0755, modification_time)) {
+      return io::IoResult::error();
+    }
+  }
+  return zip_writer.finish();
+}
+
 void AttributeMerger::mergeAttributes(core::ProcessSession &session, core::FlowFile& merge_flow) {
   for (const auto& pair : getMergedAttributes()) {
     session.putAttribute(merge_flow, pair.first, pair.second);
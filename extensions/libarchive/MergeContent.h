@@ -238,6 +238,23 @@ class ArchiveMerge {
   };
 };
 
+// Writes the ZIP archive with io::ParallelZipWriter, which deflates the entries on several threads
+class ParallelZipWriteCallback {
+ public:
+  ParallelZipWriteCallback(std::deque<std::shared_ptr<core::FlowFile>>& flows, FlowFileSerializer& serializer, size_t thread_count)
+      : flows_(flows),
+        serializer_(serializer),
+        thread_count_(thread_count) {
+  }
+
+  io::IoResult operator()(const std::shared_ptr<io::OutputStream>& stream) const;
+
+ private:
+  std::deque<std::shared_ptr<core::FlowFile>>& flows_;
+  FlowFileSerializer& serializer_;
+  size_t thread_count_;
+};
+
 class TarMerge: public ArchiveMerge, public MergeBin {
  public:
   void merge(core::ProcessSession &session, std::deque<std::shared_ptr<core::FlowFile>> &flows,
@@ -246,8 +263,13 @@ class TarMerge: public ArchiveMerge, public MergeBin {
 
 class ZipMerge: public ArchiveMerge, public MergeBin {
  public:
+  explicit ZipMerge(size_t thread_count = 1) : thread_count_(thread_count) {}
+
   void merge(core::ProcessSession &session, std::deque<std::shared_ptr<core::FlowFile>> &flows,
              FlowFileSerializer& serializer, const std::shared_ptr<core::FlowFile> &merge_flow) override;
+
+ private:
+  size_t thread_count_;
 };
 
 class AttributeMerger {
@@ -356,6 +378,15 @@ class MergeContent : public processors::BinFiles {
       .withAllowedValues({merge_content_options::ATTRIBUTE_STRATEGY_KEEP_COMMON, merge_content_options::ATTRIBUTE_STRATEGY_KEEP_ALL_UNIQUE})
       .withDefaultValue(merge_content_options::ATTRIBUTE_STRATEGY_KEEP_COMMON)
       .build();
+  EXTENSIONAPI static constexpr auto CompressionThreadCount = core::PropertyDefinitionBuilder<>::createProperty("Compression Thread Count")
+      .withDescription("The number of threads deflating the entries of a ZIP archive. If more than 1, the entries are compressed independently and in parallel, "
+          "and the archive is assembled from them in the order of the FlowFiles, instead of being written by libarchive on the processor's thread. "
+          "Each thread holds the content of one FlowFile in memory; FlowFiles larger than 16 MB are compressed on the processor's thread without being read into memory. "
+          "Used only with the ZIP Merge Format.")
+      .isRequired(true)
+      .withValidator(core::StandardPropertyValidators::UNSIGNED_INTEGER_VALIDATOR)
+      .withDefaultValue("1")
+      .build();
   EXTENSIONAPI static constexpr auto Properties = utils::array_cat(BinFiles::Properties, std::to_array<core::PropertyReference>({
       MergeStrategy,
       MergeFormat,
@@ -365,7 +396,8 @@ class MergeContent : public processors::BinFiles {
       Header,
       Footer,
       Demarcator,
-      AttributeStrategy
+      AttributeStrategy,
+      CompressionThreadCount
   }));
 
 
@@ -375,7 +407,7 @@ class MergeContent : public processors::BinFiles {
   EXTENSIONAPI static constexpr bool SupportsDynamicProperties = false;
   EXTENSIONAPI static constexpr bool SupportsDynamicRelationships = false;
   EXTENSIONAPI static constexpr core::annotation::Input InputRequirement = core::annotation::Input::INPUT_REQUIRED;
-  EXTENSIONAPI static constexpr bool IsSingleThreaded = true;
+  EXTENSIONAPI static constexpr bool IsSingleThreaded = false;
 
   ADD_COMMON_VIRTUAL_FUNCTIONS_FOR_PROCESSORS
 
@@ -405,6 +437,7 @@ class MergeContent : public processors::BinFiles {
   std::string footerContent_;
   std::string demarcatorContent_;
   std::string attributeStrategy_;
+  uint64_t compressionThreadCount_ = 1;
   static std::string readContent(const std::string& path);
 };
 
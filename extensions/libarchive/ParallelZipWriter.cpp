@@ -0,0 +1,492 @@
+/**
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The ASF licenses this file to You under the Apache License, Version 2.0
+ * (the "License"); you may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "ParallelZipWriter.h"
+
+#include <zlib.h>
+
+#include <algorithm>
+#include <limits>
+#include <memory>
+#include <utility>
+
+#include "io/Stream.h"
+#include "io/OutputStream.h"
+#include "minifi-cpp/utils/gsl.h"
+
+namespace org::apache::nifi::minifi::io {
+
+namespace {
+
+constexpr uint32_t LOCAL_FILE_HEADER_SIGNATURE = 0x04034b50;
+constexpr uint32_t CENTRAL_DIRECTORY_HEADER_SIGNATURE = 0x02014b50;
+constexpr uint32_t ZIP64_END_OF_CENTRAL_DIRECTORY_SIGNATURE = 0x06064b50;
+constexpr uint32_t ZIP64_END_OF_CENTRAL_DIRECTORY_LOCATOR_SIGNATURE = 0x07064b50;
+constexpr uint32_t END_OF_CENTRAL_DIRECTORY_SIGNATURE = 0x06054b50;
+constexpr uint32_t DATA_DESCRIPTOR_SIGNATURE = 0x08074b50;
+
+constexpr uint16_t ZIP64_EXTRA_FIELD_ID = 0x0001;
+constexpr uint16_t EXTENDED_TIMESTAMP_EXTRA_FIELD_ID = 0x5455;
+
+constexpr uint16_t METHOD_STORED = 0;
+constexpr uint16_t METHOD_DEFLATED = 8;
+constexpr uint16_t VERSION_DEFLATE = 20;
+constexpr uint16_t VERSION_ZIP64 = 45;
+constexpr uint16_t VERSION_MADE_BY_UNIX = 3 << 8;
+constexpr uint16_t FLAG_DATA_DESCRIPTOR = 1 << 3;
+constexpr uint16_t FLAG_UTF8_NAME = 1 << 11;
+
+constexpr uint32_t ZIP64_LIMIT_32 = std::numeric_limits<uint32_t>::max();
+constexpr uint16_t ZIP64_LIMIT_16 = std::numeric_limits<uint16_t>::max();
+
+// zlib takes the buffer sizes as 32-bit integers
+constexpr size_t DEFLATE_CHUNK_SIZE = 1024 * 1024 * 1024;
+constexpr size_t STREAMED_OUTPUT_BUFFER_SIZE = 64 * 1024;
+
+template<typename T>
+void appendLittleEndian(std::vector<std::byte>& buffer, T value) {
+  for (size_t i = 0; i < sizeof(T); ++i) {
+    buffer.push_back(static_cast<std::byte>((static_cast<uint64_t>(value) >> (8 * i)) & 0xFF));
+  }
+}
+
+void appendBytes(std::vector<std::byte>& buffer, std::string_view data) {
+  const auto bytes = std::as_bytes(std::span(data));
+  buffer.insert(buffer.end(), bytes.begin(), bytes.end());
+}
+
+uint32_t limitTo32Bits(uint64_t value) {
+  return value >= ZIP64_LIMIT_32 ? ZIP64_LIMIT_32 : gsl::narrow<uint32_t>(value);
+}
+
+// MS-DOS date and time, in UTC, as the agent does not know its time zone; the exact time is in the extended timestamp extra field
+std::pair<uint16_t, uint16_t> toDosDateTime(int64_t unix_time) {
+  using namespace std::chrono;  // NOLINT(build/namespaces)
+  const sys_seconds time_point{seconds{unix_time}};
+  const auto day = floor<days>(time_point);
+  const year_month_day date{day};
+  const hh_mm_ss time{time_point - day};
+  const int year = std::clamp(static_cast<int>(date.year()), 1980, 2107);
+  const auto dos_date = gsl::narrow<uint16_t>(((year - 1980) << 9) | (static_cast<unsigned>(date.month()) << 5) | static_cast<unsigned>(date.day()));
+  const auto dos_time = gsl::narrow<uint16_t>((time.hours().count() << 11) | (time.minutes().count() << 5) | (time.seconds().count() / 2));
+  return {dos_date, dos_time};
+}
+
+void appendExtendedTimestamp(std::vector<std::byte>& buffer, int64_t modification_time) {
+  appendLittleEndian(buffer, EXTENDED_TIMESTAMP_EXTRA_FIELD_ID);
+  appendLittleEndian<uint16_t>(buffer, 5);
+  appendLittleEndian<uint8_t>(buffer, 1);  // only the modification time is present
+  appendLittleEndian(buffer, gsl::narrow_cast<uint32_t>(modification_time));
+}
+
+std::optional<std::vector<std::byte>> deflateRaw(int compression_level, std::span<const std::byte> content) {
+  z_stream strm{};
+  // negative window bits write a raw deflate stream, without the zlib header and trailer
+  if (deflateInit2(&strm, compression_level, Z_DEFLATED, -MAX_WBITS, 8, Z_DEFAULT_STRATEGY) != Z_OK) {
+    return std::nullopt;
+  }
+  const auto deflate_end = gsl::finally([&strm] { deflateEnd(&strm); });
+  std::vector<std::byte> compressed(content.size() / 2 + 1024);
+  size_t input_offset = 0;
+  size_t output_size = 0;
+  int ret = Z_OK;
+  while (ret != Z_STREAM_END) {
+    if (strm.avail_in == 0) {
+      const size_t chunk_size = std::min(content.size() - input_offset, DEFLATE_CHUNK_SIZE);
+      strm.next_in = reinterpret_cast<Bytef*>(const_cast<std::byte*>(content.data() + input_offset));
+      strm.avail_in = gsl::narrow<uInt>(chunk_size);
+      input_offset += chunk_size;
+    }
+    if (output_size == compressed.size()) {
+      compressed.resize(compressed.size() * 2);
+    }
+    const size_t available_output = std::min(compressed.size() - output_size, DEFLATE_CHUNK_SIZE);
+    strm.next_out = reinterpret_cast<Bytef*>(compressed.data() + output_size);
+    strm.avail_out = gsl::narrow<uInt>(available_output);
+    ret = deflate(&strm, input_offset == content.size() ? Z_FINISH : Z_NO_FLUSH);
+    if (ret == Z_STREAM_ERROR) {
+      return std::nullopt;
+    }
+    output_size += available_output - strm.avail_out;
+  }
+  compressed.resize(output_size);
+  return compressed;
+}
+
+// deflates the content of a streamed entry into the archive, computing its CRC-32 and sizes on the way
+class DeflatingEntryStream : public StreamImpl, public virtual OutputStreamImpl {
+ public:
+  DeflatingEntryStream(int compression_level, std::function<bool(std::span<const std::byte>)> sink)
+      : sink_(std::move(sink)),
+        output_buffer_(STREAMED_OUTPUT_BUFFER_SIZE) {
+    initialized_ = deflateInit2(&strm_, compression_level, Z_DEFLATED, -MAX_WBITS, 8, Z_DEFAULT_STRATEGY) == Z_OK;
+    failed_ = !initialized_;
+  }
+
+  DeflatingEntryStream(const DeflatingEntryStream&) = delete;
+  DeflatingEntryStream(DeflatingEntryStream&&) = delete;
+  DeflatingEntryStream& operator=(const DeflatingEntryStream&) = delete;
+  DeflatingEntryStream& operator=(DeflatingEntryStream&&) = delete;
+
+  ~DeflatingEntryStream() override {
+    if (initialized_) {
+      deflateEnd(&strm_);
+    }
+  }
+
+  using OutputStream::write;
+  size_t write(const uint8_t* value, size_t size) override {
+    if (size == 0) {
+      return 0;
+    }
+    if (failed_ || value == nullptr) {
+      return STREAM_ERROR;
+    }
+    crc_ = crc32_z(crc_, value, size);
+    uncompressed_size_ += size;
+    for (size_t offset = 0; offset < size; offset += DEFLATE_CHUNK_SIZE) {
+      const size_t chunk_size = std::min(size - offset, DEFLATE_CHUNK_SIZE);
+      strm_.next_in = const_cast<Bytef*>(value + offset);
+      strm_.avail_in = gsl::narrow<uInt>(chunk_size);
+      if (!deflateAvailableInput(Z_NO_FLUSH)) {
+        failed_ = true;
+        return STREAM_ERROR;
+      }
+    }
+    return size;
+  }
+
+  // flushes the rest of the deflate stream, returns false if the content could not be compressed or written
+  bool finish() {
+    if (failed_) {
+      return false;
+    }
+    strm_.next_in = nullptr;
+    strm_.avail_in = 0;
+    failed_ = !deflateAvailableInput(Z_FINISH);
+    return !failed_;
+  }
+
+  [[nodiscard]] uint32_t crc() const { return gsl::narrow_cast<uint32_t>(crc_); }
+  [[nodiscard]] uint64_t uncompressedSize() const { return uncompressed_size_; }
+  [[nodiscard]] uint64_t compressedSize() const { return compressed_size_; }
+
+ private:
+  bool deflateAvailableInput(int flush) {
+    int ret = Z_OK;
+    do {
+      strm_.next_out = reinterpret_cast<Bytef*>(output_buffer_.data());
+      strm_.avail_out = gsl::narrow<uInt>(output_buffer_.size());
+      ret = deflate(&strm_, flush);
+      if (ret == Z_STREAM_ERROR) {
+        return false;
+      }
+      const size_t output_size = output_buffer_.size() - strm_.avail_out;
+      if (!sink_(std::span(output_buffer_).first(output_size))) {
+        return false;
+      }
+      compressed_size_ += output_size;
+    } while (flush == Z_FINISH ? ret != Z_STREAM_END : strm_.avail_out == 0);
+    return true;
+  }
+
+  std::function<bool(std::span<const std::byte>)> sink_;
+  std::vector<std::byte> output_buffer_;
+  z_stream strm_{};
+  bool initialized_ = false;
+  bool failed_ = false;
+  uLong crc_ = crc32_z(0, nullptr, 0);
+  uint64_t uncompressed_size_ = 0;
+  uint64_t compressed_size_ = 0;
+};
+
+}  // namespace
+
+ParallelZipWriter::ParallelZipWriter(OutputStream& output, int compression_level, size_t thread_count)
+    : output_(output),
+      compression_level_(compression_level),
+      thread_count_(std::max<size_t>(thread_count, 1)),
+      compressor_pool_(thread_count_) {
+}
+
+bool ParallelZipWriter::addEntry(std::string name, std::vector<std::byte> content, uint32_t mode, std::chrono::system_clock::time_point modification_time) {
+  if (failed_) {
+    return false;
+  }
+  if (compressor_pool_.size() == thread_count_ && !writeNextEntry()) {
+    return false;
+  }
+  const auto unix_time = std::chrono::duration_cast<std::chrono::seconds>(modification_time.time_since_epoch()).count();
+  compressor_pool_.add(
+      [compression_level = compression_level_, name = std::move(name), content = std::move(content), mode, unix_time]() mutable -> std::optional<CompressedEntry> {
+    CompressedEntry entry{.name = std::move(name), .mode = mode, .modification_time = unix_time};
+    entry.uncompressed_size = content.size();
+    entry.crc = gsl::narrow_cast<uint32_t>(crc32_z(crc32_z(0, nullptr, 0), reinterpret_cast<const Bytef*>(content.data()), content.size()));
+    auto compressed = deflateRaw(compression_level, content);
+    if (!compressed) {
+      return std::nullopt;
+    }
+    // incompressible content is stored as is, like zip tools do
+    if (compressed->size() < content.size()) {
+      entry.method = METHOD_DEFLATED;
+      entry.data = std::move(*compressed);
+    } else {
+      entry.method = METHOD_STORED;
+      entry.data = std::move(content);
+    }
+    return entry;
+  });
+  return true;
+}
+
+bool ParallelZipWriter::addStreamedEntry(std::string name, uint32_t mode, std::chrono::system_clock::time_point modification_time,
+    const std::function<IoResult(const std::shared_ptr<OutputStream>&)>& write_content) {
+  // the entries added earlier come first in the archive
+  while (compressor_pool_.size() > 0) {
+    if (failed_ || !writeNextEntry()) {
+      return false;
+    }
+  }
+  if (failed_) {
+    return false;
+  }
+
+  const auto unix_time = std::chrono::duration_cast<std::chrono::seconds>(modification_time.time_since_epoch()).count();
+  const auto [dos_date, dos_time] = toDosDateTime(unix_time);
+
+  // the sizes are not known in advance, so the ZIP64 extra field is always present, with the sizes in the data descriptor
+  std::vector<std::byte> extra_field;
+  appendLittleEndian(extra_field, ZIP64_EXTRA_FIELD_ID);
+  appendLittleEndian<uint16_t>(extra_field, 16);
+  appendLittleEndian<uint64_t>(extra_field, 0);
+  appendLittleEndian<uint64_t>(extra_field, 0);
+  appendExtendedTimestamp(extra_field, unix_time);
+
+  std::vector<std::byte> header;
+  appendLittleEndian(header, LOCAL_FILE_HEADER_SIGNATURE);
+  appendLittleEndian(header, VERSION_ZIP64);
+  appendLittleEndian(header, gsl::narrow<uint16_t>(FLAG_UTF8_NAME | FLAG_DATA_DESCRIPTOR));
+  appendLittleEndian(header, METHOD_DEFLATED);
+  appendLittleEndian(header, dos_time);
+  appendLittleEndian(header, dos_date);
+  appendLittleEndian<uint32_t>(header, 0);  // the CRC-32 is in the data descriptor
+  appendLittleEndian(header, ZIP64_LIMIT_32);
+  appendLittleEndian(header, ZIP64_LIMIT_32);
+  appendLittleEndian(header, gsl::narrow<uint16_t>(name.size()));
+  appendLittleEndian(header, gsl::narrow<uint16_t>(extra_field.size()));
+  appendBytes(header, name);
+  header.insert(header.end(), extra_field.begin(), extra_field.end());
+
+  const uint64_t local_header_offset = offset_;
+  if (!write(header)) {
+    failed_ = true;
+    return false;
+  }
+  const auto entry_stream = std::make_shared<DeflatingEntryStream>(compression_level_, [this](std::span<const std::byte> data) { return write(data); });
+  if (!write_content(entry_stream) || !entry_stream->finish()) {
+    failed_ = true;
+    return false;
+  }
+
+  std::vector<std::byte> data_descriptor;
+  appendLittleEndian(data_descriptor, DATA_DESCRIPTOR_SIGNATURE);
+  appendLittleEndian(data_descriptor, entry_stream->crc());
+  appendLittleEndian(data_descriptor, entry_stream->compressedSize());
+  appendLittleEndian(data_descriptor, entry_stream->uncompressedSize());
+  if (!write(data_descriptor)) {
+    failed_ = true;
+    return false;
+  }
+  central_directory_.push_back(CentralDirectoryRecord{
+    .name = std::move(name),
+    .method = METHOD_DEFLATED,
+    .crc = entry_stream->crc(),
+    .compressed_size = entry_stream->compressedSize(),
+    .uncompressed_size = entry_stream->uncompressedSize(),
+    .mode = mode,
+    .modification_time = unix_time,
+    .local_header_offset = local_header_offset,
+    .streamed = true
+  });
+  return true;
+}
+
+bool ParallelZipWriter::writeNextEntry() {
+  const auto entry = compressor_pool_.takeNext();
+  if (!entry) {
+    failed_ = true;
+    return false;
+  }
+
+  const uint64_t compressed_size = entry->data.size();
+  const bool zip64 = entry->uncompressed_size >= ZIP64_LIMIT_32 || compressed_size >= ZIP64_LIMIT_32;
+  const auto [dos_date, dos_time] = toDosDateTime(entry->modification_time);
+
+  std::vector<std::byte> extra_field;
+  if (zip64) {
+    // the local header has to contain both sizes when either of them needs ZIP64
+    appendLittleEndian(extra_field, ZIP64_EXTRA_FIELD_ID);
+    appendLittleEndian<uint16_t>(extra_field, 16);
+    appendLittleEndian(extra_field, entry->uncompressed_size);
+    appendLittleEndian(extra_field, compressed_size);
+  }
+  appendExtendedTimestamp(extra_field, entry->modification_time);
+
+  std::vector<std::byte> header;
+  appendLittleEndian(header, LOCAL_FILE_HEADER_SIGNATURE);
+  appendLittleEndian(header, zip64 ? VERSION_ZIP64 : VERSION_DEFLATE);
+  appendLittleEndian(header, FLAG_UTF8_NAME);
+  appendLittleEndian(header, entry->method);
+  appendLittleEndian(header, dos_time);
+  appendLittleEndian(header, dos_date);
+  appendLittleEndian(header, entry->crc);
+  appendLittleEndian(header, zip64 ? ZIP64_LIMIT_32 : gsl::narrow<uint32_t>(compressed_size));
+  appendLittleEndian(header, zip64 ? ZIP64_LIMIT_32 : gsl::narrow<uint32_t>(entry->uncompressed_size));
+  appendLittleEndian(header, gsl::narrow<uint16_t>(entry->name.size()));
+  appendLittleEndian(header, gsl::narrow<uint16_t>(extra_field.size()));
+  appendBytes(header, entry->name);
+  header.insert(header.end(), extra_field.begin(), extra_field.end());
+
+  const uint64_t local_header_offset = offset_;
+  if (!write(header) || !write(entry->data)) {
+    failed_ = true;
+    return false;
+  }
+  central_directory_.push_back(CentralDirectoryRecord{
+    .name = entry->name,
+    .method = entry->method,
+    .crc = entry->crc,
+    .compressed_size = compressed_size,
+    .uncompressed_size = entry->uncompressed_size,
+    .mode = entry->mode,
+    .modification_time = entry->modification_time,
+    .local_header_offset = local_header_offset
+  });
+  return true;
+}
+
+bool ParallelZipWriter::write(std::span<const std::byte> data) {
+  if (data.empty()) {
+    return true;
+  }
+  const auto ret = output_.write(data);
+  if (isError(ret) || ret != data.size()) {
+    return false;
+  }
+  offset_ += ret;
+  return true;
+}
+
+IoResult ParallelZipWriter::finish() {
+  while (compressor_pool_.size() > 0) {
+    if (!writeNextEntry()) {
+      while (compressor_pool_.size() > 0) {
+        compressor_pool_.takeNext();
+      }
+      return IoResult::error();
+    }
+  }
+  if (failed_) {
+    return IoResult::error();
+  }
+
+  const uint64_t central_directory_offset = offset_;
+  std::vector<std::byte> central_directory;
+  for (const auto& record : central_directory_) {
+    // only the values which do not fit into the 32-bit fields are in the ZIP64 extra field, in this order
+    std::vector<std::byte> zip64_values;
+    if (record.uncompressed_size >= ZIP64_LIMIT_32) {
+      appendLittleEndian(zip64_values, record.uncompressed_size);
+    }
+    if (record.compressed_size >= ZIP64_LIMIT_32) {
+      appendLittleEndian(zip64_values, record.compressed_size);
+    }
+    if (record.local_header_offset >= ZIP64_LIMIT_32) {
+      appendLittleEndian(zip64_values, record.local_header_offset);
+    }
+    std::vector<std::byte> extra_field;
+    if (!zip64_values.empty()) {
+      appendLittleEndian(extra_field, ZIP64_EXTRA_FIELD_ID);
+      appendLittleEndian(extra_field, gsl::narrow<uint16_t>(zip64_values.size()));
+      extra_field.insert(extra_field.end(), zip64_values.begin(), zip64_values.end());
+    }
+    appendExtendedTimestamp(extra_field, record.modification_time);
+
+    const bool zip64 = record.streamed || record.uncompressed_size >= ZIP64_LIMIT_32 || record.compressed_size >= ZIP64_LIMIT_32;
+    const uint16_t version = zip64 || record.local_header_offset >= ZIP64_LIMIT_32 ? VERSION_ZIP64 : VERSION_DEFLATE;
+    const auto [dos_date, dos_time] = toDosDateTime(record.modification_time);
+    appendLittleEndian(central_directory, CENTRAL_DIRECTORY_HEADER_SIGNATURE);
+    appendLittleEndian(central_directory, gsl::narrow<uint16_t>(VERSION_MADE_BY_UNIX | version));
+    appendLittleEndian(central_directory, version);
+    appendLittleEndian(central_directory, gsl::narrow<uint16_t>(record.streamed ? FLAG_UTF8_NAME | FLAG_DATA_DESCRIPTOR : FLAG_UTF8_NAME));
+    appendLittleEndian(central_directory, record.method);
+    appendLittleEndian(central_directory, dos_time);
+    appendLittleEndian(central_directory, dos_date);
+    appendLittleEndian(central_directory, record.crc);
+    appendLittleEndian(central_directory, limitTo32Bits(record.compressed_size));
+    appendLittleEndian(central_directory, limitTo32Bits(record.uncompressed_size));
+    appendLittleEndian(central_directory, gsl::narrow<uint16_t>(record.name.size()));
+    appendLittleEndian(central_directory, gsl::narrow<uint16_t>(extra_field.size()));
+    appendLittleEndian<uint16_t>(central_directory, 0);  // comment length
+    appendLittleEndian<uint16_t>(central_directory, 0);  // disk number
+    appendLittleEndian<uint16_t>(central_directory, 0);  // internal attributes
+    appendLittleEndian(central_directory, record.mode << 16);  // external attributes, the upper half is the unix mode
+    appendLittleEndian(central_directory, limitTo32Bits(record.local_header_offset));
+    appendBytes(central_directory, record.name);
+    central_directory.insert(central_directory.end(), extra_field.begin(), extra_field.end());
+  }
+  const uint64_t central_directory_size = central_directory.size();
+  const uint64_t entry_count = central_directory_.size();
+
+  std::vector<std::byte> end_of_central_directory;
+  const bool zip64 = entry_count >= ZIP64_LIMIT_16 || central_directory_size >= ZIP64_LIMIT_32 || central_directory_offset >= ZIP64_LIMIT_32;
+  if (zip64) {
+    const uint64_t zip64_end_of_central_directory_offset = central_directory_offset + central_directory_size;
+    appendLittleEndian(end_of_central_directory, ZIP64_END_OF_CENTRAL_DIRECTORY_SIGNATURE);
+    appendLittleEndian<uint64_t>(end_of_central_directory, 44);  // size of the rest of the record
+    appendLittleEndian(end_of_central_directory, gsl::narrow<uint16_t>(VERSION_MADE_BY_UNIX | VERSION_ZIP64));
+    appendLittleEndian(end_of_central_directory, VERSION_ZIP64);
+    appendLittleEndian<uint32_t>(end_of_central_directory, 0);  // disk number
+    appendLittleEndian<uint32_t>(end_of_central_directory, 0);  // disk of the central directory
+    appendLittleEndian(end_of_central_directory, entry_count);
+    appendLittleEndian(end_of_central_directory, entry_count);
+    appendLittleEndian(end_of_central_directory, central_directory_size);
+    appendLittleEndian(end_of_central_directory, central_directory_offset);
+
+    appendLittleEndian(end_of_central_directory, ZIP64_END_OF_CENTRAL_DIRECTORY_LOCATOR_SIGNATURE);
+    appendLittleEndian<uint32_t>(end_of_central_directory, 0);  // disk of the ZIP64 end of central directory record
+    appendLittleEndian(end_of_central_directory, zip64_end_of_central_directory_offset);
+    appendLittleEndian<uint32_t>(end_of_central_directory, 1);  // number of disks
+  }
+  const uint16_t entry_count_16 = entry_count >= ZIP64_LIMIT_16 ? ZIP64_LIMIT_16 : gsl::narrow<uint16_t>(entry_count);
+  appendLittleEndian(end_of_central_directory, END_OF_CENTRAL_DIRECTORY_SIGNATURE);
+  appendLittleEndian<uint16_t>(end_of_central_directory, 0);  // disk number
+  appendLittleEndian<uint16_t>(end_of_central_directory, 0);  // disk of the central directory
+  appendLittleEndian(end_of_central_directory, entry_count_16);
+  appendLittleEndian(end_of_central_directory, entry_count_16);
+  appendLittleEndian(end_of_central_directory, limitTo32Bits(central_directory_size));
+  appendLittleEndian(end_of_central_directory, limitTo32Bits(central_directory_offset));
+  appendLittleEndian<uint16_t>(end_of_central_directory, 0);  // comment length
+
+  if (!write(central_directory) || !write(end_of_central_directory)) {
+    return IoResult::error();
+  }
+  return IoResult::from(offset_);
+}
+
+}  // namespace org::apache::nifi::minifi::io
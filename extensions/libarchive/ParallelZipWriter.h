@@ -0,0 +1,102 @@
+/**
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The ASF licenses this file to You under the Apache License, Version 2.0
+ * (the "License"); you may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <optional>
+#include <span>
+#include <string>
+#include <vector>
+
+#include "minifi-cpp/io/OutputStream.h"
+#include "minifi-cpp/io/StreamCallback.h"
+#include "utils/OrderedTaskPool.h"
+
+namespace org::apache::nifi::minifi::io {
+
+/**
+ * Writes a ZIP archive whose entries are deflated independently on thread_count worker threads, and written to the output in the order they were added.
+ * An entry is written only after it has been compressed, so its sizes and CRC-32 are known when its local header is written, and the central directory
+ * is assembled from them when the archive is finished. ZIP64 records are only written when a size, an offset or the number of entries requires them.
+ * At most thread_count entries are compressed or waiting to be written at any time. Entries larger than MAX_BUFFERED_ENTRY_SIZE should be added
+ * with addStreamedEntry, which deflates them directly into the archive, so the memory used stays below about thread_count * MAX_BUFFERED_ENTRY_SIZE.
+ */
+class ParallelZipWriter {
+ public:
+  static constexpr uint64_t MAX_BUFFERED_ENTRY_SIZE = 16 * 1024 * 1024;
+
+  ParallelZipWriter(OutputStream& output, int compression_level, size_t thread_count);
+
+  ParallelZipWriter(const ParallelZipWriter&) = delete;
+  ParallelZipWriter(ParallelZipWriter&&) = delete;
+  ParallelZipWriter& operator=(const ParallelZipWriter&) = delete;
+  ParallelZipWriter& operator=(ParallelZipWriter&&) = delete;
+  ~ParallelZipWriter() = default;
+
+  // schedules the compression of the entry, returns false if it or an earlier entry could not be compressed or written
+  bool addEntry(std::string name, std::vector<std::byte> content, uint32_t mode, std::chrono::system_clock::time_point modification_time);
+
+  // writes the entries added earlier, then deflates the content written by write_content into the archive on the calling thread, without buffering it;
+  // the CRC-32 and the sizes are written after the data, in a ZIP64 data descriptor; returns false if it or an earlier entry could not be written
+  bool addStreamedEntry(std::string name, uint32_t mode, std::chrono::system_clock::time_point modification_time,
+      const std::function<IoResult(const std::shared_ptr<OutputStream>&)>& write_content);
+
+  // writes the remaining entries and the central directory, returns the size of the archive
+  IoResult finish();
+
+ private:
+  struct CompressedEntry {
+    std::string name;
+    std::vector<std::byte> data;
+    uint16_t method = 0;
+    uint32_t crc = 0;
+    uint64_t uncompressed_size = 0;
+    uint32_t mode = 0;
+    int64_t modification_time = 0;
+  };
+
+  struct CentralDirectoryRecord {
+    std::string name;
+    uint16_t method = 0;
+    uint32_t crc = 0;
+    uint64_t compressed_size = 0;
+    uint64_t uncompressed_size = 0;
+    uint32_t mode = 0;
+    int64_t modification_time = 0;
+    uint64_t local_header_offset = 0;
+    bool streamed = false;
+  };
+
+  bool writeNextEntry();
+  bool write(std::span<const std::byte> data);
+
+  OutputStream& output_;
+  int compression_level_;
+  size_t thread_count_;
+  utils::OrderedTaskPool<std::optional<CompressedEntry>> compressor_pool_;
+  std::vector<CentralDirectoryRecord> central_directory_;
+  uint64_t offset_ = 0;
+  bool failed_ = false;
+};
+
+}  // namespace org::apache::nifi::minifi::io
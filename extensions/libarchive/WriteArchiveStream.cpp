@@ -18,6 +18,7 @@
 
 #include "WriteArchiveStream.h"
 
+#include <algorithm>
 #include <utility>
 #include <string>
 
@@ -67,6 +68,31 @@ processors::archive_write_unique_ptr WriteArchiveStreamImpl::createWriteArchive(
       logger_->log_error("Archive write add filter xz error {}", archive_error_string(arch.get()));
       return nullptr;
     }
+  } else if (compress_format_ == CompressionFormat::ZSTD) {
+    result = archive_write_add_filter_zstd(arch.get());
+    if (result != ARCHIVE_OK) {
+      logger_->log_error("Archive write add filter zstd error {}", archive_error_string(arch.get()));
+      return nullptr;
+    }
+    std::string option = "zstd:compression-level=" + std::to_string(compress_level_);
+    result = archive_write_set_options(arch.get(), option.c_str());
+    if (result != ARCHIVE_OK) {
+      logger_->log_error("Archive write set options error {}", archive_error_string(arch.get()));
+      return nullptr;
+    }
+  } else if (compress_format_ == CompressionFormat::LZ4) {
+    result = archive_write_add_filter_lz4(arch.get());
+    if (result != ARCHIVE_OK) {
+      logger_->log_error("Archive write add filter lz4 error {}", archive_error_string(arch.get()));
+      return nullptr;
+    }
+    // libarchive only accepts the lz4 levels 1-9, the higher ones are available only when compressing without a TAR archive
+    std::string option = "lz4:compression-level=" + std::to_string(std::clamp(compress_level_, 1, 9));
+    result = archive_write_set_options(arch.get(), option.c_str());
+    if (result != ARCHIVE_OK) {
+      logger_->log_error("Archive write set options error {}", archive_error_string(arch.get()));
+      return nullptr;
+    }
   } else {
     logger_->log_error("Archive write unsupported compression format");
     return nullptr;
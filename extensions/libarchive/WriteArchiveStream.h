@@ -37,7 +37,9 @@ enum class CompressionFormat {
   GZIP,
   LZMA,
   XZ_LZMA2,
-  BZIP2
+  BZIP2,
+  ZSTD,
+  LZ4
 };
 
 }  // namespace org::apache::nifi::minifi::io
@@ -56,6 +58,10 @@ constexpr customize_t enum_name<CompressionFormat>(CompressionFormat value) noex
       return "xz-lzma2";
     case CompressionFormat::BZIP2:
       return "bzip2";
+    case CompressionFormat::ZSTD:
+      return "zstd";
+    case CompressionFormat::LZ4:
+      return "lz4";
   }
   return invalid_tag;
 }
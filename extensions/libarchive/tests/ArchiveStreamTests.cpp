@@ -16,10 +16,18 @@
  * limitations under the License.
  */
 
+#include <algorithm>
+#include <random>
+#include <string>
+#include <utility>
+#include <vector>
+
 #include "unit/TestBase.h"
 #include "unit/Catch.h"
+#include "utils/StringUtils.h"
 #include "WriteArchiveStream.h"
 #include "ReadArchiveStream.h"
+#include "ParallelZipWriter.h"
 
 TEST_CASE("Create and read archive") {
   std::map<std::string, std::string> files{
@@ -52,3 +60,102 @@ TEST_CASE("Create and read archive") {
     REQUIRE(extracted_entries == files.size());
   }
 }
+
+TEST_CASE("Read a ZIP archive written by ParallelZipWriter") {
+  const auto thread_count = GENERATE(1, 4);
+  std::vector<std::pair<std::string, std::string>> files{
+      {"empty.txt", ""},
+      {"repetitive.txt", utils::string::repeat("hello, I'm a repetitive file ", 10000)},
+      {"dir/short.txt", "x"}
+  };
+  std::string random_content(100000, '\0');
+  std::mt19937 random_engine(42);  // NOLINT(cert-msc32-c,cert-msc51-cpp)
+  std::generate(random_content.begin(), random_content.end(), [&] { return static_cast<char>(random_engine()); });
+  files.emplace_back("random.bin", random_content);
+
+  auto archive = std::make_shared<minifi::io::BufferStream>();
+  {
+    minifi::io::ParallelZipWriter zip_writer(*archive, 6, thread_count);
+    for (const auto& [filename, content] : files) {
+      const auto bytes = as_bytes(std::span(content));
+      REQUIRE(zip_writer.addEntry(filename, {bytes.begin(), bytes.end()}, S_IFREG | 0644, std::chrono::system_clock::now()));
+    }
+    const auto ret = zip_writer.finish();
+    REQUIRE(ret);
+    CHECK(*ret == archive->size());
+  }
+  // the repetitive file is deflated, the random one is stored
+  CHECK(archive->size() < files[1].second.size() / 10 + random_content.size() + 1000);
+
+  minifi::io::ReadArchiveStreamImpl decompressor(archive);
+  size_t extracted_entries = 0;
+  while (auto info = decompressor.nextEntry()) {
+    REQUIRE(extracted_entries < files.size());
+    const auto& [filename, content] = files[extracted_entries];
+    CHECK(info->filename == filename);
+    REQUIRE(info->size == content.size());
+    std::string file_content(info->size, '\0');
+    if (!file_content.empty()) {
+      REQUIRE(decompressor.read(as_writable_bytes(std::span(file_content))) == file_content.length());
+    }
+    CHECK(file_content == content);
+    ++extracted_entries;
+  }
+  CHECK(extracted_entries == files.size());
+}
+
+TEST_CASE("ParallelZipWriter deflates the streamed entries directly into the archive, between the buffered ones") {
+  const std::vector<std::pair<std::string, std::string>> files{
+      {"buffered.txt", "hello, I'm a buffered file"},
+      {"streamed.txt", utils::string::repeat("hello, I'm a streamed file ", 10000)},
+      {"streamed_empty.txt", ""},
+      {"last.txt", "hello, I'm the last file"}
+  };
+
+  auto archive = std::make_shared<minifi::io::BufferStream>();
+  {
+    minifi::io::ParallelZipWriter zip_writer(*archive, 6, 4);
+    for (const auto& [filename, content] : files) {
+      if (filename.starts_with("streamed")) {
+        REQUIRE(zip_writer.addStreamedEntry(filename, S_IFREG | 0644, std::chrono::system_clock::now(), [&content](const std::shared_ptr<minifi::io::OutputStream>& entry_stream) {
+          // written in several parts, like the content of a FlowFile
+          for (size_t offset = 0; offset < content.size(); offset += 1000) {
+            const auto part = std::string_view(content).substr(offset, 1000);
+            if (entry_stream->write(as_bytes(std::span(part))) != part.size()) {
+              return minifi::io::IoResult::error();
+            }
+          }
+          return minifi::io::IoResult::from(content.size());
+        }));
+      } else {
+        const auto bytes = as_bytes(std::span(content));
+        REQUIRE(zip_writer.addEntry(filename, {bytes.begin(), bytes.end()}, S_IFREG | 0644, std::chrono::system_clock::now()));
+      }
+    }
+    const auto ret = zip_writer.finish();
+    REQUIRE(ret);
+    CHECK(*ret == archive->size());
+  }
+  CHECK(archive->size() < files[1].second.size() / 10);
+
+  // the sizes of the streamed entries are only in the central directory, so the archive is read from memory, which libarchive can seek in
+  const auto reader = minifi::processors::archive_read_unique_ptr{archive_read_new()};
+  archive_read_support_format_zip(reader.get());
+  const auto buffer = archive->getBuffer();
+  REQUIRE(archive_read_open_memory(reader.get(), buffer.data(), buffer.size()) == ARCHIVE_OK);
+  size_t extracted_entries = 0;
+  struct archive_entry* entry = nullptr;
+  while (archive_read_next_header(reader.get(), &entry) == ARCHIVE_OK) {
+    REQUIRE(extracted_entries < files.size());
+    const auto& [filename, content] = files[extracted_entries];
+    CHECK(archive_entry_pathname(entry) == filename);
+    REQUIRE(archive_entry_size(entry) == gsl::narrow<int64_t>(content.size()));
+    std::string file_content(content.size(), '\0');
+    if (!file_content.empty()) {
+      REQUIRE(archive_read_data(reader.get(), file_content.data(), file_content.size()) == gsl::narrow<la_ssize_t>(file_content.size()));
+    }
+    CHECK(file_content == content);
+    ++extracted_entries;
+  }
+  CHECK(extracted_entries == files.size());
+}
@@ -16,6 +16,7 @@
  * limitations under the License.
  */
 
+#include <algorithm>
 #include <fstream>
 #include <iostream>
 #include <map>
@@ -25,6 +26,7 @@
 #include <sstream>
 #include <string>
 #include <utility>
+#include <vector>
 
 #include "CompressContent.h"
 #include "FlowController.h"
@@ -679,10 +681,17 @@ TEST_CASE_METHOD(CompressTestController, "Batch CompressFileGZip", "[compressFil
 }
 
 TEST_CASE_METHOD(DecompressTestController, "Invalid archive decompression", "[compressfiletest9]") {
-  const auto compression_format = GENERATE(CompressionFormat::GZIP, CompressionFormat::LZMA, CompressionFormat::XZ_LZMA2, CompressionFormat::BZIP2);
+  const auto compression_format = GENERATE(CompressionFormat::GZIP, CompressionFormat::LZMA, CompressionFormat::XZ_LZMA2, CompressionFormat::BZIP2,
+      CompressionFormat::ZSTD, CompressionFormat::LZ4);
   if (compression_format == CompressionFormat::BZIP2 && !archive_bzlib_version()) {
     return;
   }
+  if (compression_format == CompressionFormat::ZSTD && !archive_zstd_version()) {
+    return;
+  }
+  if (compression_format == CompressionFormat::LZ4 && !archive_liblz4_version()) {
+    return;
+  }
 
   if ((compression_format == CompressionFormat::LZMA || compression_format == CompressionFormat::XZ_LZMA2) && !archive_liblzma_version()) {
     return;
@@ -711,3 +720,80 @@ TEST_CASE_METHOD(DecompressTestController, "Invalid archive decompression", "[co
     REQUIRE(contents == "banana bread");
   }
 }
+
+TEST_CASE_METHOD(TestController, "Raw compression and decompression in blocks", "[compressfiletest10]") {
+  const auto [compression_format, file_extension, magic_number] = GENERATE(table<CompressionFormat, std::string, std::vector<uint8_t>>({
+      {CompressionFormat::GZIP, ".gz", {0x1f, 0x8b}},
+      {CompressionFormat::ZSTD, ".zst", {0x28, 0xb5, 0x2f, 0xfd}},
+      {CompressionFormat::LZ4, ".lz4", {0x04, 0x22, 0x4d, 0x18}}}));
+  const auto thread_count = GENERATE("1", "4");
+
+  auto src_dir = createTempDirectory();
+  auto dst_dir = createTempDirectory();
+  auto src_file = src_dir / "src.txt";
+  auto compressed_file = dst_dir / ("src.txt" + file_extension);
+  auto decompressed_file = dst_dir / "src.txt";
+
+  auto plan = createPlan();
+  auto get_file = plan->addProcessor("GetFile", "GetFile");
+  auto compress_content = plan->addProcessor("CompressContent", "CompressContent", core::Relationship("success", "d"), true);
+  auto put_compressed = plan->addProcessor("PutFile", "PutFile", core::Relationship("success", "d"), true);
+  auto decompress_content = plan->addProcessor("CompressContent", "CompressContent", core::Relationship("success", "d"), true);
+  auto put_decompressed = plan->addProcessor("PutFile", "PutFile", core::Relationship("success", "d"), true);
+
+  REQUIRE(plan->setProperty(get_file, minifi::processors::GetFile::Directory, src_dir.string()));
+  for (const auto& [processor, mode] : {std::pair{compress_content, CompressionMode::compress}, std::pair{decompress_content, CompressionMode::decompress}}) {
+    REQUIRE(plan->setProperty(processor, minifi::processors::CompressContent::CompressMode, std::string{magic_enum::enum_name(mode)}));
+    REQUIRE(plan->setProperty(processor, minifi::processors::CompressContent::CompressFormat, std::string{magic_enum::enum_name(compression_format)}));
+    REQUIRE(plan->setProperty(processor, minifi::processors::CompressContent::UpdateFileName, "true"));
+    REQUIRE(plan->setProperty(processor, minifi::processors::CompressContent::EncapsulateInTar, "false"));
+    REQUIRE(plan->setProperty(processor, minifi::processors::CompressContent::CompressionThreadCount, thread_count));
+    REQUIRE(plan->setProperty(processor, minifi::processors::CompressContent::CompressionBlockSize, "64 KB"));
+  }
+  REQUIRE(plan->setProperty(put_compressed, minifi::processors::PutFile::Directory, dst_dir.string()));
+  REQUIRE(plan->setProperty(put_decompressed, minifi::processors::PutFile::Directory, dst_dir.string()));
+
+  std::string content;
+  SECTION("Empty content") {}
+  SECTION("Short content") {
+    content = "Repeated repeated repeated repeated repeated stuff.";
+  }
+  SECTION("Content of many blocks") {
+    std::mt19937 gen(std::random_device{}());
+    std::uniform_int_distribution<int> dist('a', 'z');
+    for (size_t i = 0U; i < 1024 * 1024U + 17; i++) { content += gsl::narrow<char>(dist(gen)); }
+  }
+
+  std::ofstream{src_file, std::ios::binary} << content;
+
+  runSession(plan, true);
+
+  std::ifstream compressed(compressed_file, std::ios::in | std::ios::binary);
+  std::vector<uint8_t> compressed_content((std::istreambuf_iterator<char>(compressed)), std::istreambuf_iterator<char>());
+  REQUIRE(magic_number.size() < compressed_content.size());
+  CHECK(std::equal(magic_number.begin(), magic_number.end(), compressed_content.begin()));
+
+  std::ifstream decompressed(decompressed_file, std::ios::in | std::ios::binary);
+  std::string decompressed_content((std::istreambuf_iterator<char>(decompressed)), std::istreambuf_iterator<char>());
+  REQUIRE(content == decompressed_content);
+}
+
+TEST_CASE_METHOD(DecompressTestController, "Invalid raw zstd and lz4 content decompression", "[compressfiletest11]") {
+  const auto compression_format = GENERATE(CompressionFormat::ZSTD, CompressionFormat::LZ4);
+
+  CHECK(context->setProperty(minifi::processors::CompressContent::CompressFormat.name, std::string{magic_enum::enum_name(compression_format)}));
+  CHECK(context->setProperty(minifi::processors::CompressContent::CompressMode.name, std::string{magic_enum::enum_name(CompressionMode::decompress)}));
+  CHECK(context->setProperty(minifi::processors::CompressContent::EncapsulateInTar.name, "false"));
+
+  importFlowFileFrom(minifi::io::BufferStream(std::string{"banana bread"}));
+  trigger();
+
+  std::set<std::shared_ptr<core::FlowFile>> expiredFlowRecords;
+  REQUIRE_FALSE(output->poll(expiredFlowRecords));
+  auto invalid_flow = failure_output->poll(expiredFlowRecords);
+  REQUIRE(invalid_flow);
+  ReadCallback callback(gsl::narrow<size_t>(invalid_flow->getSize()));
+  read(invalid_flow, callback);
+  std::string contents(reinterpret_cast<char*>(callback.buffer_.data()), callback.read_size_);
+  REQUIRE(contents == "banana bread");
+}
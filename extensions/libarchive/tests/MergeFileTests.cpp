@@ -24,6 +24,8 @@
 #include <set>
 #include <sstream>
 #include <string>
+#include <thread>
+#include <vector>
 
 #include "core/Relationship.h"
 #include "core/Core.h"
@@ -498,6 +500,9 @@ TEST_CASE_METHOD(MergeTestController, "MergeFileTar", "[mergefiletest4]") {
 }
 
 TEST_CASE_METHOD(MergeTestController, "MergeFileZip", "[mergefiletest5]") {
+  // with more than one thread, the entries are deflated in parallel by ParallelZipWriter instead of libarchive
+  const auto thread_count = GENERATE("1", "4");
+  REQUIRE(context_->setProperty(minifi::processors::MergeContent::CompressionThreadCount, thread_count));
   REQUIRE(context_->setProperty(minifi::processors::MergeContent::MergeFormat, std::string{minifi::processors::merge_content_options::MERGE_FORMAT_ZIP_VALUE}));
   REQUIRE(context_->setProperty(minifi::processors::MergeContent::MergeStrategy, std::string{minifi::processors::merge_content_options::MERGE_STRATEGY_BIN_PACK}));
   REQUIRE(context_->setProperty(minifi::processors::MergeContent::DelimiterStrategy, std::string{minifi::processors::merge_content_options::DELIMITER_STRATEGY_TEXT}));
@@ -838,6 +843,70 @@ TEST_CASE_METHOD(MergeTestController, "Batch Size", "[testMergeFileBatchSize]")
   }
 }
 
+TEST_CASE_METHOD(MergeTestController, "MergeContent can be triggered concurrently", "[testMergeFileConcurrentTriggers]") {
+  REQUIRE(context_->setProperty(minifi::processors::MergeContent::MergeFormat, std::string{minifi::processors::merge_content_options::MERGE_FORMAT_CONCAT_VALUE}));
+  REQUIRE(context_->setProperty(minifi::processors::MergeContent::MergeStrategy, std::string{minifi::processors::merge_content_options::MERGE_STRATEGY_BIN_PACK}));
+  REQUIRE(context_->setProperty(minifi::processors::MergeContent::DelimiterStrategy, std::string{minifi::processors::merge_content_options::DELIMITER_STRATEGY_TEXT}));
+  REQUIRE(context_->setProperty(minifi::processors::MergeContent::Demarcator, ","));
+  REQUIRE(context_->setProperty(minifi::processors::MergeContent::CorrelationAttributeName, "group"));
+  REQUIRE(context_->setProperty(minifi::processors::BinFiles::MinEntries, "4"));
+  REQUIRE(context_->setProperty(minifi::processors::BinFiles::MaxEntries, "4"));
+  REQUIRE(context_->setProperty(minifi::processors::BinFiles::MaxBinCount, "1000"));
+  REQUIRE(context_->setProperty(minifi::processors::BinFiles::BatchSize, "5"));
+  REQUIRE(context_->setProperty(minifi::processors::BinFiles::FlowFilePersistence, GENERATE("On Binning", "On Merge")));
+
+  constexpr size_t GROUP_COUNT = 100;
+  constexpr size_t FLOW_FILES_PER_GROUP = 4;
+  constexpr size_t THREAD_COUNT = 8;
+  core::ProcessSessionImpl sessionGenFlowFile(context_);
+  for (size_t i = 0; i < FLOW_FILES_PER_GROUP; ++i) {
+    for (size_t group = 0; group < GROUP_COUNT; ++group) {
+      const auto flow = sessionGenFlowFile.create();
+      sessionGenFlowFile.importFrom(minifi::io::BufferStream(std::to_string(group) + "-" + std::to_string(i)), flow);
+      flow->setAttribute("group", std::to_string(group));
+      sessionGenFlowFile.flushContent();
+      input_->put(flow);
+    }
+  }
+
+  auto factory = std::make_shared<core::ProcessSessionFactoryImpl>(context_);
+  merge_content_processor_->onSchedule(*context_, *factory);
+  const auto trigger = [this] {
+    auto session = std::make_shared<core::ProcessSessionImpl>(context_);
+    merge_content_processor_->onTrigger(*context_, *session);
+    session->commit();
+  };
+  std::vector<std::thread> threads;
+  for (size_t i = 0; i < THREAD_COUNT; ++i) {
+    threads.emplace_back([this, &trigger] {
+      while (!input_->isEmpty()) {
+        trigger();
+      }
+    });
+  }
+  for (auto& thread : threads) {
+    thread.join();
+  }
+  // the bins which became ready during the last triggers of the other threads
+  trigger();
+
+  std::set<std::string> merged_contents;
+  std::set<std::shared_ptr<core::FlowFile>> expiredFlowRecords;
+  while (const auto merged_flow = output_->poll(expiredFlowRecords)) {
+    FixedBuffer callback(gsl::narrow<size_t>(merged_flow->getSize()));
+    sessionGenFlowFile.read(merged_flow, std::ref(callback));
+    const auto contents = utils::string::split(callback.to_string(), ",");
+    REQUIRE(contents.size() == FLOW_FILES_PER_GROUP);
+    const auto group = contents[0].substr(0, contents[0].find('-'));
+    for (const auto& content : contents) {
+      CHECK(content.substr(0, content.find('-')) == group);
+      merged_contents.insert(content);
+    }
+  }
+  REQUIRE(expiredFlowRecords.empty());
+  CHECK(merged_contents.size() == GROUP_COUNT * FLOW_FILES_PER_GROUP);
+}
+
 TEST_CASE_METHOD(MergeTestController, "Maximum Group Size is respected", "[testMergeFileMaximumGroupSize]") {
   // each flowfile content is 32 bytes
   for (auto& ff : flowFileContents_) {
@@ -924,3 +993,49 @@ TEST_CASE("Empty MergeContent doesnt yield when processing readybins") {
   auto second_trigger_results = controller.trigger();
   CHECK_FALSE(merge_content->isYield());
 }
+
+TEST_CASE("MergeContent bins the flow files of many correlation groups separately") {
+  using minifi::processors::MergeContent;
+  minifi::test::SingleProcessorTestController controller{minifi::test::utils::make_processor<MergeContent>("mergeContent")};
+  const auto merge_content = controller.getProcessor();
+  REQUIRE(controller.plan->setProperty(merge_content, MergeContent::CorrelationAttributeName, "device.id"));
+  REQUIRE(controller.plan->setProperty(merge_content, MergeContent::MinEntries, "2"));
+  REQUIRE(controller.plan->setProperty(merge_content, MergeContent::MaxBinCount, "1000"));
+  REQUIRE(controller.plan->setProperty(merge_content, MergeContent::BatchSize, "1000"));
+  REQUIRE(controller.plan->setProperty(merge_content, MergeContent::MaxBinAge, "200ms"));
+
+  constexpr size_t PAIRED_DEVICE_COUNT = 400;
+  constexpr size_t SINGLE_DEVICE_COUNT = 100;
+  std::vector<std::string> contents;
+  std::vector<std::string> device_ids;
+  for (size_t i = 0; i < 2 * PAIRED_DEVICE_COUNT; ++i) {
+    contents.push_back(std::to_string(i) + ",");
+    device_ids.push_back("paired-" + std::to_string(i % PAIRED_DEVICE_COUNT));
+  }
+  for (size_t i = 0; i < SINGLE_DEVICE_COUNT; ++i) {
+    contents.push_back("single-" + std::to_string(i));
+    device_ids.push_back("single-" + std::to_string(i));
+  }
+  std::vector<minifi::test::InputFlowFileData> input;
+  for (size_t i = 0; i < contents.size(); ++i) {
+    input.push_back({.content = contents[i], .attributes = {{"device.id", device_ids[i]}}});
+  }
+
+  const auto get_merged_contents = [&](const minifi::test::ProcessorTriggerResult& result) {
+    std::set<std::string> merged_contents;
+    for (const auto& flow_file : result.at(MergeContent::Merge)) {
+      merged_contents.insert(controller.plan->getContent(flow_file));
+    }
+    return merged_contents;
+  };
+
+  std::set<std::string> expected_pairs;
+  for (size_t i = 0; i < PAIRED_DEVICE_COUNT; ++i) {
+    expected_pairs.insert(contents[i] + contents[i + PAIRED_DEVICE_COUNT]);
+  }
+  CHECK(get_merged_contents(controller.trigger(std::move(input))) == expected_pairs);
+
+  // the bins of the single flow files are only merged once they are older than the Max Bin Age
+  std::this_thread::sleep_for(250ms);
+  CHECK(get_merged_contents(controller.trigger()) == std::set<std::string>(contents.end() - SINGLE_DEVICE_COUNT, contents.end()));
+}
@@ -0,0 +1,41 @@
+/**
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The ASF licenses this file to You under the Apache License, Version 2.0
+ * (the "License"); you may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "RocksDbStateManager.h"
+
+#include "RocksDbStateStorage.h"
+
+namespace org::apache::nifi::minifi::controllers {
+
+RocksDbStateManager::RocksDbStateManager(const utils::Identifier& id, gsl::not_null<RocksDbStateStorage*> storage)
+    : KeyValueStateManager(id, storage),
+      storage_(storage) {
+}
+
+std::optional<core::StateManager::State> RocksDbStateManager::readState() {
+  return storage_->readStateRecords(id_);
+}
+
+bool RocksDbStateManager::writeState(const std::optional<core::StateManager::State>& previous_state, const core::StateManager::State& state) {
+  return storage_->writeStateRecords(id_, previous_state ? &*previous_state : nullptr, state);
+}
+
+bool RocksDbStateManager::removeState() {
+  return storage_->removeStateRecords(id_);
+}
+
+}  // namespace org::apache::nifi::minifi::controllers
@@ -0,0 +1,46 @@
+/**
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The ASF licenses this file to You under the Apache License, Version 2.0
+ * (the "License"); you may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <optional>
+
+#include "controllers/keyvalue/KeyValueStateManager.h"
+#include "minifi-cpp/utils/gsl.h"
+
+namespace org::apache::nifi::minifi::controllers {
+
+class RocksDbStateStorage;
+
+/**
+ * State manager of RocksDbStateStorage with Store Keys Separately enabled. The state is read from the separate records of its keys,
+ * and a commit only writes the keys which were added, changed or removed since the last commit.
+ */
+class RocksDbStateManager final : public KeyValueStateManager {
+ public:
+  RocksDbStateManager(const utils::Identifier& id, gsl::not_null<RocksDbStateStorage*> storage);
+
+ protected:
+  std::optional<core::StateManager::State> readState() override;
+  bool writeState(const std::optional<core::StateManager::State>& previous_state, const core::StateManager::State& state) override;
+  bool removeState() override;
+
+ private:
+  gsl::not_null<RocksDbStateStorage*> storage_;
+};
+
+}  // namespace org::apache::nifi::minifi::controllers
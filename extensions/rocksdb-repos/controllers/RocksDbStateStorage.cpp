@@ -19,15 +19,36 @@
 
 #include <cinttypes>
 #include <fstream>
+#include <memory>
+#include <string_view>
 #include <utility>
+#include <vector>
 
 #include "../encryption/RocksDbEncryptionProvider.h"
+#include "RocksDbStateManager.h"
 #include "core/Resource.h"
 #include "utils/Locations.h"
 #include "utils/StringUtils.h"
 
 namespace org::apache::nifi::minifi::controllers {
 
+namespace {
+// With Store Keys Separately, every key of the state of a component is stored as "<component uuid>/<key>", and the existence of the state
+// is marked by the "<component uuid>#" record, so that an empty state can be told apart from a missing one.
+// Otherwise the whole state is serialized into the "<component uuid>" record.
+constexpr char STATE_KEY_SEPARATOR = '/';
+constexpr char STATE_MARKER_SUFFIX = '#';
+constexpr size_t UUID_STRING_LENGTH = 36;
+
+std::string stateKeyPrefix(const utils::Identifier& component_id) {
+  return std::string{component_id.to_string()} + STATE_KEY_SEPARATOR;
+}
+
+std::string stateMarkerKey(const utils::Identifier& component_id) {
+  return std::string{component_id.to_string()} + STATE_MARKER_SUFFIX;
+}
+}  // namespace
+
 RocksDbStateStorage::~RocksDbStateStorage() {
   auto_persistor_.stop();
 }
@@ -54,6 +75,11 @@ void RocksDbStateStorage::onEnable() {
 
   directory_ = getProperty(Directory.name) | utils::orThrow("RocksDbStateStorage::Directory is required property");
 
+  store_keys_separately_ = getProperty(StoreKeysSeparately.name)
+      | utils::andThen(parsing::parseBool)
+      | utils::orThrow("RocksDbStateStorage::StoreKeysSeparately is a required Property");
+  logger_->log_info("Store Keys Separately property: {}", store_keys_separately_);
+
   auto_persistor_.start(always_persist, auto_persistence_interval, [this] { return persistNonVirtual(); });
   db_.reset();
 
@@ -95,6 +121,10 @@ void RocksDbStateStorage::onEnable() {
 
   verify_checksums_in_rocksdb_reads_ = (configuration_->get(Configure::nifi_rocksdb_state_storage_read_verify_checksums) | utils::andThen(&utils::string::toBool)).value_or(false);
 
+  if (!store_keys_separately_ && !convertStateRecordsToSingleRecords()) {
+    logger_->log_error("Failed to convert the states stored as separate records in RocksDB database at {}, they are not available until Store Keys Separately is enabled again", directory_);
+  }
+
   logger_->log_trace("Enabled RocksDbStateStorage");
 }
 
@@ -229,6 +259,204 @@ bool RocksDbStateStorage::persistNonVirtual() {
   return opendb->FlushWAL(true /*sync*/).ok();
 }
 
+std::unique_ptr<core::StateManager> RocksDbStateStorage::createStateManager(const utils::Identifier& uuid) {
+  if (!store_keys_separately_) {
+    return KeyValueStateStorage::createStateManager(uuid);
+  }
+  return std::make_unique<RocksDbStateManager>(uuid, gsl::make_not_null(this));
+}
+
+std::unordered_map<utils::Identifier, core::StateManager::State> RocksDbStateStorage::getAllStates() {
+  if (!store_keys_separately_) {
+    return KeyValueStateStorage::getAllStates();
+  }
+  std::unordered_map<std::string, std::string> records;
+  if (!get(records)) {
+    return {};
+  }
+  std::unordered_map<utils::Identifier, core::StateManager::State> states;
+  for (auto& [key, value] : records) {
+    const auto component_id = utils::Identifier::parse(std::string_view(key).substr(0, UUID_STRING_LENGTH));
+    if (!component_id) {
+      logger_->log_error("Found non-UUID key \"{}\" in storage implementation", key);
+      continue;
+    }
+    if (key.size() == UUID_STRING_LENGTH) {
+      // not converted yet, it is stored as a single record
+      states.emplace(*component_id, deserialize(value));
+    } else if (key[UUID_STRING_LENGTH] == STATE_KEY_SEPARATOR) {
+      states[*component_id].emplace(key.substr(UUID_STRING_LENGTH + 1), std::move(value));
+    } else if (key[UUID_STRING_LENGTH] == STATE_MARKER_SUFFIX && key.size() == UUID_STRING_LENGTH + 1) {
+      states.try_emplace(*component_id);
+    } else {
+      logger_->log_error("Found unexpected key \"{}\" in storage implementation", key);
+    }
+  }
+  return states;
+}
+
+std::optional<core::StateManager::State> RocksDbStateStorage::readStateRecords(const utils::Identifier& component_id) {
+  std::string value;
+  if (!get(stateMarkerKey(component_id), value)) {
+    // the state may have been stored as a single record before Store Keys Separately was enabled, it is converted on the first read
+    if (!get(std::string{component_id.to_string()}, value)) {
+      return std::nullopt;
+    }
+    auto state = deserialize(value);
+    if (!writeStateRecords(component_id, nullptr, state)) {
+      logger_->log_warn("Failed to convert the state of component {} to separate records", component_id.to_string());
+    }
+    return state;
+  }
+
+  if (!db_) {
+    return std::nullopt;
+  }
+  auto opendb = db_->open();
+  if (!opendb) {
+    return std::nullopt;
+  }
+  const auto prefix = stateKeyPrefix(component_id);
+  rocksdb::ReadOptions options;
+  options.verify_checksums = verify_checksums_in_rocksdb_reads_;
+  auto it = opendb->NewIterator(options);
+  core::StateManager::State state;
+  for (it->Seek(prefix); it->Valid() && it->key().starts_with(prefix); it->Next()) {
+    auto key = it->key();
+    key.remove_prefix(prefix.size());
+    state.emplace(key.ToString(), it->value().ToString());
+  }
+  if (!it->status().ok()) {
+    logger_->log_error("Encountered error when reading the state of component {} from RocksDB database at {}, error: {}", component_id.to_string(), directory_, it->status().getState());
+    return std::nullopt;
+  }
+  return state;
+}
+
+bool RocksDbStateStorage::writeStateRecords(const utils::Identifier& component_id, const core::StateManager::State* previous_state, const core::StateManager::State& state) {
+  if (!db_) {
+    return false;
+  }
+  auto opendb = db_->open();
+  if (!opendb) {
+    return false;
+  }
+  const auto prefix = stateKeyPrefix(component_id);
+  auto batch = opendb->createWriteBatch();
+  size_t written_count = 0;
+  if (previous_state) {
+    for (const auto& [key, value] : *previous_state) {
+      if (!state.contains(key)) {
+        batch.Delete(prefix + key);
+        ++written_count;
+      }
+    }
+  } else {
+    batch.Put(stateMarkerKey(component_id), "");
+    batch.Delete(std::string{component_id.to_string()});
+  }
+  for (const auto& [key, value] : state) {
+    if (previous_state) {
+      if (const auto previous_it = previous_state->find(key); previous_it != previous_state->end() && previous_it->second == value) {
+        continue;
+      }
+    }
+    batch.Put(prefix + key, value);
+    ++written_count;
+  }
+  rocksdb::Status status = opendb->Write(default_write_options, &batch);
+  if (!status.ok()) {
+    logger_->log_error("Failed to write the state of component {} to RocksDB database at {}, error: {}", component_id.to_string(), directory_, status.getState());
+    return false;
+  }
+  logger_->log_trace("Wrote {} changed keys of the state of component {}", written_count, component_id.to_string());
+  return true;
+}
+
+bool RocksDbStateStorage::removeStateRecords(const utils::Identifier& component_id) {
+  if (!db_) {
+    return false;
+  }
+  auto opendb = db_->open();
+  if (!opendb) {
+    return false;
+  }
+  const auto prefix = stateKeyPrefix(component_id);
+  auto batch = opendb->createWriteBatch();
+  rocksdb::ReadOptions options;
+  options.verify_checksums = verify_checksums_in_rocksdb_reads_;
+  auto it = opendb->NewIterator(options);
+  for (it->Seek(prefix); it->Valid() && it->key().starts_with(prefix); it->Next()) {
+    batch.Delete(it->key());
+  }
+  if (!it->status().ok()) {
+    logger_->log_error("Encountered error when iterating through RocksDB database at {}, error: {}", directory_, it->status().getState());
+    return false;
+  }
+  batch.Delete(stateMarkerKey(component_id));
+  batch.Delete(std::string{component_id.to_string()});
+  rocksdb::Status status = opendb->Write(default_write_options, &batch);
+  if (!status.ok()) {
+    logger_->log_error("Failed to remove the state of component {} from RocksDB database at {}, error: {}", component_id.to_string(), directory_, status.getState());
+    return false;
+  }
+  return true;
+}
+
+bool RocksDbStateStorage::convertStateRecordsToSingleRecords() {
+  if (!db_) {
+    return false;
+  }
+  auto opendb = db_->open();
+  if (!opendb) {
+    return false;
+  }
+  rocksdb::ReadOptions options;
+  options.verify_checksums = verify_checksums_in_rocksdb_reads_;
+  std::vector<utils::Identifier> component_ids;
+  {
+    auto it = opendb->NewIterator(options);
+    for (it->SeekToFirst(); it->Valid(); it->Next()) {
+      const auto key = it->key();
+      if (key.size() == UUID_STRING_LENGTH + 1 && key[UUID_STRING_LENGTH] == STATE_MARKER_SUFFIX) {
+        if (const auto component_id = utils::Identifier::parse(std::string_view(key.data(), UUID_STRING_LENGTH))) {
+          component_ids.push_back(*component_id);
+        }
+      }
+    }
+    if (!it->status().ok()) {
+      logger_->log_error("Encountered error when iterating through RocksDB database at {}, error: {}", directory_, it->status().getState());
+      return false;
+    }
+  }
+
+  for (const auto& component_id : component_ids) {
+    const auto state = readStateRecords(component_id);
+    if (!state) {
+      return false;
+    }
+    const auto prefix = stateKeyPrefix(component_id);
+    auto batch = opendb->createWriteBatch();
+    batch.Put(std::string{component_id.to_string()}, serialize(*state));
+    auto it = opendb->NewIterator(options);
+    for (it->Seek(prefix); it->Valid() && it->key().starts_with(prefix); it->Next()) {
+      batch.Delete(it->key());
+    }
+    if (!it->status().ok()) {
+      logger_->log_error("Encountered error when iterating through RocksDB database at {}, error: {}", directory_, it->status().getState());
+      return false;
+    }
+    batch.Delete(stateMarkerKey(component_id));
+    rocksdb::Status status = opendb->Write(default_write_options, &batch);
+    if (!status.ok()) {
+      logger_->log_error("Failed to convert the state of component {} in RocksDB database at {}, error: {}", component_id.to_string(), directory_, status.getState());
+      return false;
+    }
+    logger_->log_info("Converted the state of component {} from separate records to a single record", component_id.to_string());
+  }
+  return true;
+}
+
 REGISTER_RESOURCE_AS(RocksDbStateStorage, ControllerService, ("RocksDbPersistableKeyValueStoreService", "rocksdbpersistablekeyvaluestoreservice", "RocksDbStateStorage"));
 
 }  // namespace org::apache::nifi::minifi::controllers
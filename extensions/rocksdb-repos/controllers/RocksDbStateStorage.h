@@ -16,9 +16,10 @@
  */
 #pragma once
 
-#include <unordered_map>
-#include <string>
 #include <memory>
+#include <optional>
+#include <string>
+#include <unordered_map>
 
 #include "utils/AutoPersistor.h"
 #include "controllers/keyvalue/KeyValueStateStorage.h"
@@ -61,10 +62,20 @@ class RocksDbStateStorage : public KeyValueStateStorage {
       .withDescription("Path to a directory for the database")
       .isRequired(true)
       .build();
+  EXTENSIONAPI static constexpr auto StoreKeysSeparately = core::PropertyDefinitionBuilder<>::createProperty("Store Keys Separately")
+      .withDescription("Store every key of the state of a component as a separate record, so that a state change only writes the keys that changed, "
+          "instead of serializing the whole state of the component into a single record. Recommended for components with large states, like the listing processors. "
+          "The states stored as a single record are converted when they are first read. "
+          "If it is disabled again, the states stored as separate records are converted back to single records when the service is enabled.")
+      .isRequired(true)
+      .withValidator(core::StandardPropertyValidators::BOOLEAN_VALIDATOR)
+      .withDefaultValue("false")
+      .build();
   EXTENSIONAPI static constexpr auto Properties = std::to_array<core::PropertyReference>({
       AlwaysPersist,
       AutoPersistenceInterval,
-      Directory
+      Directory,
+      StoreKeysSeparately
   });
 
 
@@ -85,15 +96,28 @@ class RocksDbStateStorage : public KeyValueStateStorage {
     return persistNonVirtual();
   }
 
+  using KeyValueStateStorage::createStateManager;
+  std::unique_ptr<core::StateManager> createStateManager(const utils::Identifier& uuid) override;
+  std::unordered_map<utils::Identifier, core::StateManager::State> getAllStates() override;
+
+  // the state of a component stored as one record per key, used by RocksDbStateManager
+  std::optional<core::StateManager::State> readStateRecords(const utils::Identifier& component_id);
+  // writes the keys of state which are not in previous_state with the same value, and removes the ones missing from state, in a single write batch
+  bool writeStateRecords(const utils::Identifier& component_id, const core::StateManager::State* previous_state, const core::StateManager::State& state);
+  bool removeStateRecords(const utils::Identifier& component_id);
+
  private:
   // non-virtual to allow calling on AutoPersistor's thread during destruction
   bool persistNonVirtual();
+  // used when Store Keys Separately is disabled, so that the states written while it was enabled are not lost
+  bool convertStateRecordsToSingleRecords();
 
   std::string directory_;
   std::unique_ptr<minifi::internal::RocksDatabase> db_;
   rocksdb::WriteOptions default_write_options;
   AutoPersistor auto_persistor_;
   bool verify_checksums_in_rocksdb_reads_ = false;
+  bool store_keys_separately_ = false;
 };
 
 }  // namespace org::apache::nifi::minifi::controllers
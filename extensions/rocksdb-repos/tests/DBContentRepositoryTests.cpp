@@ -313,6 +313,11 @@ TEST_CASE("ProcessSession::append should append to the flowfile and set its size
   ContentRepositoryDependentTests::testAppendToManagedFlowFile(std::make_shared<core::repository::DatabaseContentRepository>());
 }
 
+TEST_CASE("ProcessSession::append does not change the other flowfiles sharing the content of a clone (RocksDB)", "[appendclone]") {
+  const bool commit_original = GENERATE(false, true);
+  ContentRepositoryDependentTests::testAppendToClonedFlowFiles(std::make_shared<core::repository::DatabaseContentRepository>(), commit_original);
+}
+
 TEST_CASE("ProcessSession::read can read zero length flowfiles without crash (RocksDB)", "[zerolengthread]") {
   ContentRepositoryDependentTests::testReadFromZeroLengthFlowFile(std::make_shared<core::repository::DatabaseContentRepository>());
 }
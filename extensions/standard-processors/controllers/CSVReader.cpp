@@ -0,0 +1,405 @@
+/**
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The ASF licenses this file to You under the Apache License, Version 2.0
+ * (the "License"); you may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "CSVReader.h"
+
+#include <algorithm>
+#include <cctype>
+#include <cmath>
+#include <memory>
+#include <span>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "core/Resource.h"
+#include "minifi-cpp/Exception.h"
+#include "utils/ByteScanner.h"
+#include "utils/ParsingUtils.h"
+#include "utils/TimeUtil.h"
+#include "../utils/CsvUtils.h"
+
+namespace org::apache::nifi::minifi::standard {
+
+namespace {
+bool looksLikeNumber(std::string_view value) {
+  const auto is_digit = [](char c) { return std::isdigit(static_cast<unsigned char>(c)) != 0; };
+  return !value.empty() && (is_digit(value.front()) || value.front() == '-' || value.front() == '.') && is_digit(value.back());
+}
+
+bool looksLikeTimestamp(std::string_view value) {
+  return value.size() == 20 && value[4] == '-' && value[10] == 'T' && value.back() == 'Z';
+}
+
+core::RecordField inferRecordField(std::string_view value) {
+  if (value == "true" || value == "false") {
+    return core::RecordField(value == "true");
+  }
+  if (looksLikeNumber(value)) {
+    if (const auto int_value = parsing::parseIntegral<int64_t>(value)) {
+      return core::RecordField(*int_value);
+    }
+    if (const auto uint_value = parsing::parseIntegral<uint64_t>(value)) {
+      return core::RecordField(*uint_value);
+    }
+    if (const auto double_value = parsing::parseFloatingPoint<double>(value); double_value && std::isfinite(*double_value)) {
+      return core::RecordField(*double_value);
+    }
+  }
+  if (looksLikeTimestamp(value)) {
+    if (const auto time_point = utils::timeutils::parseDateTimeStr(std::string(value))) {
+      return core::RecordField(std::chrono::system_clock::time_point(*time_point));
+    }
+  }
+  return core::RecordField(std::string(value));
+}
+
+std::string withOptional(std::string bytes, std::optional<char> c) {
+  if (c) {
+    bytes.push_back(*c);
+  }
+  return bytes;
+}
+}  // namespace
+
+void CSVReader::onEnable() {
+  auto parseCharacterProperty = [this](std::string_view property_name) -> char {
+    const auto property_value = getProperty(property_name).value_or("");
+    if (const auto c = utils::csv::parseCharacter(property_value)) {
+      return *c;
+    }
+    throw Exception(PROCESS_SCHEDULE_EXCEPTION, fmt::format("Invalid value for {} property: {}", property_name, property_value));
+  };
+  auto parseBoolProperty = [this](std::string_view property_name) -> bool {
+    const auto property_value = getProperty(property_name).value_or("");
+    if (const auto value = parsing::parseBool(property_value)) {
+      return *value;
+    }
+    throw Exception(PROCESS_SCHEDULE_EXCEPTION, fmt::format("Invalid value for {} property: {}", property_name, property_value));
+  };
+
+  value_separator_ = parseCharacterProperty(ValueSeparator.name);
+  quote_character_ = parseCharacterProperty(QuoteCharacter.name);
+  if (quote_character_ == value_separator_) {
+    throw Exception(PROCESS_SCHEDULE_EXCEPTION, "Quote Character must be different from Value Separator");
+  }
+  escape_character_.reset();
+  if (!getProperty(EscapeCharacter.name).value_or("").empty()) {
+    const auto escape_character = parseCharacterProperty(EscapeCharacter.name);
+    if (escape_character == value_separator_) {
+      throw Exception(PROCESS_SCHEDULE_EXCEPTION, "Escape Character must be different from Value Separator");
+    }
+    // a doubled quote character is always an escaped quote character
+    if (escape_character != quote_character_) {
+      escape_character_ = escape_character;
+    }
+  }
+  treat_first_line_as_header_ = parseBoolProperty(TreatFirstLineAsHeader.name);
+  trim_fields_ = parseBoolProperty(TrimFields.name);
+}
+
+/**
+ * The content is read in chunks, the rows are located in the buffer with a vectorized scan for the line breaks and the quote and escape characters.
+ * The values are parsed in place, only the values containing escaped characters are copied before they are converted to record fields.
+ */
+class CSVReader::CsvRecordReader final : public core::RecordReader {
+ public:
+  CsvRecordReader(const CSVReader& csv_reader, io::InputStream& input_stream)
+      : csv_reader_(csv_reader),
+        input_stream_(input_stream),
+        row_scanner_(withOptional({'\n', csv_reader.quote_character_}, csv_reader.escape_character_)),
+        unquoted_value_scanner_(withOptional({csv_reader.value_separator_}, csv_reader.escape_character_)),
+        quoted_value_scanner_(withOptional({csv_reader.quote_character_}, csv_reader.escape_character_)) {
+  }
+
+  std::expected<std::optional<core::Record>, std::error_code> next() override {
+    if (done_) {
+      return std::nullopt;
+    }
+    auto record = nextRecord();
+    if (!record || !*record) {
+      done_ = true;
+    }
+    return record;
+  }
+
+ private:
+  static constexpr size_t CHUNK_SIZE = 64 * 1024;
+
+  std::expected<std::optional<core::Record>, std::error_code> nextRecord() {
+    while (true) {
+      const auto row = nextRow();
+      if (!row) {
+        return std::unexpected{row.error()};
+      }
+      if (!*row) {
+        return std::nullopt;
+      }
+      if ((*row)->empty()) {
+        continue;
+      }
+      if (csv_reader_.treat_first_line_as_header_ && !header_read_) {
+        header_read_ = true;
+        const bool parsed = parseRow(**row, [this](size_t, std::string_view value, bool) {
+          header_.emplace_back(value);
+        });
+        if (!parsed) {
+          return std::unexpected{std::make_error_code(std::errc::invalid_argument)};
+        }
+        continue;
+      }
+      core::Record record;
+      const bool parsed = parseRow(**row, [this, &record](size_t index, std::string_view value, bool quoted) {
+        if (!value.empty()) {
+          record.emplace(getFieldName(index), quoted ? core::RecordField(std::string(value)) : inferRecordField(value));
+        }
+      });
+      if (!parsed) {
+        return std::unexpected{std::make_error_code(std::errc::invalid_argument)};
+      }
+      return record;
+    }
+  }
+
+  [[nodiscard]] std::string getFieldName(size_t index) const {
+    if (index < header_.size() && !header_[index].empty()) {
+      return header_[index];
+    }
+    return fmt::format("column_{}", index);
+  }
+
+  // returns the next row without its line break, the row points into the buffer and is valid until the next call
+  std::expected<std::optional<std::string_view>, std::error_code> nextRow() {
+    discardConsumed();
+    size_t scan_position = position_;
+    bool in_quotes = false;
+    size_t closing_quote = std::string_view::npos;
+    while (true) {
+      const auto found = row_scanner_.find(buffer_, scan_position);
+      if (found == std::string_view::npos) {
+        const auto read_size = readChunk();
+        if (!read_size) {
+          return std::unexpected{read_size.error()};
+        }
+        if (*read_size > 0) {
+          continue;
+        }
+        if (in_quotes) {
+          return std::unexpected{std::make_error_code(std::errc::invalid_argument)};
+        }
+        if (position_ == buffer_.size()) {
+          return std::nullopt;
+        }
+        return takeRow(buffer_.size(), buffer_.size());
+      }
+      const char c = buffer_[found];
+      if (c == '\n') {
+        if (!in_quotes) {
+          return takeRow(found, found + 1);
+        }
+        scan_position = found + 1;
+      } else if (c == csv_reader_.quote_character_) {
+        if (in_quotes) {
+          in_quotes = false;
+          closing_quote = found;
+        } else if (found == closing_quote + 1 || isValueStart(found)) {
+          // a quote right after the closing quote is a doubled quote, which continues the quoted value
+          in_quotes = true;
+        }
+        scan_position = found + 1;
+      } else {
+        scan_position = found + 2;  // the escaped character is skipped, even if it is not read yet
+      }
+    }
+  }
+
+  // like in parseRow, a quote character only opens a quoted value if it is the first non-blank character of the value
+  [[nodiscard]] bool isValueStart(size_t quote_position) const {
+    size_t position = quote_position;
+    while (position > position_ && csv_reader_.trim_fields_ && isBlank(buffer_[position - 1])) {
+      --position;
+    }
+    if (position == position_) {
+      return true;
+    }
+    if (buffer_[position - 1] != csv_reader_.value_separator_) {
+      return false;
+    }
+    // the value separator does not end the previous value if it is escaped by an odd number of escape characters
+    size_t escape_count = 0;
+    while (csv_reader_.escape_character_ && position - 1 - escape_count > position_ && buffer_[position - 2 - escape_count] == *csv_reader_.escape_character_) {
+      ++escape_count;
+    }
+    return escape_count % 2 == 0;
+  }
+
+  std::string_view takeRow(size_t end, size_t next_position) {
+    auto row = std::string_view(buffer_).substr(position_, end - position_);
+    if (row.ends_with('\r')) {
+      row.remove_suffix(1);
+    }
+    position_ = next_position;
+    return row;
+  }
+
+  std::expected<size_t, std::error_code> readChunk() {
+    const auto old_size = buffer_.size();
+    buffer_.resize(old_size + CHUNK_SIZE);
+    const auto read_result = input_stream_.read(std::as_writable_bytes(std::span(buffer_).subspan(old_size)));
+    if (io::isError(read_result)) {
+      buffer_.resize(old_size);
+      return std::unexpected{std::make_error_code(std::errc::io_error)};
+    }
+    buffer_.resize(old_size + read_result);
+    return read_result;
+  }
+
+  void discardConsumed() {
+    // the consumed part is only erased if it is large, so that a buffer with many small rows is not shifted after each of them
+    if (position_ > 0 && position_ >= buffer_.size() / 2) {
+      buffer_.erase(0, position_);
+      position_ = 0;
+    }
+  }
+
+  /**
+   * Calls callback(index, value, quoted) for each value of the row, the value is only valid during the call.
+   * Returns false if a quoted value is not closed or it is followed by something other than the value separator.
+   */
+  template<typename Callback>
+  bool parseRow(std::string_view row, Callback&& callback) {
+    size_t position = 0;
+    for (size_t index = 0; ; ++index) {
+      position = skipBlanks(row, position);
+      std::string_view value;
+      const bool quoted = position < row.size() && row[position] == csv_reader_.quote_character_;
+      if (quoted) {
+        const auto end = parseQuotedValue(row, position + 1, value);
+        if (!end) {
+          return false;
+        }
+        position = skipBlanks(row, *end);
+        if (position < row.size() && row[position] != csv_reader_.value_separator_) {
+          return false;
+        }
+      } else {
+        position = parseUnquotedValue(row, position, value);
+      }
+      callback(index, value, quoted);
+      if (position >= row.size()) {
+        return true;
+      }
+      ++position;  // the value separator
+    }
+  }
+
+  // returns the position of the value separator ending the value, or the end of the row
+  size_t parseUnquotedValue(std::string_view row, size_t position, std::string_view& value) {
+    size_t start = position;
+    bool copied = false;
+    scratch_.clear();
+    while (true) {
+      const auto found = unquoted_value_scanner_.find(row, position);
+      if (found != std::string_view::npos && row[found] != csv_reader_.value_separator_) {
+        appendEscaped(row, start, found);
+        copied = true;
+        position = start = std::min(found + 2, row.size());
+        continue;
+      }
+      const auto end = found == std::string_view::npos ? row.size() : found;
+      if (copied) {
+        scratch_.append(row.substr(start, end - start));
+        value = scratch_;
+      } else {
+        value = row.substr(start, end - start);
+      }
+      while (csv_reader_.trim_fields_ && !value.empty() && isBlank(value.back())) {
+        value.remove_suffix(1);
+      }
+      return end;
+    }
+  }
+
+  // position is after the opening quote, returns the position after the closing quote
+  std::optional<size_t> parseQuotedValue(std::string_view row, size_t position, std::string_view& value) {
+    size_t start = position;
+    bool copied = false;
+    scratch_.clear();
+    while (true) {
+      const auto found = quoted_value_scanner_.find(row, position);
+      if (found == std::string_view::npos) {
+        return std::nullopt;
+      }
+      if (row[found] != csv_reader_.quote_character_) {
+        appendEscaped(row, start, found);
+        copied = true;
+        position = start = std::min(found + 2, row.size());
+      } else if (found + 1 < row.size() && row[found + 1] == csv_reader_.quote_character_) {
+        scratch_.append(row.substr(start, found + 1 - start));
+        copied = true;
+        position = start = found + 2;
+      } else {
+        if (copied) {
+          scratch_.append(row.substr(start, found - start));
+          value = scratch_;
+        } else {
+          value = row.substr(start, found - start);
+        }
+        return found + 1;
+      }
+    }
+  }
+
+  // appends the part of the value before the escape character at escape_position and the escaped character
+  void appendEscaped(std::string_view row, size_t start, size_t escape_position) {
+    scratch_.append(row.substr(start, escape_position - start));
+    if (escape_position + 1 < row.size()) {
+      scratch_.push_back(row[escape_position + 1]);
+    }
+  }
+
+  [[nodiscard]] bool isBlank(char c) const {
+    return (c == ' ' || c == '\t') && c != csv_reader_.value_separator_;
+  }
+
+  [[nodiscard]] size_t skipBlanks(std::string_view row, size_t position) const {
+    while (csv_reader_.trim_fields_ && position < row.size() && isBlank(row[position])) {
+      ++position;
+    }
+    return position;
+  }
+
+  const CSVReader& csv_reader_;
+  io::InputStream& input_stream_;
+  utils::ByteSetScanner row_scanner_;
+  utils::ByteSetScanner unquoted_value_scanner_;
+  utils::ByteSetScanner quoted_value_scanner_;
+  std::string buffer_;
+  size_t position_ = 0;
+  std::string scratch_;  // the unescaped value, if the value contains escaped characters
+  std::vector<std::string> header_;
+  bool header_read_ = false;
+  bool done_ = false;
+};
+
+std::unique_ptr<core::RecordReader> CSVReader::createRecordReader(io::InputStream& input_stream) {
+  return std::make_unique<CsvRecordReader>(*this, input_stream);
+}
+
+REGISTER_RESOURCE(CSVReader, ControllerService);
+
+}  // namespace org::apache::nifi::minifi::standard
@@ -0,0 +1,96 @@
+/**
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The ASF licenses this file to You under the Apache License, Version 2.0
+ * (the "License"); you may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#pragma once
+
+#include <memory>
+#include <optional>
+#include <string_view>
+
+#include "controllers/RecordSetReader.h"
+#include "core/PropertyDefinitionBuilder.h"
+
+namespace org::apache::nifi::minifi::standard {
+
+class CSVReader final : public core::RecordSetReaderImpl {
+ public:
+  using RecordSetReaderImpl::RecordSetReaderImpl;
+
+  CSVReader(CSVReader&&) = delete;
+  CSVReader(const CSVReader&) = delete;
+  CSVReader& operator=(CSVReader&&) = delete;
+  CSVReader& operator=(const CSVReader&) = delete;
+
+  ~CSVReader() override = default;
+
+  EXTENSIONAPI static constexpr const char* Description = "Parses CSV-formatted data, returning each row in the CSV file as a separate record. "
+      "The field names are taken from the header line, if \"Treat First Line as Header\" is set, otherwise the fields are named column_0, column_1, etc. "
+      "The types of the unquoted values are inferred: booleans, integers, floating point numbers and timestamps in the format 2023-03-16T12:32:45Z are recognized, "
+      "everything else, including the quoted values, is read as a string. Empty values are left out of the records.";
+
+  EXTENSIONAPI static constexpr auto ValueSeparator = core::PropertyDefinitionBuilder<>::createProperty("Value Separator")
+      .withDescription("The character used to separate the values of a row. Use \\t for the tab character.")
+      .isRequired(true)
+      .withDefaultValue(",")
+      .build();
+  EXTENSIONAPI static constexpr auto QuoteCharacter = core::PropertyDefinitionBuilder<>::createProperty("Quote Character")
+      .withDescription("The character used to quote values, so that they can contain the value separator, line breaks or the quote character itself, which is escaped by doubling it.")
+      .isRequired(true)
+      .withDefaultValue("\"")
+      .build();
+  EXTENSIONAPI static constexpr auto EscapeCharacter = core::PropertyDefinitionBuilder<>::createProperty("Escape Character")
+      .withDescription("The character used to escape the next character of a value, e.g. a value separator in an unquoted value. If it is empty, escaping is disabled.")
+      .withDefaultValue("\\")
+      .build();
+  EXTENSIONAPI static constexpr auto TreatFirstLineAsHeader = core::PropertyDefinitionBuilder<>::createProperty("Treat First Line as Header")
+      .withDescription("Specifies whether or not the first line of the content is a header line containing the names of the fields.")
+      .isRequired(true)
+      .withValidator(core::StandardPropertyValidators::BOOLEAN_VALIDATOR)
+      .withDefaultValue("false")
+      .build();
+  EXTENSIONAPI static constexpr auto TrimFields = core::PropertyDefinitionBuilder<>::createProperty("Trim Fields")
+      .withDescription("Whether or not the leading and trailing spaces and tabs of the unquoted values and around the quoted values are removed.")
+      .isRequired(true)
+      .withValidator(core::StandardPropertyValidators::BOOLEAN_VALIDATOR)
+      .withDefaultValue("true")
+      .build();
+
+  EXTENSIONAPI static constexpr auto Properties = std::to_array<core::PropertyReference>({
+    ValueSeparator, QuoteCharacter, EscapeCharacter, TreatFirstLineAsHeader, TrimFields
+  });
+
+  EXTENSIONAPI static constexpr bool SupportsDynamicProperties = false;
+  EXTENSIONAPI static constexpr auto ImplementsApis = std::array{ RecordSetReader::ProvidesApi };
+  ADD_COMMON_VIRTUAL_FUNCTIONS_FOR_CONTROLLER_SERVICES
+
+  std::unique_ptr<core::RecordReader> createRecordReader(io::InputStream& input_stream) override;
+
+  void initialize() override {
+    setSupportedProperties(Properties);
+  }
+  void onEnable() override;
+
+ private:
+  class CsvRecordReader;
+
+  char value_separator_ = ',';
+  char quote_character_ = '"';
+  std::optional<char> escape_character_ = '\\';
+  bool treat_first_line_as_header_ = false;
+  bool trim_fields_ = true;
+};
+
+}  // namespace org::apache::nifi::minifi::standard
@@ -0,0 +1,200 @@
+/**
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The ASF licenses this file to You under the Apache License, Version 2.0
+ * (the "License"); you may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "CSVRecordSetWriter.h"
+
+#include <algorithm>
+#include <memory>
+#include <span>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+#include "core/Resource.h"
+#include "minifi-cpp/Exception.h"
+#include "rapidjson/stringbuffer.h"
+#include "rapidjson/writer.h"
+#include "utils/ByteScanner.h"
+#include "utils/GeneralUtils.h"
+#include "utils/ProcessorConfigUtils.h"
+#include "utils/StringUtils.h"
+#include "utils/TimeUtil.h"
+#include "../utils/CsvUtils.h"
+
+namespace org::apache::nifi::minifi::standard {
+
+void CSVRecordSetWriter::onEnable() {
+  auto parseCharacterProperty = [this](std::string_view property_name) -> char {
+    const auto property_value = getProperty(property_name).value_or("");
+    if (const auto c = utils::csv::parseCharacter(property_value)) {
+      return *c;
+    }
+    throw Exception(PROCESS_SCHEDULE_EXCEPTION, fmt::format("Invalid value for {} property: {}", property_name, property_value));
+  };
+
+  value_separator_ = parseCharacterProperty(ValueSeparator.name);
+  quote_character_ = parseCharacterProperty(QuoteCharacter.name);
+  if (quote_character_ == value_separator_) {
+    throw Exception(PROCESS_SCHEDULE_EXCEPTION, "Quote Character must be different from Value Separator");
+  }
+  quote_mode_ = getProperty(QuoteMode.name) | utils::andThen(parsing::parseEnum<CsvQuoteMode>) | utils::orThrow("CSVRecordSetWriter::QuoteMode is required property");
+  record_separator_ = utils::csv::unescapeControlCharacters(getProperty(RecordSeparator.name).value_or(""));
+  if (record_separator_.empty()) {
+    throw Exception(PROCESS_SCHEDULE_EXCEPTION, "Record Separator property must be set");
+  }
+  include_header_line_ = getProperty(IncludeHeaderLine.name) | utils::andThen(parsing::parseBool) | utils::orThrow("Missing CSVRecordSetWriter::IncludeHeaderLine despite default value");
+}
+
+/**
+ * The columns are taken from the first record. The rows are formatted into a buffer, which is written to the output stream when it is full.
+ */
+class CSVRecordSetWriter::CsvRecordWriter final : public core::RecordWriter {
+ public:
+  CsvRecordWriter(const CSVRecordSetWriter& csv_writer, io::OutputStream& output_stream)
+      : csv_writer_(csv_writer),
+        output_stream_(output_stream),
+        special_characters_(std::string{csv_writer.value_separator_, csv_writer.quote_character_, '\n', '\r'}) {
+  }
+
+  std::expected<void, std::error_code> write(const core::Record& record) override {
+    if (!columns_set_) {
+      setColumns(record);
+      if (csv_writer_.include_header_line_) {
+        writeHeader();
+      }
+    }
+    std::ranges::fill(row_fields_, nullptr);
+    for (const auto& [name, field] : record) {
+      if (const auto it = column_indexes_.find(name); it != column_indexes_.end()) {
+        row_fields_[it->second] = &field;
+      }
+    }
+    for (size_t i = 0; i < row_fields_.size(); ++i) {
+      if (i > 0) {
+        buffer_.push_back(csv_writer_.value_separator_);
+      }
+      if (row_fields_[i]) {
+        appendField(*row_fields_[i]);
+      }
+    }
+    buffer_.append(csv_writer_.record_separator_);
+    if (buffer_.size() >= FLUSH_SIZE) {
+      return flush();
+    }
+    return {};
+  }
+
+  std::expected<void, std::error_code> finish() override {
+    return flush();
+  }
+
+ private:
+  static constexpr size_t FLUSH_SIZE = 64 * 1024;
+
+  void setColumns(const core::Record& record) {
+    for (const auto& [name, field] : record) {
+      columns_.push_back(name);
+    }
+    std::ranges::sort(columns_);
+    for (size_t i = 0; i < columns_.size(); ++i) {
+      column_indexes_.emplace(columns_[i], i);
+    }
+    row_fields_.resize(columns_.size());
+    columns_set_ = true;
+  }
+
+  void writeHeader() {
+    for (size_t i = 0; i < columns_.size(); ++i) {
+      if (i > 0) {
+        buffer_.push_back(csv_writer_.value_separator_);
+      }
+      appendValue(columns_[i], csv_writer_.quote_mode_ != CsvQuoteMode::Minimal);
+    }
+    buffer_.append(csv_writer_.record_separator_);
+  }
+
+  void appendField(const core::RecordField& field) {
+    const bool quote_all = csv_writer_.quote_mode_ == CsvQuoteMode::All;
+    const bool quote_non_numeric = quote_all || csv_writer_.quote_mode_ == CsvQuoteMode::NonNumeric;
+    std::visit(utils::overloaded {
+      [&](const std::string& str) { appendValue(str, quote_non_numeric); },
+      [&](int64_t i64) { appendValue(std::to_string(i64), quote_all); },
+      [&](uint64_t u64) { appendValue(std::to_string(u64), quote_all); },
+      [&](double d) { appendValue(fmt::format("{}", d), quote_all); },
+      [&](bool b) { appendValue(b ? "true" : "false", quote_non_numeric); },
+      [&](const std::chrono::system_clock::time_point& time_point) {
+        appendValue(utils::timeutils::getDateTimeStr(std::chrono::floor<std::chrono::seconds>(time_point)), quote_non_numeric);
+      },
+      [&](const auto&) {
+        // arrays and nested records
+        rapidjson::Document document;
+        const auto json_value = field.toJson(document.GetAllocator());
+        rapidjson::StringBuffer json_buffer;
+        rapidjson::Writer<rapidjson::StringBuffer> json_writer(json_buffer);
+        json_value.Accept(json_writer);
+        appendValue(std::string_view(json_buffer.GetString(), json_buffer.GetSize()), quote_non_numeric);
+      }
+    }, field.value_);
+  }
+
+  void appendValue(std::string_view value, bool quote) {
+    const auto special_character = special_characters_.find(value);
+    if (!quote && special_character == std::string_view::npos) {
+      buffer_.append(value);
+      return;
+    }
+    const char quote_character = csv_writer_.quote_character_;
+    buffer_.push_back(quote_character);
+    size_t start = 0;
+    for (auto position = value.find(quote_character); position != std::string_view::npos; position = value.find(quote_character, position + 1)) {
+      buffer_.append(value.substr(start, position + 1 - start));
+      buffer_.push_back(quote_character);
+      start = position + 1;
+    }
+    buffer_.append(value.substr(start));
+    buffer_.push_back(quote_character);
+  }
+
+  std::expected<void, std::error_code> flush() {
+    if (buffer_.empty()) {
+      return {};
+    }
+    const auto write_result = output_stream_.write(std::as_bytes(std::span(buffer_)));
+    buffer_.clear();
+    if (io::isError(write_result)) {
+      return std::unexpected{std::make_error_code(std::errc::io_error)};
+    }
+    return {};
+  }
+
+  const CSVRecordSetWriter& csv_writer_;
+  io::OutputStream& output_stream_;
+  utils::ByteSetScanner special_characters_;  // the values containing any of them are quoted
+  std::vector<std::string> columns_;
+  std::unordered_map<std::string, size_t, utils::string::transparent_string_hash, std::equal_to<>> column_indexes_;
+  std::vector<const core::RecordField*> row_fields_;
+  bool columns_set_ = false;
+  std::string buffer_;
+};
+
+std::unique_ptr<core::RecordWriter> CSVRecordSetWriter::createRecordWriter(io::OutputStream& output_stream) {
+  return std::make_unique<CsvRecordWriter>(*this, output_stream);
+}
+
+REGISTER_RESOURCE(CSVRecordSetWriter, ControllerService);
+
+}  // namespace org::apache::nifi::minifi::standard
@@ -0,0 +1,121 @@
+/**
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The ASF licenses this file to You under the Apache License, Version 2.0
+ * (the "License"); you may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#pragma once
+
+#include <memory>
+#include <string>
+
+#include "controllers/RecordSetWriter.h"
+#include "core/PropertyDefinitionBuilder.h"
+#include "utils/Enum.h"
+
+namespace org::apache::nifi::minifi::standard {
+enum class CsvQuoteMode {
+  Minimal,
+  All,
+  NonNumeric
+};
+}  // namespace org::apache::nifi::minifi::standard
+
+namespace magic_enum::customize {
+using CsvQuoteMode = org::apache::nifi::minifi::standard::CsvQuoteMode;
+
+template <>
+constexpr customize_t enum_name<CsvQuoteMode>(CsvQuoteMode value) noexcept {
+  switch (value) {
+    case CsvQuoteMode::Minimal:
+      return "Quote Minimal";
+    case CsvQuoteMode::All:
+      return "Quote All Values";
+    case CsvQuoteMode::NonNumeric:
+      return "Quote Non-Numeric Values";
+  }
+  return invalid_tag;
+}
+}  // namespace magic_enum::customize
+
+namespace org::apache::nifi::minifi::standard {
+
+class CSVRecordSetWriter final : public core::RecordSetWriterImpl {
+ public:
+  using RecordSetWriterImpl::RecordSetWriterImpl;
+
+  CSVRecordSetWriter(CSVRecordSetWriter&&) = delete;
+  CSVRecordSetWriter(const CSVRecordSetWriter&) = delete;
+  CSVRecordSetWriter& operator=(CSVRecordSetWriter&&) = delete;
+  CSVRecordSetWriter& operator=(const CSVRecordSetWriter&) = delete;
+
+  ~CSVRecordSetWriter() override = default;
+
+  EXTENSIONAPI static constexpr const char* Description = "Writes the contents of a RecordSet as CSV data, one row per record. "
+      "The columns are the fields of the first record in the alphabetical order of their names, the fields of the later records which are not among them are left out. "
+      "Arrays and nested records are written as JSON.";
+
+  EXTENSIONAPI static constexpr auto ValueSeparator = core::PropertyDefinitionBuilder<>::createProperty("Value Separator")
+      .withDescription("The character used to separate the values of a row. Use \\t for the tab character.")
+      .isRequired(true)
+      .withDefaultValue(",")
+      .build();
+  EXTENSIONAPI static constexpr auto QuoteCharacter = core::PropertyDefinitionBuilder<>::createProperty("Quote Character")
+      .withDescription("The character used to quote values. The quote characters in a quoted value are escaped by doubling them.")
+      .isRequired(true)
+      .withDefaultValue("\"")
+      .build();
+  EXTENSIONAPI static constexpr auto QuoteMode = core::PropertyDefinitionBuilder<magic_enum::enum_count<CsvQuoteMode>()>::createProperty("Quote Mode")
+      .withDescription("Specifies which values are quoted. With 'Quote Minimal', only the values containing the value separator, the quote character or a line break are quoted.")
+      .isRequired(true)
+      .withDefaultValue(magic_enum::enum_name(CsvQuoteMode::Minimal))
+      .withAllowedValues(magic_enum::enum_names<CsvQuoteMode>())
+      .build();
+  EXTENSIONAPI static constexpr auto RecordSeparator = core::PropertyDefinitionBuilder<>::createProperty("Record Separator")
+      .withDescription("Specifies the characters to use in order to separate the rows. The escape sequences \\n, \\r and \\t can be used.")
+      .isRequired(true)
+      .withDefaultValue("\\n")
+      .build();
+  EXTENSIONAPI static constexpr auto IncludeHeaderLine = core::PropertyDefinitionBuilder<>::createProperty("Include Header Line")
+      .withDescription("Specifies whether or not the CSV column names should be written out as the first line. Nothing is written if there are no records.")
+      .isRequired(true)
+      .withValidator(core::StandardPropertyValidators::BOOLEAN_VALIDATOR)
+      .withDefaultValue("true")
+      .build();
+
+  EXTENSIONAPI static constexpr auto Properties = std::to_array<core::PropertyReference>({
+    ValueSeparator, QuoteCharacter, QuoteMode, RecordSeparator, IncludeHeaderLine
+  });
+
+  EXTENSIONAPI static constexpr bool SupportsDynamicProperties = false;
+  EXTENSIONAPI static constexpr auto ImplementsApis = std::array{ RecordSetWriter::ProvidesApi };
+  ADD_COMMON_VIRTUAL_FUNCTIONS_FOR_CONTROLLER_SERVICES
+
+  std::unique_ptr<core::RecordWriter> createRecordWriter(io::OutputStream& output_stream) override;
+
+  void initialize() override {
+    setSupportedProperties(Properties);
+  }
+  void onEnable() override;
+
+ private:
+  class CsvRecordWriter;
+
+  char value_separator_ = ',';
+  char quote_character_ = '"';
+  CsvQuoteMode quote_mode_ = CsvQuoteMode::Minimal;
+  std::string record_separator_ = "\n";
+  bool include_header_line_ = true;
+};
+
+}  // namespace org::apache::nifi::minifi::standard
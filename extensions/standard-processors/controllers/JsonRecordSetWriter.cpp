@@ -17,56 +17,65 @@
 
 #include "JsonRecordSetWriter.h"
 
+#include <memory>
+
 #include <rapidjson/prettywriter.h>
 #include "core/Resource.h"
+#include "utils/GeneralUtils.h"
 #include "utils/ProcessorConfigUtils.h"
+#include "utils/TimeUtil.h"
+#include "../utils/JsonStreams.h"
 
 namespace org::apache::nifi::minifi::standard {
 
 namespace {
 
-template<typename RecordFieldType>
-rapidjson::Value toJson(const RecordFieldType& field, rapidjson::Document::AllocatorType&) {
-  return rapidjson::Value(field);
-};
-
-template<>
-rapidjson::Value toJson(const std::string& field, rapidjson::Document::AllocatorType& alloc) {
-  return {field.c_str(), gsl::narrow<rapidjson::SizeType>(field.length()), alloc};
+// the fields are emitted to the rapidjson writer directly, without building a document
+template<typename Handler, typename Fields>
+bool writeObject(Handler& handler, const Fields& fields);
+
+template<typename Handler>
+bool writeField(Handler& handler, const core::RecordField& field) {
+  return std::visit(utils::overloaded {
+    [&handler](const std::string& str) { return handler.String(str.data(), gsl::narrow<rapidjson::SizeType>(str.size()), true); },
+    [&handler](int64_t i64) { return handler.Int64(i64); },
+    [&handler](uint64_t u64) { return handler.Uint64(u64); },
+    [&handler](double d) { return handler.Double(d); },
+    [&handler](bool b) { return handler.Bool(b); },
+    [&handler](const std::chrono::system_clock::time_point& time_point) {
+      const auto str = utils::timeutils::getDateTimeStr(std::chrono::floor<std::chrono::seconds>(time_point));
+      return handler.String(str.data(), gsl::narrow<rapidjson::SizeType>(str.size()), true);
+    },
+    [&handler](const core::RecordArray& array) {
+      if (!handler.StartArray()) {
+        return false;
+      }
+      for (const auto& element : array) {
+        if (!writeField(handler, element)) {
+          return false;
+        }
+      }
+      return handler.EndArray(gsl::narrow<rapidjson::SizeType>(array.size()));
+    },
+    [&handler](const core::RecordObject& object) { return writeObject(handler, object); }
+  }, field.value_);
 }
 
-template<>
-rapidjson::Value toJson(const std::chrono::system_clock::time_point& field, rapidjson::Document::AllocatorType& alloc) {
-  const std::string serialized_time_point = utils::timeutils::getDateTimeStr(std::chrono::floor<std::chrono::seconds>(field));
-  return {serialized_time_point.c_str(), gsl::narrow<rapidjson::SizeType>(serialized_time_point.length()), alloc};
-}
-
-template<>
-rapidjson::Value toJson(const core::RecordArray& field, rapidjson::Document::AllocatorType&);
-
-template<>
-rapidjson::Value toJson(const core::RecordObject& field, rapidjson::Document::AllocatorType&);
-
-template<>
-rapidjson::Value toJson(const core::RecordArray& field, rapidjson::Document::AllocatorType& alloc) {
-  auto array_json = rapidjson::Value(rapidjson::kArrayType);
-  for (const auto& record : field) {
-    auto json_value = (std::visit([&alloc](auto&& f)-> rapidjson::Value{ return toJson(f, alloc); }, record.value_));
-    array_json.PushBack(json_value, alloc);
+template<typename Handler, typename Fields>
+bool writeObject(Handler& handler, const Fields& fields) {
+  if (!handler.StartObject()) {
+    return false;
   }
-  return array_json;
-}
-
-template<>
-rapidjson::Value toJson(const core::RecordObject& field, rapidjson::Document::AllocatorType& alloc) {
-  auto object_json = rapidjson::Value(rapidjson::kObjectType);
-  for (const auto& [record_name, record_value] : field) {
-    auto json_value = (std::visit([&alloc](auto&& f)-> rapidjson::Value{ return toJson(f, alloc); }, record_value.value_));
-    rapidjson::Value json_name(record_name.c_str(), gsl::narrow<rapidjson::SizeType>(record_name.length()), alloc);
-    object_json.AddMember(json_name, json_value, alloc);
+  rapidjson::SizeType member_count = 0;
+  for (const auto& [name, field] : fields) {
+    if (!handler.Key(name.data(), gsl::narrow<rapidjson::SizeType>(name.size()), true) || !writeField(handler, field)) {
+      return false;
+    }
+    ++member_count;
   }
-  return object_json;
+  return handler.EndObject(member_count);
 }
+
 }  // namespace
 
 void JsonRecordSetWriter::onEnable() {
@@ -74,64 +83,59 @@ void JsonRecordSetWriter::onEnable() {
   pretty_print_ = getProperty(PrettyPrint.name) | utils::andThen(parsing::parseBool) | utils::orThrow("Missing JsonRecordSetWriter::PrettyPrint despite default value");
 }
 
-void JsonRecordSetWriter::writePerLine(const core::RecordSet& record_set, const std::shared_ptr<core::FlowFile>& flow_file, core::ProcessSession& session) {
-  session.write(flow_file, [&record_set](const std::shared_ptr<io::OutputStream>& stream) -> io::IoResult {
-    int64_t write_result = 0;
-    for (const auto& record : record_set) {
-      auto doc = rapidjson::Document(rapidjson::kObjectType);
-      auto& allocator = doc.GetAllocator();
-      convertRecord(record, doc, allocator);
-      rapidjson::StringBuffer buffer;
-      rapidjson::Writer writer(buffer);
-      doc.Accept(writer);
-      const auto line = fmt::format("{}\n", buffer.GetString());
-      write_result += gsl::narrow<int64_t>(stream->write(std::as_bytes(std::span(line))));
+class JsonRecordSetWriter::JsonRecordWriter final : public core::RecordWriter {
+ public:
+  JsonRecordWriter(io::OutputStream& output_stream, OutputGroupingType output_grouping, bool pretty_print)
+      : sink_(output_stream),
+        output_grouping_(output_grouping),
+        pretty_print_(pretty_print && output_grouping == OutputGroupingType::ARRAY),
+        writer_(sink_),
+        pretty_writer_(sink_) {
+    if (output_grouping_ == OutputGroupingType::ARRAY) {
+      pretty_print_ ? pretty_writer_.StartArray() : writer_.StartArray();
     }
-    return io::IoResult::from(write_result);
-  });
-}
+  }
 
-void JsonRecordSetWriter::writeAsArray(const core::RecordSet& record_set, const std::shared_ptr<core::FlowFile>& flow_file, core::ProcessSession& session) const {
-  session.write(flow_file, [this, &record_set](const std::shared_ptr<io::OutputStream>& stream) -> io::IoResult {
-    auto doc = rapidjson::Document(rapidjson::kArrayType);
-    for (const auto& record : record_set) {
-      auto& allocator = doc.GetAllocator();
-      auto record_json = rapidjson::Value(rapidjson::kObjectType);
-      convertRecord(record, record_json, allocator);
-      doc.PushBack(std::move(record_json), allocator);
+  std::expected<void, std::error_code> write(const core::Record& record) override {
+    const bool written = pretty_print_ ? writeObject(pretty_writer_, record) : writeObject(writer_, record);
+    if (!written) {
+      return std::unexpected{std::make_error_code(std::errc::invalid_argument)};
     }
-    rapidjson::StringBuffer buffer;
-    if (pretty_print_) {
-      rapidjson::PrettyWriter pretty_writer(buffer);
-      doc.Accept(pretty_writer);
-    } else {
-      rapidjson::Writer writer(buffer);
-      doc.Accept(writer);
+    if (output_grouping_ == OutputGroupingType::ONE_LINE_PER_OBJECT) {
+      sink_.Put('\n');
+      writer_.Reset(sink_);
     }
-    auto output = fmt::format("{}", buffer.GetString());
-    return io::IoResult::from(stream->write(std::as_bytes(std::span(output))));
-  });
-}
+    return checkSink();
+  }
 
-void JsonRecordSetWriter::write(const core::RecordSet& record_set, const std::shared_ptr<core::FlowFile>& flow_file, core::ProcessSession& session) {
-  switch (output_grouping_) {
-    case OutputGroupingType::ARRAY:
-      writeAsArray(record_set, flow_file, session);
-      break;
-    case OutputGroupingType::ONE_LINE_PER_OBJECT:
-      writePerLine(record_set, flow_file, session);
-      break;
-    default:
-      throw std::invalid_argument(fmt::format("Invalid OutputGroupingType: {}", magic_enum::enum_underlying(output_grouping_)));
+  std::expected<void, std::error_code> finish() override {
+    if (output_grouping_ == OutputGroupingType::ARRAY) {
+      pretty_print_ ? pretty_writer_.EndArray() : writer_.EndArray();
+    }
+    sink_.Flush();
+    return checkSink();
   }
-}
 
-void JsonRecordSetWriter::convertRecord(const core::Record& record, rapidjson::Value& record_json, rapidjson::Document::AllocatorType& alloc) {
-  for (const auto& [field_name, field_val] : record) {
-    rapidjson::Value json_name(field_name.c_str(), gsl::narrow<rapidjson::SizeType>(field_name.length()), alloc);
-    rapidjson::Value json_value = (std::visit([&alloc](auto&& f)-> rapidjson::Value{ return toJson(f, alloc); }, field_val.value_));
-    record_json.AddMember(json_name, json_value, alloc);
+ private:
+  [[nodiscard]] std::expected<void, std::error_code> checkSink() const {
+    if (sink_.failed()) {
+      return std::unexpected{std::make_error_code(std::errc::io_error)};
+    }
+    return {};
+  }
+
+  utils::json::OutputStreamJsonSink sink_;
+  OutputGroupingType output_grouping_;
+  bool pretty_print_;
+  rapidjson::Writer<utils::json::OutputStreamJsonSink> writer_;
+  rapidjson::PrettyWriter<utils::json::OutputStreamJsonSink> pretty_writer_;
+};
+
+std::unique_ptr<core::RecordWriter> JsonRecordSetWriter::createRecordWriter(io::OutputStream& output_stream) {
+  if (output_grouping_ != OutputGroupingType::ARRAY && output_grouping_ != OutputGroupingType::ONE_LINE_PER_OBJECT) {
+    throw std::invalid_argument(fmt::format("Invalid OutputGroupingType: {}", magic_enum::enum_underlying(output_grouping_)));
   }
+  return std::make_unique<JsonRecordWriter>(output_stream, output_grouping_, pretty_print_);
 }
 
 REGISTER_RESOURCE(JsonRecordSetWriter, ControllerService);
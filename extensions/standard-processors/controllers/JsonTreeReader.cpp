@@ -17,134 +17,171 @@
 
 #include "JsonTreeReader.h"
 
-#include "core/Resource.h"
-#include "rapidjson/document.h"
+#include <limits>
+#include <memory>
+#include <optional>
+#include <string>
+#include <utility>
+#include <variant>
+#include <vector>
 
-#ifdef WIN32
-#pragma push_macro("GetObject")
-#undef GetObject  // windows.h #defines GetObject = GetObjectA or GetObjectW, which conflicts with rapidjson
-#endif
+#include "core/Resource.h"
+#include "rapidjson/reader.h"
+#include "../utils/JsonStreams.h"
 
 namespace org::apache::nifi::minifi::standard {
 
 namespace {
 
-std::expected<core::RecordField, std::error_code> parse(const rapidjson::Value& json_value) {
-  if (json_value.IsDouble()) {
-    return core::RecordField{json_value.GetDouble()};
-  }
-  if (json_value.IsBool()) {
-    return core::RecordField{json_value.GetBool()};
+/**
+ * rapidjson SAX handler building a core::Record from a JSON object while parsing, without a rapidjson document.
+ * Parsing fails on null values, as records cannot represent them, and on anything other than an object at the top level.
+ * If an object contains the same key more than once, the first value is kept.
+ */
+class RecordBuilder {
+ public:
+  bool Null() { return false; }
+  bool Bool(bool b) { return addValue(core::RecordField{b}); }
+  bool Int(int i) { return addValue(core::RecordField{int64_t{i}}); }
+  bool Uint(unsigned u) { return addValue(core::RecordField{int64_t{u}}); }
+  bool Int64(int64_t i64) { return addValue(core::RecordField{i64}); }
+  bool Uint64(uint64_t u64) {
+    if (u64 <= static_cast<uint64_t>(std::numeric_limits<int64_t>::max())) {
+      return addValue(core::RecordField{static_cast<int64_t>(u64)});
+    }
+    return addValue(core::RecordField{u64});
   }
-  if (json_value.IsInt64()) {
-    return core::RecordField{json_value.GetInt64()};
+  bool Double(double d) { return addValue(core::RecordField{d}); }
+  bool RawNumber(const char*, rapidjson::SizeType, bool) { return false; }
+  bool String(const char* str, rapidjson::SizeType length, bool) { return addValue(core::RecordField{std::string(str, length)}); }
+  bool StartObject() {
+    frames_.push_back(Frame{.container = core::RecordObject{}, .key = {}});
+    return true;
   }
-  if (json_value.IsString()) {
-    return core::RecordField{std::string{json_value.GetString(), json_value.GetStringLength()}};
+  bool Key(const char* str, rapidjson::SizeType length, bool) {
+    frames_.back().key.assign(str, length);
+    return true;
   }
-  if (json_value.IsArray()) {
-    core::RecordArray record_array;
-    for (const auto& element : json_value.GetArray()) {
-      auto element_field = parse(element);
-      if (!element_field)
-        return std::unexpected{element_field.error()};
-      record_array.push_back(std::move(*element_field));
+  bool EndObject(rapidjson::SizeType) {
+    auto object = std::get<core::RecordObject>(std::move(frames_.back().container));
+    frames_.pop_back();
+    if (frames_.empty()) {
+      result_ = core::Record{std::move(object)};
+      return true;
     }
-    return core::RecordField{std::move(record_array)};
+    return addValue(core::RecordField{std::move(object)});
   }
-  if (json_value.IsObject()) {
-    core::RecordObject record_object;
-    for (const auto& m : json_value.GetObject()) {
-      auto element_key = m.name.GetString();
-      auto element_field = parse(m.value);
-      if (!element_field)
-        return std::unexpected{element_field.error()};
-      record_object.emplace(element_key, std::move(*element_field));
+  bool StartArray() {
+    if (frames_.empty()) {
+      return false;
     }
-    // Workaround for GCC false positive -Wfree-nonheap-object https://gcc.gnu.org/bugzilla/show_bug.cgi?id=99098
-#if defined(__GNUC__) && !defined(__clang__)
-#pragma GCC diagnostic push
-#pragma GCC diagnostic ignored "-Wfree-nonheap-object"
-#endif
-    return core::RecordField{std::move(record_object)};
-#if defined(__GNUC__) && !defined(__clang__)
-#pragma GCC diagnostic pop
-#endif
+    frames_.push_back(Frame{.container = core::RecordArray{}, .key = {}});
+    return true;
+  }
+  bool EndArray(rapidjson::SizeType) {
+    auto array = std::get<core::RecordArray>(std::move(frames_.back().container));
+    frames_.pop_back();
+    return addValue(core::RecordField{std::move(array)});
   }
 
-  return std::unexpected{std::make_error_code(std::errc::invalid_argument)};
-}
+  // returns the record built from the last parsed object
+  std::optional<core::Record> release() { return std::exchange(result_, std::nullopt); }
 
-std::expected<core::Record, std::error_code> parseRecord(rapidjson::Value& record_json) {
-  core::Record result;
-  if (!record_json.IsObject()) {
-    return std::unexpected{std::make_error_code(std::errc::invalid_argument)};
-  }
-  for (const auto& member : record_json.GetObject()) {
-    const auto element_key = member.name.GetString();
-    auto element_field = parse(member.value);
-    if (!element_field)
-      return std::unexpected{element_field.error()};
-    result.emplace(element_key, std::move(*element_field));
-  }
-  return result;
-}
-}  // namespace
+ private:
+  struct Frame {
+    std::variant<core::RecordObject, core::RecordArray> container;
+    std::string key;  // the last key of the object
+  };
 
-bool readAsJsonLines(const std::string& content, core::RecordSet& record_set) {
-  std::stringstream ss(content);
-  std::string line;
-  while (std::getline(ss, line, '\n')) {
-    rapidjson::Document document;
-    if (rapidjson::ParseResult parse_result = document.Parse<rapidjson::kParseStopWhenDoneFlag>(line); parse_result.IsError())
+  bool addValue(core::RecordField field) {
+    if (frames_.empty()) {
       return false;
-    auto record = parseRecord(document);
-    if (!record)
-      return false;
-    record_set.push_back(std::move(*record));
+    }
+    auto& frame = frames_.back();
+    if (auto* object = std::get_if<core::RecordObject>(&frame.container)) {
+      object->try_emplace(frame.key, std::move(field));
+    } else {
+      std::get<core::RecordArray>(frame.container).push_back(std::move(field));
+    }
+    return true;
   }
-  return true;
-}
 
-bool readAsArray(const std::string& content, core::RecordSet& record_set) {
-  rapidjson::Document document;
-  if (const rapidjson::ParseResult parse_result = document.Parse<rapidjson::kParseStopWhenDoneFlag>(content); parse_result.IsError())
-    return false;
-  if (!document.IsArray())
-    return false;
-  for (auto& json_record : document.GetArray()) {
-    auto record  = parseRecord(json_record);
-    if (!record)
-      return false;
-    record_set.push_back(std::move(*record));
+  std::vector<Frame> frames_;
+  std::optional<core::Record> result_;
+};
+
+/**
+ * Parses the records one by one, the content is either a single JSON array of records or records separated by whitespace (e.g. JSON-per-line).
+ * The records are built while parsing, without a rapidjson document. Reading stops at the first record that is not a valid JSON object,
+ * keeping the records before it.
+ */
+class JsonRecordReader final : public core::RecordReader {
+ public:
+  explicit JsonRecordReader(io::InputStream& input_stream) : source_(input_stream) {
+    skipWhitespace();
+    if (source_.Peek() == '[') {
+      source_.Take();
+      is_array_ = true;
+    }
   }
-  return true;
-}
 
-std::expected<core::RecordSet, std::error_code> JsonTreeReader::read(io::InputStream& input_stream) {
-  core::RecordSet record_set{};
-  const auto read_result = [&record_set](io::InputStream& input_stream) -> size_t {
-    std::string content;
-    content.resize(input_stream.size());
-    const auto read_ret = input_stream.read(as_writable_bytes(std::span(content)));
-    if (io::isError(read_ret)) {
-      return io::STREAM_ERROR;
+  std::expected<std::optional<core::Record>, std::error_code> next() override {
+    auto record = parseNext();
+    if (source_.failed()) {
+      done_ = true;
+      return std::unexpected{std::make_error_code(std::errc::invalid_argument)};
     }
-    if (content.starts_with('[')) {
-      readAsArray(content, record_set);
-    } else {
-      readAsJsonLines(content, record_set);
+    if (!record) {
+      done_ = true;
+    }
+    return record;
+  }
+
+ private:
+  std::optional<core::Record> parseNext() {
+    if (done_) {
+      return std::nullopt;
+    }
+    skipWhitespace();
+    if (is_array_) {
+      if (source_.Peek() == ']') {
+        return std::nullopt;
+      }
+      if (std::exchange(expects_separator_, true)) {
+        if (source_.Peek() != ',') {
+          return std::nullopt;
+        }
+        source_.Take();
+        skipWhitespace();
+      }
+    }
+    if (source_.Peek() == '\0') {
+      return std::nullopt;
     }
-    return read_ret;
-  }(input_stream);
-  if (io::isError(read_result))
-    return std::unexpected{std::make_error_code(std::errc::invalid_argument)};
-  return record_set;
+    RecordBuilder builder;
+    if (reader_.Parse<rapidjson::kParseStopWhenDoneFlag>(source_, builder).IsError()) {
+      return std::nullopt;
+    }
+    return builder.release();
+  }
+
+  void skipWhitespace() {
+    while (source_.Peek() == ' ' || source_.Peek() == '\n' || source_.Peek() == '\r' || source_.Peek() == '\t') {
+      source_.Take();
+    }
+  }
+
+  utils::json::InputStreamJsonSource source_;
+  rapidjson::Reader reader_;
+  bool is_array_ = false;
+  bool expects_separator_ = false;
+  bool done_ = false;
+};
+}  // namespace
+
+std::unique_ptr<core::RecordReader> JsonTreeReader::createRecordReader(io::InputStream& input_stream) {
+  return std::make_unique<JsonRecordReader>(input_stream);
 }
 
 REGISTER_RESOURCE(JsonTreeReader, ControllerService);
 }  // namespace org::apache::nifi::minifi::standard
-
-#ifdef WIN32
-#pragma pop_macro("GetObject")
-#endif
@@ -16,6 +16,8 @@
  */
 #pragma once
 
+#include <memory>
+
 #include "controllers/RecordSetReader.h"
 
 namespace org::apache::nifi::minifi::standard {
@@ -44,7 +46,7 @@ class JsonTreeReader final : public core::RecordSetReaderImpl {
   EXTENSIONAPI static constexpr auto ImplementsApis = std::array{ RecordSetReader::ProvidesApi };
   ADD_COMMON_VIRTUAL_FUNCTIONS_FOR_CONTROLLER_SERVICES
 
-  std::expected<core::RecordSet, std::error_code> read(io::InputStream& input_stream) override;
+  std::unique_ptr<core::RecordReader> createRecordReader(io::InputStream& input_stream) override;
 
   void initialize() override {
     setSupportedProperties(Properties);
@@ -18,7 +18,13 @@
 #include "XMLReader.h"
 
 #include <algorithm>
+#include <cctype>
+#include <memory>
+#include <optional>
 #include <ranges>
+#include <span>
+#include <string_view>
+#include <utility>
 
 #include "core/Resource.h"
 #include "minifi-cpp/Exception.h"
@@ -135,11 +141,14 @@ void XMLReader::parseXmlNode(core::RecordObject& record_object, const pugi::xml_
   }
 }
 
-void XMLReader::addRecordFromXmlNode(const pugi::xml_node& node, core::RecordSet& record_set) const {
+core::Record XMLReader::createRecordFromXmlNode(const pugi::xml_node& node) const {
   core::RecordObject record_object;
   parseXmlNode(record_object, node);
-  core::Record record(std::move(record_object));
-  record_set.emplace_back(std::move(record));
+  return core::Record(std::move(record_object));
+}
+
+void XMLReader::addRecordFromXmlNode(const pugi::xml_node& node, core::RecordSet& record_set) const {
+  record_set.emplace_back(createRecordFromXmlNode(node));
 }
 
 bool XMLReader::parseRecordsFromXml(core::RecordSet& record_set, const std::string& xml_content) const {
@@ -183,25 +192,306 @@ void XMLReader::onEnable() {
   expect_records_as_array_ = parseBoolProperty(ExpectRecordsAsArray.name);
 }
 
-std::expected<core::RecordSet, std::error_code> XMLReader::read(io::InputStream& input_stream) {
-  core::RecordSet record_set{};
-  const auto read_result = [this, &record_set](io::InputStream& input_stream) -> size_t {
-    std::string content;
-    content.resize(input_stream.size());
-    const auto read_ret = input_stream.read(as_writable_bytes(std::span(content)));
-    if (io::isError(read_ret)) {
-      logger_->log_error("Failed to read XML data from input stream");
-      return io::STREAM_ERROR;
-    }
-    if (!parseRecordsFromXml(record_set, content)) {
-      return io::STREAM_ERROR;
-    }
-    return read_ret;
-  }(input_stream);
-  if (io::isError(read_result)) {
+/**
+ * With Expect Records as Array, the content is scanned for the children of the root element and they are parsed one by one,
+ * so only the record being read is kept in memory. Any other content is parsed as a whole, as it contains a single record.
+ */
+class XMLReader::XmlRecordReader final : public core::RecordReader {
+ public:
+  XmlRecordReader(const XMLReader& xml_reader, io::InputStream& input_stream) : xml_reader_(xml_reader), input_stream_(input_stream) {}
+
+  std::expected<std::optional<core::Record>, std::error_code> next() override {
+    if (state_ == State::Done) {
+      return std::nullopt;
+    }
+    auto record = xml_reader_.expect_records_as_array_ ? nextFromArray() : nextFromDocument();
+    if (!record || !*record) {
+      state_ = State::Done;
+    }
+    return record;
+  }
+
+ private:
+  enum class State { Prolog, Records, Done };
+
+  static constexpr size_t CHUNK_SIZE = 64 * 1024;
+
+  std::expected<std::optional<core::Record>, std::error_code> nextFromDocument() {
+    state_ = State::Done;
+    const auto content = readAll();
+    if (!content) {
+      return std::unexpected{content.error()};
+    }
+    core::RecordSet record_set;
+    if (!xml_reader_.parseRecordsFromXml(record_set, *content)) {
+      return std::unexpected{std::make_error_code(std::errc::invalid_argument)};
+    }
+    if (record_set.empty()) {
+      return std::nullopt;
+    }
+    return std::move(record_set.front());
+  }
+
+  std::expected<std::optional<core::Record>, std::error_code> nextFromArray() {
+    discardConsumed();
+    if (state_ == State::Prolog && !skipProlog()) {
+      return failure();
+    }
+    while (state_ == State::Records) {
+      skipWhitespace();
+      if (position_ == buffer_.size()) {
+        return failure();  // the root element is not closed
+      }
+      if (buffer_[position_] != '<') {
+        // character data directly in the root element, it is an empty record like in the parsed document
+        const auto end = find("<", position_);
+        if (!end) {
+          return failure();
+        }
+        position_ = *end;
+        return core::Record{};
+      }
+      if (startsWith("<!--")) {
+        if (!skipPast("-->")) {
+          return failure();
+        }
+      } else if (startsWith("<?")) {
+        if (!skipPast("?>")) {
+          return failure();
+        }
+      } else if (startsWith("<![CDATA[")) {
+        if (!skipPast("]]>")) {
+          return failure();
+        }
+        return core::Record{};
+      } else if (startsWith("</")) {
+        state_ = State::Done;
+        return std::nullopt;
+      } else {
+        return parseElement();
+      }
+    }
+    return std::nullopt;
+  }
+
+  // skips everything up to and including the start tag of the root element
+  bool skipProlog() {
+    while (true) {
+      skipWhitespace();
+      if (position_ == buffer_.size() || buffer_[position_] != '<') {
+        return false;
+      }
+      if (startsWith("<?")) {
+        if (!skipPast("?>")) {
+          return false;
+        }
+      } else if (startsWith("<!--")) {
+        if (!skipPast("-->")) {
+          return false;
+        }
+      } else if (startsWith("<!")) {
+        if (!skipDoctype()) {
+          return false;
+        }
+      } else {
+        const auto tag_end = findTagEnd(position_);
+        if (!tag_end) {
+          return false;
+        }
+        state_ = buffer_[*tag_end - 1] == '/' ? State::Done : State::Records;
+        position_ = *tag_end + 1;
+        return true;
+      }
+    }
+  }
+
+  bool skipDoctype() {
+    const auto end = findFirstOf("[>", position_);
+    if (!end) {
+      return false;
+    }
+    position_ = *end;
+    if (buffer_[*end] == '[') {
+      return skipPast("]") && skipPast(">");
+    }
+    ++position_;
+    return true;
+  }
+
+  std::expected<std::optional<core::Record>, std::error_code> parseElement() {
+    const auto element_end = findElementEnd();
+    if (!element_end) {
+      return failure();
+    }
+    pugi::xml_document doc;
+    if (!doc.load_buffer(buffer_.data() + position_, *element_end - position_, pugi::parse_default, pugi::encoding_utf8)) {
+      return failure();
+    }
+    position_ = *element_end;
+    return xml_reader_.createRecordFromXmlNode(doc.first_child());
+  }
+
+  // returns the position after the end tag of the element starting at the current position
+  std::optional<size_t> findElementEnd() {
+    size_t depth = 0;
+    size_t pos = position_;
+    do {
+      const auto tag_start = find("<", pos);
+      if (!tag_start) {
+        return std::nullopt;
+      }
+      pos = *tag_start;
+      std::optional<size_t> next;
+      if (startsWith("<!--", pos)) {
+        next = findEnd("-->", pos);
+      } else if (startsWith("<![CDATA[", pos)) {
+        next = findEnd("]]>", pos);
+      } else if (startsWith("<?", pos)) {
+        next = findEnd("?>", pos);
+      } else if (startsWith("</", pos) || startsWith("<!", pos)) {
+        next = findEnd(">", pos);
+        depth -= buffer_[pos + 1] == '/' ? 1 : 0;
+      } else {
+        const auto tag_end = findTagEnd(pos);
+        if (tag_end) {
+          next = *tag_end + 1;
+          depth += buffer_[*tag_end - 1] == '/' ? 0 : 1;
+        }
+      }
+      if (!next) {
+        return std::nullopt;
+      }
+      pos = *next;
+    } while (depth > 0);
+    return pos;
+  }
+
+  // returns the position of the '>' closing the tag starting at the given position, skipping the quoted attribute values
+  std::optional<size_t> findTagEnd(size_t pos) {
+    char quote = '\0';
+    for (++pos; ensureAvailable(pos + 1); ++pos) {
+      const char c = buffer_[pos];
+      if (quote != '\0') {
+        quote = c == quote ? '\0' : quote;
+      } else if (c == '"' || c == '\'') {
+        quote = c;
+      } else if (c == '>') {
+        return pos;
+      }
+    }
+    return std::nullopt;
+  }
+
+  std::optional<size_t> find(std::string_view token, size_t pos) {
+    while (true) {
+      if (const auto found = buffer_.find(token, pos); found != std::string::npos) {
+        return found;
+      }
+      pos = std::max(pos, buffer_.size() - std::min(buffer_.size(), token.size() - 1));
+      if (!readChunk()) {
+        return std::nullopt;
+      }
+    }
+  }
+
+  std::optional<size_t> findFirstOf(std::string_view characters, size_t pos) {
+    while (true) {
+      if (const auto found = buffer_.find_first_of(characters, pos); found != std::string::npos) {
+        return found;
+      }
+      pos = buffer_.size();
+      if (!readChunk()) {
+        return std::nullopt;
+      }
+    }
+  }
+
+  std::optional<size_t> findEnd(std::string_view token, size_t pos) {
+    const auto found = find(token, pos);
+    return found ? std::optional<size_t>(*found + token.size()) : std::nullopt;
+  }
+
+  bool skipPast(std::string_view token) {
+    const auto end = findEnd(token, position_);
+    if (end) {
+      position_ = *end;
+    }
+    return end.has_value();
+  }
+
+  bool startsWith(std::string_view token) { return startsWith(token, position_); }
+
+  bool startsWith(std::string_view token, size_t pos) {
+    ensureAvailable(pos + token.size());
+    return std::string_view(buffer_).substr(pos).starts_with(token);
+  }
+
+  void skipWhitespace() {
+    while (ensureAvailable(position_ + 1) && std::isspace(static_cast<unsigned char>(buffer_[position_]))) {
+      ++position_;
+    }
+  }
+
+  bool ensureAvailable(size_t size) {
+    while (buffer_.size() < size) {
+      if (!readChunk()) {
+        return false;
+      }
+    }
+    return true;
+  }
+
+  bool readChunk() {
+    if (end_of_stream_) {
+      return false;
+    }
+    const auto size = buffer_.size();
+    buffer_.resize(size + CHUNK_SIZE);
+    const auto read_result = input_stream_.read(as_writable_bytes(std::span(buffer_).subspan(size)));
+    if (io::isError(read_result)) {
+      read_failed_ = true;
+    }
+    buffer_.resize(size + (io::isError(read_result) ? 0 : read_result));
+    end_of_stream_ = read_failed_ || read_result == 0;
+    return !end_of_stream_;
+  }
+
+  void discardConsumed() {
+    if (position_ > buffer_.size() / 2) {
+      buffer_.erase(0, position_);
+      position_ = 0;
+    }
+  }
+
+  std::expected<std::string, std::error_code> readAll() {
+    while (readChunk()) {}
+    if (read_failed_) {
+      xml_reader_.logger_->log_error("Failed to read XML data from input stream");
+      return std::unexpected{std::make_error_code(std::errc::invalid_argument)};
+    }
+    return std::move(buffer_);
+  }
+
+  std::unexpected<std::error_code> failure() {
+    if (read_failed_) {
+      xml_reader_.logger_->log_error("Failed to read XML data from input stream");
+    } else {
+      xml_reader_.logger_->log_error("Failed to parse XML content: {}", std::string_view(buffer_).substr(position_));
+    }
     return std::unexpected{std::make_error_code(std::errc::invalid_argument)};
   }
-  return record_set;
+
+  const XMLReader& xml_reader_;
+  io::InputStream& input_stream_;
+  std::string buffer_;
+  size_t position_ = 0;
+  bool end_of_stream_ = false;
+  bool read_failed_ = false;
+  State state_ = State::Prolog;
+};
+
+std::unique_ptr<core::RecordReader> XMLReader::createRecordReader(io::InputStream& input_stream) {
+  return std::make_unique<XmlRecordReader>(*this, input_stream);
 }
 
 REGISTER_RESOURCE(XMLReader, ControllerService);
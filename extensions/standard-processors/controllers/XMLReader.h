@@ -16,6 +16,9 @@
  */
 #pragma once
 
+#include <memory>
+#include <string>
+
 #include "controllers/RecordSetReader.h"
 #include "core/PropertyDefinitionBuilder.h"
 #include "minifi-cpp/core/logging/Logger.h"
@@ -69,7 +72,7 @@ class XMLReader final : public core::RecordSetReaderImpl {
   EXTENSIONAPI static constexpr auto ImplementsApis = std::array{ RecordSetReader::ProvidesApi };
   ADD_COMMON_VIRTUAL_FUNCTIONS_FOR_CONTROLLER_SERVICES
 
-  std::expected<core::RecordSet, std::error_code> read(io::InputStream& input_stream) override;
+  std::unique_ptr<core::RecordReader> createRecordReader(io::InputStream& input_stream) override;
 
   void initialize() override {
     setSupportedProperties(Properties);
@@ -77,9 +80,12 @@ class XMLReader final : public core::RecordSetReaderImpl {
   void onEnable() override;
 
  private:
+  class XmlRecordReader;
+
   void writeRecordField(core::RecordObject& record_object, const std::string& name, const std::string& value, bool write_pcdata_node = false) const;
   void parseNodeElement(core::RecordObject& record_object, const pugi::xml_node& node) const;
   void parseXmlNode(core::RecordObject& record_object, const pugi::xml_node& node) const;
+  core::Record createRecordFromXmlNode(const pugi::xml_node& node) const;
   void addRecordFromXmlNode(const pugi::xml_node& node, core::RecordSet& record_set) const;
   bool parseRecordsFromXml(core::RecordSet& record_set, const std::string& xml_content) const;
 
@@ -16,6 +16,9 @@
  */
 #include "XMLRecordSetWriter.h"
 
+#include <memory>
+#include <utility>
+
 #include "core/Resource.h"
 #include "minifi-cpp/Exception.h"
 #include "utils/TimeUtil.h"
@@ -62,8 +65,7 @@ void XMLRecordSetWriter::onEnable() {
   }
 }
 
-std::string XMLRecordSetWriter::formatXmlOutput(pugi::xml_document& xml_doc) const {
-  std::ostringstream xml_string_stream;
+unsigned int XMLRecordSetWriter::getFormattingFlags() const {
   unsigned int xml_formatting_flags = 0;
   if (pretty_print_xml_) {
     xml_formatting_flags |= pugi::format_indent;
@@ -73,7 +75,12 @@ std::string XMLRecordSetWriter::formatXmlOutput(pugi::xml_document& xml_doc) con
   if (omit_xml_declaration_) {
     xml_formatting_flags |= pugi::format_no_declaration;
   }
-  xml_doc.save(xml_string_stream, "  ", xml_formatting_flags);
+  return xml_formatting_flags;
+}
+
+std::string XMLRecordSetWriter::formatXmlOutput(pugi::xml_document& xml_doc) const {
+  std::ostringstream xml_string_stream;
+  xml_doc.save(xml_string_stream, "  ", getFormattingFlags());
   return xml_string_stream.str();
 }
 
@@ -132,19 +139,85 @@ void XMLRecordSetWriter::convertRecordField(const std::string& field_name, const
   }, field.value_);
 }
 
-std::string XMLRecordSetWriter::convertRecordSetToXml(const core::RecordSet& record_set) const {
-  gsl_Expects(!name_of_record_tag_.empty() && !name_of_root_tag_.empty());
-  pugi::xml_document xml_doc;
-  auto root_node = xml_doc.append_child(name_of_root_tag_.c_str());
+namespace {
+class OutputStreamXmlWriter : public pugi::xml_writer {
+ public:
+  explicit OutputStreamXmlWriter(io::OutputStream& output_stream) : output_stream_(output_stream) {}
+
+  void write(const void* data, size_t size) override {
+    if (!failed_) {
+      failed_ = io::isError(output_stream_.write(static_cast<const uint8_t*>(data), size));
+    }
+  }
+
+  [[nodiscard]] bool failed() const { return failed_; }
+
+ private:
+  io::OutputStream& output_stream_;
+  bool failed_ = false;
+};
+}  // namespace
+
+/**
+ * The declaration and the root start tag are written together with the first record, formatted by pugixml the same way as a whole document,
+ * the further records are printed one by one at the depth of the root's children, and finish() closes the root element.
+ */
+class XMLRecordSetWriter::XmlRecordWriter final : public core::RecordWriter {
+ public:
+  XmlRecordWriter(const XMLRecordSetWriter& record_set_writer, io::OutputStream& output_stream)
+      : record_set_writer_(record_set_writer),
+        xml_writer_(output_stream),
+        root_end_tag_(fmt::format("</{}>{}", record_set_writer.name_of_root_tag_, record_set_writer.pretty_print_xml_ ? "\n" : "")) {
+  }
 
-  for (const auto& record : record_set) {
-    auto record_node = root_node.append_child(name_of_record_tag_.c_str());
+  std::expected<void, std::error_code> write(const core::Record& record) override {
+    pugi::xml_document xml_doc;
+    auto root_node = xml_doc.append_child(record_set_writer_.name_of_root_tag_.c_str());
+    auto record_node = root_node.append_child(record_set_writer_.name_of_record_tag_.c_str());
     for (const auto& [key, field] : record) {
-      convertRecordField(key, field, record_node);
+      record_set_writer_.convertRecordField(key, field, record_node);
+    }
+
+    if (std::exchange(root_started_, true)) {
+      record_node.print(xml_writer_, "  ", record_set_writer_.getFormattingFlags(), pugi::encoding_auto, 1);
+    } else {
+      auto xml_content = record_set_writer_.formatXmlOutput(xml_doc);
+      gsl_Assert(xml_content.ends_with(root_end_tag_));
+      xml_content.resize(xml_content.size() - root_end_tag_.size());
+      xml_writer_.write(xml_content.data(), xml_content.size());
     }
+    return checkOutput();
   }
 
-  return formatXmlOutput(xml_doc);
+  std::expected<void, std::error_code> finish() override {
+    if (root_started_) {
+      xml_writer_.write(root_end_tag_.data(), root_end_tag_.size());
+    } else {
+      pugi::xml_document xml_doc;
+      xml_doc.append_child(record_set_writer_.name_of_root_tag_.c_str());
+      const auto xml_content = record_set_writer_.formatXmlOutput(xml_doc);
+      xml_writer_.write(xml_content.data(), xml_content.size());
+    }
+    return checkOutput();
+  }
+
+ private:
+  [[nodiscard]] std::expected<void, std::error_code> checkOutput() const {
+    if (xml_writer_.failed()) {
+      return std::unexpected{std::make_error_code(std::errc::io_error)};
+    }
+    return {};
+  }
+
+  const XMLRecordSetWriter& record_set_writer_;
+  OutputStreamXmlWriter xml_writer_;
+  std::string root_end_tag_;
+  bool root_started_ = false;
+};
+
+std::unique_ptr<core::RecordWriter> XMLRecordSetWriter::createRecordWriter(io::OutputStream& output_stream) {
+  gsl_Expects(!name_of_record_tag_.empty() && !name_of_root_tag_.empty());
+  return std::make_unique<XmlRecordWriter>(*this, output_stream);
 }
 
 void XMLRecordSetWriter::write(const core::RecordSet& record_set, const std::shared_ptr<core::FlowFile>& flow_file, core::ProcessSession& session) {
@@ -152,12 +225,7 @@ void XMLRecordSetWriter::write(const core::RecordSet& record_set, const std::sha
     logger_->log_error("FlowFile is null, cannot write RecordSet to XML");
     return;
   }
-
-  auto xml_content = convertRecordSetToXml(record_set);
-  session.write(flow_file, [&xml_content](const std::shared_ptr<io::OutputStream>& stream) -> io::IoResult {
-    stream->write(reinterpret_cast<const uint8_t*>(xml_content.data()), xml_content.size());
-    return io::IoResult::from(xml_content.size());
-  });
+  RecordSetWriterImpl::write(record_set, flow_file, session);
 }
 
 REGISTER_RESOURCE(XMLRecordSetWriter, ControllerService);
@@ -16,6 +16,9 @@
  */
 #pragma once
 
+#include <memory>
+#include <string>
+
 #include "controllers/RecordSetWriter.h"
 #include "core/PropertyDefinitionBuilder.h"
 #include "minifi-cpp/core/logging/Logger.h"
@@ -106,6 +109,7 @@ class XMLRecordSetWriter final : public core::RecordSetWriterImpl {
   ADD_COMMON_VIRTUAL_FUNCTIONS_FOR_CONTROLLER_SERVICES
 
   void write(const core::RecordSet& record_set, const std::shared_ptr<core::FlowFile>& flow_file, core::ProcessSession& session) override;
+  std::unique_ptr<core::RecordWriter> createRecordWriter(io::OutputStream& output_stream) override;
 
   void initialize() override {
     setSupportedProperties(Properties);
@@ -113,8 +117,10 @@ class XMLRecordSetWriter final : public core::RecordSetWriterImpl {
   void onEnable() override;
 
  private:
+  class XmlRecordWriter;
+
+  unsigned int getFormattingFlags() const;
   std::string formatXmlOutput(pugi::xml_document& xml_doc) const;
-  std::string convertRecordSetToXml(const core::RecordSet& record_set) const;
   void convertRecordArrayField(const std::string& field_name, const core::RecordField& field, pugi::xml_node& parent_node) const;
   void convertRecordField(const std::string& field_name, const core::RecordField& field, pugi::xml_node& parent_node) const;
 
@@ -16,7 +16,9 @@
  */
 #include "ConvertRecord.h"
 
-#include <expected>
+#include <memory>
+#include <optional>
+#include <string>
 
 #include "core/Resource.h"
 #include "utils/GeneralUtils.h"
@@ -41,26 +43,53 @@ void ConvertRecord::onTrigger(core::ProcessContext& context, core::ProcessSessio
     return;
   }
 
-  std::expected<core::RecordSet, std::error_code> record_set;
-  session.read(flow_file, [this, &record_set](const std::shared_ptr<io::InputStream>& input_stream) -> io::IoResult {
-    record_set = record_converter_->record_set_reader->read(*input_stream);
-    return io::IoResult::from(input_stream->size());
+  // the records are converted one at a time, the new content is discarded if the flow file is routed to failure or removed
+  std::optional<std::error_code> read_error;
+  size_t record_count = 0;
+  session.write(flow_file, [&](const std::shared_ptr<io::OutputStream>& output_stream) -> io::IoResult {
+    const auto record_writer = record_converter_->record_set_writer->createRecordWriter(*output_stream);
+    bool write_failed = false;
+    session.read(flow_file, [&](const std::shared_ptr<io::InputStream>& input_stream) -> io::IoResult {
+      const auto record_reader = record_converter_->record_set_reader->createRecordReader(*input_stream);
+      while (true) {
+        auto record = record_reader->next();
+        if (!record) {
+          read_error = record.error();
+          break;
+        }
+        if (!*record) {
+          break;
+        }
+        if (!record_writer->write(**record)) {
+          write_failed = true;
+          break;
+        }
+        ++record_count;
+      }
+      return io::IoResult::from(input_stream->size());
+    });
+    if (read_error || (!include_zero_record_flow_files_ && record_count == 0)) {
+      return io::IoResult::cancelled();
+    }
+    if (write_failed || !record_writer->finish()) {
+      return io::IoResult::error();
+    }
+    return io::IoResult::zero();
   });
-  if (!record_set) {
-    logger_->log_error("Failed to read record set from flow file: {}", record_set.error().message());
-    flow_file->setAttribute(processors::ConvertRecord::RecordErrorMessageOutputAttribute.name, record_set.error().message());
+  if (read_error) {
+    logger_->log_error("Failed to read record set from flow file: {}", read_error->message());
+    flow_file->setAttribute(processors::ConvertRecord::RecordErrorMessageOutputAttribute.name, read_error->message());
     session.transfer(flow_file, Failure);
     return;
   }
 
-  if (!include_zero_record_flow_files_ && record_set->empty()) {
+  if (!include_zero_record_flow_files_ && record_count == 0) {
     logger_->log_info("No records found in flow file, removing flow file");
     session.remove(flow_file);
     return;
   }
 
-  record_converter_->record_set_writer->write(*record_set, flow_file, session);
-  flow_file->setAttribute(processors::ConvertRecord::RecordCountOutputAttribute.name, std::to_string(record_set->size()));
+  flow_file->setAttribute(processors::ConvertRecord::RecordCountOutputAttribute.name, std::to_string(record_count));
   session.transfer(flow_file, Success);
 }
 
@@ -17,6 +17,8 @@
 
 #include "DefragmentText.h"
 
+#include <optional>
+#include <string_view>
 #include <vector>
 #include <utility>
 
@@ -51,9 +53,13 @@ void DefragmentText::onSchedule(core::ProcessContext& context, core::ProcessSess
 
   pattern_location_ = utils::parseEnumProperty<defragment_text::PatternLocation>(context, PatternLoc);
 
-  pattern_ = context.getProperty(Pattern)
-    | utils::transform([](auto pattern_str) { return utils::Regex{std::move(pattern_str)}; })
-    | utils::orThrow("Pattern property missing or invalid");
+  const auto pattern_str = context.getProperty(Pattern) | utils::orThrow("Pattern property missing or invalid");
+  pattern_ = utils::Regex{pattern_str};
+  literal_pattern_.reset();
+  if (!pattern_str.empty() && pattern_str.find_first_of(R"(\^$.|?*+()[]{})") == std::string::npos) {
+    // a pattern without regex metacharacters can only match itself, so it is searched as a plain delimiter
+    literal_pattern_.emplace(pattern_str);
+  }
 }
 
 void DefragmentText::onTrigger(core::ProcessContext&, core::ProcessSession& session) {
@@ -150,14 +156,23 @@ void updateAppendedAttributes(core::FlowFile& buffered_ff) {
   buffered_ff.setAttribute(core::SpecialFlowAttribute::FILENAME, buffer_new_name);
 }
 
-size_t getSplitPosition(const utils::SMatch& last_match, defragment_text::PatternLocation pattern_location) {
-  size_t split_position = last_match.position(0);
+size_t getSplitPosition(size_t match_position, size_t match_length, defragment_text::PatternLocation pattern_location) {
+  size_t split_position = match_position;
   if (pattern_location == defragment_text::PatternLocation::END_OF_MESSAGE) {
-    split_position += last_match.length(0);
+    split_position += match_length;
   }
   return split_position;
 }
 
+// the matches do not overlap, as with the successive searches of getLastRegexMatch
+std::optional<size_t> findLastOccurrence(std::string_view content, const utils::DelimiterScanner& delimiter_scanner) {
+  std::optional<size_t> last_position;
+  for (auto position = delimiter_scanner.find(content); position != std::string_view::npos; position = delimiter_scanner.find(content, position + delimiter_scanner.size())) {
+    last_position = position;
+  }
+  return last_position;
+}
+
 }  // namespace
 
 bool DefragmentText::splitFlowFileAtLastPattern(core::ProcessSession& session,
@@ -165,13 +180,21 @@ bool DefragmentText::splitFlowFileAtLastPattern(core::ProcessSession& session,
                                                 std::shared_ptr<core::FlowFile> &split_before_last_pattern,
                                                 std::shared_ptr<core::FlowFile> &split_after_last_pattern) const {
   const auto read_result = session.readBuffer(original_flow_file);
-  auto last_regex_match = utils::getLastRegexMatch(to_string(read_result), pattern_);
-  if (!last_regex_match.ready()) {
+  std::optional<size_t> last_split_position;
+  if (literal_pattern_) {
+    const std::string_view content(reinterpret_cast<const char*>(read_result.buffer.data()), read_result.buffer.size());
+    if (const auto last_position = findLastOccurrence(content, *literal_pattern_)) {
+      last_split_position = getSplitPosition(*last_position, literal_pattern_->size(), pattern_location_);
+    }
+  } else if (const auto last_regex_match = utils::getLastRegexMatch(to_string(read_result), pattern_); last_regex_match.ready()) {
+    last_split_position = getSplitPosition(last_regex_match.position(0), last_regex_match.length(0), pattern_location_);
+  }
+  if (!last_split_position) {
     split_before_last_pattern = session.clone(*original_flow_file);
     split_after_last_pattern = nullptr;
     return false;
   }
-  const auto split_position = gsl::narrow<int64_t>(getSplitPosition(last_regex_match, pattern_location_));
+  const auto split_position = gsl::narrow<int64_t>(*last_split_position);
   if (split_position != 0) {
     split_before_last_pattern = session.clone(*original_flow_file, 0, split_position);
   }
@@ -18,6 +18,7 @@
 #pragma once
 
 #include <memory>
+#include <optional>
 #include <set>
 #include <string>
 #include <unordered_map>
@@ -29,6 +30,7 @@
 #include "core/logging/LoggerFactory.h"
 #include "minifi-cpp/core/PropertyDefinition.h"
 #include "core/PropertyDefinitionBuilder.h"
+#include "utils/ByteScanner.h"
 #include "utils/Enum.h"
 #include "serialization/PayloadSerializer.h"
 #include "utils/RegexUtils.h"
@@ -150,6 +152,7 @@ class DefragmentText : public core::ProcessorImpl {
 
 
   utils::Regex pattern_;
+  std::optional<utils::DelimiterScanner> literal_pattern_;
   defragment_text::PatternLocation pattern_location_;
   std::optional<std::chrono::milliseconds> max_age_;
   std::optional<size_t> max_size_;
@@ -16,7 +16,11 @@
  */
 #include "EvaluateJsonPath.h"
 
+#include <array>
+#include <istream>
+#include <span>
 #include <unordered_map>
+#include <utility>
 
 #include "core/ProcessSession.h"
 #include "minifi-cpp/core/ProcessContext.h"
@@ -28,6 +32,8 @@
 namespace org::apache::nifi::minifi::processors {
 
 namespace {
+using JsonPathExpression = decltype(jsoncons::jsonpath::make_expression<jsoncons::json>(std::string_view{}));
+
 bool isScalar(const jsoncons::json& value) {
   return !value.is_array() && !value.is_object();
 }
@@ -35,6 +41,36 @@ bool isScalar(const jsoncons::json& value) {
 bool isQueryResultEmptyOrScalar(const jsoncons::json& query_result) {
   return query_result.empty() || (query_result.size() == 1 && isScalar(query_result[0]));
 }
+
+// lets the JSON parser pull the flow file content in chunks instead of reading all of it into memory first
+class InputStreamBuffer : public std::streambuf {
+ public:
+  explicit InputStreamBuffer(io::InputStream& stream) : stream_(stream) {}
+
+  [[nodiscard]] bool hasFailed() const { return failed_; }
+
+ protected:
+  int_type underflow() override {
+    if (gptr() < egptr()) {
+      return traits_type::to_int_type(*gptr());
+    }
+    const auto read_size = stream_.read(std::as_writable_bytes(std::span(buffer_)));
+    if (io::isError(read_size)) {
+      failed_ = true;
+      return traits_type::eof();
+    }
+    if (read_size == 0) {
+      return traits_type::eof();
+    }
+    setg(buffer_.data(), buffer_.data(), buffer_.data() + read_size);
+    return traits_type::to_int_type(*gptr());
+  }
+
+ private:
+  io::InputStream& stream_;
+  std::array<char, 64 * 1024> buffer_{};
+  bool failed_ = false;
+};
 }  // namespace
 
 void EvaluateJsonPath::initialize() {
@@ -61,6 +97,32 @@ void EvaluateJsonPath::onSchedule(core::ProcessContext& context, core::ProcessSe
       return_type_ = evaluate_json_path::ReturnTypeOption::Scalar;
     }
   }
+
+  json_paths_.clear();
+  streaming_evaluator_.reset();
+  std::vector<std::vector<utils::json_path::PathStep>> simple_paths;
+  for (const auto& property_name : dynamic_properties) {
+    const auto expression = context.getRawDynamicProperty(property_name);
+    if (!expression) {
+      throw Exception(PROCESS_SCHEDULE_EXCEPTION, "Failed to retrieve dynamic property '" + property_name + "'");
+    }
+    auto& json_path = json_paths_.emplace_back(JsonPath{.property_name = property_name, .expression = *expression, .evaluate = {}, .error = {}});
+    try {
+      json_path.evaluate = [compiled = std::make_shared<JsonPathExpression>(jsoncons::jsonpath::make_expression<jsoncons::json>(*expression))](const jsoncons::json& json) {
+        return compiled->evaluate(json);
+      };
+    } catch (const jsoncons::jsonpath::jsonpath_error& e) {
+      // reported for each flow file like before, so that the content is still validated first
+      json_path.error = e.what();
+    }
+    if (auto simple_path = utils::json_path::parseSimplePath(*expression); simple_path && json_path.evaluate) {
+      simple_paths.push_back(std::move(*simple_path));
+    }
+  }
+  if (simple_paths.size() == json_paths_.size()) {
+    streaming_evaluator_.emplace(simple_paths);
+    logger_->log_debug("Every JSON path is a simple path, they are evaluated while the content is parsed");
+  }
 }
 
 std::string EvaluateJsonPath::extractQueryResult(const jsoncons::json& query_result) const {
@@ -101,34 +163,54 @@ void EvaluateJsonPath::onTrigger(core::ProcessContext& context, core::ProcessSes
     return;
   }
 
-  const auto json_string = to_string(session.readBuffer(flow_file));
-  if (json_string.empty()) {
+  if (flow_file->getSize() == 0) {
     logger_->log_error("FlowFile content is empty, transferring to Failure relationship");
     session.transfer(flow_file, Failure);
     return;
   }
 
   jsoncons::json json_object;
-  try {
-    json_object = jsoncons::json::parse(json_string);
-  } catch (const jsoncons::json_exception& e) {
-    logger_->log_error("FlowFile content is not a valid JSON document, transferring to Failure relationship: {}", e.what());
+  std::vector<jsoncons::json> streamed_results;
+  std::optional<std::string> parse_error;
+  bool read_failed = false;
+  session.read(flow_file, [&](const std::shared_ptr<io::InputStream>& input_stream) -> io::IoResult {
+    InputStreamBuffer buffer(*input_stream);
+    std::istream input(&buffer);
+    try {
+      if (streaming_evaluator_) {
+        streamed_results = streaming_evaluator_->evaluate(input);
+      } else {
+        json_object = jsoncons::json::parse(input);
+      }
+    } catch (const jsoncons::json_exception& e) {
+      parse_error = e.what();
+    }
+    read_failed = buffer.hasFailed();
+    return read_failed ? io::IoResult::error() : io::IoResult::zero();
+  });
+  if (read_failed) {
+    logger_->log_error("Failed to read the content of FlowFile with UUID '{}', transferring to Failure relationship", flow_file->getUUIDStr());
+    session.transfer(flow_file, Failure);
+    return;
+  }
+  if (parse_error) {
+    logger_->log_error("FlowFile content is not a valid JSON document, transferring to Failure relationship: {}", *parse_error);
     session.transfer(flow_file, Failure);
     return;
   }
 
   std::unordered_map<std::string, std::string> attributes_to_set;
-  for (const auto& property_name : context.getDynamicPropertyKeys()) {
-    const auto result = context.getRawDynamicProperty(property_name);
-    if (!result) {
-      logger_->log_error("Failed to retrieve dynamic property '{}' for FlowFile with UUID '{}', transferring to Failure relationship", property_name, flow_file->getUUIDStr());
+  for (size_t i = 0; i < json_paths_.size(); ++i) {
+    const auto& property_name = json_paths_[i].property_name;
+    const auto& json_path = json_paths_[i].expression;
+    if (!json_paths_[i].evaluate) {
+      logger_->log_error("Invalid JSON path expression '{}' found for attribute key '{}': {}", json_path, property_name, json_paths_[i].error);
       session.transfer(flow_file, Failure);
       return;
     }
-    const auto& json_path = *result;
     jsoncons::json query_result;
     try {
-      query_result = jsoncons::jsonpath::json_query(json_object, json_path);
+      query_result = streaming_evaluator_ ? std::move(streamed_results[i]) : json_paths_[i].evaluate(json_object);
     } catch (const jsoncons::jsonpath::jsonpath_error& e) {
       logger_->log_error("Invalid JSON path expression '{}' found for attribute key '{}': {}", json_path, property_name, e.what());
       session.transfer(flow_file, Failure);
@@ -19,6 +19,10 @@
 #include <string>
 #include <string_view>
 #include <array>
+#include <functional>
+#include <optional>
+#include <unordered_map>
+#include <vector>
 
 #include "core/ProcessorImpl.h"
 #include "minifi-cpp/core/PropertyDefinition.h"
@@ -27,6 +31,7 @@
 #include "minifi-cpp/core/RelationshipDefinition.h"
 
 #include "jsoncons/json.hpp"
+#include "../utils/JsonPathUtils.h"
 
 namespace org::apache::nifi::minifi::processors::evaluate_json_path {
 enum class DestinationType {
@@ -182,6 +187,13 @@ class EvaluateJsonPath final : public core::ProcessorImpl {
   void onTrigger(core::ProcessContext& context, core::ProcessSession& session) override;
 
  private:
+  struct JsonPath {
+    std::string property_name;
+    std::string expression;
+    std::function<jsoncons::json(const jsoncons::json&)> evaluate;  // empty if the expression is invalid
+    std::string error;
+  };
+
   std::string extractQueryResult(const jsoncons::json& query_result) const;
   void writeQueryResult(core::ProcessSession& session, core::FlowFile& flow_file, const jsoncons::json& query_result, const std::string& property_name,
     std::unordered_map<std::string, std::string>& attributes_to_set) const;
@@ -190,6 +202,8 @@ class EvaluateJsonPath final : public core::ProcessorImpl {
   evaluate_json_path::NullValueRepresentationOption null_value_representation_ = evaluate_json_path::NullValueRepresentationOption::EmptyString;
   evaluate_json_path::PathNotFoundBehaviorOption path_not_found_behavior_ = evaluate_json_path::PathNotFoundBehaviorOption::Ignore;
   evaluate_json_path::ReturnTypeOption return_type_ = evaluate_json_path::ReturnTypeOption::AutoDetect;
+  std::vector<JsonPath> json_paths_;
+  std::optional<utils::json_path::StreamingEvaluator> streaming_evaluator_;  // set if every expression is a simple path
 };
 
 }  // namespace org::apache::nifi::minifi::processors
@@ -95,6 +95,9 @@ io::IoResult ExtractText::ReadCallback::operator()(const std::shared_ptr<io::Inp
     if (insensitive) {
       regex_flags.push_back(utils::Regex::Mode::ICASE);
     }
+    if (utils::parseEnumProperty<utils::RegexEngine>(*ctx_, RegularExpressionEngine) == utils::RegexEngine::Linear) {
+      regex_flags.push_back(utils::Regex::Mode::LINEAR);
+    }
 
     std::string contentStr = contentStream.str();
 
@@ -33,6 +33,8 @@
 #include "minifi-cpp/core/PropertyValidator.h"
 #include "minifi-cpp/core/RelationshipDefinition.h"
 #include "minifi-cpp/utils/Export.h"
+#include "utils/Enum.h"
+#include "utils/RegexUtils.h"
 
 namespace org::apache::nifi::minifi::processors {
 
@@ -83,6 +85,14 @@ class ExtractText : public core::ProcessorImpl {
       .withValidator(core::StandardPropertyValidators::BOOLEAN_VALIDATOR)
       .withDefaultValue("false")
       .build();
+  EXTENSIONAPI static constexpr auto RegularExpressionEngine = core::PropertyDefinitionBuilder<magic_enum::enum_count<utils::RegexEngine>()>::createProperty("Regular Expression Engine")
+      .withDescription("The engine evaluating the regular expressions in Regex Mode. 'Standard' uses the regular expression library of the platform. "
+          "'Linear' uses ECMAScript syntax and finds the matches in time linear in the length of the content; "
+          "patterns with backreferences or lookarounds are evaluated by the standard engine.")
+      .isRequired(true)
+      .withDefaultValue(magic_enum::enum_name(utils::RegexEngine::Standard))
+      .withAllowedValues(magic_enum::enum_names<utils::RegexEngine>())
+      .build();
   EXTENSIONAPI static constexpr auto Properties = std::to_array<core::PropertyReference>({
       Attribute,
       SizeLimit,
@@ -90,7 +100,8 @@ class ExtractText : public core::ProcessorImpl {
       IncludeCaptureGroupZero,
       InsensitiveMatch,
       MaxCaptureGroupLen,
-      EnableRepeatingCaptureGroup
+      EnableRepeatingCaptureGroup,
+      RegularExpressionEngine
   });
 
 
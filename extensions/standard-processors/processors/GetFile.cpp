@@ -57,6 +57,8 @@ void GetFile::onSchedule(core::ProcessContext& context, core::ProcessSessionFact
   request_.pollInterval = utils::parseDurationProperty(context, PollInterval);
   request_.recursive = utils::parseBoolProperty(context, Recurse);
   request_.fileFilter = utils::parseProperty(context, FileFilter);
+  file_filter_regex_ = utils::Regex(request_.fileFilter);
+  request_.listingThreadCount = utils::parseU64Property(context, ListingThreadCount);
 
   if (auto directory_str = context.getProperty(Directory, nullptr)) {
     if (!utils::file::is_directory(*directory_str)) {
@@ -124,12 +126,14 @@ bool GetFile::isListingEmpty() const {
   return directory_listing_.empty();
 }
 
-void GetFile::putListing(const std::filesystem::path& file_path) {
-  logger_->log_trace("Adding file to queue: {}", file_path);
+void GetFile::putListing(std::vector<std::filesystem::path>&& file_paths) {
+  logger_->log_trace("Adding {} files to queue", file_paths.size());
 
   std::lock_guard<std::mutex> lock(directory_listing_mutex_);
 
-  directory_listing_.push(file_path);
+  for (auto& file_path : file_paths) {
+    directory_listing_.push(std::move(file_path));
+  }
 }
 
 std::queue<std::filesystem::path> GetFile::pollListing(uint64_t batch_size) {
@@ -143,57 +147,46 @@ std::queue<std::filesystem::path> GetFile::pollListing(uint64_t batch_size) {
   return list;
 }
 
-bool GetFile::fileMatchesRequestCriteria(const std::filesystem::path& full_name, const std::filesystem::path& name, const GetFileRequest &request) {
-  logger_->log_trace("Checking file: {}", full_name);
+bool GetFile::fileMatchesRequestCriteria(const utils::file::DirectoryEntry& entry, const GetFileRequest &request) {
+  logger_->log_trace("Checking file: {}", entry.fullPath());
 
-  std::error_code ec;
-  uint64_t file_size = std::filesystem::file_size(full_name, ec);
-  if (ec) {
-    logger_->log_error("file_size of {}: {}", full_name, ec.message());
-    return false;
-  }
-  const auto modifiedTime = std::filesystem::last_write_time(full_name, ec);
-  if (ec) {
-    logger_->log_error("last_write_time of {}: {}", full_name, ec.message());
+  if (request.minSize > 0 && entry.size < request.minSize)
     return false;
-  }
 
-  if (request.minSize > 0 && file_size < request.minSize)
+  if (request.maxSize > 0 && entry.size > request.maxSize)
     return false;
 
-  if (request.maxSize > 0 && file_size > request.maxSize)
-    return false;
-
-  auto fileAge = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::file_clock::now() - modifiedTime);
+  auto fileAge = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::system_clock::now() - entry.last_modified);
   if (request.minAge > 0ms && fileAge < request.minAge)
     return false;
   if (request.maxAge > 0ms && fileAge > request.maxAge)
     return false;
 
-  if (request.ignoreHiddenFile && utils::file::is_hidden(full_name))
+  if (request.ignoreHiddenFile && utils::file::is_hidden(entry.fullPath()))
     return false;
 
-  utils::Regex rgx(request.fileFilter);
-  if (!utils::regexMatch(name.string(), rgx)) {
+  if (!utils::regexMatch(entry.filename.string(), file_filter_regex_)) {
     return false;
   }
 
   auto* const getfile_metrics = dynamic_cast<GetFileMetrics*>(metrics_extension_.get());
   gsl_Assert(getfile_metrics);
-  getfile_metrics->input_bytes += file_size;
+  getfile_metrics->input_bytes += entry.size;
   ++getfile_metrics->accepted_files;
   return true;
 }
 
 void GetFile::performListing(const GetFileRequest &request) {
-  auto callback = [this, request](const std::filesystem::path& dir, const std::filesystem::path& filename) -> bool {
-    auto fullpath = dir / filename;
-    if (fileMatchesRequestCriteria(fullpath, filename, request)) {
-      putListing(fullpath);
+  // the size and the modification time are read by the listing, so the files are not stat'ed again
+  const auto entries = utils::file::list_dir_entries(request.inputDirectory, [&request](const std::filesystem::path&) { return request.recursive; },
+      request.listingThreadCount, logger_);
+  std::vector<std::filesystem::path> file_paths;
+  for (const auto& entry : entries) {
+    if (fileMatchesRequestCriteria(entry, request)) {
+      file_paths.push_back(entry.fullPath());
     }
-    return true;
-  };
-  utils::file::list_dir(request.inputDirectory, callback, logger_, request.recursive);
+  }
+  putListing(std::move(file_paths));
 }
 
 REGISTER_RESOURCE(GetFile, Processor);
@@ -35,6 +35,8 @@
 #include "core/logging/LoggerFactory.h"
 #include "minifi-cpp/utils/Export.h"
 #include "minifi-cpp/core/ProcessorMetricsExtension.h"
+#include "utils/RegexUtils.h"
+#include "utils/file/DirectoryLister.h"
 
 namespace org::apache::nifi::minifi::processors {
 
@@ -49,6 +51,7 @@ struct GetFileRequest {
   std::chrono::milliseconds pollInterval{0};
   uint64_t batchSize = 10;
   std::string fileFilter = ".*";
+  uint64_t listingThreadCount = 1;
   std::filesystem::path inputDirectory;
 };
 
@@ -144,6 +147,13 @@ class GetFile : public core::ProcessorImpl {
       .withDescription("Only files whose names match the given regular expression will be picked up")
       .withDefaultValue(".*")
       .build();
+  EXTENSIONAPI static constexpr auto ListingThreadCount = core::PropertyDefinitionBuilder<>::createProperty("Listing Thread Count")
+      .withDescription("The number of threads listing the input directory. The subdirectories are distributed among the threads, "
+          "so more than one thread only speeds up the listing of directory trees.")
+      .isRequired(true)
+      .withValidator(core::StandardPropertyValidators::UNSIGNED_INTEGER_VALIDATOR)
+      .withDefaultValue("1")
+      .build();
   EXTENSIONAPI static constexpr auto Properties = std::to_array<core::PropertyReference>({
       Directory,
       Recurse,
@@ -155,7 +165,8 @@ class GetFile : public core::ProcessorImpl {
       IgnoreHiddenFile,
       PollInterval,
       BatchSize,
-      FileFilter
+      FileFilter,
+      ListingThreadCount
   });
 
 
@@ -181,12 +192,13 @@ class GetFile : public core::ProcessorImpl {
 
  private:
   bool isListingEmpty() const;
-  void putListing(const std::filesystem::path& file_path);
+  void putListing(std::vector<std::filesystem::path>&& file_paths);
   std::queue<std::filesystem::path> pollListing(uint64_t batch_size);
-  bool fileMatchesRequestCriteria(const std::filesystem::path& full_name, const std::filesystem::path& name, const GetFileRequest &request);
+  bool fileMatchesRequestCriteria(const utils::file::DirectoryEntry& entry, const GetFileRequest &request);
   void getSingleFile(core::ProcessSession& session, const std::filesystem::path& file_path) const;
 
   GetFileRequest request_;
+  utils::Regex file_filter_regex_;
   std::queue<std::filesystem::path> directory_listing_;
   mutable std::mutex directory_listing_mutex_;
   std::atomic<std::chrono::time_point<std::chrono::system_clock>> last_listing_time_{};
@@ -17,20 +17,175 @@
  * See the License for the specific language governing permissions and
  * limitations under the License.
  */
+#include "HashContent.h"
+
+#include <openssl/evp.h>
+#include <openssl/md5.h>
+#include <openssl/sha.h>
+
+#define XXH_INLINE_ALL
+#include <xxhash.h>
+#include <blake3.h>
+
 #include <algorithm>
-#include <iostream>
+#include <array>
+#include <map>
 #include <memory>
 #include <string>
 #include <utility>
 
-#include "HashContent.h"
 #include "minifi-cpp/core/ProcessContext.h"
 #include "core/ProcessSession.h"
 #include "minifi-cpp/core/FlowFile.h"
 #include "core/Resource.h"
+#include "utils/StringUtils.h"
 
 #include "range/v3/view.hpp"
 
+namespace org::apache::nifi::minifi::processors::hash_content {
+
+namespace {
+
+// large enough to make the per-read overhead of the content streams negligible next to hashing
+constexpr size_t HASH_BUFFER_SIZE = 256 * 1024;
+
+class EvpDigest : public Digest {
+ public:
+  EvpDigest(EVP_MD* message_digest, size_t digest_length)
+      : context_(EVP_MD_CTX_new()),
+        message_digest_(message_digest),
+        digest_length_(digest_length) {
+    EVP_DigestInit_ex(context_, message_digest_, nullptr);
+  }
+
+  EvpDigest(const EvpDigest&) = delete;
+  EvpDigest(EvpDigest&&) = delete;
+  EvpDigest& operator=(const EvpDigest&) = delete;
+  EvpDigest& operator=(EvpDigest&&) = delete;
+
+  ~EvpDigest() override {
+    EVP_MD_free(message_digest_);
+    EVP_MD_CTX_free(context_);
+  }
+
+  void update(std::span<const std::byte> data) override {
+    EVP_DigestUpdate(context_, data.data(), data.size());
+  }
+
+  std::string finalize() override {
+    std::vector<std::byte> digest(digest_length_);
+    EVP_DigestFinal_ex(context_, reinterpret_cast<unsigned char*>(digest.data()), nullptr);
+    return utils::string::to_hex(digest, true /*uppercase*/);
+  }
+
+ private:
+  EVP_MD_CTX* context_;
+  EVP_MD* message_digest_;
+  size_t digest_length_;
+};
+
+class Xxh3Digest : public Digest {
+ public:
+  Xxh3Digest() : state_(XXH3_createState()) {
+    XXH3_64bits_reset(state_);
+  }
+
+  Xxh3Digest(const Xxh3Digest&) = delete;
+  Xxh3Digest(Xxh3Digest&&) = delete;
+  Xxh3Digest& operator=(const Xxh3Digest&) = delete;
+  Xxh3Digest& operator=(Xxh3Digest&&) = delete;
+
+  ~Xxh3Digest() override {
+    XXH3_freeState(state_);
+  }
+
+  void update(std::span<const std::byte> data) override {
+    XXH3_64bits_update(state_, data.data(), data.size());
+  }
+
+  std::string finalize() override {
+    XXH64_canonical_t canonical{};
+    XXH64_canonicalFromHash(&canonical, XXH3_64bits_digest(state_));
+    return utils::string::to_hex(std::as_bytes(std::span(canonical.digest)), true /*uppercase*/);
+  }
+
+ private:
+  XXH3_state_t* state_;
+};
+
+class Blake3Digest : public Digest {
+ public:
+  Blake3Digest() {
+    blake3_hasher_init(&hasher_);
+  }
+
+  void update(std::span<const std::byte> data) override {
+    blake3_hasher_update(&hasher_, data.data(), data.size());
+  }
+
+  std::string finalize() override {
+    std::array<std::byte, BLAKE3_OUT_LEN> digest{};
+    blake3_hasher_finalize(&hasher_, reinterpret_cast<uint8_t*>(digest.data()), digest.size());
+    return utils::string::to_hex(digest, true /*uppercase*/);
+  }
+
+ private:
+  blake3_hasher hasher_{};
+};
+
+std::unique_ptr<Digest> createEvpDigest(const char* name, const char* properties, size_t digest_length) {
+  EVP_MD* message_digest = EVP_MD_fetch(nullptr, name, properties);
+  if (!message_digest) {
+    return nullptr;
+  }
+  return std::make_unique<EvpDigest>(message_digest, digest_length);
+}
+
+const std::map<std::string_view, std::unique_ptr<Digest>(*)()> DIGEST_FACTORIES{
+  // MD5 is not allowed in FIPS mode, so it is fetched from a non-FIPS provider
+  {"MD5", [] { return createEvpDigest("MD5", "-fips", MD5_DIGEST_LENGTH); }},
+  {"SHA1", [] { return createEvpDigest("SHA1", nullptr, SHA_DIGEST_LENGTH); }},
+  {"SHA256", [] { return createEvpDigest("SHA256", nullptr, SHA256_DIGEST_LENGTH); }},
+  {"XXH3", [] () -> std::unique_ptr<Digest> { return std::make_unique<Xxh3Digest>(); }},
+  {"BLAKE3", [] () -> std::unique_ptr<Digest> { return std::make_unique<Blake3Digest>(); }}
+};
+
+}  // namespace
+
+std::unique_ptr<Digest> createDigest(std::string_view algorithm_name) {
+  const auto factory = DIGEST_FACTORIES.find(algorithm_name);
+  if (factory == DIGEST_FACTORIES.end()) {
+    return nullptr;
+  }
+  return factory->second();
+}
+
+std::vector<std::string_view> supportedAlgorithms() {
+  return ranges::views::keys(DIGEST_FACTORIES) | ranges::to<std::vector<std::string_view>>();
+}
+
+std::optional<uint64_t> updateDigests(io::InputStream& stream, std::span<const std::unique_ptr<Digest>> digests) {
+  std::vector<std::byte> buffer(HASH_BUFFER_SIZE);
+  uint64_t total_read = 0;
+  while (true) {
+    const auto ret = stream.read(buffer);
+    if (io::isError(ret)) {
+      return std::nullopt;
+    }
+    if (ret == 0) {
+      break;
+    }
+    const auto data = std::span(buffer).subspan(0, ret);
+    for (const auto& digest : digests) {
+      digest->update(data);
+    }
+    total_read += ret;
+  }
+  return total_read;
+}
+
+}  // namespace org::apache::nifi::minifi::processors::hash_content
+
 namespace org::apache::nifi::minifi::processors {
 
 void HashContent::initialize() {
@@ -42,15 +197,22 @@ void HashContent::onSchedule(core::ProcessContext& context, core::ProcessSession
   attrKey_ = context.getProperty(HashAttribute) | utils::orThrow("Missing HashContent::HashAttribute despite default value");
   failOnEmpty_ = context.getProperty(FailOnEmpty) | utils::andThen(parsing::parseBool) | utils::orThrow("Missing HashContent::FailOnEmpty despite default value");
 
-  {
-    std::string algo_name = context.getProperty(HashAlgorithm) | utils::orThrow("HashContent::HashAlgorithm is required property");
+  algorithms_.clear();
+  const std::string algorithm_names = context.getProperty(HashAlgorithm) | utils::orThrow("HashContent::HashAlgorithm is required property");
+  for (auto algo_name : utils::string::splitAndTrimRemovingEmpty(algorithm_names, ",")) {
     std::transform(algo_name.begin(), algo_name.end(), algo_name.begin(), ::toupper);
     std::erase(algo_name, '-');
-    if (!HashAlgos.contains(algo_name)) {
-      const auto supported_algorithms = ranges::views::keys(HashAlgos) | ranges::views::join(std::string_view(", ")) | ranges::to<std::string>();
-      throw Exception(PROCESS_SCHEDULE_EXCEPTION, algo_name + " is not supported, supported algorithms are: " + supported_algorithms);
+    if (!hash_content::createDigest(algo_name)) {
+      const auto supported_algorithms = hash_content::supportedAlgorithms();
+      throw Exception(PROCESS_SCHEDULE_EXCEPTION, algo_name + " is not supported, supported algorithms are: "
+          + (supported_algorithms | ranges::views::join(std::string_view(", ")) | ranges::to<std::string>()));
     }
-    algorithm_ = HashAlgos.at(algo_name);
+    if (std::find(algorithms_.begin(), algorithms_.end(), algo_name) == algorithms_.end()) {
+      algorithms_.push_back(std::move(algo_name));
+    }
+  }
+  if (algorithms_.empty()) {
+    throw Exception(PROCESS_SCHEDULE_EXCEPTION, "HashContent::HashAlgorithm does not contain any algorithm");
   }
 }
 
@@ -68,12 +230,23 @@ void HashContent::onTrigger(core::ProcessContext&, core::ProcessSession& session
     return;
   }
 
-  logger_->log_trace("attempting read");
-  session.read(flowFile, [&flowFile, this](const std::shared_ptr<io::InputStream>& stream) -> io::IoResult {
-    const auto& ret_val = algorithm_(stream);
-    flowFile->setAttribute(attrKey_, ret_val.first);
+  std::vector<std::unique_ptr<hash_content::Digest>> digests;
+  for (const auto& algorithm : algorithms_) {
+    digests.push_back(hash_content::createDigest(algorithm));
+  }
 
-    return io::IoResult::from(ret_val.second);
+  logger_->log_trace("attempting read");
+  session.read(flowFile, [&flowFile, &digests, this](const std::shared_ptr<io::InputStream>& stream) -> io::IoResult {
+    const auto read_size = hash_content::updateDigests(*stream, digests);
+    if (!read_size) {
+      return io::IoResult::error();
+    }
+    for (size_t i = 0; i < algorithms_.size(); ++i) {
+      // the checksum of an empty content is left empty
+      std::string checksum = *read_size > 0 ? digests[i]->finalize() : "";
+      flowFile->setAttribute(algorithms_.size() == 1 ? attrKey_ : attrKey_ + "." + algorithms_[i], std::move(checksum));
+    }
+    return io::IoResult::from(*read_size);
   });
   session.transfer(flowFile, Success);
 }
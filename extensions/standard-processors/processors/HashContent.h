@@ -19,125 +19,47 @@
  */
 #pragma once
 
-#include <openssl/evp.h>
-#include <openssl/sha.h>
-#include <openssl/md5.h>
-
-#include <array>
 #include <cstdint>
-#include <iomanip>
-#include <map>
 #include <memory>
+#include <optional>
+#include <span>
 #include <string>
-#include <sstream>
+#include <string_view>
 #include <utility>
+#include <vector>
 
 #include "core/ProcessorImpl.h"
 #include "minifi-cpp/core/PropertyDefinition.h"
 #include "core/PropertyDefinitionBuilder.h"
 #include "minifi-cpp/core/RelationshipDefinition.h"
 #include "core/ProcessSession.h"
-#include "utils/StringUtils.h"
+#include "minifi-cpp/io/InputStream.h"
 #include "minifi-cpp/utils/Export.h"
 
-using HashReturnType = std::pair<std::string, int64_t>;
-
-// Without puttng this into its own namespace, the code would export already defined symbols.
-namespace { // NOLINT
-#define HASH_BUFFER_SIZE 16384
-
-  HashReturnType MD5Hash(const std::shared_ptr<org::apache::nifi::minifi::io::InputStream>& stream) {
-    HashReturnType ret_val;
-    ret_val.second = 0;
-    std::array<std::byte, HASH_BUFFER_SIZE> buffer{};
-    EVP_MD_CTX *context = EVP_MD_CTX_new();
-    EVP_MD *md5 = EVP_MD_fetch(nullptr, "MD5", "-fips");
-    const auto guard = gsl::finally([&context, &md5]() {
-      EVP_MD_free(md5);
-      EVP_MD_CTX_free(context);
-    });
-    if (!md5) {
-      return ret_val;
-    }
-    EVP_DigestInit_ex(context, md5, nullptr);
-
-    size_t ret = 0;
-    do {
-      ret = stream->read(buffer);
-      if (ret > 0) {
-        EVP_DigestUpdate(context, buffer.data(), ret);
-        ret_val.second += gsl::narrow<int64_t>(ret);
-      }
-    } while (ret > 0);
-
-    if (ret_val.second > 0) {
-      std::array<std::byte, MD5_DIGEST_LENGTH> digest{};
-      EVP_DigestFinal_ex(context, reinterpret_cast<unsigned char*>(digest.data()), nullptr);
-      ret_val.first = org::apache::nifi::minifi::utils::string::to_hex(digest, true /*uppercase*/);
-    }
-    return ret_val;
-  }
-
-  HashReturnType SHA1Hash(const std::shared_ptr<org::apache::nifi::minifi::io::InputStream>& stream) {
-    HashReturnType ret_val;
-    ret_val.second = 0;
-    std::array<std::byte, HASH_BUFFER_SIZE> buffer{};
-    EVP_MD_CTX *context = EVP_MD_CTX_new();
-    const auto guard = gsl::finally([&context]() {
-      EVP_MD_CTX_free(context);
-    });
-    EVP_DigestInit_ex(context, EVP_sha1(), nullptr);
-
-    size_t ret = 0;
-    do {
-      ret = stream->read(buffer);
-      if (ret > 0) {
-        EVP_DigestUpdate(context, buffer.data(), ret);
-        ret_val.second += gsl::narrow<int64_t>(ret);
-      }
-    } while (ret > 0);
-
-    if (ret_val.second > 0) {
-      std::array<std::byte, SHA_DIGEST_LENGTH> digest{};
-      EVP_DigestFinal_ex(context, reinterpret_cast<unsigned char*>(digest.data()), nullptr);
-      ret_val.first = org::apache::nifi::minifi::utils::string::to_hex(digest, true /*uppercase*/);
-    }
-    return ret_val;
-  }
-
-  HashReturnType SHA256Hash(const std::shared_ptr<org::apache::nifi::minifi::io::InputStream>& stream) {
-    HashReturnType ret_val;
-    ret_val.second = 0;
-    std::array<std::byte, HASH_BUFFER_SIZE> buffer{};
-    EVP_MD_CTX *context = EVP_MD_CTX_new();
-    const auto guard = gsl::finally([&context]() {
-      EVP_MD_CTX_free(context);
-    });
-    EVP_DigestInit_ex(context, EVP_sha256(), nullptr);
-
-    size_t ret;
-    do {
-      ret = stream->read(buffer);
-      if (ret > 0) {
-        EVP_DigestUpdate(context, buffer.data(), ret);
-        ret_val.second += gsl::narrow<int64_t>(ret);
-      }
-    } while (ret > 0);
-
-    if (ret_val.second > 0) {
-      std::array<std::byte, SHA256_DIGEST_LENGTH> digest{};
-      EVP_DigestFinal_ex(context, reinterpret_cast<unsigned char*>(digest.data()), nullptr);
-      ret_val.first = org::apache::nifi::minifi::utils::string::to_hex(digest, true /*uppercase*/);
-    }
-    return ret_val;
-  }
-}  // namespace
+namespace org::apache::nifi::minifi::processors::hash_content {
 
+class Digest {
+ public:
+  virtual ~Digest() = default;
 
-namespace org::apache::nifi::minifi::processors {
+  virtual void update(std::span<const std::byte> data) = 0;
+  // returns the upper case hex representation of the digest
+  virtual std::string finalize() = 0;
+};
+
+// the names are upper case, without dashes: MD5, SHA1, SHA256, XXH3, BLAKE3
+std::unique_ptr<Digest> createDigest(std::string_view algorithm_name);
+std::vector<std::string_view> supportedAlgorithms();
 
-static const std::map<std::string, const std::function<HashReturnType(const std::shared_ptr<io::InputStream>&)>> HashAlgos =
-  { {"MD5",  MD5Hash}, {"SHA1", SHA1Hash}, {"SHA256", SHA256Hash} };
+/**
+ * Reads the stream once, and updates every digest with each buffer read.
+ * Returns the number of bytes read, or std::nullopt on a read error.
+ */
+std::optional<uint64_t> updateDigests(io::InputStream& stream, std::span<const std::unique_ptr<Digest>> digests);
+
+}  // namespace org::apache::nifi::minifi::processors::hash_content
+
+namespace org::apache::nifi::minifi::processors {
 
 class HashContent : public core::ProcessorImpl {
  public:
@@ -151,7 +73,9 @@ class HashContent : public core::ProcessorImpl {
       .withDefaultValue("Checksum")
       .build();
   EXTENSIONAPI static constexpr auto HashAlgorithm = core::PropertyDefinitionBuilder<>::createProperty("Hash Algorithm")
-      .withDescription("Name of the algorithm used to generate checksum")
+      .withDescription("Name of the algorithm used to generate checksum: MD5, SHA1, SHA256, or the non-cryptographic XXH3 and the fast cryptographic BLAKE3. "
+          "A comma-separated list of algorithms computes every checksum while reading the content once; "
+          "in this case each checksum is stored in the attribute named by the Hash Attribute and the algorithm, e.g. Checksum.SHA256")
       .withDefaultValue("SHA256")
       .isRequired(true)
       .build();
@@ -183,7 +107,7 @@ class HashContent : public core::ProcessorImpl {
   void initialize() override;
 
  private:
-  std::function<HashReturnType(const std::shared_ptr<io::InputStream>&)> algorithm_ = SHA256Hash;
+  std::vector<std::string> algorithms_;
   std::string attrKey_;
   bool failOnEmpty_{};
 };
@@ -20,6 +20,7 @@
 
 #include <cinttypes>
 #include <functional>
+#include <list>
 #include <memory>
 #include <string>
 #include <utility>
@@ -167,6 +168,9 @@ void InvokeHTTP::setupMembersFromProperties(const core::ProcessContext& context)
   content_type_ = utils::parseProperty(context, InvokeHTTP::ContentType);  // Shouldn't fail due to default value;
 
   ssl_context_service_ = utils::parseOptionalControllerService<minifi::controllers::SSLContextServiceInterface>(context, SSLContext, getUUID());
+
+  max_in_flight_requests_ = gsl::narrow<size_t>(std::max(uint64_t{1}, utils::parseU64Property(context, MaxInFlightRequests)));
+  http_version_ = utils::parseEnumProperty<http::HttpVersion>(context, HttpVersion);
 }
 
 gsl::not_null<std::unique_ptr<http::HTTPClient>> InvokeHTTP::createHTTPClientFromMembers(const std::string& url) const {
@@ -184,6 +188,12 @@ gsl::not_null<std::unique_ptr<http::HTTPClient>> InvokeHTTP::createHTTPClientFro
   if (maximum_download_speed_) {
     client->setMaximumDownloadSpeed(*maximum_download_speed_);
   }
+  if (http_version_ != http::HttpVersion::Http1_1) {
+    client->setHttpVersion(http_version_);
+  }
+  if (connection_share_) {
+    client->setConnectionShare(connection_share_);
+  }
 
   return gsl::make_not_null(std::move(client));
 }
@@ -197,7 +207,9 @@ void InvokeHTTP::onSchedule(core::ProcessContext& context, core::ProcessSessionF
     return createHTTPClientFromMembers(url);
   };
 
-  client_queue_ = std::make_unique<invoke_http::HttpClientStore>(context.getMaxConcurrentTasks() * 2, create_client);
+  connection_share_ = max_in_flight_requests_ > 1 ? std::make_shared<http::HTTPConnectionShare>() : nullptr;
+  // every task may hold max_in_flight_requests_ clients at the same time
+  client_queue_ = std::make_unique<invoke_http::HttpClientStore>(context.getMaxConcurrentTasks() * std::max(size_t{2}, max_in_flight_requests_), create_client);
 }
 
 bool InvokeHTTP::shouldEmitFlowFile() const {
@@ -256,6 +268,11 @@ void InvokeHTTP::onTrigger(core::ProcessContext& context, core::ProcessSession&
     logger_->log_debug("InvokeHTTP -- Received flowfile");
   }
 
+  if (max_in_flight_requests_ > 1) {
+    onTriggerMultiplexed(context, session, std::move(flow_file));
+    return;
+  }
+
   auto url = context.getProperty(URL, flow_file.get());
   if (!url || url->empty()) {
     logger_->log_error("InvokeHTTP -- URL is empty, transferring to failure");
@@ -267,6 +284,63 @@ void InvokeHTTP::onTrigger(core::ProcessContext& context, core::ProcessSession&
   onTriggerWithClient(context, session, flow_file, client.get());
 }
 
+namespace {
+struct InFlightRequest {
+  InFlightRequest(invoke_http::HttpClientStore& client_store, const std::string& url, std::shared_ptr<core::FlowFile> flow_file)
+      : client(client_store.getClient(url)),
+        flow_file(std::move(flow_file)),
+        transaction_id(utils::IdGenerator::getIdGenerator()->generate().to_string()) {
+  }
+
+  invoke_http::HttpClientStore::HttpClientWrapper client;
+  std::shared_ptr<core::FlowFile> flow_file;
+  std::string transaction_id;
+};
+}  // namespace
+
+void InvokeHTTP::onTriggerMultiplexed(core::ProcessContext& context, core::ProcessSession& session, std::shared_ptr<core::FlowFile> first_flow_file) {
+  std::list<InFlightRequest> requests;
+  std::unordered_map<http::HTTPClient*, InFlightRequest*> requests_by_client;
+  http::MultiHTTPClient multi_client(http_version_ == http::HttpVersion::Http2);
+
+  size_t flow_files_taken = 0;
+  for (auto flow_file = std::move(first_flow_file); flow_file; flow_file = ++flow_files_taken < max_in_flight_requests_ ? session.get() : nullptr) {
+    auto url = context.getProperty(URL, flow_file.get());
+    if (!url || url->empty()) {
+      logger_->log_error("InvokeHTTP -- URL is empty, transferring to failure");
+      session.transfer(flow_file, RelFailure);
+      continue;
+    }
+
+    auto& request = requests.emplace_back(*client_queue_, *url, flow_file);
+    http::HTTPClient& client = request.client.get();
+    logger_->log_debug("onTrigger InvokeHTTP with {} to {}", magic_enum::enum_name(method_), client.getURL());
+    if (!prepareRequest(session, flow_file, client)) {
+      client.setUploadCallback({});
+      session.transfer(flow_file, RelFailure);
+      requests.pop_back();
+      continue;
+    }
+    if (!multi_client.addRequest(client)) {
+      client.setUploadCallback({});
+      session.penalize(flow_file);
+      session.transfer(flow_file, RelFailure);
+      requests.pop_back();
+      continue;
+    }
+    requests_by_client.emplace(&client, &request);
+  }
+
+  logger_->log_debug("InvokeHTTP -- performing {} requests concurrently", multi_client.size());
+  multi_client.performAll([&](http::HTTPClient& client, bool submit_succeeded) {
+    const auto remove_callback_from_client_at_exit = gsl::finally([&client] {
+      client.setUploadCallback({});
+    });
+    const InFlightRequest& request = *requests_by_client.at(&client);
+    processResponse(context, session, request.flow_file, client, request.transaction_id, submit_succeeded);
+  });
+}
+
 void InvokeHTTP::onTriggerWithClient(core::ProcessContext& context, core::ProcessSession& session,
     const std::shared_ptr<core::FlowFile>& flow_file, minifi::http::HTTPClient& client) {
   logger_->log_debug("onTrigger InvokeHTTP with {} to {}", magic_enum::enum_name(method_), client.getURL());
@@ -277,6 +351,20 @@ void InvokeHTTP::onTriggerWithClient(core::ProcessContext& context, core::Proces
 
   std::string transaction_id = utils::IdGenerator::getIdGenerator()->generate().to_string();
 
+  if (!prepareRequest(session, flow_file, client)) {
+    session.transfer(flow_file, RelFailure);
+    return;
+  }
+
+  logger_->log_trace("InvokeHTTP -- curl performed");
+  processResponse(context, session, flow_file, client, transaction_id, client.submit());
+}
+
+/**
+ * Sets up the body and the headers of the request of flow_file
+ * @return false when the flow file should be routed to failure, true otherwise
+ */
+bool InvokeHTTP::prepareRequest(core::ProcessSession& session, const std::shared_ptr<core::FlowFile>& flow_file, http::HTTPClient& client) {
   if (shouldEmitFlowFile()) {
     logger_->log_trace("InvokeHTTP -- reading flowfile");
     const auto flow_file_reader_stream = session.getFlowFileContentStream(*flow_file);
@@ -311,13 +399,12 @@ void InvokeHTTP::onTriggerWithClient(core::ProcessContext& context, core::Proces
   }
 
   const auto append_header = [&](const std::string& key, const std::string& value) { client.setRequestHeader(key, value); };
-  if (!appendHeaders(*flow_file, append_header)) {
-    session.transfer(flow_file, RelFailure);
-    return;
-  }
+  return appendHeaders(*flow_file, append_header);
+}
 
-  logger_->log_trace("InvokeHTTP -- curl performed");
-  if (client.submit()) {
+void InvokeHTTP::processResponse(core::ProcessContext& context, core::ProcessSession& session, const std::shared_ptr<core::FlowFile>& flow_file,
+    http::HTTPClient& client, const std::string& transaction_id, bool submit_succeeded) {
+  if (submit_succeeded) {
     logger_->log_trace("InvokeHTTP -- curl successful");
 
     const std::vector<char>& response_body = client.getResponseBody();
@@ -39,6 +39,7 @@
 #include "utils/Id.h"
 #include "utils/ResourceQueue.h"
 #include "http/HTTPClient.h"
+#include "http/MultiHTTPClient.h"
 #include "minifi-cpp/utils/Export.h"
 #include "utils/Enum.h"
 #include "utils/RegexUtils.h"
@@ -253,6 +254,20 @@ class InvokeHTTP : public core::ProcessorImpl {
       .withDescription("Maximum download speed,e.g. '500 KB/s'. Leave this empty if you want no limit.")
       .withValidator(invoke_http::DATA_TRANSFER_SPEED_VALIDATOR)
       .build();
+  EXTENSIONAPI static constexpr auto MaxInFlightRequests = core::PropertyDefinitionBuilder<>::createProperty("Max In-Flight Requests")
+      .withDescription("The maximum number of requests one trigger keeps in flight. If greater than 1, up to this many flow files are taken "
+          "from the input queue at once and their requests are performed concurrently, reusing the connections opened in the same trigger "
+          "and sharing the DNS cache and TLS sessions between all tasks of the processor. Each response is routed with the flow file of its request.")
+      .withValidator(core::StandardPropertyValidators::UNSIGNED_INTEGER_VALIDATOR)
+      .withDefaultValue("1")
+      .build();
+  EXTENSIONAPI static constexpr auto HttpVersion = core::PropertyDefinitionBuilder<magic_enum::enum_count<http::HttpVersion>()>::createProperty("HTTP Version")
+      .withDescription("The HTTP version to use. HTTP/2 is negotiated on HTTPS connections and falls back to HTTP/1.1 if the server does not support it. "
+          "With Max In-Flight Requests greater than 1, concurrent requests to the same HTTP/2 server are multiplexed over a single connection. "
+          "Requires libcurl built with HTTP/2 support.")
+      .withAllowedValues(magic_enum::enum_names<http::HttpVersion>())
+      .withDefaultValue(magic_enum::enum_name(http::HttpVersion::Http1_1))
+      .build();
 
   EXTENSIONAPI static constexpr auto Properties = std::to_array<core::PropertyReference>({
         Method,
@@ -277,7 +292,9 @@ class InvokeHTTP : public core::ProcessorImpl {
         PenalizeOnNoRetry,
         InvalidHTTPHeaderFieldHandlingStrategy,
         UploadSpeedLimit,
-        DownloadSpeedLimit
+        DownloadSpeedLimit,
+        MaxInFlightRequests,
+        HttpVersion
   });
 
 
@@ -339,6 +356,10 @@ class InvokeHTTP : public core::ProcessorImpl {
   [[nodiscard]] bool shouldEmitFlowFile() const;
   void onTriggerWithClient(core::ProcessContext& context, core::ProcessSession& session,
       const std::shared_ptr<core::FlowFile>& flow_file, http::HTTPClient& client);
+  void onTriggerMultiplexed(core::ProcessContext& context, core::ProcessSession& session, std::shared_ptr<core::FlowFile> first_flow_file);
+  [[nodiscard]] bool prepareRequest(core::ProcessSession& session, const std::shared_ptr<core::FlowFile>& flow_file, http::HTTPClient& client);
+  void processResponse(core::ProcessContext& context, core::ProcessSession& session, const std::shared_ptr<core::FlowFile>& flow_file,
+      http::HTTPClient& client, const std::string& transaction_id, bool submit_succeeded);
   [[nodiscard]] bool appendHeaders(const core::FlowFile& flow_file, std::invocable<std::string, std::string> auto append_header);
 
 
@@ -365,6 +386,9 @@ class InvokeHTTP : public core::ProcessorImpl {
   bool follow_redirects_ = false;
   std::optional<std::string> content_type_;
   invoke_http::InvalidHTTPHeaderFieldHandlingOption invalid_http_header_field_handling_strategy_{};
+  size_t max_in_flight_requests_{1};
+  http::HttpVersion http_version_{http::HttpVersion::Http1_1};
+  std::shared_ptr<http::HTTPConnectionShare> connection_share_;
   std::unique_ptr<invoke_http::HttpClientStore> client_queue_;
 };
 
@@ -17,12 +17,13 @@
 
 #include "JoltTransformJSON.h"
 
+#include <algorithm>
 
 #include "core/Resource.h"
 #include "rapidjson/document.h"
 #include "rapidjson/error/en.h"
-#include "rapidjson/stringbuffer.h"
 #include "rapidjson/writer.h"
+#include "../utils/JsonStreams.h"
 #include "utils/ProcessorConfigUtils.h"
 #include "utils/StringUtils.h"
 
@@ -51,20 +52,43 @@ void JoltTransformJSON::onTrigger(core::ProcessContext& context, core::ProcessSe
     return;
   }
 
-  auto content = session.readBuffer(flowfile);
-  rapidjson::Document input;
-  rapidjson::ParseResult parse_result = input.Parse(reinterpret_cast<const char*>(content.buffer.data()), content.buffer.size());
+  // both documents allocate from a reused buffer, which grows until the documents of typical flow files fit into it
+  auto arena = acquireArena();
+  size_t allocated_size = 0;
+  {
+    rapidjson::MemoryPoolAllocator<> allocator(arena.data(), arena.size());
+    transformFlowFile(session, flowfile, allocator);
+    allocated_size = allocator.Size();
+  }
+  arena.resize(std::clamp(allocated_size + ARENA_OVERHEAD, arena.size(), MAX_ARENA_SIZE));
+  releaseArena(std::move(arena));
+}
+
+void JoltTransformJSON::transformFlowFile(core::ProcessSession& session, const std::shared_ptr<core::FlowFile>& flowfile, rapidjson::MemoryPoolAllocator<>& allocator) const {
+  rapidjson::Document input(&allocator);
+  rapidjson::ParseResult parse_result{rapidjson::kParseErrorDocumentEmpty, 0};
+  session.read(flowfile, [&](const std::shared_ptr<io::InputStream>& input_stream) -> io::IoResult {
+    utils::json::InputStreamJsonSource source(*input_stream);
+    parse_result = input.ParseStream(source);
+    if (source.failed()) {
+      return io::IoResult::error();
+    }
+    return io::IoResult::from(source.Tell());
+  });
   if (!parse_result) {
     logger_->log_warn("Failed to parse flowfile content as json: {} ({})", rapidjson::GetParseError_En(parse_result.Code()), gsl::narrow<size_t>(parse_result.Offset()));
     session.transfer(flowfile, Failure);
     return;
   }
 
-  if (auto result = spec_->process(input, logger_)) {
-    rapidjson::StringBuffer buffer;
-    rapidjson::Writer<rapidjson::StringBuffer> writer(buffer);
-    result.value().Accept(writer);
-    session.writeBuffer(flowfile, std::span<const char>(buffer.GetString(), buffer.GetSize()));
+  if (auto result = spec_->process(input, allocator, logger_)) {
+    session.write(flowfile, [&](const std::shared_ptr<io::OutputStream>& output_stream) -> io::IoResult {
+      utils::json::OutputStreamJsonSink sink(*output_stream);
+      rapidjson::Writer<utils::json::OutputStreamJsonSink> writer(sink);
+      result.value().Accept(writer);
+      sink.Flush();
+      return sink.failed() ? io::IoResult::error() : io::IoResult::zero();
+    });
     session.transfer(flowfile, Success);
   } else {
     logger_->log_info("Failed to apply transformation: {}", result.error());
@@ -72,6 +96,21 @@ void JoltTransformJSON::onTrigger(core::ProcessContext& context, core::ProcessSe
   }
 }
 
+std::vector<char> JoltTransformJSON::acquireArena() {
+  std::lock_guard lock(arena_mutex_);
+  if (arenas_.empty()) {
+    return std::vector<char>(INITIAL_ARENA_SIZE);
+  }
+  auto arena = std::move(arenas_.back());
+  arenas_.pop_back();
+  return arena;
+}
+
+void JoltTransformJSON::releaseArena(std::vector<char> arena) {
+  std::lock_guard lock(arena_mutex_);
+  arenas_.push_back(std::move(arena));
+}
+
 REGISTER_RESOURCE(JoltTransformJSON, Processor);
 
 }  // namespace org::apache::nifi::minifi::processors
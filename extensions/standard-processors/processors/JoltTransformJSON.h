@@ -17,7 +17,10 @@
 
 #pragma once
 
+#include <memory>
+#include <mutex>
 #include <string>
+#include <vector>
 
 #include "core/ProcessorImpl.h"
 #include "minifi-cpp/core/ProcessContext.h"
@@ -81,8 +84,18 @@ class JoltTransformJSON : public core::ProcessorImpl {
   void initialize() override;
 
  private:
+  static constexpr size_t INITIAL_ARENA_SIZE = 64 * 1024;
+  static constexpr size_t MAX_ARENA_SIZE = 16 * 1024 * 1024;
+  static constexpr size_t ARENA_OVERHEAD = 1024;  // allocator bookkeeping stored in the buffer
+
+  void transformFlowFile(core::ProcessSession& session, const std::shared_ptr<core::FlowFile>& flowfile, rapidjson::MemoryPoolAllocator<>& allocator) const;
+  std::vector<char> acquireArena();
+  void releaseArena(std::vector<char> arena);
+
   jolt_transform_json::JoltTransform transform_;
   std::optional<utils::jolt::Spec> spec_;
+  std::mutex arena_mutex_;
+  std::vector<std::vector<char>> arenas_;  // buffers of the rapidjson allocators, reused across flow files and concurrent triggers
 };
 
 }  // namespace org::apache::nifi::minifi::processors
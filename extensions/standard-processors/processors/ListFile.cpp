@@ -18,6 +18,8 @@
 
 
 #include <filesystem>
+#include <iterator>
+#include <utility>
 
 #include "minifi-cpp/core/ProcessContext.h"
 #include "core/Resource.h"
@@ -48,6 +50,15 @@ void ListFile::onSchedule(core::ProcessContext& context, core::ProcessSessionFac
 
 
   file_filter_.ignore_hidden_files = utils::parseBoolProperty(context, IgnoreHiddenFiles);
+
+  listing_thread_count_ = utils::parseU64Property(context, ListingThreadCount);
+  if (utils::parseEnumProperty<utils::file::ChangeDetectionStrategy>(context, ChangeDetection) == utils::file::ChangeDetectionStrategy::FileSystemEvents) {
+    file_change_watcher_ = std::make_unique<utils::file::FileChangeWatcher>();
+  } else {
+    file_change_watcher_.reset();
+  }
+  is_every_directory_watched_ = false;
+  young_files_.clear();
 }
 
 std::shared_ptr<core::FlowFile> ListFile::createFlowFile(core::ProcessSession& session, const utils::ListedFile& listed_file) {
@@ -58,7 +69,7 @@ std::shared_ptr<core::FlowFile> ListFile::createFlowFile(core::ProcessSession& s
   auto relative_path = std::filesystem::relative(listed_file.getPath().parent_path(), listed_file.getDirectory());
   session.putAttribute(*flow_file, core::SpecialFlowAttribute::PATH, (relative_path / "").string());
 
-  session.putAttribute(*flow_file, ListFile::FileSize.name, std::to_string(utils::file::file_size(listed_file.getPath())));
+  session.putAttribute(*flow_file, ListFile::FileSize.name, std::to_string(listed_file.getSize()));
   session.putAttribute(*flow_file, ListFile::FileLastModifiedTime.name, utils::timeutils::getDateTimeStr(std::chrono::time_point_cast<std::chrono::seconds>(listed_file.getLastModified())));
 
   if (auto permission_string = utils::file::FileUtils::get_permission_string(listed_file.getPath())) {
@@ -101,26 +112,77 @@ void ListFile::onTrigger(core::ProcessContext& context, core::ProcessSession& se
   auto latest_listing_state = stored_listing_state;
   uint32_t files_listed = 0;
 
-  auto process_files = [&](const std::filesystem::path& path, const std::filesystem::path& filename) {
-    auto listed_file = utils::ListedFile(path / filename, input_directory_);
+  for (const auto& entry : listFiles()) {
+    auto listed_file = utils::ListedFile(entry, input_directory_);
 
-    if (stored_listing_state.wasObjectListedAlready(listed_file) || !listed_file.matches(file_filter_)) {
-      return true;
+    if (stored_listing_state.wasObjectListedAlready(listed_file)) {
+      continue;
+    }
+    if (!listed_file.matches(file_filter_)) {
+      if (file_change_watcher_ && file_filter_.minimum_file_age && listed_file.getAge() < *file_filter_.minimum_file_age) {
+        young_files_.insert(listed_file.getPath());
+      }
+      continue;
     }
 
     session.transfer(createFlowFile(session, listed_file), Success);
     ++files_listed;
     latest_listing_state.updateState(listed_file);
-    return true;
-  };
-  utils::file::list_dir(input_directory_, process_files, logger_, recurse_subdirectories_);
-
-  listing_state_manager.storeState(latest_listing_state);
+  }
 
   if (files_listed == 0) {
     logger_->log_debug("No new files were found in input directory '{}' to list", input_directory_);
     context.yield();
+    return;
+  }
+
+  // the state only changes when a file is listed, and it can hold many keys, so it is not rewritten in vain
+  listing_state_manager.storeState(latest_listing_state);
+}
+
+std::vector<utils::file::DirectoryEntry> ListFile::listFiles() {
+  if (!file_change_watcher_) {
+    return utils::file::list_dir_entries(input_directory_, [this](const std::filesystem::path&) { return recurse_subdirectories_; }, listing_thread_count_, logger_);
+  }
+
+  auto changed_files = file_change_watcher_->takeChangedFiles();
+  if (!changed_files || !is_every_directory_watched_) {
+    logger_->log_debug("Listing every file in input directory '{}'", input_directory_);
+    young_files_.clear();
+    is_every_directory_watched_ = true;
+    return listDirectory(input_directory_);
+  }
+
+  std::vector<utils::file::DirectoryEntry> entries;
+  changed_files->merge(std::exchange(young_files_, {}));
+  for (const auto& path : *changed_files) {
+    if (auto entry = utils::file::get_directory_entry(path)) {
+      entries.push_back(std::move(*entry));
+    } else if (recurse_subdirectories_ && utils::file::is_directory(path) && !file_change_watcher_->isWatched(path)) {
+      // the files of a new directory may have been created before it could be watched
+      auto directory_entries = listDirectory(path);
+      std::move(directory_entries.begin(), directory_entries.end(), std::back_inserter(entries));
+    }
   }
+  return entries;
+}
+
+std::vector<utils::file::DirectoryEntry> ListFile::listDirectory(const std::filesystem::path& directory) {
+  // a directory is watched before it is read, so no change made during the listing is missed
+  const auto watch = [this](const std::filesystem::path& path) {
+    if (is_every_directory_watched_ && !file_change_watcher_->watch(path)) {
+      logger_->log_debug("Directory '{}' cannot be watched, the input directory will be listed again on the next trigger", path);
+      is_every_directory_watched_ = false;
+    }
+  };
+  watch(directory);
+  return utils::file::list_dir_entries(directory, [this, &watch](const std::filesystem::path& subdirectory) {
+    if (!recurse_subdirectories_) {
+      return false;
+    }
+    watch(subdirectory);
+    return true;
+  }, listing_thread_count_, logger_);
 }
 
 REGISTER_RESOURCE(ListFile, Processor);
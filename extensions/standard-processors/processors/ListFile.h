@@ -19,8 +19,10 @@
 #include <memory>
 #include <optional>
 #include <regex>
+#include <set>
 #include <string>
 #include <utility>
+#include <vector>
 
 #include "minifi-cpp/core/OutputAttributeDefinition.h"
 #include "core/ProcessorImpl.h"
@@ -34,6 +36,8 @@
 #include "utils/ListingStateManager.h"
 #include "utils/file/ListedFile.h"
 #include "utils/file/FileUtils.h"
+#include "utils/file/DirectoryLister.h"
+#include "../utils/FileChangeWatcher.h"
 
 namespace org::apache::nifi::minifi::processors {
 
@@ -86,6 +90,23 @@ class ListFile : public core::ProcessorImpl {
       .withDefaultValue("true")
       .isRequired(true)
       .build();
+  EXTENSIONAPI static constexpr auto ListingThreadCount = core::PropertyDefinitionBuilder<>::createProperty("Listing Thread Count")
+      .withDescription("The number of threads listing the input directory. The subdirectories are distributed among the threads, "
+          "so more than one thread only speeds up the listing of directory trees.")
+      .isRequired(true)
+      .withValidator(core::StandardPropertyValidators::UNSIGNED_INTEGER_VALIDATOR)
+      .withDefaultValue("1")
+      .build();
+  EXTENSIONAPI static constexpr auto ChangeDetection = core::PropertyDefinitionBuilder<magic_enum::enum_count<utils::file::ChangeDetectionStrategy>()>::createProperty("Change Detection")
+      .withDescription("Specifies how the processor finds the new files.\n"
+          "Polling: The whole input directory is listed on every trigger.\n"
+          "File System Events: The input directory is listed once, then its directories are watched, and only the files which changed since the last trigger are checked. "
+          "The events are provided by inotify, so they are only available on Linux and on local file systems; "
+          "if a directory cannot be watched or some events are lost, the whole input directory is listed again.")
+      .isRequired(true)
+      .withDefaultValue(magic_enum::enum_name(utils::file::ChangeDetectionStrategy::Polling))
+      .withAllowedValues(magic_enum::enum_names<utils::file::ChangeDetectionStrategy>())
+      .build();
   EXTENSIONAPI static constexpr auto Properties = std::to_array<core::PropertyReference>({
       InputDirectory,
       RecurseSubdirectories,
@@ -95,7 +116,9 @@ class ListFile : public core::ProcessorImpl {
       MaximumFileAge,
       MinimumFileSize,
       MaximumFileSize,
-      IgnoreHiddenFiles
+      IgnoreHiddenFiles,
+      ListingThreadCount,
+      ChangeDetection
   });
 
 
@@ -146,10 +169,17 @@ class ListFile : public core::ProcessorImpl {
 
  private:
   std::shared_ptr<core::FlowFile> createFlowFile(core::ProcessSession& session, const utils::ListedFile& listed_file);
+  std::vector<utils::file::DirectoryEntry> listFiles();
+  std::vector<utils::file::DirectoryEntry> listDirectory(const std::filesystem::path& directory);
 
   std::filesystem::path input_directory_;
   bool recurse_subdirectories_ = true;
   utils::FileFilter file_filter_{};
+  uint64_t listing_thread_count_ = 1;
+  std::unique_ptr<utils::file::FileChangeWatcher> file_change_watcher_;
+  bool is_every_directory_watched_ = false;
+  // files which were too young to be listed, they are checked again even if they do not change
+  std::set<std::filesystem::path> young_files_;
 };
 
 }  // namespace org::apache::nifi::minifi::processors
@@ -18,22 +18,535 @@
 #include "ReplaceText.h"
 
 #include <algorithm>
+#include <cctype>
+#include <iterator>
+#include <limits>
+#include <span>
 #include <vector>
 
 #include "core/Resource.h"
 #include "core/TypedValues.h"
 #include "core/logging/LoggerFactory.h"
-#include "utils/LineByLineInputOutputStreamCallback.h"
+#include "utils/ConfigurationUtils.h"
 #include "utils/ProcessorConfigUtils.h"
 
 namespace org::apache::nifi::minifi::processors {
 
+namespace {
+
+struct MatchPosition {
+  size_t begin = 0;
+  size_t end = 0;
+};
+
+std::pair<std::string_view, std::string_view> chompLineEnding(std::string_view text) {
+  if (text.ends_with("\r\n")) {
+    return {text.substr(0, text.size() - 2), text.substr(text.size() - 2)};
+  }
+  if (text.ends_with('\n')) {
+    return {text.substr(0, text.size() - 1), text.substr(text.size() - 1)};
+  }
+  return {text, {}};
+}
+
+// ${attribute_name}, where the name is not empty and does not contain '}'
+std::optional<MatchPosition> findPlaceholder(std::string_view text, size_t pos) {
+  for (auto begin = text.find("${", pos); begin != std::string_view::npos; begin = text.find("${", begin + 1)) {
+    const auto closing_brace = text.find('}', begin + 2);
+    if (closing_brace == std::string_view::npos) {
+      return std::nullopt;
+    }
+    if (closing_brace > begin + 2) {
+      return MatchPosition{.begin = begin, .end = closing_brace + 1};
+    }
+  }
+  return std::nullopt;
+}
+
+// $` and $' refer to the whole text before and after the match
+bool refersToPrefixOrSuffix(std::string_view replacement) {
+  for (size_t i = 0; i + 1 < replacement.size(); ++i) {
+    if (replacement[i] == '$') {
+      if (replacement[i + 1] == '`' || replacement[i + 1] == '\'') {
+        return true;
+      }
+      ++i;  // $$ is a literal $
+    }
+  }
+  return false;
+}
+
+/**
+ * An upper bound of the length of the matches of an ECMAScript regex, used to decide whether its matches can be found in a window of the content.
+ * The bound can be loose, e.g. the digits of a \x escape are counted as separate characters, but it is never lower than the longest match.
+ */
+class MatchLengthBound {
+ public:
+  // std::nullopt if the matches can be arbitrarily long, if they depend on the end of the content ($) or on a backreference
+  static std::optional<size_t> of(std::string_view regex) {
+    MatchLengthBound parser{regex};
+    const auto bound = parser.parseAlternation();
+    if (!bound || parser.pos_ != regex.size()) {
+      return std::nullopt;
+    }
+    return bound;
+  }
+
+ private:
+  static constexpr size_t UNBOUNDED = std::numeric_limits<size_t>::max();
+
+  explicit MatchLengthBound(std::string_view regex) : regex_(regex) {}
+
+  bool consume(char c) {
+    if (pos_ < regex_.size() && regex_[pos_] == c) {
+      ++pos_;
+      return true;
+    }
+    return false;
+  }
+
+  std::optional<size_t> parseAlternation() {
+    auto bound = parseConcatenation();
+    while (bound && consume('|')) {
+      const auto next = parseConcatenation();
+      if (!next) {
+        return std::nullopt;
+      }
+      bound = std::max(*bound, *next);
+    }
+    return bound;
+  }
+
+  std::optional<size_t> parseConcatenation() {
+    size_t bound = 0;
+    while (pos_ < regex_.size() && regex_[pos_] != '|' && regex_[pos_] != ')') {
+      const auto atom = parseAtom();
+      if (!atom) {
+        return std::nullopt;
+      }
+      const auto repeated = parseRepetition(*atom);
+      if (!repeated) {
+        return std::nullopt;
+      }
+      bound = *repeated > UNBOUNDED - bound ? UNBOUNDED : bound + *repeated;
+    }
+    return bound;
+  }
+
+  std::optional<size_t> parseRepetition(size_t atom) {
+    size_t max = 0;
+    if (consume('*') || consume('+')) {
+      return std::nullopt;
+    } else if (consume('?')) {
+      max = 1;
+    } else if (consume('{')) {
+      const auto min = parseNumber();
+      if (!min) {
+        return std::nullopt;
+      }
+      max = *min;
+      if (consume(',')) {
+        const auto upper_bound = parseNumber();
+        if (!upper_bound) {
+          return std::nullopt;
+        }
+        max = *upper_bound;
+      }
+      if (!consume('}')) {
+        return std::nullopt;
+      }
+    } else {
+      return atom;
+    }
+    consume('?');  // lazy
+    return atom != 0 && max > UNBOUNDED / atom ? UNBOUNDED : atom * max;
+  }
+
+  std::optional<size_t> parseNumber() {
+    const auto begin = pos_;
+    size_t number = 0;
+    while (pos_ < regex_.size() && std::isdigit(static_cast<unsigned char>(regex_[pos_]))) {
+      number = std::min(number * 10 + static_cast<size_t>(regex_[pos_] - '0'), UNBOUNDED / 100);  // large enough to exceed any window
+      ++pos_;
+    }
+    return pos_ == begin ? std::nullopt : std::optional<size_t>(number);
+  }
+
+  std::optional<size_t> parseAtom() {
+    switch (regex_[pos_++]) {
+      case '^':
+        return 0;
+      case '$':
+        return std::nullopt;
+      case '(': {
+        // the lookaheads are counted like the groups, as they read the content following the match
+        if (consume('?') && !consume(':') && !consume('=') && !consume('!')) {
+          return std::nullopt;
+        }
+        const auto inner = parseAlternation();
+        if (!inner || !consume(')')) {
+          return std::nullopt;
+        }
+        return inner;
+      }
+      case '[':
+        return skipClass() ? std::optional<size_t>(1) : std::nullopt;
+      case '\\': {
+        if (pos_ == regex_.size()) {
+          return std::nullopt;
+        }
+        const char escaped = regex_[pos_++];
+        if (escaped == 'b' || escaped == 'B') {
+          return 0;
+        }
+        if (escaped >= '1' && escaped <= '9') {
+          return std::nullopt;
+        }
+        return 1;
+      }
+      default:
+        return 1;
+    }
+  }
+
+  // the opening bracket is already consumed, a class matches a single character
+  bool skipClass() {
+    while (pos_ < regex_.size()) {
+      const char c = regex_[pos_++];
+      if (c == ']') {
+        return true;
+      }
+      if (c == '\\') {
+        ++pos_;
+      }
+    }
+    return false;
+  }
+
+  std::string_view regex_;
+  size_t pos_ = 0;
+};
+
+// reads at most chunk_size bytes to the end of buffer, returns the number of bytes read, 0 at the end of the input
+std::optional<size_t> appendChunk(io::InputStream& input, std::string& buffer, size_t chunk_size) {
+  const auto old_size = buffer.size();
+  buffer.resize(old_size + chunk_size);
+  const auto read_size = input.read(as_writable_bytes(std::span(buffer).subspan(old_size)));
+  if (io::isError(read_size)) {
+    return std::nullopt;
+  }
+  buffer.resize(old_size + read_size);
+  return read_size;
+}
+
+// the output is collected in a buffer, which is written to the output stream when it reaches the flush size
+class OutputBuffer {
+ public:
+  OutputBuffer(io::OutputStream& output, size_t flush_size)
+      : output_(output),
+        flush_size_(flush_size) {
+  }
+
+  std::string& data() { return buffer_; }
+
+  bool flushIfFull() {
+    return buffer_.size() < flush_size_ || flush();
+  }
+
+  bool flush() {
+    if (buffer_.empty()) {
+      return true;
+    }
+    const auto write_result = output_.write(as_bytes(std::span(buffer_)));
+    buffer_.clear();
+    if (io::isError(write_result)) {
+      return false;
+    }
+    bytes_written_ += write_result;
+    return true;
+  }
+
+  [[nodiscard]] uint64_t bytesWritten() const { return bytes_written_; }
+
+ private:
+  io::OutputStream& output_;
+  size_t flush_size_;
+  std::string buffer_;
+  uint64_t bytes_written_ = 0;
+};
+
+/**
+ * Copies the content to output, or skips it if output is null, except for the line ending at the end of the content, which is returned.
+ * Only the last two bytes read are held back, as they can be that line ending.
+ */
+std::optional<std::string> copyContent(io::InputStream& input, OutputBuffer* output, size_t chunk_size, uint64_t& bytes_read) {
+  std::string window;
+  while (true) {
+    const auto read_size = appendChunk(input, window, chunk_size);
+    if (!read_size) {
+      return std::nullopt;
+    }
+    if (*read_size == 0) {
+      break;
+    }
+    bytes_read += *read_size;
+    if (window.size() > 2) {
+      if (output) {
+        output->data().append(window, 0, window.size() - 2);
+        if (!output->flushIfFull()) {
+          return std::nullopt;
+        }
+      }
+      window.erase(0, window.size() - 2);
+    }
+  }
+  const auto [body, line_ending] = chompLineEnding(window);
+  if (output) {
+    output->data().append(body);
+  }
+  return std::string{line_ending};
+}
+
+}  // namespace
+
+/**
+ * Finds the matches of the Search Value (or the placeholders) and produces their replacements, in a line or in a window of the content.
+ */
+class ReplaceText::Matcher {
+ public:
+  Matcher(const ReplaceText& processor, const std::shared_ptr<core::FlowFile>& flow_file, const Parameters& parameters)
+      : processor_(processor),
+        flow_file_(flow_file),
+        parameters_(parameters) {
+  }
+
+  /**
+   * Finds the leftmost match in text which begins at pos or later, text[0, pos) is the already processed content before it.
+   * @param text_ends_content false if more content follows text, so the end of text is not the end of the input for the anchors
+   * @param after_empty_match true if the previous match was empty and ended at pos, the next one cannot be empty at the same position
+   */
+  std::optional<MatchPosition> find(std::string_view text, size_t pos, bool text_ends_content, bool after_empty_match) {
+    auto match = findMatch(text, pos, text_ends_content, after_empty_match);
+    if (match) {
+      last_match_ = *match;
+    }
+    return match;
+  }
+
+  // appends the replacement of the match last found in text
+  void appendReplacement(std::string& output, std::string_view text) const {
+    const auto& replacement = parameters_.replacement_value_;
+    switch (processor_.replacement_strategy_) {
+      case ReplacementStrategyType::LITERAL_REPLACE:
+        output.append(replacement);
+        return;
+      case ReplacementStrategyType::SUBSTITUTE_VARIABLES:
+        output.append(processor_.getAttributeValue(flow_file_, text.substr(last_match_.begin, last_match_.end - last_match_.begin)));
+        return;
+      case ReplacementStrategyType::REGEX_REPLACE:
+        if (processor_.linear_search_regex_) {
+          processor_.linear_search_regex_->appendReplacement(output, text, linear_captures_, replacement, search_start_);
+        } else {
+          standard_match_.format(std::back_inserter(output), replacement.data(), replacement.data() + replacement.size());
+        }
+        return;
+      default:
+        break;
+    }
+    throw Exception{PROCESSOR_EXCEPTION, utils::string::join_pack(ReplacementStrategy.name, " ", std::string{magic_enum::enum_name(processor_.replacement_strategy_)}, " does not search")};
+  }
+
+  // replaces all matches in text, which is a whole line or the whole content
+  void replaceAll(std::string& output, std::string_view text) {
+    size_t pos = 0;
+    bool after_empty_match = false;
+    while (const auto match = find(text, pos, true, after_empty_match)) {
+      output.append(text.substr(pos, match->begin - pos));
+      appendReplacement(output, text);
+      after_empty_match = match->begin == match->end;
+      pos = match->end;
+    }
+    output.append(text.substr(pos));
+  }
+
+  /**
+   * Replaces the matches in the content read from input in chunks, except for the line ending at the end of the content, which is returned.
+   *
+   * Only a window of the content is kept in memory. The part of it which cannot hold the beginning of a match any more is written out,
+   * the rest is searched again together with the next chunk. A match is only replaced once enough of the content follows it in the window
+   * that reading more could not change it, or when the window reaches the end of the content.
+   */
+  std::optional<std::string> replaceInStream(io::InputStream& input, OutputBuffer& output, size_t chunk_size, uint64_t& bytes_read) {
+    // the last two bytes are always held back, as they can be the line ending at the end of the content, which is not searched
+    const auto holdback = std::max(holdbackSize(), size_t{2});
+    const auto lookahead = std::max(lookaheadSize(), size_t{2});
+    chunk_size = std::max(chunk_size, 4 * holdback);  // so that the held back part is not searched again too many times
+
+    std::string window;
+    size_t pos = 0;
+    bool after_empty_match = false;
+    while (true) {
+      const auto read_size = appendChunk(input, window, chunk_size);
+      if (!read_size) {
+        return std::nullopt;
+      }
+      bytes_read += *read_size;
+      const bool at_end = *read_size == 0;
+
+      std::string_view text = window;
+      std::string_view line_ending;
+      if (at_end) {
+        line_ending = chompLineEnding(text.substr(pos)).second;
+        text.remove_suffix(line_ending.size());
+      }
+
+      size_t copy_until = at_end ? text.size() : (text.size() > holdback ? text.size() - holdback : 0);
+      while (const auto match = find(text, pos, at_end, after_empty_match)) {
+        if (!at_end && match->end + lookahead > text.size()) {
+          copy_until = std::min(copy_until, match->begin);
+          break;
+        }
+        output.data().append(text.substr(pos, match->begin - pos));
+        appendReplacement(output.data(), text);
+        after_empty_match = match->begin == match->end;
+        pos = match->end;
+      }
+      if (copy_until > pos) {
+        output.data().append(text.substr(pos, copy_until - pos));
+        pos = copy_until;
+        after_empty_match = false;
+      }
+
+      if (at_end) {
+        return std::string{line_ending};
+      }
+      if (!output.flushIfFull()) {
+        return std::nullopt;
+      }
+      // the byte before the unprocessed part is kept for the anchors and the word boundaries
+      if (pos > 1) {
+        window.erase(0, pos - 1);
+        pos = 1;
+      }
+    }
+  }
+
+  /**
+   * The whole content needs to be in memory if the replacement refers to the text before or after the match,
+   * or if a match of the regex may not fit in the window (it can be arbitrarily long, or it depends on the end of the content).
+   */
+  [[nodiscard]] bool needsEntireText() const {
+    if (processor_.replacement_strategy_ != ReplacementStrategyType::REGEX_REPLACE) {
+      return false;
+    }
+    if (refersToPrefixOrSuffix(parameters_.replacement_value_)) {
+      return true;
+    }
+    const auto match_length_bound = MatchLengthBound::of(parameters_.search_value_);
+    return !match_length_bound || *match_length_bound > processor_.regex_lookahead_;
+  }
+
+ private:
+  // the number of bytes at the end of a window which can hold the beginning of a match that is only found with more of the content
+  [[nodiscard]] size_t holdbackSize() const {
+    if (processor_.replacement_strategy_ == ReplacementStrategyType::LITERAL_REPLACE) {
+      return parameters_.search_value_.size() - 1;
+    }
+    return processor_.regex_lookahead_;
+  }
+
+  // the number of bytes which need to follow a match in the window, so that more of the content could not change it
+  [[nodiscard]] size_t lookaheadSize() const {
+    if (processor_.replacement_strategy_ == ReplacementStrategyType::REGEX_REPLACE) {
+      return processor_.regex_lookahead_;
+    }
+    return 0;  // literals and placeholders are complete when found
+  }
+
+  std::optional<MatchPosition> findMatch(std::string_view text, size_t pos, bool text_ends_content, bool after_empty_match) {
+    switch (processor_.replacement_strategy_) {
+      case ReplacementStrategyType::LITERAL_REPLACE: {
+        gsl_Expects(parameters_.search_value_scanner_);
+        const auto begin = parameters_.search_value_scanner_->find(text, pos);
+        if (begin == std::string_view::npos) {
+          return std::nullopt;
+        }
+        return MatchPosition{.begin = begin, .end = begin + parameters_.search_value_scanner_->size()};
+      }
+      case ReplacementStrategyType::SUBSTITUTE_VARIABLES:
+        return findPlaceholder(text, pos);
+      case ReplacementStrategyType::REGEX_REPLACE:
+        if (processor_.linear_search_regex_) {
+          return findLinearRegex(text, pos, after_empty_match);
+        }
+        return findStandardRegex(text, pos, text_ends_content, after_empty_match);
+      default:
+        break;
+    }
+    throw Exception{PROCESSOR_EXCEPTION, utils::string::join_pack(ReplacementStrategy.name, " ", std::string{magic_enum::enum_name(processor_.replacement_strategy_)}, " does not search")};
+  }
+
+  // like LinearRegex::replace(), the search continues after the next character following an empty match
+  std::optional<MatchPosition> findLinearRegex(std::string_view text, size_t pos, bool after_empty_match) {
+    if (after_empty_match) {
+      if (pos == text.size()) {
+        return std::nullopt;
+      }
+      ++pos;
+    }
+    search_start_ = pos;
+    if (!processor_.linear_search_regex_->search(text, pos, &linear_captures_)) {
+      return std::nullopt;
+    }
+    return MatchPosition{.begin = linear_captures_[0], .end = linear_captures_[1]};
+  }
+
+  // like std::regex_iterator, a non-empty match is tried at the position of an empty match before moving on to the next character
+  std::optional<MatchPosition> findStandardRegex(std::string_view text, size_t pos, bool text_ends_content, bool after_empty_match) {
+    auto flags = std::regex_constants::match_default;
+    if (!text_ends_content) {
+      flags |= std::regex_constants::match_not_eol | std::regex_constants::match_not_eow;
+    }
+    if (after_empty_match) {
+      if (auto match = searchStandardRegex(text, pos, flags | std::regex_constants::match_not_null | std::regex_constants::match_continuous)) {
+        return match;
+      }
+      if (pos == text.size()) {
+        return std::nullopt;
+      }
+      ++pos;
+    }
+    return searchStandardRegex(text, pos, flags);
+  }
+
+  std::optional<MatchPosition> searchStandardRegex(std::string_view text, size_t start, std::regex_constants::match_flag_type flags) {
+    if (start > 0) {
+      flags |= std::regex_constants::match_prev_avail;
+    }
+    if (!std::regex_search(text.begin() + gsl::narrow<std::ptrdiff_t>(start), text.end(), standard_match_, parameters_.search_regex_, flags)) {
+      return std::nullopt;
+    }
+    const auto begin = gsl::narrow<size_t>(std::distance(text.begin(), standard_match_[0].first));
+    return MatchPosition{.begin = begin, .end = begin + gsl::narrow<size_t>(standard_match_.length(0))};
+  }
+
+  const ReplaceText& processor_;
+  const std::shared_ptr<core::FlowFile>& flow_file_;
+  const Parameters& parameters_;
+  std::match_results<std::string_view::const_iterator> standard_match_;
+  std::vector<size_t> linear_captures_;
+  size_t search_start_ = 0;
+  MatchPosition last_match_;
+};
+
 void ReplaceText::initialize() {
   setSupportedProperties(Properties);
   setSupportedRelationships(Relationships);
 }
 
 void ReplaceText::onSchedule(core::ProcessContext& context, core::ProcessSessionFactory&) {
+  buffer_size_ = std::max(utils::configuration::getBufferSize(*context.getConfiguration()), size_t{1});
+
   evaluation_mode_ = utils::parseEnumProperty<EvaluationModeType>(context, EvaluationMode);
   logger_->log_debug("the {} property is set to {}", EvaluationMode.name, magic_enum::enum_name(evaluation_mode_));
 
@@ -44,6 +557,17 @@ void ReplaceText::onSchedule(core::ProcessContext& context, core::ProcessSession
 
   replacement_strategy_ = utils::parseEnumProperty<ReplacementStrategyType>(context, ReplacementStrategy);
   logger_->log_debug("the {} property is set to {}", ReplacementStrategy.name, magic_enum::enum_name(replacement_strategy_));
+
+  linear_search_regex_.reset();
+  if (replacement_strategy_ == ReplacementStrategyType::REGEX_REPLACE
+      && utils::parseEnumProperty<utils::RegexEngine>(context, RegularExpressionEngine) == utils::RegexEngine::Linear) {
+    if (const auto search_value = context.getRawProperty(SearchValue.name)) {
+      linear_search_regex_ = utils::LinearRegex::compile(*search_value);
+      if (!linear_search_regex_) {
+        logger_->log_warn("The linear engine does not support the {} '{}', falling back to the standard engine", SearchValue.name, *search_value);
+      }
+    }
+  }
 }
 
 void ReplaceText::onTrigger(core::ProcessContext& context, core::ProcessSession& session) {
@@ -76,13 +600,16 @@ ReplaceText::Parameters ReplaceText::readParameters(core::ProcessContext& contex
   if (search_value) {
     parameters.search_value_ = *search_value;
     logger_->log_debug("the {} property is set to {}", SearchValue.name, parameters.search_value_);
-    if (replacement_strategy_ == ReplacementStrategyType::REGEX_REPLACE) {
+    if (replacement_strategy_ == ReplacementStrategyType::REGEX_REPLACE && !linear_search_regex_) {
       parameters.search_regex_ = std::regex{parameters.search_value_};
     }
   }
   if ((replacement_strategy_ == ReplacementStrategyType::REGEX_REPLACE || replacement_strategy_ == ReplacementStrategyType::LITERAL_REPLACE) && parameters.search_value_.empty()) {
     throw Exception{PROCESSOR_EXCEPTION, utils::string::join_pack("Error: missing or empty ", SearchValue.name, " property")};
   }
+  if (replacement_strategy_ == ReplacementStrategyType::LITERAL_REPLACE) {
+    parameters.search_value_scanner_.emplace(parameters.search_value_);
+  }
 
   const auto replacement_value = (replacement_strategy_ == ReplacementStrategyType::REGEX_REPLACE ?
       context.getRawProperty(ReplacementValue.name) : context.getProperty(ReplacementValue, flow_file.get()));
@@ -105,8 +632,14 @@ void ReplaceText::replaceTextInEntireFile(const std::shared_ptr<core::FlowFile>&
   gsl_Expects(flow_file);
 
   try {
-    const auto input = to_string(session.readBuffer(flow_file));
-    session.writeBuffer(flow_file, applyReplacements(input, flow_file, parameters));
+    if (flow_file->getSize() == 0) {
+      // readWrite() does not call the callback for empty content, but the replacement can produce output from it
+      session.writeBuffer(flow_file, applyReplacements("", flow_file, parameters));
+    } else {
+      session.readWrite(flow_file, [this, &flow_file, &parameters](const std::shared_ptr<io::InputStream>& input, const std::shared_ptr<io::OutputStream>& output) {
+        return replaceEntireText(*input, *output, flow_file, parameters);
+      });
+    }
     session.transfer(flow_file, Success);
   } catch (const Exception& exception) {
     logger_->log_error("Error in ReplaceText (Entire text mode): {}", exception.what());
@@ -118,22 +651,9 @@ void ReplaceText::replaceTextLineByLine(const std::shared_ptr<core::FlowFile>& f
   gsl_Expects(flow_file);
 
   try {
-    utils::LineByLineInputOutputStreamCallback read_write_callback{[this, &flow_file, &parameters](const std::string& input_line, bool is_first_line, bool is_last_line) {
-      switch (line_by_line_evaluation_mode_) {
-        case LineByLineEvaluationModeType::ALL:
-          return applyReplacements(input_line, flow_file, parameters);
-        case LineByLineEvaluationModeType::FIRST_LINE:
-          return is_first_line ? applyReplacements(input_line, flow_file, parameters) : input_line;
-        case LineByLineEvaluationModeType::LAST_LINE:
-          return is_last_line ? applyReplacements(input_line, flow_file, parameters) : input_line;
-        case LineByLineEvaluationModeType::EXCEPT_FIRST_LINE:
-          return is_first_line ? input_line : applyReplacements(input_line, flow_file, parameters);
-        case LineByLineEvaluationModeType::EXCEPT_LAST_LINE:
-          return is_last_line ? input_line: applyReplacements(input_line, flow_file, parameters);
-      }
-      throw Exception{PROCESSOR_EXCEPTION, utils::string::join_pack("Unsupported ", LineByLineEvaluationMode.name, ": ", std::string{magic_enum::enum_name(line_by_line_evaluation_mode_)})};
-    }};
-    session.readWrite(flow_file, std::move(read_write_callback));
+    session.readWrite(flow_file, [this, &flow_file, &parameters](const std::shared_ptr<io::InputStream>& input, const std::shared_ptr<io::OutputStream>& output) {
+      return replaceLineByLine(*input, *output, flow_file, parameters);
+    });
     session.transfer(flow_file, Success);
   } catch (const Exception& exception) {
     logger_->log_error("Error in ReplaceText (Line-by-Line mode): {}", exception.what());
@@ -141,89 +661,196 @@ void ReplaceText::replaceTextLineByLine(const std::shared_ptr<core::FlowFile>& f
   }
 }
 
-std::string ReplaceText::applyReplacements(const std::string& input, const std::shared_ptr<core::FlowFile>& flow_file, const Parameters& parameters) const {
-  const auto [chomped_input, line_ending] = utils::string::chomp(input);
+io::ReadWriteResult ReplaceText::replaceEntireText(io::InputStream& input, io::OutputStream& output, const std::shared_ptr<core::FlowFile>& flow_file,
+    const Parameters& parameters) const {
+  OutputBuffer output_buffer(output, buffer_size_);
+  uint64_t bytes_read = 0;
+  std::optional<std::string> line_ending;
 
   switch (replacement_strategy_) {
     case ReplacementStrategyType::PREPEND:
-      return parameters.replacement_value_ + input;
+      output_buffer.data().append(parameters.replacement_value_);
+      line_ending = copyContent(input, &output_buffer, buffer_size_, bytes_read);
+      break;
 
     case ReplacementStrategyType::APPEND:
-      return chomped_input + parameters.replacement_value_ + line_ending;
-
-    case ReplacementStrategyType::REGEX_REPLACE:
-      return std::regex_replace(chomped_input, parameters.search_regex_, parameters.replacement_value_) + line_ending;
-
-    case ReplacementStrategyType::LITERAL_REPLACE:
-      return applyLiteralReplace(chomped_input, parameters) + line_ending;
+      line_ending = copyContent(input, &output_buffer, buffer_size_, bytes_read);
+      output_buffer.data().append(parameters.replacement_value_);
+      break;
 
     case ReplacementStrategyType::ALWAYS_REPLACE:
-      return parameters.replacement_value_ + line_ending;
+      output_buffer.data().append(parameters.replacement_value_);
+      line_ending = copyContent(input, nullptr, buffer_size_, bytes_read);
+      break;
 
-    case ReplacementStrategyType::SUBSTITUTE_VARIABLES:
-      return applySubstituteVariables(chomped_input, flow_file) + line_ending;
+    case ReplacementStrategyType::REGEX_REPLACE:
+    case ReplacementStrategyType::LITERAL_REPLACE:
+    case ReplacementStrategyType::SUBSTITUTE_VARIABLES: {
+      Matcher matcher(*this, flow_file, parameters);
+      if (matcher.needsEntireText()) {
+        logger_->log_debug("The matches of the {} cannot be found in a window of the content, reading the whole content into memory", SearchValue.name);
+        std::string content;
+        while (true) {
+          const auto read_size = appendChunk(input, content, buffer_size_);
+          if (!read_size) {
+            return io::ReadWriteResult::error();
+          }
+          if (*read_size == 0) {
+            break;
+          }
+          bytes_read += *read_size;
+        }
+        appendReplacements(output_buffer.data(), content, matcher, parameters);
+        line_ending.emplace();
+      } else {
+        line_ending = matcher.replaceInStream(input, output_buffer, buffer_size_, bytes_read);
+      }
+      break;
+    }
   }
 
-  throw Exception{PROCESSOR_EXCEPTION, utils::string::join_pack("Unsupported ", ReplacementStrategy.name, ": ", std::string{magic_enum::enum_name(replacement_strategy_)})};
+  if (!line_ending) {
+    return io::ReadWriteResult::error();
+  }
+  output_buffer.data().append(*line_ending);
+  if (!output_buffer.flush()) {
+    return io::ReadWriteResult::error();
+  }
+  return {bytes_read, output_buffer.bytesWritten()};
 }
 
-std::string ReplaceText::applyLiteralReplace(const std::string& input, const Parameters& parameters) {
-  std::vector<char> output;
-  output.reserve(input.size());
-
-  auto it = input.begin();
-  do {
-    auto found = std::search(it, input.end(), parameters.search_value_.begin(), parameters.search_value_.end());
-    if (found != input.end()) {
-      std::copy(it, found, std::back_inserter(output));
-      std::copy(parameters.replacement_value_.begin(), parameters.replacement_value_.end(), std::back_inserter(output));
-      it = found;
-      std::advance(it, parameters.search_value_.size());
+io::ReadWriteResult ReplaceText::replaceLineByLine(io::InputStream& input, io::OutputStream& output, const std::shared_ptr<core::FlowFile>& flow_file,
+    const Parameters& parameters) const {
+  Matcher matcher(*this, flow_file, parameters);
+  OutputBuffer output_buffer(output, buffer_size_);
+  const utils::DelimiterScanner newline_scanner("\n");
+  std::string window;
+  uint64_t bytes_read = 0;
+  size_t line_begin = 0;
+  size_t scan_position = 0;
+  bool is_first_line = true;
+
+  const auto process_line = [&](std::string_view line, bool is_last_line) {
+    bool replace = true;
+    switch (line_by_line_evaluation_mode_) {
+      case LineByLineEvaluationModeType::ALL:
+        break;
+      case LineByLineEvaluationModeType::FIRST_LINE:
+        replace = is_first_line;
+        break;
+      case LineByLineEvaluationModeType::LAST_LINE:
+        replace = is_last_line;
+        break;
+      case LineByLineEvaluationModeType::EXCEPT_FIRST_LINE:
+        replace = !is_first_line;
+        break;
+      case LineByLineEvaluationModeType::EXCEPT_LAST_LINE:
+        replace = !is_last_line;
+        break;
+    }
+    if (replace) {
+      appendReplacements(output_buffer.data(), line, matcher, parameters);
     } else {
-      std::copy(it, input.end(), std::back_inserter(output));
-      it = input.end();
+      output_buffer.data().append(line);
     }
-  } while (it != input.end());
+    is_first_line = false;
+  };
 
-  return std::string{output.begin(), output.end()};
-}
+  while (true) {
+    const auto read_size = appendChunk(input, window, buffer_size_);
+    if (!read_size) {
+      return io::ReadWriteResult::error();
+    }
+    bytes_read += *read_size;
+    const bool at_end = *read_size == 0;
+
+    // a line is only processed once the byte following it has been read, so that it is known whether it is the last one
+    const std::string_view text = window;
+    while (true) {
+      const auto newline = newline_scanner.find(text, scan_position);
+      if (newline == std::string_view::npos) {
+        scan_position = text.size();
+        break;
+      }
+      if (newline + 1 == text.size() && !at_end) {
+        scan_position = newline;
+        break;
+      }
+      process_line(text.substr(line_begin, newline + 1 - line_begin), newline + 1 == text.size());
+      line_begin = scan_position = newline + 1;
+    }
 
-std::string ReplaceText::applySubstituteVariables(const std::string& input, const std::shared_ptr<core::FlowFile>& flow_file) const {
-  static const std::regex PLACEHOLDER{R"(\$\{([^}]+)\})"};
+    if (at_end) {
+      if (line_begin < text.size()) {
+        process_line(text.substr(line_begin), true);
+      }
+      break;
+    }
+    if (!output_buffer.flushIfFull()) {
+      return io::ReadWriteResult::error();
+    }
+    window.erase(0, line_begin);
+    scan_position -= line_begin;
+    line_begin = 0;
+  }
 
-  auto input_it = std::sregex_iterator{input.begin(), input.end(), PLACEHOLDER};
-  const auto input_end = std::sregex_iterator{};
-  if (input_it == input_end) {
-    return input;
+  if (!output_buffer.flush()) {
+    return io::ReadWriteResult::error();
   }
+  return {bytes_read, output_buffer.bytesWritten()};
+}
+
+std::string ReplaceText::applyReplacements(const std::string& input, const std::shared_ptr<core::FlowFile>& flow_file, const Parameters& parameters) const {
+  std::string output;
+  Matcher matcher(*this, flow_file, parameters);
+  appendReplacements(output, input, matcher, parameters);
+  return output;
+}
+
+void ReplaceText::appendReplacements(std::string& output, std::string_view input, Matcher& matcher, const Parameters& parameters) const {
+  const auto [chomped_input, line_ending] = chompLineEnding(input);
+
+  switch (replacement_strategy_) {
+    case ReplacementStrategyType::PREPEND:
+      output.append(parameters.replacement_value_).append(input);
+      return;
 
-  std::vector<char> output;
-  auto output_it = std::back_inserter(output);
+    case ReplacementStrategyType::APPEND:
+      output.append(chomped_input).append(parameters.replacement_value_).append(line_ending);
+      return;
 
-  std::smatch match;
-  for (; input_it != input_end; ++input_it) {
-    match = *input_it;
-    output_it = std::copy(match.prefix().first, match.prefix().second, output_it);
-    std::string attribute_value = getAttributeValue(flow_file, match);
-    output_it = std::copy(attribute_value.begin(), attribute_value.end(), output_it);
+    case ReplacementStrategyType::REGEX_REPLACE:
+      if (linear_search_regex_) {
+        linear_search_regex_->replace(chomped_input, parameters.replacement_value_, false, output);
+      } else {
+        std::regex_replace(std::back_inserter(output), chomped_input.begin(), chomped_input.end(), parameters.search_regex_, parameters.replacement_value_);
+      }
+      output.append(line_ending);
+      return;
+
+    case ReplacementStrategyType::LITERAL_REPLACE:
+    case ReplacementStrategyType::SUBSTITUTE_VARIABLES:
+      matcher.replaceAll(output, chomped_input);
+      output.append(line_ending);
+      return;
+
+    case ReplacementStrategyType::ALWAYS_REPLACE:
+      output.append(parameters.replacement_value_).append(line_ending);
+      return;
   }
-  std::copy(match.suffix().first, match.suffix().second, output_it);
 
-  return std::string{output.begin(), output.end()};
+  throw Exception{PROCESSOR_EXCEPTION, utils::string::join_pack("Unsupported ", ReplacementStrategy.name, ": ", std::string{magic_enum::enum_name(replacement_strategy_)})};
 }
 
-std::string ReplaceText::getAttributeValue(const std::shared_ptr<core::FlowFile>& flow_file, const std::smatch& match) const {
+std::string ReplaceText::getAttributeValue(const std::shared_ptr<core::FlowFile>& flow_file, std::string_view placeholder) const {
   gsl_Expects(flow_file);
-  gsl_Expects(match.size() >= 2);
 
-  std::string attribute_key = match[1];
-  std::optional<std::string> attribute_value = flow_file->getAttribute(attribute_key);
-  if (attribute_value) {
+  const auto attribute_key = placeholder.substr(2, placeholder.size() - 3);
+  if (auto attribute_value = flow_file->getAttribute(attribute_key)) {
     return *attribute_value;
-  } else {
-    logger_->log_debug("Attribute {} not found in the flow file during {}", attribute_key, magic_enum::enum_name(ReplacementStrategyType::SUBSTITUTE_VARIABLES));
-    return match[0];
   }
+  logger_->log_debug("Attribute {} not found in the flow file during {}", attribute_key, magic_enum::enum_name(ReplacementStrategyType::SUBSTITUTE_VARIABLES));
+  return std::string{placeholder};
 }
 
 REGISTER_RESOURCE(ReplaceText, Processor);
@@ -17,8 +17,10 @@
 #pragma once
 
 #include <memory>
+#include <optional>
 #include <regex>
 #include <string>
+#include <string_view>
 #include <utility>
 
 #include "minifi-cpp/core/Annotation.h"
@@ -29,7 +31,14 @@
 #include "core/PropertyDefinitionBuilder.h"
 #include "minifi-cpp/core/RelationshipDefinition.h"
 #include "minifi-cpp/core/logging/Logger.h"
+#include "minifi-cpp/io/InputStream.h"
+#include "minifi-cpp/io/OutputStream.h"
+#include "minifi-cpp/io/StreamCallback.h"
+#include "utils/ByteScanner.h"
+#include "utils/ConfigurationUtils.h"
 #include "utils/Enum.h"
+#include "utils/LinearRegex.h"
+#include "utils/RegexUtils.h"
 #include "minifi-cpp/utils/Export.h"
 
 namespace org::apache::nifi::minifi::processors {
@@ -121,7 +130,9 @@ class ReplaceText : public core::ProcessorImpl {
 
   EXTENSIONAPI static constexpr auto EvaluationMode = core::PropertyDefinitionBuilder<magic_enum::enum_count<EvaluationModeType>()>::createProperty("Evaluation Mode")
       .withDescription("Run the 'Replacement Strategy' against each line separately (Line-by-Line) or "
-          "against the whole input treated as a single string (Entire Text).")
+          "against the whole input treated as a single string (Entire Text). "
+          "Entire Text mode streams the content, so a Substitute Variables placeholder is only found if it fits in 64 KB. "
+          "A Regex Replace reads the whole content into memory if its matches can be longer than 64 KB or it uses the $ anchor.")
       .isRequired(true)
       .withDefaultValue(magic_enum::enum_name(EvaluationModeType::LINE_BY_LINE))
       .withAllowedValues(magic_enum::enum_names<EvaluationModeType>())
@@ -157,12 +168,21 @@ class ReplaceText : public core::ProcessorImpl {
       .isRequired(true)
       .supportsExpressionLanguage(true)
       .build();
+  EXTENSIONAPI static constexpr auto RegularExpressionEngine = core::PropertyDefinitionBuilder<magic_enum::enum_count<utils::RegexEngine>()>::createProperty("Regular Expression Engine")
+      .withDescription("The engine evaluating the Search Value in Regex Replace mode. 'Standard' uses std::regex, which may backtrack exponentially on some patterns. "
+          "'Linear' replaces the matches in time linear in the length of the text, with the same syntax and replacement format; "
+          "patterns with backreferences or lookarounds are evaluated by std::regex.")
+      .isRequired(true)
+      .withDefaultValue(magic_enum::enum_name(utils::RegexEngine::Standard))
+      .withAllowedValues(magic_enum::enum_names<utils::RegexEngine>())
+      .build();
   EXTENSIONAPI static constexpr auto Properties = std::to_array<core::PropertyReference>({
       EvaluationMode,
       LineByLineEvaluationMode,
       ReplacementStrategy,
       SearchValue,
-      ReplacementValue
+      ReplacementValue,
+      RegularExpressionEngine
   });
 
 
@@ -186,8 +206,13 @@ class ReplaceText : public core::ProcessorImpl {
  private:
   friend struct ReplaceTextTestAccessor;
 
+  static constexpr size_t DEFAULT_REGEX_LOOKAHEAD = 64 * 1024;
+
+  class Matcher;
+
   struct Parameters {
     std::string search_value_;
+    std::optional<utils::DelimiterScanner> search_value_scanner_;  // in Literal Replace mode
     std::regex search_regex_;
     std::string replacement_value_;
   };
@@ -197,14 +222,19 @@ class ReplaceText : public core::ProcessorImpl {
   void replaceTextInEntireFile(const std::shared_ptr<core::FlowFile>& flow_file, core::ProcessSession& session, const Parameters& parameters) const;
   void replaceTextLineByLine(const std::shared_ptr<core::FlowFile>& flow_file, core::ProcessSession& session, const Parameters& parameters) const;
 
+  io::ReadWriteResult replaceEntireText(io::InputStream& input, io::OutputStream& output, const std::shared_ptr<core::FlowFile>& flow_file, const Parameters& parameters) const;
+  io::ReadWriteResult replaceLineByLine(io::InputStream& input, io::OutputStream& output, const std::shared_ptr<core::FlowFile>& flow_file, const Parameters& parameters) const;
+
   std::string applyReplacements(const std::string& input, const std::shared_ptr<core::FlowFile>& flow_file, const Parameters& parameters) const;
-  static std::string applyLiteralReplace(const std::string& input, const Parameters& parameters);
-  std::string applySubstituteVariables(const std::string& input, const std::shared_ptr<core::FlowFile>& flow_file) const;
-  std::string getAttributeValue(const std::shared_ptr<core::FlowFile>& flow_file, const std::smatch& match) const;
+  void appendReplacements(std::string& output, std::string_view input, Matcher& matcher, const Parameters& parameters) const;
+  std::string getAttributeValue(const std::shared_ptr<core::FlowFile>& flow_file, std::string_view placeholder) const;
 
   EvaluationModeType evaluation_mode_ = EvaluationModeType::LINE_BY_LINE;
   LineByLineEvaluationModeType line_by_line_evaluation_mode_ = LineByLineEvaluationModeType::ALL;
   ReplacementStrategyType replacement_strategy_ = ReplacementStrategyType::REGEX_REPLACE;
+  std::optional<utils::LinearRegex> linear_search_regex_;  // the Search Value compiled once for the linear engine
+  size_t buffer_size_ = utils::configuration::DEFAULT_BUFFER_SIZE;  // the size of the chunks read and written
+  size_t regex_lookahead_ = DEFAULT_REGEX_LOOKAHEAD;  // in Entire text mode, the longest regex match and placeholder which is found
 };
 
 }  // namespace org::apache::nifi::minifi::processors
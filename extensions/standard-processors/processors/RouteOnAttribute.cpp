@@ -22,9 +22,11 @@
 
 #include <memory>
 #include <string>
+#include <utility>
 #include <vector>
 
 #include "core/Resource.h"
+#include "utils/ProcessorConfigUtils.h"
 
 namespace org::apache::nifi::minifi::processors {
 
@@ -34,6 +36,10 @@ void RouteOnAttribute::initialize() {
 }
 
 void RouteOnAttribute::onSchedule(core::ProcessContext& context, core::ProcessSessionFactory&) {
+  batch_size_ = utils::parseU64Property(context, BatchSize);
+  if (batch_size_ < 1) {
+    throw Exception(PROCESS_SCHEDULE_EXCEPTION, "Batch Size should be positive");
+  }
   route_properties_ = context.getDynamicProperties();
 
   const auto static_relationships = RouteOnAttribute::Relationships;
@@ -48,32 +54,39 @@ void RouteOnAttribute::onSchedule(core::ProcessContext& context, core::ProcessSe
 }
 
 void RouteOnAttribute::onTrigger(core::ProcessContext& context, core::ProcessSession& session) {
-  auto flow_file = session.get();
+  std::vector<std::shared_ptr<core::FlowFile>> flow_files;
+  while (flow_files.size() < batch_size_) {
+    auto flow_file = session.get();
+    if (!flow_file) {
+      break;
+    }
+    flow_files.push_back(std::move(flow_file));
+  }
 
   // Do nothing if there are no incoming files
-  if (!flow_file) {
+  if (flow_files.empty()) {
     return;
   }
 
+  if (flow_files.size() == 1) {
+    routeFlowFile(context, session, flow_files.front());
+  } else {
+    routeBatch(context, session, flow_files);
+  }
+}
+
+void RouteOnAttribute::routeFlowFile(core::ProcessContext& context, core::ProcessSession& session, const std::shared_ptr<core::FlowFile>& flow_file) const {
   try {
-    bool did_match = false;
+    std::vector<const core::Relationship*> matched_routes;
 
     // Perform dynamic routing logic
-    for (const auto &route : route_properties_) {
-      std::string do_route = context.getDynamicProperty(route.first, flow_file.get()).value_or("");
-
-      if (do_route == "true") {
-        did_match = true;
-        auto clone = session.clone(*flow_file);
-        session.transfer(clone, route_rels_[route.first]);
+    for (const auto& [route_name, route_rel] : route_rels_) {
+      if (context.getDynamicProperty(route_name, flow_file.get()).value_or("") == "true") {
+        matched_routes.push_back(&route_rel);
       }
     }
 
-    if (!did_match) {
-      session.transfer(flow_file, Unmatched);
-    } else {
-      session.remove(flow_file);
-    }
+    transferToRoutes(session, flow_file, matched_routes);
   } catch (const std::exception &e) {
     logger_->log_error("Caught exception while updating attributes: type: {}, what: {}", typeid(e).name(), e.what());
     session.transfer(flow_file, Failure);
@@ -81,6 +94,45 @@ void RouteOnAttribute::onTrigger(core::ProcessContext& context, core::ProcessSes
   }
 }
 
+void RouteOnAttribute::routeBatch(core::ProcessContext& context, core::ProcessSession& session, const std::vector<std::shared_ptr<core::FlowFile>>& flow_files) const {
+  // each route is evaluated for the whole batch at once, and nothing is transferred until all of them are evaluated
+  std::vector<std::vector<const core::Relationship*>> matched_routes(flow_files.size());
+  try {
+    for (const auto& [route_name, route_rel] : route_rels_) {
+      const auto results = context.getDynamicPropertyForEach(route_name, flow_files);
+      if (!results) {
+        continue;
+      }
+      for (size_t i = 0; i < flow_files.size(); ++i) {
+        if ((*results)[i] == "true") {
+          matched_routes[i].push_back(&route_rel);
+        }
+      }
+    }
+  } catch (const std::exception& e) {
+    logger_->log_warn("Failed to route a batch of {} flow files, routing them one by one: {}", flow_files.size(), e.what());
+    for (const auto& flow_file : flow_files) {
+      routeFlowFile(context, session, flow_file);
+    }
+    return;
+  }
+
+  for (size_t i = 0; i < flow_files.size(); ++i) {
+    transferToRoutes(session, flow_files[i], matched_routes[i]);
+  }
+}
+
+void RouteOnAttribute::transferToRoutes(core::ProcessSession& session, const std::shared_ptr<core::FlowFile>& flow_file, const std::vector<const core::Relationship*>& matched_routes) {
+  if (matched_routes.empty()) {
+    session.transfer(flow_file, Unmatched);
+    return;
+  }
+  for (const auto* route_rel : matched_routes) {
+    session.transfer(session.clone(*flow_file), *route_rel);
+  }
+  session.remove(flow_file);
+}
+
 REGISTER_RESOURCE(RouteOnAttribute, Processor);
 
 }  // namespace org::apache::nifi::minifi::processors
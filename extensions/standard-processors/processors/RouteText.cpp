@@ -33,6 +33,8 @@
 #include "range/v3/view/transform.hpp"
 #include "range/v3/algorithm/all_of.hpp"
 #include "range/v3/algorithm/any_of.hpp"
+#include "utils/ByteScanner.h"
+#include "utils/LinearRegex.h"
 #include "utils/OptionalUtils.h"
 #include "utils/ProcessorConfigUtils.h"
 #include "utils/Searcher.h"
@@ -49,9 +51,16 @@ void RouteText::onSchedule(core::ProcessContext& context, core::ProcessSessionFa
   matching_ = utils::parseEnumProperty<route_text::Matching>(context, MatchingStrategy);
   trim_ = utils::parseBoolProperty(context, TrimWhitespace);
   case_policy_ = utils::parseBoolProperty(context, IgnoreCase) ? route_text::CasePolicy::IGNORE_CASE : route_text::CasePolicy::CASE_SENSITIVE;
-  group_regex_ = context.getProperty(GroupingRegex) | utils::toOptional() | utils::transform([] (const auto& str) {return utils::Regex(str);});
+  regex_engine_ = utils::parseEnumProperty<utils::RegexEngine>(context, RegularExpressionEngine);
+  const auto group_regex_flags = regex_engine_ == utils::RegexEngine::Linear ? std::vector<utils::Regex::Mode>{utils::Regex::Mode::LINEAR} : std::vector<utils::Regex::Mode>{};
+  group_regex_ = context.getProperty(GroupingRegex) | utils::toOptional() | utils::transform([&] (const auto& str) {return utils::Regex(str, group_regex_flags);});
   segmentation_ = utils::parseEnumProperty<route_text::Segmentation>(context, SegmentationStrategy);
   group_fallback_ = context.getProperty(GroupingFallbackValue).value_or("");
+  {
+    std::lock_guard<std::mutex> lock(regex_set_mutex_);
+    regex_set_patterns_.clear();
+    regex_set_.reset();
+  }
 
 
   for (const auto& property_name : context.getDynamicPropertyKeys()) {
@@ -90,7 +99,7 @@ class RouteText::ReadCallback {
         std::string_view::size_type curr = 0;
         while (curr < content.length()) {
           // find beginning of next line
-          std::string_view::size_type next_line = content.find('\n', curr);
+          std::string_view::size_type next_line = newline_scanner_.find(content, curr);
 
           if (next_line == std::string_view::npos) {
             fn_({content.substr(curr), segment_idx});
@@ -112,6 +121,7 @@ class RouteText::ReadCallback {
   route_text::Segmentation segmentation_;
   size_t file_size_;
   Fn fn_;
+  utils::DelimiterScanner newline_scanner_{"\n"};
 };
 
 class RouteText::MatchingContext {
@@ -142,10 +152,13 @@ class RouteText::MatchingContext {
   };
 
  public:
-  MatchingContext(core::ProcessContext& process_context, std::shared_ptr<core::FlowFile> flow_file, route_text::CasePolicy case_policy)
-    : process_context_(process_context),
+  MatchingContext(RouteText& processor, core::ProcessContext& process_context, std::shared_ptr<core::FlowFile> flow_file, route_text::CasePolicy case_policy,
+      utils::RegexEngine regex_engine)
+    : processor_(processor),
+      process_context_(process_context),
       flow_file_(std::move(flow_file)),
-      case_policy_(case_policy) {}
+      case_policy_(case_policy),
+      regex_engine_(regex_engine) {}
 
   const utils::Regex& getRegexProperty(const std::string& property_name) {
     auto it = regex_values_.find(property_name);
@@ -157,9 +170,38 @@ class RouteText::MatchingContext {
     if (case_policy_ == route_text::CasePolicy::IGNORE_CASE) {
       flags.push_back(utils::Regex::Mode::ICASE);
     }
+    if (regex_engine_ == utils::RegexEngine::Linear) {
+      flags.push_back(utils::Regex::Mode::LINEAR);
+    }
     return (regex_values_[property_name] = utils::Regex(value, flags));
   }
 
+  // the linear engine compiles the regex of every property into one set, so that a segment is scanned only once for all of them,
+  // returns std::nullopt if the set is not available and the regex of the property needs to be evaluated on its own
+  std::optional<bool> matchRegexSet(const Segment& segment, const std::string& property_name, bool full_match) {
+    if (regex_engine_ != utils::RegexEngine::Linear) {
+      return std::nullopt;
+    }
+    if (!regex_set_compiled_) {
+      regex_set_compiled_ = true;
+      std::vector<std::string> patterns;
+      for (const auto& key : process_context_.getDynamicPropertyKeys()) {
+        regex_set_indices_[key] = patterns.size();
+        patterns.push_back(process_context_.getDynamicProperty(key, flow_file_.get()) | utils::orThrow("Missing dynamic property"));
+      }
+      regex_set_ = processor_.getRegexSet(std::move(patterns));
+    }
+    const auto index = regex_set_indices_.find(property_name);
+    if (!regex_set_ || index == regex_set_indices_.end()) {
+      return std::nullopt;
+    }
+    if (regex_set_segment_idx_ != segment.idx_) {
+      regex_set_matches_ = full_match ? regex_set_->fullMatch(segment.value_) : regex_set_->search(segment.value_);
+      regex_set_segment_idx_ = segment.idx_;
+    }
+    return regex_set_matches_[index->second];
+  }
+
   const std::string& getStringProperty(const std::string& property_name) {
     auto it = string_values_.find(property_name);
     if (it != string_values_.end()) {
@@ -181,13 +223,21 @@ class RouteText::MatchingContext {
         std::forward_as_tuple(value, case_policy_)).first->second.searcher_;
   }
 
+  RouteText& processor_;
   core::ProcessContext& process_context_;
   std::shared_ptr<core::FlowFile> flow_file_;
   route_text::CasePolicy case_policy_;
+  utils::RegexEngine regex_engine_;
 
   std::map<std::string, std::string> string_values_;
   std::map<std::string, utils::Regex> regex_values_;
 
+  bool regex_set_compiled_{false};
+  std::shared_ptr<const utils::LinearRegexSet> regex_set_;
+  std::map<std::string, size_t> regex_set_indices_;
+  std::optional<size_t> regex_set_segment_idx_;
+  std::vector<bool> regex_set_matches_;
+
   struct OwningSearcher {
     OwningSearcher(std::string str, route_text::CasePolicy case_policy)
       : str_(std::move(str)), searcher_(str_.cbegin(), str_.cend(), CaseAwareHash{case_policy}, CaseAwareEq{case_policy}) {}
@@ -224,7 +274,7 @@ void RouteText::onTrigger(core::ProcessContext& context, core::ProcessSession& s
 
   std::map<Route, std::string> flow_file_contents;
 
-  MatchingContext matching_context(context, flow_file, case_policy_);
+  MatchingContext matching_context(*this, context, flow_file, case_policy_, regex_engine_);
 
   ReadCallback callback(segmentation_, flow_file->getSize(), [&] (Segment segment) {
     std::string_view original_value = segment.value_;
@@ -359,10 +409,16 @@ bool RouteText::matchSegment(MatchingContext& context, const Segment& segment, c
       return utils::string::equals(segment.value_, context.getStringProperty(property_name), case_policy_ == route_text::CasePolicy::CASE_SENSITIVE);
     }
     case route_text::Matching::CONTAINS_REGEX: {
+      if (const auto set_result = context.matchRegexSet(segment, property_name, false)) {
+        return *set_result;
+      }
       std::string segment_str = std::string(segment.value_);
       return utils::regexSearch(segment_str, context.getRegexProperty(property_name));
     }
     case route_text::Matching::MATCHES_REGEX: {
+      if (const auto set_result = context.matchRegexSet(segment, property_name, true)) {
+        return *set_result;
+      }
       std::string segment_str = std::string(segment.value_);
       return utils::regexMatch(segment_str, context.getRegexProperty(property_name));
     }
@@ -387,6 +443,19 @@ std::optional<std::string> RouteText::getGroup(const std::string_view& segment)
     | ranges::to<std::string>();
 }
 
+std::shared_ptr<const utils::LinearRegexSet> RouteText::getRegexSet(std::vector<std::string> patterns) {
+  std::lock_guard<std::mutex> lock(regex_set_mutex_);
+  if (!regex_set_ || patterns != regex_set_patterns_) {
+    auto regex_set = utils::LinearRegexSet::compile(patterns, case_policy_ == route_text::CasePolicy::IGNORE_CASE);
+    if (!regex_set) {
+      return nullptr;
+    }
+    regex_set_ = std::make_shared<const utils::LinearRegexSet>(std::move(*regex_set));
+    regex_set_patterns_ = std::move(patterns);
+  }
+  return regex_set_;
+}
+
 
 REGISTER_RESOURCE(RouteText, Processor);
 
@@ -22,6 +22,8 @@
 #include <map>
 #include <string>
 #include <memory>
+#include <mutex>
+#include <vector>
 
 #include "minifi-cpp/core/OutputAttributeDefinition.h"
 #include "core/ProcessorImpl.h"
@@ -31,6 +33,7 @@
 #include "minifi-cpp/core/RelationshipDefinition.h"
 #include "utils/Enum.h"
 #include "minifi-cpp/utils/Export.h"
+#include "utils/LinearRegex.h"
 #include "utils/RegexUtils.h"
 
 namespace org::apache::nifi::minifi::processors::route_text {
@@ -168,6 +171,15 @@ class RouteText : public core::ProcessorImpl {
       .withDefaultValue(magic_enum::enum_name(route_text::Segmentation::PER_LINE))
       .withAllowedValues(magic_enum::enum_names<route_text::Segmentation>())
       .build();
+  EXTENSIONAPI static constexpr auto RegularExpressionEngine = core::PropertyDefinitionBuilder<magic_enum::enum_count<utils::RegexEngine>()>::createProperty("Regular Expression Engine")
+      .withDescription("The engine evaluating the regular expressions of the 'Matches Regex' and 'Contains Regex' strategies and the 'Grouping Regular Expression'. "
+          "'Standard' uses the regular expression library of the platform, which may backtrack exponentially on some patterns. "
+          "'Linear' uses ECMAScript syntax and matches in time linear in the length of the segment, it evaluates all user-defined regular expressions "
+          "in a single pass over each segment. Patterns with backreferences or lookarounds are evaluated by the standard engine.")
+      .isRequired(true)
+      .withDefaultValue(magic_enum::enum_name(utils::RegexEngine::Standard))
+      .withAllowedValues(magic_enum::enum_names<utils::RegexEngine>())
+      .build();
   EXTENSIONAPI static constexpr auto Properties = std::to_array<core::PropertyReference>({
       RoutingStrategy,
       MatchingStrategy,
@@ -175,7 +187,8 @@ class RouteText : public core::ProcessorImpl {
       IgnoreCase,
       GroupingRegex,
       GroupingFallbackValue,
-      SegmentationStrategy
+      SegmentationStrategy,
+      RegularExpressionEngine
   });
 
 
@@ -226,15 +239,22 @@ class RouteText : public core::ProcessorImpl {
   std::string_view preprocess(std::string_view str) const;
   bool matchSegment(MatchingContext& context, const Segment& segment, const std::string& property_name) const;
   std::optional<std::string> getGroup(const std::string_view& segment) const;
+  std::shared_ptr<const utils::LinearRegexSet> getRegexSet(std::vector<std::string> patterns);
 
   route_text::Routing routing_ = route_text::Routing::DYNAMIC;
   route_text::Matching matching_ = route_text::Matching::STARTS_WITH;
   route_text::Segmentation segmentation_ = route_text::Segmentation::PER_LINE;
   bool trim_{true};
   route_text::CasePolicy case_policy_{route_text::CasePolicy::CASE_SENSITIVE};
+  utils::RegexEngine regex_engine_{utils::RegexEngine::Standard};
   std::optional<utils::Regex> group_regex_;
   std::string group_fallback_;
 
+  // the regex set of the last flow file, reused while the evaluated dynamic properties do not change
+  std::mutex regex_set_mutex_;
+  std::vector<std::string> regex_set_patterns_;
+  std::shared_ptr<const utils::LinearRegexSet> regex_set_;
+
   std::map<std::string, core::Relationship> dynamic_relationships_;
 };
 
@@ -22,7 +22,7 @@
 #include "minifi-cpp/core/ProcessContext.h"
 #include "core/ProcessSession.h"
 #include "core/Resource.h"
-#include "utils/ConfigurationUtils.h"
+#include "minifi-cpp/utils/gsl.h"
 #include "utils/ProcessorConfigUtils.h"
 
 namespace org::apache::nifi::minifi::processors {
@@ -32,10 +32,6 @@ void SegmentContent::initialize() {
   setSupportedRelationships(Relationships);
 }
 
-void SegmentContent::onSchedule(core::ProcessContext& context, core::ProcessSessionFactory&) {
-  buffer_size_ = utils::configuration::getBufferSize(*context.getConfiguration());
-}
-
 namespace {
 void updateSplitAttributesAndTransfer(core::ProcessSession& session, const std::vector<std::shared_ptr<core::FlowFile>>& splits, const core::FlowFile& original) {
   const std::string fragment_identifier_ = original.getAttribute(core::SpecialFlowAttribute::UUID).value_or(utils::IdGenerator::getIdGenerator()->generate().to_string());
@@ -63,41 +59,17 @@ void SegmentContent::onTrigger(core::ProcessContext& context, core::ProcessSessi
     throw Exception(PROCESSOR_EXCEPTION, fmt::format("Invalid Segment Size: '0'"));
   }
 
-  const auto ff_content_stream = session.getFlowFileContentStream(*original);
-  if (!ff_content_stream) {
-    throw Exception(PROCESSOR_EXCEPTION, fmt::format("Couldn't access the ContentStream of {}", original->getUUID().to_string()));
-  }
-
-  std::vector<std::byte> buffer;
+  // the segments are views over the content of the original, none of it is read or copied
   std::vector<std::shared_ptr<core::FlowFile>> segments{};
-
-  uint64_t current_segment_size = 0;
-  uint64_t num_bytes_read{};
-  bool needs_new_segment = true;
-  while (true) {
-    const uint64_t segment_remaining_size = max_segment_size - current_segment_size;
-    const uint64_t buffer_size = (std::min)(uint64_t{buffer_size_}, segment_remaining_size);
-    buffer.resize(buffer_size);
-    num_bytes_read = ff_content_stream->read(buffer);
-    if (io::isError(num_bytes_read)) {
-      logger_->log_error("Error while reading from {}", original->getUUID().to_string());
-      break;
+  const uint64_t original_size = original->getSize();
+  for (uint64_t offset = 0; offset < original_size; offset += max_segment_size) {
+    const uint64_t segment_size = (std::min)(max_segment_size, original_size - offset);
+    auto segment = session.clone(*original, gsl::narrow<int64_t>(offset), gsl::narrow<int64_t>(segment_size));
+    if (!segment) {
+      throw Exception(PROCESSOR_EXCEPTION, fmt::format("Couldn't create segment {}:{} of {}", offset, segment_size, original->getUUID().to_string()));
     }
-    if (num_bytes_read == 0) {  // No more data
-      break;
-    }
-    if (needs_new_segment) {
-      segments.push_back(session.create());
-      needs_new_segment = false;
-    }
-    buffer.resize(num_bytes_read);
-    session.appendBuffer(segments.back(), buffer);
-    current_segment_size += num_bytes_read;
-    if (current_segment_size >= max_segment_size) {  // Defensive >= (read shouldn't read larger than requested size)
-      needs_new_segment = true;
-      current_segment_size = 0;
-    }
-  };
+    segments.push_back(std::move(segment));
+  }
 
   updateSplitAttributesAndTransfer(session, segments, *original);
   session.transfer(original, Original);
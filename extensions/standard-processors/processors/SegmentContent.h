@@ -68,12 +68,8 @@ class SegmentContent final : public core::ProcessorImpl {
   EXTENSIONAPI static constexpr bool IsSingleThreaded = false;
   ADD_COMMON_VIRTUAL_FUNCTIONS_FOR_PROCESSORS
 
-  void onSchedule(core::ProcessContext& context, core::ProcessSessionFactory& session_factory) override;
   void onTrigger(core::ProcessContext& context, core::ProcessSession& session) override;
   void initialize() override;
-
- private:
-  size_t buffer_size_{};
 };
 
 }  // namespace org::apache::nifi::minifi::processors
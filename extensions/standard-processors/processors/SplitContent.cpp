@@ -18,6 +18,12 @@
 
 #include "SplitContent.h"
 
+#include <algorithm>
+#include <optional>
+#include <span>
+#include <string>
+#include <vector>
+
 #include <range/v3/view/split.hpp>
 
 #include "minifi-cpp/core/FlowFile.h"
@@ -27,6 +33,7 @@
 #include "utils/ConfigurationUtils.h"
 #include "utils/ProcessorConfigUtils.h"
 #include "minifi-cpp/utils/gsl.h"
+#include "utils/ByteScanner.h"
 
 namespace org::apache::nifi::minifi::processors {
 void SplitContent::initialize() {
@@ -38,31 +45,36 @@ void SplitContent::onSchedule(core::ProcessContext& context, core::ProcessSessio
   buffer_size_ = utils::configuration::getBufferSize(*context.getConfiguration());
   auto byte_sequence_str = utils::parseProperty(context, ByteSequence);
   const auto byte_sequence_format = utils::parseEnumProperty<ByteSequenceFormat>(context, ByteSequenceFormatProperty);
-  std::vector<std::byte> byte_sequence{};
+  std::string byte_sequence;
   if (byte_sequence_format == ByteSequenceFormat::Hexadecimal) {
-    byte_sequence = utils::string::from_hex(byte_sequence_str);
+    const auto byte_sequence_bytes = utils::string::from_hex(byte_sequence_str);
+    byte_sequence.assign(reinterpret_cast<const char*>(byte_sequence_bytes.data()), byte_sequence_bytes.size());
   } else {
-    byte_sequence.resize(byte_sequence_str.size());
-    std::ranges::transform(byte_sequence_str, byte_sequence.begin(), [](char c) { return static_cast<std::byte>(c); });
+    byte_sequence = std::move(byte_sequence_str);
   }
   if (byte_sequence.empty()) { throw Exception(PROCESS_SCHEDULE_EXCEPTION, "Cannot operate without byte sequence"); }
-  byte_sequence_matcher_.emplace(ByteSequenceMatcher(std::move(byte_sequence)));
+  byte_sequence_scanner_.emplace(std::move(byte_sequence));
   byte_sequence_location_ = utils::parseEnumProperty<ByteSequenceLocation>(context, ByteSequenceLocationProperty);
   keep_byte_sequence = utils::parseBoolProperty(context, KeepByteSequence);
 }
 
 namespace {
+/**
+ * The content is digested in chunks, which are searched for the byte sequence with a DelimiterScanner. The last bytes of a chunk,
+ * which could be the beginning of a byte sequence continuing in the next chunk, are kept back and searched together with the next chunk.
+ * Every split is a contiguous range of the original content, so only its boundaries are tracked, and it is cloned from the original
+ * as a view over its content when it is closed.
+ */
 class Splitter {
  public:
-  explicit Splitter(core::ProcessSession& session, std::optional<std::string> original_filename, SplitContent::ByteSequenceMatcher& byte_sequence_matcher, const bool keep_byte_sequence,
+  explicit Splitter(core::ProcessSession& session, const core::FlowFile& original, const utils::DelimiterScanner& byte_sequence_scanner, const bool keep_byte_sequence,
       const SplitContent::ByteSequenceLocation byte_sequence_location, const size_t buffer_size)
       : session_(session),
-        original_filename_(std::move(original_filename)),
-        byte_sequence_matcher_(byte_sequence_matcher),
+        original_(original),
+        byte_sequence_scanner_(byte_sequence_scanner),
         keep_trailing_byte_sequence_(keep_byte_sequence && byte_sequence_location == SplitContent::ByteSequenceLocation::Trailing),
-        keep_leading_byte_sequence_(keep_byte_sequence && byte_sequence_location == SplitContent::ByteSequenceLocation::Leading),
-        buffer_size_(buffer_size) {
-    data_before_byte_sequence_.reserve(buffer_size_);
+        keep_leading_byte_sequence_(keep_byte_sequence && byte_sequence_location == SplitContent::ByteSequenceLocation::Leading) {
+    pending_data_.reserve(buffer_size + byte_sequence_scanner_.size());
   }
 
   Splitter(const Splitter&) = delete;
@@ -70,139 +82,93 @@ class Splitter {
   Splitter(Splitter&&) = delete;
   Splitter& operator=(Splitter&&) = delete;
 
-  ~Splitter() {
-    flushRemainingData();
-    updateSplitAttributesAndTransfer();
-  }
+  ~Splitter() = default;
 
-  void digest(const std::byte b) {
-    const auto prev_matching_bytes = matching_bytes_;
-    matching_bytes_ = byte_sequence_matcher_.getNumberOfMatchingBytes(matching_bytes_, b);
-    if (matchedByteSequence()) {
-      appendDataBeforeByteSequenceToSplit();
-      if (keep_trailing_byte_sequence_) { appendByteSequenceToSplit(); }
+  void digest(const std::span<const std::byte> chunk) {
+    pending_data_.append(reinterpret_cast<const char*>(chunk.data()), chunk.size());
+    size_t position = 0;
+    for (auto match = byte_sequence_scanner_.find(pending_data_); match != std::string_view::npos; match = byte_sequence_scanner_.find(pending_data_, position)) {
+      appendDataToSplit(position, match - position);
+      if (keep_trailing_byte_sequence_) { appendDataToSplit(match, byte_sequence_scanner_.size()); }
       closeCurrentSplit();
 
       // possible new split
-      if (keep_leading_byte_sequence_) { appendByteSequenceToSplit(); }
-      matching_bytes_ = 0;
-      return;
-    }
-    // matching grew, no need to grow data_before_byte_sequence
-    if (matching_bytes_ > prev_matching_bytes) { return; }
-
-    if (matching_bytes_ > 0) {
-      // last byte could be part of the byte_sequence
-      std::copy_n(getByteSequence().begin(), prev_matching_bytes - matching_bytes_ + 1, std::back_inserter(data_before_byte_sequence_));
-    } else {
-      // last byte is not part of the byte_sequence
-      std::copy_n(getByteSequence().begin(), prev_matching_bytes - matching_bytes_, std::back_inserter(data_before_byte_sequence_));
-      data_before_byte_sequence_.push_back(b);
+      if (keep_leading_byte_sequence_) { appendDataToSplit(match, byte_sequence_scanner_.size()); }
+      position = match + byte_sequence_scanner_.size();
     }
+
+    const size_t kept_size = std::min(pending_data_.size() - position, byte_sequence_scanner_.size() - 1);
+    appendDataToSplit(position, pending_data_.size() - position - kept_size);
+    pending_data_offset_ += pending_data_.size() - kept_size;
+    pending_data_.erase(0, pending_data_.size() - kept_size);
   }
 
-  void flushIfBufferTooLarge() {
-    if (data_before_byte_sequence_.size() >= buffer_size_) { appendDataBeforeByteSequenceToSplit(); }
+  void finish() {
+    flushRemainingData();
+    updateSplitAttributesAndTransfer();
   }
 
  private:
+  struct Range {
+    uint64_t begin = 0;
+    uint64_t end = 0;
+  };
+
   void closeCurrentSplit() {
     if (current_split_) {
-      completed_splits_.push_back(current_split_);
+      auto split = session_.clone(original_, gsl::narrow<int64_t>(current_split_->begin), gsl::narrow<int64_t>(current_split_->end - current_split_->begin));
+      if (!split) {
+        throw Exception(PROCESSOR_EXCEPTION, fmt::format("Couldn't create split {}:{} of {}", current_split_->begin, current_split_->end - current_split_->begin, original_.getUUIDStr()));
+      }
+      completed_splits_.push_back(std::move(split));
       current_split_.reset();
     }
   }
 
-  void appendDataBeforeByteSequenceToSplit() {
-    if (data_before_byte_sequence_.empty()) { return; }
-    ensureCurrentSplit();
-    session_.appendBuffer(current_split_, std::span<const std::byte>(data_before_byte_sequence_.data(), data_before_byte_sequence_.size()));
-    data_before_byte_sequence_.clear();
-  }
-
-  void appendByteSequenceToSplit() {
-    ensureCurrentSplit();
-    session_.appendBuffer(current_split_, getByteSequence());
-  }
-
-  [[nodiscard]] std::span<const std::byte> getByteSequence() const { return byte_sequence_matcher_.getByteSequence(); }
-
-  void ensureCurrentSplit() {
-    if (!current_split_) { current_split_ = session_.create(); }
+  // position is relative to the pending data, the data is always directly after the end of the current split in the original content
+  void appendDataToSplit(const size_t position, const size_t size) {
+    if (size == 0) { return; }
+    const uint64_t begin = pending_data_offset_ + position;
+    if (!current_split_) { current_split_ = Range{.begin = begin, .end = begin}; }
+    gsl_Assert(current_split_->end == begin);
+    current_split_->end += size;
   }
 
-  [[nodiscard]] bool matchedByteSequence() const { return matching_bytes_ == byte_sequence_matcher_.getByteSequence().size(); }
-
   void flushRemainingData() {
-    if (current_split_ || !data_before_byte_sequence_.empty() || matching_bytes_ > 0) {
-      ensureCurrentSplit();
-      session_.appendBuffer(current_split_, std::span<const std::byte>(data_before_byte_sequence_.data(), data_before_byte_sequence_.size()));
-      session_.appendBuffer(current_split_, byte_sequence_matcher_.getByteSequence().subspan(0, matching_bytes_));
-      completed_splits_.push_back(current_split_);
+    if (current_split_ || !pending_data_.empty()) {
+      if (!current_split_) { current_split_ = Range{.begin = pending_data_offset_, .end = pending_data_offset_}; }
+      appendDataToSplit(0, pending_data_.size());
+      closeCurrentSplit();
     }
   }
 
   void updateSplitAttributesAndTransfer() const {
     const std::string fragment_identifier_ = utils::IdGenerator::getIdGenerator()->generate().to_string();
+    const auto original_filename = original_.getAttribute(core::SpecialFlowAttribute::FILENAME);
     for (size_t split_i = 0; split_i < completed_splits_.size(); ++split_i) {
       const auto& split = completed_splits_[split_i];
       split->setAttribute(SplitContent::FragmentCountOutputAttribute.name, std::to_string(completed_splits_.size()));
       split->setAttribute(SplitContent::FragmentIndexOutputAttribute.name, std::to_string(split_i + 1));  // One based indexing
       split->setAttribute(SplitContent::FragmentIdentifierOutputAttribute.name, fragment_identifier_);
-      split->setAttribute(SplitContent::SegmentOriginalFilenameOutputAttribute.name, original_filename_.value_or(""));
+      split->setAttribute(SplitContent::SegmentOriginalFilenameOutputAttribute.name, original_filename.value_or(""));
       session_.transfer(split, SplitContent::Splits);
     }
   }
 
   core::ProcessSession& session_;
-  const std::optional<std::string> original_filename_;
-  SplitContent::ByteSequenceMatcher& byte_sequence_matcher_;
-  std::vector<std::byte> data_before_byte_sequence_;
-  std::shared_ptr<core::FlowFile> current_split_ = nullptr;
+  const core::FlowFile& original_;
+  const utils::DelimiterScanner& byte_sequence_scanner_;
+  std::string pending_data_;  // the data not yet added to a split, it is shorter than the byte sequence between the chunks
+  uint64_t pending_data_offset_ = 0;  // the offset of the pending data in the original content
+  std::optional<Range> current_split_;
   std::vector<std::shared_ptr<core::FlowFile>> completed_splits_;
-  SplitContent::size_type matching_bytes_ = 0;
   const bool keep_trailing_byte_sequence_ = false;
   const bool keep_leading_byte_sequence_ = false;
-  size_t buffer_size_{};
 };
 }  // namespace
 
-SplitContent::ByteSequenceMatcher::ByteSequenceMatcher(std::vector<std::byte> byte_sequence) : byte_sequence_(std::move(byte_sequence)) {
-  byte_sequence_nodes_.push_back(node{.byte = {}, .cache = {}, .previous_max_match = {}});
-  for (const auto& byte: byte_sequence_) { byte_sequence_nodes_.push_back(node{.byte = byte, .cache = {}, .previous_max_match = {}}); }
-}
-
-SplitContent::size_type SplitContent::ByteSequenceMatcher::getNumberOfMatchingBytes(const size_type number_of_currently_matching_bytes, const std::byte next_byte) {
-  gsl_Assert(number_of_currently_matching_bytes <= byte_sequence_nodes_.size());
-  auto& curr_go = byte_sequence_nodes_[number_of_currently_matching_bytes].cache;
-  if (curr_go.contains(next_byte)) { return curr_go.at(next_byte); }
-  if (next_byte == byte_sequence_nodes_[number_of_currently_matching_bytes + 1].byte) {
-    curr_go[next_byte] = number_of_currently_matching_bytes + 1;
-    return number_of_currently_matching_bytes + 1;
-  }
-  if (number_of_currently_matching_bytes == 0) {
-    curr_go[next_byte] = 0;
-    return 0;
-  }
-
-  curr_go[next_byte] = getNumberOfMatchingBytes(getPreviousMaxMatch(number_of_currently_matching_bytes), next_byte);
-  return curr_go.at(next_byte);
-}
-
-SplitContent::size_type SplitContent::ByteSequenceMatcher::getPreviousMaxMatch(const size_type number_of_currently_matching_bytes) {
-  gsl_Assert(number_of_currently_matching_bytes <= byte_sequence_nodes_.size());
-  auto& prev_max_match = byte_sequence_nodes_[number_of_currently_matching_bytes].previous_max_match;
-  if (prev_max_match) { return *prev_max_match; }
-  if (number_of_currently_matching_bytes <= 1) {
-    prev_max_match = 0;
-    return 0;
-  }
-  prev_max_match = getNumberOfMatchingBytes(getPreviousMaxMatch(number_of_currently_matching_bytes - 1), byte_sequence_nodes_[number_of_currently_matching_bytes].byte);
-  return *prev_max_match;
-}
-
 void SplitContent::onTrigger(core::ProcessContext& context, core::ProcessSession& session) {
-  gsl_Assert(byte_sequence_matcher_);
+  gsl_Assert(byte_sequence_scanner_);
   const auto original = session.get();
   if (!original) {
     context.yield();
@@ -212,12 +178,16 @@ void SplitContent::onTrigger(core::ProcessContext& context, core::ProcessSession
   const auto ff_content_stream = session.getFlowFileContentStream(*original);
   if (!ff_content_stream) { throw Exception(PROCESSOR_EXCEPTION, fmt::format("Couldn't access the ContentStream of {}", original->getUUID().to_string())); }
 
-  Splitter splitter{session, original->getAttribute(core::SpecialFlowAttribute::FILENAME), *byte_sequence_matcher_, keep_byte_sequence, byte_sequence_location_, buffer_size_};
+  Splitter splitter{session, *original, *byte_sequence_scanner_, keep_byte_sequence, byte_sequence_location_, buffer_size_};
 
-  while (auto latest_byte = ff_content_stream->readByte()) {
-    splitter.digest(*latest_byte);
-    splitter.flushIfBufferTooLarge();
+  std::vector<std::byte> buffer(std::max(buffer_size_, size_t{1}));
+  while (true) {
+    const auto read_size = ff_content_stream->read(buffer);
+    if (io::isError(read_size)) { throw Exception(PROCESSOR_EXCEPTION, fmt::format("Failed to read the content of {}", original->getUUID().to_string())); }
+    if (read_size == 0) { break; }
+    splitter.digest(std::span(buffer).subspan(0, read_size));
   }
+  splitter.finish();
 
   session.transfer(original, Original);
 }
@@ -29,6 +29,7 @@
 #include "minifi-cpp/core/PropertyValidator.h"
 #include "minifi-cpp/core/RelationshipDefinition.h"
 #include "minifi-cpp/utils/Export.h"
+#include "utils/ByteScanner.h"
 
 namespace org::apache::nifi::minifi::processors {
 
@@ -36,7 +37,6 @@ class SplitContent final : public core::ProcessorImpl {
  public:
   using ProcessorImpl::ProcessorImpl;
 
-  using size_type = std::vector<std::byte>::size_type;
   enum class ByteSequenceFormat { Hexadecimal, Text };
   enum class ByteSequenceLocation { Trailing, Leading };
 
@@ -100,26 +100,8 @@ class SplitContent final : public core::ProcessorImpl {
   void onTrigger(core::ProcessContext& context, core::ProcessSession& session) override;
   void initialize() override;
 
-  class ByteSequenceMatcher {
-   public:
-    using size_type = std::vector<std::byte>::size_type;
-    explicit ByteSequenceMatcher(std::vector<std::byte> byte_sequence);
-    size_type getNumberOfMatchingBytes(size_type number_of_currently_matching_bytes, std::byte next_byte);
-    size_type getPreviousMaxMatch(size_type number_of_currently_matching_bytes);
-    [[nodiscard]] std::span<const std::byte> getByteSequence() const { return byte_sequence_; }
-
-   private:
-    struct node {
-      std::byte byte;
-      std::unordered_map<std::byte, size_type> cache;
-      std::optional<size_type> previous_max_match;
-    };
-    std::vector<node> byte_sequence_nodes_;
-    const std::vector<std::byte> byte_sequence_;
-  };
-
  private:
-  std::optional<ByteSequenceMatcher> byte_sequence_matcher_;
+  std::optional<utils::DelimiterScanner> byte_sequence_scanner_;
   bool keep_byte_sequence = false;
   ByteSequenceLocation byte_sequence_location_ = ByteSequenceLocation::Trailing;
   size_t buffer_size_{};
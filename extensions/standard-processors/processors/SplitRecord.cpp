@@ -17,6 +17,10 @@
 #include "SplitRecord.h"
 
 #include <expected>
+#include <memory>
+#include <optional>
+#include <string>
+#include <vector>
 
 #include "core/Resource.h"
 #include "utils/GeneralUtils.h"
@@ -55,46 +59,62 @@ void SplitRecord::onTrigger(core::ProcessContext& context, core::ProcessSession&
     return;
   }
 
-  std::expected<core::RecordSet, std::error_code> record_set;
-  session.read(original_flow_file, [this, &record_set](const std::shared_ptr<io::InputStream>& input_stream) -> io::IoResult {
-    record_set = record_converter_->record_set_reader->read(*input_stream);
+  // the records are read and written one split at a time, the number of splits is only known after the last record
+  const auto fragment_identifier = original_flow_file->getAttribute(core::SpecialFlowAttribute::UUID).value_or(utils::IdGenerator::getIdGenerator()->generate().to_string());
+  std::vector<std::shared_ptr<core::FlowFile>> split_flow_files;
+  std::optional<std::error_code> read_error;
+  bool split_creation_failed = false;
+  session.read(original_flow_file, [&](const std::shared_ptr<io::InputStream>& input_stream) -> io::IoResult {
+    const auto record_reader = record_converter_->record_set_reader->createRecordReader(*input_stream);
+    auto record = record_reader->next();
+    while (record && *record) {
+      auto split_flow_file = session.create(original_flow_file.get());
+      if (!split_flow_file) {
+        split_creation_failed = true;
+        return io::IoResult::from(input_stream->size());
+      }
+      split_flow_files.push_back(split_flow_file);
+
+      std::size_t split_record_count = 0;
+      session.write(split_flow_file, [&](const std::shared_ptr<io::OutputStream>& output_stream) -> io::IoResult {
+        const auto record_writer = record_converter_->record_set_writer->createRecordWriter(*output_stream);
+        for (; record && *record && split_record_count < *records_per_split; ++split_record_count) {
+          if (!record_writer->write(**record)) {
+            return io::IoResult::error();
+          }
+          record = record_reader->next();
+        }
+        return record_writer->finish() ? io::IoResult::zero() : io::IoResult::error();
+      });
+
+      split_flow_file->setAttribute("record.count", std::to_string(split_record_count));
+      split_flow_file->setAttribute("fragment.identifier", fragment_identifier);
+      split_flow_file->setAttribute("fragment.index", std::to_string(split_flow_files.size() - 1));
+      split_flow_file->setAttribute("segment.original.filename", original_flow_file->getAttribute("filename").value_or(""));
+    }
+    if (!record) {
+      read_error = record.error();
+    }
     return io::IoResult::from(input_stream->size());
   });
-  if (!record_set) {
-    logger_->log_error("Failed to read record set from flow file: {}", record_set.error().message());
-    session.transfer(original_flow_file, Failure);
-    return;
-  }
 
-  std::size_t current_index = 0;
-  const auto fragment_identifier = original_flow_file->getAttribute(core::SpecialFlowAttribute::UUID).value_or(utils::IdGenerator::getIdGenerator()->generate().to_string());
-  std::size_t fragment_index = 0;
-  const auto fragment_count = utils::intdiv_ceil(record_set->size(), records_per_split.value());
-  while (current_index < record_set->size()) {
-    auto split_flow_file = session.create(original_flow_file.get());
-    if (!split_flow_file) {
+  if (read_error || split_creation_failed) {
+    if (read_error) {
+      logger_->log_error("Failed to read record set from flow file: {}", read_error->message());
+    } else {
       logger_->log_error("Failed to create a new flow file for record set");
-      session.transfer(original_flow_file, Failure);
-      return;
     }
-
-    core::RecordSet slice_record_set;
-    slice_record_set.reserve(*records_per_split);
-    for (std::size_t i = 0; i < records_per_split.value() && current_index < record_set->size(); ++i, ++current_index) {
-      slice_record_set.push_back(std::move(record_set->at(current_index)));
+    for (const auto& split_flow_file : split_flow_files) {
+      session.remove(split_flow_file);
     }
+    session.transfer(original_flow_file, Failure);
+    return;
+  }
 
-    split_flow_file->setAttribute("record.count", std::to_string(slice_record_set.size()));
-    split_flow_file->setAttribute("fragment.identifier", fragment_identifier);
-    split_flow_file->setAttribute("fragment.index", std::to_string(fragment_index));
-    split_flow_file->setAttribute("fragment.count", std::to_string(fragment_count));
-    split_flow_file->setAttribute("segment.original.filename", original_flow_file->getAttribute("filename").value_or(""));
-
-    record_converter_->record_set_writer->write(slice_record_set, split_flow_file, session);
+  for (const auto& split_flow_file : split_flow_files) {
+    split_flow_file->setAttribute("fragment.count", std::to_string(split_flow_files.size()));
     session.transfer(split_flow_file, Splits);
-    ++fragment_index;
   }
-
   session.transfer(original_flow_file, Original);
 }
 
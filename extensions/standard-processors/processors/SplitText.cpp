@@ -103,13 +103,10 @@ std::optional<LineReader::LineInfo> LineReader::readNextLine(const std::optional
       return std::nullopt;
     }
 
-    const auto begin = buffer_.begin() + gsl::narrow<std::vector<char>::difference_type>(buffer_offset_);
-    const auto end = buffer_.begin() + gsl::narrow<std::vector<char>::difference_type>(last_read_size_);
-    auto endline_pos = std::find_if(begin, end, [](const auto& buffer_element) { return buffer_element == '\n'; });
-    if (endline_pos != end) {
-      const auto line_length = std::distance(buffer_.begin(), endline_pos);
-      buffer_offset_ = line_length + 1;
-      return finalizeLineInfo(getEndLineSize(line_length), starts_with);
+    const auto endline_pos = newline_scanner_.find(std::string_view(buffer_.data(), last_read_size_), buffer_offset_);
+    if (endline_pos != std::string_view::npos) {
+      buffer_offset_ = endline_pos + 1;
+      return finalizeLineInfo(getEndLineSize(endline_pos), starts_with);
     } else {
       buffer_offset_ = last_read_size_;
     }
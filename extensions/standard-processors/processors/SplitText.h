@@ -31,6 +31,7 @@
 #include "minifi-cpp/core/PropertyValidator.h"
 #include "minifi-cpp/core/RelationshipDefinition.h"
 #include "minifi-cpp/utils/Export.h"
+#include "utils/ByteScanner.h"
 #include "utils/expected.h"
 
 namespace org::apache::nifi::minifi::processors {
@@ -81,6 +82,7 @@ class LineReader {
   std::vector<char> buffer_ = std::vector<char>(buffer_size_);
   std::optional<LineInfo> last_line_info_;
   StreamReadState state_ = StreamReadState::Ok;
+  utils::DelimiterScanner newline_scanner_{"\n"};
 };
 
 }  // namespace detail
@@ -30,6 +30,7 @@
 #include "range/v3/action/sort.hpp"
 
 #include "io/CRCStream.h"
+#include "utils/ByteScanner.h"
 #include "utils/ConfigurationUtils.h"
 #include "utils/file/FileUtils.h"
 #include "utils/file/PathUtils.h"
@@ -82,6 +83,15 @@ std::map<std::filesystem::path, TailState> update_keys_in_legacy_states(const st
   return new_tail_states;
 }
 
+// confirms the candidate by its content, as inodes can be reused; older states only have the checksum of all the content read so far,
+// which is only used if there is no head fingerprint
+bool isContinuationOf(const std::filesystem::path& file_name, const TailState& state) {
+  if (state.head_size_ > 0) {
+    return utils::file::computeChecksum(file_name, state.head_size_) == state.head_checksum_;
+  }
+  return utils::file::computeChecksum(file_name, state.position_) == state.checksum_;
+}
+
 void openFile(const std::filesystem::path& file_path, uint64_t offset, std::ifstream &input_stream, const std::shared_ptr<core::logging::Logger> &logger) {
   logger->log_debug("Opening {}", file_path);
   input_stream.open(file_path, std::fstream::in | std::fstream::binary);
@@ -105,7 +115,7 @@ class FileReaderCallback {
                      char input_delimiter,
                      uint64_t checksum,
                      size_t buffer_size)
-    : input_delimiter_(input_delimiter),
+    : delimiter_scanner_(std::string(1, input_delimiter)),
       checksum_(checksum),
       buffer_size_(buffer_size) {
     openFile(file_path, offset, input_stream_, logger_);
@@ -128,10 +138,11 @@ class FileReaderCallback {
         end_ = begin_ + num_bytes_read;
       }
 
-      char *delimiter_pos = std::find(begin_, end_, input_delimiter_);
-      found_delimiter = (delimiter_pos != end_);
+      const std::string_view unprocessed(begin_, gsl::narrow<size_t>(std::distance(begin_, end_)));
+      const auto delimiter_pos = delimiter_scanner_.find(unprocessed);
+      found_delimiter = (delimiter_pos != std::string_view::npos);
 
-      const auto zlen = gsl::narrow<size_t>(std::distance(begin_, delimiter_pos)) + (found_delimiter ? 1 : 0);
+      const auto zlen = found_delimiter ? delimiter_pos + 1 : unprocessed.size();
       crc_stream.write(reinterpret_cast<uint8_t*>(begin_), zlen);
       num_bytes_written += zlen;
       begin_ += zlen;
@@ -159,7 +170,7 @@ class FileReaderCallback {
   }
 
  private:
-  char input_delimiter_{};
+  utils::DelimiterScanner delimiter_scanner_;
   uint64_t checksum_{};
   std::ifstream input_stream_;
   size_t buffer_size_{};
@@ -240,6 +251,12 @@ void TailFile::initialize() {
 void TailFile::onSchedule(core::ProcessContext& context, core::ProcessSessionFactory&) {
   buffer_size_ = utils::configuration::getBufferSize(*context.getConfiguration());
   tail_states_.clear();
+  files_to_check_.clear();
+  if (utils::parseEnumProperty<utils::file::ChangeDetectionStrategy>(context, ChangeDetection) == utils::file::ChangeDetectionStrategy::FileSystemEvents) {
+    file_change_watcher_ = std::make_unique<utils::file::FileChangeWatcher>();
+  } else {
+    file_change_watcher_.reset();
+  }
 
   auto temp_state_manager = context.createStateManager();
   if (temp_state_manager == nullptr) {
@@ -426,12 +443,21 @@ bool TailFile::getStateFromStateManager(core::StateManager& state_manager, std::
         }};
 
         std::filesystem::path file_path = current;
-        if (file_path.has_filename() && file_path.has_parent_path()) {
-          logger_->log_debug("Received path {}, file {}", file_path.parent_path(), file_path.filename());
-          new_tail_states.emplace(current, TailState{file_path.parent_path(), file_path.filename(), position, last_read_time, checksum});
-        } else {
-          new_tail_states.emplace(current, TailState{file_path.parent_path(), file_path, position, last_read_time, checksum});
+        TailState tail_state = [&] {
+          if (file_path.has_filename() && file_path.has_parent_path()) {
+            logger_->log_debug("Received path {}, file {}", file_path.parent_path(), file_path.filename());
+            return TailState{file_path.parent_path(), file_path.filename(), position, last_read_time, checksum};
+          }
+          return TailState{file_path.parent_path(), file_path, position, last_read_time, checksum};
+        }();
+        tail_state.head_size_ = readOptionalUint64(state_map, "file." + std::to_string(i) + ".head_size");
+        tail_state.head_checksum_ = readOptionalUint64(state_map, "file." + std::to_string(i) + ".head_checksum");
+        if (state_map.contains("file." + std::to_string(i) + ".inode")) {
+          tail_state.file_identity_ = utils::file::FileIdentity{
+              .device = readOptionalUint64(state_map, "file." + std::to_string(i) + ".device"),
+              .inode = readOptionalUint64(state_map, "file." + std::to_string(i) + ".inode")};
         }
+        new_tail_states.emplace(current, std::move(tail_state));
       } catch (...) {
         continue;
       }
@@ -492,6 +518,12 @@ bool TailFile::storeState(core::StateManager& state_manager) const {
     state["file." + std::to_string(i) + ".position"] = std::to_string(tail_state.second.position_);
     state["file." + std::to_string(i) + ".checksum"] = std::to_string(tail_state.second.checksum_);
     state["file." + std::to_string(i) + ".last_read_time"] = std::to_string(tail_state.second.lastReadTimeInMilliseconds());
+    state["file." + std::to_string(i) + ".head_size"] = std::to_string(tail_state.second.head_size_);
+    state["file." + std::to_string(i) + ".head_checksum"] = std::to_string(tail_state.second.head_checksum_);
+    if (const auto& file_identity = tail_state.second.file_identity_) {
+      state["file." + std::to_string(i) + ".device"] = std::to_string(file_identity->device);
+      state["file." + std::to_string(i) + ".inode"] = std::to_string(file_identity->inode);
+    }
     ++i;
   }
   if (!state_manager.set(state)) {
@@ -562,13 +594,19 @@ std::vector<TailState> TailFile::sortAndSkipMainFilePrefix(const TailState &stat
   matched_files_with_mtime |= ranges::actions::sort(first_by_mtime_then_by_name);
 
   if (!matched_files_with_mtime.empty() && state.position_ > 0) {
-    TailState &first_rotated_file = matched_files_with_mtime[0].tail_state_;
-    auto full_file_name = first_rotated_file.fileNameWithPath();
-    if (utils::file::file_size(full_file_name) >= state.position_) {
-      if (utils::file::computeChecksum(full_file_name, state.position_) == state.checksum_) {
-        first_rotated_file.position_ = state.position_;
-        first_rotated_file.checksum_ = state.checksum_;
-      }
+    // the renamed file is the one with the device and inode of the file we were reading; if there is no such file
+    // (e.g. it was copied and truncated, or the state has no identity), we try the oldest rotated file
+    auto continuation = std::ranges::find_if(matched_files_with_mtime, [&state](const TailStateWithMtime& rotated_file) {
+      return state.file_identity_ && utils::file::get_file_identity(rotated_file.tail_state_.fileNameWithPath()) == state.file_identity_;
+    });
+    if (continuation == matched_files_with_mtime.end()) {
+      continuation = matched_files_with_mtime.begin();
+    }
+    TailState &rotated_file = continuation->tail_state_;
+    auto full_file_name = rotated_file.fileNameWithPath();
+    if (utils::file::file_size(full_file_name) >= state.position_ && isContinuationOf(full_file_name, state)) {
+      rotated_file.position_ = state.position_;
+      rotated_file.checksum_ = state.checksum_;
     }
   }
 
@@ -596,8 +634,17 @@ void TailFile::onTrigger(core::ProcessContext& context, core::ProcessSession& se
   }
 
   // iterate over file states. may modify them
-  for (auto &state : tail_states_) {
-    processFile(session, state.first, state.second, *state_manager);
+  const auto files_to_check = findFilesToCheck();
+  for (auto &[full_file_name, state] : tail_states_) {
+    if (files_to_check && !files_to_check->contains(full_file_name)) {
+      continue;
+    }
+    const auto position = state.position_;
+    processFile(session, full_file_name, state, *state_manager);
+    if (file_change_watcher_ && state.position_ != position) {
+      // the batch size may have left some of the new data unread
+      files_to_check_.insert(full_file_name);
+    }
   }
 
   if (!session.existsFlowFileInRelationship(Success)) {
@@ -607,6 +654,27 @@ void TailFile::onTrigger(core::ProcessContext& context, core::ProcessSession& se
   first_trigger_ = false;
 }
 
+std::optional<std::set<std::filesystem::path>> TailFile::findFilesToCheck() {
+  if (!file_change_watcher_) {
+    return std::nullopt;
+  }
+  auto files_to_check = std::exchange(files_to_check_, {});
+  // the directories are watched before the files are checked, so no change after the check can be missed
+  for (const auto& [full_file_name, state] : tail_states_) {
+    if (!file_change_watcher_->isWatched(state.path_)) {
+      files_to_check.insert(full_file_name);
+      file_change_watcher_->watch(state.path_);
+    }
+  }
+  auto changed_files = file_change_watcher_->takeChangedFiles();
+  if (!changed_files) {
+    logger_->log_debug("Some file system events may have been lost, checking every file");
+    return std::nullopt;
+  }
+  files_to_check.merge(*changed_files);
+  return files_to_check;
+}
+
 bool TailFile::isOldFileInitiallyRead(const TailState& state) const {
   // This is our initial processing and no stored state was found
   return first_trigger_ && state.last_read_time_ == std::chrono::file_clock::time_point{};
@@ -616,19 +684,26 @@ void TailFile::processFile(core::ProcessSession& session,
                            const std::filesystem::path& full_file_name,
                            TailState &state,
                            core::StateManager& state_manager) {
+  const auto file_identity = utils::file::get_file_identity(full_file_name);
   if (isOldFileInitiallyRead(state)) {
     if (initial_start_position_ == InitialStartPositions::BEGINNING_OF_TIME) {
       processAllRotatedFiles(session, state);
     } else if (initial_start_position_ == InitialStartPositions::CURRENT_TIME) {
+      // the skipped content is not checksummed, the file is recognized after a rotation by its head fingerprint
       state.position_ = utils::file::file_size(full_file_name);
       state.last_read_time_ = std::chrono::file_clock::now();
-      state.checksum_ = utils::file::computeChecksum(full_file_name, state.position_);
+      state.checksum_ = 0;
+      state.head_size_ = 0;
+      state.file_identity_ = file_identity;
+      updateHeadFingerprint(state);
       storeState(state_manager);
       return;
     }
   } else {
     uint64_t fsize = utils::file::file_size(full_file_name);
-    if (fsize < state.position_) {
+    // a new file may already have more content than the old one had when it was renamed
+    const bool is_replaced = state.file_identity_ && file_identity && *state.file_identity_ != *file_identity;
+    if (fsize < state.position_ || is_replaced) {
       processRotatedFilesAfterLastReadTime(session, state);
     } else if (fsize == state.position_) {
       logger_->log_trace("Skipping file {} as its size hasn't changed since last read", state.file_name_);
@@ -636,7 +711,11 @@ void TailFile::processFile(core::ProcessSession& session,
     }
   }
 
+  if (file_identity) {
+    state.file_identity_ = file_identity;
+  }
   processSingleFile(session, full_file_name, state);
+  updateHeadFingerprint(state);
   storeState(state_manager);
 }
 
@@ -656,6 +735,8 @@ void TailFile::processRotatedFiles(core::ProcessSession& session, TailState &sta
   }
   state.position_ = 0;
   state.checksum_ = 0;
+  state.head_size_ = 0;
+  state.head_checksum_ = 0;
 }
 
 void TailFile::processSingleFile(core::ProcessSession& session,
@@ -742,6 +823,16 @@ void TailFile::updateStateAttributes(TailState &state, uint64_t size, uint64_t c
   state.checksum_ = checksum;
 }
 
+void TailFile::updateHeadFingerprint(TailState &state) {
+  // the fingerprint only has to be extended until it reaches its full size, so this reads at most a few kilobytes per file
+  const auto head_size = std::min(state.position_, HEAD_FINGERPRINT_SIZE);
+  if (head_size <= state.head_size_) {
+    return;
+  }
+  state.head_size_ = head_size;
+  state.head_checksum_ = utils::file::computeChecksum(state.fileNameWithPath(), head_size);
+}
+
 void TailFile::doMultifileLookup(core::ProcessContext& context) {
   checkForRemovedFiles();
   checkForNewFiles(context);
@@ -772,6 +863,10 @@ void TailFile::checkForNewFiles(core::ProcessContext& context) {
     auto full_file_name = path / file_name;
     if (!containsKey(tail_states_, full_file_name) && utils::regexMatch(file_name.string(), *pattern_regex_)) {
       tail_states_.emplace(full_file_name, TailState{path, file_name});
+      if (file_change_watcher_) {
+        // its creation may have been reported before it was found
+        files_to_check_.insert(full_file_name);
+      }
     }
     return true;
   };
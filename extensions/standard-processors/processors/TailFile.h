@@ -21,6 +21,7 @@
 
 #include <map>
 #include <memory>
+#include <set>
 #include <utility>
 #include <string>
 #include <unordered_map>
@@ -39,6 +40,8 @@
 #include "utils/Enum.h"
 #include "minifi-cpp/utils/Export.h"
 #include "utils/RegexUtils.h"
+#include "utils/file/FileUtils.h"
+#include "../utils/FileChangeWatcher.h"
 
 namespace org::apache::nifi::minifi::processors {
 
@@ -111,6 +114,10 @@ struct TailState {
   std::chrono::file_clock::time_point last_read_time_;
   uint64_t checksum_ = 0;
   bool is_rotated_ = false;
+  // the checksum of the first head_size_ bytes, used to recognize the file after it is rotated
+  uint64_t head_size_ = 0;
+  uint64_t head_checksum_ = 0;
+  std::optional<utils::file::FileIdentity> file_identity_;
 };
 
 std::ostream& operator<<(std::ostream &os, const TailState &tail_state);
@@ -207,6 +214,16 @@ class TailFile : public core::ProcessorImpl {
       .withDefaultValue(magic_enum::enum_name(TailResultFormat::FlowFilePerDelimiter))
       .withAllowedValues(magic_enum::enum_names<TailResultFormat>())
       .build();
+  EXTENSIONAPI static constexpr auto ChangeDetection = core::PropertyDefinitionBuilder<magic_enum::enum_count<utils::file::ChangeDetectionStrategy>()>::createProperty("Change Detection")
+      .withDescription("Specifies how the processor finds the tailed files which have new data.\n"
+          "Polling: The size of every tailed file is checked on every trigger.\n"
+          "File System Events: The directories of the tailed files are watched, and only the files which changed since the last trigger are checked. "
+          "The events are provided by inotify, so they are only available on Linux and on local file systems; "
+          "the files in directories which cannot be watched are polled.")
+      .isRequired(true)
+      .withDefaultValue(magic_enum::enum_name(utils::file::ChangeDetectionStrategy::Polling))
+      .withAllowedValues(magic_enum::enum_names<utils::file::ChangeDetectionStrategy>())
+      .build();
   EXTENSIONAPI static constexpr auto Properties = std::to_array<core::PropertyReference>({
       FileName,
       StateFile,
@@ -219,7 +236,8 @@ class TailFile : public core::ProcessorImpl {
       InitialStartPosition,
       AttributeProviderService,
       BatchSize,
-      ResultFormat
+      ResultFormat,
+      ChangeDetection
   });
 
 
@@ -282,9 +300,12 @@ class TailFile : public core::ProcessorImpl {
                                 const std::string &baseName, const std::string &extension,
                                 core::FlowFile& flow_file) const;
   static void updateStateAttributes(TailState &state, uint64_t size, uint64_t checksum);
+  static void updateHeadFingerprint(TailState &state);
   bool isOldFileInitiallyRead(const TailState &state) const;
+  std::optional<std::set<std::filesystem::path>> findFilesToCheck();
 
   static constexpr int BUFFER_SIZE = 512;
+  static constexpr uint64_t HEAD_FINGERPRINT_SIZE = 4096;
 
   std::optional<char> delimiter_;  // Delimiter for the data incoming from the tailed file.
   std::map<std::filesystem::path, TailState> tail_states_;
@@ -301,6 +322,8 @@ class TailFile : public core::ProcessorImpl {
   std::unordered_map<std::string, controllers::AttributeProviderService::AttributeMap> extra_attributes_;
   std::optional<uint32_t> batch_size_;
   size_t buffer_size_{};
+  std::unique_ptr<utils::file::FileChangeWatcher> file_change_watcher_;  // only set in File System Events mode
+  std::set<std::filesystem::path> files_to_check_;  // checked on the next trigger even without a file system event
 };
 
 }  // namespace org::apache::nifi::minifi::processors
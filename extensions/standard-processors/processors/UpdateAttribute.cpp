@@ -22,10 +22,13 @@
 
 #include <memory>
 #include <string>
+#include <utility>
+#include <vector>
 
 #include "core/PropertyDefinitionBuilder.h"
 #include "core/Resource.h"
 #include "minifi-cpp/core/ProcessContext.h"
+#include "utils/ProcessorConfigUtils.h"
 
 namespace org::apache::nifi::minifi::processors {
 
@@ -34,14 +37,36 @@ void UpdateAttribute::initialize() {
   setSupportedRelationships(Relationships);
 }
 
+void UpdateAttribute::onSchedule(core::ProcessContext& context, core::ProcessSessionFactory&) {
+  batch_size_ = utils::parseU64Property(context, BatchSize);
+  if (batch_size_ < 1) {
+    throw Exception(PROCESS_SCHEDULE_EXCEPTION, "Batch Size should be positive");
+  }
+}
+
 void UpdateAttribute::onTrigger(core::ProcessContext& context, core::ProcessSession& session) {
-  auto flow_file = session.get();
+  std::vector<std::shared_ptr<core::FlowFile>> flow_files;
+  while (flow_files.size() < batch_size_) {
+    auto flow_file = session.get();
+    if (!flow_file) {
+      break;
+    }
+    flow_files.push_back(std::move(flow_file));
+  }
 
   // Do nothing if there are no incoming files
-  if (!flow_file) {
+  if (flow_files.empty()) {
     return;
   }
 
+  if (flow_files.size() == 1) {
+    updateFlowFile(context, session, flow_files.front());
+  } else {
+    updateBatch(context, session, flow_files);
+  }
+}
+
+void UpdateAttribute::updateFlowFile(core::ProcessContext& context, core::ProcessSession& session, const std::shared_ptr<core::FlowFile>& flow_file) {
   try {
     for (const auto& [dyn_prop_name, dyn_prop_value] : context.getDynamicProperties(flow_file.get())) {
       flow_file->setAttribute(dyn_prop_name, dyn_prop_value);
@@ -55,6 +80,35 @@ void UpdateAttribute::onTrigger(core::ProcessContext& context, core::ProcessSess
   }
 }
 
+void UpdateAttribute::updateBatch(core::ProcessContext& context, core::ProcessSession& session, const std::vector<std::shared_ptr<core::FlowFile>>& flow_files) {
+  // every attribute value is computed for the whole batch before any attribute is set, like for a single flow file
+  std::vector<std::pair<std::string, std::vector<std::string>>> attribute_values;
+  try {
+    for (auto& dyn_prop_name : context.getDynamicPropertyKeys()) {
+      auto values = context.getDynamicPropertyForEach(dyn_prop_name, flow_files);
+      if (!values) {
+        continue;
+      }
+      attribute_values.emplace_back(std::move(dyn_prop_name), std::move(*values));
+    }
+  } catch (const std::exception& e) {
+    logger_->log_warn("Failed to update the attributes of a batch of {} flow files, updating them one by one: {}", flow_files.size(), e.what());
+    for (const auto& flow_file : flow_files) {
+      updateFlowFile(context, session, flow_file);
+    }
+    return;
+  }
+
+  for (size_t i = 0; i < flow_files.size(); ++i) {
+    const auto& flow_file = flow_files[i];
+    for (const auto& [dyn_prop_name, values] : attribute_values) {
+      flow_file->setAttribute(dyn_prop_name, values[i]);
+      logger_->log_debug("Set attribute '{}' of flow file '{}' with value '{}'", dyn_prop_name, flow_file->getUUIDStr(), values[i]);
+    }
+    session.transfer(flow_file, Success);
+  }
+}
+
 REGISTER_RESOURCE(UpdateAttribute, Processor);
 
 }  // namespace org::apache::nifi::minifi::processors
@@ -27,6 +27,8 @@
 #include "core/ProcessorImpl.h"
 #include "core/ProcessSession.h"
 #include "minifi-cpp/core/PropertyDefinition.h"
+#include "core/PropertyDefinitionBuilder.h"
+#include "minifi-cpp/core/PropertyValidator.h"
 #include "minifi-cpp/core/RelationshipDefinition.h"
 #include "core/Core.h"
 #include "core/logging/LoggerFactory.h"
@@ -40,7 +42,15 @@ class UpdateAttribute : public core::ProcessorImpl {
   EXTENSIONAPI static constexpr const char* Description = "This processor updates the attributes of a FlowFile using properties that are added by the user. "
       "This allows you to set default attribute changes that affect every FlowFile going through the processor, equivalent to the \"basic\" usage in Apache NiFi.";
 
-  EXTENSIONAPI static constexpr auto Properties = std::array<core::PropertyReference, 0>{};
+  EXTENSIONAPI static constexpr auto BatchSize = core::PropertyDefinitionBuilder<>::createProperty("Batch Size")
+      .withDescription("The maximum number of FlowFiles to update in each invocation. The attribute values of a batch are computed together, "
+          "which is cheaper than computing them for one FlowFile at a time, when the throughput is high.")
+      .isRequired(true)
+      .withValidator(core::StandardPropertyValidators::UNSIGNED_INTEGER_VALIDATOR)
+      .withDefaultValue("1")
+      .build();
+
+  EXTENSIONAPI static constexpr auto Properties = std::to_array<core::PropertyReference>({BatchSize});
 
   EXTENSIONAPI static constexpr auto Success = core::RelationshipDefinition{"success", "All files are routed to success"};
   EXTENSIONAPI static constexpr auto Failure = core::RelationshipDefinition{"failure", "Failed files are transferred to failure"};
@@ -53,8 +63,15 @@ class UpdateAttribute : public core::ProcessorImpl {
 
   ADD_COMMON_VIRTUAL_FUNCTIONS_FOR_PROCESSORS
 
+  void onSchedule(core::ProcessContext& context, core::ProcessSessionFactory& session_factory) override;
   void onTrigger(core::ProcessContext& context, core::ProcessSession& session) override;
   void initialize() override;
+
+ private:
+  void updateFlowFile(core::ProcessContext& context, core::ProcessSession& session, const std::shared_ptr<core::FlowFile>& flow_file);
+  void updateBatch(core::ProcessContext& context, core::ProcessSession& session, const std::vector<std::shared_ptr<core::FlowFile>>& flow_files);
+
+  uint64_t batch_size_ = 1;
 };
 
 }  // namespace org::apache::nifi::minifi::processors
@@ -15,10 +15,12 @@
  * See the License for the specific language governing permissions and
  * limitations under the License.
  */
+#include <algorithm>
 #include <array>
 #include <memory>
 #include <string>
 #include <unordered_map>
+#include <vector>
 #include "unit/TestBase.h"
 #include "unit/Catch.h"
 #include "core/Core.h"
@@ -70,6 +72,22 @@ class TestHandler : public CivetHandler {
   std::unordered_map<std::string, std::string> headers_;
 };
 
+class ReverseBodyHandler : public CivetHandler {
+ public:
+  bool handlePost(CivetServer*, struct mg_connection* conn) override {
+    std::string body;
+    std::array<char, 1024> buffer{};
+    int read_size = 0;
+    while ((read_size = mg_read(conn, buffer.data(), buffer.size())) > 0) {
+      body.append(buffer.data(), gsl::narrow<size_t>(read_size));
+    }
+    std::ranges::reverse(body);
+    mg_printf(conn, "HTTP/1.1 200 OK\r\nContent-Type: text/plain\r\nContent-Length: %zu\r\n\r\n", body.size());
+    mg_write(conn, body.data(), body.size());
+    return true;
+  }
+};
+
 class TestHTTPServer {
  public:
   TestHTTPServer() : server_(std::make_unique<TestServer>("8681", "/testytesttest", &handler_)) {
@@ -429,4 +447,69 @@ TEST_CASE("InvokeHTTP: invalid characters are removed from outgoing HTTP headers
   CHECK(headers.at(std::string{InvokeHTTP::STATUS_MESSAGE}) == test_attr_value_out);
 }
 
+TEST_CASE("InvokeHTTP performs multiple requests concurrently and routes the responses to their flow files", "[InvokeHTTP]") {
+  using minifi::processors::InvokeHTTP;
+
+  SingleProcessorTestController controller{minifi::test::utils::make_processor<InvokeHTTP>("InvokeHTTP")};
+  auto invoke_http = controller.getProcessor();
+  ReverseBodyHandler handler;
+  TestServer server("8682", "/reverse", &handler);
+
+  REQUIRE(invoke_http->setProperty(InvokeHTTP::Method.name, "POST"));
+  REQUIRE(invoke_http->setProperty(InvokeHTTP::URL.name, "${url}"));
+  REQUIRE(invoke_http->setProperty(InvokeHTTP::MaxInFlightRequests.name, "8"));
+
+  std::vector<std::string> contents;
+  for (size_t i = 0; i < 10; ++i) {
+    contents.push_back("request " + std::to_string(i));
+  }
+  std::vector<InputFlowFileData> input_flow_files;
+  input_flow_files.push_back({.content = "no url", .attributes = {{"index", "none"}}});
+  for (size_t i = 0; i < contents.size(); ++i) {
+    input_flow_files.push_back({.content = contents[i], .attributes = {{"url", "http://localhost:8682/reverse"}, {"index", std::to_string(i)}}});
+  }
+
+  const auto result = controller.trigger(std::move(input_flow_files));
+  CHECK(result.at(InvokeHTTP::RelNoRetry).empty());
+  CHECK(result.at(InvokeHTTP::RelRetry).empty());
+  // the trigger takes at most Max In-Flight Requests flow files, the one without a URL is routed to failure
+  REQUIRE(result.at(InvokeHTTP::RelFailure).size() == 1);
+  CHECK(controller.plan->getContent(result.at(InvokeHTTP::RelFailure)[0]) == "no url");
+  REQUIRE(result.at(InvokeHTTP::Success).size() == 7);
+  REQUIRE(result.at(InvokeHTTP::RelResponse).size() == 7);
+
+  for (const auto& response : result.at(InvokeHTTP::RelResponse)) {
+    const auto index = response->getAttribute("index");
+    REQUIRE(index);
+    std::string expected_content = "request " + *index;
+    std::ranges::reverse(expected_content);
+    CHECK(controller.plan->getContent(response) == expected_content);
+  }
+  for (const auto& request : result.at(InvokeHTTP::Success)) {
+    CHECK(controller.plan->getContent(request) == "request " + *request->getAttribute("index"));
+    CHECK(request->getAttribute(std::string{InvokeHTTP::STATUS_CODE}) == "200");
+  }
+}
+
+TEST_CASE("InvokeHTTP reuses connections between triggers with multiple requests in flight", "[InvokeHTTP]") {
+  using minifi::processors::InvokeHTTP;
+
+  SingleProcessorTestController controller{minifi::test::utils::make_processor<InvokeHTTP>("InvokeHTTP")};
+  auto invoke_http = controller.getProcessor();
+  minifi::test::ConnectionCountingServer connection_counting_server;
+
+  REQUIRE(invoke_http->setProperty(InvokeHTTP::Method.name, "GET"));
+  REQUIRE(invoke_http->setProperty(InvokeHTTP::URL.name, "http://localhost:" + connection_counting_server.getPort() + "/method"));
+  REQUIRE(invoke_http->setProperty(InvokeHTTP::MaxInFlightRequests.name, "2"));
+
+  for (auto i = 0; i < 4; ++i) {
+    const auto result = controller.trigger(InputFlowFileData{"data"});
+    CHECK(result.at(InvokeHTTP::RelFailure).empty());
+    CHECK(result.at(InvokeHTTP::Success).size() == 1);
+    CHECK(result.at(InvokeHTTP::RelResponse).size() == 1);
+  }
+
+  CHECK(1 == connection_counting_server.getConnectionCounter());
+}
+
 }  // namespace org::apache::nifi::minifi::test
@@ -0,0 +1,216 @@
+/**
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The ASF licenses this file to You under the Apache License, Version 2.0
+ * (the "License"); you may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <string>
+#include <unordered_map>
+
+#include "catch2/catch_approx.hpp"
+#include "catch2/generators/catch_generators.hpp"
+#include "controllers/CSVReader.h"
+#include "controllers/CSVRecordSetWriter.h"
+#include "io/BufferStream.h"
+#include "unit/Catch.h"
+#include "unit/TestBase.h"
+#include "unit/ControllerServiceUtils.h"
+#include "utils/TimeUtil.h"
+
+namespace org::apache::nifi::minifi::standard::test {
+
+namespace {
+std::unique_ptr<core::controller::ControllerService> createCsvReader(const std::unordered_map<std::string_view, std::string_view>& properties = {}) {
+  auto csv_reader = minifi::test::utils::make_controller_service<CSVReader>("CSVReader");
+  csv_reader->initialize();
+  for (const auto& [key, value] : properties) {
+    REQUIRE(csv_reader->setProperty(key, std::string{value}));
+  }
+  csv_reader->onEnable();
+  return csv_reader;
+}
+
+std::string writeRecords(const core::RecordSet& record_set, const std::unordered_map<std::string_view, std::string_view>& properties = {}) {
+  auto csv_writer = minifi::test::utils::make_controller_service<CSVRecordSetWriter>("CSVRecordSetWriter");
+  csv_writer->initialize();
+  for (const auto& [key, value] : properties) {
+    REQUIRE(csv_writer->setProperty(key, std::string{value}));
+  }
+  csv_writer->onEnable();
+  io::BufferStream buffer_stream;
+  const auto record_writer = csv_writer->getImplementation<CSVRecordSetWriter>()->createRecordWriter(buffer_stream);
+  for (const auto& record : record_set) {
+    REQUIRE(record_writer->write(record));
+  }
+  REQUIRE(record_writer->finish());
+  const auto buffer = buffer_stream.getBuffer();
+  return {reinterpret_cast<const char*>(buffer.data()), buffer.size()};
+}
+
+core::RecordSet readRecords(core::controller::ControllerService& csv_reader, const std::string& input) {
+  io::BufferStream buffer_stream;
+  buffer_stream.write(as_bytes(std::span(input)));
+  auto record_set = csv_reader.getImplementation<CSVReader>()->read(buffer_stream);
+  REQUIRE(record_set);
+  return std::move(*record_set);
+}
+}  // namespace
+
+TEST_CASE("CSVReader infers the types of the unquoted values", "[CSVReader]") {
+  const auto csv_reader = createCsvReader({{CSVReader::TreatFirstLineAsHeader.name, "true"}});
+  const auto record_set = readRecords(*csv_reader, "id,name,temperature,active,measured,serial\n"
+      "-1,sensor 1,21.5,true,2023-03-16T12:32:45Z,\"0042\"\n"
+      "18446744073709551615,sensor 2,1e3,false,yesterday,43\n");
+  REQUIRE(record_set.size() == 2);
+
+  const auto& first = record_set.at(0);
+  CHECK(std::get<int64_t>(first.at("id").value_) == -1);
+  CHECK(std::get<std::string>(first.at("name").value_) == "sensor 1");
+  CHECK(std::get<double>(first.at("temperature").value_) == Catch::Approx(21.5));
+  CHECK(std::get<bool>(first.at("active").value_) == true);
+  CHECK(std::get<std::chrono::system_clock::time_point>(first.at("measured").value_) == *utils::timeutils::parseRfc3339("2023-03-16T12:32:45Z"));
+  CHECK(std::get<std::string>(first.at("serial").value_) == "0042");
+
+  const auto& second = record_set.at(1);
+  CHECK(std::get<uint64_t>(second.at("id").value_) == 18446744073709551615U);
+  CHECK(std::get<double>(second.at("temperature").value_) == Catch::Approx(1000.0));
+  CHECK(std::get<bool>(second.at("active").value_) == false);
+  CHECK(std::get<std::string>(second.at("measured").value_) == "yesterday");
+  CHECK(std::get<int64_t>(second.at("serial").value_) == 43);
+}
+
+TEST_CASE("CSVReader handles quoting, escaping and line breaks", "[CSVReader]") {
+  const auto csv_reader = createCsvReader();
+  const auto record_set = readRecords(*csv_reader, "\"Smith, John\" , \"say \"\"hi\"\"\",a\\,b\r\n"
+      "\n"
+      "\"multi\nline\",,  x  ");
+  REQUIRE(record_set.size() == 2);
+
+  const auto& first = record_set.at(0);
+  CHECK(std::get<std::string>(first.at("column_0").value_) == "Smith, John");
+  CHECK(std::get<std::string>(first.at("column_1").value_) == "say \"hi\"");
+  CHECK(std::get<std::string>(first.at("column_2").value_) == "a,b");
+
+  const auto& second = record_set.at(1);
+  CHECK(std::get<std::string>(second.at("column_0").value_) == "multi\nline");
+  CHECK_THROWS(second.at("column_1"));
+  CHECK(std::get<std::string>(second.at("column_2").value_) == "x");
+}
+
+TEST_CASE("CSVReader only treats a quote character at the start of a value as an opening quote", "[CSVReader]") {
+  const auto csv_reader = createCsvReader();
+  const auto record_set = readRecords(*csv_reader, "5\" screen,x\n"
+      "a\\,\"b,  \"c\nd\"\n"
+      "3,4\n");
+  REQUIRE(record_set.size() == 3);
+
+  CHECK(std::get<std::string>(record_set.at(0).at("column_0").value_) == "5\" screen");
+  CHECK(std::get<std::string>(record_set.at(0).at("column_1").value_) == "x");
+  CHECK(std::get<std::string>(record_set.at(1).at("column_0").value_) == "a,\"b");
+  CHECK(std::get<std::string>(record_set.at(1).at("column_1").value_) == "c\nd");
+  CHECK(std::get<int64_t>(record_set.at(2).at("column_1").value_) == 4);
+}
+
+TEST_CASE("CSVReader can use other separator, quote and escape characters", "[CSVReader]") {
+  const auto csv_reader = createCsvReader({
+      {CSVReader::ValueSeparator.name, "\\t"},
+      {CSVReader::QuoteCharacter.name, "'"},
+      {CSVReader::EscapeCharacter.name, "#"},
+      {CSVReader::TrimFields.name, "false"},
+      {CSVReader::TreatFirstLineAsHeader.name, "true"}});
+  const auto record_set = readRecords(*csv_reader, "a\tb\tc\n'x\ty'\t #1\t1,5\n");
+  REQUIRE(record_set.size() == 1);
+  const auto& record = record_set.at(0);
+  CHECK(std::get<std::string>(record.at("a").value_) == "x\ty");
+  CHECK(std::get<std::string>(record.at("b").value_) == " 1");
+  CHECK(std::get<std::string>(record.at("c").value_) == "1,5");
+}
+
+TEST_CASE("CSVReader returns an error for malformed quoting after the complete records", "[CSVReader]") {
+  const auto csv_reader = createCsvReader();
+  const std::string input = GENERATE("1,2\n\"3\"4\n", "1,2\n\"3,4\n");
+  io::BufferStream buffer_stream;
+  buffer_stream.write(as_bytes(std::span(input)));
+
+  const auto record_reader = csv_reader->getImplementation<CSVReader>()->createRecordReader(buffer_stream);
+  const auto first_record = record_reader->next();
+  REQUIRE(first_record);
+  REQUIRE(*first_record);
+  CHECK(std::get<int64_t>((*first_record)->at("column_1").value_) == 2);
+  CHECK_FALSE(record_reader->next());
+}
+
+TEST_CASE("CSVReader rejects invalid configuration", "[CSVReader]") {
+  auto csv_reader = minifi::test::utils::make_controller_service<CSVReader>("CSVReader");
+  csv_reader->initialize();
+  const auto [property, value] = GENERATE(
+      std::make_pair(CSVReader::ValueSeparator.name, "::"),
+      std::make_pair(CSVReader::QuoteCharacter.name, ","),
+      std::make_pair(CSVReader::EscapeCharacter.name, ","));
+  REQUIRE(csv_reader->setProperty(property, std::string{value}));
+  REQUIRE_THROWS(csv_reader->onEnable());
+}
+
+TEST_CASE("CSVRecordSetWriter writes the fields of the first record as columns", "[CSVRecordSetWriter]") {
+  core::RecordSet record_set;
+  core::Record first;
+  first.emplace("name", core::RecordField(std::string{"Smith, John"}));
+  first.emplace("id", core::RecordField(int64_t{1}));
+  first.emplace("temperature", core::RecordField(21.5));
+  record_set.push_back(std::move(first));
+  core::Record second;
+  second.emplace("name", core::RecordField(std::string{"say \"hi\""}));
+  second.emplace("id", core::RecordField(int64_t{2}));
+  second.emplace("extra", core::RecordField(true));
+  record_set.push_back(std::move(second));
+
+  CHECK(writeRecords(record_set) == "id,name,temperature\n1,\"Smith, John\",21.5\n2,\"say \"\"hi\"\"\",\n");
+  CHECK(writeRecords(record_set, {{CSVRecordSetWriter::IncludeHeaderLine.name, "false"}, {CSVRecordSetWriter::ValueSeparator.name, ";"}})
+      == "1;Smith, John;21.5\n2;\"say \"\"hi\"\"\";\n");
+  CHECK(writeRecords(record_set, {{CSVRecordSetWriter::QuoteMode.name, "Quote Non-Numeric Values"}, {CSVRecordSetWriter::RecordSeparator.name, "\\r\\n"}})
+      == "\"id\",\"name\",\"temperature\"\r\n1,\"Smith, John\",21.5\r\n2,\"say \"\"hi\"\"\",\r\n");
+  CHECK(writeRecords(record_set, {{CSVRecordSetWriter::QuoteMode.name, "Quote All Values"}})
+      == "\"id\",\"name\",\"temperature\"\n\"1\",\"Smith, John\",\"21.5\"\n\"2\",\"say \"\"hi\"\"\",\n");
+  CHECK(writeRecords({}).empty());
+}
+
+TEST_CASE("CSVRecordSetWriter writes arrays and nested records as JSON", "[CSVRecordSetWriter]") {
+  core::RecordSet record_set;
+  core::Record record;
+  core::RecordObject nested;
+  nested.emplace("k", core::RecordField(int64_t{1}));
+  record.emplace("object", core::RecordField(std::move(nested)));
+  core::RecordArray array;
+  array.emplace_back(std::string{"x"});
+  record.emplace("array", core::RecordField(std::move(array)));
+  record.emplace("when", core::RecordField(std::chrono::system_clock::time_point(*utils::timeutils::parseDateTimeStr("2023-03-16T12:32:45Z"))));
+  record_set.push_back(std::move(record));
+
+  CHECK(writeRecords(record_set) == "array,object,when\n\"[\"\"x\"\"]\",\"{\"\"k\"\":1}\",2023-03-16T12:32:45Z\n");
+}
+
+TEST_CASE("CSV records survive a round trip through the writer and the reader", "[CSVRecordSetWriter]") {
+  core::RecordSet record_set;
+  for (int64_t i = 0; i < 100; ++i) {
+    core::Record record;
+    record.emplace("id", core::RecordField(i));
+    record.emplace("text", core::RecordField(fmt::format("line {},\n\"{}\"", i, i * i)));
+    record.emplace("value", core::RecordField(0.25 * static_cast<double>(i) + 0.1));
+    record_set.push_back(std::move(record));
+  }
+  const auto csv_reader = createCsvReader({{CSVReader::TreatFirstLineAsHeader.name, "true"}});
+  CHECK(readRecords(*csv_reader, writeRecords(record_set)) == record_set);
+}
+
+}  // namespace org::apache::nifi::minifi::standard::test
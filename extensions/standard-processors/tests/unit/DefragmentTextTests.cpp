@@ -109,6 +109,20 @@ TEST_CASE("DefragmentText Single source tests", "[defragmenttextsinglesource]")
     CHECK(read_from_success_relationship.get().readFlowFileWithContent("<3> dragon fruit<4> elderberry<5> fig"));
   }
 
+  SECTION("Multiline matching a pattern without regex metacharacters") {
+    plan->setProperty(defrag_text_flow_files, DefragmentText::Pattern, "--");
+    plan->setProperty(defrag_text_flow_files, DefragmentText::PatternLoc, magic_enum::enum_name(defragment_text::PatternLocation::END_OF_MESSAGE));
+
+    write_to_flow_file.get().setContent("apple--banana---cherry");
+    testController.runSession(plan);
+    CHECK(read_from_success_relationship.get().readFlowFileWithContent("apple--banana--"));
+
+    write_to_flow_file.get().setContent(" dragon-- fruit");
+    plan->reset();
+    testController.runSession(plan);
+    CHECK(read_from_success_relationship.get().readFlowFileWithContent("-cherry dragon--"));
+  }
+
   SECTION("Multiline matching end of messages") {
     plan->setProperty(defrag_text_flow_files, DefragmentText::Pattern, "<[0-9]+>");
     plan->setProperty(defrag_text_flow_files, DefragmentText::PatternLoc, magic_enum::enum_name(defragment_text::PatternLocation::END_OF_MESSAGE));
@@ -18,6 +18,7 @@
 #include "unit/Catch.h"
 #include "unit/SingleProcessorTestController.h"
 #include "processors/EvaluateJsonPath.h"
+#include "utils/JsonPathUtils.h"
 #include "unit/TestUtils.h"
 #include "unit/ProcessorUtils.h"
 
@@ -322,4 +323,70 @@ TEST_CASE_METHOD(EvaluateJsonPathTestFixture, "Query result is null value in flo
   CHECK(result_flow_file->getAttribute("email").value() == expected_null_value);
 }
 
+TEST_CASE("Only member names and array indices are parsed as simple JSON paths", "[EvaluateJsonPathTests]") {
+  using minifi::utils::json_path::parseSimplePath;
+  using minifi::utils::json_path::PathStep;
+  CHECK(parseSimplePath("$") == std::vector<PathStep>{});
+  CHECK(parseSimplePath("$.header.id") == std::vector<PathStep>{std::string{"header"}, std::string{"id"}});
+  CHECK(parseSimplePath("$['header'][\"first name\"][2]") == std::vector<PathStep>{std::string{"header"}, std::string{"first name"}, size_t{2}});
+  CHECK_FALSE(parseSimplePath("header.id"));
+  CHECK_FALSE(parseSimplePath("$.users[*].id"));
+  CHECK_FALSE(parseSimplePath("$..id"));
+  CHECK_FALSE(parseSimplePath("$.users[-1]"));
+  CHECK_FALSE(parseSimplePath("$.users[0:2]"));
+  CHECK_FALSE(parseSimplePath("$.users[?(@.id > 1)]"));
+  CHECK_FALSE(parseSimplePath("$.users.length"));
+  CHECK_FALSE(parseSimplePath("$.users.0"));
+}
+
+TEST_CASE_METHOD(EvaluateJsonPathTestFixture, "Simple JSON paths give the same results when they are evaluated while parsing", "[EvaluateJsonPathTests]") {
+  REQUIRE(controller_.plan->setProperty(evaluate_json_path_processor_, processors::EvaluateJsonPath::Destination, "flowfile-attribute"));
+  REQUIRE(controller_.plan->setProperty(evaluate_json_path_processor_, processors::EvaluateJsonPath::ReturnType, "json"));
+  REQUIRE(controller_.plan->setDynamicProperty(evaluate_json_path_processor_, "id", "$.header.id"));
+  REQUIRE(controller_.plan->setDynamicProperty(evaluate_json_path_processor_, "header", "$['header']"));
+  REQUIRE(controller_.plan->setDynamicProperty(evaluate_json_path_processor_, "second_tag", "$.header.tags[1]"));
+  REQUIRE(controller_.plan->setDynamicProperty(evaluate_json_path_processor_, "last_amount", "$.items[2].amount"));
+  REQUIRE(controller_.plan->setDynamicProperty(evaluate_json_path_processor_, "missing", "$.header.missing"));
+  REQUIRE(controller_.plan->setDynamicProperty(evaluate_json_path_processor_, "missing_index", "$.items[5]"));
+  REQUIRE(controller_.plan->setDynamicProperty(evaluate_json_path_processor_, "scalar_child", "$.header.id.value"));
+
+  // a path with a wildcard makes every path evaluated on the whole document
+  const bool with_complex_path = GENERATE(false, true);
+  if (with_complex_path) {
+    REQUIRE(controller_.plan->setDynamicProperty(evaluate_json_path_processor_, "all_amounts", "$.items[*].amount"));
+  }
+
+  std::string json_content = R"({"items": [{"amount": 1}, {"amount": 2.5}, {"amount": -3, "note": "x"}], "header": {"id": "abc", "tags": ["a", "b"], "nested": {"x": null}}})";
+  auto result = controller_.trigger({{.content = json_content}});
+
+  REQUIRE(result.at(processors::EvaluateJsonPath::Matched).size() == 1);
+  const auto result_flow_file = result.at(processors::EvaluateJsonPath::Matched).at(0);
+  CHECK(result_flow_file->getAttribute("id").value() == "abc");
+  CHECK(result_flow_file->getAttribute("header").value() == R"({"id":"abc","nested":{"x":null},"tags":["a","b"]})");
+  CHECK(result_flow_file->getAttribute("second_tag").value() == "b");
+  CHECK(result_flow_file->getAttribute("last_amount").value() == "-3");
+  CHECK(result_flow_file->getAttribute("missing").value().empty());
+  CHECK(result_flow_file->getAttribute("missing_index").value().empty());
+  CHECK(result_flow_file->getAttribute("scalar_child").value().empty());
+  if (with_complex_path) {
+    CHECK(result_flow_file->getAttribute("all_amounts").value() == "[1,2.5,-3]");
+  }
+}
+
+TEST_CASE_METHOD(EvaluateJsonPathTestFixture, "Parsing stops when the results of the simple JSON paths are known", "[EvaluateJsonPathTests]") {
+  REQUIRE(controller_.plan->setProperty(evaluate_json_path_processor_, processors::EvaluateJsonPath::Destination, "flowfile-attribute"));
+  REQUIRE(controller_.plan->setDynamicProperty(evaluate_json_path_processor_, "id", "$.header.id"));
+  REQUIRE(controller_.plan->setDynamicProperty(evaluate_json_path_processor_, "type", "$.header.type"));
+
+  // the body is never reached, so it is not validated either
+  std::string json_content = R"({"header": {"id": 42, "source": "sensor"}, "body": [1, 2, )";
+  auto result = controller_.trigger({{.content = json_content}});
+
+  REQUIRE(result.at(processors::EvaluateJsonPath::Matched).size() == 1);
+  REQUIRE(result.at(processors::EvaluateJsonPath::Failure).empty());
+  const auto result_flow_file = result.at(processors::EvaluateJsonPath::Matched).at(0);
+  CHECK(result_flow_file->getAttribute("id").value() == "42");
+  CHECK(result_flow_file->getAttribute("type").value().empty());
+}
+
 }  // namespace org::apache::nifi::minifi::test
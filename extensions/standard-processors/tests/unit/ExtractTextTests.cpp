@@ -140,6 +140,7 @@ TEST_CASE("Test usage of ExtractText in regex mode", "[extracttextRegexTest]") {
   auto maprocessor = plan->addProcessor("ExtractText", "testExtractText", core::Relationship("success", "description"), true);
   plan->setProperty(maprocessor, org::apache::nifi::minifi::processors::ExtractText::RegexMode, "true");
   plan->setProperty(maprocessor, org::apache::nifi::minifi::processors::ExtractText::EnableRepeatingCaptureGroup, "true");
+  plan->setProperty(maprocessor, org::apache::nifi::minifi::processors::ExtractText::RegularExpressionEngine, GENERATE("Standard", "Linear"));
   plan->setDynamicProperty(maprocessor, "RegexAttr", "Speed limit ([0-9]+)");
   plan->setDynamicProperty(maprocessor, "InvalidRegex", "[Invalid)A(F)");
 
@@ -16,6 +16,7 @@
  * limitations under the License.
  */
 #include <utility>
+#include <set>
 #include <string>
 #include <filesystem>
 #include <chrono>
@@ -315,3 +316,32 @@ TEST_CASE("GetFile can use expression language in Directory property") {
   CHECK(flow_file->getAttribute(minifi::core::SpecialFlowAttribute::ABSOLUTE_PATH) == (dir / "").string());
   CHECK(flow_file->getAttribute(minifi::core::SpecialFlowAttribute::FILENAME) == "testfile.txt");
 }
+
+TEST_CASE("GetFile lists a directory tree on multiple threads", "[getFileProperty]") {
+  using minifi::processors::GetFile;
+
+  minifi::test::SingleProcessorTestController test_controller(minifi::test::utils::make_processor<GetFile>("GetFile"));
+  const auto get_file = test_controller.getProcessor();
+  std::filesystem::path dir = test_controller.createTempDirectory();
+  REQUIRE(get_file->setProperty(GetFile::Directory.name, dir.string()));
+  REQUIRE(get_file->setProperty(GetFile::BatchSize.name, "0"));
+  REQUIRE(get_file->setProperty(GetFile::ListingThreadCount.name, "4"));
+
+  std::set<std::string> expected_contents;
+  for (int i = 0; i < 10; ++i) {
+    const auto subdirectory = dir / std::to_string(i) / "nested";
+    std::filesystem::create_directories(subdirectory);
+    for (int j = 0; j < 5; ++j) {
+      const auto content = std::to_string(i) + "/" + std::to_string(j);
+      minifi::test::utils::putFileToDir(subdirectory, std::to_string(j) + ".txt", content);
+      expected_contents.insert(content);
+    }
+  }
+
+  auto result = test_controller.trigger();
+  std::set<std::string> contents;
+  for (const auto& flow_file : result.at(GetFile::Success)) {
+    contents.insert(test_controller.plan->getContent(flow_file));
+  }
+  CHECK(contents == expected_contents);
+}
@@ -15,11 +15,14 @@
  * See the License for the specific language governing permissions and
  * limitations under the License.
  */
+#include <algorithm>
 #include <array>
 #include <memory>
+#include <span>
 #include <utility>
 #include <string>
 #include <iostream>
+#include <vector>
 
 #include "unit/TestBase.h"
 #include "unit/Catch.h"
@@ -29,6 +32,7 @@
 
 #include "core/Processor.h"
 #include "core/ProcessSession.h"
+#include "io/BufferStream.h"
 
 #include "GetFile.h"
 #include "HashContent.h"
@@ -44,6 +48,8 @@ const char* SHA256_ATTR = "SHA256Attr";
 const char* MD5_CHECKSUM = "4FE8A693C64F93F65C5FAF42DC49AB23";
 const char* SHA1_CHECKSUM = "03840DEB949D6CF0C0A624FA7EBA87FBDBCB7783";
 const char* SHA256_CHECKSUM = "66D5B2CC06203137F8A0E9714638DC1085C57A3F1FA26C8823AE5CF89AB26488";
+const char* XXH3_CHECKSUM = "7011F4A264D09253";
+const char* BLAKE3_CHECKSUM = "0A345F55EF7884EA31BD5D7F542B154A1613D8FA26FC651B492EA0EDBA699109";
 
 namespace org::apache::nifi::minifi::processors::test {
 
@@ -169,7 +175,58 @@ TEST_CASE("Invalid hash algorithm throws in onSchedule", "[HashContent]") {
   minifi::test::SingleProcessorTestController controller{minifi::test::utils::make_processor<HashContent>("HashContent")};
   auto hash_content = controller.getProcessor();
   REQUIRE(hash_content->setProperty(HashContent::HashAlgorithm.name, "My-Algo"));
-  REQUIRE_THROWS_WITH(controller.plan->scheduleProcessor(hash_content), "Process Schedule Operation: MYALGO is not supported, supported algorithms are: MD5, SHA1, SHA256");
+  REQUIRE_THROWS_WITH(controller.plan->scheduleProcessor(hash_content), "Process Schedule Operation: MYALGO is not supported, supported algorithms are: BLAKE3, MD5, SHA1, SHA256, XXH3");
+}
+
+TEST_CASE("HashContent computes the checksums of several algorithms in one pass", "[HashContent]") {
+  minifi::test::SingleProcessorTestController controller{minifi::test::utils::make_processor<HashContent>("HashContent")};
+  auto hash_content = controller.getProcessor();
+  REQUIRE(hash_content->setProperty(HashContent::HashAttribute.name, "hash"));
+
+  SECTION("A single algorithm is stored in the Hash Attribute") {
+    REQUIRE(hash_content->setProperty(HashContent::HashAlgorithm.name, "xxh3"));
+    const auto result = controller.trigger("Test text\n");
+    const auto flow_files = result.at(HashContent::Success);
+    REQUIRE(flow_files.size() == 1);
+    CHECK(flow_files[0]->getAttribute("hash") == XXH3_CHECKSUM);
+  }
+  SECTION("Each algorithm of a list gets its own attribute") {
+    REQUIRE(hash_content->setProperty(HashContent::HashAlgorithm.name, "MD5, sha-256,BLAKE3, XXH3, md5"));
+    const auto result = controller.trigger("Test text\n");
+    const auto flow_files = result.at(HashContent::Success);
+    REQUIRE(flow_files.size() == 1);
+    CHECK(flow_files[0]->getAttribute("hash.MD5") == MD5_CHECKSUM);
+    CHECK(flow_files[0]->getAttribute("hash.SHA256") == SHA256_CHECKSUM);
+    CHECK(flow_files[0]->getAttribute("hash.BLAKE3") == BLAKE3_CHECKSUM);
+    CHECK(flow_files[0]->getAttribute("hash.XXH3") == XXH3_CHECKSUM);
+    CHECK_FALSE(flow_files[0]->getAttribute("hash"));
+  }
+}
+
+TEST_CASE("The checksums of a content larger than the read buffer", "[HashContent]") {
+  std::string content;
+  for (size_t i = 0; content.size() < 1024 * 1024; ++i) {
+    content += std::to_string(i) + "\n";
+  }
+  std::vector<std::unique_ptr<hash_content::Digest>> digests;
+  digests.push_back(hash_content::createDigest("SHA256"));
+  digests.push_back(hash_content::createDigest("XXH3"));
+  std::vector<std::unique_ptr<hash_content::Digest>> reference_digests;
+  reference_digests.push_back(hash_content::createDigest("SHA256"));
+  reference_digests.push_back(hash_content::createDigest("XXH3"));
+
+  io::BufferStream stream(content);
+  REQUIRE(hash_content::updateDigests(stream, digests) == content.size());
+  // updating the digests in small pieces gives the same checksum as in one pass
+  for (size_t offset = 0; offset < content.size(); offset += 1000) {
+    const auto piece = std::as_bytes(std::span(content)).subspan(offset, std::min<size_t>(1000, content.size() - offset));
+    for (const auto& digest : reference_digests) {
+      digest->update(piece);
+    }
+  }
+  for (size_t i = 0; i < digests.size(); ++i) {
+    CHECK(digests[i]->finalize() == reference_digests[i]->finalize());
+  }
 }
 
 }  // namespace org::apache::nifi::minifi::processors::test
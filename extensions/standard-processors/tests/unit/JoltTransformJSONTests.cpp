@@ -16,6 +16,7 @@
  * limitations under the License.
  */
 
+#include "catch2/generators/catch_generators.hpp"
 #include "unit/TestBase.h"
 #include "unit/Catch.h"
 #include "unit/TestUtils.h"
@@ -270,6 +271,56 @@ TEST_CASE("Shiftr multiple patterns") {
   )json", true);
 }
 
+TEST_CASE("Shiftr transforms consecutive flow files of different sizes") {
+  SingleProcessorTestController controller{minifi::test::utils::make_processor<minifi::processors::JoltTransformJSON>("JoltProc")};
+  auto proc = controller.getProcessor();
+  controller.plan->setProperty(proc, processors::JoltTransformJSON::JoltTransform, magic_enum::enum_name(processors::jolt_transform_json::JoltTransform::Shift));
+  controller.plan->setProperty(proc, processors::JoltTransformJSON::JoltSpecification, R"json(
+    {
+      "items": {
+        "*": {
+          "id": "ids[]",
+          "name": "names.&(1,0)"
+        }
+      }
+    }
+  )json");
+
+  // the documents of the large flow file do not fit into the initial allocator buffer of the processor
+  for (const size_t item_count : {size_t{1}, size_t{5000}, size_t{2}}) {
+    std::string input = R"({"items": [)";
+    std::string expected_ids;
+    std::string expected_names;
+    for (size_t i = 0; i < item_count; ++i) {
+      const std::string separator = i == 0 ? "" : ",";
+      input += fmt::format(R"({}{{"id": {}, "name": "item {}"}})", separator, i, i);
+      expected_ids += fmt::format("{}{}", separator, i);
+      expected_names += fmt::format(R"({}"{}": "item {}")", separator, i, i);
+    }
+    input += "]}";
+    const auto expected = fmt::format(R"({{"ids": [{}], "names": {{{}}}}})", expected_ids, expected_names);
+
+    auto res = controller.trigger(input);
+
+    CHECK(res[processors::JoltTransformJSON::Failure].size() == 0);
+    REQUIRE(res[processors::JoltTransformJSON::Success].size() == 1);
+    utils::verifyJSON(controller.plan->getContent(res.at(processors::JoltTransformJSON::Success).at(0)), expected, true);
+  }
+}
+
+TEST_CASE("Shiftr routes invalid json to failure") {
+  SingleProcessorTestController controller{minifi::test::utils::make_processor<minifi::processors::JoltTransformJSON>("JoltProc")};
+  auto proc = controller.getProcessor();
+  controller.plan->setProperty(proc, processors::JoltTransformJSON::JoltTransform, magic_enum::enum_name(processors::jolt_transform_json::JoltTransform::Shift));
+  controller.plan->setProperty(proc, processors::JoltTransformJSON::JoltSpecification, R"json({"a": "b"})json");
+
+  const auto input = GENERATE(as<std::string>{}, "", "{\"a\": ", "{\"a\": 1} {}");
+  auto res = controller.trigger(input);
+
+  CHECK(res[processors::JoltTransformJSON::Failure].size() == 1);
+  CHECK(res[processors::JoltTransformJSON::Success].size() == 0);
+}
+
 static std::string to_string(const rapidjson::Value& val) {
   rapidjson::StringBuffer buf;
   rapidjson::Writer<rapidjson::StringBuffer> writer(buf);
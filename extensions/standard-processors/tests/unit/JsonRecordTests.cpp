@@ -21,6 +21,7 @@
 #include "catch2/generators/catch_generators.hpp"
 #include "controllers/JsonRecordSetWriter.h"
 #include "controllers/JsonTreeReader.h"
+#include "io/BufferStream.h"
 #include "minifi-cpp/core/Record.h"
 #include "unit/Catch.h"
 #include "unit/RecordSetTesters.h"
@@ -116,4 +117,37 @@ TEST_CASE("JsonTreeReader tests") {
   CHECK(core::test::testRecordReader(*json_record_set_reader->getImplementation<JsonTreeReader>(), input_str, expected_record_set));
 }
 
+TEST_CASE("JsonTreeReader reads the records one at a time") {
+  auto json_record_set_reader = minifi::test::utils::make_controller_service<JsonTreeReader>("json_record_set_reader");
+  const auto input_str = GENERATE(record_per_line_str, array_compressed_str, array_pretty_str);
+  io::BufferStream buffer_stream;
+  buffer_stream.write(as_bytes(std::span(input_str)));
+
+  const auto record_reader = json_record_set_reader->getImplementation<JsonTreeReader>()->createRecordReader(buffer_stream);
+  const auto first_batch = record_reader->nextBatch(1);
+  REQUIRE(first_batch);
+  REQUIRE(first_batch->size() == 1);
+  CHECK(first_batch->front() == core::test::createSampleRecord(true));
+  const auto second_record = record_reader->next();
+  REQUIRE(second_record);
+  REQUIRE(*second_record);
+  CHECK(**second_record == core::test::createSampleRecord2(true));
+  const auto last_batch = record_reader->nextBatch(10);
+  REQUIRE(last_batch);
+  CHECK(last_batch->empty());
+}
+
+TEST_CASE("JsonTreeReader keeps the records before the first invalid one") {
+  auto json_record_set_reader = minifi::test::utils::make_controller_service<JsonTreeReader>("json_record_set_reader");
+  const std::string input_str = GENERATE(R"([{"a": 1}, {"b": 2}, {"c": )", "{\"a\": 1}\n{\"b\": 2}\n\"c\"\n{\"d\": 4}\n");
+  io::BufferStream buffer_stream;
+  buffer_stream.write(as_bytes(std::span(input_str)));
+
+  const auto record_set = json_record_set_reader->getImplementation<JsonTreeReader>()->read(buffer_stream);
+  REQUIRE(record_set);
+  REQUIRE(record_set->size() == 2);
+  CHECK(std::get<int64_t>(record_set->at(0).at("a").value_) == 1);
+  CHECK(std::get<int64_t>(record_set->at(1).at("b").value_) == 2);
+}
+
 }  // namespace org::apache::nifi::minifi::standard::test
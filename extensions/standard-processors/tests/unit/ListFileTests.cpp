@@ -16,7 +16,9 @@
  * limitations under the License.
  */
 #include <memory>
+#include <set>
 #include <string>
+#include <thread>
 
 #include "unit/TestBase.h"
 #include "unit/SingleProcessorTestController.h"
@@ -274,4 +276,41 @@ TEST_CASE("If a second file with the same modification time shows up later, then
   const auto result_two = test_controller.trigger();
   CHECK(result_two.at(ListFile::Success).size() == 1);
 }
+TEST_CASE("ListFile only lists the new files if the Change Detection is File System Events") {
+  using minifi::processors::ListFile;
+
+  minifi::test::SingleProcessorTestController test_controller(minifi::test::utils::make_processor<ListFile>("ListFile"));
+  const auto list_file = test_controller.getProcessor();
+
+  const auto input_dir = test_controller.createTempDirectory();
+  REQUIRE(list_file->setProperty(ListFile::InputDirectory.name, input_dir.string()));
+  REQUIRE(list_file->setProperty(ListFile::ChangeDetection.name, "File System Events"));
+  REQUIRE(list_file->setProperty(ListFile::ListingThreadCount.name, "2"));
+  REQUIRE(list_file->setProperty(ListFile::MinimumFileAge.name, "1 sec"));
+
+  const auto get_file_names = [&](const minifi::test::ProcessorTriggerResult& result) {
+    std::set<std::string> file_names;
+    for (const auto& flow_file : result.at(ListFile::Success)) {
+      file_names.insert(flow_file->getAttribute(core::SpecialFlowAttribute::FILENAME).value_or(""));
+    }
+    return file_names;
+  };
+
+  const auto old_file = minifi::test::utils::putFileToDir(input_dir, "old_file.txt", "old");
+  std::filesystem::last_write_time(old_file, std::chrono::file_clock::now() - 1h);
+  CHECK(get_file_names(test_controller.trigger()) == std::set<std::string>{"old_file.txt"});
+
+  const auto new_subdirectory = input_dir / "new_subdirectory";
+  std::filesystem::create_directories(new_subdirectory);
+  const auto file_in_new_subdirectory = minifi::test::utils::putFileToDir(new_subdirectory, "file_in_new_subdirectory.txt", "new");
+  std::filesystem::last_write_time(file_in_new_subdirectory, std::chrono::file_clock::now() - 10min);
+  minifi::test::utils::putFileToDir(input_dir, "young_file.txt", "young");
+  CHECK(get_file_names(test_controller.trigger()) == std::set<std::string>{"file_in_new_subdirectory.txt"});
+
+  // the young file is listed once it is old enough, even though it has not changed since
+  std::this_thread::sleep_for(1100ms);
+  CHECK(get_file_names(test_controller.trigger()) == std::set<std::string>{"young_file.txt"});
+  CHECK(test_controller.trigger().at(ListFile::Success).empty());
+}
+
 }  // namespace
@@ -21,6 +21,7 @@
 #include "unit/TestBase.h"
 #include "unit/Catch.h"
 #include "FlowFileRecord.h"
+#include "io/BufferStream.h"
 
 namespace org::apache::nifi::minifi::processors {
 
@@ -38,11 +39,38 @@ struct ReplaceTextTestAccessor {
 
   void setEvaluationMode(EvaluationModeType evaluation_mode) { processor_.evaluation_mode_ = evaluation_mode; }
   void setReplacementStrategy(ReplacementStrategyType replacement_strategy) { processor_.replacement_strategy_ = replacement_strategy; }
-  void setSearchValue(const std::string& search_value) { parameters_.search_value_ = search_value; }
-  void setSearchRegex(const std::string& search_regex) { parameters_.search_regex_ = std::regex{search_regex}; }
+  void setLineByLineEvaluationMode(LineByLineEvaluationModeType line_by_line_evaluation_mode) { processor_.line_by_line_evaluation_mode_ = line_by_line_evaluation_mode; }
+  void setSearchValue(const std::string& search_value) {
+    parameters_.search_value_ = search_value;
+    parameters_.search_value_scanner_.emplace(search_value);
+  }
+  void setSearchRegex(const std::string& search_regex) {
+    parameters_.search_value_ = search_regex;
+    parameters_.search_regex_ = std::regex{search_regex};
+  }
+  void setLinearSearchRegex(const std::string& search_regex) {
+    parameters_.search_value_ = search_regex;
+    processor_.linear_search_regex_ = utils::LinearRegex::compile(search_regex);
+  }
   void setReplacementValue(const std::string& replacement_value) { parameters_.replacement_value_ = replacement_value; }
+  void setBufferSize(size_t buffer_size) { processor_.buffer_size_ = buffer_size; }
+  void setRegexLookahead(size_t regex_lookahead) { processor_.regex_lookahead_ = regex_lookahead; }
 
   std::string applyReplacements(const std::string& input, const std::shared_ptr<core::FlowFile>& flow_file = {}) const { return processor_.applyReplacements(input, flow_file, parameters_); }
+
+  // runs the streaming implementation of the evaluation mode, which reads the input in chunks of the buffer size
+  std::string replaceInStream(const std::string& input, const std::shared_ptr<core::FlowFile>& flow_file = {}) const {
+    io::BufferStream input_stream;
+    input_stream.write(as_bytes(std::span(input)));
+    io::BufferStream output_stream;
+    const auto result = processor_.evaluation_mode_ == EvaluationModeType::ENTIRE_TEXT ?
+        processor_.replaceEntireText(input_stream, output_stream, flow_file, parameters_) : processor_.replaceLineByLine(input_stream, output_stream, flow_file, parameters_);
+    REQUIRE(result);
+    REQUIRE(result.bytesRead() == input.size());
+    const auto buffer = output_stream.getBuffer();
+    REQUIRE(result.bytesWritten() == buffer.size());
+    return {reinterpret_cast<const char*>(buffer.data()), buffer.size()};
+  }
 };
 
 }  // namespace org::apache::nifi::minifi::processors
@@ -186,6 +214,104 @@ TEST_CASE("Substitute Variables works correctly in ReplaceText", "[applyReplacem
   CHECK(replace_text.applyReplacements("this ${color} ${fruit} is sour", flow_file) == "this green ${fruit} is sour");
 }
 
+TEST_CASE("ReplaceText finds the matches spanning chunk boundaries in Entire text mode", "[Entire text][streaming]") {
+  minifi::processors::ReplaceTextTestAccessor replace_text;
+  replace_text.setEvaluationMode(minifi::processors::EvaluationModeType::ENTIRE_TEXT);
+  replace_text.setBufferSize(GENERATE(1, 3, 7, 4096));
+  replace_text.setRegexLookahead(6);
+
+  const auto flow_file = std::make_shared<minifi::FlowFileRecordImpl>();
+  flow_file->setAttribute("color", "green");
+
+  SECTION("Literal Replace") {
+    replace_text.setReplacementStrategy(minifi::processors::ReplacementStrategyType::LITERAL_REPLACE);
+    replace_text.setSearchValue("apple");
+    replace_text.setReplacementValue("orange");
+    CHECK(replace_text.replaceInStream("one apple, two apples, appl apple\n") == "one orange, two oranges, appl orange\n");
+    CHECK(replace_text.replaceInStream("apple") == "orange");
+  }
+  SECTION("Regex Replace with the standard engine") {
+    replace_text.setReplacementStrategy(minifi::processors::ReplacementStrategyType::REGEX_REPLACE);
+    replace_text.setSearchRegex("a(b{1,4})c");
+    replace_text.setReplacementValue("[$1]");
+    CHECK(replace_text.replaceInStream("abbc, ac, abc abbbc; abbbbc abc ac abbc abc\r\n") == "[bb], ac, [b] [bbb]; [bbbb] [b] ac [bb] [b]\r\n");
+  }
+  SECTION("Regex Replace with the linear engine") {
+    replace_text.setReplacementStrategy(minifi::processors::ReplacementStrategyType::REGEX_REPLACE);
+    replace_text.setLinearSearchRegex("a(b{1,4})c");
+    replace_text.setReplacementValue("[$1]");
+    CHECK(replace_text.replaceInStream("abbc, ac, abc abbbc; abbbbc abc ac abbc abc\r\n") == "[bb], ac, [b] [bbb]; [bbbb] [b] ac [bb] [b]\r\n");
+  }
+  SECTION("Regex Replace with anchors, word boundaries and empty matches") {
+    replace_text.setReplacementStrategy(minifi::processors::ReplacementStrategyType::REGEX_REPLACE);
+    replace_text.setSearchRegex("^a|\\bbe|x{0,3}|c\\b");
+    replace_text.setReplacementValue("_");
+    const std::string input = "abe bebe xxc abc bebe abe xbex, xxxc abc";
+    CHECK(replace_text.replaceInStream(input + "\n") == std::regex_replace(input, std::regex{"^a|\\bbe|x{0,3}|c\\b"}, "_") + "\n");
+  }
+  SECTION("Regex Replace referring to the text before and after the match") {
+    replace_text.setReplacementStrategy(minifi::processors::ReplacementStrategyType::REGEX_REPLACE);
+    replace_text.setSearchRegex("b");
+    replace_text.setReplacementValue("($`|$')");
+    CHECK(replace_text.replaceInStream("abc\n") == "a(a|c)c\n");
+  }
+  SECTION("Substitute Variables") {
+    replace_text.setReplacementStrategy(minifi::processors::ReplacementStrategyType::SUBSTITUTE_VARIABLES);
+    CHECK(replace_text.replaceInStream("the ${color} ${color}, the ${} and the ${fruit}", flow_file) == "the green green, the ${} and the ${fruit}");
+  }
+  SECTION("Append leaves the line ending at the end") {
+    replace_text.setReplacementStrategy(minifi::processors::ReplacementStrategyType::APPEND);
+    replace_text.setReplacementValue(" tree");
+    CHECK(replace_text.replaceInStream("apple\npear\r\n") == "apple\npear tree\r\n");
+  }
+  SECTION("Always Replace keeps the line ending at the end") {
+    replace_text.setReplacementStrategy(minifi::processors::ReplacementStrategyType::ALWAYS_REPLACE);
+    replace_text.setReplacementValue("fruit");
+    CHECK(replace_text.replaceInStream("apple\npear\n") == "fruit\n");
+  }
+}
+
+TEST_CASE("ReplaceText reads the whole content if a regex match may not fit in the window in Entire text mode", "[Entire text][streaming]") {
+  minifi::processors::ReplaceTextTestAccessor replace_text;
+  replace_text.setEvaluationMode(minifi::processors::EvaluationModeType::ENTIRE_TEXT);
+  replace_text.setBufferSize(GENERATE(1, 7, 4096));
+  replace_text.setRegexLookahead(6);
+  replace_text.setReplacementStrategy(minifi::processors::ReplacementStrategyType::REGEX_REPLACE);
+  replace_text.setReplacementValue("<$&>");
+
+  const std::string input = "the first line\nthe second line\naaaaaaaaaa, abbbbbbbbbc\n";
+  const std::string search_regex = GENERATE("^[\\s\\S]*$", "line$", "a{8}", "ab+c");
+  const bool linear_engine = GENERATE(false, true);
+  if (linear_engine) {
+    replace_text.setLinearSearchRegex(search_regex);
+  } else {
+    replace_text.setSearchRegex(search_regex);
+  }
+  CHECK(replace_text.replaceInStream(input) == std::regex_replace(input, std::regex{search_regex}, "<$&>"));
+}
+
+TEST_CASE("ReplaceText reads the lines in chunks in Line-by-Line mode", "[Line-by-Line][streaming]") {
+  minifi::processors::ReplaceTextTestAccessor replace_text;
+  replace_text.setEvaluationMode(minifi::processors::EvaluationModeType::LINE_BY_LINE);
+  replace_text.setBufferSize(GENERATE(1, 3, 7, 4096));
+  replace_text.setReplacementStrategy(minifi::processors::ReplacementStrategyType::LITERAL_REPLACE);
+  replace_text.setSearchValue("a");
+  replace_text.setReplacementValue("*");
+
+  SECTION("All lines") {
+    CHECK(replace_text.replaceInStream("apple\n pear\r\n\n banana") == "*pple\n pe*r\r\n\n b*n*n*");
+    CHECK(replace_text.replaceInStream("").empty());
+  }
+  SECTION("The last line") {
+    replace_text.setLineByLineEvaluationMode(minifi::processors::LineByLineEvaluationModeType::LAST_LINE);
+    CHECK(replace_text.replaceInStream("apple\n pear\n banana\n") == "apple\n pear\n b*n*n*\n");
+  }
+  SECTION("All lines except the last") {
+    replace_text.setLineByLineEvaluationMode(minifi::processors::LineByLineEvaluationModeType::EXCEPT_LAST_LINE);
+    CHECK(replace_text.replaceInStream("apple\n pear\n banana") == "*pple\n pe*r\n banana");
+  }
+}
+
 TEST_CASE("Regex Replace works correctly in ReplaceText in line by line mode", "[Line-by-Line][Regex Replace]") {
   TestController testController;
   std::shared_ptr<TestPlan> plan = testController.createPlan();
@@ -201,6 +327,7 @@ TEST_CASE("Regex Replace works correctly in ReplaceText in line by line mode", "
   plan->setProperty(replace_text, minifi::processors::ReplaceText::ReplacementStrategy, magic_enum::enum_name(minifi::processors::ReplacementStrategyType::REGEX_REPLACE));
   plan->setProperty(replace_text, minifi::processors::ReplaceText::SearchValue, "[aeiou]");
   plan->setProperty(replace_text, minifi::processors::ReplaceText::ReplacementValue, "_");
+  plan->setProperty(replace_text, minifi::processors::ReplaceText::RegularExpressionEngine, GENERATE("Standard", "Linear"));
 
   std::string expected_output;
   SECTION("Replacing all lines") {
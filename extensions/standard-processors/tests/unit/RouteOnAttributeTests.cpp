@@ -15,10 +15,15 @@
  * See the License for the specific language governing permissions and
  * limitations under the License.
  */
+#include <algorithm>
 #include <array>
 #include <memory>
+#include <string>
+#include <vector>
 #include "unit/TestBase.h"
 #include "unit/Catch.h"
+#include "unit/ProcessorUtils.h"
+#include "unit/SingleProcessorTestController.h"
 #include <RouteOnAttribute.h>
 #include "processors/LogAttribute.h"
 #include "processors/UpdateAttribute.h"
@@ -91,3 +96,55 @@ TEST_CASE("RouteOnAttributeUnmatchedTest", "[routeOnAttributeUnmatchedTest]") {
 
   LogTestController::getInstance().reset();
 }
+
+namespace {
+std::vector<std::string> getNumbers(const std::vector<std::shared_ptr<core::FlowFile>>& flow_files) {
+  std::vector<std::string> numbers;
+  for (const auto& flow_file : flow_files) {
+    numbers.push_back(flow_file->getAttribute("number").value_or(""));
+  }
+  std::ranges::sort(numbers);
+  return numbers;
+}
+}  // namespace
+
+TEST_CASE("RouteOnAttribute routes a batch of flow files in one trigger", "[routeOnAttributeBatch]") {
+  minifi::test::SingleProcessorTestController controller{minifi::test::utils::make_processor<minifi::processors::RouteOnAttribute>("RouteOnAttribute")};
+  auto* const route_on_attribute = controller.getProcessor();
+  REQUIRE(controller.plan->setProperty(route_on_attribute, minifi::processors::RouteOnAttribute::BatchSize, "10"));
+  REQUIRE(controller.plan->setDynamicProperty(route_on_attribute, "even", "${number:mod(2):equals(0)}"));
+  REQUIRE(controller.plan->setDynamicProperty(route_on_attribute, "small", "${number:lt(3)}"));
+  const auto even = controller.addDynamicRelationship("even");
+  const auto small = controller.addDynamicRelationship("small");
+
+  std::vector<minifi::test::InputFlowFileData> input;
+  for (int number = 0; number < 6; ++number) {
+    input.push_back({.content = "content", .attributes = {{"number", std::to_string(number)}}});
+  }
+  auto results = controller.trigger(std::move(input));
+
+  CHECK(getNumbers(results.at(even)) == std::vector<std::string>{"0", "2", "4"});
+  CHECK(getNumbers(results.at(small)) == std::vector<std::string>{"0", "1", "2"});
+  CHECK(getNumbers(results.at(minifi::processors::RouteOnAttribute::Unmatched)) == std::vector<std::string>{"3", "5"});
+  CHECK(results.at(minifi::processors::RouteOnAttribute::Failure).empty());
+  for (const auto& flow_file : results.at(even)) {
+    CHECK(controller.plan->getContent(flow_file) == "content");
+  }
+}
+
+TEST_CASE("RouteOnAttribute routes the flow files of a batch one by one if the batch cannot be evaluated", "[routeOnAttributeBatch]") {
+  minifi::test::SingleProcessorTestController controller{minifi::test::utils::make_processor<minifi::processors::RouteOnAttribute>("RouteOnAttribute")};
+  auto* const route_on_attribute = controller.getProcessor();
+  REQUIRE(controller.plan->setProperty(route_on_attribute, minifi::processors::RouteOnAttribute::BatchSize, "10"));
+  REQUIRE(controller.plan->setDynamicProperty(route_on_attribute, "one", "${number:toRadix(${radix}):equals('1')}"));
+  const auto one = controller.addDynamicRelationship("one");
+
+  auto results = controller.trigger({
+      {.content = "", .attributes = {{"number", "1"}, {"radix", "2"}}},
+      {.content = "", .attributes = {{"number", "2"}, {"radix", "50"}}},
+      {.content = "", .attributes = {{"number", "3"}, {"radix", "2"}}}});
+
+  CHECK(getNumbers(results.at(one)) == std::vector<std::string>{"1"});
+  CHECK(getNumbers(results.at(minifi::processors::RouteOnAttribute::Failure)) == std::vector<std::string>{"2"});
+  CHECK(getNumbers(results.at(minifi::processors::RouteOnAttribute::Unmatched)) == std::vector<std::string>{"3"});
+}
@@ -487,3 +487,43 @@ TEST_CASE_METHOD(RouteTextController, "Expressions have access to injected varia
 
   verifyAllOutput(expected);
 }
+
+TEST_CASE_METHOD(RouteTextController, "RouteText routes the same way with both regular expression engines") {
+  REQUIRE(proc_->setProperty(processors::RouteText::RegularExpressionEngine.name, GENERATE("Standard", "Linear")));
+  REQUIRE(proc_->setProperty(processors::RouteText::SegmentationStrategy.name, "Per Line"));
+  REQUIRE(proc_->setProperty(processors::RouteText::RoutingStrategy.name, "Dynamic Routing"));
+  REQUIRE(proc_->setDynamicProperty("error", "ERROR"));
+  REQUIRE(proc_->setDynamicProperty("dated", "^[0-9]{4}-[0-9]{2}-[0-9]{2}"));
+  REQUIRE(proc_->setDynamicProperty("network", "time(out)?|refused"));
+
+  createOutput({"error", ""});
+  createOutput({"dated", ""});
+  createOutput({"network", ""});
+
+  std::string content = "2024-05-13 ERROR connection refused\n2024-05-13 INFO started\nERROR\nother";
+  putFlowFile({}, content);
+
+  std::map<std::string, FlowFilePatternVec> expected{
+      {"matched", {}},
+      {"original", {content}}
+  };
+
+  SECTION("Contains Regex") {
+    REQUIRE(proc_->setProperty(processors::RouteText::MatchingStrategy.name, "Contains Regex"));
+    expected["error"] = {"2024-05-13 ERROR connection refused\nERROR\n"};
+    expected["dated"] = {"2024-05-13 ERROR connection refused\n2024-05-13 INFO started\n"};
+    expected["network"] = {"2024-05-13 ERROR connection refused\n"};
+    expected["unmatched"] = {"other"};
+  }
+  SECTION("Matches Regex") {
+    REQUIRE(proc_->setProperty(processors::RouteText::MatchingStrategy.name, "Matches Regex"));
+    expected["error"] = {"ERROR\n"};
+    expected["dated"] = {};
+    expected["network"] = {};
+    expected["unmatched"] = {"2024-05-13 ERROR connection refused\n2024-05-13 INFO started\nother"};
+  }
+
+  run();
+
+  verifyAllOutput(expected);
+}
@@ -1834,3 +1834,122 @@ TEST_CASE("Result mode tests") {
   const auto& file_contents = result.at(minifi::processors::TailFile::Success);
   CHECK(file_contents.size() == ff_count);
 }
+
+#ifndef WIN32
+TEST_CASE("TailFile finishes the renamed file even if the new log file is already larger", "[rotation]") {
+  minifi::test::SingleProcessorTestController test_controller(minifi::test::utils::make_processor<minifi::processors::TailFile>("TailFile"));
+  LogTestController::getInstance().setTrace<minifi::processors::TailFile>();
+
+  auto dir = test_controller.createTempDirectory();
+  auto in_file = createTempFile(dir, "testfifo.txt", NEWLINE_FILE, std::ios::out | std::ios::binary, -200ms);
+
+  test_controller.plan->setProperty(test_controller.getProcessor(), minifi::processors::TailFile::FileName, in_file.string());
+  test_controller.plan->setProperty(test_controller.getProcessor(), minifi::processors::TailFile::Delimiter, ",");
+
+  {
+    auto res = test_controller.trigger();
+    REQUIRE(res.at(minifi::processors::TailFile::Success).size() == 5);
+  }
+
+  auto rotated_file = in_file;
+  rotated_file += ".1";
+  REQUIRE_NOTHROW(std::filesystem::rename(in_file, rotated_file));
+  std::filesystem::last_write_time(rotated_file, std::chrono::file_clock::now());
+  const std::string new_content = "a long first line of the new file,second,";
+  REQUIRE(new_content.size() > NEWLINE_FILE.size());
+  createTempFile(dir, "testfifo.txt", new_content, std::ios::out | std::ios::binary, -100ms);
+
+  {
+    auto res = test_controller.trigger();
+    const auto& success_ffs = res.at(minifi::processors::TailFile::Success);
+    REQUIRE(success_ffs.size() == 3);
+    CHECK(test_controller.plan->getContent(success_ffs[0]) == " seven");
+    CHECK(test_controller.plan->getContent(success_ffs[1]) == "a long first line of the new file,");
+    CHECK(test_controller.plan->getContent(success_ffs[2]) == "second,");
+  }
+}
+
+TEST_CASE("TailFile recognizes the renamed file by its inode even if an older rotated file has the same content", "[rotation]") {
+  minifi::test::SingleProcessorTestController test_controller(minifi::test::utils::make_processor<minifi::processors::TailFile>("TailFile"));
+  LogTestController::getInstance().setTrace<minifi::processors::TailFile>();
+
+  auto dir = test_controller.createTempDirectory();
+  auto in_file = createTempFile(dir, "testfifo.txt", NEWLINE_FILE, std::ios::out | std::ios::binary, -200ms);
+
+  test_controller.plan->setProperty(test_controller.getProcessor(), minifi::processors::TailFile::FileName, in_file.string());
+  test_controller.plan->setProperty(test_controller.getProcessor(), minifi::processors::TailFile::Delimiter, ",");
+
+  {
+    auto res = test_controller.trigger();
+    REQUIRE(res.at(minifi::processors::TailFile::Success).size() == 5);
+  }
+
+  auto copied_file = in_file;
+  copied_file += ".0";
+  REQUIRE(std::filesystem::copy_file(in_file, copied_file));
+  auto rotated_file = in_file;
+  rotated_file += ".1";
+  REQUIRE_NOTHROW(std::filesystem::rename(in_file, rotated_file));
+  // with equal mtimes, the copy comes first, so it would be taken as the continuation by its checksum alone
+  const auto rotation_time = std::chrono::file_clock::now();
+  std::filesystem::last_write_time(copied_file, rotation_time);
+  std::filesystem::last_write_time(rotated_file, rotation_time);
+  createTempFile(dir, "testfifo.txt", "new,", std::ios::out | std::ios::binary, -50ms);
+
+  {
+    auto res = test_controller.trigger();
+    const auto& success_ffs = res.at(minifi::processors::TailFile::Success);
+    std::vector<std::string> contents;
+    for (const auto& flow_file : success_ffs) {
+      contents.push_back(test_controller.plan->getContent(flow_file));
+    }
+    CHECK(contents == std::vector<std::string>{"one,", "two,", "three\nfour,", "five,", "six,", " seven", " seven", "new,"});
+  }
+}
+#endif
+
+TEST_CASE("TailFile only checks the changed files if the Change Detection is File System Events", "[rotation][multiple_file]") {
+  minifi::test::SingleProcessorTestController test_controller(minifi::test::utils::make_processor<minifi::processors::TailFile>("TailFile"));
+  LogTestController::getInstance().setTrace<minifi::processors::TailFile>();
+
+  auto dir = test_controller.createTempDirectory();
+  createTempFile(dir, "first.log", "one,two,", std::ios::out | std::ios::binary, -200ms);
+  createTempFile(dir, "second.log", "three,", std::ios::out | std::ios::binary, -200ms);
+
+  test_controller.plan->setProperty(test_controller.getProcessor(), minifi::processors::TailFile::TailMode, "Multiple file");
+  test_controller.plan->setProperty(test_controller.getProcessor(), minifi::processors::TailFile::FileName, ".*\\.log");
+  test_controller.plan->setProperty(test_controller.getProcessor(), minifi::processors::TailFile::BaseDirectory, dir.string());
+  test_controller.plan->setProperty(test_controller.getProcessor(), minifi::processors::TailFile::LookupFrequency, "0 sec");
+  test_controller.plan->setProperty(test_controller.getProcessor(), minifi::processors::TailFile::Delimiter, ",");
+  test_controller.plan->setProperty(test_controller.getProcessor(), minifi::processors::TailFile::ChangeDetection, "File System Events");
+
+  {
+    auto res = test_controller.trigger();
+    CHECK(res.at(minifi::processors::TailFile::Success).size() == 3);
+  }
+
+  LogTestController::getInstance().clear();
+  appendTempFile(dir, "first.log", "four,");
+  {
+    auto res = test_controller.trigger();
+    const auto& success_ffs = res.at(minifi::processors::TailFile::Success);
+    REQUIRE(success_ffs.size() == 1);
+    CHECK(test_controller.plan->getContent(success_ffs[0]) == "four,");
+  }
+#ifdef __linux__
+  CHECK_FALSE(LogTestController::getInstance().contains("Skipping file second.log"));
+#endif
+
+  REQUIRE_NOTHROW(std::filesystem::rename(dir / "second.log", dir / "second.log.1"));
+  appendTempFile(dir, "second.log.1", "five,");
+  createTempFile(dir, "second.log", "six,", std::ios::out | std::ios::binary, -100ms);
+  createTempFile(dir, "third.log", "seven,");
+  {
+    auto res = test_controller.trigger();
+    std::set<std::string> contents;
+    for (const auto& flow_file : res.at(minifi::processors::TailFile::Success)) {
+      contents.insert(test_controller.plan->getContent(flow_file));
+    }
+    CHECK(contents == std::set<std::string>{"five,", "six,", "seven,"});
+  }
+}
@@ -16,9 +16,13 @@
  * limitations under the License.
  */
 #include <memory>
+#include <string>
+#include <vector>
 
 #include "unit/TestBase.h"
 #include "unit/Catch.h"
+#include "unit/ProcessorUtils.h"
+#include "unit/SingleProcessorTestController.h"
 
 #include "LogAttribute.h"
 #include "UpdateAttribute.h"
@@ -48,3 +52,49 @@ TEST_CASE("UpdateAttributeTest", "[updateAttributeTest]") {
 
   LogTestController::getInstance().reset();
 }
+
+TEST_CASE("UpdateAttribute updates a batch of flow files in one trigger", "[updateAttributeBatch]") {
+  minifi::test::SingleProcessorTestController controller{minifi::test::utils::make_processor<minifi::processors::UpdateAttribute>("UpdateAttribute")};
+  auto* const update_attribute = controller.getProcessor();
+  REQUIRE(controller.plan->setProperty(update_attribute, minifi::processors::UpdateAttribute::BatchSize, "10"));
+  REQUIRE(controller.plan->setDynamicProperty(update_attribute, "doubled", "${number:multiply(2)}"));
+  // the attribute values are computed before any of them is set, so this is the value doubled had before the update
+  REQUIRE(controller.plan->setDynamicProperty(update_attribute, "previous", "${doubled}"));
+
+  std::vector<minifi::test::InputFlowFileData> input;
+  for (int number = 0; number < 5; ++number) {
+    input.push_back({.content = "", .attributes = {{"number", std::to_string(number)}, {"doubled", "old"}}});
+  }
+  const auto results = controller.trigger(std::move(input));
+
+  const auto& success = results.at(minifi::processors::UpdateAttribute::Success);
+  REQUIRE(success.size() == 5);
+  CHECK(results.at(minifi::processors::UpdateAttribute::Failure).empty());
+  for (const auto& flow_file : success) {
+    const auto number = std::stoi(*flow_file->getAttribute("number"));
+    CHECK(flow_file->getAttribute("doubled") == std::to_string(2 * number));
+    CHECK(flow_file->getAttribute("previous") == "old");
+  }
+}
+
+TEST_CASE("UpdateAttribute updates the flow files of a batch one by one if the batch cannot be evaluated", "[updateAttributeBatch]") {
+  minifi::test::SingleProcessorTestController controller{minifi::test::utils::make_processor<minifi::processors::UpdateAttribute>("UpdateAttribute")};
+  auto* const update_attribute = controller.getProcessor();
+  REQUIRE(controller.plan->setProperty(update_attribute, minifi::processors::UpdateAttribute::BatchSize, "10"));
+  REQUIRE(controller.plan->setDynamicProperty(update_attribute, "converted", "${number:toRadix(${radix})}"));
+
+  const auto results = controller.trigger({
+      {.content = "", .attributes = {{"number", "5"}, {"radix", "2"}}},
+      {.content = "", .attributes = {{"number", "6"}, {"radix", "50"}}},
+      {.content = "", .attributes = {{"number", "7"}, {"radix", "8"}}}});
+
+  const auto& success = results.at(minifi::processors::UpdateAttribute::Success);
+  const auto& failure = results.at(minifi::processors::UpdateAttribute::Failure);
+  REQUIRE(success.size() == 2);
+  REQUIRE(failure.size() == 1);
+  CHECK(failure[0]->getAttribute("number") == "6");
+  CHECK_FALSE(failure[0]->getAttribute("converted"));
+  for (const auto& flow_file : success) {
+    CHECK(flow_file->getAttribute("converted") == (flow_file->getAttribute("number") == "5" ? "101" : "7"));
+  }
+}
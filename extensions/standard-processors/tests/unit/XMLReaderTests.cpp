@@ -37,6 +37,11 @@ class XMLReaderTestFixture {
     return xml_reader_->getImplementation<XMLReader>()->read(buffer_stream_);
   }
 
+  std::unique_ptr<core::RecordReader> createRecordReader(const std::string& xml_input, const std::unordered_map<std::string_view, std::string_view>& properties = {}) {
+    initializeTestObject(xml_input, properties);
+    return xml_reader_->getImplementation<XMLReader>()->createRecordReader(buffer_stream_);
+  }
+
  private:
   void initializeTestObject(const std::string& xml_input, const std::unordered_map<std::string_view, std::string_view>& properties = {}) {
     xml_reader_->initialize();
@@ -250,4 +255,37 @@ TEST_CASE_METHOD(XMLReaderTestFixture, "Read multiple records from XML", "[XMLRe
   CHECK(std::get<std::string>(record2.at("value").value_) == "Hi!");
 }
 
+TEST_CASE_METHOD(XMLReaderTestFixture, "Records of an XML array are read one at a time", "[XMLReader]") {
+  const std::string xml_input = R"(<?xml version="1.0"?>
+<!-- header -->
+<root attr="a > b">
+  <node id="1"><text><![CDATA[</node>]]></text><!-- </node> --></node>
+  <?processing instruction?>
+  <node id="2"/>
+  <node>3</node>
+</root>)";
+  const auto record_reader = createRecordReader(xml_input, {{XMLReader::ExpectRecordsAsArray.name, "true"}, {XMLReader::ParseXMLAttributes.name, "true"}});
+  const auto first_batch = record_reader->nextBatch(2);
+  REQUIRE(first_batch);
+  REQUIRE(first_batch->size() == 2);
+  CHECK(std::get<std::string>(first_batch->at(0).at("text").value_) == "</node>");
+  CHECK(first_batch->at(1) == core::Record{});
+  const auto last_record = record_reader->next();
+  REQUIRE(last_record);
+  REQUIRE(*last_record);
+  CHECK(std::get<uint64_t>((*last_record)->at("value").value_) == 3);
+  const auto end = record_reader->next();
+  REQUIRE(end);
+  CHECK_FALSE(*end);
+}
+
+TEST_CASE_METHOD(XMLReaderTestFixture, "Truncated XML array results in error after the complete records", "[XMLReader]") {
+  const auto record_reader = createRecordReader("<root><node>1</node><node>2</no", {{XMLReader::ExpectRecordsAsArray.name, "true"}});
+  const auto first_record = record_reader->next();
+  REQUIRE(first_record);
+  REQUIRE(*first_record);
+  CHECK_FALSE(record_reader->next());
+  CHECK(LogTestController::getInstance().contains("Failed to parse XML content: <node>2</no"));
+}
+
 }  // namespace org::apache::nifi::minifi::standard::test
@@ -0,0 +1,58 @@
+/**
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The ASF licenses this file to You under the Apache License, Version 2.0
+ * (the "License"); you may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <optional>
+#include <string>
+#include <string_view>
+
+namespace org::apache::nifi::minifi::utils::csv {
+
+/**
+ * Parses the value of a property holding a single character of the CSV format, e.g. the value separator. "\t" stands for the tab character.
+ * Line breaks are not accepted, as they separate the rows.
+ */
+inline std::optional<char> parseCharacter(std::string_view value) {
+  if (value == "\\t") {
+    return '\t';
+  }
+  if (value.size() != 1 || value[0] == '\n' || value[0] == '\r') {
+    return std::nullopt;
+  }
+  return value[0];
+}
+
+// replaces the escape sequences \n, \r and \t of a property value with the characters they stand for
+inline std::string unescapeControlCharacters(std::string_view value) {
+  std::string result;
+  result.reserve(value.size());
+  for (size_t i = 0; i < value.size(); ++i) {
+    if (value[i] == '\\' && i + 1 < value.size()) {
+      switch (value[i + 1]) {
+        case 'n': result.push_back('\n'); ++i; continue;
+        case 'r': result.push_back('\r'); ++i; continue;
+        case 't': result.push_back('\t'); ++i; continue;
+        default: break;
+      }
+    }
+    result.push_back(value[i]);
+  }
+  return result;
+}
+
+}  // namespace org::apache::nifi::minifi::utils::csv
@@ -0,0 +1,151 @@
+/**
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The ASF licenses this file to You under the Apache License, Version 2.0
+ * (the "License"); you may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "FileChangeWatcher.h"
+
+#ifdef __linux__
+#include <sys/inotify.h>
+#include <unistd.h>
+
+#include <array>
+#include <cerrno>
+#include <cstring>
+
+#include "minifi-cpp/utils/gsl.h"
+#endif
+
+namespace org::apache::nifi::minifi::utils::file {
+
+#ifdef __linux__
+
+namespace {
+constexpr uint32_t WATCHED_EVENTS = IN_CREATE | IN_MODIFY | IN_MOVED_FROM | IN_MOVED_TO | IN_DELETE | IN_DELETE_SELF | IN_MOVE_SELF | IN_ONLYDIR;
+constexpr size_t EVENT_BUFFER_SIZE = 64 * 1024;
+}  // namespace
+
+FileChangeWatcher::FileChangeWatcher() : fd_(inotify_init1(IN_NONBLOCK | IN_CLOEXEC)) {
+  if (fd_ < 0) {
+    logger_->log_warn("Failed to initialize inotify, the files will be polled: {}", std::strerror(errno));
+  }
+}
+
+FileChangeWatcher::~FileChangeWatcher() {
+  if (fd_ >= 0) {
+    close(fd_);
+  }
+}
+
+bool FileChangeWatcher::watch(const std::filesystem::path& directory) {
+  if (watched_directories_.contains(directory)) {
+    return true;
+  }
+  if (fd_ < 0) {
+    return false;
+  }
+  const int watch_descriptor = inotify_add_watch(fd_, directory.c_str(), WATCHED_EVENTS);
+  if (watch_descriptor < 0) {
+    logger_->log_warn("Failed to watch directory {}, the files in it will be polled: {}", directory, std::strerror(errno));
+    return false;
+  }
+  if (directories_.contains(watch_descriptor)) {
+    // the events are reported with the path the directory was first watched with
+    logger_->log_debug("Directory {} is already watched as {}, the files in it will be polled", directory, directories_.at(watch_descriptor));
+    return false;
+  }
+  directories_.emplace(watch_descriptor, directory);
+  watched_directories_.insert(directory);
+  logger_->log_debug("Watching directory {}", directory);
+  return true;
+}
+
+std::optional<std::set<std::filesystem::path>> FileChangeWatcher::takeChangedFiles() {
+  std::set<std::filesystem::path> changed_files;
+  if (fd_ < 0) {
+    return changed_files;
+  }
+
+  bool changes_lost = false;
+  const auto forget_directory = [&](std::map<int, std::filesystem::path>::iterator directory) {
+    logger_->log_debug("Directory {} is no longer watched", directory->second);
+    watched_directories_.erase(directory->second);
+    directories_.erase(directory);
+    changes_lost = true;
+  };
+
+  alignas(inotify_event) std::array<char, EVENT_BUFFER_SIZE> buffer{};
+  while (true) {
+    const auto length = read(fd_, buffer.data(), buffer.size());
+    if (length <= 0) {
+      if (length < 0 && errno != EAGAIN && errno != EWOULDBLOCK) {
+        logger_->log_warn("Failed to read inotify events: {}", std::strerror(errno));
+        changes_lost = true;
+      }
+      break;
+    }
+    for (size_t offset = 0; offset < gsl::narrow<size_t>(length);) {
+      inotify_event event{};
+      std::memcpy(&event, buffer.data() + offset, sizeof(event));
+      const char* name = buffer.data() + offset + sizeof(event);
+      offset += sizeof(event) + event.len;
+
+      if ((event.mask & IN_Q_OVERFLOW) != 0) {
+        logger_->log_debug("The inotify event queue overflowed");
+        changes_lost = true;
+        continue;
+      }
+      const auto directory = directories_.find(event.wd);
+      if (directory == directories_.end()) {
+        continue;
+      }
+      if ((event.mask & IN_IGNORED) != 0 || (event.mask & IN_DELETE_SELF) != 0) {
+        forget_directory(directory);
+      } else if ((event.mask & IN_MOVE_SELF) != 0) {
+        // the watch would follow the directory to its new path
+        inotify_rm_watch(fd_, event.wd);
+        forget_directory(directory);
+      } else if (event.len > 0) {
+        changed_files.insert(directory->second / name);
+      }
+    }
+  }
+
+  if (changes_lost) {
+    return std::nullopt;
+  }
+  return changed_files;
+}
+
+#else
+
+FileChangeWatcher::FileChangeWatcher() = default;
+FileChangeWatcher::~FileChangeWatcher() = default;
+
+bool FileChangeWatcher::watch(const std::filesystem::path& /*directory*/) {
+  return false;
+}
+
+std::optional<std::set<std::filesystem::path>> FileChangeWatcher::takeChangedFiles() {
+  return std::set<std::filesystem::path>{};
+}
+
+#endif
+
+bool FileChangeWatcher::isWatched(const std::filesystem::path& directory) const {
+  return watched_directories_.contains(directory);
+}
+
+}  // namespace org::apache::nifi::minifi::utils::file
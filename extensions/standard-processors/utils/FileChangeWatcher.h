@@ -0,0 +1,83 @@
+/**
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The ASF licenses this file to You under the Apache License, Version 2.0
+ * (the "License"); you may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <filesystem>
+#include <map>
+#include <memory>
+#include <optional>
+#include <set>
+
+#include "core/logging/LoggerFactory.h"
+#include "utils/Enum.h"
+
+namespace org::apache::nifi::minifi::utils::file {
+
+enum class ChangeDetectionStrategy {
+  Polling,
+  FileSystemEvents
+};
+
+/**
+ * Collects the names of the files which were created, modified, moved or deleted in the watched directories, using inotify.
+ * On other platforms than Linux no directory can be watched, so the caller has to fall back to checking the files itself.
+ */
+class FileChangeWatcher {
+ public:
+  FileChangeWatcher();
+  ~FileChangeWatcher();
+
+  FileChangeWatcher(const FileChangeWatcher&) = delete;
+  FileChangeWatcher(FileChangeWatcher&&) = delete;
+  FileChangeWatcher& operator=(const FileChangeWatcher&) = delete;
+  FileChangeWatcher& operator=(FileChangeWatcher&&) = delete;
+
+  // returns false if the directory cannot be watched, e.g. it does not exist or the inotify watch limit is reached
+  bool watch(const std::filesystem::path& directory);
+  [[nodiscard]] bool isWatched(const std::filesystem::path& directory) const;
+
+  /**
+   * Returns the files in the watched directories which changed since the last call.
+   * Returns std::nullopt if some changes may have been lost (the event queue overflowed or a watched directory was removed or moved),
+   * then every file has to be checked.
+   */
+  std::optional<std::set<std::filesystem::path>> takeChangedFiles();
+
+ private:
+  int fd_ = -1;
+  std::map<int, std::filesystem::path> directories_;
+  std::set<std::filesystem::path> watched_directories_;
+  std::shared_ptr<core::logging::Logger> logger_ = core::logging::LoggerFactory<FileChangeWatcher>::getLogger();
+};
+
+}  // namespace org::apache::nifi::minifi::utils::file
+
+namespace magic_enum::customize {
+using ChangeDetectionStrategy = org::apache::nifi::minifi::utils::file::ChangeDetectionStrategy;
+
+template<>
+constexpr customize_t enum_name<ChangeDetectionStrategy>(ChangeDetectionStrategy value) noexcept {
+  switch (value) {
+    case ChangeDetectionStrategy::Polling:
+      return "Polling";
+    case ChangeDetectionStrategy::FileSystemEvents:
+      return "File System Events";
+  }
+  return invalid_tag;
+}
+}  // namespace magic_enum::customize
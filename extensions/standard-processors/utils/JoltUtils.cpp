@@ -273,20 +273,21 @@ std::string Spec::Template::eval(const Context& ctx) const {
 }
 
 std::optional<std::vector<std::string_view>> Spec::Regex::match(std::string_view str) const {
-  std::vector<std::string_view> matches;
-  matches.push_back(str);
   if (fragments.size() == 1) {
     if (str == fragments.front()) {
-      return matches;
+      return std::vector<std::string_view>{str};
     } else {
       return std::nullopt;
     }
   }
 
-  // first fragment is at the beginning of the string
-  if (!str.starts_with(fragments.front())) {
+  // first fragment is at the beginning of the string, the last one at the end, most names are rejected here without allocating
+  if (str.size() < fragments.front().size() + fragments.back().size() || !str.starts_with(fragments.front()) || !str.ends_with(fragments.back())) {
     return std::nullopt;
   }
+  std::vector<std::string_view> matches;
+  matches.reserve(fragments.size());
+  matches.push_back(str);
   auto it = str.begin() + fragments.front().size();
   for (size_t idx = 1; idx + 1 < fragments.size(); ++idx) {
     auto& frag = fragments[idx];
@@ -807,7 +808,7 @@ std::pair<std::string, std::string> toString(const Spec::Context& ctx, const Spe
   return {raw, result};
 }
 
-std::expected<std::reference_wrapper<const rapidjson::Value>, std::string> resolvePath(const Spec::Context& ctx, std::string_view root_path, const rapidjson::Value& root, const Spec::Path& path);
+std::expected<std::reference_wrapper<const rapidjson::Value>, std::string> resolvePath(const Spec::Context& ctx, const Spec::Context& root_ctx, const rapidjson::Value& root, const Spec::Path& path);
 
 Spec::Pattern::Value parseValue(const Spec::Context& ctx, const rapidjson::Value& val) {
   if (val.IsObject()) {
@@ -829,11 +830,11 @@ void putValue(const Spec::Context& ctx, const Spec::Destination& dest, const rap
         return;
       }
       std::reference_wrapper<const rapidjson::Value> member_value = std::ref(*root->node);
-      if (auto inner_member_value = resolvePath(ctx, ctx.path(), *root->node, val_ref->second)) {
+      if (auto inner_member_value = resolvePath(ctx, ctx, *root->node, val_ref->second)) {
         member_value = inner_member_value.value();
       } else {
-        auto sub_path = toString(ctx, val_ref->second);
         ctx.log([&] (const auto& logger) {
+          auto sub_path = toString(ctx, val_ref->second);
           logger->log_trace("Could not find member at @({},{} as {}) from {}", val_ref->first, sub_path.first, sub_path.second, ctx.path());
         }, [] (const auto&) {});
         // do not write anything and do not throw
@@ -927,10 +928,12 @@ void putValue(const Spec::Context& ctx, const Spec::Destination& dest, const rap
         }
         target.get().SetObject();
       }
-      if (!target.get().HasMember(member)) {
+      if (auto member_it = target.get().FindMember(member); member_it != target.get().MemberEnd()) {
+        target = member_it->value;
+      } else {
         target.get().AddMember(rapidjson::Value{member.c_str(), gsl::narrow<rapidjson::SizeType>(member.size()), output.GetAllocator()}, rapidjson::Value{}, output.GetAllocator());
+        target = (target.get().MemberEnd() - 1)->value;
       }
-      target = target.get()[member];
     }
   }
 
@@ -953,28 +956,39 @@ void putValue(const Spec::Context& ctx, const Spec::Destinations& destinations,
   }
 }
 
-std::expected<std::reference_wrapper<const rapidjson::Value>, std::string> resolvePath(const Spec::Context& ctx, std::string_view root_path, const rapidjson::Value& root, const Spec::Path& path) {
-  std::string full_path{root_path};
+std::expected<std::reference_wrapper<const rapidjson::Value>, std::string> resolvePath(const Spec::Context& ctx, const Spec::Context& root_ctx, const rapidjson::Value& root, const Spec::Path& path) {
+  // the path is only assembled for the error message, as most lookups succeed
+  const auto full_path = [&] (size_t end) {
+    std::string result = root_ctx.path();
+    for (size_t idx = 0; idx < end; ++idx) {
+      if (path[idx].second == Spec::MemberType::FIELD) {
+        result.append(".").append(path[idx].first.eval(ctx));
+      } else {
+        result.append("[").append(path[idx].first.eval(ctx)).append("]");
+      }
+    }
+    return result;
+  };
   std::reference_wrapper<const rapidjson::Value> result = std::ref(root);
-  for (auto& [templ, type] : path) {
+  for (size_t path_idx = 0; path_idx < path.size(); ++path_idx) {
+    auto& [templ, type] = path[path_idx];
     auto member = templ.eval(ctx);
     if (type == Spec::MemberType::FIELD) {
-      full_path += "." + member;
       if (!result.get().IsObject()) {
-        return std::unexpected{fmt::format("Expected object at {}", full_path)};
+        return std::unexpected{fmt::format("Expected object at {}", full_path(path_idx + 1))};
       }
-      if (!result.get().HasMember(member)) {
-        return std::unexpected{fmt::format("Object does not have member '{}' at {}", member, full_path)};
+      auto member_it = result.get().FindMember(member);
+      if (member_it == result.get().MemberEnd()) {
+        return std::unexpected{fmt::format("Object does not have member '{}' at {}", member, full_path(path_idx + 1))};
       }
-      result = result.get()[member];
+      result = member_it->value;
     } else if (type == Spec::MemberType::INDEX) {
       size_t idx = std::stoull(member);
-      full_path += "[" + member + "]";
       if (!result.get().IsArray()) {
-        return std::unexpected{fmt::format("Expected array at {}", full_path)};
+        return std::unexpected{fmt::format("Expected array at {}", full_path(path_idx + 1))};
       }
       if (result.get().Size() <= idx) {
-        return std::unexpected{fmt::format("Array of size {} does not have item at index {}  at {}", result.get().Size(), idx, full_path)};
+        return std::unexpected{fmt::format("Array of size {} does not have item at index {}  at {}", result.get().Size(), idx, full_path(path_idx + 1))};
       }
       result = result.get()[gsl::narrow<rapidjson::SizeType>(idx)];
     }
@@ -1014,7 +1028,7 @@ bool Spec::Pattern::processMember(const Context& ctx, std::string_view name, con
   }, [&] (const auto& logger) {
     logger->log_trace("Finished processing member '{}' of {}", name, ctx.path());
   });
-  if (auto it = literal_indices.find(std::string{name}); it != literal_indices.end()) {
+  if (auto it = literal_indices.find(name); it != literal_indices.end()) {
     // literal is matched
     Context new_ctx = ctx.extend({name}, &member);
     process(std::get<2>(literals.at(it->second)), new_ctx, member, output);
@@ -1048,10 +1062,11 @@ void Spec::Pattern::processArray(const Context& ctx, const rapidjson::Value &inp
     }
   }
   for (rapidjson::SizeType  i = 0; i < input.GetArray().Size(); ++i) {
-    if (literal_indices.contains(std::to_string(i))) {
+    const auto index = std::to_string(i);
+    if (literal_indices.contains(index)) {
       continue;
     }
-    if (processMember(sub_ctx, std::to_string(i), input[i], output)) {
+    if (processMember(sub_ctx, index, input[i], output)) {
       ++sub_ctx.match_count;
     }
   }
@@ -1061,17 +1076,18 @@ void Spec::Pattern::processObject(const Context& ctx, const rapidjson::Value &in
   gsl_Expects(input.IsObject());
   Context sub_ctx = ctx;
   for (auto& [key, numeric_key, value] : literals) {
-    if (input.GetObject().HasMember(key)) {
-      if (processMember(sub_ctx, key, input[key], output)) {
+    if (auto member_it = input.FindMember(key); member_it != input.MemberEnd()) {
+      if (processMember(sub_ctx, key, member_it->value, output)) {
         ++sub_ctx.match_count;
       }
     }
   }
   for (auto& [name, member] : input.GetObject()) {
-    if (literal_indices.contains(std::string{name.GetString(), name.GetStringLength()})) {
+    const std::string_view name_view{name.GetString(), name.GetStringLength()};
+    if (literal_indices.contains(name_view)) {
       continue;
     }
-    if (processMember(sub_ctx, std::string_view{name.GetString(), name.GetStringLength()}, member, output)) {
+    if (processMember(sub_ctx, name_view, member, output)) {
       ++sub_ctx.match_count;
     }
   }
@@ -1092,7 +1108,7 @@ void Spec::Pattern::process(const Context& ctx, const rapidjson::Value &input, r
     if (!target->node) {
       return;
     }
-    if (auto value = resolvePath(ctx, target->path(), *target->node, path)) {
+    if (auto value = resolvePath(ctx, *target, *target->node, path)) {
       Context sub_ctx = ctx.extend(ctx.matches, ctx.node);
       process(dest, sub_ctx, value.value(), output);
     } else {
@@ -1130,7 +1146,19 @@ void Spec::Pattern::process(const Context& ctx, const rapidjson::Value &input, r
 }
 
 std::expected<rapidjson::Document, std::string> Spec::process(const rapidjson::Value &input, std::shared_ptr<core::logging::Logger> logger) const {
-  rapidjson::Document output;
+  return processInto(rapidjson::Document{}, input, std::move(logger));
+}
+
+std::expected<rapidjson::Document, std::string> Spec::process(const rapidjson::Value &input, rapidjson::Document::AllocatorType& allocator,
+    std::shared_ptr<core::logging::Logger> logger) const {
+  return processInto(rapidjson::Document{&allocator}, input, std::move(logger));
+}
+
+std::expected<rapidjson::Document, std::string> Spec::processInto(rapidjson::Document output, const rapidjson::Value &input, std::shared_ptr<core::logging::Logger> logger) const {
+  // the trace messages build the path of every visited node, so the logger is only passed on if they are going to be logged
+  if (logger && !logger->should_log(core::logging::LOG_LEVEL::trace)) {
+    logger.reset();
+  }
   try {
     value_->process(Context{.matches = {"root"}, .node = &input, .logger = std::move(logger)}, input, output);
     return output;
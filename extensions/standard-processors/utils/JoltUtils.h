@@ -184,7 +184,7 @@ class Spec {
     void processObject(const Context& ctx, const rapidjson::Value &input, rapidjson::Document &output) const;
     bool processMember(const Context& ctx, std::string_view name, const rapidjson::Value& member, rapidjson::Document& output) const;
 
-    std::unordered_map<std::string, size_t> literal_indices;
+    std::unordered_map<std::string, size_t, utils::string::transparent_string_hash, std::equal_to<>> literal_indices;
     std::vector<std::tuple<std::string, std::optional<size_t>, Value>> literals;
 
     std::map<Template, Value> templates;  // '&'
@@ -197,10 +197,14 @@ class Spec {
   static std::expected<Spec, std::string> parse(std::string_view str, std::shared_ptr<core::logging::Logger> logger = {});
 
   std::expected<rapidjson::Document, std::string> process(const rapidjson::Value& input, std::shared_ptr<core::logging::Logger> logger = {}) const;
+  // the output document allocates from the given allocator, so its memory can be reused after the document is destroyed
+  std::expected<rapidjson::Document, std::string> process(const rapidjson::Value& input, rapidjson::Document::AllocatorType& allocator, std::shared_ptr<core::logging::Logger> logger = {}) const;
 
  private:
   explicit Spec(std::unique_ptr<Pattern> value): value_(std::move(value)) {}
 
+  std::expected<rapidjson::Document, std::string> processInto(rapidjson::Document output, const rapidjson::Value& input, std::shared_ptr<core::logging::Logger> logger) const;
+
   std::unique_ptr<Pattern> value_;
 };
 
@@ -0,0 +1,230 @@
+/**
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The ASF licenses this file to You under the Apache License, Version 2.0
+ * (the "License"); you may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "JsonPathUtils.h"
+
+#include <algorithm>
+#include <cctype>
+#include <charconv>
+#include <utility>
+
+#include "jsoncons/json_cursor.hpp"
+#include "minifi-cpp/utils/gsl.h"
+
+namespace org::apache::nifi::minifi::utils::json_path {
+
+namespace {
+bool isNameCharacter(char c) {
+  return std::isalnum(static_cast<unsigned char>(c)) || c == '_';
+}
+
+// jsoncons applies numeric member names and 'length' to arrays as well, these are left to the full evaluation
+bool isUnambiguousName(std::string_view name) {
+  return !name.empty() && name != "length" && !std::all_of(name.begin(), name.end(), [](char c) { return std::isdigit(static_cast<unsigned char>(c)); });
+}
+}  // namespace
+
+std::optional<std::vector<PathStep>> parseSimplePath(std::string_view path) {
+  if (path.empty() || path.front() != '$') {
+    return std::nullopt;
+  }
+  std::vector<PathStep> steps;
+  size_t pos = 1;
+  while (pos < path.size()) {
+    if (path[pos] == '.') {
+      const auto end = gsl::narrow<size_t>(std::find_if_not(path.begin() + gsl::narrow<std::ptrdiff_t>(pos) + 1, path.end(), isNameCharacter) - path.begin());
+      const auto name = path.substr(pos + 1, end - pos - 1);
+      if (!isUnambiguousName(name)) {
+        return std::nullopt;
+      }
+      steps.emplace_back(std::string(name));
+      pos = end;
+    } else if (path[pos] == '[' && pos + 1 < path.size() && (path[pos + 1] == '\'' || path[pos + 1] == '"')) {
+      const char quote = path[pos + 1];
+      const auto end = path.find(quote, pos + 2);
+      if (end == std::string_view::npos || end + 1 >= path.size() || path[end + 1] != ']') {
+        return std::nullopt;
+      }
+      const auto name = path.substr(pos + 2, end - pos - 2);
+      if (!isUnambiguousName(name) || name.find('\\') != std::string_view::npos) {
+        return std::nullopt;
+      }
+      steps.emplace_back(std::string(name));
+      pos = end + 2;
+    } else if (path[pos] == '[') {
+      const auto end = path.find(']', pos);
+      if (end == std::string_view::npos) {
+        return std::nullopt;
+      }
+      size_t index = 0;
+      const auto digits = path.substr(pos + 1, end - pos - 1);
+      const auto [ptr, ec] = std::from_chars(digits.data(), digits.data() + digits.size(), index);
+      if (digits.empty() || ec != std::errc{} || ptr != digits.data() + digits.size()) {
+        return std::nullopt;
+      }
+      steps.emplace_back(index);
+      pos = end + 1;
+    } else {
+      return std::nullopt;
+    }
+  }
+  return steps;
+}
+
+StreamingEvaluator::StreamingEvaluator(const std::vector<std::vector<PathStep>>& paths) : path_count_(paths.size()) {
+  for (size_t path_index = 0; path_index < paths.size(); ++path_index) {
+    Node* node = &root_;
+    node->subtree_paths.push_back(path_index);
+    for (const auto& step : paths[path_index]) {
+      auto& child = std::holds_alternative<std::string>(step) ? node->members[std::get<std::string>(step)] : node->elements[std::get<size_t>(step)];
+      if (!child) {
+        child = std::make_unique<Node>();
+      }
+      node = child.get();
+      node->subtree_paths.push_back(path_index);
+    }
+    node->paths.push_back(path_index);
+  }
+}
+
+class StreamingEvaluator::Evaluation {
+ public:
+  explicit Evaluation(size_t path_count) : results_(path_count, jsoncons::json(jsoncons::json_array_arg)), resolved_(path_count, false), remaining_(path_count) {}
+
+  [[nodiscard]] bool isPending(const Node& node) const {
+    return std::any_of(node.subtree_paths.begin(), node.subtree_paths.end(), [this](size_t path) { return !resolved_[path]; });
+  }
+
+  // the value of the node is known, so every path ending at or below it can be answered from the value
+  void resolve(const Node& node, const jsoncons::json& value) {
+    for (const auto path : node.paths) {
+      results_[path].push_back(value);
+    }
+    if (value.is_object()) {
+      for (const auto& [name, child] : node.members) {
+        if (value.contains(name)) {
+          resolve(*child, value.at(name));
+        }
+      }
+    } else if (value.is_array()) {
+      for (const auto& [index, child] : node.elements) {
+        if (index < value.size()) {
+          resolve(*child, value[index]);
+        }
+      }
+    }
+    finish(node);
+  }
+
+  // the paths ending at or below the node that are not resolved yet do not exist in the document
+  void finish(const Node& node) {
+    for (const auto path : node.subtree_paths) {
+      if (!resolved_[path]) {
+        resolved_[path] = true;
+        --remaining_;
+      }
+    }
+  }
+
+  [[nodiscard]] bool isComplete() const { return remaining_ == 0; }
+
+  std::vector<jsoncons::json> release() { return std::move(results_); }
+
+ private:
+  std::vector<jsoncons::json> results_;
+  std::vector<bool> resolved_;
+  size_t remaining_;
+};
+
+std::vector<jsoncons::json> StreamingEvaluator::evaluate(std::istream& input) const {
+  struct Frame {
+    const Node* node;
+    bool is_array;
+    size_t next_index = 0;
+    const Node* member = nullptr;  // the node of the member whose key was read last
+  };
+
+  const auto skip_value = [](jsoncons::json_stream_cursor& cursor) {
+    size_t depth = 0;
+    do {
+      switch (cursor.current().event_type()) {
+        case jsoncons::staj_event_type::begin_object:
+        case jsoncons::staj_event_type::begin_array:
+          ++depth;
+          break;
+        case jsoncons::staj_event_type::end_object:
+        case jsoncons::staj_event_type::end_array:
+          --depth;
+          break;
+        default:
+          break;
+      }
+      if (depth > 0) {
+        cursor.next();
+      }
+    } while (depth > 0);
+  };
+
+  const auto find_child = [](const auto& children, const auto& key) -> const Node* {
+    const auto it = children.find(key);
+    return it == children.end() ? nullptr : it->second.get();
+  };
+
+  Evaluation evaluation(path_count_);
+  std::vector<Frame> frames;
+  jsoncons::json_stream_cursor cursor(input);
+  while (!evaluation.isComplete() && !cursor.done()) {
+    const auto event_type = cursor.current().event_type();
+    if (event_type == jsoncons::staj_event_type::key) {
+      frames.back().member = find_child(frames.back().node->members, cursor.current().get<std::string_view>());
+      cursor.next();
+      continue;
+    }
+    if (event_type == jsoncons::staj_event_type::end_object || event_type == jsoncons::staj_event_type::end_array) {
+      evaluation.finish(*frames.back().node);
+      frames.pop_back();
+      cursor.next();
+      continue;
+    }
+
+    const Node* node = nullptr;
+    if (frames.empty()) {
+      node = &root_;
+    } else if (frames.back().is_array) {
+      node = find_child(frames.back().node->elements, frames.back().next_index++);
+    } else {
+      node = std::exchange(frames.back().member, nullptr);
+    }
+
+    const bool is_container = event_type == jsoncons::staj_event_type::begin_object || event_type == jsoncons::staj_event_type::begin_array;
+    if (!node || !evaluation.isPending(*node)) {
+      skip_value(cursor);
+    } else if (!node->paths.empty()) {
+      jsoncons::json_decoder<jsoncons::json> decoder;
+      cursor.read_to(decoder);
+      evaluation.resolve(*node, decoder.get_result());
+    } else if (is_container) {
+      frames.push_back(Frame{.node = node, .is_array = event_type == jsoncons::staj_event_type::begin_array});
+    } else {
+      evaluation.finish(*node);
+    }
+    cursor.next();
+  }
+  return evaluation.release();
+}
+
+}  // namespace org::apache::nifi::minifi::utils::json_path
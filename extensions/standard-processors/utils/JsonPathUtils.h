@@ -0,0 +1,73 @@
+/**
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The ASF licenses this file to You under the Apache License, Version 2.0
+ * (the "License"); you may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <functional>
+#include <istream>
+#include <map>
+#include <memory>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <variant>
+#include <vector>
+
+#include "jsoncons/json.hpp"
+
+namespace org::apache::nifi::minifi::utils::json_path {
+
+// a member name or an array index
+using PathStep = std::variant<std::string, size_t>;
+
+/**
+ * Parses JSONPath expressions consisting only of member names and non-negative array indices, e.g. $.header.id, $['header'][0] or $.
+ * Returns std::nullopt for anything else (wildcards, filters, slices, recursive descent, ...), those need to be evaluated on the whole document.
+ */
+std::optional<std::vector<PathStep>> parseSimplePath(std::string_view path);
+
+/**
+ * Evaluates simple paths while the JSON document is parsed from the stream, without building the document in memory.
+ * Only the values selected by the paths are decoded, and the parsing stops as soon as the result of every path is known,
+ * so the remainder of the document is neither read nor validated.
+ */
+class StreamingEvaluator {
+ public:
+  explicit StreamingEvaluator(const std::vector<std::vector<PathStep>>& paths);
+
+  /**
+   * Returns the result of each path in the same form as jsoncons::jsonpath::json_query: an array containing the selected value,
+   * or an empty array if the path does not exist in the document.
+   * Throws jsoncons::json_exception if the document is invalid up to the point where the parsing stops.
+   */
+  [[nodiscard]] std::vector<jsoncons::json> evaluate(std::istream& input) const;
+
+ private:
+  struct Node {
+    std::map<std::string, std::unique_ptr<Node>, std::less<>> members;
+    std::map<size_t, std::unique_ptr<Node>> elements;
+    std::vector<size_t> paths;  // the paths ending at this node
+    std::vector<size_t> subtree_paths;  // the paths ending at this node or below it
+  };
+
+  class Evaluation;
+
+  Node root_;
+  size_t path_count_;
+};
+
+}  // namespace org::apache::nifi::minifi::utils::json_path
@@ -0,0 +1,122 @@
+/**
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The ASF licenses this file to You under the Apache License, Version 2.0
+ * (the "License"); you may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <span>
+
+#include "minifi-cpp/io/InputStream.h"
+#include "minifi-cpp/io/OutputStream.h"
+#include "rapidjson/rapidjson.h"
+
+namespace org::apache::nifi::minifi::utils::json {
+
+constexpr size_t STREAM_BUFFER_SIZE = 64 * 1024;
+
+/**
+ * rapidjson input stream reading an io::InputStream through a buffer, so documents can be parsed without reading the whole content.
+ * The end of the stream and read errors are both seen as '\0' by the parser, failed() tells them apart.
+ */
+class InputStreamJsonSource {
+ public:
+  using Ch = char;
+
+  explicit InputStreamJsonSource(io::InputStream& stream) : stream_(stream) {
+    fill();
+  }
+
+  [[nodiscard]] Ch Peek() const { return position_ < size_ ? buffer_[position_] : '\0'; }
+
+  Ch Take() {
+    if (position_ >= size_) {
+      return '\0';
+    }
+    const Ch c = buffer_[position_++];
+    ++offset_;
+    if (position_ == size_) {
+      fill();
+    }
+    return c;
+  }
+
+  [[nodiscard]] size_t Tell() const { return offset_; }
+
+  Ch* PutBegin() { RAPIDJSON_ASSERT(false); return nullptr; }
+  void Put(Ch) { RAPIDJSON_ASSERT(false); }
+  void Flush() { RAPIDJSON_ASSERT(false); }
+  size_t PutEnd(Ch*) { RAPIDJSON_ASSERT(false); return 0; }
+
+  [[nodiscard]] bool failed() const { return failed_; }
+
+ private:
+  void fill() {
+    position_ = 0;
+    size_ = 0;
+    if (failed_) {
+      return;
+    }
+    const auto read_result = stream_.read(std::as_writable_bytes(std::span(buffer_)));
+    if (io::isError(read_result)) {
+      failed_ = true;
+      return;
+    }
+    size_ = read_result;
+  }
+
+  io::InputStream& stream_;
+  std::array<Ch, STREAM_BUFFER_SIZE> buffer_{};
+  size_t position_ = 0;
+  size_t size_ = 0;
+  size_t offset_ = 0;
+  bool failed_ = false;
+};
+
+/**
+ * rapidjson output stream writing to an io::OutputStream through a buffer, the buffer is written out by Flush().
+ */
+class OutputStreamJsonSink {
+ public:
+  using Ch = char;
+
+  explicit OutputStreamJsonSink(io::OutputStream& stream) : stream_(stream) {}
+
+  void Put(Ch c) {
+    if (size_ == buffer_.size()) {
+      Flush();
+    }
+    buffer_[size_++] = c;
+  }
+
+  void Flush() {
+    if (size_ > 0 && !failed_) {
+      failed_ = io::isError(stream_.write(std::as_bytes(std::span(buffer_.data(), size_))));
+    }
+    size_ = 0;
+  }
+
+  [[nodiscard]] bool failed() const { return failed_; }
+
+ private:
+  io::OutputStream& stream_;
+  std::array<Ch, STREAM_BUFFER_SIZE> buffer_{};
+  size_t size_ = 0;
+  bool failed_ = false;
+};
+
+}  // namespace org::apache::nifi::minifi::utils::json
@@ -23,10 +23,10 @@
 #include <mutex>
 #include <stack>
 #include <string>
+#include <unordered_map>
 #include <utility>
 #include <vector>
 
-#include "concurrentqueue.h"
 #include "core/ClassLoader.h"
 #include "core/ProcessSession.h"
 #include "core/ProcessorImpl.h"
@@ -37,7 +37,9 @@
 #include "minifi-cpp/core/PropertyDefinition.h"
 #include "minifi-cpp/core/RelationshipDefinition.h"
 #include "minifi-cpp/utils/Export.h"
+#include "sitetosite/PeerSelector.h"
 #include "sitetosite/SiteToSiteClient.h"
+#include "utils/ThreadPool.h"
 
 namespace org::apache::nifi::minifi {
 
@@ -59,7 +61,7 @@ class RemoteProcessGroupPort : public core::ProcessorImpl {
         transmitting_(false),
         protocol_uuid_(uuid),
         client_type_(sitetosite::ClientType::RAW),
-        peer_index_(-1) {
+        peer_selector_(direction) {
     // REST API port and host
     setURL(std::move(url));
   }
@@ -82,10 +84,45 @@ class RemoteProcessGroupPort : public core::ProcessorImpl {
           .withDefaultValue("15 s")
           .build();
 
-  MINIFIAPI static constexpr auto Properties = std::to_array<core::PropertyReference>({hostName, SSLContext, port, portUUID, idleTimeout});
+  MINIFIAPI static constexpr auto PeerRefreshInterval =
+      core::PropertyDefinitionBuilder<>::createProperty("Peer Refresh Interval")
+          .withDescription("How often the peer list and the queued flow file counts of the peers are refreshed from the remote instance. "
+              "The flow file counts are used to direct more traffic to less loaded peers.")
+          .isRequired(true)
+          .withValidator(core::StandardPropertyValidators::TIME_PERIOD_VALIDATOR)
+          .withDefaultValue("1 min")
+          .build();
+  MINIFIAPI static constexpr auto MaxParallelTransactions =
+      core::PropertyDefinitionBuilder<>::createProperty("Max Parallel Transactions")
+          .withDescription("The maximum number of transactions sending to different peers concurrently in a single trigger. "
+              "If greater than 1, the batch taken from the incoming queue is split between the transactions. Only applies to sending.")
+          .isRequired(true)
+          .withValidator(core::StandardPropertyValidators::UNSIGNED_INTEGER_VALIDATOR)
+          .withDefaultValue("1")
+          .build();
+
+  MINIFIAPI static constexpr auto CompressionCodec =
+      core::PropertyDefinitionBuilder<sitetosite::COMPRESSION_CODEC_NAMES.size()>::createProperty("Compression Codec")
+          .withDescription("The codec used when compression is enabled for the port. Codecs other than zlib are negotiated with the peer, "
+              "if the peer does not support the codec, zlib is used.")
+          .isRequired(true)
+          .withAllowedValues(sitetosite::COMPRESSION_CODEC_NAMES)
+          .withDefaultValue("zlib")
+          .build();
+  MINIFIAPI static constexpr auto CompressionParallelism =
+      core::PropertyDefinitionBuilder<>::createProperty("Compression Parallelism")
+          .withDescription("The number of 64 KB blocks compressed concurrently when sending with compression enabled.")
+          .isRequired(true)
+          .withValidator(core::StandardPropertyValidators::UNSIGNED_INTEGER_VALIDATOR)
+          .withDefaultValue("1")
+          .build();
+
+  MINIFIAPI static constexpr auto Properties = std::to_array<core::PropertyReference>({hostName, SSLContext, port, portUUID, idleTimeout, PeerRefreshInterval,
+      MaxParallelTransactions, CompressionCodec, CompressionParallelism});
 
   MINIFIAPI static constexpr auto DefaultRelationship = core::RelationshipDefinition{"undefined", ""};
   MINIFIAPI static constexpr auto Relationships = std::array{DefaultRelationship};
+  MINIFIAPI static constexpr auto Self = core::RelationshipDefinition{"__self__", "Marks the FlowFile to be owned by this processor"};
 
   MINIFIAPI static constexpr bool SupportsDynamicProperties = false;
   MINIFIAPI static constexpr bool SupportsDynamicRelationships = false;
@@ -97,6 +134,7 @@ class RemoteProcessGroupPort : public core::ProcessorImpl {
   void onSchedule(core::ProcessContext& context, core::ProcessSessionFactory& session_factory) override;
   void onTrigger(core::ProcessContext& context, core::ProcessSession& session) override;
   void initialize() override;
+  void restore(const std::shared_ptr<core::FlowFile>& flow_file) override;
 
   void setTimeout(std::chrono::milliseconds timeout) {
     timeout_ = timeout;
@@ -168,11 +206,21 @@ class RemoteProcessGroupPort : public core::ProcessorImpl {
 
  protected:
   std::optional<std::pair<std::string, uint16_t>> refreshRemoteSiteToSiteInfo();
-  void refreshPeerList();
+  // contacts the remote instance, must not be called while holding peer_mutex_
+  std::optional<std::vector<sitetosite::PeerStatus>> fetchPeerList();
+  // must be called while holding peer_mutex_
+  void updatePeerList(std::optional<std::vector<sitetosite::PeerStatus>> peers);
   std::unique_ptr<sitetosite::SiteToSiteClient> getNextProtocol();
+  std::unique_ptr<sitetosite::SiteToSiteClient> getProtocolForPeer(const sitetosite::PeerStatus& peer_status);
   void returnProtocol(core::ProcessContext& context, std::unique_ptr<sitetosite::SiteToSiteClient> protocol);
-
-  moodycamel::ConcurrentQueue<std::unique_ptr<sitetosite::SiteToSiteClient>> available_protocols_;
+  // the flow files of earlier failed transactions are taken first, these are also added to retried_flow_files
+  std::vector<sitetosite::FlowFileWithContent> getBatch(core::ProcessSession& session, std::vector<std::shared_ptr<core::FlowFile>>& retried_flow_files);
+  void transferInParallel(core::ProcessContext& context, core::ProcessSession& session);
+  bool hasFailedFlowFiles();
+
+  // idle clients, keyed by the URL of the peer they are connected to
+  std::unordered_map<std::string, std::vector<std::unique_ptr<sitetosite::SiteToSiteClient>>> available_protocols_;
+  size_t available_protocol_count_ = 0;
   std::shared_ptr<Configure> configure_;
   const sitetosite::TransferDirection direction_;
   std::atomic<bool> transmitting_;
@@ -183,22 +231,35 @@ class RemoteProcessGroupPort : public core::ProcessorImpl {
   std::vector<RPG> nifi_instances_;
   http::HTTPProxy proxy_;
   sitetosite::ClientType client_type_;
-  std::vector<sitetosite::PeerStatus> peers_;
-  int64_t peer_index_;
+  sitetosite::PeerSelector peer_selector_;
+  std::chrono::milliseconds peer_refresh_interval_ = 1min;
+  uint64_t max_parallel_transactions_ = 1;
   std::mutex peer_mutex_;
+  std::atomic<bool> peer_refresh_in_progress_{false};
   std::shared_ptr<controllers::SSLContextServiceInterface> ssl_service_;
   bool use_compression_{false};
+  sitetosite::CompressionCodec compression_codec_{sitetosite::CompressionCodec::ZLIB};
+  size_t compression_parallelism_{1};
   std::optional<uint64_t> batch_count_;
   std::optional<uint64_t> batch_size_;
   std::optional<std::chrono::milliseconds> batch_duration_;
+  // the flow files of failed parallel transactions, owned by the processor until a later trigger sends them
+  std::mutex failed_flow_files_mutex_;
+  std::vector<std::shared_ptr<core::FlowFile>> failed_flow_files_;
+  // runs the parallel transactions of the triggers, except the one run by the triggering thread
+  utils::ThreadPool transaction_pool_{1, "RemoteProcessGroupPortTransactions"};
 
  private:
   gsl::not_null<std::unique_ptr<sitetosite::SiteToSiteClient>> initializeProtocol(sitetosite::SiteToSiteClientConfiguration& config) const;
+  gsl::not_null<std::unique_ptr<sitetosite::SiteToSiteClient>> initializeProtocol(const sitetosite::PeerStatus& peer_status) const;
+  void refreshPeerListIfNeeded();
   [[nodiscard]] std::optional<std::string> getRestApiToken(const RPG& nifi) const;
   std::optional<std::pair<std::string, uint16_t>> parseSiteToSiteDataFromControllerConfig(const RPG& nifi, const std::string& controller) const;
   std::optional<std::pair<std::string, uint16_t>> tryRefreshSiteToSiteInstance(RPG nifi) const;
 
   static const char* RPG_SSL_CONTEXT_SERVICE_NAME;
+  // upper limit of the flow files split between parallel transactions in a trigger when no batch count is configured
+  static constexpr uint64_t DEFAULT_PARALLEL_BATCH_COUNT = 500;
 };
 
 }  // namespace org::apache::nifi::minifi
@@ -69,6 +69,7 @@ class ProcessContextImpl : public core::VariableRegistryImpl, public virtual Pro
   std::expected<void, std::error_code> setProperty(std::string_view name, std::string value) override;
   std::expected<void, std::error_code> clearProperty(std::string_view name) override;
   std::expected<std::string, std::error_code> getDynamicProperty(std::string_view name, const FlowFile*) const override;
+  std::expected<std::vector<std::string>, std::error_code> getDynamicPropertyForEach(std::string_view name, std::span<const std::shared_ptr<FlowFile>> flow_files) const override;
   std::expected<void, std::error_code> setDynamicProperty(std::string name, std::string value) override;
   std::expected<std::string, std::error_code> getRawProperty(std::string_view name) const override;
   std::expected<std::string, std::error_code> getRawDynamicProperty(std::string_view name) const override;
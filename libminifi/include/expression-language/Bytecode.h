@@ -0,0 +1,99 @@
+/**
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The ASF licenses this file to You under the Apache License, Version 2.0
+ * (the "License"); you may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <memory>
+#include <span>
+#include <string>
+#include <vector>
+
+#include "expression-language/Expression.h"
+#include "expression-language/Value.h"
+
+namespace org::apache::nifi::minifi::expression::bytecode {
+
+enum class OpCode : uint8_t {
+  PushConstant,  // push constants[operand]
+  LoadAttribute,  // push the value of attributes[operand]
+  Call,  // pop arg_count values, push functions[operand](values)
+  Concat,  // pop arg_count values, push the concatenation of their string values
+  EvaluateTree  // push the value of trees[operand], used for the expressions that are not lowered to bytecode
+};
+
+struct Instruction {
+  OpCode op_code;
+  uint32_t operand = 0;
+  uint32_t arg_count = 0;
+};
+
+struct AttributeSlot {
+  std::string name;
+  bool cached = false;  // referenced more than once, so it is looked up only once per evaluation
+};
+
+/**
+ * Stack based bytecode program lowered from a parsed expression.
+ *
+ * Compilation folds the functions and concatenations with constant arguments, and resolves every attribute
+ * reference to a slot, so an attribute referenced multiple times is looked up only once per evaluation.
+ * The VM passes the function arguments as a span of the value stack, so no argument vectors are built.
+ * Multi-attribute functions (e.g. anyAttribute) are not lowered, they are evaluated by the tree walker.
+ */
+class Program {
+ public:
+  static Program compile(const Expression& expression);
+
+  Value run(const Parameters& params) const;
+
+  /**
+   * Runs the program for each of the flow files. The evaluation stack is reused across the batch, and an attribute
+   * that is not set on a flow file is looked up in the variable registry only once for the whole batch.
+   */
+  std::vector<Value> runBatch(const core::VariableRegistry* registry, std::span<const std::shared_ptr<core::FlowFile>> flow_files) const;
+
+  [[nodiscard]] std::span<const Instruction> getInstructions() const {
+    return instructions_;
+  }
+
+  [[nodiscard]] std::span<const AttributeSlot> getAttributeSlots() const {
+    return attributes_;
+  }
+
+  [[nodiscard]] size_t getMaxStackSize() const {
+    return max_stack_size_;
+  }
+
+ private:
+  friend class Compiler;
+
+  struct EvaluationState;
+
+  Value run(const Parameters& params, EvaluationState& state) const;
+  Value loadAttribute(const Parameters& params, uint32_t slot_index, EvaluationState& state) const;
+
+  std::vector<Instruction> instructions_;
+  std::vector<Value> constants_;
+  std::vector<AttributeSlot> attributes_;
+  std::vector<Function> functions_;
+  std::vector<Expression> trees_;
+  size_t max_stack_size_ = 0;
+  bool has_cached_attributes_ = false;
+};
+
+}  // namespace org::apache::nifi::minifi::expression::bytecode
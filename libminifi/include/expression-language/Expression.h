@@ -20,6 +20,8 @@
 #include <string>
 #include <memory>
 #include <functional>
+#include <span>
+#include <string_view>
 #include <utility>
 #include <vector>
 
@@ -41,6 +43,13 @@ struct Parameters {
 };
 
 class Expression;
+struct ExpressionNode;
+
+namespace bytecode {
+class Program;
+}  // namespace bytecode
+
+using Function = std::function<Value(std::span<const Value> args)>;
 
 static const std::function<Value(const Parameters &params, const std::vector<Expression> &sub_exprs)> NOOP_FN;
 
@@ -49,15 +58,9 @@ static const std::function<Value(const Parameters &params, const std::vector<Exp
  */
 class Expression {
  public:
-  Expression() : val_fn_(NOOP_FN) {
-  }
+  Expression();
 
-  explicit Expression(Value val, std::function<Value(const Parameters &, const std::vector<Expression> &)> val_fn = NOOP_FN)
-      : val_(val),
-        val_fn_(std::move(val_fn)),
-        is_multi_(false) {
-    sub_expr_generator_ = [](const Parameters& /*params*/) -> std::vector<Expression> {return {};};
-  }
+  explicit Expression(Value val, std::function<Value(const Parameters &, const std::vector<Expression> &)> val_fn = NOOP_FN);
 
   /**
    * Whether or not this expression is dynamic. If it is not dynamic, then
@@ -92,6 +95,16 @@ class Expression {
    */
   Value operator()(const Parameters &params) const;
 
+  /**
+   * Evaluate the expression for each of the flow files, giving the same results as evaluating it for them one by one.
+   * Compiled expressions reuse the state of the bytecode VM across the batch.
+   *
+   * @param registry variable registry consulted for the attributes missing from a flow file
+   * @param flow_files
+   * @return results in the order of the flow files
+   */
+  [[nodiscard]] std::vector<Value> evaluate_batch(const core::VariableRegistry* registry, std::span<const std::shared_ptr<core::FlowFile>> flow_files) const;
+
   /**
    * Turn this expression into a multi-expression which generates subexpressions dynamically.
    *
@@ -113,22 +126,72 @@ class Expression {
 
   Expression make_aggregate(const std::function<Value(const Parameters &params, const std::vector<Expression> &sub_exprs)>& val_fn) const;
 
+  /**
+   * The node describing how the parser built this expression, used to lower it into bytecode.
+   * Multi-expressions and aggregates have no node, they are only evaluated by the tree walker.
+   */
+  [[nodiscard]] const ExpressionNode* node() const {
+    return node_.get();
+  }
+
+  void set_node(std::shared_ptr<const ExpressionNode> node) {
+    node_ = std::move(node);
+  }
+
+  /**
+   * Evaluates the expression by walking the expression tree, even if it was compiled to bytecode.
+   * This is the reference implementation the bytecode VM is tested against.
+   */
+  [[nodiscard]] Value evaluate_tree(const Parameters &params) const;
+
+  friend Expression compile(const std::string &expr_str);
+
  protected:
+  Expression concatenate(const Expression &other_expr) const;
+
   Value val_;
   std::function<Value(const Parameters &params, const std::vector<Expression> &sub_exprs)> val_fn_;
   std::vector<Expression> fn_args_;
   std::function<std::vector<Expression>(const Parameters &params)> sub_expr_generator_;
-  bool is_multi_;
+  bool is_multi_ = false;
+  std::shared_ptr<const ExpressionNode> node_;
+  std::shared_ptr<const bytecode::Program> program_;
+};
+
+struct ExpressionNode {
+  enum class Type {
+    Constant,
+    Attribute,
+    Function,
+    Concat
+  };
+
+  Type type;
+  Value value;  // Constant
+  std::string name;  // Attribute, Function
+  Function function;  // Function
+  bool pure = true;  // Function: the same arguments always give the same result, so calls with constant arguments can be folded
+  std::vector<Expression> args;  // Function, Concat
 };
 
 /**
  * Compiles an expression from a string in the NiFi expression language syntax.
+ * The expression is lowered to bytecode and evaluated by the bytecode VM.
  *
  * @param expr_str
  * @return
  */
 Expression compile(const std::string &expr_str);
 
+/**
+ * Compiles an expression from a string in the NiFi expression language syntax
+ * without lowering it to bytecode, the expression is evaluated by walking the expression tree.
+ *
+ * @param expr_str
+ * @return
+ */
+Expression compile_tree(const std::string &expr_str);
+
 /**
  * Creates a string expression that is not dynamic.
  *
@@ -153,6 +216,11 @@ Expression make_dynamic(const std::function<Value(const Parameters &params, cons
  */
 Expression make_dynamic_attr(const std::string &attribute_id);
 
+/**
+ * Looks up the attribute in the flow file, or in the variable registry if the flow file does not have it.
+ */
+Value resolve_attribute(const Parameters &params, std::string_view attribute_id);
+
 /**
  * Creates a dynamic expression which evaluates the given function as defined
  * in NiFi expression language.
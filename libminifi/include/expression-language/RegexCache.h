@@ -0,0 +1,100 @@
+/**
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The ASF licenses this file to You under the Apache License, Version 2.0
+ * (the "License"); you may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <functional>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <utility>
+
+namespace org::apache::nifi::minifi::expression::regex {
+
+enum class Engine {
+  Standard,  // utils::Regex for matching and std::regex for replacing, both may backtrack
+  Linear  // utils::LinearRegex, patterns it does not support fall back to the standard engine
+};
+
+/**
+ * Compiled pattern of the Expression Language regular expression functions.
+ * It is immutable after construction, so it can be shared between threads.
+ */
+class CompiledRegex {
+ public:
+  virtual ~CompiledRegex() = default;
+
+  [[nodiscard]] virtual bool matches(std::string_view subject) const = 0;
+  [[nodiscard]] virtual bool find(std::string_view subject) const = 0;
+  [[nodiscard]] virtual std::string replace(std::string_view subject, std::string_view replacement, bool first_only) const = 0;
+};
+
+std::shared_ptr<const CompiledRegex> compile(std::string pattern, Engine engine, bool case_insensitive = false);
+
+/**
+ * Process-wide cache of compiled patterns keyed by the pattern and its flags, the least recently used pattern is evicted when it is full.
+ * Changing the engine clears the cache, the already parsed expressions keep using the patterns they have compiled.
+ */
+class RegexCache {
+ public:
+  static constexpr size_t DEFAULT_CAPACITY = 256;
+
+  static RegexCache& getInstance();
+
+  std::shared_ptr<const CompiledRegex> get(std::string_view pattern, bool case_insensitive = false);
+
+  void setEngine(Engine engine);
+  [[nodiscard]] Engine getEngine() const;
+
+  void setCapacity(size_t capacity);
+  [[nodiscard]] size_t size() const;
+  void clear();
+
+ private:
+  struct Key {
+    std::string_view pattern;  // points into the pattern owned by the list entry
+    bool case_insensitive;
+
+    bool operator==(const Key&) const = default;
+  };
+
+  struct KeyHash {
+    size_t operator()(const Key& key) const {
+      return std::hash<std::string_view>{}(key.pattern) * 31 + static_cast<size_t>(key.case_insensitive);
+    }
+  };
+
+  struct Entry {
+    std::string pattern;
+    bool case_insensitive;
+    std::shared_ptr<const CompiledRegex> regex;
+  };
+
+  void evict();
+
+  mutable std::mutex mutex_;
+  Engine engine_ = Engine::Standard;
+  size_t capacity_ = DEFAULT_CAPACITY;
+  std::list<Entry> entries_;  // most recently used first
+  std::unordered_map<Key, std::list<Entry>::iterator, KeyHash> index_;
+};
+
+}  // namespace org::apache::nifi::minifi::expression::regex
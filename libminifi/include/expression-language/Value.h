@@ -57,6 +57,9 @@ class Value {
     }, value_);
   }
 
+  /// The held string if this is a string value, allows reading it without a copy
+  [[nodiscard]] const std::string* getString() const { return std::get_if<std::string>(&value_); }
+
   void setSignedLong(int64_t val) { value_ = val; }
   void setUnsignedLong(uint64_t val) { value_ = val; }
   void setLongDouble(long double val) { value_ = val; }
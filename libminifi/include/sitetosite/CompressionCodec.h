@@ -0,0 +1,58 @@
+/**
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The ASF licenses this file to You under the Apache License, Version 2.0
+ * (the "License"); you may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <optional>
+#include <span>
+#include <string_view>
+#include <vector>
+
+#include "CompressionConsts.h"
+
+namespace org::apache::nifi::minifi::sitetosite {
+
+/**
+ * Codec used for the blocks of a compressed Site-to-Site stream. The block framing is the same for every codec,
+ * only ZLIB is understood by NiFi, the others have to be negotiated with the peer before use.
+ */
+enum class CompressionCodec {
+  ZLIB,
+  LZ4,
+  ZSTD
+};
+
+inline constexpr std::array<std::string_view, 3> COMPRESSION_CODEC_NAMES{"zlib", "lz4", "zstd"};
+
+std::optional<CompressionCodec> parseCompressionCodec(std::string_view name);
+std::string_view compressionCodecName(CompressionCodec codec);
+
+/**
+ * Compresses a single block of at most COMPRESSION_BUFFER_SIZE bytes.
+ * @return the compressed block, or std::nullopt on failure
+ */
+std::optional<std::vector<std::byte>> compressBlock(CompressionCodec codec, std::span<const std::byte> block);
+
+/**
+ * Decompresses a single block into the output buffer, which has to be exactly as large as the original block.
+ * @return true if the block was decompressed to the expected size
+ */
+bool decompressBlock(CompressionCodec codec, std::span<const std::byte> compressed_block, std::span<std::byte> output);
+
+}  // namespace org::apache::nifi::minifi::sitetosite
@@ -23,6 +23,8 @@
 namespace org::apache::nifi::minifi::sitetosite {
 
 inline constexpr size_t COMPRESSION_BUFFER_SIZE = 65536;
+// upper bound of a compressed block for every supported codec, incompressible data grows slightly
+inline constexpr size_t MAX_COMPRESSED_BLOCK_SIZE = COMPRESSION_BUFFER_SIZE + COMPRESSION_BUFFER_SIZE / 128 + 1024;
 inline constexpr std::array<char, 4> SYNC_BYTES = { 'S', 'Y', 'N', 'C' };
 
 }  // namespace org::apache::nifi::minifi::sitetosite
@@ -19,6 +19,7 @@
 
 #include "io/InputStream.h"
 #include "io/BufferStream.h"
+#include "CompressionCodec.h"
 #include "CompressionConsts.h"
 #include "core/logging/LoggerFactory.h"
 
@@ -26,8 +27,9 @@ namespace org::apache::nifi::minifi::sitetosite {
 
 class CompressionInputStream : public io::InputStreamImpl {
  public:
-  explicit CompressionInputStream(io::InputStream& internal_stream)
-      : internal_stream_(internal_stream) {
+  explicit CompressionInputStream(io::InputStream& internal_stream, CompressionCodec codec = CompressionCodec::ZLIB)
+      : codec_(codec),
+        internal_stream_(internal_stream) {
   }
 
   using io::InputStream::read;
@@ -42,9 +44,11 @@ class CompressionInputStream : public io::InputStreamImpl {
  private:
   size_t decompressData();
 
+  CompressionCodec codec_;
   bool eof_{false};
   io::InputStream& internal_stream_;
   std::vector<std::byte> buffer_{COMPRESSION_BUFFER_SIZE};
+  std::vector<std::byte> compressed_buffer_{MAX_COMPRESSED_BLOCK_SIZE};
   size_t buffer_offset_{0};
   size_t buffered_data_length_{0};
   std::shared_ptr<core::logging::Logger> logger_ = core::logging::LoggerFactory<CompressionInputStream>::getLogger();
@@ -17,17 +17,32 @@
  */
 #pragma once
 
+#include <algorithm>
+#include <memory>
+#include <optional>
+#include <span>
+#include <vector>
+
 #include "io/OutputStream.h"
 #include "io/BaseStream.h"
+#include "CompressionCodec.h"
 #include "CompressionConsts.h"
 #include "core/logging/LoggerFactory.h"
+#include "utils/OrderedTaskPool.h"
 
 namespace org::apache::nifi::minifi::sitetosite {
 
+/**
+ * Writes data in the NiFi Site-to-Site compressed framing: blocks of at most COMPRESSION_BUFFER_SIZE bytes, each compressed independently.
+ * With a parallelism greater than 1, that many blocks are buffered and compressed concurrently, which keeps the output byte-for-byte
+ * identical to the sequential one.
+ */
 class CompressionOutputStream : public io::StreamImpl, public virtual io::OutputStreamImpl {
  public:
-  explicit CompressionOutputStream(io::OutputStream& internal_stream)
-      : internal_stream_(internal_stream) {
+  explicit CompressionOutputStream(io::OutputStream& internal_stream, CompressionCodec codec = CompressionCodec::ZLIB, size_t parallelism = 1)
+      : codec_(codec),
+        internal_stream_(internal_stream),
+        buffer_(COMPRESSION_BUFFER_SIZE * std::max<size_t>(parallelism, 1)) {
   }
 
   using io::OutputStream::write;
@@ -37,11 +52,15 @@ class CompressionOutputStream : public io::StreamImpl, public virtual io::Output
 
  private:
   size_t compressAndWrite();
+  size_t writeBlock(std::span<const std::byte> original_block, const std::vector<std::byte>& compressed_block);
 
+  CompressionCodec codec_;
   bool was_data_written_{false};
   size_t buffer_offset_{0};
   io::OutputStream& internal_stream_;
-  std::vector<std::byte> buffer_{COMPRESSION_BUFFER_SIZE};
+  std::vector<std::byte> buffer_;
+  // compresses all but the first block of the buffer, declared after the buffer, so the running tasks finish before it is destroyed
+  std::optional<utils::OrderedTaskPool<std::optional<std::vector<std::byte>>>> compressor_pool_;
   std::shared_ptr<core::logging::Logger> logger_ = core::logging::LoggerFactory<CompressionOutputStream>::getLogger();
 };
 
@@ -23,6 +23,7 @@
 #include <utility>
 #include <vector>
 #include "HTTPTransaction.h"
+#include "http/MultiHTTPClient.h"
 #include "sitetosite/SiteToSite.h"
 #include "sitetosite/SiteToSiteClient.h"
 #include "core/logging/LoggerConfiguration.h"
@@ -41,6 +42,7 @@ class HttpSiteToSiteClient final : public SiteToSiteClient {
   static constexpr char const* HANDSHAKE_PROPERTY_BATCH_COUNT = "x-nifi-site-to-site-batch-count";
   static constexpr char const* HANDSHAKE_PROPERTY_BATCH_SIZE = "x-nifi-site-to-site-batch-size";
   static constexpr char const* HANDSHAKE_PROPERTY_BATCH_DURATION = "x-nifi-site-to-site-batch-duration";
+  static constexpr char const* HANDSHAKE_PROPERTY_COMPRESSION_CODEC = "x-nifi-site-to-site-compression-codec";
 
   explicit HttpSiteToSiteClient(gsl::not_null<std::unique_ptr<SiteToSitePeer>> peer)
       : SiteToSiteClient(std::move(peer)),
@@ -92,6 +94,8 @@ class HttpSiteToSiteClient final : public SiteToSiteClient {
   std::optional<SiteToSiteResponse> readResponseForSendTransfer(const std::shared_ptr<Transaction>& transaction);
 
   ResponseCode current_code_;
+  // the requests of the transactions reuse the TLS sessions and DNS entries of the earlier requests to the peer
+  std::shared_ptr<http::HTTPConnectionShare> connection_share_ = std::make_shared<http::HTTPConnectionShare>();
   std::shared_ptr<core::logging::Logger> logger_ = core::logging::LoggerFactory<HttpSiteToSiteClient>::getLogger();
 };
 
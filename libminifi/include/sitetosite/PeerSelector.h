@@ -0,0 +1,80 @@
+/**
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The ASF licenses this file to You under the Apache License, Version 2.0
+ * (the "License"); you may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#pragma once
+
+#include <chrono>
+#include <optional>
+#include <random>
+#include <vector>
+
+#include "Peer.h"
+#include "SiteToSite.h"
+
+namespace org::apache::nifi::minifi::sitetosite {
+
+/**
+ * Chooses the peer for the next transaction based on the flow file counts reported by the remote cluster.
+ * When sending, peers with fewer queued flow files are preferred, when receiving, peers with more queued
+ * flow files are preferred. No peer is ever starved completely, so stale counts correct themselves.
+ * Not thread safe, callers are expected to synchronize access.
+ */
+class PeerSelector {
+ public:
+  explicit PeerSelector(TransferDirection direction, std::mt19937::result_type seed = std::random_device{}())
+      : direction_(direction),
+        random_engine_(seed) {
+  }
+
+  void setPeers(std::vector<PeerStatus> peers, std::chrono::steady_clock::time_point refreshed_at = std::chrono::steady_clock::now());
+
+  [[nodiscard]] const std::vector<PeerStatus>& getPeers() const {
+    return peers_;
+  }
+
+  [[nodiscard]] bool empty() const {
+    return peers_.empty();
+  }
+
+  [[nodiscard]] bool needsRefresh(std::chrono::milliseconds refresh_interval, std::chrono::steady_clock::time_point now = std::chrono::steady_clock::now()) const {
+    return peers_.empty() || now - last_refresh_ >= refresh_interval;
+  }
+
+  [[nodiscard]] const std::vector<double>& getWeights() const {
+    return weights_;
+  }
+
+  std::optional<PeerStatus> next();
+
+  // selects up to count distinct peers, weighted sampling without replacement
+  std::vector<PeerStatus> nextDistinct(size_t count);
+
+  static std::vector<double> calculateWeights(TransferDirection direction, const std::vector<PeerStatus>& peers);
+
+ private:
+  static constexpr double MAX_SHARE = 0.8;
+  static constexpr double MIN_SHARE = 0.2;
+
+  TransferDirection direction_;
+  std::vector<PeerStatus> peers_;
+  std::vector<double> weights_;
+  std::discrete_distribution<size_t> distribution_;
+  std::mt19937 random_engine_;
+  std::chrono::steady_clock::time_point last_refresh_;
+};
+
+}  // namespace org::apache::nifi::minifi::sitetosite
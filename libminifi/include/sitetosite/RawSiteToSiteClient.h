@@ -89,6 +89,7 @@ class RawSiteToSiteClient final : public SiteToSiteClient {
 
   std::shared_ptr<core::logging::Logger> logger_ = core::logging::LoggerFactory<RawSiteToSiteClient>::getLogger();
   utils::Identifier comms_identifier_;
+  bool codec_fallback_pending_{false};
 };
 
 }  // namespace sitetosite
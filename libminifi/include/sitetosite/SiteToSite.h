@@ -22,6 +22,7 @@
 #include <utility>
 
 #include "minifi-cpp/controllers/SSLContextServiceInterface.h"
+#include "CompressionCodec.h"
 #include "Peer.h"
 #include "io/CRCStream.h"
 #include "utils/Id.h"
@@ -79,6 +80,12 @@ enum class HandshakeProperty {
    * the protocol. Value is in milliseconds.
    */
   BATCH_DURATION,
+  /**
+   * The codec used for the compressed blocks when GZIP is true, if it is not
+   * zlib. Not part of the NiFi protocol, peers that do not know it reject the
+   * handshake and the client falls back to zlib.
+   */
+  COMPRESSION_CODEC,
   MAX_HANDSHAKE_PROPERTY
 };
 
@@ -367,6 +374,22 @@ class SiteToSiteClientConfiguration {
     return use_compression_;
   }
 
+  void setCompressionCodec(CompressionCodec codec) {
+    compression_codec_ = codec;
+  }
+
+  CompressionCodec getCompressionCodec() const {
+    return compression_codec_;
+  }
+
+  void setCompressionParallelism(size_t parallelism) {
+    compression_parallelism_ = parallelism;
+  }
+
+  size_t getCompressionParallelism() const {
+    return compression_parallelism_;
+  }
+
   void setBatchCount(std::optional<uint64_t> count) {
     batch_count_ = count;
   }
@@ -409,6 +432,8 @@ class SiteToSiteClientConfiguration {
   std::shared_ptr<controllers::SSLContextServiceInterface> ssl_service_;
   http::HTTPProxy proxy_;
   bool use_compression_{false};
+  CompressionCodec compression_codec_{CompressionCodec::ZLIB};
+  size_t compression_parallelism_{1};
   std::optional<uint64_t> batch_count_;
   std::optional<uint64_t> batch_size_;
   std::optional<std::chrono::milliseconds> batch_duration_;
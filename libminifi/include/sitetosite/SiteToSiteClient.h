@@ -19,6 +19,7 @@
 #pragma once
 
 #include <algorithm>
+#include <functional>
 #include <map>
 #include <memory>
 #include <string>
@@ -56,6 +57,11 @@ struct DataPacket {
   const std::string& payload;
 };
 
+struct FlowFileWithContent {
+  std::shared_ptr<core::FlowFile> flow_file;
+  std::shared_ptr<io::InputStream> content;
+};
+
 struct SiteToSiteResponse {
   ResponseCode code = ResponseCode::UNRECOGNIZED_RESPONSE_CODE;
   std::string message;
@@ -85,6 +91,13 @@ class SiteToSiteClient {
     }
   }
 
+  /**
+   * Sends flow files already taken from a session in a single transaction. The content is read from the streams opened
+   * by the caller instead of through the session, so clients of different peers can run this concurrently. Reporting
+   * provenance and removing the flow files from the session is left to the caller.
+   */
+  bool sendFlowFiles(core::ProcessContext& context, const std::vector<FlowFileWithContent>& flow_files);
+
   void setPortId(const utils::Identifier& id) {
     port_id_ = id;
   }
@@ -97,6 +110,10 @@ class SiteToSiteClient {
     return port_id_;
   }
 
+  [[nodiscard]] std::string getPeerURL() const {
+    return peer_->getURL();
+  }
+
   [[nodiscard]] const std::shared_ptr<core::logging::Logger> &getLogger() {
     return logger_;
   }
@@ -109,6 +126,20 @@ class SiteToSiteClient {
     use_compression_ = use_compression;
   }
 
+  // the preferred codec is negotiated with the peer, zlib is used if the peer does not support it
+  void setCompressionCodec(CompressionCodec codec) {
+    preferred_compression_codec_ = codec;
+    compression_codec_ = codec;
+  }
+
+  [[nodiscard]] CompressionCodec getCompressionCodec() const {
+    return compression_codec_;
+  }
+
+  void setCompressionParallelism(size_t parallelism) {
+    compression_parallelism_ = std::max<size_t>(parallelism, 1);
+  }
+
   void setBatchSize(uint64_t size) {
     batch_size_ = size;
   }
@@ -143,6 +174,7 @@ class SiteToSiteClient {
   void finalizeSendTransaction(const std::shared_ptr<Transaction>& transaction, uint64_t sent_bytes);
   bool sendPacket(const DataPacket& packet);
   bool sendFlowFile(const std::shared_ptr<Transaction>& transaction, core::FlowFile& flow_file, core::ProcessSession& session);
+  bool sendFlowFile(const std::shared_ptr<Transaction>& transaction, core::FlowFile& flow_file, const std::function<int64_t(io::OutputStream&)>& write_content);
 
   void cancel(const utils::Identifier &transaction_id);
   bool complete(core::ProcessContext& context, const utils::Identifier &transaction_id);
@@ -168,6 +200,9 @@ class SiteToSiteClient {
   std::shared_ptr<minifi::controllers::SSLContextServiceInterface> ssl_context_service_;
 
   std::atomic_bool use_compression_{false};
+  std::atomic<CompressionCodec> preferred_compression_codec_{CompressionCodec::ZLIB};
+  std::atomic<CompressionCodec> compression_codec_{CompressionCodec::ZLIB};
+  std::atomic<size_t> compression_parallelism_{1};
   std::atomic<uint64_t> batch_count_{0};
   std::atomic<uint64_t> batch_size_{0};
   std::atomic<std::chrono::milliseconds> batch_duration_{0s};
@@ -182,6 +217,7 @@ class SiteToSiteClient {
 
   static const ResponseCodeContext* getResponseCodeContext(ResponseCode code);
   bool transferFlowFiles(core::ProcessContext& context, core::ProcessSession& session);
+  bool isBatchFull(const Transaction& transaction, std::chrono::steady_clock::time_point transaction_started_at) const;
   bool receiveFlowFiles(core::ProcessContext& context, core::ProcessSession& session);
 
   bool confirmReceive(const std::shared_ptr<Transaction>& transaction, const utils::Identifier& transaction_id);
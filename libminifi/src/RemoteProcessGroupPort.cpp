@@ -27,6 +27,9 @@
 #include <utility>
 #include <vector>
 #include <algorithm>
+#include <functional>
+#include <future>
+#include <limits>
 
 #include "minifi-cpp/Exception.h"
 #include "controllers/SSLContextService.h"
@@ -47,6 +50,10 @@ using namespace std::literals::chrono_literals;
 namespace org::apache::nifi::minifi {
 
 namespace {
+std::string peerKey(const sitetosite::PeerStatus& peer_status) {
+  return "nifi://" + peer_status.getHost() + ":" + std::to_string(peer_status.getPort());
+}
+
 std::string buildFullSiteToSiteUrl(const RPG& nifi) {
   std::stringstream full_url;
   full_url << nifi.protocol << nifi.host;
@@ -79,6 +86,8 @@ gsl::not_null<std::unique_ptr<sitetosite::SiteToSiteClient>> RemoteProcessGroupP
   config.setHTTPProxy(proxy_);
   config.setIdleTimeout(idle_timeout_);
   config.setUseCompression(use_compression_);
+  config.setCompressionCodec(compression_codec_);
+  config.setCompressionParallelism(compression_parallelism_);
   config.setBatchCount(batch_count_);
   config.setBatchSize(batch_size_);
   config.setBatchDuration(batch_duration_);
@@ -87,37 +96,63 @@ gsl::not_null<std::unique_ptr<sitetosite::SiteToSiteClient>> RemoteProcessGroupP
   return sitetosite::createClient(config);
 }
 
-std::unique_ptr<sitetosite::SiteToSiteClient> RemoteProcessGroupPort::getNextProtocol() {
-  std::unique_ptr<sitetosite::SiteToSiteClient> next_protocol = nullptr;
-  if (!available_protocols_.try_dequeue(next_protocol)) {
+gsl::not_null<std::unique_ptr<sitetosite::SiteToSiteClient>> RemoteProcessGroupPort::initializeProtocol(const sitetosite::PeerStatus& peer_status) const {
+  sitetosite::SiteToSiteClientConfiguration config(peer_status.getPortId(), peer_status.getHost(), peer_status.getPort(), local_network_interface_, client_type_);
+  return initializeProtocol(config);
+}
+
+void RemoteProcessGroupPort::refreshPeerListIfNeeded() {
+  // only one thread refreshes the peer list, the others keep using the previous one instead of waiting for the remote instance
+  if (nifi_instances_.empty() || peer_refresh_in_progress_.exchange(true)) {
+    return;
+  }
+  const auto refresh_finished = gsl::finally([this] { peer_refresh_in_progress_ = false; });
+  {
     std::lock_guard<std::mutex> lock(peer_mutex_);
-    if (peer_index_ >= 0) {
-      logger_->log_debug("Creating client from peer {}", peer_index_);
-      auto& peer_status = peers_[peer_index_];
-      sitetosite::SiteToSiteClientConfiguration config(peer_status.getPortId(), peer_status.getHost(), peer_status.getPort(), local_network_interface_, client_type_);
-      peer_index_++;
-      if (peer_index_ >= gsl::narrow<int>(peers_.size())) {
-        peer_index_ = 0;
-      }
-      next_protocol = initializeProtocol(config);
-    } else {
-      logger_->log_debug("Refreshing the peer list since there are none configured.");
-      refreshPeerList();
+    if (!peer_selector_.needsRefresh(peer_refresh_interval_)) {
+      return;
     }
   }
-  logger_->log_debug("Obtained protocol from available_protocols_");
-  return next_protocol;
+  logger_->log_debug("Refreshing the peer list and the flow file counts of the peers");
+  auto peers = fetchPeerList();
+  std::lock_guard<std::mutex> lock(peer_mutex_);
+  updatePeerList(std::move(peers));
+}
+
+std::unique_ptr<sitetosite::SiteToSiteClient> RemoteProcessGroupPort::getProtocolForPeer(const sitetosite::PeerStatus& peer_status) {
+  auto it = available_protocols_.find(peerKey(peer_status));
+  if (it != available_protocols_.end() && !it->second.empty()) {
+    auto protocol = std::move(it->second.back());
+    it->second.pop_back();
+    --available_protocol_count_;
+    logger_->log_debug("Obtained protocol for peer {} from available_protocols_", it->first);
+    return protocol;
+  }
+  logger_->log_debug("Creating client for peer {}:{}", peer_status.getHost(), peer_status.getPort());
+  return initializeProtocol(peer_status);
+}
+
+std::unique_ptr<sitetosite::SiteToSiteClient> RemoteProcessGroupPort::getNextProtocol() {
+  refreshPeerListIfNeeded();
+  std::lock_guard<std::mutex> lock(peer_mutex_);
+  if (auto peer_status = peer_selector_.next()) {
+    return getProtocolForPeer(*peer_status);
+  }
+  logger_->log_debug("No peers are available");
+  return nullptr;
 }
 
 void RemoteProcessGroupPort::returnProtocol(core::ProcessContext& context, std::unique_ptr<sitetosite::SiteToSiteClient> return_protocol) {
-  auto count = std::max<size_t>(context.getProcessor().getMaxConcurrentTasks(), peers_.size());
-  if (available_protocols_.size_approx() >= count) {
+  std::lock_guard<std::mutex> lock(peer_mutex_);
+  auto count = std::max<size_t>(context.getProcessor().getMaxConcurrentTasks() * max_parallel_transactions_, peer_selector_.getPeers().size());
+  if (available_protocol_count_ >= count) {
     logger_->log_debug("not enqueueing protocol {}", getUUIDStr());
     // let the memory be freed
     return;
   }
-  logger_->log_debug("enqueueing protocol {}, have a total of {}", getUUIDStr(), available_protocols_.size_approx());
-  available_protocols_.enqueue(std::move(return_protocol));
+  logger_->log_debug("enqueueing protocol {}, have a total of {}", getUUIDStr(), available_protocol_count_);
+  available_protocols_[return_protocol->getPeerURL()].push_back(std::move(return_protocol));
+  ++available_protocol_count_;
 }
 
 void RemoteProcessGroupPort::initialize() {
@@ -154,27 +189,41 @@ void RemoteProcessGroupPort::onSchedule(core::ProcessContext& context, core::Pro
   }
 
   idle_timeout_ = context.getProperty(idleTimeout) | utils::andThen(parsing::parseDuration<std::chrono::milliseconds>) | utils::orThrow("RemoteProcessGroupPort::idleTimeout is a required Property");
+  peer_refresh_interval_ = context.getProperty(PeerRefreshInterval) | utils::andThen(parsing::parseDuration<std::chrono::milliseconds>)
+      | utils::orThrow("RemoteProcessGroupPort::PeerRefreshInterval is a required Property");
+  max_parallel_transactions_ = std::max<uint64_t>(1, context.getProperty(MaxParallelTransactions) | utils::andThen(parsing::parseIntegral<uint64_t>)
+      | utils::orThrow("RemoteProcessGroupPort::MaxParallelTransactions is a required Property"));
+  const auto compression_codec_name = context.getProperty(CompressionCodec) | utils::orThrow("RemoteProcessGroupPort::CompressionCodec is a required Property");
+  if (const auto compression_codec = sitetosite::parseCompressionCodec(compression_codec_name)) {
+    compression_codec_ = *compression_codec;
+  } else {
+    throw Exception(PROCESS_SCHEDULE_EXCEPTION, fmt::format("Invalid Compression Codec: {}", compression_codec_name));
+  }
+  compression_parallelism_ = std::max<size_t>(1, context.getProperty(CompressionParallelism) | utils::andThen(parsing::parseIntegral<size_t>)
+      | utils::orThrow("RemoteProcessGroupPort::CompressionParallelism is a required Property"));
+  if (max_parallel_transactions_ > 1 && direction_ == sitetosite::TransferDirection::RECEIVE) {
+    logger_->log_warn("Max Parallel Transactions is only supported when sending, receiving will use a single transaction per trigger");
+  }
+  if (max_parallel_transactions_ > 1 && direction_ == sitetosite::TransferDirection::SEND) {
+    const uint64_t pool_size = context.getProcessor().getMaxConcurrentTasks() * (max_parallel_transactions_ - 1);
+    transaction_pool_.setMaxConcurrentTasks(gsl::narrow<uint16_t>(std::min<uint64_t>(pool_size, std::numeric_limits<uint16_t>::max())));
+    transaction_pool_.start();
+  }
 
+  auto peers = nifi_instances_.empty() ? std::nullopt : fetchPeerList();
   std::lock_guard<std::mutex> lock(peer_mutex_);
-  if (!nifi_instances_.empty()) {
-    refreshPeerList();
-    if (!peers_.empty())
-      peer_index_ = 0;
-  }
+  updatePeerList(std::move(peers));
   // populate the site2site protocol for load balancing between them
-  if (!peers_.empty()) {
-    auto count = std::max<size_t>(context.getProcessor().getMaxConcurrentTasks(), peers_.size());
-    for (uint32_t i = 0; i < count; i++) {
-      auto peer_status = peers_[peer_index_];
-      sitetosite::SiteToSiteClientConfiguration config(peer_status.getPortId(), peer_status.getHost(), peer_status.getPort(), local_network_interface_, client_type_);
-      peer_index_++;
-      if (peer_index_ >= gsl::narrow<int>(peers_.size())) {
-        peer_index_ = 0;
-      }
+  if (!peer_selector_.empty()) {
+    const auto& peers = peer_selector_.getPeers();
+    auto count = std::max<size_t>(context.getProcessor().getMaxConcurrentTasks(), peers.size());
+    for (size_t i = 0; i < count; i++) {
+      const auto& peer_status = peers[i % peers.size()];
       logger_->log_trace("Creating client");
-      auto next_protocol = initializeProtocol(config);
+      auto next_protocol = initializeProtocol(peer_status);
       logger_->log_trace("Created client, moving into available protocols");
-      returnProtocol(context, std::move(next_protocol));
+      available_protocols_[peerKey(peer_status)].push_back(std::move(next_protocol));
+      ++available_protocol_count_;
     }
   } else {
     // we don't have any peers
@@ -184,9 +233,169 @@ void RemoteProcessGroupPort::onSchedule(core::ProcessContext& context, core::Pro
 
 void RemoteProcessGroupPort::notifyStop() {
   transmitting_ = false;
-  std::unique_ptr<sitetosite::SiteToSiteClient> next_protocol = nullptr;
-  while (available_protocols_.try_dequeue(next_protocol)) {
-    // clear all protocols now
+  transaction_pool_.shutdown();
+  std::lock_guard<std::mutex> lock(peer_mutex_);
+  available_protocols_.clear();
+  available_protocol_count_ = 0;
+}
+
+std::vector<sitetosite::FlowFileWithContent> RemoteProcessGroupPort::getBatch(core::ProcessSession& session, std::vector<std::shared_ptr<core::FlowFile>>& retried_flow_files) {
+  const uint64_t max_count = batch_count_.value_or(DEFAULT_PARALLEL_BATCH_COUNT);
+  const auto started_at = std::chrono::steady_clock::now();
+  std::vector<sitetosite::FlowFileWithContent> batch;
+  uint64_t batch_bytes = 0;
+  const auto is_full = [&] {
+    return batch.size() >= max_count
+        || (batch_size_ && batch_bytes >= *batch_size_)
+        || (batch_duration_ && std::chrono::steady_clock::now() - started_at >= *batch_duration_);
+  };
+  const auto add_to_batch = [&](std::shared_ptr<core::FlowFile> flow_file) {
+    batch_bytes += flow_file->getSize();
+    auto content = flow_file->getResourceClaim() && flow_file->getResourceClaim()->exists() ? session.getFlowFileContentStream(*flow_file) : nullptr;
+    batch.push_back({std::move(flow_file), std::move(content)});
+  };
+
+  {
+    std::lock_guard<std::mutex> lock(failed_flow_files_mutex_);
+    for (auto it = failed_flow_files_.begin(); it != failed_flow_files_.end() && !is_full();) {
+      if ((*it)->isPenalized()) {
+        ++it;
+        continue;
+      }
+      session.add(*it);
+      retried_flow_files.push_back(*it);
+      add_to_batch(*it);
+      it = failed_flow_files_.erase(it);
+    }
+  }
+  while (!is_full()) {
+    auto flow_file = session.get();
+    if (!flow_file) {
+      break;
+    }
+    add_to_batch(std::move(flow_file));
+  }
+  return batch;
+}
+
+bool RemoteProcessGroupPort::hasFailedFlowFiles() {
+  std::lock_guard<std::mutex> lock(failed_flow_files_mutex_);
+  return !failed_flow_files_.empty();
+}
+
+void RemoteProcessGroupPort::restore(const std::shared_ptr<core::FlowFile>& flow_file) {
+  if (!flow_file) {
+    return;
+  }
+  std::lock_guard<std::mutex> lock(failed_flow_files_mutex_);
+  failed_flow_files_.push_back(flow_file);
+}
+
+void RemoteProcessGroupPort::transferInParallel(core::ProcessContext& context, core::ProcessSession& session) {
+  refreshPeerListIfNeeded();
+  std::vector<std::unique_ptr<sitetosite::SiteToSiteClient>> protocols;
+  {
+    std::lock_guard<std::mutex> lock(peer_mutex_);
+    for (const auto& peer_status : peer_selector_.nextDistinct(gsl::narrow<size_t>(max_parallel_transactions_))) {
+      protocols.push_back(getProtocolForPeer(peer_status));
+    }
+  }
+  if (protocols.empty()) {
+    throw Exception(SITE2SITE_EXCEPTION, "No peers are available");
+  }
+
+  std::vector<std::shared_ptr<core::FlowFile>> retried_flow_files;
+  auto batch = getBatch(session, retried_flow_files);
+  try {
+    const auto used_protocol_count = std::min(protocols.size(), batch.size());
+    for (size_t i = used_protocol_count; i < protocols.size(); ++i) {
+      returnProtocol(context, std::move(protocols[i]));
+    }
+    protocols.resize(used_protocol_count);
+    if (batch.empty()) {
+      return;
+    }
+
+    // distribute the flow files so that every transaction carries roughly the same amount of content
+    std::vector<std::vector<sitetosite::FlowFileWithContent>> sub_batches(protocols.size());
+    std::vector<uint64_t> sub_batch_bytes(protocols.size(), 0);
+    std::ranges::stable_sort(batch, std::greater<>{}, [](const auto& flow_file_with_content) { return flow_file_with_content.flow_file->getSize(); });
+    for (auto& flow_file_with_content : batch) {
+      const auto target = std::distance(sub_batch_bytes.begin(), std::ranges::min_element(sub_batch_bytes));
+      sub_batch_bytes[target] += flow_file_with_content.flow_file->getSize();
+      sub_batches[target].push_back(std::move(flow_file_with_content));
+    }
+
+    const auto send = [this, &context](sitetosite::SiteToSiteClient& protocol, const std::vector<sitetosite::FlowFileWithContent>& sub_batch) {
+      try {
+        return protocol.sendFlowFiles(context, sub_batch);
+      } catch (const std::exception& exception) {
+        logger_->log_error("Site2Site transaction to {} failed: {}", protocol.getPeerURL(), exception.what());
+        return false;
+      }
+    };
+    const auto start_time = std::chrono::steady_clock::now();
+    std::vector<std::future<bool>> results;
+    for (size_t i = 1; i < protocols.size(); ++i) {
+      auto result = std::make_shared<std::promise<bool>>();
+      results.push_back(result->get_future());
+      std::future<utils::TaskRescheduleInfo> task_future;  // the result is reported through the promise
+      transaction_pool_.execute(utils::Worker{[&send, &protocol = *protocols[i], &sub_batch = sub_batches[i], result] {
+        result->set_value(send(protocol, sub_batch));
+        return utils::TaskRescheduleInfo::Done();
+      }, getUUIDStr()}, task_future);
+    }
+    std::vector<bool> succeeded(protocols.size(), false);
+    succeeded[0] = send(*protocols[0], sub_batches[0]);
+    for (size_t i = 1; i < protocols.size(); ++i) {
+      try {
+        succeeded[i] = results[i - 1].get();
+      } catch (const std::future_error&) {
+        // the pool was shut down before running the transaction
+        succeeded[i] = false;
+      }
+    }
+    const auto duration = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - start_time);
+
+    std::vector<std::string> peer_urls;
+    for (auto& protocol : protocols) {
+      peer_urls.push_back(protocol->getPeerURL());
+      returnProtocol(context, std::move(protocol));
+    }
+
+    // the flow files of the completed transactions are removed, the ones of the failed transactions are penalized and kept by the processor,
+    // so only these are sent again, instead of rolling back the whole session and sending the completed transactions twice
+    std::vector<std::shared_ptr<core::FlowFile>> failed_flow_files;
+    for (size_t i = 0; i < sub_batches.size(); ++i) {
+      if (!succeeded[i]) {
+        logger_->log_warn("Site2Site transaction to {} failed, keeping its {} flow files to send them again", peer_urls[i], sub_batches[i].size());
+      }
+      for (const auto& [flow_file, content] : sub_batches[i]) {
+        if (succeeded[i]) {
+          std::string transit_uri = peer_urls[i] + "/" + flow_file->getUUIDStr();
+          std::string details = "urn:nifi:" + flow_file->getUUIDStr() + "Remote Host=" + peer_urls[i];
+          session.getProvenanceReporter()->send(*flow_file, transit_uri, details, duration, false);
+          session.remove(flow_file);
+        } else {
+          session.penalize(flow_file);
+          session.transfer(flow_file, Self);
+          failed_flow_files.push_back(flow_file);
+        }
+      }
+    }
+
+    if (!failed_flow_files.empty()) {
+      // the processor only takes the flow files over after the session is committed, otherwise a rollback would return them to the queue as well
+      session.commit();
+      std::lock_guard<std::mutex> lock(failed_flow_files_mutex_);
+      failed_flow_files_.insert(failed_flow_files_.end(), failed_flow_files.begin(), failed_flow_files.end());
+      context.yield();
+    }
+  } catch (...) {
+    // the retried flow files are still owned by the processor if the session is rolled back
+    std::lock_guard<std::mutex> lock(failed_flow_files_mutex_);
+    failed_flow_files_.insert(failed_flow_files_.end(), retried_flow_files.begin(), retried_flow_files.end());
+    throw;
   }
 }
 
@@ -197,6 +406,12 @@ void RemoteProcessGroupPort::onTrigger(core::ProcessContext& context, core::Proc
   }
 
   try {
+    // the flow files of failed parallel transactions are also sent this way if the setting was changed since
+    if (direction_ == sitetosite::TransferDirection::SEND && (max_parallel_transactions_ > 1 || hasFailedFlowFiles())) {
+      transferInParallel(context, session);
+      return;
+    }
+
     logger_->log_trace("get protocol in on trigger");
     auto protocol = getNextProtocol();
 
@@ -347,30 +562,44 @@ std::optional<std::pair<std::string, uint16_t>> RemoteProcessGroupPort::refreshR
   return std::nullopt;
 }
 
-void RemoteProcessGroupPort::refreshPeerList() {
+std::optional<std::vector<sitetosite::PeerStatus>> RemoteProcessGroupPort::fetchPeerList() {
   auto connection = refreshRemoteSiteToSiteInfo();
   if (!connection) {
     logger_->log_warn("No port configured");
-    return;
+    return std::nullopt;
   }
 
-  peers_.clear();
-
   std::unique_ptr<sitetosite::SiteToSiteClient> protocol;
   sitetosite::SiteToSiteClientConfiguration config(protocol_uuid_, connection->first, connection->second, local_network_interface_, client_type_);
   protocol = initializeProtocol(config);
 
-  if (protocol) {
-    if (auto peers = protocol->getPeerList()) {
-      peers_ = *peers;
+  return protocol->getPeerList();
+}
+
+void RemoteProcessGroupPort::updatePeerList(std::optional<std::vector<sitetosite::PeerStatus>> peers) {
+  if (!peers) {
+    if (!nifi_instances_.empty()) {
+      logger_->log_warn("Could not refresh the peer list, keeping the previous {} peers", peer_selector_.getPeers().size());
     }
+    return;
   }
 
-  logger_->log_info("Have {} peers", peers_.size());
-
-  if (!peers_.empty()) {
-    peer_index_ = 0;
+  peer_selector_.setPeers(std::move(*peers));
+  const auto& weights = peer_selector_.getWeights();
+  for (size_t i = 0; i < peer_selector_.getPeers().size(); ++i) {
+    const auto& peer_status = peer_selector_.getPeers()[i];
+    logger_->log_debug("Peer {}:{} has {} flow files queued, weight {}", peer_status.getHost(), peer_status.getPort(), peer_status.getFlowFileCount(), weights[i]);
   }
+  logger_->log_info("Have {} peers", peer_selector_.getPeers().size());
+
+  // drop the idle clients of peers which are no longer part of the remote cluster
+  std::erase_if(available_protocols_, [&](const auto& entry) {
+    const bool is_current_peer = std::ranges::any_of(peer_selector_.getPeers(), [&](const auto& peer_status) { return peerKey(peer_status) == entry.first; });
+    if (!is_current_peer) {
+      available_protocol_count_ -= entry.second.size();
+    }
+    return !is_current_peer;
+  });
 }
 
 }  // namespace org::apache::nifi::minifi
@@ -141,6 +141,21 @@ std::expected<std::string, std::error_code> ProcessContextImpl::getDynamicProper
   return cached_dynamic_expressions_[std::string{name}](p).asString();
 }
 
+std::expected<std::vector<std::string>, std::error_code> ProcessContextImpl::getDynamicPropertyForEach(const std::string_view name, std::span<const std::shared_ptr<FlowFile>> flow_files) const {
+  auto cached_dyn_expr_it = cached_dynamic_expressions_.find(name);
+  if (cached_dyn_expr_it == cached_dynamic_expressions_.end()) {
+    auto expression_str = getProcessor().getDynamicProperty(name);
+    if (!expression_str) { return std::unexpected{expression_str.error()}; }
+    cached_dyn_expr_it = cached_dynamic_expressions_.emplace(std::string{name}, expression::compile(*expression_str)).first;
+  }
+  std::vector<std::string> results;
+  results.reserve(flow_files.size());
+  for (auto& value : cached_dyn_expr_it->second.evaluate_batch(this, flow_files)) {
+    results.push_back(value.asString());
+  }
+  return results;
+}
+
 std::expected<std::string, std::error_code> ProcessContextImpl::getRawProperty(const std::string_view name) const {
   return getProcessor().getProperty(name);
 }
@@ -188,13 +188,11 @@ std::shared_ptr<core::FlowFile> ProcessSessionImpl::clone(const FlowFile& parent
   std::shared_ptr<core::FlowFile> record = this->create(&parent);
   if (record) {
     logger_->log_debug("Cloned parent flow files {} to {}, with {}:{}", parent.getUUIDStr(), record->getUUIDStr(), offset, size);
-    if (parent.getResourceClaim()) {
-      write(record, [&] (const std::shared_ptr<io::OutputStream>& output) -> io::IoResult {
-        return io::IoResult::from(read(parent, [&] (const std::shared_ptr<io::InputStream>& input) -> io::IoResult {
-          io::StreamSlice slice(input, offset, size);
-          return internal::pipe(slice, *output);
-        }));
-      });
+    // the clone is a view over the parent's content, the claim is shared instead of copied
+    if (const auto parent_claim = parent.getResourceClaim()) {
+      record->setResourceClaim(parent_claim);
+      record->setOffset(parent.getOffset() + gsl::narrow<uint64_t>(offset));
+      record->setSize(gsl::narrow<uint64_t>(size));
     }
     provenance_report_->clone(parent, *record);
   }
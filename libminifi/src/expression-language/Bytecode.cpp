@@ -0,0 +1,286 @@
+/**
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The ASF licenses this file to You under the Apache License, Version 2.0
+ * (the "License"); you may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "expression-language/Bytecode.h"
+
+#include <algorithm>
+#include <cstddef>
+#include <memory>
+#include <optional>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "minifi-cpp/utils/gsl.h"
+
+namespace org::apache::nifi::minifi::expression::bytecode {
+
+class Compiler {
+ public:
+  explicit Compiler(Program& program) : program_(program) {}
+
+  void lower(const Expression& expression) {
+    if (auto constant = constantValue(expression)) {
+      emit({.op_code = OpCode::PushConstant, .operand = addConstant(std::move(*constant))}, 0);
+      return;
+    }
+
+    const auto* node = expression.node();
+    if (!node) {
+      program_.trees_.push_back(expression);
+      emit({.op_code = OpCode::EvaluateTree, .operand = gsl::narrow<uint32_t>(program_.trees_.size() - 1)}, 0);
+      return;
+    }
+
+    switch (node->type) {
+      case ExpressionNode::Type::Constant:  // already handled by constantValue
+        emit({.op_code = OpCode::PushConstant, .operand = addConstant(node->value)}, 0);
+        return;
+      case ExpressionNode::Type::Attribute:
+        emit({.op_code = OpCode::LoadAttribute, .operand = attributeSlot(node->name)}, 0);
+        return;
+      case ExpressionNode::Type::Function:
+        for (const auto& arg : node->args) {
+          lower(arg);
+        }
+        program_.functions_.push_back(node->function);
+        emit({.op_code = OpCode::Call, .operand = gsl::narrow<uint32_t>(program_.functions_.size() - 1), .arg_count = gsl::narrow<uint32_t>(node->args.size())}, node->args.size());
+        return;
+      case ExpressionNode::Type::Concat:
+        lowerConcat(expression);
+        return;
+    }
+  }
+
+ private:
+  // the parser builds concatenations as a left-deep binary tree, they are lowered to a single n-ary concatenation
+  static void flattenConcat(const Expression& expression, std::vector<const Expression*>& parts) {
+    const auto* node = expression.node();
+    if (node && node->type == ExpressionNode::Type::Concat) {
+      for (const auto& arg : node->args) {
+        flattenConcat(arg, parts);
+      }
+    } else {
+      parts.push_back(&expression);
+    }
+  }
+
+  void lowerConcat(const Expression& expression) {
+    std::vector<const Expression*> parts;
+    flattenConcat(expression, parts);
+
+    uint32_t arg_count = 0;
+    std::string constant_prefix;
+    const auto flush_constant = [&] {
+      if (!constant_prefix.empty()) {
+        emit({.op_code = OpCode::PushConstant, .operand = addConstant(Value(std::exchange(constant_prefix, {})))}, 0);
+        ++arg_count;
+      }
+    };
+    for (const auto* part : parts) {
+      if (auto constant = constantValue(*part)) {
+        constant_prefix.append(constant->asString());
+        continue;
+      }
+      flush_constant();
+      lower(*part);
+      ++arg_count;
+    }
+    flush_constant();
+    emit({.op_code = OpCode::Concat, .arg_count = arg_count}, arg_count);
+  }
+
+  static std::optional<Value> constantValue(const Expression& expression) {
+    const auto* node = expression.node();
+    if (!node) {
+      return std::nullopt;
+    }
+
+    switch (node->type) {
+      case ExpressionNode::Type::Constant:
+        return node->value;
+      case ExpressionNode::Type::Attribute:
+        return std::nullopt;
+      case ExpressionNode::Type::Function: {
+        if (!node->pure) {
+          return std::nullopt;
+        }
+        std::vector<Value> args;
+        args.reserve(node->args.size());
+        for (const auto& arg : node->args) {
+          auto constant = constantValue(arg);
+          if (!constant) {
+            return std::nullopt;
+          }
+          args.push_back(std::move(*constant));
+        }
+        try {
+          return node->function(args);
+        } catch (const std::exception&) {
+          // the error is reported when the expression is evaluated, like without folding
+          return std::nullopt;
+        }
+      }
+      case ExpressionNode::Type::Concat: {
+        std::vector<const Expression*> parts;
+        flattenConcat(expression, parts);
+        std::string result;
+        for (const auto* part : parts) {
+          auto constant = constantValue(*part);
+          if (!constant) {
+            return std::nullopt;
+          }
+          result.append(constant->asString());
+        }
+        return Value(std::move(result));
+      }
+    }
+    return std::nullopt;
+  }
+
+  uint32_t addConstant(Value value) {
+    program_.constants_.push_back(std::move(value));
+    return gsl::narrow<uint32_t>(program_.constants_.size() - 1);
+  }
+
+  uint32_t attributeSlot(const std::string& name) {
+    const auto [it, inserted] = attribute_slots_.emplace(name, gsl::narrow<uint32_t>(program_.attributes_.size()));
+    if (inserted) {
+      program_.attributes_.push_back({.name = name});
+    } else {
+      program_.attributes_[it->second].cached = true;
+      program_.has_cached_attributes_ = true;
+    }
+    return it->second;
+  }
+
+  void emit(Instruction instruction, size_t popped) {
+    program_.instructions_.push_back(instruction);
+    stack_size_ = stack_size_ - popped + 1;
+    program_.max_stack_size_ = std::max(program_.max_stack_size_, stack_size_);
+  }
+
+  Program& program_;
+  size_t stack_size_ = 0;
+  std::unordered_map<std::string, uint32_t> attribute_slots_;
+};
+
+Program Program::compile(const Expression& expression) {
+  Program program;
+  Compiler(program).lower(expression);
+  return program;
+}
+
+struct Program::EvaluationState {
+  std::vector<Value> stack;
+  std::vector<std::optional<Value>> attribute_cache;
+  std::vector<std::optional<Value>> registry_cache;  // only used when evaluating a batch
+};
+
+Value Program::run(const Parameters& params) const {
+  EvaluationState state;
+  state.stack.reserve(max_stack_size_);
+  state.attribute_cache.resize(has_cached_attributes_ ? attributes_.size() : 0);
+  return run(params, state);
+}
+
+std::vector<Value> Program::runBatch(const core::VariableRegistry* registry, std::span<const std::shared_ptr<core::FlowFile>> flow_files) const {
+  EvaluationState state;
+  state.stack.reserve(max_stack_size_);
+  state.attribute_cache.resize(has_cached_attributes_ ? attributes_.size() : 0);
+  state.registry_cache.resize(attributes_.size());
+  std::vector<Value> results;
+  results.reserve(flow_files.size());
+  for (const auto& flow_file : flow_files) {
+    std::ranges::fill(state.attribute_cache, std::nullopt);
+    results.push_back(run(Parameters{registry, flow_file.get()}, state));
+  }
+  return results;
+}
+
+Value Program::loadAttribute(const Parameters& params, uint32_t slot_index, EvaluationState& state) const {
+  const auto& slot = attributes_[slot_index];
+  if (state.registry_cache.empty()) {
+    return resolve_attribute(params, slot.name);
+  }
+  // the registry is the same for every flow file of a batch, so it is looked up at most once per attribute slot
+  if (params.flow_file) {
+    if (auto result = params.flow_file->getAttribute(slot.name)) {
+      return Value(std::move(*result));
+    }
+  }
+  auto& registry_value = state.registry_cache[slot_index];
+  if (!registry_value) {
+    registry_value = resolve_attribute(Parameters{params.registry_}, slot.name);
+  }
+  return *registry_value;
+}
+
+Value Program::run(const Parameters& params, EvaluationState& state) const {
+  auto& stack = state.stack;
+  stack.clear();
+
+  for (const auto& instruction : instructions_) {
+    switch (instruction.op_code) {
+      case OpCode::PushConstant:
+        stack.push_back(constants_[instruction.operand]);
+        break;
+      case OpCode::LoadAttribute: {
+        if (!attributes_[instruction.operand].cached) {
+          stack.push_back(loadAttribute(params, instruction.operand, state));
+          break;
+        }
+        auto& cached_value = state.attribute_cache[instruction.operand];
+        if (!cached_value) {
+          cached_value = loadAttribute(params, instruction.operand, state);
+        }
+        stack.push_back(*cached_value);
+        break;
+      }
+      case OpCode::Call: {
+        const auto args_begin = stack.end() - static_cast<std::ptrdiff_t>(instruction.arg_count);
+        Value result = functions_[instruction.operand](std::span<const Value>(args_begin, stack.end()));
+        stack.erase(args_begin, stack.end());
+        stack.push_back(std::move(result));
+        break;
+      }
+      case OpCode::Concat: {
+        const auto args_begin = stack.end() - static_cast<std::ptrdiff_t>(instruction.arg_count);
+        std::string result;
+        for (auto it = args_begin; it != stack.end(); ++it) {
+          if (const auto* str = it->getString()) {
+            result.append(*str);
+          } else {
+            result.append(it->asString());
+          }
+        }
+        stack.erase(args_begin, stack.end());
+        stack.emplace_back(std::move(result));
+        break;
+      }
+      case OpCode::EvaluateTree:
+        stack.push_back(trees_[instruction.operand](params));
+        break;
+    }
+  }
+
+  gsl_Assert(stack.size() == 1);
+  return std::move(stack.back());
+}
+
+}  // namespace org::apache::nifi::minifi::expression::bytecode
@@ -15,16 +15,20 @@
  * limitations under the License.
  */
 
+#include <array>
 #include <atomic>
 #include <chrono>
 #include <utility>
 #include <iostream>
 #include <iomanip>
+#include <iterator>
+#include <memory>
 #include <random>
 #include <algorithm>
-#include <regex>
 #include <functional>
+#include <span>
 #include <string>
+#include <string_view>
 
 #include "rapidjson/reader.h"
 #include "rapidjson/writer.h"
@@ -33,7 +37,6 @@
 #include "utils/StringUtils.h"
 #include "utils/OsUtils.h"
 #include "expression-language/Expression.h"
-#include "utils/RegexUtils.h"
 #include "utils/TimeUtil.h"
 #include "utils/TimeZoneUtils.h"
 
@@ -63,7 +66,9 @@
 #include <unistd.h>
 #endif
 
+#include "expression-language/Bytecode.h"
 #include "expression-language/Driver.h"
+#include "expression-language/RegexCache.h"
 
 #include "core/logging/LoggerFactory.h"
 
@@ -75,7 +80,56 @@ using namespace std::literals::chrono_literals;
 
 namespace org::apache::nifi::minifi::expression {
 
-Expression compile(const std::string &expr_str) {
+namespace {
+std::shared_ptr<const ExpressionNode> make_node(ExpressionNode node) {
+  return std::make_shared<const ExpressionNode>(std::move(node));
+}
+
+bool is_pure(std::string_view function_name) {
+  static constexpr std::array<std::string_view, 8> IMPURE_FUNCTIONS{"hostname", "ip", "reverseDnsLookup", "UUID", "now", "random", "nextInt", "resolve_user_id"};
+  return std::find(IMPURE_FUNCTIONS.begin(), IMPURE_FUNCTIONS.end(), function_name) == IMPURE_FUNCTIONS.end();
+}
+
+/// Views the string value of an argument, only non-string values are converted to a new string
+class StringArg {
+ public:
+  explicit StringArg(const Value& value) {
+    if (const auto* str = value.getString()) {
+      view_ = *str;
+    } else {
+      converted_ = value.asString();
+      view_ = converted_;
+    }
+  }
+
+  StringArg(const StringArg&) = delete;
+  StringArg(StringArg&&) = delete;
+  StringArg& operator=(const StringArg&) = delete;
+  StringArg& operator=(StringArg&&) = delete;
+  ~StringArg() = default;
+
+  [[nodiscard]] std::string_view view() const { return view_; }
+
+ private:
+  std::string converted_;
+  std::string_view view_;
+};
+}  // namespace
+
+Expression::Expression() : val_fn_(NOOP_FN), node_(make_node({.type = ExpressionNode::Type::Constant})) {
+}
+
+Expression::Expression(Value val, std::function<Value(const Parameters &, const std::vector<Expression> &)> val_fn)
+    : val_(val),
+      val_fn_(std::move(val_fn)),
+      is_multi_(false) {
+  sub_expr_generator_ = [](const Parameters& /*params*/) -> std::vector<Expression> {return {};};
+  if (!val_fn_) {
+    node_ = make_node({.type = ExpressionNode::Type::Constant, .value = std::move(val)});
+  }
+}
+
+Expression compile_tree(const std::string &expr_str) {
   std::stringstream expr_str_stream(expr_str);
   Driver driver(&expr_str_stream);
   Parser parser(&driver);
@@ -83,6 +137,12 @@ Expression compile(const std::string &expr_str) {
   return driver.result;
 }
 
+Expression compile(const std::string &expr_str) {
+  auto expression = compile_tree(expr_str);
+  expression.program_ = std::make_shared<const bytecode::Program>(bytecode::Program::compile(expression));
+  return expression;
+}
+
 Expression make_static(std::string val) {
   return Expression(Value(std::move(val)));
 }
@@ -91,24 +151,30 @@ Expression make_dynamic(const std::function<Value(const Parameters &params, cons
   return Expression(Value(), val_fn);
 }
 
-Expression make_dynamic_attr(const std::string &attribute_id) {
-  return make_dynamic([attribute_id](const Parameters &params, const std::vector<Expression>& /*sub_exprs*/) -> Value {
-    if (params.flow_file) {
-      if (auto result = params.flow_file->getAttribute(attribute_id)) {
-        return Value(std::move(*result));
-      }
+Value resolve_attribute(const Parameters &params, std::string_view attribute_id) {
+  if (params.flow_file) {
+    if (auto result = params.flow_file->getAttribute(attribute_id)) {
+      return Value(std::move(*result));
     }
-    if (params.registry_) {
-      if (auto result = params.registry_->getConfigurationProperty(attribute_id)) {
-        return Value(std::move(*result));
-      }
+  }
+  if (params.registry_) {
+    if (auto result = params.registry_->getConfigurationProperty(attribute_id)) {
+      return Value(std::move(*result));
     }
+  }
 
-    return {};
+  return {};
+}
+
+Expression make_dynamic_attr(const std::string &attribute_id) {
+  auto expression = make_dynamic([attribute_id](const Parameters &params, const std::vector<Expression>& /*sub_exprs*/) -> Value {
+    return resolve_attribute(params, attribute_id);
   });
+  expression.set_node(make_node({.type = ExpressionNode::Type::Attribute, .name = attribute_id}));
+  return expression;
 }
 
-Value resolve_user_id(const std::vector<Value> &args) {
+Value resolve_user_id(std::span<const Value> args) {
   std::string name;
   if (args.size() == 1) {
     name = args[0].asString();
@@ -120,7 +186,7 @@ Value resolve_user_id(const std::vector<Value> &args) {
   return Value(name);
 }
 
-Value expr_hostname(const std::vector<Value> &args) {
+Value expr_hostname(std::span<const Value> args) {
   std::array<char, 1024> hostname{};
   gethostname(hostname.data(), 1023);
 
@@ -155,7 +221,7 @@ Value expr_hostname(const std::vector<Value> &args) {
   return Value(std::string(hostname.data()));
 }
 
-Value expr_ip(const std::vector<Value>& /*args*/) {
+Value expr_ip(std::span<const Value> /*args*/) {
   std::array<char, 1024> hostname{};
   gethostname(hostname.data(), 1023);
 
@@ -188,7 +254,7 @@ Value expr_ip(const std::vector<Value>& /*args*/) {
   return {};
 }
 
-Value expr_reverseDnsLookup(const std::vector<Value>& args) {
+Value expr_reverseDnsLookup(std::span<const Value> args) {
   std::string ip_address_str = args[0].asString();
 
   std::chrono::steady_clock::duration timeout_duration = 5s;
@@ -208,23 +274,23 @@ Value expr_reverseDnsLookup(const std::vector<Value>& args) {
       });
 }
 
-Value expr_uuid(const std::vector<Value>& /*args*/) {
+Value expr_uuid(std::span<const Value> /*args*/) {
   return Value(utils::IdGenerator::getIdGenerator()->generate().to_string());
 }
 
-Value expr_toUpper(const std::vector<Value> &args) {
+Value expr_toUpper(std::span<const Value> args) {
   std::string result = args[0].asString();
   std::transform(result.begin(), result.end(), result.begin(), ::toupper);
   return Value(result);
 }
 
-Value expr_toLower(const std::vector<Value> &args) {
+Value expr_toLower(std::span<const Value> args) {
   std::string result = args[0].asString();
   std::transform(result.begin(), result.end(), result.begin(), ::tolower);
   return Value(result);
 }
 
-Value expr_substring(const std::vector<Value> &args) {
+Value expr_substring(std::span<const Value> args) {
   if (args.size() < 3) {
     auto offset = gsl::narrow<size_t>(args[1].asUnsignedLong());
     return Value{args[0].asString().substr(offset)};
@@ -235,38 +301,39 @@ Value expr_substring(const std::vector<Value> &args) {
   }
 }
 
-Value expr_substringBefore(const std::vector<Value> &args) {
-  const std::string &arg_0 = args[0].asString();
-  return Value(arg_0.substr(0, arg_0.find(args[1].asString())));
+Value expr_substringBefore(std::span<const Value> args) {
+  const StringArg arg_0(args[0]);
+  const StringArg arg_1(args[1]);
+  return Value(std::string{arg_0.view().substr(0, arg_0.view().find(arg_1.view()))});
 }
 
-Value expr_substringBeforeLast(const std::vector<Value> &args) {
+Value expr_substringBeforeLast(std::span<const Value> args) {
   size_t last_pos = 0;
-  const std::string &arg_0 = args[0].asString();
-  const std::string &arg_1 = args[1].asString();
-  while (arg_0.find(arg_1, last_pos + 1) != std::string::npos) {
-    last_pos = arg_0.find(arg_1, last_pos + 1);
+  const StringArg arg_0(args[0]);
+  const StringArg arg_1(args[1]);
+  while (arg_0.view().find(arg_1.view(), last_pos + 1) != std::string_view::npos) {
+    last_pos = arg_0.view().find(arg_1.view(), last_pos + 1);
   }
-  return Value(arg_0.substr(0, last_pos));
+  return Value(std::string{arg_0.view().substr(0, last_pos)});
 }
 
-Value expr_substringAfter(const std::vector<Value> &args) {
-  const std::string &arg_0 = args[0].asString();
-  const std::string &arg_1 = args[1].asString();
-  return Value(arg_0.substr(arg_0.find(arg_1) + arg_1.length()));
+Value expr_substringAfter(std::span<const Value> args) {
+  const StringArg arg_0(args[0]);
+  const StringArg arg_1(args[1]);
+  return Value(std::string{arg_0.view().substr(arg_0.view().find(arg_1.view()) + arg_1.view().length())});
 }
 
-Value expr_substringAfterLast(const std::vector<Value> &args) {
+Value expr_substringAfterLast(std::span<const Value> args) {
   size_t last_pos = 0;
-  const std::string &arg_0 = args[0].asString();
-  const std::string &arg_1 = args[1].asString();
-  while (arg_0.find(arg_1, last_pos + 1) != std::string::npos) {
-    last_pos = arg_0.find(arg_1, last_pos + 1);
+  const StringArg arg_0(args[0]);
+  const StringArg arg_1(args[1]);
+  while (arg_0.view().find(arg_1.view(), last_pos + 1) != std::string_view::npos) {
+    last_pos = arg_0.view().find(arg_1.view(), last_pos + 1);
   }
-  return Value(arg_0.substr(last_pos + arg_1.length()));
+  return Value(std::string{arg_0.view().substr(last_pos + arg_1.view().length())});
 }
 
-Value expr_getDelimitedField(const std::vector<Value> &args) {
+Value expr_getDelimitedField(std::span<const Value> args) {
   const auto &subject = args[0].asString();
   const auto &index = args[1].asUnsignedLong() - 1;
   char delimiter_ch = ',';
@@ -386,28 +453,28 @@ Value expr_getDelimitedField(const std::vector<Value> &args) {
   return Value(result);
 }
 
-Value expr_startsWith(const std::vector<Value> &args) {
-  const std::string &arg_0 = args[0].asString();
-  const std::string &arg_1 = args[1].asString();
-  return Value(arg_0.starts_with(arg_1));
+Value expr_startsWith(std::span<const Value> args) {
+  const StringArg arg_0(args[0]);
+  const StringArg arg_1(args[1]);
+  return Value(arg_0.view().starts_with(arg_1.view()));
 }
 
-Value expr_endsWith(const std::vector<Value> &args) {
-  const std::string &arg_0 = args[0].asString();
-  const std::string &arg_1 = args[1].asString();
-  return Value(arg_0.ends_with(arg_1));
+Value expr_endsWith(std::span<const Value> args) {
+  const StringArg arg_0(args[0]);
+  const StringArg arg_1(args[1]);
+  return Value(arg_0.view().ends_with(arg_1.view()));
 }
 
-Value expr_contains(const std::vector<Value> &args) {
-  const std::string &arg_0 = args[0].asString();
-  const std::string &arg_1 = args[1].asString();
-  return Value(arg_0.contains(arg_1));
+Value expr_contains(std::span<const Value> args) {
+  const StringArg arg_0(args[0]);
+  const StringArg arg_1(args[1]);
+  return Value(arg_0.view().contains(arg_1.view()));
 }
 
-Value expr_in(const std::vector<Value> &args) {
-  const std::string &arg_0 = args[0].asString();
+Value expr_in(std::span<const Value> args) {
+  const StringArg arg_0(args[0]);
   for (size_t i = 1; i < args.size(); i++) {
-    if (arg_0 == args[i].asString()) {
+    if (arg_0.view() == StringArg(args[i]).view()) {
       return Value(true);
     }
   }
@@ -415,8 +482,8 @@ Value expr_in(const std::vector<Value> &args) {
   return Value(false);
 }
 
-Value expr_indexOf(const std::vector<Value> &args) {
-  auto pos = args[0].asString().find(args[1].asString());
+Value expr_indexOf(std::span<const Value> args) {
+  auto pos = StringArg(args[0]).view().find(StringArg(args[1]).view());
 
   if (pos == std::string::npos) {
     return Value(static_cast<int64_t>(-1));
@@ -425,15 +492,15 @@ Value expr_indexOf(const std::vector<Value> &args) {
   }
 }
 
-Value expr_lastIndexOf(const std::vector<Value> &args) {
+Value expr_lastIndexOf(std::span<const Value> args) {
   size_t pos = std::string::npos;
-  const std::string &arg_0 = args[0].asString();
-  const std::string &arg_1 = args[1].asString();
-  auto cur_pos = arg_0.find(arg_1, 0);
+  const StringArg arg_0(args[0]);
+  const StringArg arg_1(args[1]);
+  auto cur_pos = arg_0.view().find(arg_1.view(), 0);
 
   while (cur_pos != std::string::npos) {
     pos = cur_pos;
-    cur_pos = arg_0.find(arg_1, pos + 1);
+    cur_pos = arg_0.view().find(arg_1.view(), pos + 1);
   }
 
   if (pos == std::string::npos) {
@@ -443,7 +510,7 @@ Value expr_lastIndexOf(const std::vector<Value> &args) {
   }
 }
 
-Value expr_escapeJson(const std::vector<Value> &args) {
+Value expr_escapeJson(std::span<const Value> args) {
   const std::string &arg_0 = args[0].asString();
   rapidjson::StringBuffer buf;
   rapidjson::Writer<rapidjson::StringBuffer> writer(buf);
@@ -452,7 +519,7 @@ Value expr_escapeJson(const std::vector<Value> &args) {
   return Value(result.substr(1, result.length() - 2));
 }
 
-Value expr_unescapeJson(const std::vector<Value> &args) {
+Value expr_unescapeJson(std::span<const Value> args) {
   std::stringstream arg_0_ss;
   arg_0_ss << "[\"" << args[0].asString() << "\"]";
   rapidjson::Reader reader;
@@ -465,7 +532,7 @@ Value expr_unescapeJson(const std::vector<Value> &args) {
   }
 }
 
-Value expr_escapeHtml3(const std::vector<Value> &args) {
+Value expr_escapeHtml3(std::span<const Value> args) {
   return Value(utils::string::replaceMap(args[0].asString(), { { "!", "&excl;" }, { "\"", "&quot;" }, { "#", "&num;" }, { "$", "&dollar;" }, { "%", "&percnt;" }, { "&", "&amp;" },
                                                   { "'", "&apos;" }, { "(", "&lpar;" }, { ")", "&rpar;" }, { "*", "&ast;" }, { "+", "&plus;" }, { ",", "&comma;" }, { "-", "&minus;" }, { ".",
                                                       "&period;" }, { "/", "&sol;" }, { ":", "&colon;" }, { ";", "&semi;" }, { "<", "&lt;" }, { "=", "&equals;" }, { ">", "&gt;" }, { "?", "&quest;" },
@@ -486,7 +553,7 @@ Value expr_escapeHtml3(const std::vector<Value> &args) {
                                                       "&ugrave;" }, { "ú", "&uacute;" }, { "û", "&ucirc;" }, { "ü", "&uuml;" }, { "ý", "&yacute;" }, { "þ", "&thorn;" }, { "ÿ", "&yuml;" } }));
 }
 
-Value expr_escapeHtml4(const std::vector<Value> &args) {
+Value expr_escapeHtml4(std::span<const Value> args) {
   return Value(utils::string::replaceMap(args[0].asString(), { { "!", "&excl;" }, { "\"", "&quot;" }, { "#", "&num;" }, { "$", "&dollar;" }, { "%", "&percnt;" }, { "&", "&amp;" },
                                                   { "'", "&apos;" }, { "(", "&lpar;" }, { ")", "&rpar;" }, { "*", "&ast;" }, { "+", "&plus;" }, { ",", "&comma;" }, { "-", "&minus;" }, { ".",
                                                       "&period;" }, { "/", "&sol;" }, { ":", "&colon;" }, { ";", "&semi;" }, { "<", "&lt;" }, { "=", "&equals;" }, { ">", "&gt;" }, { "?", "&quest;" },
@@ -534,7 +601,7 @@ Value expr_escapeHtml4(const std::vector<Value> &args) {
                                                       "&rsaquo;" }, { "\u20AC", "&euro;" } }));
 }
 
-Value expr_unescapeHtml3(const std::vector<Value> &args) {
+Value expr_unescapeHtml3(std::span<const Value> args) {
   return Value(utils::string::replaceMap(args[0].asString(), { { "&excl;", "!" }, { "&quot;", "\"" }, { "&num;", "#" }, { "&dollar;", "$" }, { "&percnt;", "%" }, { "&amp;", "&" },
                                                   { "&apos;", "'" }, { "&lpar;", "(" }, { "&rpar;", ")" }, { "&ast;", "*" }, { "&plus;", "+" }, { "&comma;", "," }, { "&minus;", "-" }, { "&period;",
                                                       "." }, { "&sol;", "/" }, { "&colon;", ":" }, { "&semi;", ";" }, { "&lt;", "<" }, { "&equals;", "=" }, { "&gt;", ">" }, { "&quest;", "?" }, {
@@ -555,7 +622,7 @@ Value expr_unescapeHtml3(const std::vector<Value> &args) {
                                                       "&uacute;", "ú" }, { "&ucirc;", "û" }, { "&uuml;", "ü" }, { "&yacute;", "ý" }, { "&thorn;", "þ" }, { "&yuml;", "ÿ" } }));
 }
 
-Value expr_unescapeHtml4(const std::vector<Value> &args) {
+Value expr_unescapeHtml4(std::span<const Value> args) {
   return Value(utils::string::replaceMap(args[0].asString(), { { "&excl;", "!" }, { "&quot;", "\"" }, { "&num;", "#" }, { "&dollar;", "$" }, { "&percnt;", "%" }, { "&amp;", "&" },
                                                   { "&apos;", "'" }, { "&lpar;", "(" }, { "&rpar;", ")" }, { "&ast;", "*" }, { "&plus;", "+" }, { "&comma;", "," }, { "&minus;", "-" }, { "&period;",
                                                       "." }, { "&sol;", "/" }, { "&colon;", ":" }, { "&semi;", ";" }, { "&lt;", "<" }, { "&equals;", "=" }, { "&gt;", ">" }, { "&quest;", "?" }, {
@@ -603,15 +670,15 @@ Value expr_unescapeHtml4(const std::vector<Value> &args) {
                                                       "\u203A" }, { "&euro;", "\u20AC" } }));
 }
 
-Value expr_escapeXml(const std::vector<Value> &args) {
+Value expr_escapeXml(std::span<const Value> args) {
   return Value(utils::string::replaceMap(args[0].asString(), { { "\"", "&quot;" }, { "'", "&apos;" }, { "<", "&lt;" }, { ">", "&gt;" }, { "&", "&amp;" } }));
 }
 
-Value expr_unescapeXml(const std::vector<Value> &args) {
+Value expr_unescapeXml(std::span<const Value> args) {
   return Value(utils::string::replaceMap(args[0].asString(), { { "&quot;", "\"" }, { "&apos;", "'" }, { "&lt;", "<" }, { "&gt;", ">" }, { "&amp;", "&" } }));
 }
 
-Value expr_escapeCsv(const std::vector<Value> &args) {
+Value expr_escapeCsv(std::span<const Value> args) {
   auto result = args[0].asString();
   const std::array<char, 4> quote_req_chars = { '"', '\r', '\n', ',' };
   bool quote_required = false;
@@ -633,7 +700,7 @@ Value expr_escapeCsv(const std::vector<Value> &args) {
   return Value(result);
 }
 
-Value expr_format(const std::vector<Value> &args) {
+Value expr_format(std::span<const Value> args) {
   using std::chrono::milliseconds;
 
   const date::sys_time<milliseconds> utc_time_point{milliseconds(args[0].asUnsignedLong())};
@@ -646,7 +713,7 @@ Value expr_format(const std::vector<Value> &args) {
   return Value(result_stream.str());
 }
 
-Value expr_toDate(const std::vector<Value> &args) {
+Value expr_toDate(std::span<const Value> args) {
   using std::chrono::milliseconds;
   auto input_string = args[0].asString();
 
@@ -671,12 +738,12 @@ Value expr_toDate(const std::vector<Value> &args) {
   return Value(int64_t{std::chrono::duration_cast<milliseconds>(zoned_time_point.get_sys_time().time_since_epoch()).count()});
 }
 
-Value expr_now(const std::vector<Value>& /*args*/) {
+Value expr_now(std::span<const Value> /*args*/) {
   using std::chrono::milliseconds;
   return Value(int64_t{std::chrono::duration_cast<milliseconds>(std::chrono::system_clock::now().time_since_epoch()).count()});
 }
 
-Value expr_unescapeCsv(const std::vector<Value> &args) {
+Value expr_unescapeCsv(std::span<const Value> args) {
   auto result = args[0].asString();
 
   if (result[0] == '"' && result[result.size() - 1] == '"') {
@@ -705,7 +772,7 @@ Value expr_unescapeCsv(const std::vector<Value> &args) {
   return Value(result);
 }
 
-Value expr_urlEncode(const std::vector<Value> &args) {
+Value expr_urlEncode(std::span<const Value> args) {
   auto arg_0 = args[0].asString();
   CURL *curl = curl_easy_init();
   if (curl != nullptr) {
@@ -724,7 +791,7 @@ Value expr_urlEncode(const std::vector<Value> &args) {
   }
 }
 
-Value expr_urlDecode(const std::vector<Value> &args) {
+Value expr_urlDecode(std::span<const Value> args) {
   auto arg_0 = args[0].asString();
   CURL *curl = curl_easy_init();
   if (curl != nullptr) {
@@ -744,15 +811,15 @@ Value expr_urlDecode(const std::vector<Value> &args) {
   }
 }
 
-Value expr_base64Encode(const std::vector<Value> &args) {
+Value expr_base64Encode(std::span<const Value> args) {
   return Value(utils::string::to_base64(args[0].asString()));
 }
 
-Value expr_base64Decode(const std::vector<Value> &args) {
+Value expr_base64Decode(std::span<const Value> args) {
   return Value(utils::string::from_base64(args[0].asString(), utils::as_string));
 }
 
-Value expr_replace(const std::vector<Value> &args) {
+Value expr_replace(std::span<const Value> args) {
   std::string result = args[0].asString();
   const std::string &find = args[1].asString();
   const std::string &replace = args[2].asString();
@@ -768,21 +835,15 @@ Value expr_replace(const std::vector<Value> &args) {
   return Value(result);
 }
 
-Value expr_replaceFirst(const std::vector<Value> &args) {
-  std::string result = args[0].asString();
-  const std::regex find(args[1].asString());
-  const std::string &replace = args[2].asString();
-  return Value(std::regex_replace(result, find, replace, std::regex_constants::format_first_only));
+Value expr_replaceFirst(std::span<const Value> args, const regex::CompiledRegex& find) {
+  return Value(find.replace(StringArg(args[0]).view(), StringArg(args[2]).view(), true));
 }
 
-Value expr_replaceAll(const std::vector<Value> &args) {
-  std::string result = args[0].asString();
-  const std::regex find(args[1].asString());
-  const std::string &replace = args[2].asString();
-  return Value(std::regex_replace(result, find, replace));
+Value expr_replaceAll(std::span<const Value> args, const regex::CompiledRegex& find) {
+  return Value(find.replace(StringArg(args[0]).view(), StringArg(args[2]).view(), false));
 }
 
-Value expr_replaceNull(const std::vector<Value> &args) {
+Value expr_replaceNull(std::span<const Value> args) {
   if (args[0].isNull()) {
     return args[1];
   } else {
@@ -790,47 +851,43 @@ Value expr_replaceNull(const std::vector<Value> &args) {
   }
 }
 
-Value expr_replaceEmpty(const std::vector<Value> &args) {
-  std::string result = args[0].asString();
-  const std::regex find("^[ \n\r\t]*$");
-  const std::string &replace = args[1].asString();
-  return Value(std::regex_replace(result, find, replace));
+Value expr_replaceEmpty(std::span<const Value> args) {
+  // same as replacing the pattern ^[ \n\r\t]*$, without compiling it
+  const StringArg subject(args[0]);
+  if (std::all_of(subject.view().begin(), subject.view().end(), [](char c) { return c == ' ' || c == '\n' || c == '\r' || c == '\t'; })) {
+    return Value(args[1].asString());
+  }
+  return Value(std::string(subject.view()));
 }
 
-Value expr_matches(const std::vector<Value> &args) {
-  const auto &subject = args[0].asString();
-  const auto expr = utils::Regex(args[1].asString());
-
-  return Value(utils::regexMatch(subject, expr));
+Value expr_matches(std::span<const Value> args, const regex::CompiledRegex& expr) {
+  return Value(expr.matches(StringArg(args[0]).view()));
 }
 
-Value expr_find(const std::vector<Value> &args) {
-  const auto &subject = args[0].asString();
-  const auto expr = utils::Regex(args[1].asString());
-
-  return Value(utils::regexSearch(subject, expr));
+Value expr_find(std::span<const Value> args, const regex::CompiledRegex& expr) {
+  return Value(expr.find(StringArg(args[0]).view()));
 }
 
-Value expr_trim(const std::vector<Value> &args) {
+Value expr_trim(std::span<const Value> args) {
   return Value{utils::string::trim(args[0].asString())};
 }
 
-Value expr_append(const std::vector<Value> &args) {
+Value expr_append(std::span<const Value> args) {
   std::string result = args[0].asString();
-  return Value(result.append(args[1].asString()));
+  return Value(result.append(StringArg(args[1]).view()));
 }
 
-Value expr_prepend(const std::vector<Value> &args) {
+Value expr_prepend(std::span<const Value> args) {
   std::string result = args[1].asString();
-  return Value(result.append(args[0].asString()));
+  return Value(result.append(StringArg(args[0]).view()));
 }
 
-Value expr_length(const std::vector<Value> &args) {
-  uint64_t len = args[0].asString().length();
+Value expr_length(std::span<const Value> args) {
+  uint64_t len = StringArg(args[0]).view().length();
   return Value(len);
 }
 
-Value expr_binary_op(const std::vector<Value> &args, long double (*ldop)(long double, long double), int64_t (*iop)(int64_t, int64_t), bool long_only = false) {
+Value expr_binary_op(std::span<const Value> args, long double (*ldop)(long double, long double), int64_t (*iop)(int64_t, int64_t), bool long_only = false) {
   try {
     if (!long_only && !args[0].isDecimal() && !args[1].isDecimal()) {
       return Value(iop(args[0].asSignedLong(), args[1].asSignedLong()));
@@ -842,27 +899,27 @@ Value expr_binary_op(const std::vector<Value> &args, long double (*ldop)(long do
   }
 }
 
-Value expr_plus(const std::vector<Value> &args) {
+Value expr_plus(std::span<const Value> args) {
   return expr_binary_op(args, [](long double a, long double b) {return a + b;}, [](int64_t a, int64_t b) {return a + b;});
 }
 
-Value expr_minus(const std::vector<Value> &args) {
+Value expr_minus(std::span<const Value> args) {
   return expr_binary_op(args, [](long double a, long double b) {return a - b;}, [](int64_t a, int64_t b) {return a - b;});
 }
 
-Value expr_multiply(const std::vector<Value> &args) {
+Value expr_multiply(std::span<const Value> args) {
   return expr_binary_op(args, [](long double a, long double b) {return a * b;}, [](int64_t a, int64_t b) {return a * b;});
 }
 
-Value expr_divide(const std::vector<Value> &args) {
+Value expr_divide(std::span<const Value> args) {
   return expr_binary_op(args, [](long double a, long double b) {return a / b;}, [](int64_t a, int64_t b) {return a / b;}, true);
 }
 
-Value expr_mod(const std::vector<Value> &args) {
+Value expr_mod(std::span<const Value> args) {
   return expr_binary_op(args, [](long double a, long double b) {return std::fmod(a, b);}, [](int64_t a, int64_t b) {return a % b;});
 }
 
-Value expr_toRadix(const std::vector<Value> &args) {
+Value expr_toRadix(std::span<const Value> args) {
   int64_t radix = args[1].asSignedLong();
 
   if (radix < 2 || radix > 36) {
@@ -900,7 +957,7 @@ Value expr_toRadix(const std::vector<Value> &args) {
   return Value(ss.str());
 }
 
-Value expr_fromRadix(const std::vector<Value> &args) {
+Value expr_fromRadix(std::span<const Value> args) {
   int radix = gsl::narrow<int>(args[1].asSignedLong());
 
   if (radix < 2 || radix > 36) {
@@ -910,15 +967,14 @@ Value expr_fromRadix(const std::vector<Value> &args) {
   return Value(std::to_string(std::stoll(args[0].asString(), nullptr, radix)));
 }
 
-Value expr_random(const std::vector<Value>& /*args*/) {
+Value expr_random(std::span<const Value> /*args*/) {
   std::random_device random_device;
   std::mt19937 generator(random_device());
   std::uniform_int_distribution<int64_t> distribution(0, LLONG_MAX);
   return Value(distribution(generator));
 }
 
-template<Value T(const std::vector<Value> &)>
-Expression make_dynamic_function_incomplete(const std::string &function_name, const std::vector<Expression> &args, std::size_t num_args) {
+Expression make_function_expression(const std::string &function_name, const std::vector<Expression> &args, std::size_t num_args, Function function) {
   if (args.size() < num_args) {
     std::stringstream message_ss;
     message_ss << "Expression language function " << function_name << " called with " << args.size() << " argument(s), but " << num_args << " are required";
@@ -933,42 +989,78 @@ Expression make_dynamic_function_incomplete(const std::string &function_name, co
     }
 
     return args[0].compose_multi([=](const std::vector<Value> &args) -> Value {
-      return T(args);
+      return function(args);
     },
                                  multi_args);
   } else {
-    return make_dynamic([=](const Parameters &params, const std::vector<Expression>& /*sub_exprs*/) -> Value {
+    auto expression = make_dynamic([=](const Parameters &params, const std::vector<Expression>& /*sub_exprs*/) -> Value {
       std::vector<Value> evaluated_args;
       evaluated_args.reserve(args.size());
       for (const auto &arg : args) {
         evaluated_args.emplace_back(arg(params));
       }
 
-      return T(evaluated_args);
+      return function(evaluated_args);
     });
+    expression.set_node(make_node({.type = ExpressionNode::Type::Function, .name = function_name, .function = function, .pure = is_pure(function_name), .args = args}));
+    return expression;
+  }
+}
+
+template<Value T(std::span<const Value>)>
+Expression make_dynamic_function_incomplete(const std::string &function_name, const std::vector<Expression> &args, std::size_t num_args) {
+  return make_function_expression(function_name, args, num_args, T);
+}
+
+std::shared_ptr<const regex::CompiledRegex> literal_regex(const Expression &pattern) {
+  const auto* node = pattern.node();
+  if (!node || node->type != ExpressionNode::Type::Constant) {
+    return nullptr;
+  }
+  return regex::RegexCache::getInstance().get(node->value.asString());
+}
+
+template<Value T(std::span<const Value>, const regex::CompiledRegex&)>
+Value expr_with_cached_regex(std::span<const Value> args) {
+  return T(args, *regex::RegexCache::getInstance().get(StringArg(args[1]).view()));
+}
+
+/**
+ * The pattern is the second argument of the regular expression functions. A literal pattern is compiled when the expression
+ * is parsed, otherwise the compiled pattern is looked up in the process-wide cache on each evaluation.
+ */
+template<Value T(std::span<const Value>, const regex::CompiledRegex&)>
+Expression make_regex_function(const std::string &function_name, const std::vector<Expression> &args, std::size_t num_args) {
+  if (args.size() > 1) {
+    if (auto compiled_regex = literal_regex(args[1])) {
+      return make_function_expression(function_name, args, num_args, [compiled_regex](std::span<const Value> args) {
+        return T(args, *compiled_regex);
+      });
+    }
   }
+  return make_function_expression(function_name, args, num_args, expr_with_cached_regex<T>);
 }
 
-Value expr_literal(const std::vector<Value> &args) {
+Value expr_literal(std::span<const Value> args) {
   return args[0];
 }
 
-Value expr_isNull(const std::vector<Value> &args) {
+Value expr_isNull(std::span<const Value> args) {
   return Value(args[0].isNull());
 }
 
-Value expr_notNull(const std::vector<Value> &args) {
+Value expr_notNull(std::span<const Value> args) {
   return Value(!args[0].isNull());
 }
 
-Value expr_isEmpty(const std::vector<Value> &args) {
+Value expr_isEmpty(std::span<const Value> args) {
   if (args[0].isNull()) {
     return Value(true);
   }
 
-  std::string arg_0 = args[0].asString();
+  const StringArg arg_0(args[0]);
 
-  for (char c : arg_0) {
+  for (char c : arg_0.view()) {
     if (c != ' ' && c != '\f' && c != '\n' && c != '\r' && c != '\t' && c != '\v') {
       return Value(false);
     }
@@ -977,21 +1069,15 @@ Value expr_isEmpty(const std::vector<Value> &args) {
   return Value(true);
 }
 
-Value expr_equals(const std::vector<Value> &args) {
-  return Value(args[0].asString() == args[1].asString());
+Value expr_equals(std::span<const Value> args) {
+  return Value(StringArg(args[0]).view() == StringArg(args[1]).view());
 }
 
-Value expr_equalsIgnoreCase(const std::vector<Value> &args) {
-  auto arg_0 = args[0].asString();
-  auto arg_1 = args[1].asString();
-
-  std::transform(arg_0.begin(), arg_0.end(), arg_0.begin(), ::tolower);
-  std::transform(arg_1.begin(), arg_1.end(), arg_1.begin(), ::tolower);
-
-  return Value(arg_0 == arg_1);
+Value expr_equalsIgnoreCase(std::span<const Value> args) {
+  return Value(utils::string::equalsIgnoreCase(StringArg(args[0]).view(), StringArg(args[1]).view()));
 }
 
-Value expr_gt(const std::vector<Value> &args) {
+Value expr_gt(std::span<const Value> args) {
   if (args[0].isDecimal() && args[1].isDecimal()) {
     return Value(args[0].asLongDouble() > args[1].asLongDouble());
   } else {
@@ -999,7 +1085,7 @@ Value expr_gt(const std::vector<Value> &args) {
   }
 }
 
-Value expr_ge(const std::vector<Value> &args) {
+Value expr_ge(std::span<const Value> args) {
   if (args[0].isDecimal() && args[1].isDecimal()) {
     return Value(args[0].asLongDouble() >= args[1].asLongDouble());
   } else {
@@ -1007,7 +1093,7 @@ Value expr_ge(const std::vector<Value> &args) {
   }
 }
 
-Value expr_lt(const std::vector<Value> &args) {
+Value expr_lt(std::span<const Value> args) {
   if (args[0].isDecimal() && args[1].isDecimal()) {
     return Value(args[0].asLongDouble() < args[1].asLongDouble());
   } else {
@@ -1015,7 +1101,7 @@ Value expr_lt(const std::vector<Value> &args) {
   }
 }
 
-Value expr_le(const std::vector<Value> &args) {
+Value expr_le(std::span<const Value> args) {
   if (args[0].isDecimal() && args[1].isDecimal()) {
     return Value(args[0].asLongDouble() <= args[1].asLongDouble());
   } else {
@@ -1023,19 +1109,19 @@ Value expr_le(const std::vector<Value> &args) {
   }
 }
 
-Value expr_and(const std::vector<Value> &args) {
+Value expr_and(std::span<const Value> args) {
   return Value(args[0].asBoolean() && args[1].asBoolean());
 }
 
-Value expr_or(const std::vector<Value> &args) {
+Value expr_or(std::span<const Value> args) {
   return Value(args[0].asBoolean() || args[1].asBoolean());
 }
 
-Value expr_not(const std::vector<Value> &args) {
+Value expr_not(std::span<const Value> args) {
   return Value(!args[0].asBoolean());
 }
 
-Value expr_ifElse(const std::vector<Value> &args) {
+Value expr_ifElse(std::span<const Value> args) {
   if (args[0].asBoolean()) {
     return args[1];
   } else {
@@ -1043,7 +1129,7 @@ Value expr_ifElse(const std::vector<Value> &args) {
   }
 }
 
-Value expr_nextInt(const std::vector<Value>&) {
+Value expr_nextInt(std::span<const Value>) {
   static std::atomic<int64_t> counter{0};
   return Value(counter++);
 }
@@ -1145,6 +1231,9 @@ Expression make_allMatchingAttributes(const std::string &function_name, const st
     throw std::runtime_error(message_ss.str());
   }
 
+  std::vector<std::shared_ptr<const regex::CompiledRegex>> literal_regexes;
+  std::transform(args.begin(), args.end(), std::back_inserter(literal_regexes), literal_regex);
+
   auto result = make_dynamic([=](const Parameters &params, const std::vector<Expression> &sub_exprs) -> Value {
     std::vector<Value> evaluated_args;
 
@@ -1160,8 +1249,8 @@ Expression make_allMatchingAttributes(const std::string &function_name, const st
   result.make_multi([=](const Parameters &params) -> std::vector<Expression> {
     std::vector<Expression> out_exprs;
 
-    for (const auto &arg : args) {
-      const auto attr_regex = utils::Regex(arg(params).asString());
+    for (size_t i = 0; i < args.size(); ++i) {
+      const auto attr_regex = literal_regexes[i] ? literal_regexes[i] : regex::RegexCache::getInstance().get(args[i](params).asString());
       const auto cur_flow_file = params.flow_file;
       std::map<std::string, std::string> attrs;
 
@@ -1170,7 +1259,7 @@ Expression make_allMatchingAttributes(const std::string &function_name, const st
       }
 
       for (const auto &attr : attrs) {
-        if (utils::regexMatch(attr.first, attr_regex)) {
+        if (attr_regex->matches(attr.first)) {
           out_exprs.emplace_back(make_dynamic([=](const Parameters& /*params*/,
                       const std::vector<Expression>& /*sub_exprs*/) -> Value {
                     std::string attr_val;
@@ -1198,6 +1287,9 @@ Expression make_anyMatchingAttribute(const std::string &function_name, const std
     throw std::runtime_error(message_ss.str());
   }
 
+  std::vector<std::shared_ptr<const regex::CompiledRegex>> literal_regexes;
+  std::transform(args.begin(), args.end(), std::back_inserter(literal_regexes), literal_regex);
+
   auto result = make_dynamic([=](const Parameters &params, const std::vector<Expression> &sub_exprs) -> Value {
     std::vector<Value> evaluated_args;
 
@@ -1213,8 +1305,8 @@ Expression make_anyMatchingAttribute(const std::string &function_name, const std
   result.make_multi([=](const Parameters &params) -> std::vector<Expression> {
     std::vector<Expression> out_exprs;
 
-    for (const auto &arg : args) {
-      const auto attr_regex = utils::Regex(arg(params).asString());
+    for (size_t i = 0; i < args.size(); ++i) {
+      const auto attr_regex = literal_regexes[i] ? literal_regexes[i] : regex::RegexCache::getInstance().get(args[i](params).asString());
       const auto cur_flow_file = params.flow_file;
       std::map<std::string, std::string> attrs;
 
@@ -1223,7 +1315,7 @@ Expression make_anyMatchingAttribute(const std::string &function_name, const std
       }
 
       for (const auto &attr : attrs) {
-        if (utils::regexMatch(attr.first, attr_regex)) {
+        if (attr_regex->matches(attr.first)) {
           out_exprs.emplace_back(make_dynamic([=](const Parameters& /*params*/,
                       const std::vector<Expression>& /*sub_exprs*/) -> Value {
                     std::string attr_val;
@@ -1436,17 +1528,17 @@ Expression make_dynamic_function(const std::string &function_name, const std::ve
   } else if (function_name == "replace") {
     return make_dynamic_function_incomplete<expr_replace>(function_name, args, 2);
   } else if (function_name == "replaceFirst") {
-    return make_dynamic_function_incomplete<expr_replaceFirst>(function_name, args, 2);
+    return make_regex_function<expr_replaceFirst>(function_name, args, 2);
   } else if (function_name == "replaceAll") {
-    return make_dynamic_function_incomplete<expr_replaceAll>(function_name, args, 2);
+    return make_regex_function<expr_replaceAll>(function_name, args, 2);
   } else if (function_name == "replaceNull") {
     return make_dynamic_function_incomplete<expr_replaceNull>(function_name, args, 1);
   } else if (function_name == "replaceEmpty") {
     return make_dynamic_function_incomplete<expr_replaceEmpty>(function_name, args, 1);
   } else if (function_name == "matches") {
-    return make_dynamic_function_incomplete<expr_matches>(function_name, args, 1);
+    return make_regex_function<expr_matches>(function_name, args, 1);
   } else if (function_name == "find") {
-    return make_dynamic_function_incomplete<expr_find>(function_name, args, 1);
+    return make_regex_function<expr_find>(function_name, args, 1);
   } else if (function_name == "allMatchingAttributes") {
     return make_allMatchingAttributes(function_name, args);
   } else if (function_name == "anyMatchingAttribute") {
@@ -1547,6 +1639,14 @@ bool Expression::is_dynamic() const {
 }
 
 Expression Expression::operator+(const Expression &other_expr) const {
+  auto result = concatenate(other_expr);
+  if (result.is_dynamic()) {
+    result.node_ = make_node({.type = ExpressionNode::Type::Concat, .args = {*this, other_expr}});
+  }
+  return result;
+}
+
+Expression Expression::concatenate(const Expression &other_expr) const {
   if (is_dynamic() && other_expr.is_dynamic()) {
     auto val_fn = val_fn_;
     auto other_val_fn = other_expr.val_fn_;
@@ -1591,6 +1691,25 @@ Expression Expression::operator+(const Expression &other_expr) const {
 }
 
 Value Expression::operator()(const Parameters &params) const {
+  if (program_) {
+    return program_->run(params);
+  }
+  return evaluate_tree(params);
+}
+
+std::vector<Value> Expression::evaluate_batch(const core::VariableRegistry* registry, std::span<const std::shared_ptr<core::FlowFile>> flow_files) const {
+  if (program_) {
+    return program_->runBatch(registry, flow_files);
+  }
+  std::vector<Value> results;
+  results.reserve(flow_files.size());
+  for (const auto& flow_file : flow_files) {
+    results.push_back(evaluate_tree(Parameters{registry, flow_file.get()}));
+  }
+  return results;
+}
+
+Value Expression::evaluate_tree(const Parameters &params) const {
   if (is_dynamic()) {
     return val_fn_(params, sub_expr_generator_(params));
   } else {
@@ -0,0 +1,174 @@
+/**
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The ASF licenses this file to You under the Apache License, Version 2.0
+ * (the "License"); you may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "expression-language/RegexCache.h"
+
+#include <iterator>
+#include <optional>
+#include <regex>
+#include <vector>
+
+#include "utils/LinearRegex.h"
+#include "utils/RegexUtils.h"
+
+namespace org::apache::nifi::minifi::expression::regex {
+
+namespace {
+// matching uses utils::Regex and replacing uses std::regex like before the cache, each is compiled on first use,
+// so an invalid pattern is reported by the function evaluating it
+class StandardRegex final : public CompiledRegex {
+ public:
+  StandardRegex(std::string pattern, bool case_insensitive) : pattern_(std::move(pattern)), case_insensitive_(case_insensitive) {}
+
+  [[nodiscard]] bool matches(std::string_view subject) const override {
+    return utils::regexMatch(subject, matcher());
+  }
+
+  [[nodiscard]] bool find(std::string_view subject) const override {
+    return utils::regexSearch(subject, matcher());
+  }
+
+  [[nodiscard]] std::string replace(std::string_view subject, std::string_view replacement, bool first_only) const override {
+    std::call_once(replacer_flag_, [this] {
+      replacer_.emplace(pattern_, case_insensitive_ ? std::regex::ECMAScript | std::regex::icase : std::regex::ECMAScript);
+    });
+    std::string result;
+    std::regex_replace(std::back_inserter(result), subject.begin(), subject.end(), *replacer_, std::string(replacement),
+        first_only ? std::regex_constants::format_first_only : std::regex_constants::format_default);
+    return result;
+  }
+
+ private:
+  const utils::Regex& matcher() const {
+    std::call_once(matcher_flag_, [this] {
+      matcher_.emplace(pattern_, case_insensitive_ ? std::vector<utils::Regex::Mode>{utils::Regex::Mode::ICASE} : std::vector<utils::Regex::Mode>{});
+    });
+    return *matcher_;
+  }
+
+  std::string pattern_;
+  bool case_insensitive_;
+  mutable std::once_flag matcher_flag_;
+  mutable std::optional<utils::Regex> matcher_;
+  mutable std::once_flag replacer_flag_;
+  mutable std::optional<std::regex> replacer_;
+};
+
+class LinearEngineRegex final : public CompiledRegex {
+ public:
+  explicit LinearEngineRegex(utils::LinearRegex regex) : regex_(std::move(regex)) {}
+
+  [[nodiscard]] bool matches(std::string_view subject) const override {
+    return regex_.fullMatch(subject);
+  }
+
+  [[nodiscard]] bool find(std::string_view subject) const override {
+    return regex_.search(subject);
+  }
+
+  [[nodiscard]] std::string replace(std::string_view subject, std::string_view replacement, bool first_only) const override {
+    return regex_.replace(subject, replacement, first_only);
+  }
+
+ private:
+  utils::LinearRegex regex_;
+};
+}  // namespace
+
+std::shared_ptr<const CompiledRegex> compile(std::string pattern, Engine engine, bool case_insensitive) {
+  if (engine == Engine::Linear) {
+    if (auto linear_regex = utils::LinearRegex::compile(pattern, case_insensitive)) {
+      return std::make_shared<LinearEngineRegex>(std::move(*linear_regex));
+    }
+  }
+  return std::make_shared<StandardRegex>(std::move(pattern), case_insensitive);
+}
+
+RegexCache& RegexCache::getInstance() {
+  static RegexCache instance;
+  return instance;
+}
+
+std::shared_ptr<const CompiledRegex> RegexCache::get(std::string_view pattern, bool case_insensitive) {
+  Engine engine;
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (const auto it = index_.find(Key{pattern, case_insensitive}); it != index_.end()) {
+      entries_.splice(entries_.begin(), entries_, it->second);
+      return it->second->regex;
+    }
+    engine = engine_;
+  }
+
+  // compiled outside the lock, if two threads miss the same pattern, the second one reuses the entry of the first one
+  auto regex = compile(std::string(pattern), engine, case_insensitive);
+
+  std::lock_guard<std::mutex> lock(mutex_);
+  if (engine != engine_) {
+    return regex;
+  }
+  if (const auto it = index_.find(Key{pattern, case_insensitive}); it != index_.end()) {
+    return it->second->regex;
+  }
+  if (capacity_ == 0) {
+    return regex;
+  }
+  entries_.push_front(Entry{std::string(pattern), case_insensitive, regex});
+  index_.emplace(Key{entries_.front().pattern, case_insensitive}, entries_.begin());
+  evict();
+  return regex;
+}
+
+void RegexCache::setEngine(Engine engine) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  if (engine_ != engine) {
+    engine_ = engine;
+    index_.clear();
+    entries_.clear();
+  }
+}
+
+Engine RegexCache::getEngine() const {
+  std::lock_guard<std::mutex> lock(mutex_);
+  return engine_;
+}
+
+void RegexCache::setCapacity(size_t capacity) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  capacity_ = capacity;
+  evict();
+}
+
+size_t RegexCache::size() const {
+  std::lock_guard<std::mutex> lock(mutex_);
+  return entries_.size();
+}
+
+void RegexCache::clear() {
+  std::lock_guard<std::mutex> lock(mutex_);
+  index_.clear();
+  entries_.clear();
+}
+
+void RegexCache::evict() {
+  while (entries_.size() > capacity_) {
+    index_.erase(Key{entries_.back().pattern, entries_.back().case_insensitive});
+    entries_.pop_back();
+  }
+}
+
+}  // namespace org::apache::nifi::minifi::expression::regex
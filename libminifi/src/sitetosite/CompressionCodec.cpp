@@ -0,0 +1,107 @@
+/**
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The ASF licenses this file to You under the Apache License, Version 2.0
+ * (the "License"); you may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "sitetosite/CompressionCodec.h"
+
+#include <zlib.h>
+#include <zstd.h>
+#include <lz4.h>
+
+#include "minifi-cpp/utils/gsl.h"
+#include "utils/StringUtils.h"
+
+namespace org::apache::nifi::minifi::sitetosite {
+
+namespace {
+// zstd level 1 and zlib Z_BEST_SPEED, the point of compressing S2S traffic is to save bandwidth without stalling the sender
+constexpr int ZSTD_COMPRESSION_LEVEL = 1;
+}  // namespace
+
+std::optional<CompressionCodec> parseCompressionCodec(std::string_view name) {
+  for (const auto codec : {CompressionCodec::ZLIB, CompressionCodec::LZ4, CompressionCodec::ZSTD}) {
+    if (utils::string::equalsIgnoreCase(name, compressionCodecName(codec))) {
+      return codec;
+    }
+  }
+  return std::nullopt;
+}
+
+std::string_view compressionCodecName(CompressionCodec codec) {
+  switch (codec) {
+    case CompressionCodec::ZLIB: return "zlib";
+    case CompressionCodec::LZ4: return "lz4";
+    case CompressionCodec::ZSTD: return "zstd";
+  }
+  return "zlib";
+}
+
+std::optional<std::vector<std::byte>> compressBlock(CompressionCodec codec, std::span<const std::byte> block) {
+  std::vector<std::byte> compressed;
+  switch (codec) {
+    case CompressionCodec::ZLIB: {
+      uLongf compressed_size = compressBound(gsl::narrow<uLong>(block.size()));
+      compressed.resize(compressed_size);
+      if (compress2(reinterpret_cast<Bytef*>(compressed.data()), &compressed_size, reinterpret_cast<const Bytef*>(block.data()), gsl::narrow<uLong>(block.size()), Z_BEST_SPEED) != Z_OK) {
+        return std::nullopt;
+      }
+      compressed.resize(compressed_size);
+      return compressed;
+    }
+    case CompressionCodec::LZ4: {
+      compressed.resize(gsl::narrow<size_t>(LZ4_compressBound(gsl::narrow<int>(block.size()))));
+      const int compressed_size = LZ4_compress_default(reinterpret_cast<const char*>(block.data()), reinterpret_cast<char*>(compressed.data()),
+          gsl::narrow<int>(block.size()), gsl::narrow<int>(compressed.size()));
+      if (compressed_size <= 0) {
+        return std::nullopt;
+      }
+      compressed.resize(gsl::narrow<size_t>(compressed_size));
+      return compressed;
+    }
+    case CompressionCodec::ZSTD: {
+      compressed.resize(ZSTD_compressBound(block.size()));
+      const size_t compressed_size = ZSTD_compress(compressed.data(), compressed.size(), block.data(), block.size(), ZSTD_COMPRESSION_LEVEL);
+      if (ZSTD_isError(compressed_size)) {
+        return std::nullopt;
+      }
+      compressed.resize(compressed_size);
+      return compressed;
+    }
+  }
+  return std::nullopt;
+}
+
+bool decompressBlock(CompressionCodec codec, std::span<const std::byte> compressed_block, std::span<std::byte> output) {
+  switch (codec) {
+    case CompressionCodec::ZLIB: {
+      uLongf decompressed_size = gsl::narrow<uLongf>(output.size());
+      return uncompress(reinterpret_cast<Bytef*>(output.data()), &decompressed_size, reinterpret_cast<const Bytef*>(compressed_block.data()),
+          gsl::narrow<uLong>(compressed_block.size())) == Z_OK && decompressed_size == output.size();
+    }
+    case CompressionCodec::LZ4: {
+      const int decompressed_size = LZ4_decompress_safe(reinterpret_cast<const char*>(compressed_block.data()), reinterpret_cast<char*>(output.data()),
+          gsl::narrow<int>(compressed_block.size()), gsl::narrow<int>(output.size()));
+      return decompressed_size >= 0 && gsl::narrow<size_t>(decompressed_size) == output.size();
+    }
+    case CompressionCodec::ZSTD: {
+      const size_t decompressed_size = ZSTD_decompress(output.data(), output.size(), compressed_block.data(), compressed_block.size());
+      return !ZSTD_isError(decompressed_size) && decompressed_size == output.size();
+    }
+  }
+  return false;
+}
+
+}  // namespace org::apache::nifi::minifi::sitetosite
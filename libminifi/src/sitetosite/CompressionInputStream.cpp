@@ -18,7 +18,6 @@
 #include "sitetosite/CompressionInputStream.h"
 
 #include <algorithm>
-#include "io/ZlibStream.h"
 
 namespace org::apache::nifi::minifi::sitetosite {
 
@@ -27,10 +26,9 @@ size_t CompressionInputStream::decompressData() {
     return 0;
   }
 
-  std::vector<std::byte> local_buffer(COMPRESSION_BUFFER_SIZE);
-  auto ret = internal_stream_.read(std::span(local_buffer).subspan(0, SYNC_BYTES.size()));
+  auto ret = internal_stream_.read(std::span(compressed_buffer_).subspan(0, SYNC_BYTES.size()));
   if (ret != SYNC_BYTES.size() ||
-      !std::equal(SYNC_BYTES.begin(), SYNC_BYTES.end(), local_buffer.begin(), [](char sync_char, std::byte read_byte) { return static_cast<std::byte>(sync_char) == read_byte;})) {
+      !std::equal(SYNC_BYTES.begin(), SYNC_BYTES.end(), compressed_buffer_.begin(), [](char sync_char, std::byte read_byte) { return static_cast<std::byte>(sync_char) == read_byte;})) {
     logger_->log_error("Failed to read sync bytes or sync bytes do not match");
     return io::STREAM_ERROR;
   }
@@ -54,7 +52,7 @@ size_t CompressionInputStream::decompressData() {
     return io::STREAM_ERROR;
   }
 
-  if (compressed_size > COMPRESSION_BUFFER_SIZE) {
+  if (compressed_size > MAX_COMPRESSED_BLOCK_SIZE) {
     logger_->log_error("Compressed size exceeds buffer size");
     return io::STREAM_ERROR;
   }
@@ -64,28 +62,15 @@ size_t CompressionInputStream::decompressData() {
     return io::STREAM_ERROR;
   }
 
-  ret = internal_stream_.read(std::span(local_buffer).subspan(0, compressed_size));
+  ret = internal_stream_.read(std::span(compressed_buffer_).subspan(0, compressed_size));
   if (io::isError(ret) || ret != compressed_size) {
     logger_->log_error("Failed to read compressed data, ret: {}", ret);
     return io::STREAM_ERROR;
   }
 
-  if (compressed_size != 0) {
-    io::BufferStream decompressed_data_stream;
-    io::ZlibDecompressStream zlib_stream{gsl::make_not_null(&decompressed_data_stream), io::ZlibCompressionFormat::ZLIB};
-    ret = zlib_stream.write(std::span(local_buffer).subspan(0, compressed_size));
-    if (io::isError(ret)) {
-      logger_->log_error("Failed to write compressed data to zlib stream, ret: {}", ret);
-      return ret;
-    }
-    zlib_stream.close();
-    gsl_Assert(zlib_stream.isFinished());
-
-    ret = decompressed_data_stream.read(std::span(buffer_).subspan(0, original_size));
-    if (io::isError(ret) || ret != original_size) {
-      logger_->log_error("Failed to read decompressed data, ret: {}", ret);
-      return io::STREAM_ERROR;
-    }
+  if (compressed_size != 0 && !decompressBlock(codec_, std::span(compressed_buffer_).subspan(0, compressed_size), std::span(buffer_).subspan(0, original_size))) {
+    logger_->log_error("Failed to decompress {} bytes of {} compressed data to {} bytes", compressed_size, compressionCodecName(codec_), original_size);
+    return io::STREAM_ERROR;
   }
 
   uint8_t end_byte = 0;
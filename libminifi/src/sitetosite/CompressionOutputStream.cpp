@@ -18,10 +18,9 @@
 #include "sitetosite/CompressionOutputStream.h"
 
 #include <algorithm>
+#include <optional>
+#include <vector>
 
-#include "io/ZlibStream.h"
-#include "io/StreamPipe.h"
-#include "io/BufferStream.h"
 #include "core/logging/LoggerFactory.h"
 
 namespace org::apache::nifi::minifi::sitetosite {
@@ -62,6 +61,53 @@ size_t CompressionOutputStream::write(const uint8_t *value, size_t len) {
 }
 
 size_t CompressionOutputStream::compressAndWrite() {
+  const auto data = std::span<const std::byte>(buffer_).subspan(0, buffer_offset_);
+  if (data.empty()) {
+    return 0;
+  }
+  std::vector<std::span<const std::byte>> blocks;
+  for (size_t offset = 0; offset < data.size(); offset += COMPRESSION_BUFFER_SIZE) {
+    blocks.push_back(data.subspan(offset, std::min(COMPRESSION_BUFFER_SIZE, data.size() - offset)));
+  }
+
+  if (blocks.size() > 1 && !compressor_pool_) {
+    // created on the first full buffer, so streams of a single block do not start any threads
+    compressor_pool_.emplace(buffer_.size() / COMPRESSION_BUFFER_SIZE - 1);
+  }
+  // on error or exception the remaining tasks still read the buffer, they have to finish before it can be reused; their results are not needed
+  const auto discard_pending_blocks = gsl::finally([this] {
+    while (compressor_pool_ && compressor_pool_->size() > 0) {
+      try {
+        compressor_pool_->takeNext();
+      } catch (...) {
+      }
+    }
+  });
+  for (size_t i = 1; i < blocks.size(); ++i) {
+    compressor_pool_->add([codec = codec_, block = blocks[i]] { return compressBlock(codec, block); });
+  }
+  // the first block is compressed on the calling thread, the rest are taken in order, so the framing stays sequential
+  auto first_compressed_block = compressBlock(codec_, blocks[0]);
+
+  size_t total_written = 0;
+  for (size_t i = 0; i < blocks.size(); ++i) {
+    const auto compressed_block = i == 0 ? std::move(first_compressed_block) : compressor_pool_->takeNext();
+    if (!compressed_block) {
+      logger_->log_error("Failed to compress block of {} bytes with {}", blocks[i].size(), compressionCodecName(codec_));
+      return io::STREAM_ERROR;
+    }
+    const auto ret = writeBlock(blocks[i], *compressed_block);
+    if (io::isError(ret)) {
+      return ret;
+    }
+    total_written += ret;
+  }
+
+  buffer_offset_ = 0;
+  return total_written;
+}
+
+size_t CompressionOutputStream::writeBlock(std::span<const std::byte> original_block, const std::vector<std::byte>& compressed_block) {
   if (was_data_written_) {
     // Write a continue byte to indicate that there is more data to follow
     const auto ret = internal_stream_.write(static_cast<uint8_t>(1));
@@ -76,40 +122,26 @@ size_t CompressionOutputStream::compressAndWrite() {
     return ret;
   }
 
-  io::BufferStream buffer_stream;
-  {
-    io::ZlibCompressStream zlib_stream{gsl::make_not_null(&buffer_stream), io::ZlibCompressionFormat::ZLIB, Z_BEST_SPEED};
-    const auto ret = zlib_stream.write(std::span(buffer_).subspan(0, buffer_offset_));
-    if (io::isError(ret)) {
-      logger_->log_error("Failed to write data to zlib stream: {}", ret);
-      return ret;
-    }
-    gsl_Assert(buffer_offset_ == ret);
-    zlib_stream.close();
-    gsl_Assert(zlib_stream.isFinished());
-  }
-
   // Write the original size of the data before compression
-
-  if (const auto ret = internal_stream_.write(gsl::narrow<uint32_t>(buffer_offset_)); io::isError(ret)) {
+  if (const auto ret = internal_stream_.write(gsl::narrow<uint32_t>(original_block.size())); io::isError(ret)) {
     logger_->log_error("Failed to write original size before compression: {}", ret);
     return ret;
   }
 
   // Write the compressed size of the data
-  if (const auto ret = internal_stream_.write(gsl::narrow<uint32_t>(buffer_stream.size())); io::isError(ret)) {
+  if (const auto ret = internal_stream_.write(gsl::narrow<uint32_t>(compressed_block.size())); io::isError(ret)) {
     return ret;
   }
 
   // Write the compressed data
-  const io::IoResult pipe_res = internal::pipe(buffer_stream, internal_stream_);
-  if (!pipe_res) {
+  const auto ret = internal_stream_.write(std::span<const std::byte>(compressed_block));
+  if (io::isError(ret) || ret != compressed_block.size()) {
+    logger_->log_error("Failed to write compressed data: {}", ret);
     return io::STREAM_ERROR;
   }
 
-  buffer_offset_ = 0;
   was_data_written_ = true;
-  return gsl::narrow<size_t>(pipe_res.toI64());
+  return ret;
 }
 
 void CompressionOutputStream::flush() {
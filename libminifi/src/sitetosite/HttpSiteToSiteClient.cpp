@@ -96,6 +96,7 @@ std::shared_ptr<Transaction> HttpSiteToSiteClient::createTransaction(TransferDir
   std::stringstream uri;
   uri << getBaseURI() << "data-transfer/" << dir_str << "/" << getPortId().to_string() << "/transactions";
   auto client = createHttpClient(uri.str(), http::HttpRequestMethod::Post);
+  compression_codec_ = preferred_compression_codec_.load();
   setSiteToSiteHeaders(*client);
   client->setConnectionTimeout(std::chrono::milliseconds(5000));
   client->setContentType("application/json");
@@ -129,6 +130,13 @@ std::shared_ptr<Transaction> HttpSiteToSiteClient::createTransaction(TransferDir
     return nullptr;
   }
 
+  // peers that do not support the codec ignore the header and expect zlib
+  if (use_compression_ && compression_codec_ != CompressionCodec::ZLIB
+      && client->getHeaderValue(HANDSHAKE_PROPERTY_COMPRESSION_CODEC) != compressionCodecName(compression_codec_)) {
+    logger_->log_debug("Peer did not accept {} compression, using zlib", compressionCodecName(compression_codec_));
+    compression_codec_ = CompressionCodec::ZLIB;
+  }
+
   org::apache::nifi::minifi::io::CRCStream<SiteToSitePeer> crcstream(gsl::make_not_null(peer_.get()));
   auto transaction = std::make_shared<HttpTransaction>(direction, std::move(crcstream));
   transaction->initialize(this, url);
@@ -284,6 +292,7 @@ std::string HttpSiteToSiteClient::getBaseURI() {
 std::unique_ptr<minifi::http::HTTPClient> HttpSiteToSiteClient::createHttpClient(const std::string &uri, http::HttpRequestMethod method) {
   auto http_client_ = std::make_unique<minifi::http::HTTPClient>(uri, ssl_context_service_);
   http_client_->initialize(method, uri, ssl_context_service_);
+  http_client_->setConnectionShare(connection_share_);
   if (!peer_->getInterface().empty()) {
     logger_->log_info("HTTP Site2Site bind local network interface {}", peer_->getInterface());
     http_client_->setInterface(peer_->getInterface());
@@ -386,6 +395,9 @@ void HttpSiteToSiteClient::deleteTransaction(const utils::Identifier& transactio
 void HttpSiteToSiteClient::setSiteToSiteHeaders(minifi::http::HTTPClient& client) {
   client.setRequestHeader(PROTOCOL_VERSION_HEADER, "1");
   client.setRequestHeader(HANDSHAKE_PROPERTY_USE_COMPRESSION, use_compression_ ? "true" : "false");
+  if (use_compression_ && compression_codec_ != CompressionCodec::ZLIB) {
+    client.setRequestHeader(HANDSHAKE_PROPERTY_COMPRESSION_CODEC, std::string{compressionCodecName(compression_codec_)});
+  }
   if (timeout_.load() > 0ms) {
     client.setRequestHeader(HANDSHAKE_PROPERTY_REQUEST_EXPIRATION, std::to_string(timeout_.load().count()));
   }
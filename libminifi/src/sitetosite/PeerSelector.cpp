@@ -0,0 +1,74 @@
+/**
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The ASF licenses this file to You under the Apache License, Version 2.0
+ * (the "License"); you may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "sitetosite/PeerSelector.h"
+
+#include <algorithm>
+#include <numeric>
+#include <utility>
+
+namespace org::apache::nifi::minifi::sitetosite {
+
+std::vector<double> PeerSelector::calculateWeights(TransferDirection direction, const std::vector<PeerStatus>& peers) {
+  const uint64_t total_flow_file_count = std::accumulate(peers.begin(), peers.end(), uint64_t{0},
+      [](uint64_t sum, const PeerStatus& peer) { return sum + peer.getFlowFileCount(); });
+  if (peers.size() < 2 || total_flow_file_count == 0) {
+    return std::vector<double>(peers.size(), 1.0);
+  }
+
+  std::vector<double> weights;
+  weights.reserve(peers.size());
+  for (const auto& peer : peers) {
+    const double share = static_cast<double>(peer.getFlowFileCount()) / static_cast<double>(total_flow_file_count);
+    if (direction == TransferDirection::SEND) {
+      weights.push_back(1.0 - std::min(share, MAX_SHARE));
+    } else {
+      weights.push_back(std::max(share, MIN_SHARE));
+    }
+  }
+  return weights;
+}
+
+void PeerSelector::setPeers(std::vector<PeerStatus> peers, std::chrono::steady_clock::time_point refreshed_at) {
+  peers_ = std::move(peers);
+  weights_ = calculateWeights(direction_, peers_);
+  distribution_ = std::discrete_distribution<size_t>(weights_.begin(), weights_.end());
+  last_refresh_ = refreshed_at;
+}
+
+std::optional<PeerStatus> PeerSelector::next() {
+  if (peers_.empty()) {
+    return std::nullopt;
+  }
+  return peers_[distribution_(random_engine_)];
+}
+
+std::vector<PeerStatus> PeerSelector::nextDistinct(size_t count) {
+  std::vector<PeerStatus> selected;
+  std::vector<double> remaining_weights = weights_;
+  count = std::min(count, peers_.size());
+  selected.reserve(count);
+  while (selected.size() < count) {
+    std::discrete_distribution<size_t> distribution(remaining_weights.begin(), remaining_weights.end());
+    const auto index = distribution(random_engine_);
+    selected.push_back(peers_[index]);
+    remaining_weights[index] = 0.0;
+  }
+  return selected;
+}
+
+}  // namespace org::apache::nifi::minifi::sitetosite
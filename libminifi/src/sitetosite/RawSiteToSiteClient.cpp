@@ -163,6 +163,11 @@ bool RawSiteToSiteClient::handShake() {
     }
   }
 
+  const CompressionCodec proposed_codec = use_compression_ ? preferred_compression_codec_.load() : CompressionCodec::ZLIB;
+  if (proposed_codec != CompressionCodec::ZLIB) {
+    properties[std::string(magic_enum::enum_name(HandshakeProperty::COMPRESSION_CODEC))] = std::string{compressionCodecName(proposed_codec)};
+  }
+
   if (current_version_ >= 3) {
     if (const auto ret = peer_->write(peer_->getURL()); ret == 0 || io::isError(ret)) {
       logger_->log_error("Failed to write peer URL {}", ret);
@@ -200,8 +205,20 @@ bool RawSiteToSiteClient::handShake() {
   switch (response->code) {
     case ResponseCode::PROPERTIES_OK:
       logger_->log_debug("Site2Site HandShake Completed");
+      compression_codec_ = proposed_codec;
       peer_state_ = PeerState::HANDSHAKED;
       return true;
+    case ResponseCode::UNKNOWN_PROPERTY_NAME:
+    case ResponseCode::ILLEGAL_PROPERTY_VALUE:
+      if (proposed_codec != CompressionCodec::ZLIB) {
+        logger_->log_warn("Site2Site peer {} does not support {} compression, falling back to zlib", peer_->getURL(), compressionCodecName(proposed_codec));
+        preferred_compression_codec_ = CompressionCodec::ZLIB;
+        compression_codec_ = CompressionCodec::ZLIB;
+        codec_fallback_pending_ = true;
+        return false;
+      }
+      logger_->log_error("Site2Site HandShake on port {} failed: {}", port_id_.to_string(), response->message);
+      return false;
     case ResponseCode::PORT_NOT_IN_VALID_STATE:
       logPortStateError("in invalid state");
       return false;
@@ -319,7 +336,15 @@ bool RawSiteToSiteClient::bootstrap() {
 
   if (!establish() || !handShake() || !negotiateCodec()) {
     tearDown();
-    return false;
+    if (!codec_fallback_pending_) {
+      return false;
+    }
+    // the peer rejected the compression codec, retry once with zlib
+    codec_fallback_pending_ = false;
+    if (!establish() || !handShake() || !negotiateCodec()) {
+      tearDown();
+      return false;
+    }
   }
 
   logger_->log_debug("Site to Site ready for data transaction");
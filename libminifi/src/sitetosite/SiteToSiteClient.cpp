@@ -138,7 +138,7 @@ bool SiteToSiteClient::transferFlowFiles(core::ProcessContext& context, core::Pr
     throw Exception(SITE2SITE_EXCEPTION, "Can not create transaction");
   }
   utils::Identifier transaction_id = transaction->getUUID();
-  std::chrono::high_resolution_clock::time_point transaction_started_at = std::chrono::high_resolution_clock::now();
+  const auto transaction_started_at = std::chrono::steady_clock::now();
 
   try {
     while (true) {
@@ -155,8 +155,7 @@ bool SiteToSiteClient::transferFlowFiles(core::ProcessContext& context, core::Pr
       session.getProvenanceReporter()->send(*flow, transit_uri, details, std::chrono::duration_cast<std::chrono::milliseconds>(end_time - start_time), false);
       session.remove(flow);
 
-      std::chrono::nanoseconds transfer_duration = std::chrono::high_resolution_clock::now() - transaction_started_at;
-      if (transfer_duration > batch_send_nanos_) {
+      if (isBatchFull(*transaction, transaction_started_at)) {
         break;
       }
 
@@ -182,6 +181,65 @@ bool SiteToSiteClient::transferFlowFiles(core::ProcessContext& context, core::Pr
   return true;
 }
 
+bool SiteToSiteClient::sendFlowFiles(core::ProcessContext& context, const std::vector<FlowFileWithContent>& flow_files) {
+  if (flow_files.empty()) {
+    return true;
+  }
+
+  if (peer_state_ != PeerState::READY && !bootstrap()) {
+    return false;
+  }
+
+  std::shared_ptr<Transaction> transaction;
+  try {
+    transaction = createTransaction(TransferDirection::SEND);
+    if (transaction == nullptr) {
+      throw Exception(SITE2SITE_EXCEPTION, "Can not create transaction");
+    }
+    const utils::Identifier transaction_id = transaction->getUUID();
+
+    for (const auto& [flow_file, content] : flow_files) {
+      const bool sent = sendFlowFile(transaction, *flow_file, [&content](io::OutputStream& stream) -> int64_t {
+        if (!content) {
+          return 0;
+        }
+        return internal::pipe(*content, stream).toI64();
+      });
+      if (!sent) {
+        throw Exception(SITE2SITE_EXCEPTION, "Send Failed");
+      }
+      logger_->log_debug("Site2Site transaction {} send flow record {}", transaction_id.to_string(), flow_file->getUUIDStr());
+    }
+
+    if (!confirm(transaction_id)) {
+      throw Exception(SITE2SITE_EXCEPTION, "Confirm Failed for " + transaction_id.to_string());
+    }
+    if (!complete(context, transaction_id)) {
+      throw Exception(SITE2SITE_EXCEPTION, "Complete Failed for " + transaction_id.to_string());
+    }
+    logger_->log_debug("Site2Site transaction {} successfully sent flow record {}, content bytes {}", transaction_id.to_string(), transaction->getCurrentTransfers(), transaction->getBytes());
+    deleteTransaction(transaction_id);
+  } catch (const std::exception& exception) {
+    handleTransactionError(transaction, context, exception);
+    return false;
+  }
+  return true;
+}
+
+bool SiteToSiteClient::isBatchFull(const Transaction& transaction, std::chrono::steady_clock::time_point transaction_started_at) const {
+  if (batch_count_ > 0 && transaction.getCurrentTransfers() >= batch_count_) {
+    return true;
+  }
+  if (batch_size_ > 0 && transaction.getBytes() >= batch_size_) {
+    return true;
+  }
+  const auto elapsed = std::chrono::steady_clock::now() - transaction_started_at;
+  if (batch_duration_.load() > 0ms && elapsed >= batch_duration_.load()) {
+    return true;
+  }
+  return elapsed > batch_send_nanos_;
+}
+
 bool SiteToSiteClient::confirmReceive(const std::shared_ptr<Transaction>& transaction, const utils::Identifier& transaction_id) {
   if (transaction->isDataAvailable()) {
     return false;
@@ -455,6 +513,14 @@ void SiteToSiteClient::finalizeSendTransaction(const std::shared_ptr<Transaction
 }
 
 bool SiteToSiteClient::sendFlowFile(const std::shared_ptr<Transaction>& transaction, core::FlowFile& flow_file, core::ProcessSession& session) {
+  return sendFlowFile(transaction, flow_file, [&session, &flow_file](io::OutputStream& stream) {
+    return session.read(flow_file, [&stream](const std::shared_ptr<io::InputStream>& input_stream) -> io::IoResult {
+      return internal::pipe(*input_stream, stream);
+    });
+  });
+}
+
+bool SiteToSiteClient::sendFlowFile(const std::shared_ptr<Transaction>& transaction, core::FlowFile& flow_file, const std::function<int64_t(io::OutputStream&)>& write_content) {
   if (!initializeSend(transaction)) {
     return false;
   }
@@ -462,7 +528,7 @@ bool SiteToSiteClient::sendFlowFile(const std::shared_ptr<Transaction>& transact
   std::unique_ptr<CompressionOutputStream> compression_stream;
   std::unique_ptr<io::CRCStream<io::OutputStream>> compression_wrapper_crc_stream;
   if (use_compression_) {
-    compression_stream = std::make_unique<CompressionOutputStream>(transaction->getStream());
+    compression_stream = std::make_unique<CompressionOutputStream>(transaction->getStream(), compression_codec_, compression_parallelism_);
     compression_wrapper_crc_stream = std::make_unique<io::CRCStream<io::OutputStream>>(gsl::make_not_null(compression_stream.get()));
   }
   io::OutputStream& stream = use_compression_ ?  static_cast<io::OutputStream&>(*compression_wrapper_crc_stream) : static_cast<io::OutputStream&>(transaction->getStream());
@@ -490,9 +556,7 @@ bool SiteToSiteClient::sendFlowFile(const std::shared_ptr<Transaction>& transact
       return false;
     }
     if (flow_file.getSize() > 0) {
-      auto read_result = session.read(flow_file, [&stream](const std::shared_ptr<io::InputStream>& input_stream) -> io::IoResult {
-        return internal::pipe(*input_stream, stream);
-      });
+      const auto read_result = write_content(stream);
       if (flow_file.getSize() != gsl::narrow<uint64_t>(read_result)) {
         logger_->log_debug("Mismatched sizes {} {}", flow_file.getSize(), read_result);
         return false;
@@ -527,7 +591,7 @@ bool SiteToSiteClient::sendPacket(const DataPacket& packet) {
   std::unique_ptr<CompressionOutputStream> compression_stream;
   std::unique_ptr<io::CRCStream<io::OutputStream>> compression_wrapper_crc_stream;
   if (use_compression_) {
-    compression_stream = std::make_unique<CompressionOutputStream>(packet.transaction->getStream());
+    compression_stream = std::make_unique<CompressionOutputStream>(packet.transaction->getStream(), compression_codec_, compression_parallelism_);
     compression_wrapper_crc_stream = std::make_unique<io::CRCStream<io::OutputStream>>(gsl::make_not_null(compression_stream.get()));
   }
   io::OutputStream& stream = use_compression_ ?  static_cast<io::OutputStream&>(*compression_wrapper_crc_stream) : static_cast<io::OutputStream&>(transaction->getStream());
@@ -668,7 +732,7 @@ std::pair<uint64_t, uint64_t> SiteToSiteClient::readFlowFiles(const std::shared_
   std::unique_ptr<CompressionInputStream> compression_stream;
   std::unique_ptr<io::CRCStream<io::InputStream>> compression_wrapper_crc_stream;
   if (use_compression_) {
-    compression_stream = std::make_unique<CompressionInputStream>(transaction->getStream());
+    compression_stream = std::make_unique<CompressionInputStream>(transaction->getStream(), compression_codec_);
     compression_wrapper_crc_stream = std::make_unique<io::CRCStream<io::InputStream>>(gsl::make_not_null(compression_stream.get()));
   }
   io::InputStream& stream = use_compression_ ?  static_cast<io::InputStream&>(*compression_wrapper_crc_stream) : transaction->getStream();
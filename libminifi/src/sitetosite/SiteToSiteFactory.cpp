@@ -37,6 +37,8 @@ gsl::not_null<std::unique_ptr<SiteToSitePeer>> createStreamingPeer(const SiteToS
 void setCommonConfigurationOptions(SiteToSiteClient& client, const SiteToSiteClientConfiguration &client_configuration) {
   client.setSSLContextService(client_configuration.getSecurityContext());
   client.setUseCompression(client_configuration.getUseCompression());
+  client.setCompressionCodec(client_configuration.getCompressionCodec());
+  client.setCompressionParallelism(client_configuration.getCompressionParallelism());
   if (client_configuration.getBatchCount()) {
     client.setBatchCount(client_configuration.getBatchCount().value());
   }
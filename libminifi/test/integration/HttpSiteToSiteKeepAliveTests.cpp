@@ -0,0 +1,118 @@
+/**
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The ASF licenses this file to You under the Apache License, Version 2.0
+ * (the "License"); you may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "unit/TestBase.h"
+#include "unit/Catch.h"
+#include "unit/DummyProcessor.h"
+#include "integration/MockSiteToSiteServer.h"
+#include "io/BufferStream.h"
+#include "sitetosite/HttpSiteToSiteClient.h"
+
+namespace org::apache::nifi::minifi::test {
+
+namespace {
+std::vector<sitetosite::FlowFileWithContent> createFlowFiles(const std::vector<std::string>& contents) {
+  std::vector<sitetosite::FlowFileWithContent> flow_files;
+  for (const auto& content : contents) {
+    auto flow_file = std::make_shared<core::FlowFileImpl>();
+    flow_file->setSize(content.size());
+    flow_file->setAttribute("content.length", std::to_string(content.size()));
+    flow_files.push_back({flow_file, std::make_shared<io::BufferStream>(content)});
+  }
+  return flow_files;
+}
+
+std::unique_ptr<sitetosite::HttpSiteToSiteClient> createClient(MockSiteToSiteServer& server) {
+  auto client = std::make_unique<sitetosite::HttpSiteToSiteClient>(
+      gsl::make_not_null(std::make_unique<sitetosite::SiteToSitePeer>("localhost", gsl::narrow<uint16_t>(std::stoi(server.getPort())), "")));
+  client->setPortId(utils::IdGenerator::getIdGenerator()->generate());
+  return client;
+}
+}  // namespace
+
+TEST_CASE("HTTP site-to-site transactions reuse the connection to the peer", "[s2s][http]") {
+  TestController test_controller;
+  auto plan = test_controller.createPlan();
+  plan->addProcessor<DummyProcessor>("dummy");
+  plan->runNextProcessor();
+  auto context = plan->getCurrentContext();
+
+  MockSiteToSiteServer server;
+  auto client = createClient(server);
+
+  const std::vector<std::string> contents{"first flow file", "", "third flow file", std::string(200000, 'x')};
+  for (size_t i = 0; i < 5; ++i) {
+    REQUIRE(client->sendFlowFiles(*context, createFlowFiles(contents)));
+  }
+
+  const auto received = server.getReceivedFlowFiles();
+  REQUIRE(received.size() == 5 * contents.size());
+  for (size_t i = 0; i < received.size(); ++i) {
+    CHECK(received[i].content == contents[i % contents.size()]);
+    CHECK(received[i].attributes.at("content.length") == std::to_string(contents[i % contents.size()].size()));
+  }
+  CHECK(server.getConfirmedTransactionCount() == 5);
+  CHECK(server.getConnectionCount() == 1);
+}
+
+TEST_CASE("HTTP site-to-site streams large transactions", "[s2s][http]") {
+  TestController test_controller;
+  auto plan = test_controller.createPlan();
+  plan->addProcessor<DummyProcessor>("dummy");
+  plan->runNextProcessor();
+  auto context = plan->getCurrentContext();
+
+  MockSiteToSiteServer server(false);
+  auto client = createClient(server);
+
+  const std::vector<std::string> contents(16, std::string(1024 * 1024, 'a'));
+  REQUIRE(client->sendFlowFiles(*context, createFlowFiles(contents)));
+
+  CHECK(server.getReceivedFlowFileCount() == contents.size());
+  CHECK(server.getReceivedBytes() == contents.size() * contents[0].size());
+  CHECK(server.getConfirmedTransactionCount() == 1);
+}
+
+TEST_CASE("HTTP site-to-site sends compressed transactions", "[s2s][http]") {
+  TestController test_controller;
+  auto plan = test_controller.createPlan();
+  plan->addProcessor<DummyProcessor>("dummy");
+  plan->runNextProcessor();
+  auto context = plan->getCurrentContext();
+
+  MockSiteToSiteServer server;
+  auto client = createClient(server);
+  const auto codec = GENERATE(sitetosite::CompressionCodec::ZLIB, sitetosite::CompressionCodec::LZ4, sitetosite::CompressionCodec::ZSTD);
+  client->setUseCompression(true);
+  client->setCompressionCodec(codec);
+
+  const std::vector<std::string> contents{"first flow file", "", std::string(200000, 'x')};
+  REQUIRE(client->sendFlowFiles(*context, createFlowFiles(contents)));
+
+  const auto received = server.getReceivedFlowFiles();
+  REQUIRE(received.size() == contents.size());
+  for (size_t i = 0; i < received.size(); ++i) {
+    CHECK(received[i].content == contents[i]);
+  }
+  CHECK(server.getConfirmedTransactionCount() == 1);
+}
+
+}  // namespace org::apache::nifi::minifi::test
@@ -17,9 +17,11 @@
  */
 
 #define CATCH_CONFIG_RUNNER
+#include <filesystem>
 #include <vector>
 #include <memory>
 #include <string>
+#include <unordered_map>
 
 #include "unit/Catch.h"
 #include "unit/TestBase.h"
@@ -77,7 +79,7 @@ class PersistentStateStorageTestsFixture {
     std::filesystem::current_path(minifi::utils::file::get_executable_dir());
   }
 
-  void loadYaml() {
+  void loadYaml(const std::filesystem::path& yaml_path = config_yaml) {
     controller.reset();
 
     process_group.reset();
@@ -92,7 +94,7 @@ class PersistentStateStorageTestsFixture {
     test_repo = std::make_shared<TestRepository>();
     test_flow_repo = std::make_shared<TestFlowRepository>();
 
-    configuration->set(minifi::Configure::nifi_flow_configuration_file, config_yaml);
+    configuration->set(minifi::Configure::nifi_flow_configuration_file, yaml_path.string());
 
     content_repo = std::make_shared<core::repository::VolatileContentRepository>();
     content_repo->initialize(configuration);
@@ -101,7 +103,7 @@ class PersistentStateStorageTestsFixture {
         .flow_file_repo = test_repo,
         .content_repo = content_repo,
         .configuration = configuration,
-        .path = config_yaml,
+        .path = yaml_path,
         .filesystem = std::make_shared<utils::file::FileSystem>(),
         .sensitive_values_encryptor = utils::crypto::EncryptionProvider{utils::crypto::XSalsa20Cipher{utils::crypto::XSalsa20Cipher::generateKey()}}
     });
@@ -248,3 +250,74 @@ TEST_CASE_METHOD(PersistentStateStorageTestsFixture, "PersistentStateStorageTest
   REQUIRE(true == controller->get(key, res));
   REQUIRE(value == res);
 }
+
+TEST_CASE_METHOD(PersistentStateStorageTestsFixture, "PersistentStateStorageTestsFixture state manager set, update and clear", "[basic]") {
+  const auto uuid = utils::IdGenerator::getIdGenerator()->generate();
+  const core::StateManager::State updated_state = {
+      {"foobar", "567"},
+      {"buzz", "value"},
+      {"new", "key"},
+  };
+  {
+    auto state_manager = controller->createStateManager(uuid);
+    core::StateManager::State state;
+    REQUIRE_FALSE(state_manager->get(state));
+    REQUIRE(state_manager->set({{"foobar", "234"}, {"buzz", "value"}, {"removed", "key"}}));
+    REQUIRE(state_manager->set(updated_state));
+    REQUIRE(state_manager->get(state));
+    REQUIRE(updated_state == state);
+    REQUIRE(state_manager->persist());
+  }
+
+  SECTION("without persistence") {
+  }
+  SECTION("with persistence") {
+    loadYaml();
+  }
+
+  auto state_manager = controller->createStateManager(uuid);
+  core::StateManager::State state;
+  REQUIRE(state_manager->get(state));
+  REQUIRE(updated_state == state);
+  REQUIRE(controller->getAllStates().at(uuid) == updated_state);
+
+  REQUIRE(state_manager->set({}));
+  REQUIRE(state_manager->get(state));
+  REQUIRE(state.empty());
+  REQUIRE(controller->getAllStates().at(uuid).empty());
+
+  REQUIRE(state_manager->clear());
+  REQUIRE_FALSE(state_manager->get(state));
+  REQUIRE_FALSE(controller->getAllStates().contains(uuid));
+}
+
+// hidden, as it only applies to RocksDbStateStorage; it is run by its own test, with the RocksDbStateStorage.yml config
+TEST_CASE_METHOD(PersistentStateStorageTestsFixture, "RocksDbStateStorage keeps the states when Store Keys Separately is switched", "[.store_keys_separately]") {
+  const auto single_record_yaml = std::filesystem::path{config_yaml}.parent_path() / "RocksDbStateStorage.yml";
+  const auto keys_stored_separately_yaml = std::filesystem::path{config_yaml}.parent_path() / "RocksDbStateStorageWithKeysStoredSeparately.yml";
+  const auto uuid = utils::IdGenerator::getIdGenerator()->generate();
+  const core::StateManager::State initial_state = {{"foo", "bar"}, {"empty", ""}};
+  const core::StateManager::State updated_state = {{"foo", "baz"}, {"new", "key"}};
+  core::StateManager::State state;
+
+  loadYaml(single_record_yaml);
+  REQUIRE(controller->createStateManager(uuid)->set(initial_state));
+
+  loadYaml(keys_stored_separately_yaml);
+  {
+    auto state_manager = controller->createStateManager(uuid);
+    REQUIRE(state_manager->get(state));
+    CHECK(state == initial_state);
+    REQUIRE(state_manager->set(updated_state));
+  }
+  std::string value;
+  CHECK_FALSE(controller->get(std::string{uuid.to_string()}, value));
+
+  loadYaml(single_record_yaml);
+  REQUIRE(controller->createStateManager(uuid)->get(state));
+  CHECK(state == updated_state);
+  CHECK(controller->getAllStates().at(uuid) == updated_state);
+  std::unordered_map<std::string, std::string> records;
+  REQUIRE(controller->get(records));
+  CHECK(records.size() == 1);
+}
@@ -0,0 +1,213 @@
+/**
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The ASF licenses this file to You under the Apache License, Version 2.0
+ * (the "License"); you may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "MockSiteToSiteServer.h"
+
+#include <array>
+#include <cassert>
+#include <iterator>
+#include <optional>
+#include <span>
+
+#include "CivetStream.h"
+#include "io/CRCStream.h"
+#include "sitetosite/CompressionInputStream.h"
+#include "sitetosite/HttpSiteToSiteClient.h"
+#include "utils/Id.h"
+
+namespace org::apache::nifi::minifi::test {
+
+namespace {
+// the codec of the body, or std::nullopt if the client does not compress it
+std::optional<sitetosite::CompressionCodec> getCompressionCodec(struct mg_connection* conn) {
+  const char* use_compression = mg_get_header(conn, sitetosite::HttpSiteToSiteClient::HANDSHAKE_PROPERTY_USE_COMPRESSION);
+  if (use_compression == nullptr || std::string_view{use_compression} != "true") {
+    return std::nullopt;
+  }
+  const char* codec = mg_get_header(conn, sitetosite::HttpSiteToSiteClient::HANDSHAKE_PROPERTY_COMPRESSION_CODEC);
+  return codec == nullptr ? sitetosite::CompressionCodec::ZLIB : sitetosite::parseCompressionCodec(codec);
+}
+
+// returns std::nullopt at the end of the body, sets failed if the flow file is truncated
+std::optional<ReceivedFlowFile> readFlowFile(io::InputStream& stream, bool& failed) {
+  uint32_t num_attributes = 0;
+  if (io::isError(stream.read(num_attributes))) {
+    return std::nullopt;
+  }
+  ReceivedFlowFile flow_file;
+  for (uint32_t i = 0; i < num_attributes; ++i) {
+    std::string name;
+    std::string value;
+    stream.read(name, true);
+    stream.read(value, true);
+    flow_file.attributes[name] = value;
+  }
+  uint64_t length = 0;
+  stream.read(length);
+  flow_file.content.resize(gsl::narrow<size_t>(length));
+  if (stream.read(std::as_writable_bytes(std::span(flow_file.content))) != length) {
+    failed = true;
+    return std::nullopt;
+  }
+  return flow_file;
+}
+}  // namespace
+
+bool MockSiteToSiteServer::SiteToSiteApiHandler::handleGet(CivetServer*, struct mg_connection* conn) {
+  server_.saveConnectionId(conn);
+  const std::string uri = mg_get_request_info(conn)->local_uri;
+  if (!uri.ends_with("/site-to-site/peers")) {
+    mg_printf(conn, "HTTP/1.1 404 Not Found\r\nContent-Length: 0\r\n\r\n");
+    return true;
+  }
+  const auto body = R"({"peers": [{"hostname": "localhost", "port": )" + server_.getPort() + R"(, "secure": false, "flowFileCount": 0}]})";
+  mg_printf(conn, "HTTP/1.1 200 OK\r\nContent-Type: application/json\r\nContent-Length: %zu\r\n\r\n", body.length());
+  mg_printf(conn, "%s", body.c_str());
+  return true;
+}
+
+bool MockSiteToSiteServer::SiteToSiteApiHandler::handlePost(CivetServer*, struct mg_connection* conn) {
+  server_.saveConnectionId(conn);
+  const std::string uri = mg_get_request_info(conn)->local_uri;
+  if (uri.ends_with("/flow-files")) {
+    receiveFlowFiles(conn);
+  } else if (uri.ends_with("/transactions")) {
+    createTransaction(conn, uri);
+  } else {
+    mg_printf(conn, "HTTP/1.1 404 Not Found\r\nContent-Length: 0\r\n\r\n");
+  }
+  return true;
+}
+
+bool MockSiteToSiteServer::SiteToSiteApiHandler::handleDelete(CivetServer*, struct mg_connection* conn) {
+  server_.saveConnectionId(conn);
+  std::string response_code;
+  CivetServer::getParam(conn, "responseCode", response_code);
+  if (response_code == "12") {
+    std::lock_guard lock(server_.mutex_);
+    ++server_.confirmed_transactions_;
+  }
+  mg_printf(conn, "HTTP/1.1 200 OK\r\nContent-Type: application/json\r\nContent-Length: 0\r\n\r\n");
+  return true;
+}
+
+void MockSiteToSiteServer::SiteToSiteApiHandler::createTransaction(struct mg_connection* conn, const std::string& uri) {
+  std::array<char, 1024> discarded{};
+  while (mg_read(conn, discarded.data(), discarded.size()) > 0) {}
+
+  const auto location = "http://localhost:" + server_.getPort() + uri + "/" + utils::IdGenerator::getIdGenerator()->generate().to_string();
+  // every codec is accepted, which is signaled by echoing it back
+  std::string codec_header;
+  if (const auto codec = getCompressionCodec(conn)) {
+    codec_header = std::string{sitetosite::HttpSiteToSiteClient::HANDSHAKE_PROPERTY_COMPRESSION_CODEC} + ": " + std::string{sitetosite::compressionCodecName(*codec)} + "\r\n";
+  }
+  mg_printf(conn, "HTTP/1.1 201 Created\r\nLocation: %s\r\nx-location-uri-intent: transaction-url\r\n%sContent-Length: 0\r\n\r\n", location.c_str(), codec_header.c_str());
+}
+
+void MockSiteToSiteServer::SiteToSiteApiHandler::receiveFlowFiles(struct mg_connection* conn) {
+  const auto codec = getCompressionCodec(conn);
+  io::CivetStream civet_stream(conn);
+  io::CRCStream<io::CivetStream> stream(gsl::make_not_null(&civet_stream));
+  std::vector<ReceivedFlowFile> flow_files;
+  uint64_t bytes = 0;
+  uint64_t crc = stream.getCRC();
+  while (true) {
+    // the body is a sequence of serialized flow files, the end of the body is the end of the transaction
+    bool failed = false;
+    std::optional<ReceivedFlowFile> flow_file;
+    if (codec) {
+      // the client compresses every flow file as a separate stream, and its checksum covers the uncompressed data of the last one
+      sitetosite::CompressionInputStream decompressing_stream(civet_stream, *codec);
+      io::InputStream& decompressed_stream = decompressing_stream;
+      io::CRCStream<io::InputStream> crc_stream(gsl::make_not_null(&decompressed_stream));
+      flow_file = readFlowFile(crc_stream, failed);
+      if (flow_file) {
+        crc = crc_stream.getCRC();
+      }
+    } else {
+      flow_file = readFlowFile(stream, failed);
+      crc = stream.getCRC();
+    }
+    if (failed) {
+      mg_printf(conn, "HTTP/1.1 400 Bad Request\r\nContent-Length: 0\r\n\r\n");
+      return;
+    }
+    if (!flow_file) {
+      break;
+    }
+    bytes += flow_file->content.size();
+    flow_files.push_back(std::move(*flow_file));
+  }
+
+  {
+    std::lock_guard lock(server_.mutex_);
+    server_.flow_file_count_ += flow_files.size();
+    server_.bytes_ += bytes;
+    if (server_.keep_flow_files_) {
+      server_.flow_files_.insert(server_.flow_files_.end(), std::make_move_iterator(flow_files.begin()), std::make_move_iterator(flow_files.end()));
+    }
+  }
+
+  const auto crc_string = std::to_string(crc);
+  mg_printf(conn, "HTTP/1.1 202 Accepted\r\nContent-Type: text/plain\r\nContent-Length: %zu\r\n\r\n", crc_string.length());
+  mg_printf(conn, "%s", crc_string.c_str());
+}
+
+MockSiteToSiteServer::MockSiteToSiteServer(bool keep_flow_files)
+    : keep_flow_files_(keep_flow_files) {
+  server_.addHandler("/nifi-api", api_handler_);
+}
+
+std::string MockSiteToSiteServer::getPort() {
+  const auto& listening_ports = server_.getListeningPorts();
+  assert(!listening_ports.empty());
+  return std::to_string(listening_ports[0]);
+}
+
+size_t MockSiteToSiteServer::getConnectionCount() {
+  std::lock_guard lock(mutex_);
+  return connections_.size();
+}
+
+std::vector<ReceivedFlowFile> MockSiteToSiteServer::getReceivedFlowFiles() {
+  std::lock_guard lock(mutex_);
+  return flow_files_;
+}
+
+uint64_t MockSiteToSiteServer::getReceivedFlowFileCount() {
+  std::lock_guard lock(mutex_);
+  return flow_file_count_;
+}
+
+uint64_t MockSiteToSiteServer::getReceivedBytes() {
+  std::lock_guard lock(mutex_);
+  return bytes_;
+}
+
+uint64_t MockSiteToSiteServer::getConfirmedTransactionCount() {
+  std::lock_guard lock(mutex_);
+  return confirmed_transactions_;
+}
+
+void MockSiteToSiteServer::saveConnectionId(struct mg_connection* conn) {
+  auto user_connection_data = reinterpret_cast<minifi::utils::SmallString<36>*>(mg_get_user_connection_data(conn));
+  assert(user_connection_data);
+  std::lock_guard lock(mutex_);
+  connections_.emplace(*user_connection_data);
+}
+
+}  // namespace org::apache::nifi::minifi::test
@@ -0,0 +1,94 @@
+/**
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The ASF licenses this file to You under the Apache License, Version 2.0
+ * (the "License"); you may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <map>
+#include <mutex>
+#include <set>
+#include <string>
+#include <vector>
+
+#include "CivetServer.h"
+#include "ConnectionCountingServer.h"
+#include "utils/SmallString.h"
+
+namespace org::apache::nifi::minifi::test {
+
+struct ReceivedFlowFile {
+  std::map<std::string, std::string> attributes;
+  std::string content;
+};
+
+/**
+ * Minimal NiFi site-to-site HTTP endpoint for sending to an input port. Unlike the handlers in HTTPHandlers.h,
+ * it keeps the connections alive and accepts any number of flow files in a transaction, so it can be used to
+ * verify connection reuse and to measure the throughput of the HTTP site-to-site client. Compressed transactions
+ * are accepted with every compression codec.
+ */
+class MockSiteToSiteServer {
+ public:
+  explicit MockSiteToSiteServer(bool keep_flow_files = true);
+
+  std::string getPort();
+
+  size_t getConnectionCount();
+  std::vector<ReceivedFlowFile> getReceivedFlowFiles();
+  uint64_t getReceivedFlowFileCount();
+  uint64_t getReceivedBytes();
+  uint64_t getConfirmedTransactionCount();
+
+ private:
+  class SiteToSiteApiHandler : public CivetHandler {
+   public:
+    explicit SiteToSiteApiHandler(MockSiteToSiteServer& server) : server_(server) {}
+
+    bool handleGet(CivetServer*, struct mg_connection* conn) override;
+    bool handlePost(CivetServer*, struct mg_connection* conn) override;
+    bool handleDelete(CivetServer*, struct mg_connection* conn) override;
+
+   private:
+    void createTransaction(struct mg_connection* conn, const std::string& uri);
+    void receiveFlowFiles(struct mg_connection* conn);
+
+    MockSiteToSiteServer& server_;
+  };
+
+  void saveConnectionId(struct mg_connection* conn);
+
+  static inline std::vector<std::string> options = {
+      "enable_keep_alive", "yes",
+      "keep_alive_timeout_ms", "15000",
+      "num_threads", "4",
+      "listening_ports", "0"};
+
+  bool keep_flow_files_;
+  std::mutex mutex_;
+  std::set<minifi::utils::SmallString<36>> connections_;
+  std::vector<ReceivedFlowFile> flow_files_;
+  uint64_t flow_file_count_ = 0;
+  uint64_t bytes_ = 0;
+  uint64_t confirmed_transactions_ = 0;
+
+  details::AddIdToUserConnectionData add_id_to_user_connection_data_;
+  CivetServer server_{options, &add_id_to_user_connection_data_};
+  SiteToSiteApiHandler api_handler_{*this};
+};
+
+}  // namespace org::apache::nifi::minifi::test
@@ -159,6 +159,38 @@ inline void testAppendToManagedFlowFile(std::shared_ptr<core::ContentRepository>
   CHECK(read_until_it_can_callback.value_ == "myfoobar");
 }
 
+inline void testAppendToClonedFlowFiles(std::shared_ptr<core::ContentRepository> content_repo, const bool commit_original) {
+  auto fixture = Fixture(std::move(content_repo));
+  core::ProcessSession& process_session = fixture.processSession();
+  const auto original_ff = process_session.create();
+  REQUIRE(original_ff);
+  fixture.writeToFlowFile(original_ff, "foobar");
+  if (commit_original) {
+    fixture.transferAndCommit(original_ff);
+  }
+
+  // the clones share the content of the original, appending to one of them must not change the others
+  auto clone_first_half = process_session.clone(*original_ff, 0, 3);
+  auto clone_second_half = process_session.clone(*original_ff, 3, 3);
+  REQUIRE(clone_first_half != nullptr);
+  REQUIRE(clone_second_half != nullptr);
+  CHECK(clone_first_half->getResourceClaim() == original_ff->getResourceClaim());
+  process_session.appendBuffer(clone_first_half, "baz");
+  process_session.appendBuffer(clone_second_half, "!");
+  process_session.transfer(clone_first_half, fixture.Success);
+  process_session.transfer(clone_second_half, fixture.Success);
+  if (!commit_original) {
+    process_session.transfer(original_ff, fixture.Success);
+  }
+  process_session.commit();
+
+  CHECK(to_string(process_session.readBuffer(original_ff)) == "foobar");
+  CHECK(clone_first_half->getSize() == 6);
+  CHECK(to_string(process_session.readBuffer(clone_first_half)) == "foobaz");
+  CHECK(clone_second_half->getSize() == 4);
+  CHECK(to_string(process_session.readBuffer(clone_second_half)) == "bar!");
+}
+
 inline void testReadFromZeroLengthFlowFile(std::shared_ptr<core::ContentRepository> content_repo) {
   const auto fixture = Fixture(std::move(content_repo));
   core::ProcessSession& process_session = fixture.processSession();
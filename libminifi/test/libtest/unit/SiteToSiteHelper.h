@@ -49,6 +49,10 @@ class SiteToSiteResponder : public minifi::io::BaseStreamImpl {
     return size;
   }
 
+  [[nodiscard]] bool has_client_response() const {
+    return !client_responses_.empty();
+  }
+
   std::string get_next_client_response() {
     std::string ret = client_responses_.front();
     client_responses_.pop();
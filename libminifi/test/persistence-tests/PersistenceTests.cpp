@@ -126,6 +126,9 @@ struct TestFlow{
     processor_->onTrigger(*processorContext, *session);
     session->commit();
   }
+  void reschedule() {
+    processor_->onSchedule(*processorContext, *process_session_factory_);
+  }
 
   Connection* input_;
   Connection* output_;
@@ -252,6 +255,139 @@ TEST_CASE("Processors Can Store FlowFiles", "[TestP1]") {
   }
 }
 
+std::unique_ptr<core::Processor> setupMergeProcessorPersistingOnMerge(const utils::Identifier& id) {
+  auto processor = setupMergeProcessor(id);
+  REQUIRE(processor->setProperty(MergeContent::FlowFilePersistence.name, "On Merge"));
+  return processor;
+}
+
+TEST_CASE("Processors persisting the binned FlowFiles on merge leave them in the incoming connection", "[TestP1]") {
+  TestController testController;
+  LogTestController::getInstance().setTrace<core::repository::FlowFileRepository>();
+
+  auto dir = testController.createTempDirectory();
+
+  auto config = std::make_shared<minifi::ConfigureImpl>();
+  config->set(minifi::Configure::nifi_dbcontent_repository_directory_default, (dir / "content_repository").string());
+  config->set(minifi::Configure::nifi_flowfile_repository_directory_default, (dir / "flowfile_repository").string());
+
+  std::shared_ptr<core::Repository> prov_repo = std::make_shared<TestThreadedRepository>();
+  auto ff_repository = std::make_shared<core::repository::FlowFileRepository>("flowFileRepository");
+  std::shared_ptr<core::ContentRepository> content_repo = std::make_shared<core::repository::FileSystemRepository>();
+  ff_repository->initialize(config);
+  content_repo->initialize(config);
+
+  auto flowConfig = std::make_unique<core::FlowConfiguration>(core::ConfigurationContext{
+      .flow_file_repo = ff_repository,
+      .content_repo = content_repo,
+      .configuration = config,
+      .path = "",
+      .filesystem = std::make_shared<utils::file::FileSystem>(),
+      .sensitive_values_encryptor = utils::crypto::EncryptionProvider{utils::crypto::XSalsa20Cipher{utils::crypto::XSalsa20Cipher::generateKey()}}
+  });
+  auto flowController = std::make_shared<minifi::FlowController>(prov_repo, ff_repository, config, std::move(flowConfig), content_repo);
+
+  {
+    TestFlow flow(ff_repository, content_repo, prov_repo, setupMergeProcessorPersistingOnMerge, MergeContent::Merge);
+
+    flowController->load(std::move(flow.root_));
+    ff_repository->start();
+    REQUIRE(verifyEventHappenedInPollTime(std::chrono::seconds(1), [&ff_repository]{ return ff_repository->isRunning(); }));
+
+    flow.write("one");
+    flow.write("two");
+    // the processor bins them, but does not commit their ownership
+    flow.trigger();
+    flow.trigger();
+
+    ff_repository->stop();
+    flowController->stop();
+
+    std::set<std::shared_ptr<core::FlowFile>> expired;
+    REQUIRE_FALSE(flow.input_->poll(expired));
+    REQUIRE_FALSE(flow.output_->poll(expired));
+    REQUIRE(expired.empty());
+  }
+
+  // restart as if the agent crashed, the FlowFiles are restored to the incoming connection
+  {
+    TestFlow flow(ff_repository, content_repo, prov_repo, setupMergeProcessorPersistingOnMerge, MergeContent::Merge);
+
+    flowController->load(std::move(flow.root_));
+    ff_repository->start();
+    REQUIRE(verifyEventHappenedInPollTime(std::chrono::seconds(1), [&ff_repository]{ return ff_repository->isRunning(); }));
+    REQUIRE(verifyEventHappenedInPollTime(std::chrono::seconds(1), []{ return LogTestController::getInstance().countOccurrences("Found connection for") == 2; }));
+    REQUIRE(flow.input_->getQueueSize() == 2);
+
+    flow.write("three");
+    flow.trigger();
+    flow.trigger();
+    flow.trigger();
+    ff_repository->stop();
+    flowController->stop();
+
+    std::set<std::shared_ptr<core::FlowFile>> expired;
+    auto file = flow.output_->poll(expired);
+    REQUIRE(file);
+    REQUIRE(expired.empty());
+    REQUIRE(flow.input_->isEmpty());
+
+    auto content = flow.read(file);
+    REQUIRE_THAT(content, Catch::Matchers::Equals("_Header_one_Demarcator_two_Demarcator_three_Footer_") || Catch::Matchers::Equals("_Header_two_Demarcator_one_Demarcator_three_Footer_"));
+  }
+}
+
+TEST_CASE("Processors persisting the binned FlowFiles on merge return them to the incoming connection when rescheduled", "[TestP1]") {
+  TestController testController;
+
+  auto dir = testController.createTempDirectory();
+
+  auto config = std::make_shared<minifi::ConfigureImpl>();
+  config->set(minifi::Configure::nifi_dbcontent_repository_directory_default, (dir / "content_repository").string());
+  config->set(minifi::Configure::nifi_flowfile_repository_directory_default, (dir / "flowfile_repository").string());
+
+  std::shared_ptr<core::Repository> prov_repo = std::make_shared<TestThreadedRepository>();
+  auto ff_repository = std::make_shared<core::repository::FlowFileRepository>("flowFileRepository");
+  std::shared_ptr<core::ContentRepository> content_repo = std::make_shared<core::repository::FileSystemRepository>();
+  ff_repository->initialize(config);
+  content_repo->initialize(config);
+
+  auto flowConfig = std::make_unique<core::FlowConfiguration>(core::ConfigurationContext{
+      .flow_file_repo = ff_repository,
+      .content_repo = content_repo,
+      .configuration = config,
+      .path = "",
+      .filesystem = std::make_shared<utils::file::FileSystem>(),
+      .sensitive_values_encryptor = utils::crypto::EncryptionProvider{utils::crypto::XSalsa20Cipher{utils::crypto::XSalsa20Cipher::generateKey()}}
+  });
+  auto flowController = std::make_shared<minifi::FlowController>(prov_repo, ff_repository, config, std::move(flowConfig), content_repo);
+
+  TestFlow flow(ff_repository, content_repo, prov_repo, setupMergeProcessorPersistingOnMerge, MergeContent::Merge);
+
+  flowController->load(std::move(flow.root_));
+  ff_repository->start();
+  REQUIRE(verifyEventHappenedInPollTime(std::chrono::seconds(1), [&ff_repository]{ return ff_repository->isRunning(); }));
+
+  flow.write("one");
+  flow.write("two");
+  flow.trigger();
+  flow.trigger();
+  REQUIRE(flow.input_->isEmpty());
+
+  // the held session is rolled back, so the FlowFiles are back in the incoming connection and no longer in the bins
+  flow.reschedule();
+  REQUIRE(flow.input_->getQueueSize() == 2);
+
+  flow.write("three");
+  flow.trigger();
+  ff_repository->stop();
+  flowController->stop();
+
+  std::set<std::shared_ptr<core::FlowFile>> expired;
+  REQUIRE_FALSE(flow.output_->poll(expired));
+  REQUIRE(expired.empty());
+}
+
 class ContentUpdaterProcessor : public core::ProcessorImpl {
  public:
   using ProcessorImpl::ProcessorImpl;
@@ -0,0 +1,59 @@
+/**
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The ASF licenses this file to You under the Apache License, Version 2.0
+ * (the "License"); you may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <algorithm>
+#include <string>
+
+#include "catch2/generators/catch_generators_range.hpp"
+#include "utils/ByteScanner.h"
+#include "unit/TestBase.h"
+#include "unit/Catch.h"
+
+namespace utils = org::apache::nifi::minifi::utils;
+
+TEST_CASE("ByteSetScanner finds the same positions as std::string_view::find_first_of", "[byteScanner]") {
+  const std::string bytes = GENERATE(as<std::string>{}, "", ",", ",\"\n", std::string{"\0\xff", 2}, "abcdefgh");
+  // the subjects are longer than a vector block, so both the vectorized loop and the tail are used
+  const std::string subject = GENERATE(as<std::string>{}, "", "x", "0123456789abcdef0123456789ABCDEF,", "first,\"second\"\nthird,fourth,fifth,sixth,seventh",
+      std::string(40, 'x') + std::string{"\xff"} + "h", std::string(17, '\0'));
+  const auto instruction_set = GENERATE(from_range(utils::getSupportedVectorInstructionSets()));
+  const utils::ByteSetScanner scanner(bytes, instruction_set);
+  for (size_t pos = 0; pos <= subject.size(); ++pos) {
+    CHECK(scanner.find(subject, pos) == std::string_view(subject).find_first_of(bytes, pos));
+  }
+  CHECK(scanner.find(subject, subject.size() + 1) == std::string_view::npos);
+}
+
+TEST_CASE("DelimiterScanner finds the same positions as std::string_view::find", "[byteScanner]") {
+  const std::string delimiter = GENERATE(as<std::string>{}, "\n", "\r\n", "--", "abcab", std::string{"\0\xff\0", 3}, std::string(20, 'x'));
+  const std::string subject = GENERATE(as<std::string>{}, "", "\n", "first line\r\nsecond line\nthird line\r\n\r\nlast line without line ending",
+      "----------------------------------------", "abcabcabcabdabcab abcabcab xyzabcab", std::string(63, 'x') + "y" + std::string(21, 'x'),
+      std::string{"\0\xff\0\xff\0\xff\0\xff\0\xff\0\xff\0\xff\0\xff\0", 17} + std::string{"\0\xff\0", 3});
+  const auto instruction_set = GENERATE(from_range(utils::getSupportedVectorInstructionSets()));
+  const utils::DelimiterScanner scanner(delimiter, instruction_set);
+  for (size_t pos = 0; pos <= subject.size(); ++pos) {
+    CHECK(scanner.find(subject, pos) == std::string_view(subject).find(delimiter, pos));
+  }
+  CHECK(scanner.find(subject, subject.size() + 1) == std::string_view::npos);
+}
+
+TEST_CASE("The scalar instruction set is always supported and the preferred one is among the supported ones", "[byteScanner]") {
+  const auto& instruction_sets = utils::getSupportedVectorInstructionSets();
+  REQUIRE_FALSE(instruction_sets.empty());
+  CHECK(instruction_sets.front() == utils::VectorInstructionSet::Scalar);
+  CHECK(std::ranges::find(instruction_sets, utils::getVectorInstructionSet()) != instruction_sets.end());
+}
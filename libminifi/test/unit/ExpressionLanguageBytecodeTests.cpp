@@ -0,0 +1,167 @@
+/**
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The ASF licenses this file to You under the Apache License, Version 2.0
+ * (the "License"); you may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <algorithm>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "expression-language/Bytecode.h"
+#include "expression-language/Expression.h"
+#include "core/FlowFile.h"
+#include "unit/TestBase.h"
+#include "unit/Catch.h"
+
+namespace expression = org::apache::nifi::minifi::expression;
+namespace bytecode = org::apache::nifi::minifi::expression::bytecode;
+
+namespace {
+bytecode::Program compileProgram(const std::string& expression_string) {
+  return bytecode::Program::compile(expression::compile_tree(expression_string));
+}
+
+size_t countInstructions(const bytecode::Program& program, bytecode::OpCode op_code) {
+  return std::ranges::count_if(program.getInstructions(), [op_code](const auto& instruction) { return instruction.op_code == op_code; });
+}
+}  // namespace
+
+TEST_CASE("Bytecode VM gives the same results as the tree walker", "[expressionLanguageBytecode]") {
+  auto flow_file = std::make_shared<core::FlowFileImpl>();
+  flow_file->addAttribute("filename", "data.X.csv");
+  flow_file->addAttribute("number", "42");
+  flow_file->addAttribute("decimal", "1.5");
+  flow_file->addAttribute("empty", "");
+  flow_file->addAttribute("list", "a,b,c");
+  const expression::Parameters params{flow_file.get()};
+
+  const std::string expression_string = GENERATE(as<std::string>{},
+      "",
+      "static text",
+      "${filename}",
+      "prefix ${filename} suffix",
+      "${missing}",
+      "${filename:substringBefore('.'):toUpper():equals('DATA')}",
+      "${filename:substringAfterLast('.')}",
+      "${filename:startsWith('data'):and(${filename:endsWith('.csv')})}",
+      "${number:plus(8):multiply(2)}",
+      "${decimal:plus(1)}",
+      "${number:gt(${decimal})}",
+      "${empty:isEmpty()}",
+      "${missing:isNull():not()}",
+      "${missing:replaceNull('default')}",
+      "${filename:length()}",
+      "${filename:indexOf('.')}:${filename:lastIndexOf('.')}",
+      "${literal('abc'):toUpper()}",
+      "${literal(3):plus(4)}",
+      "${literal(true):ifElse('yes', 'no')}",
+      "${filename:equalsIgnoreCase('DATA.x.CSV')}",
+      "${filename:in('a', 'data.X.csv')}",
+      "${filename:replaceAll('\\\\.', '_')}",
+      "${allAttributes('filename', 'number'):isEmpty()}",
+      "${anyAttribute('filename', 'empty'):isEmpty():not()}",
+      "${allDelineatedValues(${list}, ','):in('a', 'b', 'c')}",
+      "${join(${list}, ':')}",
+      "${filename:append(${number}):prepend('x')}");
+
+  const auto tree = expression::compile_tree(expression_string);
+  const auto compiled = expression::compile(expression_string);
+  const auto tree_result = tree(params);
+  const auto compiled_result = compiled(params);
+  CHECK(tree_result.isNull() == compiled_result.isNull());
+  CHECK(tree_result.asString() == compiled_result.asString());
+  CHECK(compiled.evaluate_tree(params).asString() == tree_result.asString());
+}
+
+TEST_CASE("Bytecode compilation folds constant functions and concatenations", "[expressionLanguageBytecode]") {
+  const auto program = compileProgram("a${literal('b'):toUpper()}c${literal(1):plus(2)}");
+  REQUIRE(program.getInstructions().size() == 1);
+  CHECK(program.getInstructions()[0].op_code == bytecode::OpCode::PushConstant);
+  CHECK(program.run(expression::Parameters{}).asString() == "aBc3");
+}
+
+TEST_CASE("Bytecode compilation merges adjacent constants of a concatenation", "[expressionLanguageBytecode]") {
+  const auto program = compileProgram("a${literal('b')}c${filename}d${literal('e')}");
+  CHECK(countInstructions(program, bytecode::OpCode::PushConstant) == 2);
+  CHECK(countInstructions(program, bytecode::OpCode::Concat) == 1);
+  CHECK(countInstructions(program, bytecode::OpCode::LoadAttribute) == 1);
+}
+
+TEST_CASE("Bytecode compilation does not fold impure functions", "[expressionLanguageBytecode]") {
+  const auto program = compileProgram("${UUID()}");
+  CHECK(countInstructions(program, bytecode::OpCode::Call) == 1);
+  const auto first = program.run(expression::Parameters{}).asString();
+  const auto second = program.run(expression::Parameters{}).asString();
+  CHECK(first != second);
+}
+
+TEST_CASE("Bytecode compilation resolves attribute references to slots", "[expressionLanguageBytecode]") {
+  const auto program = compileProgram("${filename:startsWith('a'):or(${filename:endsWith('b')}):and(${other:isEmpty()})}");
+  REQUIRE(program.getAttributeSlots().size() == 2);
+  CHECK(program.getAttributeSlots()[0].name == "filename");
+  CHECK(program.getAttributeSlots()[0].cached);
+  CHECK(program.getAttributeSlots()[1].name == "other");
+  CHECK_FALSE(program.getAttributeSlots()[1].cached);
+  CHECK(countInstructions(program, bytecode::OpCode::LoadAttribute) == 3);
+
+  auto flow_file = std::make_shared<core::FlowFileImpl>();
+  flow_file->addAttribute("filename", "ab");
+  CHECK(program.run(expression::Parameters{flow_file.get()}).asString() == "true");
+}
+
+TEST_CASE("Bytecode VM evaluates multi-attribute functions with the tree walker", "[expressionLanguageBytecode]") {
+  const auto program = compileProgram("${anyAttribute('a', 'b'):equals('x')}");
+  CHECK(countInstructions(program, bytecode::OpCode::EvaluateTree) == 1);
+
+  auto flow_file = std::make_shared<core::FlowFileImpl>();
+  flow_file->addAttribute("b", "x");
+  CHECK(program.run(expression::Parameters{flow_file.get()}).asString() == "true");
+}
+
+TEST_CASE("Bytecode VM reports evaluation errors like the tree walker", "[expressionLanguageBytecode]") {
+  const auto expression_string = "${literal('abc'):toRadix(50)}";
+  CHECK_THROWS_AS(expression::compile_tree(expression_string)(expression::Parameters{}), std::runtime_error);
+  CHECK_THROWS_AS(expression::compile(expression_string)(expression::Parameters{}), std::runtime_error);
+}
+
+TEST_CASE("Evaluating an expression for a batch of flow files gives the same results as evaluating it for each of them", "[expressionLanguageBytecode]") {
+  std::vector<std::shared_ptr<core::FlowFile>> flow_files;
+  for (const auto* filename : {"data.csv", "DATA.json", "", "report.csv.gz"}) {
+    auto flow_file = std::make_shared<core::FlowFileImpl>();
+    flow_file->addAttribute("filename", filename);
+    flow_files.push_back(flow_file);
+  }
+  flow_files[1]->addAttribute("number", "7");
+  flow_files.push_back(std::make_shared<core::FlowFileImpl>());
+
+  const std::string expression_string = GENERATE(as<std::string>{},
+      "static text",
+      "${filename}",
+      "${filename:toLower():endsWith('.csv'):or(${filename:isEmpty()})}",
+      "${number:replaceNull(1):plus(${number:replaceNull(2)})}",
+      "${anyAttribute('filename', 'number'):isEmpty()}");
+
+  for (const auto& evaluated : {expression::compile(expression_string), expression::compile_tree(expression_string)}) {
+    const auto results = evaluated.evaluate_batch(nullptr, flow_files);
+    REQUIRE(results.size() == flow_files.size());
+    for (size_t i = 0; i < flow_files.size(); ++i) {
+      const auto expected = evaluated(expression::Parameters{flow_files[i].get()});
+      CHECK(results[i].isNull() == expected.isNull());
+      CHECK(results[i].asString() == expected.asString());
+    }
+  }
+}
@@ -0,0 +1,125 @@
+/**
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The ASF licenses this file to You under the Apache License, Version 2.0
+ * (the "License"); you may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "expression-language/Expression.h"
+#include "expression-language/RegexCache.h"
+#include "core/FlowFile.h"
+#include "unit/TestBase.h"
+#include "unit/Catch.h"
+
+namespace expression = org::apache::nifi::minifi::expression;
+namespace regex = org::apache::nifi::minifi::expression::regex;
+
+namespace {
+class RegexEngineGuard {
+ public:
+  explicit RegexEngineGuard(regex::Engine engine) {
+    regex::RegexCache::getInstance().setEngine(engine);
+  }
+
+  RegexEngineGuard(const RegexEngineGuard&) = delete;
+  RegexEngineGuard(RegexEngineGuard&&) = delete;
+  RegexEngineGuard& operator=(const RegexEngineGuard&) = delete;
+  RegexEngineGuard& operator=(RegexEngineGuard&&) = delete;
+
+  ~RegexEngineGuard() {
+    regex::RegexCache::getInstance().setEngine(regex::Engine::Standard);
+    regex::RegexCache::getInstance().setCapacity(regex::RegexCache::DEFAULT_CAPACITY);
+  }
+};
+}  // namespace
+
+TEST_CASE("RegexCache reuses the compiled patterns and evicts the least recently used one", "[regexCache]") {
+  RegexEngineGuard guard(regex::Engine::Standard);
+  auto& cache = regex::RegexCache::getInstance();
+  cache.clear();
+  cache.setCapacity(2);
+
+  const auto a = cache.get("a+");
+  CHECK(cache.get("a+") == a);
+  CHECK(cache.get("a+", true) != a);
+  CHECK(cache.size() == 2);
+
+  cache.get("b+");
+  CHECK(cache.size() == 2);
+  CHECK(cache.get("a+") != a);
+
+  cache.setCapacity(0);
+  CHECK(cache.size() == 0);
+  CHECK(cache.get("a+")->matches("aaa"));
+  CHECK(cache.size() == 0);
+}
+
+TEST_CASE("RegexCache compiles with the configured engine", "[regexCache]") {
+  RegexEngineGuard guard(regex::Engine::Linear);
+  auto& cache = regex::RegexCache::getInstance();
+  cache.get("a+");
+  REQUIRE(cache.size() == 1);
+
+  cache.setEngine(regex::Engine::Standard);
+  CHECK(cache.size() == 0);
+  CHECK(cache.getEngine() == regex::Engine::Standard);
+}
+
+TEST_CASE("Expression Language regular expression functions give the same results with both engines", "[expressionLanguageRegex]") {
+  const auto engine = GENERATE(regex::Engine::Standard, regex::Engine::Linear);
+  RegexEngineGuard guard(engine);
+
+  auto flow_file = std::make_shared<core::FlowFileImpl>();
+  flow_file->addAttribute("filename", "data.2024-05-13.csv");
+  flow_file->addAttribute("pattern", "[0-9]+");
+  flow_file->addAttribute("attr.1", "a");
+  flow_file->addAttribute("attr.2", "b");
+  const expression::Parameters params{flow_file.get()};
+
+  const auto evaluate = [&](const std::string& expression_string) {
+    return expression::compile(expression_string)(params).asString();
+  };
+
+  CHECK(evaluate("${filename:matches('data.*csv')}") == "true");
+  CHECK(evaluate("${filename:matches('data')}") == "false");
+  CHECK(evaluate("${filename:find('[0-9]{4}')}") == "true");
+  CHECK(evaluate("${filename:find(${pattern})}") == "true");
+  CHECK(evaluate("${filename:replaceAll('[0-9]', '#')}") == "data.####-##-##.csv");
+  CHECK(evaluate("${filename:replaceAll(${pattern}, 'N')}") == "data.N-N-N.csv");
+  CHECK(evaluate("${filename:replaceFirst('([0-9]+)-([0-9]+)', '$2-$1')}") == "data.05-2024-13.csv");
+  CHECK(evaluate("${literal('a11b23c44'):replaceAll('(\\\\d)\\\\1', 'x')}") == "axb23cx");
+  CHECK(evaluate("${allMatchingAttributes('attr\\\\..*'):isEmpty():not()}") == "true");
+  CHECK(evaluate("${anyMatchingAttribute('attr\\\\..*'):equals('b')}") == "true");
+  CHECK(evaluate("${literal(''):replaceEmpty('empty')}") == "empty");
+  CHECK(evaluate("${filename:replaceEmpty('empty')}") == "data.2024-05-13.csv");
+}
+
+TEST_CASE("Literal patterns are compiled when the expression is parsed", "[expressionLanguageRegex]") {
+  RegexEngineGuard guard(regex::Engine::Standard);
+  auto& cache = regex::RegexCache::getInstance();
+  cache.clear();
+
+  const auto expression = expression::compile("${filename:matches('a.*')}");
+  CHECK(cache.size() == 1);
+  cache.clear();
+
+  auto flow_file = std::make_shared<core::FlowFileImpl>();
+  flow_file->addAttribute("filename", "abc");
+  CHECK(expression(expression::Parameters{flow_file.get()}).asBoolean());
+  CHECK(cache.size() == 0);
+}
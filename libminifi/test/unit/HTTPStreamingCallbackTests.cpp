@@ -165,4 +165,18 @@ TEST_CASE_METHOD(HttpStreamingCallbackTestsFixture, "HttpStreamingCallback multi
 
   REQUIRE(input == content);
 }
+
+TEST_CASE_METHOD(HttpStreamingCallbackTestsFixture, "HttpStreamingCallback rejects data written after close", "[basic]") {
+  std::string input = "foobar";
+  REQUIRE(callback_.process(reinterpret_cast<const uint8_t*>(input.c_str()), input.length()).inner() == input.length());
+  callback_.close();
+
+  std::string late_input = "baz";
+  CHECK(!callback_.process(reinterpret_cast<const uint8_t*>(late_input.c_str()), late_input.length()));
+
+  startConsumerThread();
+  std::string content = waitForCompletionAndGetContent();
+
+  REQUIRE(input == content);
+}
 }  // namespace org::apache::nifi::minifi::test
@@ -0,0 +1,137 @@
+/**
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The ASF licenses this file to You under the Apache License, Version 2.0
+ * (the "License"); you may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <chrono>
+#include <regex>
+#include <string>
+#include <vector>
+
+#include "utils/LinearRegex.h"
+#include "utils/RegexUtils.h"
+#include "minifi-cpp/utils/gsl.h"
+#include "unit/TestBase.h"
+#include "unit/Catch.h"
+
+namespace utils = org::apache::nifi::minifi::utils;
+
+TEST_CASE("LinearRegex gives the same results as std::regex", "[linearRegex]") {
+  const std::string pattern = GENERATE(as<std::string>{},
+      "abc", "a.c", "a*", "a+b", "(a|ab)(c|bcd)(d*)", "x*", "[a-c]+", "[^a-c]+", "\\d+", "\\w+@\\w+\\.com", "\\s*$", "^\\S+",
+      "(\\d{2,3})-(\\d{1,})", "a{3}", "a{2,}?", "(a+?)(a*)", "colou?r", "\\bis\\b", "\\Bis", "(?:ab)+", "[\\d.]+", "[a\\-z]", "(a|b)*c", "(x)?a",
+      "^$", "\\x41", "\\.", "(a)|(b)", ".*", "[.]");
+  const std::string subject = GENERATE(as<std::string>{},
+      "", "abc", "aaa", "xabcdx", "This is an island", "call 555-1234 or 12-3", "john@example.com", "  \t", "AAbaab", "a.b-c", "color colour");
+
+  const std::regex std_regex(pattern);
+  const auto linear_regex = utils::LinearRegex::compile(pattern);
+  REQUIRE(linear_regex);
+
+  CHECK(linear_regex->fullMatch(subject) == std::regex_match(subject, std_regex));
+  CHECK(linear_regex->search(subject) == std::regex_search(subject, std_regex));
+
+  std::smatch std_match;
+  std::vector<size_t> captures;
+  if (std::regex_search(subject, std_match, std_regex)) {
+    REQUIRE(linear_regex->search(subject, 0, &captures));
+    REQUIRE(captures.size() == 2 * std_match.size());
+    for (size_t group = 0; group < std_match.size(); ++group) {
+      if (std_match[group].matched) {
+        CHECK(captures[2 * group] == gsl::narrow<size_t>(std_match.position(group)));
+        CHECK(captures[2 * group + 1] == gsl::narrow<size_t>(std_match.position(group) + std_match.length(group)));
+      } else {
+        CHECK(captures[2 * group] == utils::LinearRegex::NPOS);
+      }
+    }
+  }
+
+  CHECK(linear_regex->replace(subject, "<$&>", true) == std::regex_replace(subject, std_regex, "<$&>", std::regex_constants::format_first_only));
+  CHECK(linear_regex->replace(subject, "[$1|$$]", false) == std::regex_replace(subject, std_regex, "[$1|$$]"));
+}
+
+TEST_CASE("LinearRegex matches case-insensitively", "[linearRegex]") {
+  const auto linear_regex = utils::LinearRegex::compile("[a-c]+x", true);
+  REQUIRE(linear_regex);
+  CHECK(linear_regex->fullMatch("AbCX"));
+  CHECK_FALSE(linear_regex->fullMatch("AbDX"));
+}
+
+TEST_CASE("LinearRegex does not compile the patterns it cannot simulate", "[linearRegex]") {
+  const std::string pattern = GENERATE(as<std::string>{}, "(a)\\1", "a(?=b)", "a(?!b)", "[[:alpha:]]", "a{2", "(ab", "ab)", "*a", "a**", "\\u0041", "a{1001}");
+  CHECK_FALSE(utils::LinearRegex::compile(pattern));
+}
+
+TEST_CASE("LinearRegex runs in linear time on patterns which make backtracking engines explode", "[linearRegex]") {
+  const auto linear_regex = utils::LinearRegex::compile("(a+)+b");
+  REQUIRE(linear_regex);
+  const std::string subject(10000, 'a');
+  const auto start = std::chrono::steady_clock::now();
+  CHECK_FALSE(linear_regex->fullMatch(subject));
+  CHECK_FALSE(linear_regex->search(subject));
+  CHECK(std::chrono::steady_clock::now() - start < std::chrono::seconds(10));
+}
+
+
+TEST_CASE("LinearRegexSet tells which patterns match in a single pass", "[linearRegex]") {
+  const std::vector<std::string> patterns{"ERROR", "^\\d{4}-\\d{2}-\\d{2}", "user=(\\w+)", "timeout|refused", ".*\\.java:\\d+\\)$", "(a+)+b"};
+  const std::string subject = GENERATE(as<std::string>{},
+      "", "2024-05-13 ERROR connection refused", "2024-05-13 INFO user=admin logged in", "\tat Foo.bar(Foo.java:42)", "aaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaab", "ERROR");
+  const auto case_insensitive = GENERATE(false, true);
+
+  const auto regex_set = utils::LinearRegexSet::compile(patterns, case_insensitive);
+  REQUIRE(regex_set);
+  REQUIRE(regex_set->size() == patterns.size());
+  const auto search_results = regex_set->search(subject);
+  const auto full_match_results = regex_set->fullMatch(subject);
+  for (size_t i = 0; i < patterns.size(); ++i) {
+    const std::regex std_regex(patterns[i], case_insensitive ? std::regex::ECMAScript | std::regex::icase : std::regex::ECMAScript);
+    CHECK(search_results[i] == std::regex_search(subject, std_regex));
+    CHECK(full_match_results[i] == std::regex_match(subject, std_regex));
+  }
+}
+
+TEST_CASE("LinearRegexSet does not compile if any of its patterns is unsupported", "[linearRegex]") {
+  CHECK_FALSE(utils::LinearRegexSet::compile(std::vector<std::string>{"a+", "(a)\\1"}));
+  const auto empty_set = utils::LinearRegexSet::compile(std::vector<std::string>{});
+  REQUIRE(empty_set);
+  CHECK(empty_set->search("abc").empty());
+}
+
+TEST_CASE("utils::Regex can evaluate its pattern with the linear engine", "[linearRegex]") {
+  const utils::Regex regex("([a-z]+)-([0-9]+)", {utils::Regex::Mode::LINEAR});
+  CHECK(utils::regexMatch("abc-12", regex));
+  CHECK_FALSE(utils::regexMatch("abc-12x", regex));
+  CHECK(utils::regexSearch(std::string_view{"xx abc-12x"}, regex));
+
+  const std::string subject = "xx abc-12x";
+  utils::SMatch match;
+  REQUIRE(utils::regexSearch(subject, match, regex));
+  REQUIRE(match.size() == 3);
+  CHECK(match.position(0) == 3);
+  CHECK(std::string(match[1]) == "abc");
+  CHECK(std::string(match[2]) == "12");
+  CHECK(std::string(match.suffix()) == "x");
+
+  const std::string pairs = "a-1 b-2 c-3";
+  const auto last_match = utils::getLastRegexMatch(pairs, regex);
+  REQUIRE(last_match.ready());
+  CHECK(std::string(last_match[1]) == "c");
+
+  const utils::Regex copy = regex;
+  CHECK(utils::regexMatch("q-1", copy));
+  CHECK(utils::regexMatch("ABb", utils::Regex("ab+", {utils::Regex::Mode::LINEAR, utils::Regex::Mode::ICASE})));
+}
@@ -0,0 +1,55 @@
+/**
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The ASF licenses this file to You under the Apache License, Version 2.0
+ * (the "License"); you may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <stdexcept>
+#include <string>
+
+#include "unit/TestBase.h"
+#include "unit/Catch.h"
+#include "utils/OrderedTaskPool.h"
+
+TEST_CASE("OrderedTaskPool hands out the results in the order the tasks were added") {
+  utils::OrderedTaskPool<std::string> pool(3);
+  for (size_t i = 0; i < 20; ++i) {
+    pool.add([i] { return std::to_string(i); });
+  }
+  CHECK(pool.size() == 20);
+  for (size_t i = 0; i < 20; ++i) {
+    CHECK(pool.takeNext() == std::to_string(i));
+  }
+  CHECK(pool.size() == 0);
+}
+
+TEST_CASE("OrderedTaskPool rethrows the exception of a task when its result is taken") {
+  utils::OrderedTaskPool<std::string> pool(3);
+  for (size_t i = 0; i < 10; ++i) {
+    pool.add([i]() -> std::string {
+      if (i == 4) {
+        throw std::runtime_error("task 4 failed");
+      }
+      return std::to_string(i);
+    });
+  }
+  for (size_t i = 0; i < 4; ++i) {
+    CHECK(pool.takeNext() == std::to_string(i));
+  }
+  CHECK_THROWS_WITH(pool.takeNext(), "task 4 failed");
+  for (size_t i = 5; i < 10; ++i) {
+    CHECK(pool.takeNext() == std::to_string(i));
+  }
+}
@@ -0,0 +1,113 @@
+/**
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The ASF licenses this file to You under the Apache License, Version 2.0
+ * (the "License"); you may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <map>
+#include <set>
+#include <string>
+#include <vector>
+
+#include "unit/TestBase.h"
+#include "unit/Catch.h"
+#include "sitetosite/PeerSelector.h"
+
+namespace org::apache::nifi::minifi::test {
+
+namespace {
+std::vector<sitetosite::PeerStatus> createPeers(const std::vector<uint32_t>& flow_file_counts) {
+  const auto port_id = utils::IdGenerator::getIdGenerator()->generate();
+  std::vector<sitetosite::PeerStatus> peers;
+  for (size_t i = 0; i < flow_file_counts.size(); ++i) {
+    peers.emplace_back(port_id, "host" + std::to_string(i), gsl::narrow<uint16_t>(8080 + i), flow_file_counts[i], true);
+  }
+  return peers;
+}
+
+std::map<std::string, size_t> countSelections(sitetosite::PeerSelector& selector, size_t selections) {
+  std::map<std::string, size_t> counts;
+  for (size_t i = 0; i < selections; ++i) {
+    auto peer = selector.next();
+    REQUIRE(peer);
+    ++counts[peer->getHost()];
+  }
+  return counts;
+}
+}  // namespace
+
+TEST_CASE("PeerSelector without peers selects nothing", "[peerselector]") {
+  sitetosite::PeerSelector selector(sitetosite::TransferDirection::SEND, 0);
+  CHECK(selector.empty());
+  CHECK_FALSE(selector.next());
+  CHECK(selector.nextDistinct(3).empty());
+}
+
+TEST_CASE("PeerSelector weights peers equally if nothing is queued", "[peerselector]") {
+  const auto weights = sitetosite::PeerSelector::calculateWeights(sitetosite::TransferDirection::SEND, createPeers({0, 0, 0}));
+  CHECK(weights == std::vector<double>{1.0, 1.0, 1.0});
+}
+
+TEST_CASE("PeerSelector prefers less loaded peers when sending", "[peerselector]") {
+  const auto weights = sitetosite::PeerSelector::calculateWeights(sitetosite::TransferDirection::SEND, createPeers({900, 100}));
+  REQUIRE(weights.size() == 2);
+  CHECK(weights[0] == Catch::Approx(0.2));
+  CHECK(weights[1] == Catch::Approx(0.9));
+
+  sitetosite::PeerSelector selector(sitetosite::TransferDirection::SEND, 42);
+  selector.setPeers(createPeers({900, 100}));
+  const auto counts = countSelections(selector, 1000);
+  CHECK(counts.at("host1") > 3 * counts.at("host0"));
+}
+
+TEST_CASE("PeerSelector prefers more loaded peers when receiving", "[peerselector]") {
+  const auto weights = sitetosite::PeerSelector::calculateWeights(sitetosite::TransferDirection::RECEIVE, createPeers({900, 100}));
+  REQUIRE(weights.size() == 2);
+  CHECK(weights[0] == Catch::Approx(0.9));
+  CHECK(weights[1] == Catch::Approx(0.2));
+}
+
+TEST_CASE("PeerSelector never starves a peer", "[peerselector]") {
+  sitetosite::PeerSelector selector(sitetosite::TransferDirection::SEND, 42);
+  selector.setPeers(createPeers({100000, 0, 0}));
+  const auto counts = countSelections(selector, 1000);
+  CHECK(counts.contains("host0"));
+}
+
+TEST_CASE("PeerSelector can select distinct peers for parallel transactions", "[peerselector]") {
+  sitetosite::PeerSelector selector(sitetosite::TransferDirection::SEND, 42);
+  selector.setPeers(createPeers({10, 20, 30}));
+
+  const auto two_peers = selector.nextDistinct(2);
+  REQUIRE(two_peers.size() == 2);
+  CHECK(two_peers[0].getHost() != two_peers[1].getHost());
+
+  std::set<std::string> hosts;
+  for (const auto& peer : selector.nextDistinct(5)) {
+    hosts.insert(peer.getHost());
+  }
+  CHECK(hosts == std::set<std::string>{"host0", "host1", "host2"});
+}
+
+TEST_CASE("PeerSelector needs refresh after the refresh interval", "[peerselector]") {
+  using namespace std::literals::chrono_literals;
+  sitetosite::PeerSelector selector(sitetosite::TransferDirection::SEND, 42);
+  CHECK(selector.needsRefresh(1min));
+
+  const auto now = std::chrono::steady_clock::now();
+  selector.setPeers(createPeers({1, 2}), now);
+  CHECK_FALSE(selector.needsRefresh(1min, now + 30s));
+  CHECK(selector.needsRefresh(1min, now + 1min));
+}
+
+}  // namespace org::apache::nifi::minifi::test
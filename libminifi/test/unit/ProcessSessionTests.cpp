@@ -122,6 +122,12 @@ TEST_CASE("ProcessSession::append should append to the flowfile and set its size
   }
 }
 
+TEST_CASE("ProcessSession::append does not change the other flowfiles sharing the content of a clone", "[appendclone]") {
+  const bool commit_original = GENERATE(false, true);
+  ContentRepositoryDependentTests::testAppendToClonedFlowFiles(std::make_shared<minifi::core::repository::VolatileContentRepository>(), commit_original);
+  ContentRepositoryDependentTests::testAppendToClonedFlowFiles(std::make_shared<minifi::core::repository::FileSystemRepository>(), commit_original);
+}
+
 TEST_CASE("ProcessSession::read can read zero length flowfiles without crash", "[zerolengthread]") {
   ContentRepositoryDependentTests::testReadFromZeroLengthFlowFile(std::make_shared<core::repository::VolatileContentRepository>());
   ContentRepositoryDependentTests::testReadFromZeroLengthFlowFile(std::make_shared<core::repository::FileSystemRepository>());
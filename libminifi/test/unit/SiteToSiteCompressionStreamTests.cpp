@@ -14,8 +14,13 @@
  * See the License for the specific language governing permissions and
  * limitations under the License.
  */
+#include <algorithm>
+#include <random>
+#include <vector>
+
 #include "unit/Catch.h"
 #include "unit/TestBase.h"
+#include "catch2/generators/catch_generators.hpp"
 #include "sitetosite/CompressionOutputStream.h"
 #include "sitetosite/CompressionInputStream.h"
 #include "io/BufferStream.h"
@@ -212,4 +217,62 @@ TEST_CASE("Read large number of bytes that uses multiple buffers", "[Compression
   }
 }
 
+TEST_CASE("Compressed data can be read back with every codec", "[CompressionOutputStream]") {
+  const auto codec = GENERATE(sitetosite::CompressionCodec::ZLIB, sitetosite::CompressionCodec::LZ4, sitetosite::CompressionCodec::ZSTD);
+  const size_t parallelism = GENERATE(1, 4);
+  CAPTURE(sitetosite::compressionCodecName(codec), parallelism);
+
+  io::BufferStream buffer_stream;
+  sitetosite::CompressionOutputStream output_stream(buffer_stream, codec, parallelism);
+  constexpr uint32_t count = 100000;
+  for (uint32_t i = 0; i < count; ++i) {
+    CHECK(output_stream.write(i) == 4);
+  }
+  output_stream.close();
+
+  sitetosite::CompressionInputStream input_stream(buffer_stream, codec);
+  for (uint32_t i = 0; i < count; ++i) {
+    uint32_t read_value{};
+    REQUIRE(input_stream.read(read_value) == 4);
+    REQUIRE(read_value == i);
+  }
+}
+
+TEST_CASE("Incompressible data can be read back", "[CompressionOutputStream]") {
+  const auto codec = GENERATE(sitetosite::CompressionCodec::ZLIB, sitetosite::CompressionCodec::LZ4, sitetosite::CompressionCodec::ZSTD);
+  CAPTURE(sitetosite::compressionCodecName(codec));
+
+  std::mt19937 random_engine(42);  // NOLINT(cert-msc32-c,cert-msc51-cpp)
+  std::vector<std::byte> data(3 * sitetosite::COMPRESSION_BUFFER_SIZE + 123);
+  std::generate(data.begin(), data.end(), [&] { return static_cast<std::byte>(random_engine()); });
+
+  io::BufferStream buffer_stream;
+  sitetosite::CompressionOutputStream output_stream(buffer_stream, codec, 2);
+  REQUIRE(output_stream.write(data) == data.size());
+  output_stream.close();
+
+  sitetosite::CompressionInputStream input_stream(buffer_stream, codec);
+  std::vector<std::byte> read_data(data.size());
+  REQUIRE(input_stream.read(read_data) == data.size());
+  CHECK(read_data == data);
+}
+
+TEST_CASE("Parallel compression keeps the zlib framing", "[CompressionOutputStream]") {
+  io::BufferStream buffer_stream;
+  sitetosite::CompressionOutputStream output_stream(buffer_stream, sitetosite::CompressionCodec::ZLIB, 3);
+  for (size_t i = 0; i < 40000; ++i) {
+    CHECK(output_stream.write(static_cast<uint32_t>(42)) == 4);
+  }
+  output_stream.close();
+
+  verifyCompressedChunks(buffer_stream, 160000);
+}
+
+TEST_CASE("Compression codec names can be parsed", "[CompressionCodec]") {
+  CHECK(sitetosite::parseCompressionCodec("zlib") == sitetosite::CompressionCodec::ZLIB);
+  CHECK(sitetosite::parseCompressionCodec("LZ4") == sitetosite::CompressionCodec::LZ4);
+  CHECK(sitetosite::parseCompressionCodec("zstd") == sitetosite::CompressionCodec::ZSTD);
+  CHECK_FALSE(sitetosite::parseCompressionCodec("gzip"));
+}
+
 }  // namespace org::apache::nifi::minifi::test
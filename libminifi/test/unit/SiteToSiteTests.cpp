@@ -21,6 +21,7 @@
 #include <memory>
 #include <string>
 #include <utility>
+#include <vector>
 
 #include "minifi-cpp/io/BaseStream.h"
 #include "sitetosite/Peer.h"
@@ -283,6 +284,39 @@ TEST_CASE("TestSiteToSiteVerifyNegotiationFail", "[S2S]") {
   REQUIRE_FALSE(SiteToSiteClientTestAccessor::bootstrap(protocol));
 }
 
+TEST_CASE("Raw Site2Site client falls back to zlib if the peer rejects the compression codec", "[S2S]") {
+  initializeLogging();
+  auto collector = std::make_unique<SiteToSiteResponder>();
+  auto collector_ptr = collector.get();
+
+  const std::string resource_ok{static_cast<char>(magic_enum::enum_underlying(sitetosite::ResourceNegotiationStatusCode::RESOURCE_OK))};
+  collector->push_response(resource_ok);
+  collector->push_response("R");
+  collector->push_response("C");
+  collector->push_response(std::string{static_cast<char>(magic_enum::enum_underlying(sitetosite::ResponseCode::UNKNOWN_PROPERTY_NAME))});
+  const std::string error_message = "Unknown property COMPRESSION_CODEC";
+  collector->push_response(std::string{'\0', static_cast<char>(error_message.size())});
+  collector->push_response(error_message);
+  initializeMockBootstrapResponses(*collector);
+
+  auto peer = gsl::make_not_null(std::make_unique<sitetosite::SiteToSitePeer>(std::move(collector), "fake_host", 65433, ""));
+  sitetosite::RawSiteToSiteClient protocol(std::move(peer));
+  protocol.setPortId(minifi::utils::Identifier::parse("C56A4180-65AA-42EC-A945-5FD21DEC0538").value());
+  protocol.setUseCompression(true);
+  protocol.setCompressionCodec(sitetosite::CompressionCodec::ZSTD);
+
+  REQUIRE(SiteToSiteClientTestAccessor::bootstrap(protocol));
+  CHECK(protocol.getCompressionCodec() == sitetosite::CompressionCodec::ZLIB);
+
+  std::vector<std::string> client_responses;
+  while (collector_ptr->has_client_response()) {
+    client_responses.push_back(collector_ptr->get_next_client_response());
+  }
+  CHECK(std::count(client_responses.begin(), client_responses.end(), "COMPRESSION_CODEC") == 1);
+  CHECK(std::count(client_responses.begin(), client_responses.end(), "zstd") == 1);
+  CHECK(std::count(client_responses.begin(), client_responses.end(), "SocketFlowFileProtocol") == 2);
+}
+
 void initializeMockRemoteClientReceiveDataResponses(SiteToSiteResponder& collector, bool use_compression) {
   auto addResponseCode = [&collector](sitetosite::ResponseCode code) {
     collector.push_response("R");
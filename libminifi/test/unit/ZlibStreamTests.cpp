@@ -117,3 +117,30 @@ TEST_CASE("gzip compression and decompression pipeline", "[basic]") {
   REQUIRE(decompressStream.isFinished());
   REQUIRE(original == utils::span_to<std::string>(utils::as_span<const char>(output.getBuffer())));
 }
+
+TEST_CASE("multi-member gzip decompression", "[basic]") {
+  io::BufferStream compressBuffer;
+  std::string original;
+  for (const auto* member : {"foo", "bar", "baz"}) {
+    io::ZlibCompressStream compressStream(gsl::make_not_null(&compressBuffer));
+    const auto length = strlen(member);
+    REQUIRE(length == compressStream.write(reinterpret_cast<const uint8_t*>(member), length));
+    compressStream.close();
+    original += member;
+  }
+
+  io::BufferStream decompressBuffer;
+  io::ZlibDecompressStream decompressStream(gsl::make_not_null(&decompressBuffer));
+
+  SECTION("The members are written at once") {
+    REQUIRE(compressBuffer.size() == decompressStream.write(compressBuffer.getBuffer()));
+  }
+  SECTION("The members are written byte by byte") {
+    for (const auto byte : compressBuffer.getBuffer()) {
+      REQUIRE(1 == decompressStream.write(std::span(&byte, 1)));
+    }
+  }
+
+  REQUIRE(decompressStream.isFinished());
+  REQUIRE(original == utils::span_to<std::string>(utils::as_span<const char>(decompressBuffer.getBuffer())));
+}
@@ -0,0 +1,143 @@
+/**
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The ASF licenses this file to You under the Apache License, Version 2.0
+ * (the "License"); you may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <algorithm>
+#include <chrono>
+#include <random>
+#include <span>
+#include <string>
+#include <vector>
+
+#include "benchmark/benchmark.h"
+#include "ContentCompression.h"
+#include "io/BufferStream.h"
+#include "io/ZlibStream.h"
+#include "ParallelZipWriter.h"
+#include "minifi-cpp/utils/gsl.h"
+
+namespace minifi = org::apache::nifi::minifi;
+
+namespace {
+
+constexpr size_t PAYLOAD_SIZE = 32 * 1024 * 1024;
+constexpr size_t BLOCK_SIZE = 1024 * 1024;
+
+// log lines, which compress to about a fifth of their size, like most of the text content flowing through an agent
+const std::string& getPayload() {
+  static const std::string payload = [] {
+    std::mt19937 random_engine(42);  // NOLINT(cert-msc32-c,cert-msc51-cpp)
+    std::string result;
+    result.reserve(PAYLOAD_SIZE);
+    while (result.size() < PAYLOAD_SIZE) {
+      result += "[2024-05-13 10:" + std::to_string(random_engine() % 60) + ":" + std::to_string(random_engine() % 60) + "] [org::apache::nifi::minifi::core::ProcessSession] "
+          + "[INFO] Transferred flow file " + std::to_string(random_engine()) + " of size " + std::to_string(random_engine() % 65536) + "\n";
+    }
+    return result;
+  }();
+  return payload;
+}
+
+std::string formatName(minifi::io::CompressionFormat format) {
+  return std::string{magic_enum::enum_name(format)};
+}
+
+// the single member gzip stream CompressContent writes with one thread
+void BM_CompressGzipStream(benchmark::State& state) {
+  const auto& payload = getPayload();
+  const auto level = gsl::narrow<int>(state.range(0));
+  size_t compressed_size = 0;
+  for (auto _ : state) {
+    minifi::io::BufferStream output;
+    {
+      minifi::io::ZlibCompressStream compress_stream(gsl::make_not_null(&output), minifi::io::ZlibCompressionFormat::GZIP, level);
+      compress_stream.write(reinterpret_cast<const uint8_t*>(payload.data()), payload.size());
+      compress_stream.close();
+    }
+    compressed_size = output.size();
+    benchmark::DoNotOptimize(compressed_size);
+  }
+  state.SetBytesProcessed(gsl::narrow<int64_t>(state.iterations() * payload.size()));
+  state.counters["ratio"] = static_cast<double>(payload.size()) / static_cast<double>(compressed_size);
+}
+
+void BM_CompressInBlocks(benchmark::State& state) {
+  const auto format = static_cast<minifi::io::CompressionFormat>(state.range(0));
+  const auto level = gsl::narrow<int>(state.range(1));
+  const auto thread_count = gsl::narrow<size_t>(state.range(2));
+  const auto& payload = getPayload();
+  size_t compressed_size = 0;
+  for (auto _ : state) {
+    minifi::io::BufferStream input(payload);
+    minifi::io::BufferStream output;
+    benchmark::DoNotOptimize(minifi::io::compressInBlocks(input, output, format, level, BLOCK_SIZE, thread_count));
+    compressed_size = output.size();
+  }
+  state.SetBytesProcessed(gsl::narrow<int64_t>(state.iterations() * payload.size()));
+  state.counters["ratio"] = static_cast<double>(payload.size()) / static_cast<double>(compressed_size);
+  state.SetLabel(formatName(format));
+}
+
+void BM_DecompressFrames(benchmark::State& state) {
+  const auto format = static_cast<minifi::io::CompressionFormat>(state.range(0));
+  const auto& payload = getPayload();
+  minifi::io::BufferStream compressed;
+  {
+    minifi::io::BufferStream input(payload);
+    minifi::io::compressInBlocks(input, compressed, format, 1, BLOCK_SIZE, 1);
+  }
+  for (auto _ : state) {
+    minifi::io::BufferStream input(compressed.getBuffer());
+    minifi::io::BufferStream output;
+    benchmark::DoNotOptimize(minifi::io::decompressFrames(input, output, format));
+  }
+  state.SetBytesProcessed(gsl::narrow<int64_t>(state.iterations() * payload.size()));
+  state.SetLabel(formatName(format));
+}
+
+// the ZIP archive MergeContent writes of a bin of 1 MB flow files
+void BM_ParallelZipWriter(benchmark::State& state) {
+  const auto thread_count = gsl::narrow<size_t>(state.range(0));
+  const auto payload = as_bytes(std::span(getPayload()));
+  size_t archive_size = 0;
+  for (auto _ : state) {
+    minifi::io::BufferStream output;
+    minifi::io::ParallelZipWriter zip_writer(output, 6, thread_count);
+    for (size_t offset = 0; offset < payload.size(); offset += BLOCK_SIZE) {
+      const auto entry = payload.subspan(offset, std::min(BLOCK_SIZE, payload.size() - offset));
+      zip_writer.addEntry("entry" + std::to_string(offset / BLOCK_SIZE), {entry.begin(), entry.end()}, 0100644, std::chrono::system_clock::now());
+    }
+    benchmark::DoNotOptimize(zip_writer.finish());
+    archive_size = output.size();
+  }
+  state.SetBytesProcessed(gsl::narrow<int64_t>(state.iterations() * payload.size()));
+  state.counters["ratio"] = static_cast<double>(payload.size()) / static_cast<double>(archive_size);
+}
+
+}  // namespace
+
+// compression level
+BENCHMARK(BM_CompressGzipStream)->Arg(1)->Arg(6)->Unit(benchmark::kMillisecond)->UseRealTime();
+// format (0: gzip, 4: zstd, 5: lz4) x compression level x thread count
+BENCHMARK(BM_CompressInBlocks)->ArgsProduct({{0}, {1, 6}, {1, 2, 4, 8}})->Unit(benchmark::kMillisecond)->UseRealTime();
+BENCHMARK(BM_CompressInBlocks)->ArgsProduct({{4}, {1, 3, 9}, {1, 2, 4, 8}})->Unit(benchmark::kMillisecond)->UseRealTime();
+BENCHMARK(BM_CompressInBlocks)->ArgsProduct({{5}, {1, 9}, {1, 2, 4, 8}})->Unit(benchmark::kMillisecond)->UseRealTime();
+// format (4: zstd, 5: lz4)
+BENCHMARK(BM_DecompressFrames)->Arg(4)->Arg(5)->Unit(benchmark::kMillisecond);
+// thread count
+BENCHMARK(BM_ParallelZipWriter)->Arg(1)->Arg(2)->Arg(4)->Arg(8)->Unit(benchmark::kMillisecond)->UseRealTime();
+
+BENCHMARK_MAIN();
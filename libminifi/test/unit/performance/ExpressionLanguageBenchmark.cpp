@@ -0,0 +1,116 @@
+/**
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The ASF licenses this file to You under the Apache License, Version 2.0
+ * (the "License"); you may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <array>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "benchmark/benchmark.h"
+#include "core/FlowFile.h"
+#include "expression-language/Expression.h"
+#include "expression-language/RegexCache.h"
+#include "minifi-cpp/utils/gsl.h"
+
+namespace minifi = org::apache::nifi::minifi;
+
+namespace {
+
+constexpr std::array<const char*, 6> EXPRESSIONS{
+    "${filename}",
+    "${filename:substringBefore('.'):toUpper():equals('X')}",
+    "${filename:startsWith('data'):and(${filename:endsWith('.csv')}):or(${mime.type:equals('text/csv')})}",
+    "${path}/${filename:substringBeforeLast('.')}.${literal('json'):toUpper()}",
+    "${fileSize:plus(1024):divide(2):gt(4096)}",
+    "${allAttributes('filename', 'path'):isEmpty():not()}"};
+
+constexpr std::array<const char*, 5> REGEX_EXPRESSIONS{
+    "${filename:matches('data\\\\.[0-9-]+\\\\.csv')}",
+    "${filename:replaceAll('([0-9]+)-([0-9]+)', '$2_$1')}",
+    "${filename:find(${pattern})}",
+    "${allMatchingAttributes('file.*'):isEmpty()}",
+    "${path:matches('(/[a-z]+)+/')}"};
+
+std::shared_ptr<minifi::core::FlowFile> createFlowFile() {
+  auto flow_file = std::make_shared<minifi::core::FlowFileImpl>();
+  flow_file->addAttribute("filename", "data.2024-05-13.csv");
+  flow_file->addAttribute("path", "/var/data/incoming");
+  flow_file->addAttribute("mime.type", "text/csv");
+  flow_file->addAttribute("fileSize", "123456");
+  flow_file->addAttribute("pattern", "[0-9]{4}");
+  return flow_file;
+}
+
+template<minifi::expression::Expression Compile(const std::string&)>
+void BM_EvaluateExpression(benchmark::State& state) {
+  const auto expression = Compile(EXPRESSIONS.at(gsl::narrow<size_t>(state.range(0))));
+  const auto flow_file = createFlowFile();
+  const minifi::expression::Parameters params{flow_file.get()};
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(expression(params));
+  }
+  state.SetItemsProcessed(state.iterations());
+  state.SetLabel(EXPRESSIONS.at(gsl::narrow<size_t>(state.range(0))));
+}
+
+constexpr size_t BATCH_SIZE = 1000;
+
+// the expression is evaluated for each flow file of a batch, like RouteOnAttribute does with a Batch Size of 1
+void BM_EvaluateExpressionPerFlowFile(benchmark::State& state) {
+  const auto expression = minifi::expression::compile(EXPRESSIONS.at(gsl::narrow<size_t>(state.range(0))));
+  std::vector<std::shared_ptr<minifi::core::FlowFile>> flow_files(BATCH_SIZE, createFlowFile());
+  for (auto _ : state) {
+    for (const auto& flow_file : flow_files) {
+      benchmark::DoNotOptimize(expression(minifi::expression::Parameters{flow_file.get()}));
+    }
+  }
+  state.SetItemsProcessed(gsl::narrow<int64_t>(state.iterations() * BATCH_SIZE));
+  state.SetLabel(EXPRESSIONS.at(gsl::narrow<size_t>(state.range(0))));
+}
+
+void BM_EvaluateExpressionBatch(benchmark::State& state) {
+  const auto expression = minifi::expression::compile(EXPRESSIONS.at(gsl::narrow<size_t>(state.range(0))));
+  std::vector<std::shared_ptr<minifi::core::FlowFile>> flow_files(BATCH_SIZE, createFlowFile());
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(expression.evaluate_batch(nullptr, flow_files));
+  }
+  state.SetItemsProcessed(gsl::narrow<int64_t>(state.iterations() * BATCH_SIZE));
+  state.SetLabel(EXPRESSIONS.at(gsl::narrow<size_t>(state.range(0))));
+}
+
+template<minifi::expression::regex::Engine Engine>
+void BM_EvaluateRegexExpression(benchmark::State& state) {
+  minifi::expression::regex::RegexCache::getInstance().setEngine(Engine);
+  const auto expression = minifi::expression::compile(REGEX_EXPRESSIONS.at(gsl::narrow<size_t>(state.range(0))));
+  const auto flow_file = createFlowFile();
+  const minifi::expression::Parameters params{flow_file.get()};
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(expression(params));
+  }
+  state.SetItemsProcessed(state.iterations());
+  state.SetLabel(REGEX_EXPRESSIONS.at(gsl::narrow<size_t>(state.range(0))));
+}
+
+}  // namespace
+
+BENCHMARK(BM_EvaluateExpression<minifi::expression::compile_tree>)->Name("TreeWalker")->DenseRange(0, gsl::narrow<int64_t>(EXPRESSIONS.size() - 1));
+BENCHMARK(BM_EvaluateExpression<minifi::expression::compile>)->Name("Bytecode")->DenseRange(0, gsl::narrow<int64_t>(EXPRESSIONS.size() - 1));
+BENCHMARK(BM_EvaluateExpressionPerFlowFile)->DenseRange(0, gsl::narrow<int64_t>(EXPRESSIONS.size() - 1));
+BENCHMARK(BM_EvaluateExpressionBatch)->DenseRange(0, gsl::narrow<int64_t>(EXPRESSIONS.size() - 1));
+BENCHMARK(BM_EvaluateRegexExpression<minifi::expression::regex::Engine::Standard>)->Name("StandardRegex")->DenseRange(0, gsl::narrow<int64_t>(REGEX_EXPRESSIONS.size() - 1));
+BENCHMARK(BM_EvaluateRegexExpression<minifi::expression::regex::Engine::Linear>)->Name("LinearRegex")->DenseRange(0, gsl::narrow<int64_t>(REGEX_EXPRESSIONS.size() - 1));
+
+BENCHMARK_MAIN();
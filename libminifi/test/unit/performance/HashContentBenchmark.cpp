@@ -0,0 +1,103 @@
+/**
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The ASF licenses this file to You under the Apache License, Version 2.0
+ * (the "License"); you may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <memory>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "benchmark/benchmark.h"
+#include "io/BufferStream.h"
+#include "minifi-cpp/utils/gsl.h"
+#include "processors/HashContent.h"
+
+namespace minifi = org::apache::nifi::minifi;
+namespace hash_content = minifi::processors::hash_content;
+
+namespace {
+
+constexpr size_t PAYLOAD_SIZE = 64 * 1024 * 1024;
+
+const std::string& getPayload() {
+  static const std::string payload = [] {
+    std::mt19937_64 random_engine(42);  // NOLINT(cert-msc32-c,cert-msc51-cpp)
+    std::string result(PAYLOAD_SIZE, '\0');
+    for (auto& c : result) {
+      c = static_cast<char>(random_engine());
+    }
+    return result;
+  }();
+  return payload;
+}
+
+const std::vector<std::vector<std::string_view>> ALGORITHM_SETS{
+  {"MD5"}, {"SHA1"}, {"SHA256"}, {"XXH3"}, {"BLAKE3"}, {"MD5", "SHA256"}, {"MD5", "SHA256", "XXH3"}
+};
+
+std::string label(const std::vector<std::string_view>& algorithms) {
+  std::string result;
+  for (const auto algorithm : algorithms) {
+    result += (result.empty() ? "" : "+") + std::string{algorithm};
+  }
+  return result;
+}
+
+// all the digests of the set are updated while reading the content once
+void BM_HashContentSinglePass(benchmark::State& state) {
+  const auto& algorithms = ALGORITHM_SETS.at(gsl::narrow<size_t>(state.range(0)));
+  const auto& payload = getPayload();
+  minifi::io::BufferStream stream(payload);
+  for (auto _ : state) {
+    std::vector<std::unique_ptr<hash_content::Digest>> digests;
+    for (const auto algorithm : algorithms) {
+      digests.push_back(hash_content::createDigest(algorithm));
+    }
+    stream.seek(0);
+    benchmark::DoNotOptimize(hash_content::updateDigests(stream, digests));
+    for (const auto& digest : digests) {
+      benchmark::DoNotOptimize(digest->finalize());
+    }
+  }
+  state.SetBytesProcessed(gsl::narrow<int64_t>(state.iterations() * payload.size()));
+  state.SetLabel(label(algorithms));
+}
+
+// the content is read once for each digest of the set, like by a chain of HashContent processors with a single algorithm each
+void BM_HashContentPassPerAlgorithm(benchmark::State& state) {
+  const auto& algorithms = ALGORITHM_SETS.at(gsl::narrow<size_t>(state.range(0)));
+  const auto& payload = getPayload();
+  minifi::io::BufferStream stream(payload);
+  for (auto _ : state) {
+    for (const auto algorithm : algorithms) {
+      std::vector<std::unique_ptr<hash_content::Digest>> digests;
+      digests.push_back(hash_content::createDigest(algorithm));
+      stream.seek(0);
+      benchmark::DoNotOptimize(hash_content::updateDigests(stream, digests));
+      benchmark::DoNotOptimize(digests[0]->finalize());
+    }
+  }
+  state.SetBytesProcessed(gsl::narrow<int64_t>(state.iterations() * payload.size()));
+  state.SetLabel(label(algorithms));
+}
+
+}  // namespace
+
+// index into ALGORITHM_SETS
+BENCHMARK(BM_HashContentSinglePass)->DenseRange(0, 6)->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_HashContentPassPerAlgorithm)->DenseRange(5, 6)->Unit(benchmark::kMillisecond);
+
+BENCHMARK_MAIN();
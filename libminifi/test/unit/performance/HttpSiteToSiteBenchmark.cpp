@@ -0,0 +1,74 @@
+/**
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The ASF licenses this file to You under the Apache License, Version 2.0
+ * (the "License"); you may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "benchmark/benchmark.h"
+#include "unit/TestBase.h"
+#include "unit/DummyProcessor.h"
+#include "integration/MockSiteToSiteServer.h"
+#include "io/BufferStream.h"
+#include "minifi-cpp/utils/gsl.h"
+#include "sitetosite/HttpSiteToSiteClient.h"
+
+namespace minifi = org::apache::nifi::minifi;
+
+namespace {
+
+void BM_HttpSiteToSiteSend(benchmark::State& state) {
+  const auto flow_file_size = gsl::narrow<size_t>(state.range(0));
+  const auto flow_files_per_transaction = gsl::narrow<size_t>(state.range(1));
+
+  LogTestController::getInstance().setOff<minifi::sitetosite::HttpSiteToSiteClient>();
+  TestController test_controller;
+  auto plan = test_controller.createPlan();
+  plan->addProcessor<minifi::test::DummyProcessor>("dummy");
+  plan->runNextProcessor();
+  auto context = plan->getCurrentContext();
+
+  minifi::test::MockSiteToSiteServer server(false);
+  minifi::sitetosite::HttpSiteToSiteClient client(
+      gsl::make_not_null(std::make_unique<minifi::sitetosite::SiteToSitePeer>("localhost", gsl::narrow<uint16_t>(std::stoi(server.getPort())), "")));
+  client.setPortId(minifi::utils::IdGenerator::getIdGenerator()->generate());
+
+  const std::string content(flow_file_size, 'x');
+  for (auto _ : state) {
+    state.PauseTiming();
+    std::vector<minifi::sitetosite::FlowFileWithContent> flow_files;
+    for (size_t i = 0; i < flow_files_per_transaction; ++i) {
+      auto flow_file = std::make_shared<minifi::core::FlowFileImpl>();
+      flow_file->setSize(content.size());
+      flow_files.push_back({flow_file, std::make_shared<minifi::io::BufferStream>(content)});
+    }
+    state.ResumeTiming();
+    if (!client.sendFlowFiles(*context, flow_files)) {
+      state.SkipWithError("Failed to send flow files");
+      break;
+    }
+  }
+  state.SetBytesProcessed(gsl::narrow<int64_t>(server.getReceivedBytes()));
+  state.SetItemsProcessed(gsl::narrow<int64_t>(server.getReceivedFlowFileCount()));
+  state.counters["connections"] = static_cast<double>(server.getConnectionCount());
+}
+
+}  // namespace
+
+// flow file size x flow files per transaction
+BENCHMARK(BM_HttpSiteToSiteSend)->ArgsProduct({{1024, 64 * 1024, 1024 * 1024}, {1, 100}})->Unit(benchmark::kMillisecond)->UseRealTime();
+
+BENCHMARK_MAIN();
@@ -0,0 +1,100 @@
+/**
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The ASF licenses this file to You under the Apache License, Version 2.0
+ * (the "License"); you may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <algorithm>
+#include <random>
+#include <string>
+#include <string_view>
+
+#include "benchmark/benchmark.h"
+#include "minifi-cpp/utils/gsl.h"
+#include "utils/ByteScanner.h"
+
+namespace minifi = org::apache::nifi::minifi;
+
+namespace {
+
+constexpr size_t CORPUS_SIZE = 16 * 1024 * 1024;
+
+// log-like lines of printable characters, the lengths vary uniformly between half and one and a half times the average line length
+std::string createCorpus(size_t average_line_length, std::string_view line_ending) {
+  std::mt19937 generator(42);  // NOLINT(cert-msc32-c,cert-msc51-cpp), the corpus should be the same in every run
+  std::uniform_int_distribution<size_t> line_length_distribution(average_line_length / 2, average_line_length * 3 / 2);
+  std::uniform_int_distribution<int> character_distribution(' ', '~');
+  std::string corpus;
+  corpus.reserve(CORPUS_SIZE + 2 * average_line_length);
+  while (corpus.size() < CORPUS_SIZE) {
+    const auto line_length = line_length_distribution(generator);
+    for (size_t i = 0; i < line_length; ++i) {
+      corpus.push_back(static_cast<char>(character_distribution(generator)));
+    }
+    corpus.append(line_ending);
+  }
+  return corpus;
+}
+
+template<typename Find>
+void countLines(benchmark::State& state, std::string_view line_ending, Find find) {
+  const auto corpus = createCorpus(gsl::narrow<size_t>(state.range(0)), line_ending);
+  const auto expected_line_count = gsl::narrow<size_t>(std::ranges::count(corpus, line_ending.back()));
+  size_t line_count = 0;
+  for (auto _ : state) {
+    line_count = 0;
+    for (auto position = find(corpus, 0); position != std::string_view::npos; position = find(corpus, position + line_ending.size())) {
+      ++line_count;
+    }
+    benchmark::DoNotOptimize(line_count);
+  }
+  if (line_count != expected_line_count) {
+    state.SkipWithError("Wrong number of lines found");
+    return;
+  }
+  state.SetBytesProcessed(gsl::narrow<int64_t>(state.iterations() * corpus.size()));
+  state.SetItemsProcessed(gsl::narrow<int64_t>(state.iterations() * line_count));
+}
+
+void BM_StringViewFind(benchmark::State& state, std::string_view line_ending) {
+  countLines(state, line_ending, [line_ending](std::string_view data, size_t pos) { return data.find(line_ending, pos); });
+}
+
+void BM_DelimiterScanner(benchmark::State& state, std::string_view line_ending, minifi::utils::VectorInstructionSet instruction_set) {
+  if (std::ranges::find(minifi::utils::getSupportedVectorInstructionSets(), instruction_set) == minifi::utils::getSupportedVectorInstructionSets().end()) {
+    state.SkipWithError("The instruction set is not supported on this CPU");
+    return;
+  }
+  const minifi::utils::DelimiterScanner scanner(std::string{line_ending}, instruction_set);
+  countLines(state, line_ending, [&scanner](std::string_view data, size_t pos) { return scanner.find(data, pos); });
+}
+
+}  // namespace
+
+using minifi::utils::VectorInstructionSet;
+
+// the argument is the average line length, short lines are typical of logs, long lines of e.g. JSON records
+BENCHMARK_CAPTURE(BM_StringViewFind, LF, "\n")->Arg(40)->Arg(2000)->Unit(benchmark::kMillisecond);
+BENCHMARK_CAPTURE(BM_DelimiterScanner, LF_Scalar, "\n", VectorInstructionSet::Scalar)->Arg(40)->Arg(2000)->Unit(benchmark::kMillisecond);
+BENCHMARK_CAPTURE(BM_DelimiterScanner, LF_SSE2, "\n", VectorInstructionSet::SSE2)->Arg(40)->Arg(2000)->Unit(benchmark::kMillisecond);
+BENCHMARK_CAPTURE(BM_DelimiterScanner, LF_AVX2, "\n", VectorInstructionSet::AVX2)->Arg(40)->Arg(2000)->Unit(benchmark::kMillisecond);
+BENCHMARK_CAPTURE(BM_DelimiterScanner, LF_NEON, "\n", VectorInstructionSet::NEON)->Arg(40)->Arg(2000)->Unit(benchmark::kMillisecond);
+
+BENCHMARK_CAPTURE(BM_StringViewFind, CRLF, "\r\n")->Arg(40)->Arg(2000)->Unit(benchmark::kMillisecond);
+BENCHMARK_CAPTURE(BM_DelimiterScanner, CRLF_Scalar, "\r\n", VectorInstructionSet::Scalar)->Arg(40)->Arg(2000)->Unit(benchmark::kMillisecond);
+BENCHMARK_CAPTURE(BM_DelimiterScanner, CRLF_SSE2, "\r\n", VectorInstructionSet::SSE2)->Arg(40)->Arg(2000)->Unit(benchmark::kMillisecond);
+BENCHMARK_CAPTURE(BM_DelimiterScanner, CRLF_AVX2, "\r\n", VectorInstructionSet::AVX2)->Arg(40)->Arg(2000)->Unit(benchmark::kMillisecond);
+BENCHMARK_CAPTURE(BM_DelimiterScanner, CRLF_NEON, "\r\n", VectorInstructionSet::NEON)->Arg(40)->Arg(2000)->Unit(benchmark::kMillisecond);
+
+BENCHMARK_MAIN();
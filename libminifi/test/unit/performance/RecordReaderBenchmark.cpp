@@ -0,0 +1,209 @@
+/**
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The ASF licenses this file to You under the Apache License, Version 2.0
+ * (the "License"); you may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <memory>
+#include <span>
+#include <string>
+
+#include "benchmark/benchmark.h"
+#include "controllers/CSVReader.h"
+#include "controllers/CSVRecordSetWriter.h"
+#include "controllers/JsonRecordSetWriter.h"
+#include "controllers/JsonTreeReader.h"
+#include "fmt/format.h"
+#include "io/BufferStream.h"
+#include "minifi-cpp/utils/gsl.h"
+#include "unit/ControllerServiceUtils.h"
+
+namespace minifi = org::apache::nifi::minifi;
+
+namespace {
+
+// sensor readings, the same data is generated as CSV with a header line and as one JSON object per line
+std::string createSensorData(size_t row_count, bool csv) {
+  std::string data;
+  if (csv) {
+    data += "sensor_id,location,temperature,humidity,active,measured_at\n";
+  }
+  for (size_t i = 0; i < row_count; ++i) {
+    const auto sensor_id = gsl::narrow<int64_t>(i % 1000);
+    const auto temperature = 15.0 + gsl::narrow<double>(i % 200) / 10.0;
+    const auto humidity = gsl::narrow<int64_t>(30 + i % 50);
+    const bool active = i % 7 != 0;
+    const auto measured_at = fmt::format("2024-05-{:02}T{:02}:{:02}:{:02}Z", 1 + i % 28, i % 24, i % 60, (i * 7) % 60);
+    if (csv) {
+      data += fmt::format("{},\"Building {}, floor {}\",{},{},{},{}\n", sensor_id, i % 10, i % 5, temperature, humidity, active, measured_at);
+    } else {
+      data += fmt::format(R"({{"sensor_id":{},"location":"Building {}, floor {}","temperature":{},"humidity":{},"active":{},"measured_at":"{}"}})" "\n",
+          sensor_id, i % 10, i % 5, temperature, humidity, active, measured_at);
+    }
+  }
+  return data;
+}
+
+// JSON-per-line records with 500 fields of the same names, or with 10 fields whose names are unique to the record, like sparse or high-cardinality keys
+std::string createJsonRecords(size_t row_count, bool sparse) {
+  const size_t field_count = sparse ? 10 : 500;
+  std::string data;
+  for (size_t i = 0; i < row_count; ++i) {
+    data += '{';
+    for (size_t j = 0; j < field_count; ++j) {
+      const auto name = sparse ? fmt::format("key_{}", i * field_count + j) : fmt::format("field_{:03}", j);
+      data += fmt::format(R"({}"{}":{})", j == 0 ? "" : ",", name, j % 2 == 0 ? std::to_string(i + j) : fmt::format(R"("value {}")", j));
+    }
+    data += "}\n";
+  }
+  return data;
+}
+
+template<typename Reader>
+std::unique_ptr<minifi::core::controller::ControllerService> createReader(bool csv) {
+  auto reader = minifi::test::utils::make_controller_service<Reader>("reader");
+  reader->initialize();
+  if (csv) {
+    gsl_Assert(reader->setProperty(minifi::standard::CSVReader::TreatFirstLineAsHeader.name, "true"));
+  }
+  reader->onEnable();
+  return reader;
+}
+
+template<typename Reader>
+void readRecords(benchmark::State& state, bool csv) {
+  const auto row_count = gsl::narrow<size_t>(state.range(0));
+  const auto data = createSensorData(row_count, csv);
+  auto reader = createReader<Reader>(csv);
+  for (auto _ : state) {
+    minifi::io::BufferStream buffer_stream;
+    buffer_stream.write(as_bytes(std::span(data)));
+    const auto record_reader = reader->template getImplementation<Reader>()->createRecordReader(buffer_stream);
+    size_t records_read = 0;
+    while (true) {
+      auto record = record_reader->next();
+      if (!record || !*record) {
+        break;
+      }
+      benchmark::DoNotOptimize(**record);
+      ++records_read;
+    }
+    if (records_read != row_count) {
+      state.SkipWithError("Failed to read all records");
+      return;
+    }
+  }
+  state.SetBytesProcessed(gsl::narrow<int64_t>(state.iterations() * data.size()));
+  state.SetItemsProcessed(gsl::narrow<int64_t>(state.iterations() * row_count));
+}
+
+template<typename Writer>
+void writeRecords(benchmark::State& state) {
+  const auto row_count = gsl::narrow<size_t>(state.range(0));
+  auto reader = createReader<minifi::standard::CSVReader>(true);
+  const auto data = createSensorData(row_count, true);
+  minifi::io::BufferStream input_stream;
+  input_stream.write(as_bytes(std::span(data)));
+  const auto record_set = reader->getImplementation<minifi::standard::CSVReader>()->read(input_stream);
+  if (!record_set || record_set->size() != row_count) {
+    state.SkipWithError("Failed to read the records");
+    return;
+  }
+  auto writer = minifi::test::utils::make_controller_service<Writer>("writer");
+  writer->initialize();
+  writer->onEnable();
+  size_t bytes_written = 0;
+  for (auto _ : state) {
+    minifi::io::BufferStream output_stream;
+    const auto record_writer = writer->template getImplementation<Writer>()->createRecordWriter(output_stream);
+    for (const auto& record : *record_set) {
+      if (!record_writer->write(record)) {
+        state.SkipWithError("Failed to write the records");
+        return;
+      }
+    }
+    if (!record_writer->finish()) {
+      state.SkipWithError("Failed to write the records");
+      return;
+    }
+    bytes_written = output_stream.size();
+  }
+  state.SetBytesProcessed(gsl::narrow<int64_t>(state.iterations() * bytes_written));
+  state.SetItemsProcessed(gsl::narrow<int64_t>(state.iterations() * row_count));
+}
+
+// what ConvertRecord does with a JSON reader and writer: every record is read and written as soon as it is parsed
+void BM_JsonReadAndWrite(benchmark::State& state) {
+  const auto row_count = gsl::narrow<size_t>(state.range(0));
+  const bool sparse = state.range(1) != 0;
+  const auto data = createJsonRecords(row_count, sparse);
+  auto reader = createReader<minifi::standard::JsonTreeReader>(false);
+  auto writer = minifi::test::utils::make_controller_service<minifi::standard::JsonRecordSetWriter>("writer");
+  writer->initialize();
+  writer->onEnable();
+  for (auto _ : state) {
+    minifi::io::BufferStream input_stream;
+    input_stream.write(as_bytes(std::span(data)));
+    minifi::io::BufferStream output_stream;
+    const auto record_reader = reader->getImplementation<minifi::standard::JsonTreeReader>()->createRecordReader(input_stream);
+    const auto record_writer = writer->getImplementation<minifi::standard::JsonRecordSetWriter>()->createRecordWriter(output_stream);
+    size_t records_written = 0;
+    while (true) {
+      auto record = record_reader->next();
+      if (!record || !*record) {
+        break;
+      }
+      if (!record_writer->write(**record)) {
+        break;
+      }
+      ++records_written;
+    }
+    if (records_written != row_count || !record_writer->finish()) {
+      state.SkipWithError("Failed to convert the records");
+      return;
+    }
+  }
+  state.SetBytesProcessed(gsl::narrow<int64_t>(state.iterations() * data.size()));
+  state.SetItemsProcessed(gsl::narrow<int64_t>(state.iterations() * row_count));
+  state.SetLabel(sparse ? "sparse" : "wide");
+}
+
+void BM_CsvReader(benchmark::State& state) {
+  readRecords<minifi::standard::CSVReader>(state, true);
+}
+
+void BM_JsonTreeReader(benchmark::State& state) {
+  readRecords<minifi::standard::JsonTreeReader>(state, false);
+}
+
+void BM_CsvRecordSetWriter(benchmark::State& state) {
+  writeRecords<minifi::standard::CSVRecordSetWriter>(state);
+}
+
+void BM_JsonRecordSetWriter(benchmark::State& state) {
+  writeRecords<minifi::standard::JsonRecordSetWriter>(state);
+}
+
+}  // namespace
+
+// the argument is the number of records
+BENCHMARK(BM_CsvReader)->Arg(10000)->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_JsonTreeReader)->Arg(10000)->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_CsvRecordSetWriter)->Arg(10000)->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_JsonRecordSetWriter)->Arg(10000)->Unit(benchmark::kMillisecond);
+// number of records x shape (0: wide, 1: sparse)
+BENCHMARK(BM_JsonReadAndWrite)->ArgsProduct({{1000}, {0}})->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_JsonReadAndWrite)->ArgsProduct({{10000, 100000}, {1}})->Unit(benchmark::kMillisecond);
+
+BENCHMARK_MAIN();
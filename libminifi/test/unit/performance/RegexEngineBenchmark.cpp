@@ -0,0 +1,138 @@
+/**
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The ASF licenses this file to You under the Apache License, Version 2.0
+ * (the "License"); you may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <algorithm>
+#include <array>
+#include <random>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "benchmark/benchmark.h"
+#include "utils/LinearRegex.h"
+#include "utils/RegexUtils.h"
+#include "minifi-cpp/utils/gsl.h"
+
+namespace minifi = org::apache::nifi::minifi;
+
+namespace {
+
+constexpr size_t MEBIBYTE = 1024 * 1024;
+constexpr size_t CHUNK_SIZE = 16 * MEBIBYTE;
+
+// routing rules of a typical log processing flow, written in the common subset of POSIX ERE and ECMAScript
+const std::vector<std::string> PATTERNS{
+    "ERROR", "WARN", "FATAL", "Exception", "timeout|timed out", "connection (refused|reset)",
+    "^[0-9]{4}-[0-9]{2}-[0-9]{2}", "user=[a-z]+", "status=5[0-9][0-9]", "status=4[0-9][0-9]", "latency=[0-9]{4,}ms", "GET /api/v[0-9]+/",
+    "POST /api/v[0-9]+/orders", "session=[0-9a-f]{16}", "[0-9]+\\.[0-9]+\\.[0-9]+\\.[0-9]+", "retry( attempt)? [0-9]+",
+    "disk (full|quota)", "OutOfMemory", "thread-[0-9]+ blocked", "checksum mismatch", "certificate (expired|revoked)",
+    "rate limit", "deprecated", "shutting down"};
+
+constexpr std::array<std::string_view, 6> LEVELS{"INFO", "INFO", "INFO", "DEBUG", "WARN", "ERROR"};
+constexpr std::array<std::string_view, 8> MESSAGES{
+    "GET /api/v2/items status=200 latency=12ms",
+    "POST /api/v1/orders status=503 latency=2048ms",
+    "user=alice session=0123456789abcdef logged in from 10.0.12.7",
+    "connection refused by 192.168.1.20, retry attempt 3",
+    "thread-17 blocked on lock owned by thread-4",
+    "java.io.IOException: checksum mismatch in block 8812",
+    "scheduled compaction finished in 381ms",
+    "request timed out after 30000ms, status=408"};
+
+// a deterministic chunk of log lines, it is matched repeatedly to scan corpora larger than the memory we want to spend
+const std::string& logChunk() {
+  static const std::string chunk = [] {
+    std::mt19937 generator(42);  // NOLINT(cert-msc32-c,cert-msc51-cpp)
+    std::uniform_int_distribution<size_t> level(0, LEVELS.size() - 1);
+    std::uniform_int_distribution<size_t> message(0, MESSAGES.size() - 1);
+    std::uniform_int_distribution<int> second(0, 59);
+    std::string result;
+    result.reserve(CHUNK_SIZE + 256);
+    while (result.size() < CHUNK_SIZE) {
+      result.append("2024-05-13 12:34:").append(std::to_string(10 + second(generator) % 50)).append(" ")
+          .append(LEVELS[level(generator)]).append(" [worker] ").append(MESSAGES[message(generator)]).append("\n");
+    }
+    return result;
+  }();
+  return chunk;
+}
+
+template<typename Fn>
+void forEachLine(std::string_view content, Fn&& fn) {
+  while (!content.empty()) {
+    const auto end = content.find('\n');
+    fn(content.substr(0, end));
+    content = end == std::string_view::npos ? std::string_view{} : content.substr(end + 1);
+  }
+}
+
+template<typename Fn>
+void scanCorpus(benchmark::State& state, Fn&& match_line) {
+  const auto& chunk = logChunk();
+  const auto chunk_count = gsl::narrow<size_t>(state.range(0)) * MEBIBYTE / CHUNK_SIZE;
+  for (auto _ : state) {
+    size_t matches = 0;
+    for (size_t i = 0; i < chunk_count; ++i) {
+      forEachLine(chunk, [&](std::string_view line) { matches += match_line(line); });
+    }
+    benchmark::DoNotOptimize(matches);
+  }
+  state.SetBytesProcessed(gsl::narrow<int64_t>(state.iterations() * chunk_count * chunk.size()));
+}
+
+void BM_RegexPerPattern(benchmark::State& state, const std::vector<minifi::utils::Regex::Mode>& modes) {
+  std::vector<minifi::utils::Regex> regexes;
+  for (const auto& pattern : PATTERNS) {
+    regexes.emplace_back(pattern, modes);
+  }
+  scanCorpus(state, [&](std::string_view line) {
+    size_t matches = 0;
+    for (const auto& regex : regexes) {
+      matches += minifi::utils::regexSearch(line, regex);
+    }
+    return matches;
+  });
+}
+
+void BM_StandardRegex(benchmark::State& state) {
+  BM_RegexPerPattern(state, {});
+}
+
+void BM_LinearRegex(benchmark::State& state) {
+  BM_RegexPerPattern(state, {minifi::utils::Regex::Mode::LINEAR});
+}
+
+void BM_LinearRegexSet(benchmark::State& state) {
+  const auto regex_set = minifi::utils::LinearRegexSet::compile(PATTERNS);
+  if (!regex_set) {
+    state.SkipWithError("the patterns are not supported by LinearRegexSet");
+    return;
+  }
+  scanCorpus(state, [&](std::string_view line) {
+    const auto results = regex_set->search(line);
+    return gsl::narrow<size_t>(std::count(results.begin(), results.end(), true));
+  });
+}
+
+}  // namespace
+
+// the argument is the size of the corpus in MiB
+BENCHMARK(BM_StandardRegex)->Arg(16)->Arg(1024)->Iterations(1)->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_LinearRegex)->Arg(16)->Arg(1024)->Iterations(1)->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_LinearRegexSet)->Arg(16)->Arg(1024)->Iterations(1)->Unit(benchmark::kMillisecond);
+
+BENCHMARK_MAIN();
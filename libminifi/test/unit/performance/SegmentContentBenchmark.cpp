@@ -0,0 +1,89 @@
+/**
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The ASF licenses this file to You under the Apache License, Version 2.0
+ * (the "License"); you may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <memory>
+#include <set>
+#include <span>
+#include <string>
+#include <vector>
+
+#include "benchmark/benchmark.h"
+#include "FlowFileRecord.h"
+#include "minifi-cpp/utils/gsl.h"
+#include "processors/SegmentContent.h"
+#include "unit/ProcessorUtils.h"
+#include "unit/TestBase.h"
+
+namespace minifi = org::apache::nifi::minifi;
+using minifi::processors::SegmentContent;
+
+namespace {
+
+constexpr size_t SEGMENT_COUNT = 16;
+
+std::shared_ptr<minifi::core::FlowFile> createFlowFile(TestPlan& plan, const std::string& content) {
+  const auto flow_file = std::make_shared<minifi::FlowFileRecordImpl>();
+  auto content_session = plan.getContentRepo()->createSession();
+  auto claim = content_session->create();
+  auto stream = content_session->write(claim);
+  stream->write(as_bytes(std::span(content)));
+  flow_file->setResourceClaim(claim);
+  flow_file->setSize(stream->size());
+  flow_file->setOffset(0);
+  stream->close();
+  content_session->commit();
+  return flow_file;
+}
+
+// the flow file is cut into the same number of segments regardless of its size, so the time taken only depends on the size if the content is copied
+void BM_SegmentContent(benchmark::State& state) {
+  const auto content_size = gsl::narrow<size_t>(state.range(0));
+  LogTestController::getInstance().setOff<SegmentContent>();
+  TestController test_controller;
+  auto plan = test_controller.createPlan();
+  auto* const segment_content = plan->addProcessor(minifi::test::utils::make_processor<SegmentContent>("SegmentContent"), "SegmentContent", {});
+  plan->setProperty(segment_content, SegmentContent::SegmentSize, std::to_string(content_size / SEGMENT_COUNT) + " B");
+  auto* const input = plan->addConnection(nullptr, minifi::core::Relationship{"success", "success"}, segment_content);
+  auto* const segments = plan->addConnection(segment_content, SegmentContent::Segments, nullptr);
+  auto* const original = plan->addConnection(segment_content, SegmentContent::Original, nullptr);
+
+  const std::string content(content_size, 'x');
+  size_t segment_count = 0;
+  for (auto _ : state) {
+    state.PauseTiming();
+    input->put(createFlowFile(*plan, content));
+    state.ResumeTiming();
+    plan->runProcessor(segment_content);
+    std::set<std::shared_ptr<minifi::core::FlowFile>> expired_flow_files;
+    while (segments->isWorkAvailable()) {
+      benchmark::DoNotOptimize(segments->poll(expired_flow_files));
+      ++segment_count;
+    }
+    while (original->isWorkAvailable()) {
+      benchmark::DoNotOptimize(original->poll(expired_flow_files));
+    }
+  }
+  state.SetBytesProcessed(gsl::narrow<int64_t>(state.iterations() * content_size));
+  state.SetItemsProcessed(gsl::narrow<int64_t>(segment_count));
+}
+
+}  // namespace
+
+// flow file size
+BENCHMARK(BM_SegmentContent)->Arg(1024 * 1024)->Arg(16 * 1024 * 1024)->Arg(128 * 1024 * 1024)->Unit(benchmark::kMillisecond)->UseRealTime();
+
+BENCHMARK_MAIN();
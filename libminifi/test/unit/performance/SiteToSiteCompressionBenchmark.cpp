@@ -0,0 +1,160 @@
+/**
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The ASF licenses this file to You under the Apache License, Version 2.0
+ * (the "License"); you may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <algorithm>
+#include <array>
+#include <memory>
+#include <optional>
+#include <random>
+#include <span>
+#include <string>
+#include <vector>
+
+#include "benchmark/benchmark.h"
+#include "unit/TestBase.h"
+#include "unit/DummyProcessor.h"
+#include "integration/MockSiteToSiteServer.h"
+#include "io/BufferStream.h"
+#include "minifi-cpp/utils/gsl.h"
+#include "sitetosite/CompressionInputStream.h"
+#include "sitetosite/CompressionOutputStream.h"
+#include "sitetosite/HttpSiteToSiteClient.h"
+
+namespace minifi = org::apache::nifi::minifi;
+
+namespace {
+
+constexpr size_t PAYLOAD_SIZE = 8 * 1024 * 1024;
+constexpr size_t FLOW_FILE_SIZE = 1024 * 1024;
+
+std::string generateJsonPayload() {
+  std::mt19937 random_engine(42);  // NOLINT(cert-msc32-c,cert-msc51-cpp)
+  std::uniform_int_distribution<int> value_distribution(0, 100000);
+  std::string payload;
+  payload.reserve(PAYLOAD_SIZE);
+  while (payload.size() < PAYLOAD_SIZE) {
+    payload += R"({"sensor_id":")" + std::to_string(value_distribution(random_engine) % 64) + R"(","temperature":)" + std::to_string(value_distribution(random_engine))
+        + R"(,"humidity":)" + std::to_string(value_distribution(random_engine)) + R"(,"status":"OK","timestamp":)" + std::to_string(1700000000 + payload.size()) + "}\n";
+  }
+  return payload;
+}
+
+std::string generateLogPayload() {
+  static constexpr std::array<std::string_view, 4> LEVELS{"INFO", "DEBUG", "WARN", "ERROR"};
+  static constexpr std::array<std::string_view, 3> COMPONENTS{"[org::apache::nifi::minifi::core::ProcessSession]", "[org::apache::nifi::minifi::FlowController]",
+      "[org::apache::nifi::minifi::sitetosite::RawSiteToSiteClient]"};
+  std::mt19937 random_engine(42);  // NOLINT(cert-msc32-c,cert-msc51-cpp)
+  std::string payload;
+  payload.reserve(PAYLOAD_SIZE);
+  while (payload.size() < PAYLOAD_SIZE) {
+    payload += "[2024-05-13 10:" + std::to_string(random_engine() % 60) + ":" + std::to_string(random_engine() % 60) + "." + std::to_string(random_engine() % 1000) + "] "
+        + std::string{COMPONENTS[random_engine() % COMPONENTS.size()]} + " [" + std::string{LEVELS[random_engine() % LEVELS.size()]} + "] Transferred flow file "
+        + std::to_string(random_engine()) + " of size " + std::to_string(random_engine() % 65536) + "\n";
+  }
+  return payload;
+}
+
+const std::string& getPayload(int64_t payload_type) {
+  static const std::string json_payload = generateJsonPayload();
+  static const std::string log_payload = generateLogPayload();
+  return payload_type == 0 ? json_payload : log_payload;
+}
+
+// the size of the payload compressed the way the client sends it, every flow file as a separate compressed stream
+size_t compressedSize(const std::string& payload, minifi::sitetosite::CompressionCodec codec) {
+  size_t compressed_size = 0;
+  for (size_t offset = 0; offset < payload.size(); offset += FLOW_FILE_SIZE) {
+    minifi::io::BufferStream buffer_stream;
+    minifi::sitetosite::CompressionOutputStream output_stream(buffer_stream, codec);
+    output_stream.write(reinterpret_cast<const uint8_t*>(payload.data() + offset), std::min(FLOW_FILE_SIZE, payload.size() - offset));
+    output_stream.close();
+    compressed_size += buffer_stream.size();
+  }
+  return compressed_size;
+}
+
+// sends the payload split into flow files in a single transaction through the HTTP site-to-site client, codec -1 is uncompressed
+void BM_SiteToSiteSend(benchmark::State& state) {
+  const auto codec = state.range(0) < 0 ? std::nullopt : std::optional{static_cast<minifi::sitetosite::CompressionCodec>(state.range(0))};
+  const auto& payload = getPayload(state.range(1));
+  const auto parallelism = gsl::narrow<size_t>(state.range(2));
+
+  LogTestController::getInstance().setOff<minifi::sitetosite::HttpSiteToSiteClient>();
+  LogTestController::getInstance().setOff<minifi::sitetosite::CompressionInputStream>();
+  TestController test_controller;
+  auto plan = test_controller.createPlan();
+  plan->addProcessor<minifi::test::DummyProcessor>("dummy");
+  plan->runNextProcessor();
+  auto context = plan->getCurrentContext();
+
+  minifi::test::MockSiteToSiteServer server(false);
+  minifi::sitetosite::HttpSiteToSiteClient client(
+      gsl::make_not_null(std::make_unique<minifi::sitetosite::SiteToSitePeer>("localhost", gsl::narrow<uint16_t>(std::stoi(server.getPort())), "")));
+  client.setPortId(minifi::utils::IdGenerator::getIdGenerator()->generate());
+  client.setUseCompression(codec.has_value());
+  client.setCompressionCodec(codec.value_or(minifi::sitetosite::CompressionCodec::ZLIB));
+  client.setCompressionParallelism(parallelism);
+
+  for (auto _ : state) {
+    state.PauseTiming();
+    std::vector<minifi::sitetosite::FlowFileWithContent> flow_files;
+    for (size_t offset = 0; offset < payload.size(); offset += FLOW_FILE_SIZE) {
+      const auto content = std::as_bytes(std::span(payload)).subspan(offset, std::min(FLOW_FILE_SIZE, payload.size() - offset));
+      auto flow_file = std::make_shared<minifi::core::FlowFileImpl>();
+      flow_file->setSize(content.size());
+      flow_files.push_back({flow_file, std::make_shared<minifi::io::BufferStream>(content)});
+    }
+    state.ResumeTiming();
+    if (!client.sendFlowFiles(*context, flow_files)) {
+      state.SkipWithError("Failed to send flow files");
+      break;
+    }
+  }
+  state.SetBytesProcessed(gsl::narrow<int64_t>(server.getReceivedBytes()));
+  state.SetItemsProcessed(gsl::narrow<int64_t>(server.getReceivedFlowFileCount()));
+  state.counters["ratio"] = codec ? static_cast<double>(payload.size()) / static_cast<double>(compressedSize(payload, *codec)) : 1.0;
+  state.SetLabel(std::string{codec ? minifi::sitetosite::compressionCodecName(*codec) : "uncompressed"} + (state.range(1) == 0 ? "/json" : "/log"));
+}
+
+// the decompression of a received stream, which is the cost of the codec on the receiving side
+void BM_SiteToSiteDecompress(benchmark::State& state) {
+  const auto codec = static_cast<minifi::sitetosite::CompressionCodec>(state.range(0));
+  const auto& payload = getPayload(state.range(1));
+  minifi::io::BufferStream compressed_stream;
+  {
+    minifi::sitetosite::CompressionOutputStream output_stream(compressed_stream, codec);
+    output_stream.write(reinterpret_cast<const uint8_t*>(payload.data()), payload.size());
+    output_stream.close();
+  }
+  const auto compressed = compressed_stream.getBuffer();
+  std::vector<std::byte> output(payload.size());
+  for (auto _ : state) {
+    minifi::io::BufferStream buffer_stream(compressed);
+    minifi::sitetosite::CompressionInputStream input_stream(buffer_stream, codec);
+    benchmark::DoNotOptimize(input_stream.read(output));
+  }
+  state.SetBytesProcessed(gsl::narrow<int64_t>(state.iterations() * payload.size()));
+  state.SetLabel(std::string{minifi::sitetosite::compressionCodecName(codec)} + (state.range(1) == 0 ? "/json" : "/log"));
+}
+
+}  // namespace
+
+// codec (-1: uncompressed, 0: zlib, 1: lz4, 2: zstd) x payload (0: json, 1: log) x parallelism
+BENCHMARK(BM_SiteToSiteSend)->ArgsProduct({{-1}, {0, 1}, {1}})->Unit(benchmark::kMillisecond)->UseRealTime();
+BENCHMARK(BM_SiteToSiteSend)->ArgsProduct({{0, 1, 2}, {0, 1}, {1, 4}})->Unit(benchmark::kMillisecond)->UseRealTime();
+BENCHMARK(BM_SiteToSiteDecompress)->ArgsProduct({{0, 1, 2}, {0, 1}})->Unit(benchmark::kMillisecond);
+
+BENCHMARK_MAIN();
@@ -17,6 +17,9 @@
 #pragma once
 
 #include <expected>
+#include <memory>
+#include <optional>
+#include <utility>
 
 #include "minifi-cpp/core/ControllerServiceTypeDefinition.h"
 #include "minifi-cpp/core/Record.h"
@@ -25,6 +28,34 @@
 
 namespace org::apache::nifi::minifi::core {
 
+/**
+ * Pulls the records from an input stream one at a time, so only the records held by the caller are kept in memory.
+ * It refers to the input stream it was created for, so it must not outlive the stream.
+ */
+class RecordReader {
+ public:
+  virtual ~RecordReader() = default;
+
+  // returns std::nullopt after the last record
+  virtual std::expected<std::optional<Record>, std::error_code> next() = 0;
+
+  // returns at most max_count records, an empty set after the last record
+  std::expected<RecordSet, std::error_code> nextBatch(size_t max_count) {
+    RecordSet record_set;
+    while (record_set.size() < max_count) {
+      auto record = next();
+      if (!record) {
+        return std::unexpected{record.error()};
+      }
+      if (!*record) {
+        break;
+      }
+      record_set.push_back(std::move(**record));
+    }
+    return record_set;
+  }
+};
+
 class RecordSetReader : public controller::ControllerServiceHandle {
  public:
   static constexpr auto ProvidesApi = core::ControllerServiceTypeDefinition{
@@ -35,6 +66,7 @@ class RecordSetReader : public controller::ControllerServiceHandle {
   };
 
   virtual std::expected<RecordSet, std::error_code> read(io::InputStream& input_stream) = 0;
+  virtual std::unique_ptr<RecordReader> createRecordReader(io::InputStream& input_stream) = 0;
 };
 
 }  // namespace org::apache::nifi::minifi::core
@@ -16,16 +16,35 @@
  */
 #pragma once
 
+#include <expected>
+#include <memory>
+#include <system_error>
+
 #include "minifi-cpp/core/controller/ControllerServiceHandle.h"
 
 #include "minifi-cpp/core/ControllerServiceTypeDefinition.h"
 #include "minifi-cpp/core/FlowFile.h"
 #include "minifi-cpp/core/ProcessSession.h"
 #include "minifi-cpp/core/Record.h"
+#include "minifi-cpp/io/OutputStream.h"
 #include "minifi-cpp/agent/agent_version.h"
 
 namespace org::apache::nifi::minifi::core {
 
+/**
+ * Writes records to an output stream one at a time, the counterpart of RecordReader.
+ * It refers to the output stream it was created for, so it must not outlive the stream.
+ */
+class RecordWriter {
+ public:
+  virtual ~RecordWriter() = default;
+
+  virtual std::expected<void, std::error_code> write(const Record& record) = 0;
+
+  // completes the output (e.g. closes the enclosing array), no records can be written afterwards
+  virtual std::expected<void, std::error_code> finish() = 0;
+};
+
 class RecordSetWriter : public controller::ControllerServiceHandle {
  public:
   static constexpr auto ProvidesApi = core::ControllerServiceTypeDefinition{
@@ -36,6 +55,7 @@ class RecordSetWriter : public controller::ControllerServiceHandle {
   };
 
   virtual void write(const RecordSet& record_set, const std::shared_ptr<FlowFile>& flow_file, ProcessSession& session) = 0;
+  virtual std::unique_ptr<RecordWriter> createRecordWriter(io::OutputStream& output_stream) = 0;
 };
 
 }  // namespace org::apache::nifi::minifi::core
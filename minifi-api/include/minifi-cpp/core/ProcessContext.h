@@ -18,6 +18,7 @@
 
 #include <memory>
 #include <optional>
+#include <span>
 #include <string>
 #include <vector>
 
@@ -65,6 +66,8 @@ class ProcessContext : public virtual core::VariableRegistry, public virtual uti
   virtual std::expected<void, std::error_code> clearProperty(std::string_view name) = 0;
 
   virtual std::expected<std::string, std::error_code> getDynamicProperty(std::string_view name, const FlowFile* flow_file = nullptr) const = 0;
+  // evaluates the dynamic property for each of the flow files, like calling getDynamicProperty for them one by one, but cheaper for large batches
+  virtual std::expected<std::vector<std::string>, std::error_code> getDynamicPropertyForEach(std::string_view name, std::span<const std::shared_ptr<FlowFile>> flow_files) const = 0;
   virtual std::expected<void, std::error_code> setDynamicProperty(std::string name, std::string value) = 0;
 
   virtual std::expected<std::string, std::error_code> getRawDynamicProperty(std::string_view name) const = 0;
@@ -66,6 +66,8 @@ class Configuration : public virtual Properties {
   static constexpr const char *nifi_flowfile_repository_directory_default = "nifi.flowfile.repository.directory.default";
   static constexpr const char *nifi_dbcontent_repository_directory_default = "nifi.database.content.repository.directory.default";
   static constexpr const char *nifi_default_internal_buffer_size = "nifi.default.internal.buffer.size";
+  static constexpr const char *nifi_expression_language_regex_engine = "nifi.expression.language.regex.engine";
+  static constexpr const char *nifi_expression_language_regex_cache_size = "nifi.expression.language.regex.cache.size";
 
   // these are internal properties related to the rocksdb backend
   static constexpr const char *nifi_flowfile_repository_rocksdb_compaction_period = "nifi.flowfile.repository.rocksdb.compaction.period";
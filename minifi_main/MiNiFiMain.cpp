@@ -63,13 +63,17 @@
 #include "core/extension/ExtensionManager.h"
 #include "core/repository/VolatileContentRepository.h"
 #include "core/state/MetricsPublisherStore.h"
+#include "expression-language/RegexCache.h"
 #include "properties/Decryptor.h"
 #include "utils/Environment.h"
+#include "utils/ParsingUtils.h"
+#include "utils/expected.h"
 #include "utils/FileMutex.h"
 #include "utils/file/AssetManager.h"
 #include "utils/file/FileUtils.h"
 #include "utils/file/PathUtils.h"
 #include "range/v3/algorithm/min_element.hpp"
+#include "magic_enum/magic_enum.hpp"
 #include "core/Repository.h"
 
 namespace minifi = org::apache::nifi::minifi;
@@ -131,6 +135,21 @@ void overridePropertiesFromCommandLine(const argparse::ArgumentParser& parser, c
   }
 }
 
+void configureExpressionLanguageRegex(const minifi::Configure& configure, const std::shared_ptr<core::logging::Logger>& logger) {
+  auto& regex_cache = minifi::expression::regex::RegexCache::getInstance();
+  if (const auto engine_str = configure.get(minifi::Configure::nifi_expression_language_regex_engine)) {
+    if (const auto engine = magic_enum::enum_cast<minifi::expression::regex::Engine>(*engine_str, magic_enum::case_insensitive)) {
+      regex_cache.setEngine(*engine);
+    } else {
+      logger->log_warn("Invalid value \"{}\" for {}, using the standard regex engine", *engine_str, minifi::Configure::nifi_expression_language_regex_engine);
+    }
+  }
+  if (const auto cache_size = configure.get(minifi::Configure::nifi_expression_language_regex_cache_size)
+      | utils::andThen([](const auto& str) { return minifi::parsing::parseIntegral<size_t>(str) | utils::toOptional(); })) {
+    regex_cache.setCapacity(*cache_size);
+  }
+}
+
 [[nodiscard]] std::optional<int /* exit code */> dumpDocsIfRequested(const argparse::ArgumentParser& parser) {
   if (!parser.is_used("--docs")) {
     return std::nullopt;  // don't exit
@@ -328,6 +347,7 @@ int main(int argc, char **argv) {
     overridePropertiesFromCommandLine(argument_parser, configure);
 
     minifi::fips::initializeFipsMode(configure, *locations, logger);
+    configureExpressionLanguageRegex(*configure, logger);
 
     minifi::core::extension::ExtensionManager extension_manager(configure);
 